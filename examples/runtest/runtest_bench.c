@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <string.h>
+#include "runtest_bench.h"
+#include "runtest_bench_common.h"
+
+//
+// Benchmark routine signature.
+//
+typedef
+_Success_( return )
+BOOLEAN
+( *AML_BENCH_ROUTINE )(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Named benchmark table entry.
+//
+typedef struct _AML_BENCH_ENTRY {
+    const CHAR*       Name;
+    const CHAR*       Description;
+    AML_BENCH_ROUTINE Routine;
+} AML_BENCH_ENTRY;
+
+//
+// All available benchmarks.
+//
+static const AML_BENCH_ENTRY AmlBenchmarks[ ] = {
+    { "name-cache",      "Method invocation with and without the call site name resolution cache", AmlBenchNameCache },
+    { "namespace-map",   "Table load and absolute path lookup of all nodes, namespace hash-table statistics", AmlBenchNamespaceMap },
+    { "scope-depth",     "Unprefixed name lookup from increasingly deep scopes, with and without scope prefix hashes", AmlBenchScopeDepth },
+    { "opcode-dispatch", "Per-opcode instruction throughput of synthetic methods, covering every opcode class", AmlBenchOpcodeDispatch },
+    { "skip-index",      "Table load with and without the namespace pass skip index, skip index statistics", AmlBenchSkipIndex },
+    { "id-cache",        "Identification method evaluation with and without memoization of pure methods, cache statistics", AmlBenchIdentificationCache },
+#ifdef AML_TEST_HAS_THREADS
+    { "ns-readers",      "Concurrent lock-free namespace lookups from 1-64 reader threads alongside a node creating/releasing writer", AmlBenchConcurrentReaders },
+    { "device-init",     "Serial and worker pool initialization of a synthetic device tree with sleeping _INI methods, critical path timing", AmlBenchDeviceInit },
+#endif
+    { "region-vector",   "Multi-word EC field reads and writes with per-word and vectored region access handlers, callback counts", AmlBenchRegionVector },
+    { "gnvs",            "GNVS-style SystemMemory field accesses with the regular handler and with direct access of the region mapping", AmlBenchGnvs },
+    { "region-map",      "Temporary and overlapping SystemMemory regions with private host mappings and with the shared mapping cache", AmlBenchRegionMap },
+    { "region-window",   "Sparse field reads of a 64 MiB SystemMemory region, mapped entirely and mapped on demand in windows", AmlBenchRegionWindow },
+    { "pci-topology",    "Named and temporary PCI_Config regions behind bridges, with per-region and cached PCI topology resolution", AmlBenchPciTopology },
+    { "index-field",     "CMOS-style index field accesses and runs of host unit reads, with and without index register elision", AmlBenchIndexField },
+    { "load",            "Load of a 64 KiB SSDT from a SystemMemory region, read in access words, copied directly, and evaluated in place", AmlBenchLoad },
+    { "clone",           "Instantiation of 1000 states by fully loading the table, and by cloning an initialized template state", AmlBenchClone },
+    { "share",           "Memory of 64 clones of a template state held at once, with private and with shared (copy-on-write) named data", AmlBenchShare },
+#if defined(AML_TEST_HAS_THREADS) && defined(AML_TEST_HAS_UCONTEXT)
+    { "async",           "Asynchronous evaluations that sleep, wait, and perform pended EC accesses, multiplexed over a few threads", AmlBenchAsyncEvaluation },
+#endif
+};
+
+//
+// Run the named benchmark against the given full ACPI table (including the table header).
+// Benchmarks are only used for local measurements, results are printed to stdout.
+//
+_Success_( return )
+BOOLEAN
+AmlTestRunBenchmark(
+    _In_z_                        const CHAR*  BenchmarkName,
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    SIZE_T i;
+
+    //
+    // Find and run the benchmark by name.
+    //
+    for( i = 0; i < AML_COUNTOF( AmlBenchmarks ); i++ ) {
+        if( strcmp( AmlBenchmarks[ i ].Name, BenchmarkName ) == 0 ) {
+            return AmlBenchmarks[ i ].Routine( Table, TableSize );
+        }
+    }
+
+    //
+    // Unknown benchmark, list all available benchmarks.
+    //
+    printf( "Error: Unknown benchmark \"%s\", available benchmarks:\n", BenchmarkName );
+    for( i = 0; i < AML_COUNTOF( AmlBenchmarks ); i++ ) {
+        printf( "  %-16s %s\n", AmlBenchmarks[ i ].Name, AmlBenchmarks[ i ].Description );
+    }
+    return AML_FALSE;
+}
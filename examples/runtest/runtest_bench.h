@@ -0,0 +1,15 @@
+#pragma once
+
+#include "aml_platform.h"
+
+//
+// Run the named benchmark against the given full ACPI table (including the table header).
+// Benchmarks are only used for local measurements, results are printed to stdout.
+//
+_Success_( return )
+BOOLEAN
+AmlTestRunBenchmark(
+    _In_z_                        const CHAR*  BenchmarkName,
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
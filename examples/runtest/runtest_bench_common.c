@@ -0,0 +1,363 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "runtest_bench_common.h"
+
+//
+// Methods that take longer than this (per call) to warm up are skipped,
+// these are typically test drivers or methods that stall/sleep.
+//
+#define AML_BENCH_METHOD_MAX_WARMUP_NS ( 2 * 1000 * 1000 )
+
+//
+// Benchmark allocator callbacks.
+//
+_Success_( return != NULL )
+VOID*
+AmlBenchMemoryAllocate(
+    _Inout_ VOID*  Context,
+    _In_    SIZE_T Size
+    )
+{
+    return malloc( Size );
+}
+
+_Success_( return )
+BOOLEAN
+AmlBenchMemoryFree(
+    _Inout_          VOID*  Context,
+    _In_ _Frees_ptr_ VOID*  Allocation,
+    _In_             SIZE_T AllocationSize
+    )
+{
+    free( Allocation );
+    return AML_TRUE;
+}
+
+//
+// Current wall-clock time in nanoseconds.
+//
+UINT64
+AmlBenchTimeNs(
+    VOID
+    )
+{
+    struct timespec Time;
+
+    timespec_get( &Time, TIME_UTC );
+    return ( ( ( UINT64 )Time.tv_sec * 1000000000ull ) + ( UINT64 )Time.tv_nsec );
+}
+
+//
+// Create a quiet state and load the given table, followed by an optional additional code block,
+// as part of the initial load (optionally including initial _INI handling).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchLoadTableEx(
+    _Out_                         AML_BENCH_CONTEXT*          Context,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                Code,
+    _In_                          SIZE_T                      CodeSize,
+    _In_                          BOOLEAN                     InitializeDevices
+    )
+{
+    AML_DESCRIPTION_HEADER TableHeader;
+    AML_STATE_PARAMETERS   StateParameters;
+    AML_ALLOCATOR          Allocator;
+
+    //
+    // The table has already been validated by the caller.
+    //
+    AML_MEMCPY( &TableHeader, Table, sizeof( TableHeader ) );
+
+    //
+    // Set up a quiet host and the state.
+    //
+    Context->AcpiGlobalLock = 0;
+    Context->Host = ( AML_HOST_CONTEXT ){ .GlobalLock = &Context->AcpiGlobalLock, .IsQuiet = AML_TRUE };
+    Allocator = ( AML_ALLOCATOR ){ .Allocate = AmlBenchMemoryAllocate, .Free = AmlBenchMemoryFree };
+    StateParameters = *Parameters;
+    StateParameters.Host = &Context->Host;
+    StateParameters.Use64BitInteger = ( TableHeader.Revision > 1 );
+    if( AmlStateCreate( &Context->State, Allocator, &StateParameters ) == AML_FALSE ) {
+        printf( "Error: AmlStateCreate failed!\n" );
+        return AML_FALSE;
+    }
+
+    //
+    // Load the table and perform initial device initialization.
+    //
+    if( AmlCreatePredefinedNamespaces( &Context->State ) == AML_FALSE ) {
+        printf( "Error: AmlCreatePredefinedNamespaces failed!\n" );
+        AmlStateFree( &Context->State );
+        return AML_FALSE;
+    }
+    AmlCreatePredefinedObjects( &Context->State );
+    if( AmlEvalLoadedTableCode( &Context->State, &Table[ sizeof( TableHeader ) ], ( TableSize - sizeof( TableHeader ) ), NULL ) == AML_FALSE ) {
+        printf( "Error: AmlEvalLoadedTableCode failed!\n" );
+        AmlStateFree( &Context->State );
+        return AML_FALSE;
+    }
+    if( ( CodeSize != 0 ) && ( AmlEvalLoadedTableCode( &Context->State, Code, CodeSize, NULL ) == AML_FALSE ) ) {
+        printf( "Error: AmlEvalLoadedTableCode failed for the synthetic code block!\n" );
+        AmlStateFree( &Context->State );
+        return AML_FALSE;
+    }
+    AmlCompleteInitialLoad( &Context->State, InitializeDevices );
+    return AML_TRUE;
+}
+
+//
+// Create a quiet state and fully load the given table (including initial _INI/_REG handling).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchLoadTable(
+    _Out_                         AML_BENCH_CONTEXT*          Context,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize
+    )
+{
+    return AmlBenchLoadTableEx( Context, Parameters, Table, TableSize, NULL, 0, AML_TRUE );
+}
+
+//
+// Namespace iterator callback, collects all argument-less predefined (_XXX) AML methods.
+// Only predefined control methods are benchmarked, these are the methods repeatedly evaluated by an OS,
+// other methods may be arbitrary test drivers that aren't guaranteed to ever complete.
+//
+AML_ITERATOR_ACTION
+AmlBenchCollectMethod(
+    _In_opt_ VOID*               UserContext,
+    _Inout_  AML_STATE*          State,
+    _Inout_  AML_NAMESPACE_NODE* Node
+    )
+{
+    AML_BENCH_METHOD_LIST* List;
+    AML_OBJECT**           NewMethods;
+
+    List = UserContext;
+    if( ( Node->Object == NULL )
+        || ( Node->LocalName.Data[ 0 ] != '_' )
+        || ( Node->Object->u.Method.UserRoutine != NULL )
+        || ( Node->Object->u.Method.ArgumentCount != 0 ) )
+    {
+        return AML_ITERATOR_ACTION_CONTINUE;
+    }
+
+    //
+    // Grow the list if needed.
+    //
+    if( List->Count >= List->Capacity ) {
+        List->Capacity = AML_MAX( 64, ( List->Capacity * 2 ) );
+        if( ( NewMethods = realloc( List->Methods, ( List->Capacity * sizeof( List->Methods[ 0 ] ) ) ) ) == NULL ) {
+            return AML_ITERATOR_ACTION_ERROR;
+        }
+        List->Methods = NewMethods;
+    }
+    List->Methods[ List->Count++ ] = Node->Object;
+    return AML_ITERATOR_ACTION_CONTINUE;
+}
+
+//
+// Invoke all methods of the list once (untimed), removes any methods that fail or are too slow.
+//
+VOID
+AmlBenchWarmupMethods(
+    _Inout_ AML_STATE*             State,
+    _Inout_ AML_BENCH_METHOD_LIST* List
+    )
+{
+    SIZE_T   i;
+    SIZE_T   Kept;
+    UINT64   Start;
+    AML_DATA ReturnValue;
+
+    for( i = 0, Kept = 0; i < List->Count; i++ ) {
+        Start = AmlBenchTimeNs();
+        if( AmlMethodInvoke( State, List->Methods[ i ], 0, NULL, 0, &ReturnValue ) == AML_FALSE ) {
+            continue;
+        }
+        AmlDataFree( &ReturnValue );
+        if( ( AmlBenchTimeNs() - Start ) > AML_BENCH_METHOD_MAX_WARMUP_NS ) {
+            continue;
+        }
+        List->Methods[ Kept++ ] = List->Methods[ i ];
+    }
+    List->Count = Kept;
+}
+
+//
+// Time all methods of the list, returns the total elapsed time in nanoseconds.
+//
+UINT64
+AmlBenchTimeMethods(
+    _Inout_ AML_STATE*                   State,
+    _In_    const AML_BENCH_METHOD_LIST* List,
+    _In_    SIZE_T                       Iterations,
+    _Out_   UINT64*                      pFailureCount
+    )
+{
+    SIZE_T   i;
+    SIZE_T   j;
+    UINT64   Start;
+    UINT64   FailureCount;
+    AML_DATA ReturnValue;
+
+    FailureCount = 0;
+    Start = AmlBenchTimeNs();
+    for( j = 0; j < Iterations; j++ ) {
+        for( i = 0; i < List->Count; i++ ) {
+            if( AmlMethodInvoke( State, List->Methods[ i ], 0, NULL, 0, &ReturnValue ) == AML_FALSE ) {
+                FailureCount++;
+                continue;
+            }
+            AmlDataFree( &ReturnValue );
+        }
+    }
+    *pFailureCount = FailureCount;
+    return ( AmlBenchTimeNs() - Start );
+}
+
+//
+// Compare repeated method invocation performance with and without an optional (cache) feature of the state.
+// Both modes run the same set of argument-less predefined methods of the table, within the same state.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchCompareMethods(
+    _In_reads_bytes_( TableSize ) const UINT8*                 Table,
+    _In_                          SIZE_T                       TableSize,
+    _In_                          AML_BENCH_ENABLE_ROUTINE     EnableRoutine,
+    _In_                          AML_BENCH_STATISTICS_ROUTINE StatisticsRoutine
+    )
+{
+    AML_BENCH_CONTEXT*    Context;
+    AML_BENCH_METHOD_LIST List;
+    UINT64                ElapsedUncached;
+    UINT64                ElapsedCached;
+    UINT64                FailuresUncached;
+    UINT64                FailuresCached;
+    UINT64                CallCount;
+    UINT64                HitCount;
+    UINT64                MissCount;
+    SIZE_T                i;
+
+    //
+    // Load the table with all optional features disabled, the feature is only enabled for the second timed pass.
+    //
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Collect and warm up all benchmarkable methods.
+    //
+    List = ( AML_BENCH_METHOD_LIST ){ 0 };
+    AmlIterateNamespaceObjects( &Context->State, NULL, AmlBenchCollectMethod, &List, AML_OBJECT_TYPE_METHOD );
+    AmlBenchWarmupMethods( &Context->State, &List );
+    CallCount = ( ( UINT64 )List.Count * AML_BENCH_METHOD_ITERATIONS );
+    printf( "Benchmarking %"PRIu64" method(s), %u iteration(s) each.\n", ( UINT64 )List.Count, AML_BENCH_METHOD_ITERATIONS );
+
+    //
+    // Time the regular evaluator first, then build the caches (untimed) and time the cached evaluator.
+    //
+    ElapsedUncached = AmlBenchTimeMethods( &Context->State, &List, AML_BENCH_METHOD_ITERATIONS, &FailuresUncached );
+    EnableRoutine( &Context->State );
+    AmlBenchWarmupMethods( &Context->State, &List );
+    ElapsedCached = AmlBenchTimeMethods( &Context->State, &List, AML_BENCH_METHOD_ITERATIONS, &FailuresCached );
+
+    //
+    // Gather cache statistics of all benchmarked methods.
+    //
+    HitCount = 0;
+    MissCount = 0;
+    for( i = 0; i < List.Count; i++ ) {
+        StatisticsRoutine( List.Methods[ i ], &HitCount, &MissCount );
+    }
+
+    //
+    // Print results.
+    //
+    if( CallCount != 0 ) {
+        printf( "Uncached: %"PRIu64" ns/call (%"PRIu64" failed call(s))\n", ( ElapsedUncached / CallCount ), FailuresUncached );
+        printf( "Cached:   %"PRIu64" ns/call (%"PRIu64" failed call(s))\n", ( ElapsedCached / CallCount ), FailuresCached );
+        if( ElapsedCached != 0 ) {
+            printf( "Speedup:  %.2fx\n", ( ( double )ElapsedUncached / ( double )ElapsedCached ) );
+        }
+    }
+    printf( "Cache:    %"PRIu64" hit(s), %"PRIu64" miss(es)\n", HitCount, MissCount );
+
+    free( List.Methods );
+    AmlStateFree( &Context->State );
+    free( Context );
+    return AML_TRUE;
+}
+
+//
+// Append an encoded PkgLength for the given size of the package contents (excluding the PkgLength itself).
+//
+SIZE_T
+AmlBenchEncodePackageLength(
+    _Out_writes_bytes_( 3 ) UINT8* Output,
+    _In_                    SIZE_T ContentSize
+    )
+{
+    SIZE_T Length;
+
+    if( ( ContentSize + 1 ) <= 0x3F ) {
+        Output[ 0 ] = ( UINT8 )( ContentSize + 1 );
+        return 1;
+    }
+    Length = ( ContentSize + 2 );
+    if( Length <= 0xFFF ) {
+        Output[ 0 ] = ( UINT8 )( ( 1 << 6 ) | ( Length & 0xF ) );
+        Output[ 1 ] = ( UINT8 )( Length >> 4 );
+        return 2;
+    }
+    Length = ( ContentSize + 3 );
+    Output[ 0 ] = ( UINT8 )( ( 2 << 6 ) | ( Length & 0xF ) );
+    Output[ 1 ] = ( UINT8 )( Length >> 4 );
+    Output[ 2 ] = ( UINT8 )( Length >> 12 );
+    return 3;
+}
+
+//
+// Append a synthetic argument-less method definition to the code block,
+// the body initializes Local0 and then repeats the given instruction.
+//
+SIZE_T
+AmlBenchEncodeMethod(
+    _Out_    UINT8*       Output,
+    _In_z_   const CHAR*  Name,
+    _In_opt_ const UINT8* Instruction,
+    _In_     SIZE_T       InstructionSize,
+    _In_     SIZE_T       RepeatCount
+    )
+{
+    static const UINT8 Prologue[ ] = { 0x70, 0x00, 0x60 }; /* Store (Zero, Local0) */
+    SIZE_T             Offset;
+    SIZE_T             i;
+
+    Output[ 0 ] = 0x14; /* MethodOp */
+    Offset = 1;
+    Offset += AmlBenchEncodePackageLength( &Output[ Offset ], ( 4 + 1 + sizeof( Prologue ) + ( InstructionSize * RepeatCount ) ) );
+    AML_MEMCPY( &Output[ Offset ], Name, 4 );
+    Offset += 4;
+    Output[ Offset++ ] = 0; /* MethodFlags */
+    AML_MEMCPY( &Output[ Offset ], Prologue, sizeof( Prologue ) );
+    Offset += sizeof( Prologue );
+    for( i = 0; i < RepeatCount; i++ ) {
+        AML_MEMCPY( &Output[ Offset ], Instruction, InstructionSize );
+        Offset += InstructionSize;
+    }
+    return Offset;
+}
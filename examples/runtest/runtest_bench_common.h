@@ -0,0 +1,395 @@
+#pragma once
+
+#include "runtest_host.h"
+#include "aml_platform.h"
+#include "aml_eval.h"
+
+//
+// Default amount of timed iterations of each benchmarked method.
+//
+#define AML_BENCH_METHOD_ITERATIONS 200
+
+//
+// Full benchmark state (loaded table namespace and host).
+//
+typedef struct _AML_BENCH_CONTEXT {
+    AML_STATE        State;
+    AML_HOST_CONTEXT Host;
+    volatile LONG    AcpiGlobalLock;
+} AML_BENCH_CONTEXT;
+
+//
+// Collected list of benchmarked method objects.
+//
+typedef struct _AML_BENCH_METHOD_LIST {
+    AML_OBJECT** Methods;
+    SIZE_T       Count;
+    SIZE_T       Capacity;
+} AML_BENCH_METHOD_LIST;
+
+//
+// Enable the benchmarked optional state feature.
+//
+typedef
+VOID
+( *AML_BENCH_ENABLE_ROUTINE )(
+    _Inout_ AML_STATE* State
+    );
+
+//
+// Accumulate the cache statistics of a single benchmarked method.
+//
+typedef
+VOID
+( *AML_BENCH_STATISTICS_ROUTINE )(
+    _In_    const AML_OBJECT* Method,
+    _Inout_ UINT64*           pHitCount,
+    _Inout_ UINT64*           pMissCount
+    );
+
+//
+// Benchmark allocator callbacks.
+//
+_Success_( return != NULL )
+VOID*
+AmlBenchMemoryAllocate(
+    _Inout_ VOID*  Context,
+    _In_    SIZE_T Size
+    );
+
+_Success_( return )
+BOOLEAN
+AmlBenchMemoryFree(
+    _Inout_          VOID*  Context,
+    _In_ _Frees_ptr_ VOID*  Allocation,
+    _In_             SIZE_T AllocationSize
+    );
+
+//
+// Current wall-clock time in nanoseconds.
+//
+UINT64
+AmlBenchTimeNs(
+    VOID
+    );
+
+//
+// Create a quiet state and load the given table, followed by an optional additional code block,
+// as part of the initial load (optionally including initial _INI handling).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchLoadTableEx(
+    _Out_                         AML_BENCH_CONTEXT*          Context,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                Code,
+    _In_                          SIZE_T                      CodeSize,
+    _In_                          BOOLEAN                     InitializeDevices
+    );
+
+//
+// Create a quiet state and fully load the given table (including initial _INI/_REG handling).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchLoadTable(
+    _Out_                         AML_BENCH_CONTEXT*          Context,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize
+    );
+
+//
+// Namespace iterator callback, collects all argument-less predefined (_XXX) AML methods.
+// Only predefined control methods are benchmarked, these are the methods repeatedly evaluated by an OS,
+// other methods may be arbitrary test drivers that aren't guaranteed to ever complete.
+//
+AML_ITERATOR_ACTION
+AmlBenchCollectMethod(
+    _In_opt_ VOID*               UserContext,
+    _Inout_  AML_STATE*          State,
+    _Inout_  AML_NAMESPACE_NODE* Node
+    );
+
+//
+// Invoke all methods of the list once (untimed), removes any methods that fail or are too slow.
+//
+VOID
+AmlBenchWarmupMethods(
+    _Inout_ AML_STATE*             State,
+    _Inout_ AML_BENCH_METHOD_LIST* List
+    );
+
+//
+// Time all methods of the list, returns the total elapsed time in nanoseconds.
+//
+UINT64
+AmlBenchTimeMethods(
+    _Inout_ AML_STATE*                   State,
+    _In_    const AML_BENCH_METHOD_LIST* List,
+    _In_    SIZE_T                       Iterations,
+    _Out_   UINT64*                      pFailureCount
+    );
+
+//
+// Compare repeated method invocation performance with and without an optional (cache) feature of the state.
+// Both modes run the same set of argument-less predefined methods of the table, within the same state.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchCompareMethods(
+    _In_reads_bytes_( TableSize ) const UINT8*                 Table,
+    _In_                          SIZE_T                       TableSize,
+    _In_                          AML_BENCH_ENABLE_ROUTINE     EnableRoutine,
+    _In_                          AML_BENCH_STATISTICS_ROUTINE StatisticsRoutine
+    );
+
+//
+// Append an encoded PkgLength for the given size of the package contents (excluding the PkgLength itself).
+//
+SIZE_T
+AmlBenchEncodePackageLength(
+    _Out_writes_bytes_( 3 ) UINT8* Output,
+    _In_                    SIZE_T ContentSize
+    );
+
+//
+// Append a synthetic argument-less method definition to the code block,
+// the body initializes Local0 and then repeats the given instruction.
+//
+SIZE_T
+AmlBenchEncodeMethod(
+    _Out_    UINT8*       Output,
+    _In_z_   const CHAR*  Name,
+    _In_opt_ const UINT8* Instruction,
+    _In_     SIZE_T       InstructionSize,
+    _In_     SIZE_T       RepeatCount
+    );
+
+//
+// Namespace and name lookup benchmarks (runtest_bench_namespace.c).
+//
+
+//
+// Compare repeated method invocation performance with and without the call site name resolution cache.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchNameCache(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Measure table load time with and without a namespace capacity hint,
+// and the lookup time of every namespace node by its absolute path.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchNamespaceMap(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Measure the time of an unprefixed name lookup that resolves to a root-level node from increasingly deep scopes,
+// with the per-level prefix hashes of the scope, and with the previous approach of rehashing every ancestor path.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchScopeDepth(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Compare table load time (both passes and initial device initialization) with and without the namespace pass skip index.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchSkipIndex(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+#ifdef AML_TEST_HAS_THREADS
+//
+// Measure lock-free namespace lookup throughput of an increasing amount of concurrent reader threads,
+// while a writer thread keeps creating and releasing named objects (inserting and removing path map entries,
+// causing periodic path map rehashes, and retiring released nodes).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchConcurrentReaders(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+#endif
+
+//
+// Method evaluation benchmarks (runtest_bench_eval.c).
+//
+
+//
+// Measure the per-opcode throughput of the interpreter.
+// Loads a synthetic code block (alongside the given table) with one method per benchmarked instruction,
+// each method body repeats the instruction, the cost of an empty method body is subtracted from every result.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchOpcodeDispatch(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Compare repeated evaluation of all identification methods of a synthetic set of devices (loaded alongside the given table)
+// with and without the identification method result cache.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchIdentificationCache(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Parallel and asynchronous evaluation benchmarks (runtest_bench_concurrency.c).
+//
+
+#ifdef AML_TEST_HAS_THREADS
+//
+// Initialize a synthetic tree of devices (all with slow _INI methods) serially, and then in parallel on a worker pool,
+// each using a freshly loaded state, the parallel initialization reports its critical path and per-device timing.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchDeviceInit(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+#endif
+
+#if defined(AML_TEST_HAS_THREADS) && defined(AML_TEST_HAS_UCONTEXT)
+//
+// Multiplex a large amount of concurrently pending evaluations over a few worker threads.
+// Every evaluation acquires a mutex, sleeps, waits for an event (until the timeout), and reads from an EC field,
+// the simulated EC region handler pends the access until its device latency has passed.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchAsyncEvaluation(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+#endif
+
+//
+// Operation region and field access benchmarks (runtest_bench_region.c).
+//
+
+//
+// Read and write a 256-bit (unaligned) ByteAcc EC field, with a regular per-word region access handler,
+// and then with an additional vectored handler, counting the handler callbacks that each field access takes.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchRegionVector(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Evaluate a GNVS-style method that repeatedly reads and writes fields of a SystemMemory NVS region,
+// with the regular SystemMemory handler, and with direct access of the region mapping (UseDirectSystemMemoryAccess).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchGnvs(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Evaluate a method that creates a temporary SystemMemory region (cycling through 4 pages) and reads fields of it
+// and of two static overlapping regions, with private host mappings per region, and with the shared mapping cache.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchRegionMap(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Evaluate a method that reads a few fields spread over a 64 MiB SystemMemory region (ROM shadow style, unaligned base,
+// one field straddling a window boundary), with the region mapped entirely, and mapped on demand in windows.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchRegionWindow(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Evaluate a method that reads a named and a temporary PCI_Config region of a device behind two PCI-to-PCI bridges,
+// with the PCI information evaluated and resolved per region, and shared through the PCI topology cache.
+// The bridge buses are renumbered by AML every few invocations, both states must observe the same addresses.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchPciTopology(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Evaluate a CMOS-style method that polls and updates units of an index field behind SystemIO index/data registers,
+// and read all units from the host, with every index written before every access, and with index register elision.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchIndexField(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Table load and state instantiation benchmarks (runtest_bench_state.c).
+//
+
+//
+// Load a 64 KiB SSDT from a SystemMemory region, read through the region space handler in batches of access words,
+// copied straight from the region mapping (direct access), and evaluated in place within the region mapping.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchLoad(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Instantiate states for the given table by fully loading it (including initial _INI/_REG handling),
+// and by cloning an initialized template state, every clone must hold the same amount of nodes as the template.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchClone(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
+
+//
+// Hold many clones of an initialized template state at once, with and without sharing the static named data of the template,
+// and compare the memory private to each clone against the memory shared by all clones.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchShare(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
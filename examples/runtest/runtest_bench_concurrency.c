@@ -0,0 +1,907 @@
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef AML_TEST_HAS_THREADS
+ #include <threads.h>
+#endif
+#ifdef AML_TEST_HAS_UCONTEXT
+ #include <ucontext.h>
+#endif
+#include "runtest_bench_common.h"
+#include "aml_eval_async.h"
+
+//
+// Asynchronous evaluation benchmark parameters, the amount of concurrently started evaluations, the amount of worker threads
+// that they are multiplexed over, the coroutine stack size, and the durations of the waits performed by each evaluation.
+// Suspended event waits are polled by the worker threads at the given interval.
+//
+#define AML_BENCH_ASYNC_TASKS        1000
+#define AML_BENCH_ASYNC_THREADS      4
+#define AML_BENCH_ASYNC_STACK_SIZE   ( 256 * 1024 )
+#define AML_BENCH_ASYNC_SLEEP_MS     10
+#define AML_BENCH_ASYNC_WAIT_MS      5
+#define AML_BENCH_ASYNC_DEVICE_MS    2
+#define AML_BENCH_ASYNC_POLL_MS      1
+#define AML_BENCH_ASYNC_DEVICE_VALUE 0x5A
+
+//
+// Parallel device initialization benchmark parameters, the synthetic device tree has the given amount of root devices,
+// each with the given amount of child devices, the _INI method of every device sleeps for the given duration.
+//
+#define AML_BENCH_DEVICE_INIT_ROOTS    16
+#define AML_BENCH_DEVICE_INIT_CHILDREN 8
+#define AML_BENCH_DEVICE_INIT_SLEEP_MS 2
+#define AML_BENCH_DEVICE_INIT_WORKERS  16
+
+#if defined(AML_TEST_HAS_THREADS) && defined(AML_TEST_HAS_UCONTEXT)
+
+//
+// Coroutine of the asynchronous evaluation benchmark (ucontext based).
+// HostContext holds the context of the host thread that has most recently resumed the coroutine.
+//
+typedef struct _AML_BENCH_COROUTINE {
+    ucontext_t          Context;
+    ucontext_t          HostContext;
+    AML_COROUTINE_ENTRY Entry;
+    VOID*               EntryContext;
+    VOID*               Stack;
+} AML_BENCH_COROUTINE;
+
+//
+// State shared by the asynchronous evaluation benchmark worker threads.
+// The AML state is not thread safe, starting and resuming evaluations is serialized by the state lock.
+//
+typedef struct _AML_BENCH_ASYNC_SHARED {
+    AML_BENCH_CONTEXT*            Context;
+    AML_OBJECT*                   Method;
+    mtx_t                         StateLock;
+    struct _AML_BENCH_ASYNC_TASK* Tasks;
+    SIZE_T                        TaskCount;
+    UINT64                        FinishedCount;
+    UINT64                        PendingCount;
+    UINT64                        MaxPendingCount;
+    UINT64                        ResumeCount;
+    UINT64                        FailureCount;
+} AML_BENCH_ASYNC_SHARED;
+
+//
+// Single asynchronous evaluation of the benchmark.
+// A task is only run by the worker thread that has claimed it, DeviceData is the access data of a pended EC access,
+// which the simulated device completes once DeviceDeadline has passed.
+//
+typedef struct _AML_BENCH_ASYNC_TASK {
+    AML_EVAL_ASYNC          Evaluation;
+    AML_BENCH_ASYNC_SHARED* Shared;
+    AML_REGION_ACCESS_DATA* DeviceData;
+    UINT64                  DeviceDeadline;
+    UINT64                  PollTime;
+    UINT64                  IsClaimed;
+    UINT64                  IsFinished;
+    BOOLEAN                 IsStarted;
+} AML_BENCH_ASYNC_TASK;
+
+//
+// Per-thread state of the asynchronous evaluation benchmark.
+//
+typedef struct _AML_BENCH_ASYNC_WORKER {
+    AML_BENCH_ASYNC_SHARED* Shared;
+    thrd_t                  Thread;
+    SIZE_T                  Index;
+} AML_BENCH_ASYNC_WORKER;
+
+//
+// Atomically add to a shared counter, returns the new value.
+//
+static
+UINT64
+AmlBenchAtomicAdd(
+    _Inout_ UINT64* Counter,
+    _In_    UINT64  Value
+    )
+{
+    UINT64 Current;
+
+    do {
+        Current = AML_ATOMIC_LOAD64( Counter );
+    } while( AML_ATOMIC_COMPARE_EXCHANGE64( Counter, Current, ( Current + Value ) ) != Current );
+    return ( Current + Value );
+}
+
+//
+// Coroutine most recently resumed by the current thread, read by the start trampoline of a coroutine upon its first resume.
+//
+static _Thread_local AML_BENCH_COROUTINE* AmlBenchCoroutineResumed;
+
+//
+// Coroutine start trampoline, makecontext can't portably pass pointer arguments, the coroutine is passed through AmlBenchCoroutineResumed.
+//
+static
+VOID
+AmlBenchCoroutineStart(
+    VOID
+    )
+{
+    AML_BENCH_COROUTINE* Coroutine;
+
+    Coroutine = AmlBenchCoroutineResumed;
+    Coroutine->Entry( Coroutine->EntryContext );
+}
+
+//
+// Benchmark coroutine interface callbacks.
+//
+_Success_( return != NULL )
+static
+VOID*
+AmlBenchCoroutineCreate(
+    _Inout_opt_ VOID*               Context,
+    _In_        AML_COROUTINE_ENTRY Entry,
+    _Inout_     VOID*               EntryContext
+    )
+{
+    AML_BENCH_COROUTINE* volatile Coroutine; /* getcontext may return twice, Coroutine must not be clobbered. */
+
+    if( ( Coroutine = calloc( 1, sizeof( *Coroutine ) ) ) == NULL ) {
+        return NULL;
+    } else if( ( Coroutine->Stack = malloc( AML_BENCH_ASYNC_STACK_SIZE ) ) == NULL ) {
+        free( Coroutine );
+        return NULL;
+    } else if( getcontext( &Coroutine->Context ) != 0 ) {
+        free( Coroutine->Stack );
+        free( Coroutine );
+        return NULL;
+    }
+    Coroutine->Entry = Entry;
+    Coroutine->EntryContext = EntryContext;
+    Coroutine->Context.uc_stack.ss_sp = Coroutine->Stack;
+    Coroutine->Context.uc_stack.ss_size = AML_BENCH_ASYNC_STACK_SIZE;
+    Coroutine->Context.uc_link = NULL;
+    makecontext( &Coroutine->Context, AmlBenchCoroutineStart, 0 );
+    return Coroutine;
+}
+
+static
+VOID
+AmlBenchCoroutineResume(
+    _Inout_opt_ VOID* Context,
+    _Inout_     VOID* Coroutine
+    )
+{
+    AmlBenchCoroutineResumed = Coroutine;
+    swapcontext( &( ( AML_BENCH_COROUTINE* )Coroutine )->HostContext, &( ( AML_BENCH_COROUTINE* )Coroutine )->Context );
+}
+
+static
+VOID
+AmlBenchCoroutineYield(
+    _Inout_opt_ VOID* Context,
+    _Inout_     VOID* Coroutine
+    )
+{
+    swapcontext( &( ( AML_BENCH_COROUTINE* )Coroutine )->Context, &( ( AML_BENCH_COROUTINE* )Coroutine )->HostContext );
+}
+
+static
+VOID
+AmlBenchCoroutineFree(
+    _Inout_opt_            VOID* Context,
+    _Inout_ _Post_invalid_ VOID* Coroutine
+    )
+{
+    free( ( ( AML_BENCH_COROUTINE* )Coroutine )->Stack );
+    free( Coroutine );
+}
+
+//
+// Simulated asynchronous EC region access handler, pends every access of an asynchronous evaluation,
+// the access is then completed by the worker thread that resumes the evaluation once the device latency has passed.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchAsyncRegionHandler(
+    _Inout_     AML_STATE*                   State,
+    _Inout_     AML_OBJECT_OPERATION_REGION* Region,
+    _Inout_     VOID*                        UserContext,
+    _Inout_opt_ AML_OBJECT_FIELD*            Field,
+    _In_        AML_REGION_ACCESS_TYPE       AccessType,
+    _In_        UINT8                        AccessAttribute,
+    _In_        UINT64                       AccessOffset,
+    _In_        UINT64                       AccessBitWidth,
+    _Inout_     AML_REGION_ACCESS_DATA*      Data
+    )
+{
+    AML_BENCH_ASYNC_TASK* Task;
+
+    //
+    // Complete accesses of regular evaluations synchronously.
+    //
+    if( ( Task = ( AML_BENCH_ASYNC_TASK* )AmlEvalAsyncPendRegionAccess( State ) ) == NULL ) {
+        if( AccessType == AML_REGION_ACCESS_TYPE_READ ) {
+            Data->Word = AML_BENCH_ASYNC_DEVICE_VALUE;
+        }
+        return AML_TRUE;
+    }
+    Task->DeviceData = ( ( AccessType == AML_REGION_ACCESS_TYPE_READ ) ? Data : NULL );
+    Task->DeviceDeadline = ( AmlHostMonotonicTimer( State->Host ) + ( AML_BENCH_ASYNC_DEVICE_MS * 10000 ) );
+    return AML_TRUE;
+}
+
+//
+// Completion routine of the benchmarked evaluations, validates the returned (device) value.
+//
+static
+VOID
+AmlBenchAsyncCompletion(
+    _Inout_opt_ VOID*           UserContext,
+    _Inout_     AML_STATE*      State,
+    _Inout_     AML_EVAL_ASYNC* Evaluation,
+    _In_opt_    const AML_DATA* Result
+    )
+{
+    AML_BENCH_ASYNC_SHARED* Shared;
+
+    Shared = UserContext;
+    if( ( Result == NULL ) || ( Result->Type != AML_DATA_TYPE_INTEGER ) || ( Result->u.Integer != AML_BENCH_ASYNC_DEVICE_VALUE ) ) {
+        AmlBenchAtomicAdd( &Shared->FailureCount, 1 );
+    }
+}
+
+//
+// Start or resume the given (claimed) task if it is runnable, returns AML_FALSE if the task is still waiting.
+//
+static
+BOOLEAN
+AmlBenchAsyncRunTask(
+    _Inout_ AML_BENCH_ASYNC_TASK* Task
+    )
+{
+    AML_BENCH_ASYNC_SHARED*   Shared;
+    const AML_WAIT_CONDITION* Condition;
+    AML_EVAL_ASYNC_STATUS     Status;
+    UINT64                    Now;
+    UINT64                    PendingCount;
+    UINT64                    MaxPendingCount;
+
+    Shared = Task->Shared;
+    Now = AmlHostMonotonicTimer( &Shared->Context->Host );
+    if( Task->IsStarted == AML_FALSE ) {
+        Task->IsStarted = AML_TRUE;
+        PendingCount = AmlBenchAtomicAdd( &Shared->PendingCount, 1 );
+        do {
+            MaxPendingCount = AML_ATOMIC_LOAD64( &Shared->MaxPendingCount );
+        } while( ( PendingCount > MaxPendingCount )
+                 && ( AML_ATOMIC_COMPARE_EXCHANGE64( &Shared->MaxPendingCount, MaxPendingCount, PendingCount ) != MaxPendingCount ) );
+        mtx_lock( &Shared->StateLock );
+        Status = AmlEvalObjectAsync( &Task->Evaluation, Shared->Method, AML_TRUE, AmlBenchAsyncCompletion, Shared );
+        mtx_unlock( &Shared->StateLock );
+    } else {
+        //
+        // Check the wake condition, event and mutex waits are polled.
+        //
+        Condition = &Task->Evaluation.WaitCondition;
+        switch( Condition->Type ) {
+        case AML_WAIT_CONDITION_TYPE_SLEEP:
+            if( Now < Condition->Deadline ) {
+                return AML_FALSE;
+            }
+            break;
+        case AML_WAIT_CONDITION_TYPE_EVENT:
+        case AML_WAIT_CONDITION_TYPE_MUTEX:
+            if( ( Now < Condition->Deadline ) && ( Now < Task->PollTime ) ) {
+                return AML_FALSE;
+            }
+            break;
+        case AML_WAIT_CONDITION_TYPE_REGION:
+            if( Now < Task->DeviceDeadline ) {
+                return AML_FALSE;
+            }
+            if( Task->DeviceData != NULL ) {
+                Task->DeviceData->Word = AML_BENCH_ASYNC_DEVICE_VALUE;
+            }
+            AmlEvalAsyncCompleteRegionAccess( &Task->Evaluation, AML_TRUE );
+            break;
+        default:
+            break;
+        }
+        mtx_lock( &Shared->StateLock );
+        Status = AmlEvalAsyncResume( &Task->Evaluation );
+        mtx_unlock( &Shared->StateLock );
+    }
+    AmlBenchAtomicAdd( &Shared->ResumeCount, 1 );
+
+    //
+    // Count finished tasks.
+    //
+    if( Status == AML_EVAL_ASYNC_STATUS_PENDING ) {
+        Task->PollTime = ( AmlHostMonotonicTimer( &Shared->Context->Host ) + ( AML_BENCH_ASYNC_POLL_MS * 10000 ) );
+        return AML_TRUE;
+    } else if( Status != AML_EVAL_ASYNC_STATUS_COMPLETED ) {
+        AmlBenchAtomicAdd( &Shared->FailureCount, 1 );
+    }
+    AmlBenchAtomicAdd( &Shared->PendingCount, ( UINT64 )-1 );
+    AML_ATOMIC_STORE64( &Task->IsFinished, 1 );
+    AmlBenchAtomicAdd( &Shared->FinishedCount, 1 );
+    return AML_TRUE;
+}
+
+//
+// Worker thread routine, repeatedly claims and runs all runnable tasks until every task has finished.
+//
+static
+INT
+AmlBenchAsyncWorkerThread(
+    _Inout_ VOID* Argument
+    )
+{
+    AML_BENCH_ASYNC_WORKER* Worker;
+    AML_BENCH_ASYNC_SHARED* Shared;
+    AML_BENCH_ASYNC_TASK*   Task;
+    SIZE_T                  Start;
+    SIZE_T                  i;
+    BOOLEAN                 IsProgress;
+
+    Worker = Argument;
+    Shared = Worker->Shared;
+    Start = ( ( Worker->Index * Shared->TaskCount ) / AML_BENCH_ASYNC_THREADS );
+    while( AML_ATOMIC_LOAD64( &Shared->FinishedCount ) < Shared->TaskCount ) {
+        IsProgress = AML_FALSE;
+        for( i = 0; i < Shared->TaskCount; i++ ) {
+            Task = &Shared->Tasks[ ( ( Start + i ) % Shared->TaskCount ) ];
+            if( AML_ATOMIC_LOAD64( &Task->IsFinished ) != 0 ) {
+                continue;
+            } else if( AML_ATOMIC_COMPARE_EXCHANGE64( &Task->IsClaimed, 0, 1 ) != 0 ) {
+                continue;
+            }
+            IsProgress |= AmlBenchAsyncRunTask( Task );
+            AML_ATOMIC_STORE64( &Task->IsClaimed, 0 );
+        }
+        if( IsProgress == AML_FALSE ) {
+            thrd_sleep( &( struct timespec ){ .tv_nsec = 100000 }, NULL );
+        }
+    }
+    return 0;
+}
+
+//
+// Multiplex a large amount of concurrently pending evaluations over a few worker threads.
+// Every evaluation acquires a mutex, sleeps, waits for an event (until the timeout), and reads from an EC field,
+// the simulated EC region handler pends the access until its device latency has passed.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchAsyncEvaluation(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x5B, 0x01, 'Z', 'A', 'M', 'X', 0x00,                         /* Mutex (ZAMX, 0) */
+        0x5B, 0x02, 'Z', 'A', 'E', 'V',                               /* Event (ZAEV) */
+        0x5B, 0x80, 'Z', 'A', 'E', 'R', 0x03, 0x00, 0x0A, 0x10,       /* OperationRegion (ZAER, EmbeddedControl, Zero, 0x10) */
+        0x5B, 0x81, 0x0B, 'Z', 'A', 'E', 'R', 0x01, 'Z', 'A', 'E', 'F', 0x08, /* Field (ZAER, ByteAcc) { ZAEF, 8 } */
+        0x14, 0x25, 'Z', 'A', 'S', 'Y', 0x00,                         /* Method (ZASY) */
+        0x5B, 0x23, 'Z', 'A', 'M', 'X', 0xFF, 0xFF,                   /*   Acquire (ZAMX, 0xFFFF) */
+        0x5B, 0x27, 'Z', 'A', 'M', 'X',                               /*   Release (ZAMX) */
+        0x5B, 0x22, 0x0A, AML_BENCH_ASYNC_SLEEP_MS,                   /*   Sleep (AML_BENCH_ASYNC_SLEEP_MS) */
+        0x5B, 0x25, 'Z', 'A', 'E', 'V', 0x0A, AML_BENCH_ASYNC_WAIT_MS, /*   Wait (ZAEV, AML_BENCH_ASYNC_WAIT_MS) */
+        0xA4, 'Z', 'A', 'E', 'F',                                     /*   Return (ZAEF) */
+    };
+    AML_BENCH_CONTEXT*     Context;
+    AML_BENCH_ASYNC_SHARED Shared;
+    AML_BENCH_ASYNC_WORKER Workers[ AML_BENCH_ASYNC_THREADS ];
+    AML_COROUTINE_ROUTINES Routines;
+    AML_NAMESPACE_NODE*    Node;
+    AML_DATA               Result;
+    SIZE_T                 InitializedCount;
+    SIZE_T                 StartedCount;
+    SIZE_T                 i;
+    UINT64                 Start;
+    UINT64                 Elapsed;
+    UINT64                 BlockingMs;
+    BOOLEAN                Success;
+
+    //
+    // Load the table and the synthetic code block, and register the simulated EC region handler.
+    //
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    }
+    if( ( AmlEvalLoadedTableCode( &Context->State, Code, sizeof( Code ), NULL ) == AML_FALSE )
+        || ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZASY", 0, &Node ) == AML_FALSE )
+        || ( Node->Object->Type != AML_OBJECT_TYPE_METHOD )
+        || ( AmlRegisterRegionSpaceAccessHandler( &Context->State, AML_REGION_SPACE_TYPE_EMBEDDED_CONTROL, AmlBenchAsyncRegionHandler, NULL, AML_FALSE ) == AML_FALSE ) )
+    {
+        printf( "Error: failed to load the synthetic benchmark methods!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Evaluate the method once synchronously (the region handler completes the access directly).
+    //
+    if( ( AmlEvalObject( &Context->State, Node->Object, &Result, AML_TRUE ) == AML_FALSE )
+        || ( Result.Type != AML_DATA_TYPE_INTEGER )
+        || ( Result.u.Integer != AML_BENCH_ASYNC_DEVICE_VALUE ) )
+    {
+        printf( "Error: synchronous evaluation of the synthetic method failed!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+    AmlDataFree( &Result );
+
+    //
+    // Initialize all asynchronous evaluations, each with its own execution context.
+    //
+    Shared = ( AML_BENCH_ASYNC_SHARED ){ .Context = Context, .Method = Node->Object, .TaskCount = AML_BENCH_ASYNC_TASKS };
+    if( mtx_init( &Shared.StateLock, mtx_plain ) != thrd_success ) {
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    } else if( ( Shared.Tasks = calloc( Shared.TaskCount, sizeof( Shared.Tasks[ 0 ] ) ) ) == NULL ) {
+        mtx_destroy( &Shared.StateLock );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+    Routines = ( AML_COROUTINE_ROUTINES ){
+        .Create = AmlBenchCoroutineCreate,
+        .Resume = AmlBenchCoroutineResume,
+        .Yield  = AmlBenchCoroutineYield,
+        .Free   = AmlBenchCoroutineFree
+    };
+    Success = AML_TRUE;
+    for( InitializedCount = 0; InitializedCount < Shared.TaskCount; InitializedCount++ ) {
+        Shared.Tasks[ InitializedCount ].Shared = &Shared;
+        if( AmlEvalAsyncInitialize( &Shared.Tasks[ InitializedCount ].Evaluation, &Context->State, &Routines ) == AML_FALSE ) {
+            Success = AML_FALSE;
+            break;
+        }
+    }
+
+    //
+    // Run all evaluations to completion from the worker threads.
+    //
+    printf( "Running %u asynchronous evaluation(s) over %u worker thread(s), each waits for %u ms (Sleep), %u ms (Wait timeout), %u ms (pended EC read).\n",
+            AML_BENCH_ASYNC_TASKS,
+            AML_BENCH_ASYNC_THREADS,
+            AML_BENCH_ASYNC_SLEEP_MS,
+            AML_BENCH_ASYNC_WAIT_MS,
+            AML_BENCH_ASYNC_DEVICE_MS );
+    Start = AmlBenchTimeNs();
+    StartedCount = 0;
+    for( i = 0; ( i < AML_BENCH_ASYNC_THREADS ) && Success; i++ ) {
+        Workers[ i ] = ( AML_BENCH_ASYNC_WORKER ){ .Shared = &Shared, .Index = i };
+        if( thrd_create( &Workers[ i ].Thread, AmlBenchAsyncWorkerThread, &Workers[ i ] ) != thrd_success ) {
+            Success = AML_FALSE;
+            break;
+        }
+        StartedCount++;
+    }
+    if( Success == AML_FALSE ) {
+        AML_ATOMIC_STORE64( &Shared.FinishedCount, Shared.TaskCount );
+    }
+    for( i = 0; i < StartedCount; i++ ) {
+        thrd_join( Workers[ i ].Thread, NULL );
+    }
+    Elapsed = ( AmlBenchTimeNs() - Start );
+
+    //
+    // Print results, compared against the minimum time needed if every evaluation blocked its worker thread.
+    //
+    if( Success ) {
+        BlockingMs = ( ( ( UINT64 )AML_BENCH_ASYNC_TASKS * ( AML_BENCH_ASYNC_SLEEP_MS + AML_BENCH_ASYNC_WAIT_MS + AML_BENCH_ASYNC_DEVICE_MS ) ) / AML_BENCH_ASYNC_THREADS );
+        printf( "Elapsed:  %"PRIu64" ms (blocking evaluation on the same threads: >= %"PRIu64" ms)\n", ( Elapsed / 1000000 ), BlockingMs );
+        printf( "Resumes:  %"PRIu64" (%.1f per evaluation), %"PRIu64" evaluation(s) pending at most\n",
+                Shared.ResumeCount,
+                ( ( double )Shared.ResumeCount / ( double )Shared.TaskCount ),
+                Shared.MaxPendingCount );
+        printf( "Failed:   %"PRIu64"\n", Shared.FailureCount );
+        Success = ( Shared.FailureCount == 0 );
+    }
+    if( Success == AML_FALSE ) {
+        printf( "Error: one or more asynchronous evaluations failed!\n" );
+    }
+
+    for( i = 0; i < InitializedCount; i++ ) {
+        AmlEvalAsyncFree( &Shared.Tasks[ i ].Evaluation );
+    }
+    free( Shared.Tasks );
+    mtx_destroy( &Shared.StateLock );
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+#endif
+
+#ifdef AML_TEST_HAS_THREADS
+
+//
+// Work item queued to the benchmark worker pool.
+//
+typedef struct _AML_BENCH_POOL_ITEM {
+    struct _AML_BENCH_POOL_ITEM* Next;
+    AML_WORK_ROUTINE             Routine;
+    VOID*                        WorkContext;
+} AML_BENCH_POOL_ITEM;
+
+//
+// Simple worker pool (FIFO queue of work items), OutstandingCount counts queued and running work items.
+//
+typedef struct _AML_BENCH_POOL {
+    mtx_t                Lock;
+    cnd_t                WorkAvailable;
+    cnd_t                WorkDone;
+    AML_BENCH_POOL_ITEM* Head;
+    AML_BENCH_POOL_ITEM* Tail;
+    SIZE_T               OutstandingCount;
+    BOOLEAN              IsShutdown;
+    thrd_t               Threads[ AML_BENCH_DEVICE_INIT_WORKERS ];
+    SIZE_T               ThreadCount;
+} AML_BENCH_POOL;
+
+//
+// Per-device timing collected by the parallel device initialization benchmark.
+//
+typedef struct _AML_BENCH_DEVICE_INIT_TIMING {
+    UINT64 DeviceCount;
+    UINT64 MaxInitTime;
+    UINT64 MaxPathTime;
+} AML_BENCH_DEVICE_INIT_TIMING;
+
+//
+// Worker pool thread routine, runs queued work items until the pool is shut down.
+//
+static
+INT
+AmlBenchPoolThread(
+    _Inout_ VOID* Argument
+    )
+{
+    AML_BENCH_POOL*      Pool;
+    AML_BENCH_POOL_ITEM* Item;
+
+    Pool = Argument;
+    mtx_lock( &Pool->Lock );
+    for( ;; ) {
+        while( ( Pool->Head == NULL ) && ( Pool->IsShutdown == AML_FALSE ) ) {
+            cnd_wait( &Pool->WorkAvailable, &Pool->Lock );
+        }
+        if( ( Item = Pool->Head ) == NULL ) {
+            break;
+        }
+        if( ( Pool->Head = Item->Next ) == NULL ) {
+            Pool->Tail = NULL;
+        }
+        mtx_unlock( &Pool->Lock );
+        Item->Routine( Item->WorkContext );
+        free( Item );
+        mtx_lock( &Pool->Lock );
+        if( --Pool->OutstandingCount == 0 ) {
+            cnd_broadcast( &Pool->WorkDone );
+        }
+    }
+    mtx_unlock( &Pool->Lock );
+    return 0;
+}
+
+//
+// Worker pool submit callback, queues the work item for the next idle worker thread.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchPoolSubmit(
+    _Inout_opt_ VOID*            Context,
+    _In_        AML_WORK_ROUTINE Routine,
+    _Inout_     VOID*            WorkContext
+    )
+{
+    AML_BENCH_POOL*      Pool;
+    AML_BENCH_POOL_ITEM* Item;
+
+    Pool = Context;
+    if( ( Item = malloc( sizeof( *Item ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    *Item = ( AML_BENCH_POOL_ITEM ){ .Routine = Routine, .WorkContext = WorkContext };
+    mtx_lock( &Pool->Lock );
+    if( Pool->Tail != NULL ) {
+        Pool->Tail->Next = Item;
+    } else {
+        Pool->Head = Item;
+    }
+    Pool->Tail = Item;
+    Pool->OutstandingCount += 1;
+    cnd_signal( &Pool->WorkAvailable );
+    mtx_unlock( &Pool->Lock );
+    return AML_TRUE;
+}
+
+//
+// Worker pool wait callback, waits until all queued and running work items have finished.
+//
+static
+VOID
+AmlBenchPoolWait(
+    _Inout_opt_ VOID* Context
+    )
+{
+    AML_BENCH_POOL* Pool;
+
+    Pool = Context;
+    mtx_lock( &Pool->Lock );
+    while( Pool->OutstandingCount != 0 ) {
+        cnd_wait( &Pool->WorkDone, &Pool->Lock );
+    }
+    mtx_unlock( &Pool->Lock );
+}
+
+//
+// Create the benchmark worker pool threads.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchPoolCreate(
+    _Out_ AML_BENCH_POOL* Pool
+    )
+{
+    *Pool = ( AML_BENCH_POOL ){ 0 };
+    if( mtx_init( &Pool->Lock, mtx_plain ) != thrd_success ) {
+        return AML_FALSE;
+    } else if( cnd_init( &Pool->WorkAvailable ) != thrd_success ) {
+        mtx_destroy( &Pool->Lock );
+        return AML_FALSE;
+    } else if( cnd_init( &Pool->WorkDone ) != thrd_success ) {
+        cnd_destroy( &Pool->WorkAvailable );
+        mtx_destroy( &Pool->Lock );
+        return AML_FALSE;
+    }
+    for( Pool->ThreadCount = 0; Pool->ThreadCount < AML_COUNTOF( Pool->Threads ); Pool->ThreadCount++ ) {
+        if( thrd_create( &Pool->Threads[ Pool->ThreadCount ], AmlBenchPoolThread, Pool ) != thrd_success ) {
+            break;
+        }
+    }
+    return ( Pool->ThreadCount != 0 );
+}
+
+//
+// Shut down and join all benchmark worker pool threads, all work items must have finished.
+//
+static
+VOID
+AmlBenchPoolFree(
+    _Inout_ AML_BENCH_POOL* Pool
+    )
+{
+    SIZE_T i;
+
+    mtx_lock( &Pool->Lock );
+    Pool->IsShutdown = AML_TRUE;
+    cnd_broadcast( &Pool->WorkAvailable );
+    mtx_unlock( &Pool->Lock );
+    for( i = 0; i < Pool->ThreadCount; i++ ) {
+        thrd_join( Pool->Threads[ i ], NULL );
+    }
+    cnd_destroy( &Pool->WorkDone );
+    cnd_destroy( &Pool->WorkAvailable );
+    mtx_destroy( &Pool->Lock );
+}
+
+//
+// Device initialization timing callback, called with the scheduler lock held.
+//
+static
+VOID
+AmlBenchDeviceInitTiming(
+    _Inout_opt_ VOID*               UserContext,
+    _Inout_     struct _AML_STATE*  State,
+    _In_        AML_NAMESPACE_NODE* Node,
+    _In_        UINT64              InitTime,
+    _In_        UINT64              PathTime
+    )
+{
+    AML_BENCH_DEVICE_INIT_TIMING* Timing;
+
+    Timing = UserContext;
+    Timing->DeviceCount += 1;
+    Timing->MaxInitTime  = AML_MAX( Timing->MaxInitTime, InitTime );
+    Timing->MaxPathTime  = AML_MAX( Timing->MaxPathTime, PathTime );
+}
+
+//
+// Append a synthetic device definition with a sleeping _INI method to the code block, followed by the given child devices.
+//
+static
+SIZE_T
+AmlBenchEncodeSleepingDevice(
+    _Out_                          UINT8*       Output,
+    _In_z_                         const CHAR*  Name,
+    _In_reads_bytes_( ChildSize )  const UINT8* Children,
+    _In_                           SIZE_T       ChildSize
+    )
+{
+    static const UINT8 Initializer[ ] = {
+        0x14, 0x0A, '_', 'I', 'N', 'I', 0x00,          /* Method (_INI) */
+        0x5B, 0x22, 0x0A, AML_BENCH_DEVICE_INIT_SLEEP_MS, /*   Sleep (AML_BENCH_DEVICE_INIT_SLEEP_MS) */
+    };
+    SIZE_T Offset;
+
+    Output[ 0 ] = 0x5B; /* DeviceOp */
+    Output[ 1 ] = 0x82;
+    Offset = 2;
+    Offset += AmlBenchEncodePackageLength( &Output[ Offset ], ( 4 + sizeof( Initializer ) + ChildSize ) );
+    AML_MEMCPY( &Output[ Offset ], Name, 4 );
+    Offset += 4;
+    AML_MEMCPY( &Output[ Offset ], Initializer, sizeof( Initializer ) );
+    Offset += sizeof( Initializer );
+    if( ChildSize != 0 ) {
+        AML_MEMCPY( &Output[ Offset ], Children, ChildSize );
+        Offset += ChildSize;
+    }
+    return Offset;
+}
+
+//
+// Initialize a synthetic tree of devices (all with slow _INI methods) serially, and then on a worker pool (overlapping their sleeps),
+// each using a freshly loaded state, the parallel initialization reports its critical path and per-device timing.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchDeviceInit(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    UINT8*                       Code;
+    UINT8*                       Children;
+    UINT8*                       Roots;
+    SIZE_T                       CodeSize;
+    SIZE_T                       ChildSize;
+    SIZE_T                       RootSize;
+    SIZE_T                       i;
+    SIZE_T                       j;
+    CHAR                         Name[ 5 ];
+    AML_BENCH_CONTEXT*           Context;
+    AML_NAMESPACE_NODE*          Node;
+    AML_BENCH_POOL               Pool;
+    AML_WORKER_POOL              WorkerPool;
+    AML_BENCH_DEVICE_INIT_TIMING Timing;
+    AML_DEVICE_INIT_STATISTICS   Statistics;
+    UINT64                       Start;
+    UINT64                       SerialNs;
+    UINT64                       ParallelNs;
+    double                       TicksToUs;
+    BOOLEAN                      Success;
+
+    //
+    // Build the synthetic device tree below a single container device (ZDIN),
+    // the children of each root device are encoded at the start of the scratch buffer, and all root devices after them.
+    //
+    Code = malloc( 0x10000 );
+    Children = malloc( 0x10000 );
+    Context = malloc( sizeof( *Context ) );
+    if( ( Code == NULL ) || ( Children == NULL ) || ( Context == NULL ) ) {
+        free( Code );
+        free( Children );
+        free( Context );
+        return AML_FALSE;
+    }
+    RootSize = 0;
+    Roots = &Children[ 0x8000 ];
+    for( i = 0; i < AML_BENCH_DEVICE_INIT_ROOTS; i++ ) {
+        ChildSize = 0;
+        for( j = 0; j < AML_BENCH_DEVICE_INIT_CHILDREN; j++ ) {
+            snprintf( Name, sizeof( Name ), "ZC%02X", ( UINT )j );
+            ChildSize += AmlBenchEncodeSleepingDevice( &Children[ ChildSize ], Name, NULL, 0 );
+        }
+        snprintf( Name, sizeof( Name ), "ZR%02X", ( UINT )i );
+        RootSize += AmlBenchEncodeSleepingDevice( &Roots[ RootSize ], Name, Children, ChildSize );
+    }
+    Code[ 0 ] = 0x5B; /* Device (ZDIN) */
+    Code[ 1 ] = 0x82;
+    CodeSize = 2;
+    CodeSize += AmlBenchEncodePackageLength( &Code[ CodeSize ], ( 4 + RootSize ) );
+    AML_MEMCPY( &Code[ CodeSize ], "ZDIN", 4 );
+    CodeSize += 4;
+    AML_MEMCPY( &Code[ CodeSize ], Roots, RootSize );
+    CodeSize += RootSize;
+
+    //
+    // Serially initialize the synthetic devices of a fresh state.
+    //
+    printf( "Initializing %u device(s) (%u with %u children each), every _INI sleeps for %u ms.\n",
+            ( AML_BENCH_DEVICE_INIT_ROOTS * ( AML_BENCH_DEVICE_INIT_CHILDREN + 1 ) ),
+            AML_BENCH_DEVICE_INIT_ROOTS,
+            AML_BENCH_DEVICE_INIT_CHILDREN,
+            AML_BENCH_DEVICE_INIT_SLEEP_MS );
+    Success = AML_FALSE;
+    SerialNs = 0;
+    if( AmlBenchLoadTableEx( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize, Code, CodeSize, AML_FALSE ) ) {
+        Context->Host.IsSleepEnabled = AML_TRUE;
+        if( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZDIN", 0, &Node ) ) {
+            Start = AmlBenchTimeNs();
+            Success = AmlInitializeDevices( &Context->State, &Node->TreeEntry, AML_FALSE );
+            SerialNs = ( AmlBenchTimeNs() - Start );
+        }
+        AmlStateFree( &Context->State );
+    }
+    if( Success == AML_FALSE ) {
+        printf( "Error: serial device initialization failed!\n" );
+        free( Code );
+        free( Children );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Initialize the synthetic devices of another fresh state in parallel.
+    //
+    Success = AML_FALSE;
+    ParallelNs = 0;
+    Timing = ( AML_BENCH_DEVICE_INIT_TIMING ){ 0 };
+    Statistics = ( AML_DEVICE_INIT_STATISTICS ){ 0 };
+    if( AmlBenchPoolCreate( &Pool ) ) {
+        WorkerPool = ( AML_WORKER_POOL ){
+            .Context     = &Pool,
+            .WorkerCount = Pool.ThreadCount,
+            .Submit      = AmlBenchPoolSubmit,
+            .Wait        = AmlBenchPoolWait
+        };
+        if( AmlBenchLoadTableEx( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize, Code, CodeSize, AML_FALSE ) ) {
+            Context->Host.IsSleepEnabled = AML_TRUE;
+            if( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZDIN", 0, &Node ) ) {
+                Start = AmlBenchTimeNs();
+                Success = AmlInitializeDevicesParallel(
+                    &Context->State,
+                    &Node->TreeEntry,
+                    AML_FALSE,
+                    &( AML_DEVICE_INIT_PARAMETERS ){
+                        .Pool          = &WorkerPool,
+                        .TimingRoutine = AmlBenchDeviceInitTiming,
+                        .TimingContext = &Timing
+                    },
+                    &Statistics
+                );
+                ParallelNs = ( AmlBenchTimeNs() - Start );
+            }
+            AmlStateFree( &Context->State );
+        }
+        AmlBenchPoolFree( &Pool );
+    }
+    if( Success == AML_FALSE ) {
+        printf( "Error: parallel device initialization failed!\n" );
+    } else {
+        //
+        // The runtest monotonic timer isn't calibrated to 100ns, convert timer values to wall-clock time
+        // using the elapsed time of the parallel initialization as measured by both clocks.
+        //
+        TicksToUs = ( ( double )( ParallelNs / 1000 ) / ( double )AML_MAX( Statistics.ElapsedTime, 1 ) );
+        printf( "Serial:        %"PRIu64" ms\n", ( SerialNs / 1000000 ) );
+        printf( "Parallel:      %"PRIu64" ms (%u worker threads, serialized evaluation)\n", ( ParallelNs / 1000000 ), ( UINT )WorkerPool.WorkerCount );
+        printf( "Devices:       %"PRIu64" (%"PRIu64" timed, %"PRIu64" failed), total init time %.1f ms, slowest device %.1f ms\n",
+                Statistics.DeviceCount,
+                Timing.DeviceCount,
+                Statistics.FailedDeviceCount,
+                ( ( ( double )Statistics.TotalTime * TicksToUs ) / 1000.0 ),
+                ( ( ( double )Timing.MaxInitTime * TicksToUs ) / 1000.0 ) );
+        printf( "Critical path: %.1f ms\n", ( ( ( double )Statistics.CriticalPathTime * TicksToUs ) / 1000.0 ) );
+        if( Statistics.FailedDeviceCount != 0 ) {
+            printf( "Error: %"PRIu64" device(s) failed to initialize!\n", Statistics.FailedDeviceCount );
+            Success = AML_FALSE;
+        }
+    }
+
+    free( Code );
+    free( Children );
+    free( Context );
+    return Success;
+}
+
+#endif
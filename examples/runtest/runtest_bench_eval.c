@@ -0,0 +1,362 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "runtest_bench_common.h"
+
+//
+// Amount of copies of the benchmarked instruction within each synthetic method body,
+// and amount of timed invocations of each synthetic method by the opcode dispatch benchmark.
+//
+#define AML_BENCH_OPCODE_REPEAT     256
+#define AML_BENCH_OPCODE_ITERATIONS 2000
+
+//
+// Amount of synthetic devices (each with _HID, _UID, _ADR, and _SUN methods) of the identification method cache benchmark.
+//
+#define AML_BENCH_ID_DEVICE_COUNT 200
+
+//
+// Single instruction timed by the opcode dispatch benchmark.
+// The instruction may use Local0, which is initialized to Zero at the start of the method body.
+//
+typedef struct _AML_BENCH_OPCODE_CASE {
+    const CHAR* Name;
+    const CHAR* Class;
+    UINT8       Code[ 8 ];
+    SIZE_T      CodeSize;
+} AML_BENCH_OPCODE_CASE;
+
+//
+// Instructions timed by the opcode dispatch benchmark, covering every opcode class handled by AmlEvalTerm.
+// ZOPN is an empty method created alongside the synthetic methods.
+//
+static const AML_BENCH_OPCODE_CASE AmlBenchOpcodeCases[ ] = {
+    { "Noop",                      "Statement",      { 0xA3 },                         1 },
+    { "If (Zero) {}",              "Statement",      { 0xA0, 0x02, 0x00 },             3 },
+    { "Store (One, Local0)",       "Expression",     { 0x70, 0x01, 0x60 },             3 },
+    { "Add (Local0, One, Local0)", "Expression",     { 0x72, 0x60, 0x01, 0x60 },       4 },
+    { "Increment (Local0)",        "Expression",     { 0x75, 0x60 },                   2 },
+    { "LEqual (Local0, Zero)",     "Expression",     { 0x93, 0x60, 0x00 },             3 },
+    { "LNotEqual (Local0, Zero)",  "Expression",     { 0x92, 0x93, 0x60, 0x00 },       4 },
+    { "CondRefOf (Local0)",        "Expression",     { 0x5B, 0x12, 0x60, 0x00 },       4 },
+    { "Buffer (1) {}",             "DataExpression", { 0x11, 0x04, 0x0A, 0x01, 0x00 }, 5 },
+    { "One",                       "DataObject",     { 0x01 },                         1 },
+    { "ZOPN ()",                   "None",           { 'Z', 'O', 'P', 'N' },           4 },
+};
+
+//
+// Invoke the given method the given amount of times, returns the total elapsed time in nanoseconds.
+//
+static
+UINT64
+AmlBenchTimeMethod(
+    _Inout_ AML_STATE*  State,
+    _In_    AML_OBJECT* Method,
+    _In_    SIZE_T      Iterations,
+    _Inout_ UINT64*     pFailureCount
+    )
+{
+    SIZE_T   i;
+    UINT64   Start;
+    AML_DATA ReturnValue;
+
+    Start = AmlBenchTimeNs();
+    for( i = 0; i < Iterations; i++ ) {
+        if( AmlMethodInvoke( State, Method, 0, NULL, 0, &ReturnValue ) == AML_FALSE ) {
+            *pFailureCount += 1;
+            continue;
+        }
+        AmlDataFree( &ReturnValue );
+    }
+    return ( AmlBenchTimeNs() - Start );
+}
+
+//
+// Measure the per-opcode throughput of the interpreter.
+// Loads a synthetic code block (alongside the given table) with one method per benchmarked instruction,
+// each method body repeats the instruction, the cost of an empty method body is subtracted from every result.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchOpcodeDispatch(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* Node;
+    AML_OBJECT*         Methods[ AML_COUNTOF( AmlBenchOpcodeCases ) + 1 ];
+    CHAR                Path[ 6 ];
+    UINT8*              Code;
+    SIZE_T              CodeCapacity;
+    SIZE_T              CodeSize;
+    SIZE_T              i;
+    UINT64              FailureCount;
+    UINT64              Elapsed;
+    UINT64              BaseNs;
+    double              OpNs;
+    BOOLEAN             Success;
+
+    //
+    // Encode the synthetic methods (ZO00, ZO01, ..., an empty-body baseline method ZOBS, and the invoked method ZOPN).
+    //
+    CodeCapacity = ( ( AML_COUNTOF( AmlBenchOpcodeCases ) + 2 ) * ( 16 + ( sizeof( AmlBenchOpcodeCases[ 0 ].Code ) * AML_BENCH_OPCODE_REPEAT ) ) );
+    if( ( Code = malloc( CodeCapacity ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    CodeSize = 0;
+    for( i = 0; i < AML_COUNTOF( AmlBenchOpcodeCases ); i++ ) {
+        snprintf( Path, sizeof( Path ), "ZO%02u", ( UINT )i );
+        CodeSize += AmlBenchEncodeMethod( &Code[ CodeSize ], Path, AmlBenchOpcodeCases[ i ].Code, AmlBenchOpcodeCases[ i ].CodeSize, AML_BENCH_OPCODE_REPEAT );
+    }
+    CodeSize += AmlBenchEncodeMethod( &Code[ CodeSize ], "ZOBS", NULL, 0, 0 );
+    CodeSize += AmlBenchEncodeMethod( &Code[ CodeSize ], "ZOPN", NULL, 0, 0 );
+
+    //
+    // Load the table, then the synthetic code block (must remain allocated until the state is freed).
+    //
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        free( Code );
+        return AML_FALSE;
+    }
+    if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Context );
+        free( Code );
+        return AML_FALSE;
+    }
+    Success = AmlEvalLoadedTableCode( &Context->State, Code, CodeSize, NULL );
+    for( i = 0; ( i <= AML_COUNTOF( AmlBenchOpcodeCases ) ) && Success; i++ ) {
+        if( i < AML_COUNTOF( AmlBenchOpcodeCases ) ) {
+            snprintf( Path, sizeof( Path ), "\\ZO%02u", ( UINT )i );
+        } else {
+            snprintf( Path, sizeof( Path ), "\\ZOBS" );
+        }
+        if( ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, Path, 0, &Node ) == AML_FALSE )
+            || ( Node->Object == NULL )
+            || ( Node->Object->Type != AML_OBJECT_TYPE_METHOD ) )
+        {
+            Success = AML_FALSE;
+            break;
+        }
+        Methods[ i ] = Node->Object;
+    }
+    if( Success == AML_FALSE ) {
+        printf( "Error: failed to load the synthetic benchmark methods!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        free( Code );
+        return AML_FALSE;
+    }
+
+    //
+    // Time the baseline method first, then every benchmarked instruction (after a single untimed warm-up call).
+    //
+    FailureCount = 0;
+    AmlBenchTimeMethod( &Context->State, Methods[ AML_COUNTOF( AmlBenchOpcodeCases ) ], 1, &FailureCount );
+    Elapsed = AmlBenchTimeMethod( &Context->State, Methods[ AML_COUNTOF( AmlBenchOpcodeCases ) ], AML_BENCH_OPCODE_ITERATIONS, &FailureCount );
+    BaseNs = ( Elapsed / AML_BENCH_OPCODE_ITERATIONS );
+    printf( "Benchmarking %u instruction(s), %u copies per method, %u call(s) each, empty method call: %"PRIu64" ns.\n",
+            ( UINT )AML_COUNTOF( AmlBenchOpcodeCases ), AML_BENCH_OPCODE_REPEAT, AML_BENCH_OPCODE_ITERATIONS, BaseNs );
+    printf( "%-28s %-16s %12s %12s\n", "Instruction", "Class", "ns/op", "Mop/s" );
+    for( i = 0; i < AML_COUNTOF( AmlBenchOpcodeCases ); i++ ) {
+        AmlBenchTimeMethod( &Context->State, Methods[ i ], 1, &FailureCount );
+        Elapsed = AmlBenchTimeMethod( &Context->State, Methods[ i ], AML_BENCH_OPCODE_ITERATIONS, &FailureCount );
+        Elapsed = ( ( Elapsed > ( BaseNs * AML_BENCH_OPCODE_ITERATIONS ) ) ? ( Elapsed - ( BaseNs * AML_BENCH_OPCODE_ITERATIONS ) ) : 0 );
+        OpNs = ( ( double )Elapsed / ( ( double )AML_BENCH_OPCODE_ITERATIONS * AML_BENCH_OPCODE_REPEAT ) );
+        printf( "%-28s %-16s %12.1f %12.2f\n",
+                AmlBenchOpcodeCases[ i ].Name,
+                AmlBenchOpcodeCases[ i ].Class,
+                OpNs,
+                ( ( OpNs > 0.0 ) ? ( 1000.0 / OpNs ) : 0.0 ) );
+    }
+    if( FailureCount != 0 ) {
+        printf( "Error: %"PRIu64" failed invocation(s)!\n", FailureCount );
+        Success = AML_FALSE;
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    free( Code );
+    return Success;
+}
+
+//
+// Namespace iterator callback, collects all identification methods (_HID, _CID, _UID, _ADR, _SUN).
+//
+static
+AML_ITERATOR_ACTION
+AmlBenchCollectIdentificationMethod(
+    _In_opt_ VOID*               UserContext,
+    _Inout_  AML_STATE*          State,
+    _Inout_  AML_NAMESPACE_NODE* Node
+    )
+{
+    static const CHAR* const Names[ ] = { "_HID", "_CID", "_UID", "_ADR", "_SUN" };
+    SIZE_T                   i;
+
+    for( i = 0; i < AML_COUNTOF( Names ); i++ ) {
+        if( memcmp( Node->LocalName.Data, Names[ i ], sizeof( Node->LocalName.Data ) ) == 0 ) {
+            return AmlBenchCollectMethod( UserContext, State, Node );
+        }
+    }
+    return AML_ITERATOR_ACTION_CONTINUE;
+}
+
+//
+// Append a synthetic device definition with the identification methods of a typical enumerated device to the code block.
+// The _HID, _UID, and _ADR methods are pure (_ADR computes the address using a local), _SUN references a named object (impure).
+//
+static
+SIZE_T
+AmlBenchEncodeIdentifiedDevice(
+    _Out_  UINT8*      Output,
+    _In_z_ const CHAR* Name,
+    _In_   UINT16      Index
+    )
+{
+    const UINT8 Methods[ ] = {
+        0x14, 0x10, '_', 'H', 'I', 'D', 0x00,                       /* Method (_HID) */
+        0xA4, 0x0D, 'P', 'N', 'P', '0', 'C', '0', 'F', 0x00,        /*   Return ("PNP0C0F") */
+        0x14, 0x0A, '_', 'U', 'I', 'D', 0x00,                       /* Method (_UID) */
+        0xA4, 0x0B, ( UINT8 )Index, ( UINT8 )( Index >> 8 ),        /*   Return (Index) */
+        0x14, 0x15, '_', 'A', 'D', 'R', 0x00,                       /* Method (_ADR) */
+        0x70, 0x0B, ( UINT8 )Index, ( UINT8 )( Index >> 8 ), 0x60,  /*   Store (Index, Local0) */
+        0xA4, 0x7D, 0x79, 0x60, 0x0A, 0x10, 0x00, 0x0A, 0x03, 0x00, /*   Return (Or (ShiftLeft (Local0, 0x10), 0x03)) */
+        0x14, 0x0B, '_', 'S', 'U', 'N', 0x00,                       /* Method (_SUN) */
+        0xA4, 'Z', 'S', 'U', 'N',                                   /*   Return (ZSUN) */
+    };
+    SIZE_T Offset;
+
+    Output[ 0 ] = 0x5B; /* DeviceOp */
+    Output[ 1 ] = 0x82;
+    Offset = 2;
+    Offset += AmlBenchEncodePackageLength( &Output[ Offset ], ( 4 + sizeof( Methods ) ) );
+    AML_MEMCPY( &Output[ Offset ], Name, 4 );
+    Offset += 4;
+    AML_MEMCPY( &Output[ Offset ], Methods, sizeof( Methods ) );
+    Offset += sizeof( Methods );
+    return Offset;
+}
+
+//
+// Compare repeated evaluation of all identification methods of a synthetic set of devices (loaded alongside the given table)
+// with and without the identification method result cache.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchIdentificationCache(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8    SunObject[ ] = { 0x08, 'Z', 'S', 'U', 'N', 0x01 }; /* Name (ZSUN, One) */
+    AML_BENCH_CONTEXT*    Context;
+    AML_BENCH_METHOD_LIST List;
+    AML_NAMESPACE_NODE*   Node;
+    AML_DATA              Result;
+    UINT8*                Code;
+    UINT8*                Devices;
+    SIZE_T                CodeSize;
+    SIZE_T                DevicesSize;
+    CHAR                  Name[ 5 ];
+    UINT64                Start;
+    UINT64                Elapsed[ 2 ];
+    UINT64                FailureCount;
+    UINT64                CallCount;
+    SIZE_T                i;
+    SIZE_T                j;
+    SIZE_T                k;
+
+    //
+    // Build the synthetic devices below a single container device (ZIDC) that also declares the ZSUN object read by every _SUN.
+    //
+    Code = malloc( 0x10000 );
+    Devices = malloc( 0x10000 );
+    Context = malloc( sizeof( *Context ) );
+    if( ( Code == NULL ) || ( Devices == NULL ) || ( Context == NULL ) ) {
+        free( Code );
+        free( Devices );
+        free( Context );
+        return AML_FALSE;
+    }
+    DevicesSize = 0;
+    for( i = 0; i < AML_BENCH_ID_DEVICE_COUNT; i++ ) {
+        snprintf( Name, sizeof( Name ), "Z%03X", ( UINT )i );
+        DevicesSize += AmlBenchEncodeIdentifiedDevice( &Devices[ DevicesSize ], Name, ( UINT16 )i );
+    }
+    Code[ 0 ] = 0x5B; /* Device (ZIDC) */
+    Code[ 1 ] = 0x82;
+    CodeSize = 2;
+    CodeSize += AmlBenchEncodePackageLength( &Code[ CodeSize ], ( 4 + sizeof( SunObject ) + DevicesSize ) );
+    AML_MEMCPY( &Code[ CodeSize ], "ZIDC", 4 );
+    CodeSize += 4;
+    AML_MEMCPY( &Code[ CodeSize ], SunObject, sizeof( SunObject ) );
+    CodeSize += sizeof( SunObject );
+    AML_MEMCPY( &Code[ CodeSize ], Devices, DevicesSize );
+    CodeSize += DevicesSize;
+    free( Devices );
+    if( AmlBenchLoadTableEx( Context, &( AML_STATE_PARAMETERS ){ .DisableIdentificationCache = AML_TRUE }, Table, TableSize, Code, CodeSize, AML_TRUE ) == AML_FALSE ) {
+        free( Code );
+        free( Context );
+        return AML_FALSE;
+    }
+    if( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZIDC", 0, &Node ) == AML_FALSE ) {
+        printf( "Error: synthetic identification device container not found!\n" );
+        AmlStateFree( &Context->State );
+        free( Code );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Collect and warm up all identification methods of the synthetic devices.
+    //
+    List = ( AML_BENCH_METHOD_LIST ){ 0 };
+    AmlIterateNamespaceObjects( &Context->State, &Node->TreeEntry, AmlBenchCollectIdentificationMethod, &List, AML_OBJECT_TYPE_METHOD );
+    AmlBenchWarmupMethods( &Context->State, &List );
+    CallCount = ( ( UINT64 )List.Count * AML_BENCH_METHOD_ITERATIONS );
+    printf( "Benchmarking %"PRIu64" identification method(s) of %u synthetic device(s), %u iteration(s) each.\n",
+            ( UINT64 )List.Count,
+            AML_BENCH_ID_DEVICE_COUNT,
+            AML_BENCH_METHOD_ITERATIONS );
+
+    //
+    // Time evaluation of all methods (as done by device enumeration), first uncached, then cached.
+    //
+    FailureCount = 0;
+    for( k = 0; k < 2; k++ ) {
+        Context->State.UseIdentificationCache = ( k != 0 );
+        Start = AmlBenchTimeNs();
+        for( j = 0; j < AML_BENCH_METHOD_ITERATIONS; j++ ) {
+            for( i = 0; i < List.Count; i++ ) {
+                if( AmlEvalObject( &Context->State, List.Methods[ i ], &Result, AML_TRUE ) == AML_FALSE ) {
+                    FailureCount++;
+                    continue;
+                }
+                AmlDataFree( &Result );
+            }
+        }
+        Elapsed[ k ] = ( AmlBenchTimeNs() - Start );
+    }
+
+    //
+    // Print results.
+    //
+    if( CallCount != 0 ) {
+        printf( "Uncached: %"PRIu64" ns/call\n", ( Elapsed[ 0 ] / CallCount ) );
+        printf( "Cached:   %"PRIu64" ns/call\n", ( Elapsed[ 1 ] / CallCount ) );
+        if( Elapsed[ 1 ] != 0 ) {
+            printf( "Speedup:  %.2fx\n", ( ( double )Elapsed[ 0 ] / ( double )Elapsed[ 1 ] ) );
+        }
+    }
+    printf( "Cache:    %"PRIu64" hit(s), %"PRIu64" miss(es), %"PRIu64" failed call(s)\n",
+            Context->State.IdentificationCacheHitCount,
+            Context->State.IdentificationCacheMissCount,
+            FailureCount );
+
+    free( List.Methods );
+    AmlStateFree( &Context->State );
+    free( Code );
+    free( Context );
+    return AML_TRUE;
+}
@@ -0,0 +1,674 @@
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef AML_TEST_HAS_THREADS
+ #include <threads.h>
+#endif
+#include "runtest_bench_common.h"
+#include "aml_name_cache.h"
+#include "aml_hash.h"
+
+//
+// Deepest synthetic scope level and amount of timed lookups per level of the scope depth benchmark.
+//
+#define AML_BENCH_SCOPE_MAX_DEPTH   64
+#define AML_BENCH_SCOPE_ITERATIONS  100000
+
+//
+// Amount of timed table loads of each configuration of the skip index benchmark.
+//
+#define AML_BENCH_LOAD_ITERATIONS 20
+
+//
+// Concurrent namespace reader benchmark parameters, the reader thread count is doubled up to the maximum amount of readers.
+// The writer repeatedly invokes a method that creates (and then releases) the given amount of method-local named objects.
+//
+#define AML_BENCH_READER_MAX_THREADS  AML_EPOCH_MAX_READERS
+#define AML_BENCH_READER_DURATION_MS  200
+#define AML_BENCH_READER_BATCH        64
+#define AML_BENCH_WRITER_OBJECT_COUNT 256
+
+//
+// Call site name resolution cache feature and statistics callbacks.
+//
+static
+VOID
+AmlBenchEnableNameCache(
+    _Inout_ AML_STATE* State
+    )
+{
+    State->UseNameResolutionCache = AML_TRUE;
+}
+
+static
+VOID
+AmlBenchNameCacheStatistics(
+    _In_    const AML_OBJECT* Method,
+    _Inout_ UINT64*           pHitCount,
+    _Inout_ UINT64*           pMissCount
+    )
+{
+    if( Method->u.Method.NameCache != NULL ) {
+        *pHitCount += Method->u.Method.NameCache->HitCount;
+        *pMissCount += Method->u.Method.NameCache->MissCount;
+    }
+}
+
+//
+// Compare repeated method invocation performance with and without the call site name resolution cache.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchNameCache(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    return AmlBenchCompareMethods( Table, TableSize, AmlBenchEnableNameCache, AmlBenchNameCacheStatistics );
+}
+
+//
+// Collected list of namespace nodes.
+//
+typedef struct _AML_BENCH_NODE_LIST {
+    AML_NAMESPACE_NODE** Nodes;
+    SIZE_T               Count;
+    SIZE_T               Capacity;
+} AML_BENCH_NODE_LIST;
+
+//
+// Namespace iterator callback, collects all namespace nodes.
+//
+static
+AML_ITERATOR_ACTION
+AmlBenchCollectNode(
+    _In_opt_ VOID*               UserContext,
+    _Inout_  AML_STATE*          State,
+    _Inout_  AML_NAMESPACE_NODE* Node
+    )
+{
+    AML_BENCH_NODE_LIST* List;
+    AML_NAMESPACE_NODE** NewNodes;
+
+    List = UserContext;
+    if( List->Count >= List->Capacity ) {
+        List->Capacity = AML_MAX( 256, ( List->Capacity * 2 ) );
+        if( ( NewNodes = realloc( List->Nodes, ( List->Capacity * sizeof( List->Nodes[ 0 ] ) ) ) ) == NULL ) {
+            return AML_ITERATOR_ACTION_ERROR;
+        }
+        List->Nodes = NewNodes;
+    }
+    List->Nodes[ List->Count++ ] = Node;
+    return AML_ITERATOR_ACTION_CONTINUE;
+}
+
+//
+// Print the current statistics of the namespace path hash-table.
+//
+static
+VOID
+AmlBenchPrintPathMapStatistics(
+    _In_ const AML_STATE* State
+    )
+{
+    AML_NAMESPACE_PATH_MAP_STATISTICS Statistics;
+
+    AmlNamespacePathMapQueryStatistics( &State->Namespace.PathMap, &Statistics );
+    printf( "  Nodes: %"PRIu64", capacity: %"PRIu64", removed: %"PRIu64", resizes: %"PRIu64"\n",
+            ( UINT64 )Statistics.Count,
+            ( UINT64 )Statistics.Capacity,
+            ( UINT64 )Statistics.TombstoneCount,
+            Statistics.ResizeCount );
+    if( Statistics.LookupCount != 0 ) {
+        printf( "  Lookups: %"PRIu64", average probe length: %.2f, max probe length: %"PRIu64"\n",
+                Statistics.LookupCount,
+                ( ( double )Statistics.ProbeCount / ( double )Statistics.LookupCount ),
+                Statistics.MaxProbeLength );
+    }
+}
+
+//
+// Measure table load time with and without a namespace capacity hint,
+// and the lookup time of every namespace node by its absolute path.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchNamespaceMap(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_BENCH_CONTEXT*                Context;
+    AML_BENCH_NODE_LIST               List;
+    AML_NAMESPACE_NODE*               FoundNode;
+    AML_NAMESPACE_PATH_MAP_STATISTICS Statistics;
+    UINT64                            Start;
+    UINT64                            Elapsed;
+    UINT64                            FailureCount;
+    SIZE_T                            NodeCount;
+    SIZE_T                            i;
+    SIZE_T                            j;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Load the table using the default initial capacity.
+    //
+    Start = AmlBenchTimeNs();
+    if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    }
+    Elapsed = ( AmlBenchTimeNs() - Start );
+    printf( "Load (default capacity): %"PRIu64" us\n", ( Elapsed / 1000 ) );
+    AmlBenchPrintPathMapStatistics( &Context->State );
+
+    //
+    // Look up every node of the namespace by its absolute path.
+    //
+    List = ( AML_BENCH_NODE_LIST ){ 0 };
+    AmlIterateNamespaceObjects( &Context->State, NULL, AmlBenchCollectNode, &List, AML_OBJECT_TYPE_NONE );
+    FailureCount = 0;
+    Start = AmlBenchTimeNs();
+    for( j = 0; j < AML_BENCH_METHOD_ITERATIONS; j++ ) {
+        for( i = 0; i < List.Count; i++ ) {
+            if( AmlNamespaceSearch( &Context->State.Namespace,
+                                    NULL,
+                                    &List.Nodes[ i ]->AbsolutePath,
+                                    AML_SEARCH_FLAG_NO_ALIAS_RESOLUTION,
+                                    &FoundNode ) == AML_FALSE )
+            {
+                FailureCount++;
+            }
+        }
+    }
+    Elapsed = ( AmlBenchTimeNs() - Start );
+    if( List.Count != 0 ) {
+        printf( "Lookup: %"PRIu64" ns/lookup (%"PRIu64" node(s), %"PRIu64" failed lookup(s))\n",
+                ( Elapsed / ( ( UINT64 )List.Count * AML_BENCH_METHOD_ITERATIONS ) ),
+                ( UINT64 )List.Count,
+                FailureCount );
+    }
+    AmlBenchPrintPathMapStatistics( &Context->State );
+    AmlNamespacePathMapQueryStatistics( &Context->State.Namespace.PathMap, &Statistics );
+    NodeCount = Statistics.Count;
+    free( List.Nodes );
+    AmlStateFree( &Context->State );
+
+    //
+    // Reload the table with a capacity hint of the final amount of nodes.
+    //
+    Start = AmlBenchTimeNs();
+    if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ .NamespaceCapacityHint = NodeCount }, Table, TableSize ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    }
+    Elapsed = ( AmlBenchTimeNs() - Start );
+    printf( "Load (capacity hint %"PRIu64"): %"PRIu64" us\n", ( UINT64 )NodeCount, ( Elapsed / 1000 ) );
+    AmlBenchPrintPathMapStatistics( &Context->State );
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return AML_TRUE;
+}
+
+//
+// Reference implementation of the relative name search without precomputed scope prefix hashes,
+// the path of every ancestor level is hashed again from the root (quadratic in the scope depth).
+//
+static
+AML_NAMESPACE_NODE*
+AmlBenchSearchRelativeNameRehash(
+    _In_ AML_NAMESPACE_STATE*       Namespace,
+    _In_ const AML_NAMESPACE_SCOPE* Scope,
+    _In_ const AML_NAME_SEG*        Name
+    )
+{
+    AML_NAMESPACE_NODE* Node;
+    UINT32              Hash;
+    SIZE_T              i;
+    SIZE_T              j;
+
+    for( i = 0; i <= Scope->AbsolutePath.SegmentCount; i++ ) {
+        Hash = AML_NAMESPACE_HASH_SEED;
+        for( j = 0; j < ( Scope->AbsolutePath.SegmentCount - i ); j++ ) {
+            Hash = AmlHashKey32( Scope->AbsolutePath.Segments[ j ].Data, sizeof( Scope->AbsolutePath.Segments[ j ].Data ), Hash );
+        }
+        Hash = AmlHashKey32( Name->Data, sizeof( Name->Data ), Hash );
+        Node = AmlNamespacePathMapLookup( &Namespace->PathMap, Hash );
+        if( ( Node != NULL ) && ( Node->LocalName.AsUInt32 == Name->AsUInt32 ) ) {
+            return Node;
+        }
+    }
+    return NULL;
+}
+
+//
+// Measure the time of an unprefixed name lookup that resolves to a root-level node from increasingly deep scopes,
+// with the per-level prefix hashes of the scope, and with the previous approach of rehashing every ancestor path.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchScopeDepth(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_BENCH_CONTEXT*   Context;
+    AML_NAMESPACE_STATE* Namespace;
+    AML_NAMESPACE_NODE*  TargetNode;
+    AML_NAMESPACE_NODE*  FoundNode;
+    AML_NAME_SEG         TargetSegment;
+    AML_NAME_SEG         ScopeSegment;
+    AML_NAME_STRING      Name;
+    SIZE_T               Depth;
+    SIZE_T               PushedDepth;
+    SIZE_T               i;
+    UINT64               Start;
+    UINT64               ElapsedRehash;
+    UINT64               ElapsedPrefix;
+    UINT64               FailureCount;
+    BOOLEAN              Success;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    }
+    Namespace = &Context->State.Namespace;
+
+    //
+    // Create the root-level lookup target.
+    //
+    AML_MEMCPY( TargetSegment.Data, "BNCH", sizeof( TargetSegment.Data ) );
+    Name = ( AML_NAME_STRING ){ .Prefix = { .Data = { '\\' }, .Length = 1 }, .Segments = &TargetSegment, .SegmentCount = 1 };
+    if( AmlNamespaceCreateNode( Namespace, &Namespace->ScopeRoot, &Name, &TargetNode ) == AML_FALSE ) {
+        printf( "Error: failed to create the benchmark target node!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Push synthetic scope levels (\S000.S001...), timing lookups of the target at each power of 2 depth.
+    //
+    printf( "%8s %16s %16s\n", "Depth", "Rehash (ns)", "Prefix (ns)" );
+    Name = ( AML_NAME_STRING ){ .Segments = &TargetSegment, .SegmentCount = 1 };
+    Success = AML_TRUE;
+    FailureCount = 0;
+    PushedDepth = 0;
+    for( Depth = 1; ( Depth <= AML_BENCH_SCOPE_MAX_DEPTH ) && Success; Depth *= 2 ) {
+        while( PushedDepth < Depth ) {
+            ScopeSegment.Data[ 0 ] = 'S';
+            ScopeSegment.Data[ 1 ] = ( UINT8 )( '0' + ( ( PushedDepth / 100 ) % 10 ) );
+            ScopeSegment.Data[ 2 ] = ( UINT8 )( '0' + ( ( PushedDepth / 10 ) % 10 ) );
+            ScopeSegment.Data[ 3 ] = ( UINT8 )( '0' + ( PushedDepth % 10 ) );
+            if( AmlNamespacePushScope( Namespace, &( AML_NAME_STRING ){ .Segments = &ScopeSegment, .SegmentCount = 1 }, 0 ) == AML_FALSE ) {
+                printf( "Error: failed to push scope level %"PRIu64"!\n", ( UINT64 )PushedDepth );
+                Success = AML_FALSE;
+                break;
+            }
+            PushedDepth++;
+        }
+        if( Success == AML_FALSE ) {
+            break;
+        }
+
+        Start = AmlBenchTimeNs();
+        for( i = 0; i < AML_BENCH_SCOPE_ITERATIONS; i++ ) {
+            FailureCount += ( AmlBenchSearchRelativeNameRehash( Namespace, Namespace->ScopeLast, &TargetSegment ) != TargetNode );
+        }
+        ElapsedRehash = ( AmlBenchTimeNs() - Start );
+
+        Start = AmlBenchTimeNs();
+        for( i = 0; i < AML_BENCH_SCOPE_ITERATIONS; i++ ) {
+            if( ( AmlNamespaceSearch( Namespace, NULL, &Name, 0, &FoundNode ) == AML_FALSE ) || ( FoundNode != TargetNode ) ) {
+                FailureCount++;
+            }
+        }
+        ElapsedPrefix = ( AmlBenchTimeNs() - Start );
+
+        printf( "%8"PRIu64" %16"PRIu64" %16"PRIu64"\n",
+                ( UINT64 )Depth,
+                ( ElapsedRehash / AML_BENCH_SCOPE_ITERATIONS ),
+                ( ElapsedPrefix / AML_BENCH_SCOPE_ITERATIONS ) );
+    }
+    if( FailureCount != 0 ) {
+        printf( "Error: %"PRIu64" failed lookup(s)!\n", FailureCount );
+        Success = AML_FALSE;
+    }
+
+    //
+    // Pop all synthetic scope levels.
+    //
+    while( PushedDepth-- > 0 ) {
+        AmlNamespacePopScope( Namespace );
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Compare table load time (both passes and initial device initialization) with and without the namespace pass skip index.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchSkipIndex(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_BENCH_CONTEXT*        Context;
+    AML_SKIP_INDEX_STATISTICS Statistics;
+    UINT64                    Start;
+    UINT64                    Elapsed;
+    UINT64                    MinElapsed;
+    UINT64                    TotalElapsed;
+    SIZE_T                    i;
+    SIZE_T                    j;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Time repeated loads of the table into a new state, first without the skip index, then with the skip index.
+    //
+    Statistics = ( AML_SKIP_INDEX_STATISTICS ){ 0 };
+    for( i = 0; i < 2; i++ ) {
+        MinElapsed = ~0ull;
+        TotalElapsed = 0;
+        for( j = 0; j < AML_BENCH_LOAD_ITERATIONS; j++ ) {
+            Start = AmlBenchTimeNs();
+            if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ .UseNamespaceSkipIndex = ( i != 0 ) }, Table, TableSize ) == AML_FALSE ) {
+                free( Context );
+                return AML_FALSE;
+            }
+            Elapsed = ( AmlBenchTimeNs() - Start );
+            MinElapsed = AML_MIN( MinElapsed, Elapsed );
+            TotalElapsed += Elapsed;
+            Statistics = Context->State.SkipIndexStatistics;
+            AmlStateFree( &Context->State );
+        }
+        printf( "Load (%s): %"PRIu64" us average, %"PRIu64" us minimum (%u load(s))\n",
+                ( ( i != 0 ) ? "skip index" : "no skip index" ),
+                ( ( TotalElapsed / AML_BENCH_LOAD_ITERATIONS ) / 1000 ),
+                ( MinElapsed / 1000 ),
+                AML_BENCH_LOAD_ITERATIONS );
+    }
+
+    //
+    // Print the statistics of the last load with the skip index.
+    //
+    printf( "Skip index: %"PRIu64" recorded definition(s), %"PRIu64" hit(s), %"PRIu64" miss(es)\n",
+            Statistics.EntryCount,
+            Statistics.HitCount,
+            Statistics.MissCount );
+
+    free( Context );
+    return AML_TRUE;
+}
+
+#ifdef AML_TEST_HAS_THREADS
+
+//
+// State shared by the concurrent namespace reader benchmark threads.
+//
+typedef struct _AML_BENCH_READER_SHARED {
+    AML_BENCH_CONTEXT*     Context;
+    const AML_NAME_STRING* Names;
+    SIZE_T                 NameCount;
+    AML_OBJECT*            WriterMethod;
+    UINT64                 Stop;
+} AML_BENCH_READER_SHARED;
+
+//
+// Per-thread state of the concurrent namespace reader benchmark.
+// For the writer thread, OperationCount is the amount of writer method invocations.
+//
+typedef struct _AML_BENCH_READER_THREAD {
+    AML_BENCH_READER_SHARED* Shared;
+    thrd_t                   Thread;
+    SIZE_T                   Index;
+    UINT64                   OperationCount;
+    UINT64                   FailureCount;
+} AML_BENCH_READER_THREAD;
+
+//
+// Append a synthetic argument-less method definition that declares the given amount of named objects (W000, W001, ...).
+//
+static
+SIZE_T
+AmlBenchEncodeNameMethod(
+    _Out_  UINT8*      Output,
+    _In_z_ const CHAR* Name,
+    _In_   SIZE_T      NameCount
+    )
+{
+    CHAR   LocalName[ 5 ];
+    SIZE_T Offset;
+    SIZE_T i;
+
+    Output[ 0 ] = 0x14; /* MethodOp */
+    Offset = 1;
+    Offset += AmlBenchEncodePackageLength( &Output[ Offset ], ( 4 + 1 + ( NameCount * 6 ) ) );
+    AML_MEMCPY( &Output[ Offset ], Name, 4 );
+    Offset += 4;
+    Output[ Offset++ ] = 0; /* MethodFlags */
+    for( i = 0; i < NameCount; i++ ) {
+        snprintf( LocalName, sizeof( LocalName ), "W%03X", ( UINT )i );
+        Output[ Offset++ ] = 0x08; /* NameOp */
+        AML_MEMCPY( &Output[ Offset ], LocalName, 4 );
+        Offset += 4;
+        Output[ Offset++ ] = 0x00; /* ZeroOp */
+    }
+    return Offset;
+}
+
+//
+// Reader thread routine, repeatedly looks up all names until stopped, each lookup in its own read-side critical section.
+//
+static
+INT
+AmlBenchReaderThread(
+    _Inout_ VOID* Argument
+    )
+{
+    AML_BENCH_READER_THREAD* Thread;
+    AML_BENCH_READER_SHARED* Shared;
+    AML_NAMESPACE_READER     Reader;
+    AML_NAMESPACE_NODE*      Node;
+    SIZE_T                   NameIndex;
+    SIZE_T                   i;
+
+    Thread = Argument;
+    Shared = Thread->Shared;
+    if( AmlNamespaceReaderRegister( &Shared->Context->State.Namespace, &Reader ) == AML_FALSE ) {
+        Thread->FailureCount++;
+        return 0;
+    }
+    NameIndex = ( ( Thread->Index * 7919 ) % Shared->NameCount );
+    while( AML_ATOMIC_LOAD64( &Shared->Stop ) == 0 ) {
+        for( i = 0; i < AML_BENCH_READER_BATCH; i++ ) {
+            AmlNamespaceReaderEnter( &Reader );
+            if( AmlNamespaceReaderSearch( &Reader, NULL, &Shared->Names[ NameIndex ], &Node ) == AML_FALSE ) {
+                Thread->FailureCount++;
+            }
+            AmlNamespaceReaderLeave( &Reader );
+            NameIndex = ( ( ( NameIndex + 1 ) < Shared->NameCount ) ? ( NameIndex + 1 ) : 0 );
+        }
+        Thread->OperationCount += AML_BENCH_READER_BATCH;
+    }
+    AmlNamespaceReaderUnregister( &Reader );
+    return 0;
+}
+
+//
+// Writer thread routine, repeatedly creates and releases a batch of named objects until stopped.
+//
+static
+INT
+AmlBenchWriterThread(
+    _Inout_ VOID* Argument
+    )
+{
+    AML_BENCH_READER_THREAD* Thread;
+    AML_BENCH_READER_SHARED* Shared;
+    AML_DATA                 ReturnValue;
+
+    Thread = Argument;
+    Shared = Thread->Shared;
+    while( AML_ATOMIC_LOAD64( &Shared->Stop ) == 0 ) {
+        if( AmlMethodInvoke( &Shared->Context->State, Shared->WriterMethod, 0, NULL, 0, &ReturnValue ) == AML_FALSE ) {
+            Thread->FailureCount++;
+            continue;
+        }
+        AmlDataFree( &ReturnValue );
+        Thread->OperationCount++;
+    }
+    return 0;
+}
+
+//
+// Measure lock-free namespace lookup throughput of an increasing amount of concurrent reader threads,
+// while a writer thread keeps creating and releasing named objects (inserting and removing path map entries,
+// causing periodic path map rehashes, and retiring released nodes).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchConcurrentReaders(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_BENCH_CONTEXT*                Context;
+    AML_BENCH_NODE_LIST               List;
+    AML_BENCH_READER_SHARED           Shared;
+    AML_BENCH_READER_THREAD*          Threads;
+    AML_BENCH_READER_THREAD           Writer;
+    AML_NAMESPACE_NODE*               Node;
+    AML_NAME_STRING*                  Names;
+    AML_NAMESPACE_PATH_MAP_STATISTICS Statistics;
+    UINT8*                            Code;
+    SIZE_T                            CodeSize;
+    SIZE_T                            ThreadCount;
+    SIZE_T                            StartedCount;
+    SIZE_T                            i;
+    UINT64                            Start;
+    UINT64                            Elapsed;
+    UINT64                            LookupCount;
+    UINT64                            FailureCount;
+    BOOLEAN                           Success;
+
+    //
+    // Encode the writer method, and load it alongside the table (the code must remain allocated until the state is freed).
+    //
+    if( ( Code = malloc( 16 + ( AML_BENCH_WRITER_OBJECT_COUNT * 6 ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    CodeSize = AmlBenchEncodeNameMethod( Code, "ZWRT", AML_BENCH_WRITER_OBJECT_COUNT );
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        free( Code );
+        return AML_FALSE;
+    } else if( ( Threads = calloc( AML_BENCH_READER_MAX_THREADS, sizeof( Threads[ 0 ] ) ) ) == NULL ) {
+        free( Context );
+        free( Code );
+        return AML_FALSE;
+    } else if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Threads );
+        free( Context );
+        free( Code );
+        return AML_FALSE;
+    }
+    Names = NULL;
+    List = ( AML_BENCH_NODE_LIST ){ 0 };
+    Success = AML_FALSE;
+    do {
+        if( ( AmlEvalLoadedTableCode( &Context->State, Code, CodeSize, NULL ) == AML_FALSE )
+            || ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZWRT", 0, &Node ) == AML_FALSE )
+            || ( Node->Object->Type != AML_OBJECT_TYPE_METHOD ) )
+        {
+            printf( "Error: failed to load the synthetic benchmark methods!\n" );
+            break;
+        }
+        Shared = ( AML_BENCH_READER_SHARED ){ .Context = Context, .WriterMethod = Node->Object };
+
+        //
+        // Look up the absolute paths of all (permanent) nodes of the loaded table.
+        //
+        AmlIterateNamespaceObjects( &Context->State, NULL, AmlBenchCollectNode, &List, AML_OBJECT_TYPE_NONE );
+        if( ( List.Count == 0 ) || ( ( Names = malloc( List.Count * sizeof( Names[ 0 ] ) ) ) == NULL ) ) {
+            break;
+        }
+        for( i = 0; i < List.Count; i++ ) {
+            Names[ i ] = List.Nodes[ i ]->AbsolutePath;
+        }
+        Shared.Names = Names;
+        Shared.NameCount = List.Count;
+        printf( "Looking up %"PRIu64" node(s) for %u ms per step, writer creates/releases %u object(s) per call.\n",
+                ( UINT64 )List.Count,
+                AML_BENCH_READER_DURATION_MS,
+                AML_BENCH_WRITER_OBJECT_COUNT );
+        printf( "%8s %14s %18s %14s %10s\n", "Readers", "Mlookups/s", "ns/lookup/reader", "Writer calls", "Failed" );
+
+        //
+        // Run every step with a fresh writer thread, and the given amount of reader threads.
+        //
+        Success = AML_TRUE;
+        for( ThreadCount = 1; ( ThreadCount <= AML_BENCH_READER_MAX_THREADS ) && Success; ThreadCount *= 2 ) {
+            AML_ATOMIC_STORE64( &Shared.Stop, 0 );
+            Writer = ( AML_BENCH_READER_THREAD ){ .Shared = &Shared };
+            if( thrd_create( &Writer.Thread, AmlBenchWriterThread, &Writer ) != thrd_success ) {
+                Success = AML_FALSE;
+                break;
+            }
+            Start = AmlBenchTimeNs();
+            for( StartedCount = 0; StartedCount < ThreadCount; StartedCount++ ) {
+                Threads[ StartedCount ] = ( AML_BENCH_READER_THREAD ){ .Shared = &Shared, .Index = StartedCount };
+                if( thrd_create( &Threads[ StartedCount ].Thread, AmlBenchReaderThread, &Threads[ StartedCount ] ) != thrd_success ) {
+                    Success = AML_FALSE;
+                    break;
+                }
+            }
+            thrd_sleep( &( struct timespec ){ .tv_nsec = ( AML_BENCH_READER_DURATION_MS * 1000000l ) }, NULL );
+            AML_ATOMIC_STORE64( &Shared.Stop, 1 );
+            LookupCount = 0;
+            FailureCount = 0;
+            for( i = 0; i < StartedCount; i++ ) {
+                thrd_join( Threads[ i ].Thread, NULL );
+                LookupCount += Threads[ i ].OperationCount;
+                FailureCount += Threads[ i ].FailureCount;
+            }
+            Elapsed = ( AmlBenchTimeNs() - Start );
+            thrd_join( Writer.Thread, NULL );
+            FailureCount += Writer.FailureCount;
+            printf( "%8"PRIu64" %14.2f %18.1f %14"PRIu64" %10"PRIu64"\n",
+                    ( UINT64 )ThreadCount,
+                    ( ( double )LookupCount / ( ( double )Elapsed / 1000.0 ) ),
+                    ( ( LookupCount != 0 ) ? ( ( ( double )Elapsed * ( double )ThreadCount ) / ( double )LookupCount ) : 0.0 ),
+                    Writer.OperationCount,
+                    FailureCount );
+            Success = ( Success && ( FailureCount == 0 ) );
+        }
+        AmlNamespacePathMapQueryStatistics( &Context->State.Namespace.PathMap, &Statistics );
+        printf( "Path map: %"PRIu64" node(s), %"PRIu64" resize(s)\n", ( UINT64 )Statistics.Count, Statistics.ResizeCount );
+        if( Success == AML_FALSE ) {
+            printf( "Error: one or more concurrent lookups or writer calls failed!\n" );
+        }
+    } while( 0 );
+
+    free( Names );
+    free( List.Nodes );
+    AmlStateFree( &Context->State );
+    free( Threads );
+    free( Context );
+    free( Code );
+    return Success;
+}
+
+#endif
@@ -0,0 +1,1042 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "runtest_bench_common.h"
+#include "aml_field.h"
+
+//
+// Vectored region access benchmark parameters, amount of timed field reads/writes of each handler configuration,
+// and the simulated cost of every region access handler callback (for example, a VM exit).
+//
+#define AML_BENCH_VECTOR_ITERATIONS 2000
+#define AML_BENCH_VECTOR_EXIT_NS    1000
+
+//
+// Amount of timed GNVS method invocations of each SystemMemory access mode, and the amount of loop iterations per invocation.
+//
+#define AML_BENCH_GNVS_ITERATIONS       2000
+#define AML_BENCH_GNVS_LOOP_COUNT       64
+#define AML_BENCH_GNVS_FIELD_ITERATIONS 200000
+
+//
+// Amount of timed invocations of the temporary SystemMemory region method, with and without the mapping cache.
+//
+#define AML_BENCH_REGION_MAP_ITERATIONS 20000
+
+//
+// Amount of timed invocations of the large SystemMemory region method, and the size above which regions are windowed.
+//
+#define AML_BENCH_REGION_WINDOW_ITERATIONS 20000
+#define AML_BENCH_REGION_WINDOW_THRESHOLD  ( 1024 * 1024 )
+
+//
+// Amount of timed invocations of the bridged PCI region method, and the interval between bridge bus renumbering invocations.
+//
+#define AML_BENCH_PCI_TOPOLOGY_ITERATIONS        20000
+#define AML_BENCH_PCI_TOPOLOGY_RENUMBER_INTERVAL 1000
+
+//
+// Amount of timed invocations of the CMOS-style index field method (and of loop iterations within it),
+// and the amount of timed reads of all index field units (per unit and as a single run).
+//
+#define AML_BENCH_INDEX_FIELD_ITERATIONS     20000
+#define AML_BENCH_INDEX_FIELD_LOOP_COUNT     16
+#define AML_BENCH_INDEX_FIELD_RUN_ITERATIONS 20000
+#define AML_BENCH_INDEX_FIELD_UNIT_COUNT     16
+
+//
+// Simulated EC register contents of the vectored region access benchmark, every byte holds its own offset.
+//
+static
+UINT64
+AmlBenchVectorDeviceWord(
+    _In_ UINT64 Offset,
+    _In_ UINT64 BitWidth
+    )
+{
+    UINT64 Word;
+    UINT64 i;
+
+    Word = 0;
+    for( i = 0; i < ( BitWidth / CHAR_BIT ); i++ ) {
+        Word |= ( ( ( Offset + i ) & 0xFF ) << ( i * CHAR_BIT ) );
+    }
+    return Word;
+}
+
+//
+// Simulate the cost of a single region access handler callback.
+//
+static
+VOID
+AmlBenchVectorExit(
+    VOID
+    )
+{
+    UINT64 End;
+
+    End = ( AmlBenchTimeNs() + AML_BENCH_VECTOR_EXIT_NS );
+    while( AmlBenchTimeNs() < End ) {
+        AML_PAUSE();
+    }
+}
+
+//
+// Regular (per-word) simulated EC region access handler, counts callbacks.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchVectorRegionHandler(
+    _Inout_     AML_STATE*                   State,
+    _Inout_     AML_OBJECT_OPERATION_REGION* Region,
+    _Inout_     VOID*                        UserContext,
+    _Inout_opt_ AML_OBJECT_FIELD*            Field,
+    _In_        AML_REGION_ACCESS_TYPE       AccessType,
+    _In_        UINT8                        AccessAttribute,
+    _In_        UINT64                       AccessOffset,
+    _In_        UINT64                       AccessBitWidth,
+    _Inout_     AML_REGION_ACCESS_DATA*      Data
+    )
+{
+    *( UINT64* )UserContext += 1;
+    AmlBenchVectorExit();
+    if( AccessType == AML_REGION_ACCESS_TYPE_READ ) {
+        Data->Word = AmlBenchVectorDeviceWord( AccessOffset, AccessBitWidth );
+    }
+    return AML_TRUE;
+}
+
+//
+// Vectored simulated EC region access handler, services all given accesses within a single (counted) callback.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchVectorRegionVectorHandler(
+    _Inout_                     AML_STATE*                   State,
+    _Inout_                     AML_OBJECT_OPERATION_REGION* Region,
+    _Inout_                     VOID*                        UserContext,
+    _Inout_opt_                 AML_OBJECT_FIELD*            Field,
+    _In_                        AML_REGION_ACCESS_TYPE       AccessType,
+    _In_                        UINT8                        AccessAttribute,
+    _Inout_count_( EntryCount ) AML_REGION_ACCESS_ENTRY*     Entries,
+    _In_                        SIZE_T                       EntryCount
+    )
+{
+    SIZE_T i;
+
+    *( UINT64* )UserContext += 1;
+    AmlBenchVectorExit();
+    if( AccessType == AML_REGION_ACCESS_TYPE_READ ) {
+        for( i = 0; i < EntryCount; i++ ) {
+            Entries[ i ].Word = AmlBenchVectorDeviceWord( Entries[ i ].Offset, Entries[ i ].BitWidth );
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Time repeated invocations of the field read and write methods, validates the read field contents.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchVectorTimeAccesses(
+    _Inout_ AML_BENCH_CONTEXT* Context,
+    _In_    AML_OBJECT*        ReadMethod,
+    _In_    AML_OBJECT*        WriteMethod,
+    _In_    const UINT64*      CallbackCount,
+    _In_z_  const CHAR*        Label
+    )
+{
+    AML_DATA Result;
+    UINT64   Start;
+    UINT64   ReadNs;
+    UINT64   WriteNs;
+    UINT64   ReadCallbacks;
+    UINT64   WriteCallbacks;
+    SIZE_T   i;
+    SIZE_T   j;
+
+    //
+    // Time field reads, the field starts at bit 4 of the simulated registers.
+    //
+    ReadCallbacks = *CallbackCount;
+    Start = AmlBenchTimeNs();
+    for( i = 0; i < AML_BENCH_VECTOR_ITERATIONS; i++ ) {
+        if( ( AmlEvalObject( &Context->State, ReadMethod, &Result, AML_TRUE ) == AML_FALSE )
+            || ( Result.Type != AML_DATA_TYPE_BUFFER ) )
+        {
+            printf( "Error: field read failed!\n" );
+            return AML_FALSE;
+        }
+        for( j = 0; j < Result.u.Buffer->Size; j++ ) {
+            if( Result.u.Buffer->Data[ j ] != ( UINT8 )( ( j >> 4 ) | ( ( j + 1 ) << 4 ) ) ) {
+                printf( "Error: unexpected field data at byte %u!\n", ( UINT )j );
+                AmlDataFree( &Result );
+                return AML_FALSE;
+            }
+        }
+        AmlDataFree( &Result );
+    }
+    ReadNs = ( AmlBenchTimeNs() - Start );
+    ReadCallbacks = ( *CallbackCount - ReadCallbacks );
+
+    //
+    // Time field writes (preserving the bits of the partially written first and last words).
+    //
+    WriteCallbacks = *CallbackCount;
+    Start = AmlBenchTimeNs();
+    for( i = 0; i < AML_BENCH_VECTOR_ITERATIONS; i++ ) {
+        if( AmlEvalObject( &Context->State, WriteMethod, &Result, AML_FALSE ) == AML_FALSE ) {
+            printf( "Error: field write failed!\n" );
+            return AML_FALSE;
+        }
+        AmlDataFree( &Result );
+    }
+    WriteNs = ( AmlBenchTimeNs() - Start );
+    WriteCallbacks = ( *CallbackCount - WriteCallbacks );
+
+    printf( "%-10s read:  %6.1f callback(s), %8.0f ns per field access\n",
+            Label,
+            ( ( double )ReadCallbacks / AML_BENCH_VECTOR_ITERATIONS ),
+            ( ( double )ReadNs / AML_BENCH_VECTOR_ITERATIONS ) );
+    printf( "%-10s write: %6.1f callback(s), %8.0f ns per field access\n",
+            Label,
+            ( ( double )WriteCallbacks / AML_BENCH_VECTOR_ITERATIONS ),
+            ( ( double )WriteNs / AML_BENCH_VECTOR_ITERATIONS ) );
+    return AML_TRUE;
+}
+
+//
+// Read and write a 256-bit (unaligned) ByteAcc EC field, with a regular per-word region access handler,
+// and then with an additional vectored handler, counting the handler callbacks that each field access takes.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchRegionVector(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x5B, 0x80, 'Z', 'V', 'E', 'R', 0x03, 0x00, 0x0A, 0x40,         /* OperationRegion (ZVER, EmbeddedControl, Zero, 0x40) */
+        0x5B, 0x81, 0x11, 'Z', 'V', 'E', 'R', 0x01,                     /* Field (ZVER, ByteAcc, NoLock, Preserve) */
+        'Z', 'V', 'P', 'D', 0x04,                                       /*   ZVPD, 4 */
+        'Z', 'V', 'E', 'F', 0x40, 0x10,                                 /*   ZVEF, 256 */
+        0x08, 'Z', 'V', 'B', 'F', 0x11, 0x03, 0x0A, 0x20,               /* Name (ZVBF, Buffer (0x20) {}) */
+        0x14, 0x0B, 'Z', 'V', 'R', 'D', 0x00,                           /* Method (ZVRD) */
+        0xA4, 'Z', 'V', 'E', 'F',                                       /*   Return (ZVEF) */
+        0x14, 0x0F, 'Z', 'V', 'W', 'R', 0x00,                           /* Method (ZVWR) */
+        0x70, 'Z', 'V', 'B', 'F', 'Z', 'V', 'E', 'F',                   /*   Store (ZVBF, ZVEF) */
+    };
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* ReadNode;
+    AML_NAMESPACE_NODE* WriteNode;
+    UINT64              CallbackCount;
+    BOOLEAN             Success;
+
+    //
+    // Load the table and the synthetic code block, and register the regular simulated EC region handler.
+    //
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    }
+    CallbackCount = 0;
+    if( ( AmlEvalLoadedTableCode( &Context->State, Code, sizeof( Code ), NULL ) == AML_FALSE )
+        || ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZVRD", 0, &ReadNode ) == AML_FALSE )
+        || ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZVWR", 0, &WriteNode ) == AML_FALSE )
+        || ( AmlRegisterRegionSpaceAccessHandler( &Context->State, AML_REGION_SPACE_TYPE_EMBEDDED_CONTROL, AmlBenchVectorRegionHandler, &CallbackCount, AML_FALSE ) == AML_FALSE ) )
+    {
+        printf( "Error: failed to load the synthetic benchmark methods!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Time field accesses split into regular handler callbacks, and then batched into vectored handler callbacks.
+    //
+    printf( "Accessing a 256-bit ByteAcc EC field (unaligned), every handler callback costs %u ns.\n", AML_BENCH_VECTOR_EXIT_NS );
+    Success = AmlBenchVectorTimeAccesses( Context, ReadNode->Object, WriteNode->Object, &CallbackCount, "Per-word" );
+    if( Success ) {
+        Success = AmlRegisterRegionSpaceVectorAccessHandler( &Context->State, AML_REGION_SPACE_TYPE_EMBEDDED_CONTROL, AmlBenchVectorRegionVectorHandler );
+    }
+    if( Success ) {
+        Success = AmlBenchVectorTimeAccesses( Context, ReadNode->Object, WriteNode->Object, &CallbackCount, "Vectored" );
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Time repeated invocations of the synthetic GNVS method using a state created with the given parameters,
+// returns the final value returned by the method, which must be identical for all SystemMemory access modes.
+// Additionally times plain reads of a 64-bit (8 access word) field, without any interpreter overhead.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchGnvsTime(
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                Code,
+    _In_                          SIZE_T                      CodeSize,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _Out_                         UINT64*                     pElapsedNs,
+    _Out_                         UINT64*                     pFieldElapsedNs,
+    _Out_                         UINT64*                     pResult
+    )
+{
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* MethodNode;
+    AML_NAMESPACE_NODE* FieldNode;
+    AML_DATA            Result;
+    UINT64              FieldValue;
+    UINT64              Start;
+    SIZE_T              i;
+    BOOLEAN             Success;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTableEx( Context, Parameters, Table, TableSize, Code, CodeSize, AML_TRUE ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    } else if( ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZGNV", 0, &MethodNode ) == AML_FALSE )
+               || ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZVSB", 0, &FieldNode ) == AML_FALSE ) )
+    {
+        printf( "Error: failed to find the synthetic benchmark method!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    Success = AML_TRUE;
+    Result = ( AML_DATA ){ .Type = AML_DATA_TYPE_NONE };
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_GNVS_ITERATIONS ) && Success; i++ ) {
+        AmlDataFree( &Result );
+        Success = AmlEvalObject( &Context->State, MethodNode->Object, &Result, AML_TRUE );
+    }
+    *pElapsedNs = ( AmlBenchTimeNs() - Start );
+    if( ( Success == AML_FALSE ) || ( Result.Type != AML_DATA_TYPE_INTEGER ) ) {
+        printf( "Error: synthetic GNVS method failed!\n" );
+        Success = AML_FALSE;
+    } else {
+        *pResult = Result.u.Integer;
+    }
+
+    //
+    // Time plain field reads, the region has already been mapped by the method invocations.
+    //
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_GNVS_FIELD_ITERATIONS ) && Success; i++ ) {
+        Success = AmlFieldUnitRead( &Context->State, FieldNode->Object, &FieldValue, sizeof( FieldValue ), AML_FALSE, NULL );
+    }
+    *pFieldElapsedNs = ( AmlBenchTimeNs() - Start );
+
+    AmlDataFree( &Result );
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Evaluate a GNVS-style method that repeatedly reads and writes fields of a SystemMemory NVS region,
+// with the regular SystemMemory handler, and with direct access of the region mapping (UseDirectSystemMemoryAccess).
+//
+_Success_( return )
+BOOLEAN
+AmlBenchGnvs(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x5B, 0x80, 'Z', 'N', 'V', 'S', 0x00,                           /* OperationRegion (ZNVS, SystemMemory, */
+        0x0C, 0x00, 0x00, 0xFF, 0x7F, 0x0B, 0x00, 0x01,                 /*   0x7FFF0000, 0x100) */
+        0x5B, 0x81, 0x2F, 'Z', 'N', 'V', 'S', 0x00,                     /* Field (ZNVS, AnyAcc, NoLock, Preserve) */
+        'Z', 'S', 'Y', 'S', 0x10,                                       /*   ZSYS, 16 */
+        'Z', 'M', 'I', 'F', 0x08,                                       /*   ZMIF, 8 */
+        'Z', 'R', 'M', '0', 0x08,                                       /*   ZRM0, 8 */
+        'Z', 'B', 'F', '0', 0x01,                                       /*   ZBF0, 1 */
+        'Z', 'B', 'F', '1', 0x03,                                       /*   ZBF1, 3 */
+        'Z', 'B', 'F', '2', 0x04,                                       /*   ZBF2, 4 */
+        'Z', 'S', 'L', 'B', 0x20,                                       /*   ZSLB, 32 */
+        'Z', 'V', 'S', 'B', 0x40, 0x04,                                 /*   ZVSB, 64 */
+        0x14, 0x3E, 'Z', 'G', 'N', 'V', 0x00,                           /* Method (ZGNV) */
+        0x70, 0x00, 0x60,                                               /*   Local0 = Zero */
+        0xA2, 0x2F, 0x95, 0x60, 0x0A, AML_BENCH_GNVS_LOOP_COUNT,        /*   While (Local0 < LOOP_COUNT) */
+        0x70, 'Z', 'S', 'Y', 'S', 0x61,                                 /*     Local1 = ZSYS */
+        0x72, 'Z', 'M', 'I', 'F', 0x01, 'Z', 'M', 'I', 'F',             /*     ZMIF = ZMIF + One */
+        0x70, 0x60, 'Z', 'R', 'M', '0',                                 /*     ZRM0 = Local0 */
+        0x70, 'Z', 'S', 'L', 'B', 0x62,                                 /*     Local2 = ZSLB */
+        0x70, 0x60, 'Z', 'B', 'F', '1',                                 /*     ZBF1 = Local0 */
+        0x70, 'Z', 'V', 'S', 'B', 0x63,                                 /*     Local3 = ZVSB */
+        0x75, 0x60,                                                     /*     Local0++ */
+        0xA4, 'Z', 'M', 'I', 'F',                                       /*   Return (ZMIF) */
+    };
+    UINT64 HandlerNs;
+    UINT64 HandlerFieldNs;
+    UINT64 HandlerResult;
+    UINT64 DirectNs;
+    UINT64 DirectFieldNs;
+    UINT64 DirectResult;
+
+    if( AmlBenchGnvsTime( Table, TableSize, Code, sizeof( Code ),
+                          &( AML_STATE_PARAMETERS ){ 0 }, &HandlerNs, &HandlerFieldNs, &HandlerResult ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    } else if( AmlBenchGnvsTime( Table, TableSize, Code, sizeof( Code ),
+                                 &( AML_STATE_PARAMETERS ){ .UseDirectSystemMemoryAccess = AML_TRUE },
+                                 &DirectNs, &DirectFieldNs, &DirectResult ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    } else if( HandlerResult != DirectResult ) {
+        printf( "Error: direct SystemMemory access returned 0x%"PRIx64", expected 0x%"PRIx64"!\n", DirectResult, HandlerResult );
+        return AML_FALSE;
+    }
+
+    printf( "GNVS method with %u loop iterations of 6 field accesses each, and plain 64-bit AnyAcc field reads.\n", AML_BENCH_GNVS_LOOP_COUNT );
+    printf( "Handler:   %10.0f ns per call, %8.1f ns per field read\n",
+            ( ( double )HandlerNs / AML_BENCH_GNVS_ITERATIONS ),
+            ( ( double )HandlerFieldNs / AML_BENCH_GNVS_FIELD_ITERATIONS ) );
+    printf( "Direct:    %10.0f ns per call, %8.1f ns per field read (%.2fx, %.2fx)\n",
+            ( ( double )DirectNs / AML_BENCH_GNVS_ITERATIONS ),
+            ( ( double )DirectFieldNs / AML_BENCH_GNVS_FIELD_ITERATIONS ),
+            ( ( double )HandlerNs / AML_MAX( DirectNs, 1 ) ),
+            ( ( double )HandlerFieldNs / AML_MAX( DirectFieldNs, 1 ) ) );
+    return AML_TRUE;
+}
+
+//
+// Time repeated invocations of the temporary SystemMemory region method using a state created with the given parameters,
+// returns the amount of host map calls and the mapping cache statistics of the state.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchRegionMapTime(
+    _In_reads_bytes_( TableSize ) const UINT8*                  Table,
+    _In_                          SIZE_T                        TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                  Code,
+    _In_                          SIZE_T                        CodeSize,
+    _In_                          const AML_STATE_PARAMETERS*   Parameters,
+    _Out_                         UINT64*                       pElapsedNs,
+    _Out_                         UINT64*                       pHostMapCount,
+    _Out_                         AML_MAPPING_CACHE_STATISTICS* pStatistics
+    )
+{
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* MethodNode;
+    AML_DATA            Result;
+    UINT64              HostMapCount;
+    UINT64              Start;
+    SIZE_T              i;
+    BOOLEAN             Success;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTableEx( Context, Parameters, Table, TableSize, Code, CodeSize, AML_TRUE ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    } else if( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZMAP", 0, &MethodNode ) == AML_FALSE ) {
+        printf( "Error: failed to find the synthetic benchmark method!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Only count the host map calls of the timed invocations, not the ones of the table load.
+    //
+    Success = AML_TRUE;
+    HostMapCount = Context->Host.MemoryMapCount;
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_REGION_MAP_ITERATIONS ) && Success; i++ ) {
+        Success = AmlEvalObject( &Context->State, MethodNode->Object, &Result, AML_TRUE );
+        if( Success ) {
+            AmlDataFree( &Result );
+        }
+    }
+    *pElapsedNs = ( AmlBenchTimeNs() - Start );
+    *pHostMapCount = ( Context->Host.MemoryMapCount - HostMapCount );
+    *pStatistics = Context->State.MappingCache.Statistics;
+    if( Success == AML_FALSE ) {
+        printf( "Error: synthetic region method failed!\n" );
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Evaluate a method that creates a temporary SystemMemory region (cycling through 4 pages) and reads fields of it
+// and of two static overlapping regions, with private host mappings per region, and with the shared mapping cache.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchRegionMap(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x08, 'Z', 'M', 'I', 'X', 0x00,                                 /* Name (ZMIX, Zero) */
+        0x5B, 0x80, 'Z', 'M', 'R', '0', 0x00,                           /* OperationRegion (ZMR0, SystemMemory, */
+        0x0C, 0x00, 0x00, 0xFE, 0x7F, 0x0B, 0x00, 0x01,                 /*   0x7FFE0000, 0x100) */
+        0x5B, 0x81, 0x0B, 'Z', 'M', 'R', '0', 0x00,                     /* Field (ZMR0, AnyAcc, NoLock, Preserve) */
+        'Z', 'F', '0', '0', 0x20,                                       /*   ZF00, 32 */
+        0x5B, 0x80, 'Z', 'M', 'R', '1', 0x00,                           /* OperationRegion (ZMR1, SystemMemory, */
+        0x0C, 0x80, 0x00, 0xFE, 0x7F, 0x0B, 0x00, 0x10,                 /*   0x7FFE0080, 0x1000) */
+        0x5B, 0x81, 0x0B, 'Z', 'M', 'R', '1', 0x00,                     /* Field (ZMR1, AnyAcc, NoLock, Preserve) */
+        'Z', 'F', '1', '0', 0x20,                                       /*   ZF10, 32 */
+        0x14, 0x47, 0x04, 'Z', 'M', 'A', 'P', 0x00,                     /* Method (ZMAP) */
+        0x75, 'Z', 'M', 'I', 'X',                                       /*   ZMIX++ */
+        0x7B, 'Z', 'M', 'I', 'X', 0x0A, 0x03, 0x60,                     /*   Local0 = ZMIX & 3 */
+        0x5B, 0x80, 'Z', 'T', 'M', 'P', 0x00,                           /*   OperationRegion (ZTMP, SystemMemory, */
+        0x72, 0x0C, 0x10, 0x00, 0xFE, 0x7F,                             /*     0x7FFE0010 + */
+        0x79, 0x60, 0x0A, 0x0C, 0x00, 0x00,                             /*     (Local0 << 12), */
+        0x0A, 0x20,                                                     /*     0x20) */
+        0x5B, 0x81, 0x0B, 'Z', 'T', 'M', 'P', 0x00,                     /*   Field (ZTMP, AnyAcc, NoLock, Preserve) */
+        'Z', 'T', 'F', '0', 0x20,                                       /*     ZTF0, 32 */
+        0xA4, 0x72, 'Z', 'T', 'F', '0',                                 /*   Return (ZTF0 + */
+        0x72, 'Z', 'F', '0', '0', 'Z', 'F', '1', '0', 0x00, 0x00,       /*     (ZF00 + ZF10)) */
+    };
+    AML_MAPPING_CACHE_STATISTICS PrivateStatistics;
+    AML_MAPPING_CACHE_STATISTICS CachedStatistics;
+    UINT64                       PrivateNs;
+    UINT64                       PrivateMapCount;
+    UINT64                       CachedNs;
+    UINT64                       CachedMapCount;
+
+    if( AmlBenchRegionMapTime( Table, TableSize, Code, sizeof( Code ),
+                               &( AML_STATE_PARAMETERS ){ 0 }, &PrivateNs, &PrivateMapCount, &PrivateStatistics ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    } else if( AmlBenchRegionMapTime( Table, TableSize, Code, sizeof( Code ),
+                                      &( AML_STATE_PARAMETERS ){ .UseMappingCache = AML_TRUE },
+                                      &CachedNs, &CachedMapCount, &CachedStatistics ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    }
+
+    //
+    // Note: the test host backs every mapping by a plain heap allocation, a real host map/unmap (page table updates,
+    // TLB invalidation) is considerably more expensive, the amount of host map calls is the more relevant figure.
+    //
+    printf( "Method creating a temporary 32-byte SystemMemory region, and reading fields of it and two overlapping static regions.\n" );
+    printf( "Private:   %8.0f ns per call, %6.3f host maps per call\n",
+            ( ( double )PrivateNs / AML_BENCH_REGION_MAP_ITERATIONS ),
+            ( ( double )PrivateMapCount / AML_BENCH_REGION_MAP_ITERATIONS ) );
+    printf( "Cached:    %8.0f ns per call, %6.3f host maps per call (%.2fx)\n",
+            ( ( double )CachedNs / AML_BENCH_REGION_MAP_ITERATIONS ),
+            ( ( double )CachedMapCount / AML_BENCH_REGION_MAP_ITERATIONS ),
+            ( ( double )PrivateNs / AML_MAX( CachedNs, 1 ) ) );
+    printf( "Mapping cache: %"PRIu64" acquisitions, %"PRIu64" map calls saved, %"PRIu64" host maps, %"PRIu64" host unmaps, "
+            "%"PRIu64" merges, %"PRIu64" evictions\n",
+            CachedStatistics.AcquireCount,
+            CachedStatistics.MapCallsSaved,
+            CachedStatistics.HostMapCount,
+            CachedStatistics.HostUnmapCount,
+            CachedStatistics.MergeCount,
+            CachedStatistics.EvictionCount );
+    return AML_TRUE;
+}
+
+//
+// Time the first and the following repeated invocations of the large SystemMemory region method
+// using a state created with the given parameters, returns the amount and total size of all host maps of the invocations.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchRegionWindowTime(
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                Code,
+    _In_                          SIZE_T                      CodeSize,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _Out_                         UINT64*                     pFirstNs,
+    _Out_                         UINT64*                     pElapsedNs,
+    _Out_                         UINT64*                     pHostMapCount,
+    _Out_                         UINT64*                     pHostMapSize
+    )
+{
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* MethodNode;
+    AML_DATA            Result;
+    UINT64              HostMapCount;
+    UINT64              HostMapSize;
+    UINT64              Start;
+    SIZE_T              i;
+    BOOLEAN             Success;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTableEx( Context, Parameters, Table, TableSize, Code, CodeSize, AML_TRUE ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    } else if( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZROR", 0, &MethodNode ) == AML_FALSE ) {
+        printf( "Error: failed to find the synthetic benchmark method!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // The first invocation maps the region (or its first windows), time it separately.
+    //
+    HostMapCount = Context->Host.MemoryMapCount;
+    HostMapSize = Context->Host.MemoryMapSize;
+    Start = AmlBenchTimeNs();
+    Success = AmlEvalObject( &Context->State, MethodNode->Object, &Result, AML_TRUE );
+    *pFirstNs = ( AmlBenchTimeNs() - Start );
+    if( Success ) {
+        AmlDataFree( &Result );
+    }
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_REGION_WINDOW_ITERATIONS ) && Success; i++ ) {
+        Success = AmlEvalObject( &Context->State, MethodNode->Object, &Result, AML_TRUE );
+        if( Success ) {
+            AmlDataFree( &Result );
+        }
+    }
+    *pElapsedNs = ( AmlBenchTimeNs() - Start );
+    *pHostMapCount = ( Context->Host.MemoryMapCount - HostMapCount );
+    *pHostMapSize = ( Context->Host.MemoryMapSize - HostMapSize );
+    if( Success == AML_FALSE ) {
+        printf( "Error: synthetic region method failed!\n" );
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Evaluate a method that reads a few fields spread over a 64 MiB SystemMemory region (ROM shadow style,
+// one field straddling a window boundary), with the region mapped entirely, and mapped on demand in windows.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchRegionWindow(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x5B, 0x80, 'Z', 'R', 'O', 'M', 0x00,                           /* OperationRegion (ZROM, SystemMemory, */
+        0x0C, 0x00, 0x00, 0x00, 0x7C, 0x0C, 0x00, 0x00, 0x00, 0x04,     /*   0x7C000000, 0x4000000) */
+        0x5B, 0x81, 0x2A, 'Z', 'R', 'O', 'M', 0x03,                     /* Field (ZROM, DWordAcc, NoLock, Preserve) */
+        0x00, 0x80, 0xFC, 0xFF,                                         /*   Offset (0x1FFF8) */
+        'Z', 'R', '0', '0', 0x20,                                       /*   ZR00, 32 */
+        0x00, 0x10,                                                     /*   Offset (0x1FFFE) */
+        'Z', 'R', '0', '1', 0x20,                                       /*   ZR01, 32 */
+        0x00, 0xC0, 0xFF, 0xFF, 0xFE,                                   /*   Offset (0x2000000) */
+        'Z', 'R', '0', '2', 0x20,                                       /*   ZR02, 32 */
+        0x00, 0xC0, 0xF6, 0xFF, 0xFF,                                   /*   Offset (0x3FFFFF0) */
+        'Z', 'R', '0', '3', 0x20,                                       /*   ZR03, 32 */
+        0x14, 0x1D, 'Z', 'R', 'O', 'R', 0x00,                           /* Method (ZROR) */
+        0xA4, 0x72,                                                     /*   Return ( */
+        0x72, 'Z', 'R', '0', '0', 'Z', 'R', '0', '1', 0x00,             /*     (ZR00 + ZR01) + */
+        0x72, 'Z', 'R', '0', '2', 'Z', 'R', '0', '3', 0x00, 0x00,       /*     (ZR02 + ZR03)) */
+    };
+    UINT64 EntireFirstNs;
+    UINT64 EntireNs;
+    UINT64 EntireMapCount;
+    UINT64 EntireMapSize;
+    UINT64 WindowedFirstNs;
+    UINT64 WindowedNs;
+    UINT64 WindowedMapCount;
+    UINT64 WindowedMapSize;
+
+    if( AmlBenchRegionWindowTime( Table, TableSize, Code, sizeof( Code ), &( AML_STATE_PARAMETERS ){ 0 },
+                                  &EntireFirstNs, &EntireNs, &EntireMapCount, &EntireMapSize ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    } else if( AmlBenchRegionWindowTime( Table, TableSize, Code, sizeof( Code ),
+                                         &( AML_STATE_PARAMETERS ){ .RegionWindowThreshold = AML_BENCH_REGION_WINDOW_THRESHOLD },
+                                         &WindowedFirstNs, &WindowedNs, &WindowedMapCount, &WindowedMapSize ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    }
+
+    printf( "Method reading 4 fields spread over a 64 MiB SystemMemory region, %u KiB windows, %u windows per region.\n",
+            ( UINT )( AML_BUILD_REGION_WINDOW_SIZE / 1024 ), ( UINT )AML_BUILD_REGION_WINDOW_COUNT );
+    printf( "Entire:    first call %10.0f ns, %8.0f ns per call, %"PRIu64" host maps, %10"PRIu64" bytes mapped\n",
+            ( double )EntireFirstNs,
+            ( ( double )EntireNs / AML_BENCH_REGION_WINDOW_ITERATIONS ),
+            EntireMapCount,
+            EntireMapSize );
+    printf( "Windowed:  first call %10.0f ns, %8.0f ns per call, %"PRIu64" host maps, %10"PRIu64" bytes mapped\n",
+            ( double )WindowedFirstNs,
+            ( ( double )WindowedNs / AML_BENCH_REGION_WINDOW_ITERATIONS ),
+            WindowedMapCount,
+            WindowedMapSize );
+    return AML_TRUE;
+}
+
+//
+// Time repeated invocations of the bridged PCI region method (renumbering the bridge buses every few invocations)
+// using a state created with the given parameters, returns a checksum of all results, the amount of PCI configuration reads,
+// and the PCI topology cache statistics of the state.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchPciTopologyTime(
+    _In_reads_bytes_( TableSize ) const UINT8*                       Table,
+    _In_                          SIZE_T                             TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                       Code,
+    _In_                          SIZE_T                             CodeSize,
+    _In_                          const AML_STATE_PARAMETERS*        Parameters,
+    _Out_                         UINT64*                            pElapsedNs,
+    _Out_                         UINT64*                            pChecksum,
+    _Out_                         UINT64*                            pReadCount,
+    _Out_                         AML_PCI_TOPOLOGY_CACHE_STATISTICS* pStatistics
+    )
+{
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* ReadNode;
+    AML_NAMESPACE_NODE* RenumberNode;
+    AML_DATA            Result;
+    UINT64              ReadCount;
+    UINT64              Start;
+    SIZE_T              i;
+    BOOLEAN             Success;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTableEx( Context, Parameters, Table, TableSize, Code, CodeSize, AML_TRUE ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    } else if( ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZPCR", 0, &ReadNode ) == AML_FALSE )
+               || ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZPCW", 0, &RenumberNode ) == AML_FALSE ) )
+    {
+        printf( "Error: failed to find the synthetic benchmark methods!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Every emulated PCI function is a bridge, and every 32-bit read returns the address that it was performed at.
+    //
+    Context->Host.IsPciBridgeEmulated = AML_TRUE;
+    Context->Host.PciBridgeBusStride = 1;
+    Success = AML_TRUE;
+    *pChecksum = 0;
+    ReadCount = Context->Host.PciConfigReadCount;
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_PCI_TOPOLOGY_ITERATIONS ) && Success; i++ ) {
+        if( ( i % AML_BENCH_PCI_TOPOLOGY_RENUMBER_INTERVAL ) == ( AML_BENCH_PCI_TOPOLOGY_RENUMBER_INTERVAL - 1 ) ) {
+            if( ( Success = AmlEvalObject( &Context->State, RenumberNode->Object, &Result, AML_TRUE ) ) ) {
+                AmlDataFree( &Result );
+            }
+        }
+        if( Success && ( Success = AmlEvalObject( &Context->State, ReadNode->Object, &Result, AML_TRUE ) ) ) {
+            *pChecksum = ( ( *pChecksum * 31 ) + ( ( Result.Type == AML_DATA_TYPE_INTEGER ) ? Result.u.Integer : 0 ) );
+            AmlDataFree( &Result );
+        }
+    }
+    *pElapsedNs = ( AmlBenchTimeNs() - Start );
+    *pReadCount = ( Context->Host.PciConfigReadCount - ReadCount );
+    *pStatistics = Context->State.PciTopology.Statistics;
+    if( Success == AML_FALSE ) {
+        printf( "Error: synthetic PCI region method failed!\n" );
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Evaluate a method that reads a named and a temporary PCI_Config region of a device behind two PCI-to-PCI bridges,
+// with the PCI information evaluated and resolved per region, and shared through the PCI topology cache.
+// The bridge buses are renumbered by AML every few invocations, both states must observe the same addresses.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchPciTopology(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x5B, 0x82, 0x45, 0x0A, 'Z', 'P', 'C', 'I',                     /* Device (ZPCI) */
+        0x08, '_', 'H', 'I', 'D', 0x0C, 0x41, 0xD0, 0x0A, 0x08,         /*   Name (_HID, EisaId ("PNP0A08")) */
+        0x08, '_', 'B', 'B', 'N', 0x00,                                 /*   Name (_BBN, Zero) */
+        0x5B, 0x82, 0x4D, 0x08, 'Z', 'B', 'R', '0',                     /*   Device (ZBR0) */
+        0x08, '_', 'A', 'D', 'R', 0x0C, 0x00, 0x00, 0x01, 0x00,         /*     Name (_ADR, 0x00010000) */
+        0x5B, 0x82, 0x4B, 0x07, 'Z', 'B', 'R', '1',                     /*     Device (ZBR1) */
+        0x08, '_', 'A', 'D', 'R', 0x0C, 0x00, 0x00, 0x02, 0x00,         /*       Name (_ADR, 0x00020000) */
+        0x5B, 0x80, 'Z', 'B', 'C', 'F', 0x02, 0x0A, 0x18, 0x0A, 0x04,   /*       OperationRegion (ZBCF, PCI_Config, 0x18, 4) */
+        0x5B, 0x81, 0x0D, 'Z', 'B', 'C', 'F', 0x01,                     /*       Field (ZBCF, ByteAcc, NoLock, Preserve) */
+        0x00, 0x08, 'Z', 'B', 'U', 'S', 0x08,                           /*         , 8, ZBUS, 8 */
+        0x5B, 0x82, 0x4F, 0x04, 'Z', 'D', 'E', 'V',                     /*       Device (ZDEV) */
+        0x08, '_', 'A', 'D', 'R', 0x0C, 0x00, 0x00, 0x03, 0x00,         /*         Name (_ADR, 0x00030000) */
+        0x5B, 0x80, 'Z', 'C', 'F', 'G', 0x02, 0x00, 0x0B, 0x00, 0x01,   /*         OperationRegion (ZCFG, PCI_Config, Zero, 0x100) */
+        0x5B, 0x81, 0x0B, 'Z', 'C', 'F', 'G', 0x03, 'Z', 'V', 'I', 'D', /*         Field (ZCFG, DWordAcc, NoLock, Preserve) */
+        0x20,                                                           /*           ZVID, 32 */
+        0x14, 0x26, 'Z', 'T', 'M', 'P', 0x00,                           /*         Method (ZTMP) */
+        0x5B, 0x80, 'Z', 'T', 'R', 'G', 0x02, 0x00, 0x0B, 0x00, 0x01,   /*           OperationRegion (ZTRG, PCI_Config, Zero, 0x100) */
+        0x5B, 0x81, 0x0B, 'Z', 'T', 'R', 'G', 0x03, 'Z', 'T', 'V', 'D', /*           Field (ZTRG, DWordAcc, NoLock, Preserve) */
+        0x20,                                                           /*             ZTVD, 32 */
+        0x70, 'Z', 'T', 'V', 'D', 0x60,                                 /*           Local0 = ZTVD */
+        0xA4, 0x60,                                                     /*           Return (Local0) */
+        0x08, 'Z', 'C', 'N', 'T', 0x00,                                 /* Name (ZCNT, Zero) */
+        0x14, 0x2D, 'Z', 'P', 'C', 'W', 0x00,                           /* Method (ZPCW) */
+        0x75, 'Z', 'C', 'N', 'T',                                       /*   Increment (ZCNT) */
+        0x70, 0x72, 0x7B, 'Z', 'C', 'N', 'T', 0x0A, 0x07, 0x00,         /*   \ZPCI.ZBR0.ZBR1.ZBUS = ((ZCNT & 7) */
+        0x0A, 0x02, 0x00,                                               /*     + 2) */
+        0x5C, 0x2F, 0x04, 'Z', 'P', 'C', 'I', 'Z', 'B', 'R', '0',
+        'Z', 'B', 'R', '1', 'Z', 'B', 'U', 'S',
+        0xA4, 0x00,                                                     /*   Return (Zero) */
+        0x14, 0x37, 'Z', 'P', 'C', 'R', 0x00,                           /* Method (ZPCR) */
+        0xA4, 0x72,                                                     /*   Return (\ZPCI.ZBR0.ZBR1.ZDEV.ZVID + */
+        0x5C, 0x2F, 0x05, 'Z', 'P', 'C', 'I', 'Z', 'B', 'R', '0',
+        'Z', 'B', 'R', '1', 'Z', 'D', 'E', 'V', 'Z', 'V', 'I', 'D',
+        0x5C, 0x2F, 0x05, 'Z', 'P', 'C', 'I', 'Z', 'B', 'R', '0',       /*     \ZPCI.ZBR0.ZBR1.ZDEV.ZTMP ()) */
+        'Z', 'B', 'R', '1', 'Z', 'D', 'E', 'V', 'Z', 'T', 'M', 'P',
+        0x00,
+    };
+    UINT64                            UncachedNs;
+    UINT64                            UncachedChecksum;
+    UINT64                            UncachedReadCount;
+    AML_PCI_TOPOLOGY_CACHE_STATISTICS UncachedStatistics;
+    UINT64                            CachedNs;
+    UINT64                            CachedChecksum;
+    UINT64                            CachedReadCount;
+    AML_PCI_TOPOLOGY_CACHE_STATISTICS CachedStatistics;
+
+    if( AmlBenchPciTopologyTime( Table, TableSize, Code, sizeof( Code ), &( AML_STATE_PARAMETERS ){ 0 },
+                                 &UncachedNs, &UncachedChecksum, &UncachedReadCount, &UncachedStatistics ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    } else if( AmlBenchPciTopologyTime( Table, TableSize, Code, sizeof( Code ),
+                                        &( AML_STATE_PARAMETERS ){ .UsePciTopologyCache = AML_TRUE },
+                                        &CachedNs, &CachedChecksum, &CachedReadCount, &CachedStatistics ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    } else if( UncachedChecksum != CachedChecksum ) {
+        printf( "Error: PCI region results differ with the PCI topology cache enabled!\n" );
+        return AML_FALSE;
+    }
+
+    printf( "Method reading a named and a temporary PCI_Config region behind 2 bridges, buses renumbered every %u calls.\n",
+            ( UINT )AML_BENCH_PCI_TOPOLOGY_RENUMBER_INTERVAL );
+    printf( "Uncached:  %8.0f ns per call, %6.2f PCI config reads per call\n",
+            ( ( double )UncachedNs / AML_BENCH_PCI_TOPOLOGY_ITERATIONS ),
+            ( ( double )UncachedReadCount / AML_BENCH_PCI_TOPOLOGY_ITERATIONS ) );
+    printf( "Cached:    %8.0f ns per call, %6.2f PCI config reads per call (%.2fx)\n",
+            ( ( double )CachedNs / AML_BENCH_PCI_TOPOLOGY_ITERATIONS ),
+            ( ( double )CachedReadCount / AML_BENCH_PCI_TOPOLOGY_ITERATIONS ),
+            ( ( double )UncachedNs / AML_MAX( CachedNs, 1 ) ) );
+    printf( "Topology cache: %"PRIu64" lookups, %"PRIu64" hits, %"PRIu64" evaluations, %"PRIu64" address resolves, "
+            "%"PRIu64" address hits, %"PRIu64" address invalidations\n",
+            CachedStatistics.LookupCount,
+            CachedStatistics.HitCount,
+            CachedStatistics.InsertCount,
+            CachedStatistics.AddressResolveCount,
+            CachedStatistics.AddressHitCount,
+            CachedStatistics.AddressInvalidationCount );
+    return AML_TRUE;
+}
+
+//
+// Timing results of the index field benchmark for a single set of state parameters.
+//
+typedef struct _AML_BENCH_INDEX_FIELD_TIMING {
+    UINT64 MethodNs;
+    UINT64 MethodWriteCount;
+    UINT64 MethodResult;
+    UINT64 UnitNs;
+    UINT64 UnitWriteCount;
+    UINT64 RunNs;
+    UINT64 RunWriteCount;
+    UINT64 Checksum;
+} AML_BENCH_INDEX_FIELD_TIMING;
+
+//
+// Time repeated invocations of the CMOS-style index field method using a state created with the given parameters,
+// and repeated reads of all index field units, both separately per unit and as a single run (AmlIndexFieldReadRun).
+// Returns the elapsed time and the amount of IO port writes of every part, and the results of all reads.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchIndexFieldTime(
+    _In_reads_bytes_( TableSize ) const UINT8*                  Table,
+    _In_                          SIZE_T                        TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                  Code,
+    _In_                          SIZE_T                        CodeSize,
+    _In_                          const AML_STATE_PARAMETERS*   Parameters,
+    _Out_                         AML_BENCH_INDEX_FIELD_TIMING* Timing
+    )
+{
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* MethodNode;
+    AML_NAMESPACE_NODE* UnitNode;
+    AML_OBJECT*         Units[ AML_BENCH_INDEX_FIELD_UNIT_COUNT ];
+    UINT64              Values[ AML_BENCH_INDEX_FIELD_UNIT_COUNT ];
+    CHAR                UnitPath[ 8 ];
+    AML_DATA            Result;
+    UINT64              WriteCount;
+    UINT64              Start;
+    SIZE_T              i;
+    SIZE_T              j;
+    BOOLEAN             Success;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTableEx( Context, Parameters, Table, TableSize, Code, CodeSize, AML_TRUE ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    }
+    Success = AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZCMR", 0, &MethodNode );
+    for( i = 0; ( i < AML_COUNTOF( Units ) ) && Success; i++ ) {
+        snprintf( UnitPath, sizeof( UnitPath ), "\\ZC0%X", ( UINT )i );
+        if( ( Success = AmlNamespaceSearchZ( &Context->State.Namespace, NULL, UnitPath, 0, &UnitNode ) ) ) {
+            Units[ i ] = UnitNode->Object;
+        }
+    }
+    if( Success == AML_FALSE ) {
+        printf( "Error: failed to find the synthetic benchmark objects!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    //
+    // Time the method, every loop iteration polls one unit twice and then writes and reads back another unit.
+    //
+    *Timing = ( AML_BENCH_INDEX_FIELD_TIMING ){ 0 };
+    Result = ( AML_DATA ){ .Type = AML_DATA_TYPE_NONE };
+    WriteCount = Context->Host.IoPortWriteCount;
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_INDEX_FIELD_ITERATIONS ) && Success; i++ ) {
+        AmlDataFree( &Result );
+        Success = AmlEvalObject( &Context->State, MethodNode->Object, &Result, AML_TRUE );
+    }
+    Timing->MethodNs = ( AmlBenchTimeNs() - Start );
+    Timing->MethodWriteCount = ( Context->Host.IoPortWriteCount - WriteCount );
+    if( ( Success == AML_FALSE ) || ( Result.Type != AML_DATA_TYPE_INTEGER ) ) {
+        printf( "Error: synthetic index field method failed!\n" );
+        Success = AML_FALSE;
+    } else {
+        Timing->MethodResult = Result.u.Integer;
+    }
+    AmlDataFree( &Result );
+
+    //
+    // Time reads of all units, once separately per unit, and once as a single run.
+    //
+    WriteCount = Context->Host.IoPortWriteCount;
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_INDEX_FIELD_RUN_ITERATIONS ) && Success; i++ ) {
+        for( j = 0; ( j < AML_COUNTOF( Units ) ) && Success; j++ ) {
+            Values[ j ] = 0;
+            Success = AmlFieldUnitRead( &Context->State, Units[ j ], &Values[ j ], sizeof( Values[ j ] ), AML_FALSE, NULL );
+            Timing->Checksum = ( ( Timing->Checksum * 31 ) + Values[ j ] );
+        }
+    }
+    Timing->UnitNs = ( AmlBenchTimeNs() - Start );
+    Timing->UnitWriteCount = ( Context->Host.IoPortWriteCount - WriteCount );
+    WriteCount = Context->Host.IoPortWriteCount;
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_INDEX_FIELD_RUN_ITERATIONS ) && Success; i++ ) {
+        Success = AmlIndexFieldReadRun( &Context->State, Units, AML_COUNTOF( Units ), Values );
+        for( j = 0; ( j < AML_COUNTOF( Units ) ) && Success; j++ ) {
+            Timing->Checksum = ( ( Timing->Checksum * 31 ) + Values[ j ] );
+        }
+    }
+    Timing->RunNs = ( AmlBenchTimeNs() - Start );
+    Timing->RunWriteCount = ( Context->Host.IoPortWriteCount - WriteCount );
+    if( Success == AML_FALSE ) {
+        printf( "Error: synthetic index field reads failed!\n" );
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Evaluate a CMOS-style method that polls and updates units of an index field behind SystemIO index/data registers,
+// and read all units from the host, with every index written before every access, and with index register elision.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchIndexField(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x5B, 0x80, 'Z', 'C', 'M', 'S', 0x01, 0x0A, 0x70, 0x0A, 0x02,   /* OperationRegion (ZCMS, SystemIO, 0x70, 0x02) */
+        0x5B, 0x81, 0x10, 'Z', 'C', 'M', 'S', 0x01,                     /* Field (ZCMS, ByteAcc, NoLock, Preserve) */
+        'Z', 'I', 'D', 'X', 0x08,                                       /*   ZIDX, 8 */
+        'Z', 'D', 'A', 'T', 0x08,                                       /*   ZDAT, 8 */
+        0x5B, 0x86, 0x4B, 0x05, 'Z', 'I', 'D', 'X', 'Z', 'D', 'A', 'T', /* IndexField (ZIDX, ZDAT, */
+        0x01,                                                           /*   ByteAcc, NoLock, Preserve) */
+        'Z', 'C', '0', '0', 0x08, 'Z', 'C', '0', '1', 0x08,             /*   ZC00, 8, ZC01, 8 */
+        'Z', 'C', '0', '2', 0x08, 'Z', 'C', '0', '3', 0x08,             /*   ZC02, 8, ZC03, 8 */
+        'Z', 'C', '0', '4', 0x08, 'Z', 'C', '0', '5', 0x08,             /*   ZC04, 8, ZC05, 8 */
+        'Z', 'C', '0', '6', 0x08, 'Z', 'C', '0', '7', 0x08,             /*   ZC06, 8, ZC07, 8 */
+        'Z', 'C', '0', '8', 0x08, 'Z', 'C', '0', '9', 0x08,             /*   ZC08, 8, ZC09, 8 */
+        'Z', 'C', '0', 'A', 0x08, 'Z', 'C', '0', 'B', 0x08,             /*   ZC0A, 8, ZC0B, 8 */
+        'Z', 'C', '0', 'C', 0x08, 'Z', 'C', '0', 'D', 0x08,             /*   ZC0C, 8, ZC0D, 8 */
+        'Z', 'C', '0', 'E', 0x08, 'Z', 'C', '0', 'F', 0x08,             /*   ZC0E, 8, ZC0F, 8 */
+        0x14, 0x31, 'Z', 'C', 'M', 'R', 0x00,                           /* Method (ZCMR) */
+        0x70, 0x00, 0x60,                                               /*   Local0 = Zero */
+        0x70, 0x00, 0x61,                                               /*   Local1 = Zero */
+        0xA2, 0x22, 0x95, 0x60, 0x0A, AML_BENCH_INDEX_FIELD_LOOP_COUNT, /*   While (Local0 < LOOP_COUNT) */
+        0x72, 0x61, 'Z', 'C', '0', '0', 0x61,                           /*     Local1 += ZC00 */
+        0x72, 0x61, 'Z', 'C', '0', '0', 0x61,                           /*     Local1 += ZC00 */
+        0x70, 0x60, 'Z', 'C', '0', '1',                                 /*     ZC01 = Local0 */
+        0x72, 0x61, 'Z', 'C', '0', '1', 0x61,                           /*     Local1 += ZC01 */
+        0x75, 0x60,                                                     /*     Local0++ */
+        0xA4, 0x61,                                                     /*   Return (Local1) */
+    };
+    AML_BENCH_INDEX_FIELD_TIMING Regular;
+    AML_BENCH_INDEX_FIELD_TIMING Elided;
+    UINT64                       UnitCount;
+
+    if( AmlBenchIndexFieldTime( Table, TableSize, Code, sizeof( Code ), &( AML_STATE_PARAMETERS ){ 0 }, &Regular ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlBenchIndexFieldTime( Table, TableSize, Code, sizeof( Code ),
+                                       &( AML_STATE_PARAMETERS ){ .UseIndexRegisterElision = AML_TRUE }, &Elided ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    } else if( ( Regular.MethodResult != Elided.MethodResult ) || ( Regular.Checksum != Elided.Checksum ) ) {
+        printf( "Error: index register elision results differ!\n" );
+        return AML_FALSE;
+    }
+
+    UnitCount = ( ( UINT64 )AML_BENCH_INDEX_FIELD_RUN_ITERATIONS * AML_BENCH_INDEX_FIELD_UNIT_COUNT );
+    printf( "CMOS-style method with %u loop iterations of 4 index field accesses each, and host reads of %u index field units.\n",
+            AML_BENCH_INDEX_FIELD_LOOP_COUNT, AML_BENCH_INDEX_FIELD_UNIT_COUNT );
+    printf( "Regular: %8.0f ns per call (%5.1f IO writes), per unit %6.1f ns (%.2f IO writes), run %6.1f ns (%.2f IO writes)\n",
+            ( ( double )Regular.MethodNs / AML_BENCH_INDEX_FIELD_ITERATIONS ),
+            ( ( double )Regular.MethodWriteCount / AML_BENCH_INDEX_FIELD_ITERATIONS ),
+            ( ( double )Regular.UnitNs / UnitCount ),
+            ( ( double )Regular.UnitWriteCount / UnitCount ),
+            ( ( double )Regular.RunNs / UnitCount ),
+            ( ( double )Regular.RunWriteCount / UnitCount ) );
+    printf( "Elided:  %8.0f ns per call (%5.1f IO writes), per unit %6.1f ns (%.2f IO writes), run %6.1f ns (%.2f IO writes)\n",
+            ( ( double )Elided.MethodNs / AML_BENCH_INDEX_FIELD_ITERATIONS ),
+            ( ( double )Elided.MethodWriteCount / AML_BENCH_INDEX_FIELD_ITERATIONS ),
+            ( ( double )Elided.UnitNs / UnitCount ),
+            ( ( double )Elided.UnitWriteCount / UnitCount ),
+            ( ( double )Elided.RunNs / UnitCount ),
+            ( ( double )Elided.RunWriteCount / UnitCount ) );
+    return AML_TRUE;
+}
@@ -0,0 +1,380 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "runtest_bench_common.h"
+#include "aml_field.h"
+
+//
+// Amount of states instantiated by fully loading the table, and by cloning an initialized template state.
+//
+#define AML_BENCH_CLONE_ITERATIONS 1000
+
+//
+// Amount of clones of an initialized template state held at once, with private and with shared namespace data.
+//
+#define AML_BENCH_SHARE_STATE_COUNT 64
+
+//
+// Amount of timed Load invocations of the synthetic SSDT, and its size (must fit the 3-byte package length of its If).
+//
+#define AML_BENCH_TABLE_LOAD_ITERATIONS 500
+#define AML_BENCH_TABLE_LOAD_SIZE       ( 64 * 1024 )
+
+//
+// Time repeated Load invocations of the synthetic SSDT using a state created with the given parameters,
+// the SSDT is first written to the SystemMemory region through a field, and then loaded directly from the region.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlBenchLoadTime(
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize,
+    _In_reads_bytes_( CodeSize )  const UINT8*                Code,
+    _In_                          SIZE_T                      CodeSize,
+    _In_reads_bytes_( SsdtSize )  const UINT8*                Ssdt,
+    _In_                          SIZE_T                      SsdtSize,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _Out_                         UINT64*                     pElapsedNs
+    )
+{
+    AML_BENCH_CONTEXT*  Context;
+    AML_NAMESPACE_NODE* MethodNode;
+    AML_NAMESPACE_NODE* FieldNode;
+    AML_DATA            Result;
+    UINT64              Start;
+    SIZE_T              i;
+    BOOLEAN             Success;
+
+    if( ( Context = malloc( sizeof( *Context ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( AmlBenchLoadTableEx( Context, Parameters, Table, TableSize, Code, CodeSize, AML_TRUE ) == AML_FALSE ) {
+        free( Context );
+        return AML_FALSE;
+    } else if( ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZLDT", 0, &MethodNode ) == AML_FALSE )
+               || ( AmlNamespaceSearchZ( &Context->State.Namespace, NULL, "\\ZTBF", 0, &FieldNode ) == AML_FALSE ) )
+    {
+        printf( "Error: failed to find the synthetic benchmark objects!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    } else if( AmlFieldUnitWrite( &Context->State, FieldNode->Object, Ssdt, SsdtSize, AML_FALSE ) == AML_FALSE ) {
+        printf( "Error: failed to write the synthetic SSDT to the region!\n" );
+        AmlStateFree( &Context->State );
+        free( Context );
+        return AML_FALSE;
+    }
+
+    Success = AML_TRUE;
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_TABLE_LOAD_ITERATIONS ) && Success; i++ ) {
+        Success = AmlEvalObject( &Context->State, MethodNode->Object, &Result, AML_TRUE );
+        if( Success ) {
+            Success = ( ( Result.Type == AML_DATA_TYPE_INTEGER ) && ( Result.u.Integer != 0 ) );
+            AmlDataFree( &Result );
+        }
+    }
+    *pElapsedNs = ( AmlBenchTimeNs() - Start );
+    if( Success == AML_FALSE ) {
+        printf( "Error: synthetic Load method failed!\n" );
+    }
+
+    AmlStateFree( &Context->State );
+    free( Context );
+    return Success;
+}
+
+//
+// Load a 64 KiB SSDT from a SystemMemory region, read through the region space handler in batches of access words,
+// copied straight from the region mapping (direct access), and evaluated in place within the region mapping.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchLoad(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    static const UINT8 Code[ ] = {
+        0x5B, 0x80, 'Z', 'T', 'B', 'R', 0x00,                           /* OperationRegion (ZTBR, SystemMemory, */
+        0x0C, 0x00, 0x00, 0xE0, 0x7F, 0x0C, 0x00, 0x00, 0x01, 0x00,     /*   0x7FE00000, 0x10000) */
+        0x5B, 0x81, 0x0D, 'Z', 'T', 'B', 'R', 0x00,                     /* Field (ZTBR, AnyAcc, NoLock, Preserve) */
+        'Z', 'T', 'B', 'F', 0x80, 0x00, 0x80,                           /*   ZTBF, 0x80000 */
+        0x14, 0x0F, 'Z', 'L', 'D', 'T', 0x00,                           /* Method (ZLDT) */
+        0x5B, 0x20, 'Z', 'T', 'B', 'R', 0x60,                           /*   Load (ZTBR, Local0) */
+        0xA4, 0x60,                                                     /*   Return (Local0) */
+    };
+    AML_DESCRIPTION_HEADER Header;
+    UINT8*                 Ssdt;
+    SIZE_T                 PkgLength;
+    SIZE_T                 i;
+    UINT64                 WordNs;
+    UINT64                 DirectNs;
+    UINT64                 InPlaceNs;
+    BOOLEAN                Success;
+
+    //
+    // Build an SSDT consisting of a single If (Zero) containing a Buffer up to the full table size.
+    //
+    if( ( Ssdt = malloc( AML_BENCH_TABLE_LOAD_SIZE ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    Header = ( AML_DESCRIPTION_HEADER ){ .Signature = 0x54445353, .Length = AML_BENCH_TABLE_LOAD_SIZE, .Revision = 2 };
+    memcpy( Ssdt, &Header, sizeof( Header ) );
+    PkgLength = ( AML_BENCH_TABLE_LOAD_SIZE - sizeof( Header ) - 1 );
+    Ssdt[ sizeof( Header ) + 0 ] = 0xA0;
+    Ssdt[ sizeof( Header ) + 1 ] = ( UINT8 )( 0x80 | ( PkgLength & 0xF ) );
+    Ssdt[ sizeof( Header ) + 2 ] = ( UINT8 )( PkgLength >> 4 );
+    Ssdt[ sizeof( Header ) + 3 ] = ( UINT8 )( PkgLength >> 12 );
+    Ssdt[ sizeof( Header ) + 4 ] = 0x00;
+    PkgLength -= 5;
+    Ssdt[ sizeof( Header ) + 5 ] = 0x11;
+    Ssdt[ sizeof( Header ) + 6 ] = ( UINT8 )( 0x80 | ( PkgLength & 0xF ) );
+    Ssdt[ sizeof( Header ) + 7 ] = ( UINT8 )( PkgLength >> 4 );
+    Ssdt[ sizeof( Header ) + 8 ] = ( UINT8 )( PkgLength >> 12 );
+    Ssdt[ sizeof( Header ) + 9 ] = 0x00;
+    for( i = ( sizeof( Header ) + 10 ); i < AML_BENCH_TABLE_LOAD_SIZE; i++ ) {
+        Ssdt[ i ] = ( UINT8 )i;
+    }
+
+    Success = ( AmlBenchLoadTime( Table, TableSize, Code, sizeof( Code ), Ssdt, AML_BENCH_TABLE_LOAD_SIZE,
+                                  &( AML_STATE_PARAMETERS ){ 0 }, &WordNs )
+                && AmlBenchLoadTime( Table, TableSize, Code, sizeof( Code ), Ssdt, AML_BENCH_TABLE_LOAD_SIZE,
+                                     &( AML_STATE_PARAMETERS ){ .UseDirectSystemMemoryAccess = AML_TRUE }, &DirectNs )
+                && AmlBenchLoadTime( Table, TableSize, Code, sizeof( Code ), Ssdt, AML_BENCH_TABLE_LOAD_SIZE,
+                                     &( AML_STATE_PARAMETERS ){ .UseDirectSystemMemoryAccess = AML_TRUE, .UseInPlaceTableLoad = AML_TRUE },
+                                     &InPlaceNs ) );
+    free( Ssdt );
+    if( Success == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    printf( "Method loading a %u KiB SSDT from a SystemMemory region.\n", ( UINT )( AML_BENCH_TABLE_LOAD_SIZE / 1024 ) );
+    printf( "Words:     %10.0f ns per load\n",
+            ( ( double )WordNs / AML_BENCH_TABLE_LOAD_ITERATIONS ) );
+    printf( "Direct:    %10.0f ns per load (%.2fx)\n",
+            ( ( double )DirectNs / AML_BENCH_TABLE_LOAD_ITERATIONS ),
+            ( ( double )WordNs / AML_MAX( DirectNs, 1 ) ) );
+    printf( "In place:  %10.0f ns per load (%.2fx)\n",
+            ( ( double )InPlaceNs / AML_BENCH_TABLE_LOAD_ITERATIONS ),
+            ( ( double )WordNs / AML_MAX( InPlaceNs, 1 ) ) );
+    return AML_TRUE;
+}
+
+//
+// Count all namespace nodes of the state.
+//
+static
+SIZE_T
+AmlBenchCountNodes(
+    _In_ const AML_STATE* State
+    )
+{
+    const AML_NAMESPACE_NODE* Node;
+    SIZE_T                    Count;
+
+    Count = 0;
+    for( Node = State->Namespace.InOrderNodeHead; Node != NULL; Node = Node->InOrderNext ) {
+        Count++;
+    }
+    return Count;
+}
+
+//
+// Instantiate states for the given table by fully loading it (including initial _INI/_REG handling),
+// and by cloning an initialized template state, every clone must hold the same amount of nodes as the template.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchClone(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_BENCH_CONTEXT* Template;
+    AML_BENCH_CONTEXT* Context;
+    AML_STATE*         Clone;
+    AML_ALLOCATOR      Allocator;
+    SIZE_T             NodeCount;
+    UINT64             Start;
+    UINT64             LoadNs;
+    UINT64             FreezeNs;
+    UINT64             CloneNs;
+    SIZE_T             i;
+    BOOLEAN            Success;
+
+    Template = malloc( sizeof( *Template ) );
+    Context  = malloc( sizeof( *Context ) );
+    Clone    = malloc( sizeof( *Clone ) );
+    if( ( Template == NULL ) || ( Context == NULL ) || ( Clone == NULL ) ) {
+        free( Template );
+        free( Context );
+        free( Clone );
+        return AML_FALSE;
+    }
+
+    //
+    // Instantiate every state by loading the table from scratch.
+    //
+    Success = AML_TRUE;
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_CLONE_ITERATIONS ) && Success; i++ ) {
+        Success = AmlBenchLoadTable( Context, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize );
+        if( Success ) {
+            AmlStateFree( &Context->State );
+        }
+    }
+    LoadNs = ( AmlBenchTimeNs() - Start );
+    if( Success == AML_FALSE ) {
+        free( Template );
+        free( Context );
+        free( Clone );
+        return AML_FALSE;
+    }
+
+    //
+    // Instantiate every state as a clone of a single frozen template state.
+    //
+    if( AmlBenchLoadTable( Template, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Template );
+        free( Context );
+        free( Clone );
+        return AML_FALSE;
+    }
+    NodeCount = AmlBenchCountNodes( &Template->State );
+    Allocator = ( AML_ALLOCATOR ){ .Allocate = AmlBenchMemoryAllocate, .Free = AmlBenchMemoryFree };
+    Start = AmlBenchTimeNs();
+    if( AmlStateFreezeTemplate( &Template->State ) == AML_FALSE ) {
+        printf( "Error: AmlStateFreezeTemplate failed!\n" );
+        Success = AML_FALSE;
+    }
+    FreezeNs = ( AmlBenchTimeNs() - Start );
+    Start = AmlBenchTimeNs();
+    for( i = 0; ( i < AML_BENCH_CLONE_ITERATIONS ) && Success; i++ ) {
+        Success = AmlStateClone( &Template->State, Clone, Allocator, &( AML_STATE_PARAMETERS ){ .Host = &Template->Host } );
+        if( Success ) {
+            if( AmlBenchCountNodes( Clone ) != NodeCount ) {
+                printf( "Error: clone holds %"PRIu64" nodes, template holds %"PRIu64" nodes!\n",
+                        ( UINT64 )AmlBenchCountNodes( Clone ),
+                        ( UINT64 )NodeCount );
+                Success = AML_FALSE;
+            }
+            AmlStateFree( Clone );
+        } else {
+            printf( "Error: AmlStateClone failed!\n" );
+        }
+    }
+    CloneNs = ( AmlBenchTimeNs() - Start );
+    AmlStateFree( &Template->State );
+    free( Template );
+    free( Context );
+    free( Clone );
+    if( Success == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    printf( "Instantiation of %u states holding %"PRIu64" namespace nodes.\n", ( UINT )AML_BENCH_CLONE_ITERATIONS, ( UINT64 )NodeCount );
+    printf( "Full load: %10.0f ns per state\n",
+            ( ( double )LoadNs / AML_BENCH_CLONE_ITERATIONS ) );
+    printf( "Clone:     %10.0f ns per state (%.2fx), freezing the template: %.0f ns\n",
+            ( ( double )CloneNs / AML_BENCH_CLONE_ITERATIONS ),
+            ( ( double )LoadNs / AML_MAX( CloneNs, 1 ) ),
+            ( double )FreezeNs );
+    return AML_TRUE;
+}
+
+//
+// Hold many clones of an initialized template state at once, with and without sharing the static named data of the template,
+// and compare the memory private to each clone against the memory shared by all clones.
+//
+_Success_( return )
+BOOLEAN
+AmlBenchShare(
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_BENCH_CONTEXT*     Template;
+    AML_STATE*             Clones;
+    AML_ALLOCATOR          Allocator;
+    AML_STATE_MEMORY_USAGE Usage;
+    UINT64                 PrivateSize[ 2 ];
+    UINT64                 SharedSize[ 2 ];
+    UINT64                 SharedObjectCount[ 2 ];
+    UINT64                 CloneNs[ 2 ];
+    UINT64                 Start;
+    SIZE_T                 CloneCount;
+    SIZE_T                 Mode;
+    SIZE_T                 i;
+    BOOLEAN                Success;
+
+    Template = malloc( sizeof( *Template ) );
+    Clones   = malloc( sizeof( Clones[ 0 ] ) * AML_BENCH_SHARE_STATE_COUNT );
+    if( ( Template == NULL ) || ( Clones == NULL ) ) {
+        free( Template );
+        free( Clones );
+        return AML_FALSE;
+    } else if( AmlBenchLoadTable( Template, &( AML_STATE_PARAMETERS ){ 0 }, Table, TableSize ) == AML_FALSE ) {
+        free( Template );
+        free( Clones );
+        return AML_FALSE;
+    } else if( AmlStateFreezeTemplate( &Template->State ) == AML_FALSE ) {
+        printf( "Error: AmlStateFreezeTemplate failed!\n" );
+        AmlStateFree( &Template->State );
+        free( Template );
+        free( Clones );
+        return AML_FALSE;
+    }
+
+    //
+    // Clone the frozen template with private (mode 0) and with shared (mode 1) namespace data.
+    //
+    Allocator = ( AML_ALLOCATOR ){ .Allocate = AmlBenchMemoryAllocate, .Free = AmlBenchMemoryFree };
+    Success = AML_TRUE;
+    for( Mode = 0; ( Mode < 2 ) && Success; Mode++ ) {
+        Start = AmlBenchTimeNs();
+        for( CloneCount = 0; ( CloneCount < AML_BENCH_SHARE_STATE_COUNT ) && Success; CloneCount++ ) {
+            Success = AmlStateClone( &Template->State,
+                                     &Clones[ CloneCount ],
+                                     Allocator,
+                                     &( AML_STATE_PARAMETERS ){ .Host = &Template->Host, .UseSharedNamespace = ( Mode != 0 ) } );
+            if( Success == AML_FALSE ) {
+                break;
+            }
+        }
+        CloneNs[ Mode ] = ( AmlBenchTimeNs() - Start );
+
+        //
+        // Sum up the memory usage of all clones held at once.
+        //
+        PrivateSize[ Mode ] = 0;
+        SharedSize[ Mode ] = 0;
+        SharedObjectCount[ Mode ] = 0;
+        for( i = 0; i < CloneCount; i++ ) {
+            AmlStateQueryMemoryUsage( &Clones[ i ], &Usage );
+            PrivateSize[ Mode ] += Usage.PrivateSize;
+            SharedSize[ Mode ] = Usage.SharedSize;
+            SharedObjectCount[ Mode ] = Usage.SharedObjectCount;
+            AmlStateFree( &Clones[ i ] );
+        }
+    }
+    AmlStateFree( &Template->State );
+    free( Template );
+    free( Clones );
+    if( Success == AML_FALSE ) {
+        printf( "Error: AmlStateClone failed!\n" );
+        return AML_FALSE;
+    }
+
+    printf( "%u clones of an initialized template state held at once.\n", ( UINT )AML_BENCH_SHARE_STATE_COUNT );
+    for( Mode = 0; Mode < 2; Mode++ ) {
+        printf( "%s %10.0f ns per clone, %10"PRIu64" private bytes per clone, %10"PRIu64" shared bytes, %"PRIu64" shared objects per clone, total %"PRIu64" bytes\n",
+                ( ( Mode == 0 ) ? "Private:" : "Shared: " ),
+                ( ( double )CloneNs[ Mode ] / AML_BENCH_SHARE_STATE_COUNT ),
+                ( PrivateSize[ Mode ] / AML_BENCH_SHARE_STATE_COUNT ),
+                SharedSize[ Mode ],
+                SharedObjectCount[ Mode ],
+                ( PrivateSize[ Mode ] + SharedSize[ Mode ] ) );
+    }
+    return AML_TRUE;
+}
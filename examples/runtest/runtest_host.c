@@ -1,8 +1,14 @@
 #include <stdio.h>
+#include <stdlib.h>
+#ifdef AML_TEST_HAS_THREADS
+ #include <threads.h>
+#endif
+#include <time.h>
 #include "runtest_host.h"
 #include "aml_host.h"
 #include "aml_debug.h"
 #include "aml_namespace.h"
+#include "aml_pci.h"
 
 //
 // ACPI global lock format.
@@ -12,6 +18,11 @@
 #define ACPI_GLOBAL_LOCK_OWNED_SHIFT   1ul
 #define ACPI_GLOBAL_LOCK_OWNED_FLAG    (1ul << 1) /* Non-zero indicates that the Global Lock is Owned. */
 
+//
+// Page size of the fake test memory mappings, mapped addresses keep the page offset of the physical address.
+//
+#define AML_TEST_HOST_PAGE_SIZE 4096
+
 //
 // Interlocked/atomic compare and exchange intrinsic.
 // Behaves like _InterlockedCompareExchange from MSVC.
@@ -46,18 +57,18 @@
 #endif
 
 //
-// Host debug print helpers.
+// Host debug print helpers, silenced while the host context is in quiet mode (benchmarks).
 //
 #ifndef AML_HOST_PRINTF
  #ifndef AML_BUILD_FUZZER
-  #define AML_HOST_PRINTF(...) printf(__VA_ARGS__)
+  #define AML_HOST_PRINTF(...) ((Host->IsQuiet) ? ((VOID)0) : ((VOID)printf(__VA_ARGS__)))
  #else
   #define AML_HOST_PRINTF(...) ((VOID)0)
  #endif
 #endif
 #ifndef AML_HOST_VPRINTF
  #ifndef AML_BUILD_FUZZER
-  #define AML_HOST_VPRINTF(...) vprintf(__VA_ARGS__)
+  #define AML_HOST_VPRINTF(...) ((Host->IsQuiet) ? ((VOID)0) : ((VOID)vprintf(__VA_ARGS__)))
  #else
   #define AML_HOST_VPRINTF(...) ((VOID)0)
  #endif
@@ -240,19 +251,30 @@ AmlHostMemoryMap(
     _Outptr_ VOID**            ppMappedAddress
     )
 {
-    VOID* Allocation;
+    SIZE_T PageOffset;
+    VOID*  Allocation;
+    UINT8* PageBase;
 
     //
     // Attempt to allocate a block of fake test memory for the caller.
     // Does not handle the case of multiple maps of the physical address,
     // the simple fake memory system is just to implement the ACPICA testcases.
+    // Like a real mapping, the returned address is at the page offset of the physical address within a page-aligned block,
+    // so naturally aligned physical addresses stay aligned. The original allocation is stored right before the page base.
     //
-    if( ( Allocation = malloc( Size ) ) == NULL ) {
+    PageOffset = ( SIZE_T )( PhysicalAddress & ( AML_TEST_HOST_PAGE_SIZE - 1 ) );
+    if( ( Size > ( SIZE_MAX - sizeof( VOID* ) - ( AML_TEST_HOST_PAGE_SIZE - 1 ) - PageOffset ) )
+        || ( ( Allocation = malloc( sizeof( VOID* ) + ( AML_TEST_HOST_PAGE_SIZE - 1 ) + PageOffset + ( SIZE_T )Size ) ) == NULL ) )
+    {
         return AML_FALSE;
     }
-    AML_MEMSET( Allocation, 0, Size );
-    AML_HOST_PRINTF( "Host: Mapping physical address 0x%"PRIx64" (size=0x%"PRIx64") (virtual=0x%p)\n", PhysicalAddress, Size, Allocation );
-    *ppMappedAddress = Allocation;
+    PageBase = ( UINT8* )( ( ( SIZE_T )Allocation + sizeof( VOID* ) + ( AML_TEST_HOST_PAGE_SIZE - 1 ) ) & ~( SIZE_T )( AML_TEST_HOST_PAGE_SIZE - 1 ) );
+    AML_MEMCPY( ( PageBase - sizeof( VOID* ) ), &Allocation, sizeof( VOID* ) );
+    AML_MEMSET( &PageBase[ PageOffset ], 0, ( SIZE_T )Size );
+    Host->MemoryMapCount += 1;
+    Host->MemoryMapSize += Size;
+    AML_HOST_PRINTF( "Host: Mapping physical address 0x%"PRIx64" (size=0x%"PRIx64") (virtual=0x%p)\n", PhysicalAddress, Size, &PageBase[ PageOffset ] );
+    *ppMappedAddress = &PageBase[ PageOffset ];
     return AML_TRUE;
 }
 
@@ -267,8 +289,20 @@ AmlHostMemoryUnmap(
     _In_     UINT64            Size
     )
 {
+    UINT8* PageBase;
+    VOID*  Allocation;
+
+    //
+    // Recover the original allocation stored right before the page base of the mapping.
+    // PCI regions are released as mapped regions without a mapped address.
+    //
     AML_HOST_PRINTF( "Host: Unmapping virtual address 0x%p (size: 0x%"PRIx64")\n", MappedAddress, Size );
-    free( MappedAddress );
+    if( MappedAddress == NULL ) {
+        return AML_TRUE;
+    }
+    PageBase = ( UINT8* )( ( SIZE_T )MappedAddress & ~( SIZE_T )( AML_TEST_HOST_PAGE_SIZE - 1 ) );
+    AML_MEMCPY( &Allocation, ( PageBase - sizeof( VOID* ) ), sizeof( VOID* ) );
+    free( Allocation );
     return AML_TRUE;
 }
 
@@ -298,7 +332,25 @@ AmlHostMutexCreate(
     _Out_   UINT64*           MutexHandleOutput
     )
 {
+#ifdef AML_TEST_HAS_THREADS
+    mtx_t* Mutex;
+
+    //
+    // Mutexes are recursive, AML allows the owner of a mutex to acquire it again.
+    //
+    if( ( Mutex = malloc( sizeof( *Mutex ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( mtx_init( Mutex, ( mtx_timed | mtx_recursive ) ) != thrd_success ) {
+        free( Mutex );
+        return AML_FALSE;
+    }
+    *MutexHandleOutput = ( UINT64 )( UINT_PTR )Mutex;
+#else
+    //
+    // Without thread support, the test host is single threaded, and mutexes are never contended.
+    //
     *MutexHandleOutput = AML_RDTSC();
+#endif
     AML_HOST_PRINTF( "Host: Creating internal mutex object: 0x%"PRIx64"\n", *MutexHandleOutput );
     return AML_TRUE;
 }
@@ -314,8 +366,38 @@ AmlHostMutexAcquire(
     _In_    UINT64            TimeoutMs
     )
 {
+#ifdef AML_TEST_HAS_THREADS
+    mtx_t*          Mutex;
+    struct timespec Deadline;
+    INT             Status;
+#endif
+
     AML_HOST_PRINTF( "Host: Awaiting acquire of internal mutex object: 0x%"PRIx64" (timeout: 0x%"PRIx64")\n", MutexHandle, TimeoutMs );
+#ifdef AML_TEST_HAS_THREADS
+    Mutex = ( mtx_t* )( UINT_PTR )MutexHandle;
+    if( TimeoutMs >= 0xFFFF ) {
+        Status = mtx_lock( Mutex );
+    } else {
+        timespec_get( &Deadline, TIME_UTC );
+        Deadline.tv_sec += ( time_t )( TimeoutMs / 1000 );
+        Deadline.tv_nsec += ( long )( ( TimeoutMs % 1000 ) * 1000000 );
+        if( Deadline.tv_nsec >= 1000000000 ) {
+            Deadline.tv_sec += 1;
+            Deadline.tv_nsec -= 1000000000;
+        }
+        Status = mtx_timedlock( Mutex, &Deadline );
+    }
+    switch( Status ) {
+    case thrd_success:
+        return AML_WAIT_STATUS_SUCCESS;
+    case thrd_timedout:
+        return AML_WAIT_STATUS_TIMEOUT;
+    default:
+        return AML_WAIT_STATUS_ERROR;
+    }
+#else
     return AML_WAIT_STATUS_SUCCESS;
+#endif
 }
 
 //
@@ -328,6 +410,9 @@ AmlHostMutexRelease(
     )
 {
     AML_HOST_PRINTF( "Host: Releasing internal mutex object: 0x%"PRIx64"\n", MutexHandle );
+#ifdef AML_TEST_HAS_THREADS
+    mtx_unlock( ( mtx_t* )( UINT_PTR )MutexHandle );
+#endif
 }
 
 //
@@ -339,7 +424,16 @@ AmlHostMutexFree(
     _In_    UINT64            MutexHandle
     )
 {
+#ifdef AML_TEST_HAS_THREADS
+    mtx_t* Mutex;
+#endif
+
     AML_HOST_PRINTF( "Host: Freeing internal mutex object: 0x%"PRIx64"\n", MutexHandle );
+#ifdef AML_TEST_HAS_THREADS
+    Mutex = ( mtx_t* )( UINT_PTR )MutexHandle;
+    mtx_destroy( Mutex );
+    free( Mutex );
+#endif
 }
 
 //
@@ -444,7 +538,11 @@ AmlHostSleep(
 {
     Milliseconds = AML_MIN( Milliseconds, 5000 );
     AML_HOST_PRINTF( "Host: Sleeping for %"PRIu64" millisecond(s).\n", Milliseconds );
-    // Sleep( ( DWORD )Milliseconds );
+#ifdef AML_TEST_HAS_THREADS
+    if( Host->IsSleepEnabled ) {
+        thrd_sleep( &( struct timespec ){ .tv_sec = ( Milliseconds / 1000 ), .tv_nsec = ( ( Milliseconds % 1000 ) * 1000000l ) }, NULL );
+    }
+#endif
 }
 
 //
@@ -538,6 +636,7 @@ AmlHostIoPortWrite8(
     _In_    UINT8             Value
     )
 {
+    Host->IoPortWriteCount += 1;
     AML_HOST_PRINTF( "Host: Write8 0x%"PRIx64" to IO port 0x%x\n", ( UINT64 )Value, ( UINT )PortIndex );
 }
 
@@ -551,6 +650,7 @@ AmlHostIoPortWrite16(
     _In_    UINT16            Value
     )
 {
+    Host->IoPortWriteCount += 1;
     AML_HOST_PRINTF( "Host: Write16 0x%"PRIx64" to IO port 0x%x\n", ( UINT64 )Value, ( UINT )PortIndex );
 }
 
@@ -564,6 +664,7 @@ AmlHostIoPortWrite32(
     _In_    UINT32            Value
     )
 {
+    Host->IoPortWriteCount += 1;
     AML_HOST_PRINTF( "Host: Write32 0x%"PRIx64" to IO port 0x%x\n", ( UINT64 )Value, ( UINT )PortIndex );
 }
 
@@ -693,6 +794,19 @@ AmlHostPciConfigRead8(
         ( UINT )Address.Function,
         Offset
     );
+    Host->PciConfigReadCount += 1;
+
+    //
+    // Emulated bridges report a PCI-to-PCI bridge header and a secondary bus number.
+    //
+    if( Host->IsPciBridgeEmulated ) {
+        switch( Offset ) {
+        case AML_PCI_CFS_OFFSET_HEADER_TYPE:
+            return AML_PCI_CFS_HEADER_TYPE_PCI_TO_PCI_BRIDGE;
+        case AML_PCI_CFS_OFFSET_BRIDGE_SECONDARY_BUS:
+            return ( UINT8 )( Address.Bus + Host->PciBridgeBusStride );
+        }
+    }
     return 0xFF;
 }
 
@@ -714,6 +828,7 @@ AmlHostPciConfigRead16(
         ( UINT )Address.Function,
         Offset
     );
+    Host->PciConfigReadCount += 1;
     return 0xFFFF;
 }
 
@@ -735,6 +850,14 @@ AmlHostPciConfigRead32(
         ( UINT )Address.Function,
         Offset
     );
+    Host->PciConfigReadCount += 1;
+
+    //
+    // Emulated functions return their own address, allowing the resolved address of an access to be checked.
+    //
+    if( Host->IsPciBridgeEmulated ) {
+        return ( ( ( UINT32 )Address.Bus << 16 ) | ( ( UINT32 )Address.Device << 8 ) | Address.Function );
+    }
     return 0xFFFFFFFF;
 }
 
@@ -756,6 +879,7 @@ AmlHostPciConfigRead64(
         ( UINT )Address.Function,
         Offset
     );
+    Host->PciConfigReadCount += 1;
     return 0xFFFFFFFFFFFFFFFF;
 }
 
@@ -779,6 +903,13 @@ AmlHostPciConfigWrite8(
         ( UINT )Address.Function,
         Offset
     );
+
+    //
+    // Renumber all emulated bridges relative to the written one.
+    //
+    if( Host->IsPciBridgeEmulated && ( Offset == AML_PCI_CFS_OFFSET_BRIDGE_SECONDARY_BUS ) ) {
+        Host->PciBridgeBusStride = ( UINT8 )( Value - Address.Bus );
+    }
 }
 
 //
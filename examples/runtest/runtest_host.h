@@ -5,4 +5,12 @@
 //
 struct _AML_HOST_CONTEXT {
     volatile LONG* GlobalLock;
+    BOOLEAN        IsQuiet;
+    BOOLEAN        IsSleepEnabled; /* Actually block the calling thread in AmlHostSleep (used by benchmarks). */
+    UINT64         MemoryMapCount; /* Amount of successful AmlHostMemoryMap calls (used by benchmarks). */
+    UINT64         MemoryMapSize;  /* Total size of all successful AmlHostMemoryMap calls (used by benchmarks). */
+    UINT64         PciConfigReadCount; /* Amount of PCI configuration space reads (used by benchmarks). */
+    UINT64         IoPortWriteCount;   /* Amount of IO port writes (used by benchmarks). */
+    BOOLEAN        IsPciBridgeEmulated; /* Emulate every PCI function as a bridge with secondary bus (Bus + PciBridgeBusStride) (used by benchmarks). */
+    UINT8          PciBridgeBusStride;  /* Set by 8-bit writes to the secondary bus register of emulated bridges (secondary bus - Bus). */
 };
\ No newline at end of file
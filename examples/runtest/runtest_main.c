@@ -1,10 +1,24 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "runtest_host.h"
+#include "runtest_bench.h"
+#include "runtest_stress.h"
 #include "aml_platform.h"
 #include "aml_eval.h"
 #include "aml_base.h"
 #include "aml_debug.h"
+#include "aml_namespace_image.h"
+
+//
+// Optional allocation limit of the test allocator (allocator context), used to catch unbounded memory growth.
+// Allocators without a context are unlimited.
+//
+typedef struct _AML_TEST_MEMORY_LIMIT {
+    SIZE_T Limit;     /* Maximum amount of outstanding allocated bytes, 0 if unlimited. */
+    SIZE_T Allocated; /* Current amount of outstanding allocated bytes. */
+} AML_TEST_MEMORY_LIMIT;
 
 //
 // User-provided allocator interface callback to allocate memory.
@@ -17,7 +31,27 @@ AmlTestMemoryAllocate(
     _In_    SIZE_T Size
     )
 {
-    return malloc( Size );
+    AML_TEST_MEMORY_LIMIT* MemoryLimit;
+    VOID*                  Allocation;
+
+    //
+    // Fail any allocation that would exceed the limit.
+    //
+    MemoryLimit = Context;
+    if( MemoryLimit == NULL ) {
+        return malloc( Size );
+    } else if( ( MemoryLimit->Limit != 0 ) && ( Size > ( MemoryLimit->Limit - MemoryLimit->Allocated ) ) ) {
+        printf( "Error: Allocation of %zu bytes exceeds the memory limit (%zu of %zu bytes allocated).\n", Size, MemoryLimit->Allocated, MemoryLimit->Limit );
+        return NULL;
+    }
+
+    //
+    // Track the outstanding allocated size.
+    //
+    if( ( Allocation = malloc( Size ) ) != NULL ) {
+        MemoryLimit->Allocated += Size;
+    }
+    return Allocation;
 }
 
 //
@@ -32,10 +66,165 @@ AmlTestMemoryFree(
     _In_             SIZE_T AllocationSize
     )
 {
+    AML_TEST_MEMORY_LIMIT* MemoryLimit;
+
+    MemoryLimit = Context;
+    if( MemoryLimit != NULL ) {
+        MemoryLimit->Allocated -= AllocationSize;
+    }
     free( Allocation );
     return AML_TRUE;
 }
 
+//
+// Command-line options of the test application.
+//
+typedef struct _AML_TEST_OPTIONS {
+    const CHAR*          BenchmarkName;      /* Run the named benchmark instead of the regular tests (-b). */
+    SIZE_T               ThreadCount;        /* Run the multithreaded stress test instead of the regular tests (-t). */
+    const CHAR*          ImageFileName;      /* Load the namespace from a namespace image file, produced if needed (-i). */
+    BOOLEAN              UseClone;           /* Run the regular tests on a clone of the initialized state (-c). */
+    BOOLEAN              UseSharedNamespace; /* The clone shares the static named data of the initialized state (-s). */
+    SIZE_T               MemoryLimit;        /* Fail allocations of the state past this size in bytes, unlimited if 0 (-m). */
+    AML_STATE_PARAMETERS Features;           /* Optional interpreter features enabled for the regular tests (-f). */
+} AML_TEST_OPTIONS;
+
+//
+// Enable an optional interpreter feature in the state creation parameters.
+//
+typedef
+VOID
+( *AML_TEST_ENABLE_ROUTINE )(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    );
+
+//
+// Named optional interpreter feature, enabled for the regular tests using runtest -f <feature>.
+//
+typedef struct _AML_TEST_FEATURE {
+    const CHAR*             Name;
+    const CHAR*             Description;
+    AML_TEST_ENABLE_ROUTINE Enable;
+} AML_TEST_FEATURE;
+
+//
+// Optional interpreter feature callbacks.
+//
+static
+VOID
+AmlTestEnableNameCache(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->UseNameResolutionCache = AML_TRUE;
+}
+
+static
+VOID
+AmlTestEnableNamespaceCapacity(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->NamespaceCapacityHint = 4096;
+}
+
+static
+VOID
+AmlTestEnableSkipIndex(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->UseNamespaceSkipIndex = AML_TRUE;
+}
+
+static
+VOID
+AmlTestEnableDirectMemory(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->UseDirectSystemMemoryAccess = AML_TRUE;
+}
+
+static
+VOID
+AmlTestEnableMappingCache(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->UseMappingCache = AML_TRUE;
+}
+
+static
+VOID
+AmlTestEnableRegionWindow(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->RegionWindowThreshold = 128;
+}
+
+static
+VOID
+AmlTestEnablePciTopology(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->UsePciTopologyCache = AML_TRUE;
+}
+
+static
+VOID
+AmlTestEnableIndexElision(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->UseIndexRegisterElision = AML_TRUE;
+}
+
+static
+VOID
+AmlTestEnableInPlaceLoad(
+    _Inout_ AML_STATE_PARAMETERS* Parameters
+    )
+{
+    Parameters->UseInPlaceTableLoad = AML_TRUE;
+}
+
+//
+// All available optional interpreter features.
+//
+static const AML_TEST_FEATURE AmlTestFeatures[ ] = {
+    { "name-cache",         "Per-call-site name resolution caches", AmlTestEnableNameCache },
+    { "namespace-capacity", "Namespace hash table pre-sized for 4096 nodes", AmlTestEnableNamespaceCapacity },
+    { "skip-index",         "Namespace pass skip indexes of loaded tables", AmlTestEnableSkipIndex },
+    { "direct-memory",      "Direct field access through SystemMemory region mappings", AmlTestEnableDirectMemory },
+    { "mapping-cache",      "Shared host mappings of overlapping SystemMemory regions", AmlTestEnableMappingCache },
+    { "region-window",      "SystemMemory regions larger than 128 bytes mapped on demand in windows", AmlTestEnableRegionWindow },
+    { "pci-topology",       "Shared PCI topology resolution of PCI_Config and PCI_BAR_Target regions", AmlTestEnablePciTopology },
+    { "index-elision",      "Elision of redundant index register writes of index fields", AmlTestEnableIndexElision },
+    { "in-place-load",      "Evaluation of loaded tables in place, without a heap copy", AmlTestEnableInPlaceLoad },
+};
+
+//
+// Find an optional interpreter feature by name, returns NULL if there is no such feature.
+//
+static
+const AML_TEST_FEATURE*
+AmlTestFindFeature(
+    _In_z_ const CHAR* FeatureName
+    )
+{
+    SIZE_T i;
+
+    for( i = 0; i < AML_COUNTOF( AmlTestFeatures ); i++ ) {
+        if( strcmp( AmlTestFeatures[ i ].Name, FeatureName ) == 0 ) {
+            return &AmlTestFeatures[ i ];
+        }
+    }
+    return NULL;
+}
+
 //
 // Recursively debug print a namespace tree node and all of its children.
 //
@@ -79,26 +268,215 @@ AmlTestPrintNamespaceTreeNode(
     }
 }
 
+//
+// Current wall-clock time in nanoseconds.
+//
+static
+UINT64
+AmlTestTimeNs(
+    VOID
+    )
+{
+    struct timespec Time;
+
+    timespec_get( &Time, TIME_UTC );
+    return ( ( ( UINT64 )Time.tv_sec * 1000000000ull ) + ( UINT64 )Time.tv_nsec );
+}
+
+//
+// Read an entire namespace image file, returns NULL if the file doesn't exist or can't be read.
+// The returned buffer is allocated using malloc, and is suitably aligned for AmlNamespaceImageLoad.
+//
+static
+VOID*
+AmlTestReadImageFile(
+    _In_z_ const CHAR* FileName,
+    _Out_  SIZE_T*     pImageSize
+    )
+{
+    FILE* ImageFile;
+    LONG  FileSize;
+    VOID* Image;
+
+#ifdef _MSC_VER
+    if( fopen_s( &ImageFile, FileName, "rb" ) != 0 ) {
+#else
+    if( ( ImageFile = fopen( FileName, "rb" ) ) == NULL ) {
+#endif
+        return NULL;
+    }
+
+    Image = NULL;
+    if( ( fseek( ImageFile, 0, SEEK_END ) == 0 )
+        && ( ( FileSize = ftell( ImageFile ) ) > 0 )
+        && ( fseek( ImageFile, 0, SEEK_SET ) == 0 )
+        && ( ( Image = malloc( ( SIZE_T )FileSize ) ) != NULL ) )
+    {
+        if( fread( Image, 1, ( SIZE_T )FileSize, ImageFile ) != ( SIZE_T )FileSize ) {
+            free( Image );
+            Image = NULL;
+        }
+        *pImageSize = ( SIZE_T )FileSize;
+    }
+    fclose( ImageFile );
+    return Image;
+}
+
+//
+// Load the namespace of the given table from a namespace image file (instead of loading the table code).
+// If the image file doesn't exist, or doesn't match the table, the table is loaded normally by a scratch state,
+// and a new image is produced, written to the image file, and loaded by the given state (timing each step).
+// The returned images (including any rejected image, which may be partially referenced by the state if it was corrupt)
+// must remain allocated until the given state has been freed.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlTestLoadNamespaceImage(
+    _Inout_                       AML_STATE*                  State,
+    _In_                          const AML_STATE_PARAMETERS* Parameters,
+    _In_reads_bytes_( TableSize ) const UINT8*                Table,
+    _In_                          SIZE_T                      TableSize,
+    _In_z_                        const CHAR*                 ImageFileName,
+    _Outptr_                      VOID**                      ppImage,
+    _Outptr_                      VOID**                      ppRejectedImage
+    )
+{
+    AML_NAMESPACE_IMAGE_TABLE ImageTable;
+    AML_STATE                 ScratchState;
+    AML_ALLOCATOR             Allocator;
+    VOID*                     Image;
+    VOID*                     BuiltImage;
+    SIZE_T                    ImageSize;
+    UINT64                    StartTime;
+    UINT64                    LoadTime;
+    UINT64                    BuildTime;
+    FILE*                     ImageFile;
+    BOOLEAN                   Success;
+
+    //
+    // Attempt to load an existing image file matching the table.
+    //
+    ImageTable = ( AML_NAMESPACE_IMAGE_TABLE ){ .Table = Table, .TableSize = TableSize };
+    if( ( Image = AmlTestReadImageFile( ImageFileName, &ImageSize ) ) != NULL ) {
+        StartTime = AmlTestTimeNs();
+        if( AmlNamespaceImageLoad( State, Image, ImageSize, &ImageTable, 1 ) ) {
+            printf( "Namespace image (%zu bytes) loaded in %"PRIu64" us.\n", ImageSize, ( ( AmlTestTimeNs() - StartTime ) / 1000 ) );
+            *ppImage = Image;
+            return AML_TRUE;
+        }
+        printf( "Namespace image doesn't match the table, producing a new image.\n" );
+        *ppRejectedImage = Image;
+    }
+
+    //
+    // Load the table normally using a scratch state, and produce a new image of the loaded namespace.
+    //
+    Allocator = ( AML_ALLOCATOR ){ .Allocate = AmlTestMemoryAllocate, .Free = AmlTestMemoryFree };
+    if( AmlStateCreate( &ScratchState, Allocator, Parameters ) == AML_FALSE ) {
+        printf( "Error: AmlStateCreate failed!\n" );
+        AmlStateFree( &ScratchState );
+        return AML_FALSE;
+    } else if( AmlCreatePredefinedNamespaces( &ScratchState ) == AML_FALSE ) {
+        printf( "Error: AmlCreatePredefinedNamespaces failed!\n" );
+        AmlStateFree( &ScratchState );
+        return AML_FALSE;
+    }
+    AmlCreatePredefinedObjects( &ScratchState );
+    StartTime = AmlTestTimeNs();
+    if( AmlEvalLoadedTableCode( &ScratchState, &Table[ sizeof( AML_DESCRIPTION_HEADER ) ], ( TableSize - sizeof( AML_DESCRIPTION_HEADER ) ), NULL ) == AML_FALSE ) {
+        printf( "Error: AmlEvalLoadedTableCode failed!\n" );
+        AmlStateFree( &ScratchState );
+        return AML_FALSE;
+    }
+    LoadTime = ( AmlTestTimeNs() - StartTime );
+    StartTime = AmlTestTimeNs();
+    if( AmlNamespaceImageBuild( &ScratchState, &ImageTable, 1, &BuiltImage, &ImageSize ) == AML_FALSE ) {
+        printf( "Error: AmlNamespaceImageBuild failed!\n" );
+        AmlStateFree( &ScratchState );
+        return AML_FALSE;
+    }
+    BuildTime = ( AmlTestTimeNs() - StartTime );
+
+    //
+    // Copy the image out of the scratch state heap, and write it to the image file.
+    //
+    if( ( Image = malloc( ImageSize ) ) == NULL ) {
+        printf( "Error: Failed to allocate memory for the namespace image.\n" );
+        AmlNamespaceImageFree( &ScratchState, BuiltImage );
+        AmlStateFree( &ScratchState );
+        return AML_FALSE;
+    }
+    AML_MEMCPY( Image, BuiltImage, ImageSize );
+    AmlNamespaceImageFree( &ScratchState, BuiltImage );
+    AmlStateFree( &ScratchState );
+#ifdef _MSC_VER
+    if( fopen_s( &ImageFile, ImageFileName, "wb" ) != 0 ) {
+#else
+    if( ( ImageFile = fopen( ImageFileName, "wb" ) ) == NULL ) {
+#endif
+        perror( "Error" );
+        printf( "Error: Failed to open output image file: %s\n", ImageFileName );
+        free( Image );
+        return AML_FALSE;
+    }
+    Success = ( fwrite( Image, 1, ImageSize, ImageFile ) == ImageSize );
+    fclose( ImageFile );
+    if( Success == AML_FALSE ) {
+        printf( "Error: Failed to write output image file: %s\n", ImageFileName );
+        free( Image );
+        return AML_FALSE;
+    }
+
+    //
+    // Load the namespace of the new image.
+    //
+    *ppImage = Image;
+    StartTime = AmlTestTimeNs();
+    if( AmlNamespaceImageLoad( State, Image, ImageSize, &ImageTable, 1 ) == AML_FALSE ) {
+        printf( "Error: AmlNamespaceImageLoad failed!\n" );
+        return AML_FALSE;
+    }
+    printf(
+        "Table loaded in %"PRIu64" us, namespace image (%zu bytes) built in %"PRIu64" us, loaded in %"PRIu64" us.\n",
+        ( LoadTime / 1000 ),
+        ImageSize,
+        ( BuildTime / 1000 ),
+        ( ( AmlTestTimeNs() - StartTime ) / 1000 )
+    );
+    return AML_TRUE;
+}
+
 //
 // Attempt to load and evaluate a table from the given file path.
+// The state is created with the optional features of the given options, and set up and tested as described by the options
+// (namespace image, clone, memory limit, see AML_TEST_OPTIONS).
 //
 _Success_( return )
 static
 BOOLEAN
 AmlTestExecuteSingleTable(
-    _In_reads_bytes_( InputSize ) const UINT8* Input,
-    _In_                          SIZE_T       InputSize,
-    _In_                          BOOLEAN      IgnoreHeader
+    _In_reads_bytes_( InputSize ) const UINT8*            Input,
+    _In_                          SIZE_T                  InputSize,
+    _In_                          BOOLEAN                 IgnoreHeader,
+    _In_                          const AML_TEST_OPTIONS* Options
     )
 {
     AML_DESCRIPTION_HEADER TableHeader;
+    AML_TEST_MEMORY_LIMIT  AllocatorLimit;
     BOOLEAN                Use64BitInteger;
     const UINT8*           TableData;
     SIZE_T                 TableDataSize;
     AML_ALLOCATOR          Allocator;
+    AML_STATE_PARAMETERS   Parameters;
+    AML_STATE_PARAMETERS   CloneParameters;
     AML_STATE              State;
+    AML_STATE              Clone;
+    AML_STATE*             TestState;
     volatile LONG          AcpiGlobalLock;
     AML_HOST_CONTEXT       Host;
+    VOID*                  Image;
+    VOID*                  RejectedImage;
     AML_NAMESPACE_NODE*    TsfiNode;
     const AML_DATA*        TsfiValue;
     AML_NAMESPACE_NODE*    TestMain;
@@ -140,18 +518,23 @@ AmlTestExecuteSingleTable(
     //
     AcpiGlobalLock = 0;
     Host = ( AML_HOST_CONTEXT ){ .GlobalLock = &AcpiGlobalLock };
-    Allocator = ( AML_ALLOCATOR ){ .Allocate = AmlTestMemoryAllocate, .Free = AmlTestMemoryFree };
-    if( AmlStateCreate(
-        &State,
-        Allocator,
-        &( AML_STATE_PARAMETERS ){
-            .Host            = &Host,
-            .Use64BitInteger = Use64BitInteger,
-        } ) == AML_FALSE )
-    {
+    AllocatorLimit = ( AML_TEST_MEMORY_LIMIT ){ .Limit = Options->MemoryLimit };
+    Allocator = ( AML_ALLOCATOR ){ .Context = &AllocatorLimit, .Allocate = AmlTestMemoryAllocate, .Free = AmlTestMemoryFree };
+    Parameters = Options->Features;
+    Parameters.Host = &Host;
+    Parameters.Use64BitInteger = Use64BitInteger;
+    Image = NULL;
+    RejectedImage = NULL;
+    TestState = &State;
+    if( AmlStateCreate( &State, Allocator, &Parameters ) == AML_FALSE ) {
         printf( "Error: AmlStateCreate failed!\n" );
     FAIL_FREE_STATE:
+        if( TestState != &State ) {
+            AmlStateFree( TestState );
+        }
         AmlStateFree( &State );
+        free( Image );
+        free( RejectedImage );
         return AML_FALSE;
     }
 
@@ -168,7 +551,11 @@ AmlTestExecuteSingleTable(
     // Attempt to execute the input code.
     //
     _Analysis_assume_( TableData != NULL );
-    if( AmlEvalLoadedTableCode( &State, TableData, TableDataSize, NULL ) == AML_FALSE ) {
+    if( Options->ImageFileName != NULL ) {
+        if( AmlTestLoadNamespaceImage( &State, &Parameters, Input, ( TableDataSize + sizeof( TableHeader ) ), Options->ImageFileName, &Image, &RejectedImage ) == AML_FALSE ) {
+            goto FAIL_FREE_STATE;
+        }
+    } else if( AmlEvalLoadedTableCode( &State, TableData, TableDataSize, NULL ) == AML_FALSE ) {
 #ifndef AML_BUILD_FUZZER
         printf( "Error: AmlEvalLoadedTableCode failed!\n" );
 #endif
@@ -181,32 +568,49 @@ AmlTestExecuteSingleTable(
     //
     AmlCompleteInitialLoad( &State, AML_TRUE );
 
+    //
+    // Optionally run the remaining tests against a clone of the initialized state, instead of the state itself.
+    // Clones using the shared namespace of the template copy any shared objects modified by the tests.
+    //
+    if( Options->UseClone ) {
+        CloneParameters = Parameters;
+        CloneParameters.UseSharedNamespace = Options->UseSharedNamespace;
+        if( AmlStateFreezeTemplate( &State ) == AML_FALSE ) {
+            printf( "Error: AmlStateFreezeTemplate failed!\n" );
+            goto FAIL_FREE_STATE;
+        } else if( AmlStateClone( &State, &Clone, Allocator, &CloneParameters ) == AML_FALSE ) {
+            printf( "Error: AmlStateClone failed!\n" );
+            goto FAIL_FREE_STATE;
+        }
+        TestState = &Clone;
+    }
+
     //
     // Dump the entire created namespace in hierarchical tree format.
     //
 #ifndef AML_BUILD_FUZZER
-    AmlTestPrintNamespaceTreeNode( &State, &State.Namespace.TreeRoot, 0 );
+    AmlTestPrintNamespaceTreeNode( TestState, &TestState->Namespace.TreeRoot, 0 );
 #endif
 
     //
     // Test broadcasting _REG.
     //
-    AmlRegisterRegionSpaceAccessHandler( &State, AML_REGION_SPACE_TYPE_SMBUS, AmlOperationRegionHandlerDefaultNull, NULL, AML_TRUE );
+    AmlRegisterRegionSpaceAccessHandler( TestState, AML_REGION_SPACE_TYPE_SMBUS, AmlOperationRegionHandlerDefaultNull, NULL, AML_TRUE );
 
     //
     // Check for any test case failures (TSFI object will contain the index of the last test case failure).
     //
-    if( AmlNamespaceSearchZ( &State.Namespace, NULL, "TSFI", 0, &TsfiNode ) ) {
+    if( AmlNamespaceSearchZ( &TestState->Namespace, NULL, "TSFI", 0, &TsfiNode ) ) {
         if( TsfiNode->Object->Type == AML_OBJECT_TYPE_NAME ) {
             TsfiValue = &TsfiNode->Object->u.Name.Value;
             if( ( TsfiValue->Type != AML_DATA_TYPE_INTEGER ) || ( TsfiValue->u.Integer != 0 ) ) {
-                AML_DEBUG_ERROR( &State, "Error: One or more test cases failed! Last failed TSFI value: " );
+                AML_DEBUG_ERROR( TestState, "Error: One or more test cases failed! Last failed TSFI value: " );
                 if( TsfiValue->Type == AML_DATA_TYPE_INTEGER ) {
-                    AML_DEBUG_ERROR( &State, "%"PRId64"", TsfiValue->u.Integer );
+                    AML_DEBUG_ERROR( TestState, "%"PRId64"", TsfiValue->u.Integer );
                 } else {
-                    AmlDebugPrintDataValue( &State, AML_DEBUG_LEVEL_ERROR, TsfiValue );
+                    AmlDebugPrintDataValue( TestState, AML_DEBUG_LEVEL_ERROR, TsfiValue );
                 }
-                AML_DEBUG_ERROR( &State, "\n" );
+                AML_DEBUG_ERROR( TestState, "\n" );
                 goto FAIL_FREE_STATE;
             }
         }
@@ -216,10 +620,10 @@ AmlTestExecuteSingleTable(
     // If the namespace has a MAIN method, execute it.
     // This is used to support ACPICA testcases (specifically grammar.asl).
     //
-    if( AmlNamespaceSearchZ( &State.Namespace, NULL, "MAIN", 0, &TestMain ) ) {
+    if( AmlNamespaceSearchZ( &TestState->Namespace, NULL, "MAIN", 0, &TestMain ) ) {
         if( ( TestMain->Object != NULL ) && ( TestMain->Object->Type == AML_OBJECT_TYPE_METHOD ) ) {
-            if( AmlMethodInvoke( &State, TestMain->Object, 0, NULL, 0, NULL ) == AML_FALSE ) {
-                AML_DEBUG_ERROR( &State, "ACPICA-style testcase MAIN invoke failed!\n" );
+            if( AmlMethodInvoke( TestState, TestMain->Object, 0, NULL, 0, NULL ) == AML_FALSE ) {
+                AML_DEBUG_ERROR( TestState, "ACPICA-style testcase MAIN invoke failed!\n" );
                 goto FAIL_FREE_STATE;
             }
         }
@@ -228,17 +632,17 @@ AmlTestExecuteSingleTable(
     //
     // Check for any test case failures (ACPI style), ERRS will contain the amount of failed test cases.
     //
-    if( AmlNamespaceSearchZ( &State.Namespace, NULL, "\\ERRS", 0, &ErrsNode ) ) {
+    if( AmlNamespaceSearchZ( &TestState->Namespace, NULL, "\\ERRS", 0, &ErrsNode ) ) {
         if( ErrsNode->Object->Type == AML_OBJECT_TYPE_NAME ) {
             TsfiValue = &ErrsNode->Object->u.Name.Value;
             if( ( TsfiValue->Type != AML_DATA_TYPE_INTEGER ) || ( TsfiValue->u.Integer != 0 ) ) {
-                AML_DEBUG_ERROR( &State, "Error: One or more test cases failed! ERRS count: " );
+                AML_DEBUG_ERROR( TestState, "Error: One or more test cases failed! ERRS count: " );
                 if( TsfiValue->Type == AML_DATA_TYPE_INTEGER ) {
-                    AML_DEBUG_ERROR( &State, "%"PRId64"", TsfiValue->u.Integer );
+                    AML_DEBUG_ERROR( TestState, "%"PRId64"", TsfiValue->u.Integer );
                 } else {
-                    AmlDebugPrintDataValue( &State, AML_DEBUG_LEVEL_ERROR, TsfiValue );
+                    AmlDebugPrintDataValue( TestState, AML_DEBUG_LEVEL_ERROR, TsfiValue );
                 }
-                AML_DEBUG_ERROR( &State, "\n" );
+                AML_DEBUG_ERROR( TestState, "\n" );
                 goto FAIL_FREE_STATE;
             }
         }
@@ -255,18 +659,27 @@ AmlTestExecuteSingleTable(
 #ifndef AML_BUILD_FUZZER
     printf( "\n\nAll test cases completed successfully.\n" );
 #endif
+    if( TestState != &State ) {
+        AmlStateFree( TestState );
+    }
     AmlStateFree( &State );
+    free( Image );
+    free( RejectedImage );
     return AML_TRUE;
 }
 
 //
 // Attempt to load and evaluate a table from the given file path.
+// If a benchmark name is given, the named benchmark is run on the table instead of the regular tests.
+// If a non-zero thread count is given, the multithreaded stress test is run on the table instead of the regular tests.
+// Otherwise the regular tests are run as described by the remaining options (see AmlTestExecuteSingleTable).
 //
 _Success_( return == EXIT_SUCCESS )
 static
 INT
 AmlTestMain(
-    _In_z_ const CHAR* FileName
+    _In_z_ const CHAR*             FileName,
+    _In_   const AML_TEST_OPTIONS* Options
     )
 {
     AML_DESCRIPTION_HEADER TableHeader;
@@ -329,7 +742,13 @@ AmlTestMain(
         //
         // Attempt to execute the actual test from the input table.
         //
-        Success = AmlTestExecuteSingleTable( TableData, TableHeader.Length, AML_FALSE );
+        if( Options->BenchmarkName != NULL ) {
+            Success = AmlTestRunBenchmark( Options->BenchmarkName, TableData, TableHeader.Length );
+        } else if( Options->ThreadCount != 0 ) {
+            Success = AmlTestRunStress( Options->ThreadCount, TableData, TableHeader.Length );
+        } else {
+            Success = AmlTestExecuteSingleTable( TableData, TableHeader.Length, AML_FALSE, Options );
+        }
     } while( 0 );
     fclose( TableFile );
 
@@ -358,7 +777,7 @@ LLVMFuzzerTestOneInput(
     _In_                     SIZE_T       Size
     )
 {
-    AmlTestExecuteSingleTable( Data, Size, AML_TRUE );
+    AmlTestExecuteSingleTable( Data, Size, AML_TRUE, &( AML_TEST_OPTIONS ){ 0 } );
     return 0;
 }
 
@@ -377,16 +796,56 @@ main(
     )
 {
 #ifndef AML_BUILD_LOCAL_DEV_TEST
-    if( ArgC < 2 ) {
+    AML_TEST_OPTIONS        Options;
+    const AML_TEST_FEATURE* Feature;
+    INT                     i;
+    SIZE_T                  j;
+
+    //
+    // runtest [-b <benchmark>] [-t <threads>] [-i <image path>] [-c] [-s] [-m <memory limit MiB>] [-f <feature>]... <table path>
+    //
+    Options = ( AML_TEST_OPTIONS ){ 0 };
+    for( i = 1; i < ( ArgC - 1 ); i++ ) {
+        if( strcmp( ArgV[ i ], "-c" ) == 0 ) {
+            Options.UseClone = AML_TRUE;
+        } else if( strcmp( ArgV[ i ], "-s" ) == 0 ) {
+            Options.UseClone = AML_TRUE;
+            Options.UseSharedNamespace = AML_TRUE;
+        } else if( ( i + 2 ) >= ArgC ) {
+            break;
+        } else if( strcmp( ArgV[ i ], "-b" ) == 0 ) {
+            Options.BenchmarkName = ArgV[ ++i ];
+        } else if( ( strcmp( ArgV[ i ], "-t" ) == 0 ) && ( atoi( ArgV[ i + 1 ] ) > 0 ) ) {
+            Options.ThreadCount = ( SIZE_T )atoi( ArgV[ ++i ] );
+        } else if( strcmp( ArgV[ i ], "-i" ) == 0 ) {
+            Options.ImageFileName = ArgV[ ++i ];
+        } else if( ( strcmp( ArgV[ i ], "-m" ) == 0 ) && ( atoi( ArgV[ i + 1 ] ) > 0 ) ) {
+            Options.MemoryLimit = ( ( SIZE_T )atoi( ArgV[ ++i ] ) << 20 );
+        } else if( ( strcmp( ArgV[ i ], "-f" ) == 0 ) && ( ( Feature = AmlTestFindFeature( ArgV[ i + 1 ] ) ) != NULL ) ) {
+            Feature->Enable( &Options.Features );
+            i++;
+        } else {
+            break;
+        }
+    }
+
+    //
+    // Print usage and all available features upon invalid arguments.
+    //
+    if( ( ArgC < 2 ) || ( i != ( ArgC - 1 ) ) ) {
         printf(
             "Invalid arguments.\n"
-            "Usage: runtest <table path>\n"
+            "Usage: runtest [-b <benchmark>] [-t <threads>] [-i <image path>] [-c] [-s] [-m <memory limit MiB>] [-f <feature>]... <table path>\n"
+            "Available features:\n"
         );
+        for( j = 0; j < AML_COUNTOF( AmlTestFeatures ); j++ ) {
+            printf( "  %-16s %s\n", AmlTestFeatures[ j ].Name, AmlTestFeatures[ j ].Description );
+        }
         return EXIT_FAILURE;
     }
-    return AmlTestMain( ArgV[ 1 ] );
+    return AmlTestMain( ArgV[ ArgC - 1 ], &Options );
 #else
-    return AmlTestMain( "C:\\git\\amli\\tests\\acpica_grammar_1\\grammar.aml" );
+    return AmlTestMain( "C:\\git\\amli\\tests\\acpica_grammar_1\\grammar.aml", &( AML_TEST_OPTIONS ){ 0 } );
 #endif
 }
 
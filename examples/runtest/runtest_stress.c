@@ -0,0 +1,489 @@
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef AML_TEST_HAS_THREADS
+ #include <threads.h>
+#endif
+#include <time.h>
+#include "runtest_host.h"
+#include "runtest_stress.h"
+#include "aml_platform.h"
+#include "aml_eval.h"
+#include "aml_base.h"
+#include "aml_debug.h"
+#include "aml_method.h"
+#include "aml_execution_context.h"
+
+#ifdef AML_TEST_HAS_THREADS
+
+//
+// Maximum amount of stress test threads.
+//
+#define AML_STRESS_MAX_THREADS 64
+
+//
+// Maximum amount of times that each thread evaluates every method.
+//
+#define AML_STRESS_ITERATIONS 20
+
+//
+// Per-thread time budget of the evaluations of a single method, the iteration count of methods that take longer than
+// the budget allows (typically test drivers or methods that stall/sleep) is reduced accordingly, down to a single iteration.
+//
+#define AML_STRESS_METHOD_BUDGET_NS ( 40 * 1000 * 1000 )
+
+//
+// A single stress tested method, along with the result of its single threaded baseline evaluation.
+// The concurrent failure count is only updated while holding the state lock.
+//
+typedef struct _AML_STRESS_METHOD {
+    AML_NAMESPACE_NODE* Node;
+    SIZE_T              Iterations;
+    BOOLEAN             BaselineSuccess;
+    UINT64              FailureCount;
+} AML_STRESS_METHOD;
+
+//
+// Shared stress test state, the AML state and the list of evaluated methods.
+// The AML state itself is not thread safe, all threads serialize their use of it using the state lock (a host mutex),
+// which is bound as the blocking lock of every thread's execution context, so that other threads run while a method blocks.
+//
+typedef struct _AML_STRESS_CONTEXT {
+    AML_STATE          State;
+    AML_HOST_CONTEXT   Host;
+    volatile LONG      AcpiGlobalLock;
+    UINT64             StateLock;
+    BOOLEAN            HasStateLock;
+    AML_STRESS_METHOD* Methods;
+    SIZE_T             MethodCount;
+    SIZE_T             MethodCapacity;
+} AML_STRESS_CONTEXT;
+
+//
+// Per-thread stress test state.
+//
+typedef struct _AML_STRESS_THREAD {
+    AML_STRESS_CONTEXT*   Stress;
+    AML_EXECUTION_CONTEXT Context;
+    thrd_t                Thread;
+    SIZE_T                Index;
+    UINT64                InvokeCount;
+    UINT64                FailureCount;
+} AML_STRESS_THREAD;
+
+//
+// User-provided allocator interface callback to allocate memory.
+//
+_Success_( return != NULL )
+static
+VOID*
+AmlStressMemoryAllocate(
+    _Inout_ VOID*  Context,
+    _In_    SIZE_T Size
+    )
+{
+    return malloc( Size );
+}
+
+//
+// User-provided allocator interface callback to free memory previously allocated using AML_MEMORY_ALLOCATE.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlStressMemoryFree(
+    _Inout_          VOID*  Context,
+    _In_ _Frees_ptr_ VOID*  Allocation,
+    _In_             SIZE_T AllocationSize
+    )
+{
+    free( Allocation );
+    return AML_TRUE;
+}
+
+//
+// Current wall-clock time in nanoseconds.
+//
+static
+UINT64
+AmlStressTimeNs(
+    VOID
+    )
+{
+    struct timespec Time;
+
+    timespec_get( &Time, TIME_UTC );
+    return ( ( ( UINT64 )Time.tv_sec * 1000000000ull ) + ( UINT64 )Time.tv_nsec );
+}
+
+//
+// Namespace iterator callback, collects all argument-less predefined (_XXX) AML methods.
+//
+static
+AML_ITERATOR_ACTION
+AmlStressCollectMethod(
+    _In_opt_ VOID*               UserContext,
+    _Inout_  AML_STATE*          State,
+    _Inout_  AML_NAMESPACE_NODE* Node
+    )
+{
+    AML_STRESS_CONTEXT* Stress;
+    AML_STRESS_METHOD*  NewMethods;
+
+    Stress = UserContext;
+    if( ( Node->Object == NULL )
+        || ( Node->LocalName.Data[ 0 ] != '_' )
+        || ( Node->Object->u.Method.UserRoutine != NULL )
+        || ( Node->Object->u.Method.ArgumentCount != 0 ) )
+    {
+        return AML_ITERATOR_ACTION_CONTINUE;
+    }
+
+    //
+    // Grow the list if needed.
+    //
+    if( Stress->MethodCount >= Stress->MethodCapacity ) {
+        Stress->MethodCapacity = AML_MAX( 64, ( Stress->MethodCapacity * 2 ) );
+        if( ( NewMethods = realloc( Stress->Methods, ( Stress->MethodCapacity * sizeof( Stress->Methods[ 0 ] ) ) ) ) == NULL ) {
+            return AML_ITERATOR_ACTION_ERROR;
+        }
+        Stress->Methods = NewMethods;
+    }
+    Stress->Methods[ Stress->MethodCount++ ] = ( AML_STRESS_METHOD ){ .Node = Node };
+    return AML_ITERATOR_ACTION_CONTINUE;
+}
+
+//
+// Print the absolute path of a method.
+//
+static
+VOID
+AmlStressPrintMethodPath(
+    _In_ const AML_STRESS_METHOD* Method
+    )
+{
+    SIZE_T i;
+
+    printf( "\\" );
+    for( i = 0; i < Method->Node->AbsolutePath.SegmentCount; i++ ) {
+        printf( "%s%.4s", ( ( i != 0 ) ? "." : "" ), Method->Node->AbsolutePath.Segments[ i ].Data );
+    }
+}
+
+//
+// Invoke all collected methods once (single threaded), recording the baseline result of every method,
+// and determine the amount of iterations of every method from its duration.
+//
+static
+VOID
+AmlStressBaselineMethods(
+    _Inout_ AML_STRESS_CONTEXT* Stress
+    )
+{
+    SIZE_T             i;
+    UINT64             Start;
+    UINT64             Elapsed;
+    AML_STRESS_METHOD* Method;
+    AML_DATA           ReturnValue;
+
+    for( i = 0; i < Stress->MethodCount; i++ ) {
+        Method = &Stress->Methods[ i ];
+        Start = AmlStressTimeNs();
+        Method->BaselineSuccess = AmlMethodInvoke( &Stress->State, Method->Node->Object, 0, NULL, 0, &ReturnValue );
+        Elapsed = AML_MAX( 1, ( AmlStressTimeNs() - Start ) );
+        if( Method->BaselineSuccess ) {
+            AmlDataFree( &ReturnValue );
+        }
+        Method->Iterations = ( SIZE_T )AML_MAX( 1, AML_MIN( AML_STRESS_ITERATIONS, ( AML_STRESS_METHOD_BUDGET_NS / Elapsed ) ) );
+    }
+}
+
+//
+// Stress test thread routine, repeatedly evaluates all methods within the execution context of the thread.
+// The state lock is acquired and the context entered for every single invocation to interleave the threads as much as possible,
+// failures are recorded per method while the context is still entered (under the state lock).
+//
+static
+INT
+AmlStressThreadMain(
+    _Inout_ VOID* Argument
+    )
+{
+    AML_STRESS_THREAD*  Thread;
+    AML_STRESS_CONTEXT* Stress;
+    SIZE_T              i;
+    SIZE_T              j;
+    AML_STRESS_METHOD*  Method;
+    AML_DATA            ReturnValue;
+
+    Thread = Argument;
+    Stress = Thread->Stress;
+    for( j = 0; j < AML_STRESS_ITERATIONS; j++ ) {
+        for( i = 0; i < Stress->MethodCount; i++ ) {
+            //
+            // Each thread starts at a different method, so that different threads evaluate different methods at once.
+            //
+            Method = &Stress->Methods[ ( i + Thread->Index ) % Stress->MethodCount ];
+            if( j >= Method->Iterations ) {
+                continue;
+            } else if( AmlHostMutexAcquire( &Stress->Host, Stress->StateLock, 0xFFFF ) != AML_WAIT_STATUS_SUCCESS ) {
+                Thread->FailureCount++;
+                continue;
+            } else if( AmlExecutionContextEnter( &Thread->Context ) == AML_FALSE ) {
+                AmlHostMutexRelease( &Stress->Host, Stress->StateLock );
+                Thread->FailureCount++;
+                continue;
+            }
+            if( AmlMethodInvoke( &Stress->State, Method->Node->Object, 0, NULL, 0, &ReturnValue ) ) {
+                AmlDataFree( &ReturnValue );
+            } else {
+                Thread->FailureCount++;
+                Method->FailureCount++;
+            }
+            AmlExecutionContextLeave( &Thread->Context );
+            AmlHostMutexRelease( &Stress->Host, Stress->StateLock );
+            Thread->InvokeCount++;
+        }
+    }
+    return 0;
+}
+
+//
+// Get the current amount of namespace nodes.
+//
+static
+UINT64
+AmlStressNodeCount(
+    _In_ const AML_STATE* State
+    )
+{
+    AML_NAMESPACE_PATH_MAP_STATISTICS Statistics;
+
+    AmlNamespacePathMapQueryStatistics( &State->Namespace.PathMap, &Statistics );
+    return ( UINT64 )Statistics.Count;
+}
+
+//
+// Run the multithreaded stress test against the given full ACPI table (including the table header).
+// Loads the table, then evaluates all argument-less predefined methods from the given amount of threads,
+// each thread using its own execution context of the shared state, serialized by a host mutex.
+//
+_Success_( return )
+BOOLEAN
+AmlTestRunStress(
+    _In_                          SIZE_T       ThreadCount,
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    AML_DESCRIPTION_HEADER TableHeader;
+    AML_STRESS_CONTEXT*    Stress;
+    AML_STRESS_THREAD*     Threads;
+    AML_ALLOCATOR          Allocator;
+    SIZE_T                 ContextCount;
+    SIZE_T                 StartedCount;
+    SIZE_T                 i;
+    UINT64                 NodeCountBefore;
+    UINT64                 NodeCountAfter;
+    UINT64                 InvokeCount;
+    UINT64                 FailureCount;
+    UINT64                 NewFailureCount;
+    UINT64                 VerifyFailureCount;
+    UINT64                 Start;
+    UINT64                 Elapsed;
+    AML_DATA               ReturnValue;
+    BOOLEAN                Success;
+
+    if( ( ThreadCount == 0 ) || ( ThreadCount > AML_STRESS_MAX_THREADS ) ) {
+        printf( "Error: Invalid stress test thread count (must be 1-%u).\n", AML_STRESS_MAX_THREADS );
+        return AML_FALSE;
+    }
+
+    //
+    // Set up a quiet host and the shared state, the table has already been validated by the caller.
+    //
+    AML_MEMCPY( &TableHeader, Table, sizeof( TableHeader ) );
+    if( ( Stress = calloc( 1, sizeof( *Stress ) ) ) == NULL ) {
+        return AML_FALSE;
+    } else if( ( Threads = calloc( ThreadCount, sizeof( *Threads ) ) ) == NULL ) {
+        free( Stress );
+        return AML_FALSE;
+    }
+    Stress->Host = ( AML_HOST_CONTEXT ){ .GlobalLock = &Stress->AcpiGlobalLock, .IsQuiet = AML_TRUE };
+    Allocator = ( AML_ALLOCATOR ){ .Allocate = AmlStressMemoryAllocate, .Free = AmlStressMemoryFree };
+    if( AmlStateCreate(
+        &Stress->State,
+        Allocator,
+        &( AML_STATE_PARAMETERS ){
+            .Host            = &Stress->Host,
+            .Use64BitInteger = ( TableHeader.Revision > 1 ),
+        } ) == AML_FALSE )
+    {
+        printf( "Error: AmlStateCreate failed!\n" );
+        free( Threads );
+        free( Stress );
+        return AML_FALSE;
+    }
+
+    //
+    // Load the table and perform initial device initialization, then collect all methods and record their baseline results.
+    //
+    ContextCount = 0;
+    StartedCount = 0;
+    Success = AML_FALSE;
+    do {
+        if( AmlCreatePredefinedNamespaces( &Stress->State ) == AML_FALSE ) {
+            printf( "Error: AmlCreatePredefinedNamespaces failed!\n" );
+            break;
+        }
+        AmlCreatePredefinedObjects( &Stress->State );
+        if( AmlEvalLoadedTableCode( &Stress->State, &Table[ sizeof( TableHeader ) ], ( TableSize - sizeof( TableHeader ) ), NULL ) == AML_FALSE ) {
+            printf( "Error: AmlEvalLoadedTableCode failed!\n" );
+            break;
+        }
+        AmlCompleteInitialLoad( &Stress->State, AML_TRUE );
+        AmlIterateNamespaceObjects( &Stress->State, NULL, AmlStressCollectMethod, Stress, AML_OBJECT_TYPE_METHOD );
+        AmlStressBaselineMethods( Stress );
+        NodeCountBefore = AmlStressNodeCount( &Stress->State );
+
+        //
+        // Initialize the execution context of every thread, bound to the state lock,
+        // from now on all evaluation happens within a context, while holding the state lock.
+        //
+        if( AmlHostMutexCreate( &Stress->Host, &Stress->StateLock ) == AML_FALSE ) {
+            printf( "Error: AmlHostMutexCreate failed!\n" );
+            break;
+        }
+        Stress->HasStateLock = AML_TRUE;
+        for( ContextCount = 0; ContextCount < ThreadCount; ContextCount++ ) {
+            if( AmlExecutionContextInitialize( &Threads[ ContextCount ].Context, &Stress->State ) == AML_FALSE ) {
+                printf( "Error: AmlExecutionContextInitialize failed!\n" );
+                break;
+            }
+            Threads[ ContextCount ].Context.BlockingLock    = Stress->StateLock;
+            Threads[ ContextCount ].Context.HasBlockingLock = AML_TRUE;
+            Threads[ ContextCount ].Stress                  = Stress;
+            Threads[ ContextCount ].Index                   = ContextCount;
+        }
+        if( ContextCount != ThreadCount ) {
+            break;
+        }
+
+        //
+        // Run all threads concurrently.
+        //
+        printf( "Stress testing %"PRIu64" method(s) on %"PRIu64" thread(s), up to %u iteration(s) each.\n",
+                ( UINT64 )Stress->MethodCount,
+                ( UINT64 )ThreadCount,
+                AML_STRESS_ITERATIONS );
+        Start = AmlStressTimeNs();
+        for( StartedCount = 0; StartedCount < ThreadCount; StartedCount++ ) {
+            if( thrd_create( &Threads[ StartedCount ].Thread, AmlStressThreadMain, &Threads[ StartedCount ] ) != thrd_success ) {
+                printf( "Error: Failed to create stress test thread!\n" );
+                break;
+            }
+        }
+        InvokeCount = 0;
+        FailureCount = 0;
+        for( i = 0; i < StartedCount; i++ ) {
+            thrd_join( Threads[ i ].Thread, NULL );
+            InvokeCount += Threads[ i ].InvokeCount;
+            FailureCount += Threads[ i ].FailureCount;
+        }
+        Elapsed = ( AmlStressTimeNs() - Start );
+        if( StartedCount != ThreadCount ) {
+            break;
+        }
+
+        //
+        // Methods that already failed during the single threaded baseline are expected to fail, any other failure is an error.
+        // The shared state must also remain consistent: all temporary nodes must have been released,
+        // and every method must still evaluate with its baseline result afterwards.
+        //
+        NodeCountAfter = AmlStressNodeCount( &Stress->State );
+        NewFailureCount = 0;
+        VerifyFailureCount = 0;
+        if( AmlHostMutexAcquire( &Stress->Host, Stress->StateLock, 0xFFFF ) != AML_WAIT_STATUS_SUCCESS ) {
+            break;
+        } else if( AmlExecutionContextEnter( &Threads[ 0 ].Context ) == AML_FALSE ) {
+            AmlHostMutexRelease( &Stress->Host, Stress->StateLock );
+            break;
+        }
+        for( i = 0; i < Stress->MethodCount; i++ ) {
+            if( Stress->Methods[ i ].BaselineSuccess == AML_FALSE ) {
+                continue;
+            } else if( Stress->Methods[ i ].FailureCount != 0 ) {
+                printf( "Error: " );
+                AmlStressPrintMethodPath( &Stress->Methods[ i ] );
+                printf( " failed %"PRIu64" time(s) during the stress test!\n", Stress->Methods[ i ].FailureCount );
+                NewFailureCount += Stress->Methods[ i ].FailureCount;
+            }
+            if( AmlMethodInvoke( &Stress->State, Stress->Methods[ i ].Node->Object, 0, NULL, 0, &ReturnValue ) == AML_FALSE ) {
+                printf( "Error: " );
+                AmlStressPrintMethodPath( &Stress->Methods[ i ] );
+                printf( " failed after the stress test!\n" );
+                VerifyFailureCount++;
+                continue;
+            }
+            AmlDataFree( &ReturnValue );
+        }
+        AmlExecutionContextLeave( &Threads[ 0 ].Context );
+        AmlHostMutexRelease( &Stress->Host, Stress->StateLock );
+
+        //
+        // Print results.
+        //
+        printf( "Invocations: %"PRIu64" (%"PRIu64" failed, %"PRIu64" unexpectedly), %"PRIu64" us\n",
+                InvokeCount,
+                FailureCount,
+                NewFailureCount,
+                ( Elapsed / 1000 ) );
+        printf( "Namespace:   %"PRIu64" node(s) before, %"PRIu64" node(s) after\n", NodeCountBefore, NodeCountAfter );
+        if( NodeCountBefore != NodeCountAfter ) {
+            printf( "Error: Namespace node count changed during the stress test!\n" );
+            break;
+        } else if( NewFailureCount != 0 ) {
+            printf( "Error: %"PRIu64" invocation(s) of baseline-successful method(s) failed during the stress test!\n", NewFailureCount );
+            break;
+        } else if( VerifyFailureCount != 0 ) {
+            printf( "Error: %"PRIu64" method(s) failed after the stress test!\n", VerifyFailureCount );
+            break;
+        }
+        printf( "Stress test completed successfully.\n" );
+        Success = AML_TRUE;
+    } while( 0 );
+
+    //
+    // All contexts must be freed before the state.
+    //
+    for( i = 0; i < ContextCount; i++ ) {
+        AmlExecutionContextFree( &Threads[ i ].Context );
+    }
+    if( Stress->HasStateLock ) {
+        AmlHostMutexFree( &Stress->Host, Stress->StateLock );
+    }
+    AmlStateFree( &Stress->State );
+    free( Stress->Methods );
+    free( Threads );
+    free( Stress );
+    return Success;
+}
+
+#else
+
+//
+// Run the multithreaded stress test against the given full ACPI table (including the table header).
+// Not available without C11 threads support.
+//
+_Success_( return )
+BOOLEAN
+AmlTestRunStress(
+    _In_                          SIZE_T       ThreadCount,
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    )
+{
+    printf( "Error: The stress test requires C11 threads support (AML_TEST_HAS_THREADS).\n" );
+    return AML_FALSE;
+}
+
+#endif
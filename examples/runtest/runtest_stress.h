@@ -0,0 +1,16 @@
+#pragma once
+
+#include "aml_platform.h"
+
+//
+// Run the multithreaded stress test against the given full ACPI table (including the table header).
+// Loads the table, then evaluates all argument-less predefined methods from the given amount of threads,
+// each thread using its own execution context of the shared state, serialized by a host mutex.
+//
+_Success_( return )
+BOOLEAN
+AmlTestRunStress(
+    _In_                          SIZE_T       ThreadCount,
+    _In_reads_bytes_( TableSize ) const UINT8* Table,
+    _In_                          SIZE_T       TableSize
+    );
@@ -385,6 +385,36 @@ AmlArenaRelease(
     AmlArenaFreeChunkList( Arena, &Arena->ChunkFreeList );
 }
 
+//
+// Calculate the total backing allocation size of all chunks of the given list.
+//
+static
+SIZE_T
+AmlArenaChunkListSize(
+    _In_ const AML_ARENA_CHUNK_LIST* List
+    )
+{
+    const AML_ARENA_CHUNK* Chunk;
+    SIZE_T                 Size;
+
+    Size = 0;
+    for( Chunk = List->First; Chunk != NULL; Chunk = Chunk->Next ) {
+        Size += Chunk->AllocationSize;
+    }
+    return Size;
+}
+
+//
+// Query the total size of all backing memory currently allocated by the arena (including unused chunks).
+//
+SIZE_T
+AmlArenaQueryAllocatedSize(
+    _In_ const AML_ARENA* Arena
+    )
+{
+    return ( AmlArenaChunkListSize( &Arena->ChunkList ) + AmlArenaChunkListSize( &Arena->ChunkFreeList ) );
+}
+
 //
 // Allocate memory using the given arena.
 //
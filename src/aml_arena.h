@@ -117,6 +117,14 @@ AmlArenaRelease(
     _Inout_ AML_ARENA* Arena
     );
 
+//
+// Query the total size of all backing memory currently allocated by the arena (including unused chunks).
+//
+SIZE_T
+AmlArenaQueryAllocatedSize(
+    _In_ const AML_ARENA* Arena
+    );
+
 //
 // Take a snapshot of the current arena, must be committed or rolled back.
 //
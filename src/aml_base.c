@@ -428,4 +428,48 @@ AmlPathStringZToNameString(
 		}
 	}
 	return AmlPathStringToNameString( Arena, Path, Length, NameString );
+}
+
+//
+// Convert a null-terminated path string made up of a single unprefixed name segment to an AML_NAME_SEG (without allocating).
+// Fails for all other paths, these must be converted using AmlPathStringZToNameString.
+//
+_Success_( return )
+BOOLEAN
+AmlPathStringZToNameSeg(
+	_In_z_ const CHAR*   Path,
+	_Out_  AML_NAME_SEG* Segment
+	)
+{
+	SIZE_T i;
+
+	//
+	// Consume up to 4 NameChars/DigitChars, the segment must begin with a NameChar ('A'-'Z' | '_').
+	//
+	for( i = 0; ( i < AML_COUNTOF( Segment->Data ) ) && ( Path[ i ] != '\0' ); i++ ) {
+		if( ( Path[ i ] >= '0' ) && ( Path[ i ] <= '9' ) ) {
+			if( i == 0 ) {
+				return AML_FALSE;
+			}
+		} else if( ( ( Path[ i ] < 'A' ) || ( Path[ i ] > 'Z' ) ) && ( Path[ i ] != '_' ) ) {
+			return AML_FALSE;
+		}
+		Segment->Data[ i ] = ( UINT8 )Path[ i ];
+	}
+
+	//
+	// The path must end after the segment, an empty segment is not valid.
+	//
+	if( ( i == 0 ) || ( Path[ i ] != '\0' ) ) {
+		return AML_FALSE;
+	}
+
+	//
+	// Pad short name segments with underscores.
+	//
+	for( ; i < AML_COUNTOF( Segment->Data ); i++ ) {
+		Segment->Data[ i ] = '_';
+	}
+
+	return AML_TRUE;
 }
\ No newline at end of file
@@ -80,4 +80,15 @@ AmlPathStringZToNameString(
     _Inout_ AML_ARENA*       Arena,
     _In_z_  const CHAR*      Path,
     _Out_   AML_NAME_STRING* NameString
+    );
+
+//
+// Convert a null-terminated path string made up of a single unprefixed name segment to an AML_NAME_SEG (without allocating).
+// Fails for all other paths, these must be converted using AmlPathStringZToNameString.
+//
+_Success_( return )
+BOOLEAN
+AmlPathStringZToNameSeg(
+    _In_z_ const CHAR*   Path,
+    _Out_  AML_NAME_SEG* Segment
     );
\ No newline at end of file
@@ -13,6 +13,9 @@ AmlBufferDataReference(
     _Inout_ AML_BUFFER_DATA* Buffer
     )
 {
+    if( Buffer->IsShared ) {
+        return;
+    }
     AmlStateSnapshotItemPushAction( Buffer->StateItem, AML_TRUE );
     Buffer->ReferenceCount++;
 }
@@ -25,6 +28,9 @@ AmlBufferDataRelease(
     _Inout_ _Post_invalid_ AML_BUFFER_DATA* Buffer
     )
 {
+    if( Buffer->IsShared ) {
+        return;
+    }
     AmlStateSnapshotItemPushAction( Buffer->StateItem, AML_FALSE );
     if( Buffer->ReferenceCount-- == 1 ) {
         if( Buffer->StateItem != NULL ) {
@@ -210,6 +216,9 @@ AmlPackageDataReference(
     _Inout_ _Post_invalid_ AML_PACKAGE_DATA* Package
     )
 {
+    if( Package->IsShared ) {
+        return;
+    }
     Package->ReferenceCount++;
 }
 
@@ -253,8 +262,9 @@ AmlPackageDataRelease(
 {
     //
     // Decrease the reference counter, only free if we hit zero.
+    // Shared packages are owned by their base namespace.
     //
-    if( --Package->ReferenceCount != 0 ) {
+    if( Package->IsShared || ( --Package->ReferenceCount != 0 ) ) {
         return;
     }
 
@@ -353,10 +363,91 @@ AmlDataFree(
     *Data = ( AML_DATA ){ .Type = AML_DATA_TYPE_NONE };
 }
 
+//
+// Create a private copy of shared (read-only) buffer data.
+//
+_Success_( return != NULL )
+static
+AML_BUFFER_DATA*
+AmlBufferDataCopy(
+    _Inout_ AML_HEAP*              Heap,
+    _In_    const AML_BUFFER_DATA* Source
+    )
+{
+    AML_BUFFER_DATA* Buffer;
+
+    if( ( Buffer = AmlBufferDataCreate( Heap, Source->Size, Source->MaxSize ) ) == NULL ) {
+        return NULL;
+    }
+    if( Source->Size != 0 ) {
+        AML_MEMCPY( Buffer->Data, Source->Data, Source->Size );
+    }
+    return Buffer;
+}
+
+//
+// Create a private copy of a shared (read-only) package, shared element data is copied as well.
+//
+_Success_( return != NULL )
+static
+AML_PACKAGE_DATA*
+AmlPackageDataCopy(
+    _Inout_ AML_HEAP*               Heap,
+    _In_    const AML_PACKAGE_DATA* Source
+    )
+{
+    AML_PACKAGE_DATA*     Package;
+    AML_PACKAGE_ELEMENT** Elements;
+    AML_PACKAGE_ELEMENT*  Element;
+    UINT64                i;
+
+    //
+    // Allocate the package and its element array, all elements are initially absent.
+    //
+    if( Source->ElementCount > ( SIZE_MAX / sizeof( Elements[ 0 ] ) ) ) {
+        return NULL;
+    } else if( ( Package = AmlHeapAllocate( Heap, sizeof( *Package ) ) ) == NULL ) {
+        return NULL;
+    } else if( ( Elements = AmlHeapAllocate( Heap, ( ( SIZE_T )Source->ElementCount * sizeof( Elements[ 0 ] ) ) ) ) == NULL ) {
+        AmlHeapFree( Heap, Package );
+        return NULL;
+    }
+    for( i = 0; i < Source->ElementCount; i++ ) {
+        Elements[ i ] = NULL;
+    }
+    *Package = ( AML_PACKAGE_DATA ){
+        .ParentHeap       = Heap,
+        .ElementArrayHeap = Heap,
+        .ReferenceCount   = 1,
+        .ElementCount     = Source->ElementCount,
+        .Elements         = Elements,
+    };
+
+    //
+    // Duplicate the value of every present element.
+    //
+    for( i = 0; i < Source->ElementCount; i++ ) {
+        if( Source->Elements[ i ] == NULL ) {
+            continue;
+        } else if( ( Element = AmlHeapAllocate( Heap, sizeof( *Element ) ) ) == NULL ) {
+            AmlPackageDataRelease( Package );
+            return NULL;
+        }
+        *Element = ( AML_PACKAGE_ELEMENT ){ .ParentHeap = Heap, .Value.Type = AML_DATA_TYPE_NONE };
+        Elements[ i ] = Element;
+        if( AmlDataDuplicate( &Source->Elements[ i ]->Value, Heap, &Element->Value ) == AML_FALSE ) {
+            AmlPackageDataRelease( Package );
+            return NULL;
+        }
+    }
+    return Package;
+}
+
 //
 // Duplicate the given template to the given heap/output.
 // Does not deep-copy reference counted types (string/buffer/package),
 // simply raises the reference counter to account for the copy.
+// Shared data (see AML_BUFFER_DATA::IsShared) is never referenced by the duplicate, it is copied to the given heap instead.
 //
 _Success_( return )
 BOOLEAN
@@ -382,12 +473,22 @@ AmlDataDuplicate(
     case AML_DATA_TYPE_STRING:
         if( Copy.u.String->Size > Copy.u.String->MaxSize ) {
             return AML_FALSE;
+        } else if( Copy.u.String->IsShared ) {
+            if( ( Copy.u.String = AmlBufferDataCopy( DuplicateHeap, Copy.u.String ) ) == NULL ) {
+                return AML_FALSE;
+            }
+            break;
         }
         AmlBufferDataReference( Copy.u.String );
         break;
     case AML_DATA_TYPE_BUFFER:
         if( Copy.u.Buffer->Size > Copy.u.Buffer->MaxSize ) {
             return AML_FALSE;
+        } else if( Copy.u.Buffer->IsShared ) {
+            if( ( Copy.u.Buffer = AmlBufferDataCopy( DuplicateHeap, Copy.u.Buffer ) ) == NULL ) {
+                return AML_FALSE;
+            }
+            break;
         }
         AmlBufferDataReference( Copy.u.Buffer );
         break;
@@ -402,7 +503,11 @@ AmlDataDuplicate(
         }
         break;
     case AML_DATA_TYPE_PACKAGE:
-        if( Copy.u.Package != NULL ) {
+        if( ( Copy.u.Package != NULL ) && Copy.u.Package->IsShared ) {
+            if( ( Copy.u.Package = AmlPackageDataCopy( DuplicateHeap, Copy.u.Package ) ) == NULL ) {
+                return AML_FALSE;
+            }
+        } else if( Copy.u.Package != NULL ) {
             AmlPackageDataReference( Copy.u.Package );
         }
         break;
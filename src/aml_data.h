@@ -100,6 +100,7 @@ typedef struct _AML_PACKAGE_DATA {
     SIZE_T                        ReferenceCount;
     UINT64                        ElementCount;
     struct _AML_PACKAGE_ELEMENT** Elements;
+    BOOLEAN                       IsShared; /* Read-only package of a shared object, not reference counted, duplicates are copies. */
 } AML_PACKAGE_DATA;
 
 //
@@ -113,6 +114,7 @@ typedef struct _AML_BUFFER_DATA {
     SIZE_T                           ReferenceCount;
     SIZE_T                           Size;
     SIZE_T                           MaxSize;
+    BOOLEAN                          IsShared; /* Read-only buffer of a shared object, not reference counted, duplicates are copies. */
 } AML_BUFFER_DATA;
 
 //
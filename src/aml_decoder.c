@@ -315,6 +315,7 @@ AmlDecoderPeekOpcode(
         .PrefixL1                  = ( Is2ByteInstruction ? OpcodeEntryL1->OpcodeByte : 0 ),
         .LeafOpcode                = *MainOpcode,
         .IsExpressionOpcode        = ( MainOpcode->IsExpressionOp == 1 ),
+        .OpcodeClass               = MainOpcode->OpcodeClass,
         .FixedArgumentTypes        = &AmlOpcodeFixedArgumentListSharedValueTable[ MainOpcode->FixedListArgTableOffset ],
         .FixedArgumentTypeCount    = MainOpcode->FixedListArgCount,
         .VariableArgumentTypes     = &AmlOpcodeVariableArgumentListSharedValueTable[ MainOpcode->VariableListArgTableOffset ],
@@ -1785,7 +1786,6 @@ AmlDecoderConsumeTermArg(
 //
 // ComputationalData := ByteConst | WordConst | DWordConst | QWordConst | String | ConstObj | RevisionOp | DefBuffer
 // DataObject := ComputationalData | DefPackage | DefVarPackage
-// TODO: Add all this classification stuff to the opcode table!
 //
 _Success_( return )
 BOOLEAN
@@ -1794,28 +1794,14 @@ AmlDecoderIsDataObject(
     _In_    const AML_DECODER_INSTRUCTION_OPCODE* Opcode
     )
 {
-    BOOLEAN IsMatch;
-
-    //
-    // ComputationalData := ByteConst | WordConst | DWordConst | QWordConst | String | ConstObj | RevisionOp | DefBuffer
-    //
-    IsMatch  = ( ( Opcode->OpcodeID >= AML_OPCODE_ID_BYTE_PREFIX ) && ( Opcode->OpcodeID <= AML_OPCODE_ID_QWORD_PREFIX ) );
-    IsMatch |= ( ( Opcode->OpcodeID >= AML_OPCODE_ID_ZERO_OP ) && ( Opcode->OpcodeID <= AML_OPCODE_ID_ONE_OP ) );
-    IsMatch |= ( Opcode->OpcodeID == AML_OPCODE_ID_ONES_OP );
-    IsMatch |= ( Opcode->OpcodeID == AML_OPCODE_ID_REVISION_OP );
-    IsMatch |= ( Opcode->OpcodeID == AML_OPCODE_ID_BUFFER_OP );
-
-    //
-    // DefPackage | DefVarPackage
-    //
-    IsMatch |= ( ( Opcode->OpcodeID >= AML_OPCODE_ID_PACKAGE_OP ) && ( Opcode->OpcodeID <= AML_OPCODE_ID_VAR_PACKAGE_OP ) );
-
-    return IsMatch;
+    return ( ( Opcode->OpcodeClass == AML_OPCODE_CLASS_DATA_OBJECT )
+             | ( Opcode->OpcodeClass == AML_OPCODE_CLASS_DATA_EXPRESSION ) );
 }
 
 //
 // Attempts to classify the given opcode and determine if it is a statement opcode.
-// TODO: Add all this classification stuff to the opcode table!
+// StatementOpcode := DefBreak | DefBreakPoint | DefContinue | DefFatal | DefIfElse | DefNoop
+// | DefNotify | DefRelease | DefReset | DefReturn | DefSignal | DefSleep | DefStall | DefWhile
 //
 _Success_( return )
 BOOLEAN
@@ -1824,50 +1810,7 @@ AmlDecoderIsStatementOpcode(
     _In_    const AML_DECODER_INSTRUCTION_OPCODE* Op
     )
 {
-    BOOLEAN IsStatement;
-
-    //
-    // 0x5B 0x21               , StallOp                , Term Object     , TermArg                                           , -                        , 0		
-    // 0x5B 0x22               , SleepOp                , Term Object     , TermArg                                           , -                        , 0	
-    // 0x5B 0x24               , SignalOp               , Term Object     , SuperName                                         , -                        , 0		
-    // 0x5B 0x26               , ResetOp                , Term Object     , SuperName                                         , -                        , 0		
-    // 0x5B 0x27               , ReleaseOp              , Term Object     , SuperName                                         , -                        , 0		
-    // 0x5B 0x32               , FatalOp                , Term Object     , ByteData DWordData TermArg                        , -                        , 0	
-    //
-    switch( Op->OpcodeID ) {
-    case AML_OPCODE_ID_STALL_OP:
-    case AML_OPCODE_ID_SLEEP_OP:
-    case AML_OPCODE_ID_SIGNAL_OP:
-    case AML_OPCODE_ID_RESET_OP:
-    case AML_OPCODE_ID_RELEASE_OP:
-        IsStatement = AML_TRUE;
-        break;
-    default:
-        IsStatement = AML_FALSE;
-        break;
-    }
-    IsStatement |= ( Op->OpcodeID == AML_OPCODE_ID_FATAL_OP );
-
-    //
-    // 0xA0                    , IfOp                   , Term Object     , TermArg                                           , TermList                 , 0		
-    // 0xA1                    , ElseOp                 , Term Object     , -                                                 , TermList                 , 0		
-    // 0xA2                    , WhileOp                , Term Object     , TermArg                                           , TermList                 , 0		
-    // 0xA3                    , NoopOp                 , Term Object     , -                                                 , -                        , 0		
-    // 0xA4                    , ReturnOp               , Term Object     , TermArg                                           , -                        , 0		
-    // 0xA5                    , BreakOp                , Term Object     , -                                                 , -                        , 0		
-    //
-    IsStatement |= ( ( Op->OpcodeID >= AML_OPCODE_ID_IF_OP ) && ( Op->OpcodeID <= AML_OPCODE_ID_BREAK_OP ) );
-
-    //
-    // 0x86                    , NotifyOp               , Term Object     , SuperName TermArg                                 , -                        , 0		
-    // 0x9F                    , ContinueOp             , Term Object     , -                                                 , -                        , 0		
-    // 0xCC                    , BreakPointOp           , Term Object     , -                                                 , -                        , 0
-    //
-    IsStatement |= ( Op->OpcodeID == AML_OPCODE_ID_NOTIFY_OP );
-    IsStatement |= ( Op->OpcodeID == AML_OPCODE_ID_CONTINUE_OP );
-    IsStatement |= ( Op->OpcodeID == AML_OPCODE_ID_BREAK_POINT_OP );
-
-    return IsStatement;
+    return ( Op->OpcodeClass == AML_OPCODE_CLASS_STATEMENT );
 }
 
 //
@@ -1885,7 +1828,7 @@ AmlDecoderIsExpressionOpcode(
 
 //
 // Attempts to classify the given opcode and determine if it is a namespace modifier object opcode.
-// TODO: Add all this classification stuff to the opcode table!
+// NameSpaceModifierObj := DefAlias | DefName | DefScope
 //
 _Success_( return )
 BOOLEAN
@@ -1894,22 +1837,15 @@ AmlDecoderIsNamespaceModifierObjectOpcode(
     _In_    const AML_DECODER_INSTRUCTION_OPCODE* Op
     )
 {
-    //
-    // NameSpaceModifierObj := DefAlias | DefName | DefScope
-    //
-    return ( ( Op->OpcodeID == AML_OPCODE_ID_ALIAS_OP )
-             | ( Op->OpcodeID == AML_OPCODE_ID_NAME_OP )
-             | ( Op->OpcodeID == AML_OPCODE_ID_SCOPE_OP ) );
+    return ( Op->OpcodeClass == AML_OPCODE_CLASS_NAMESPACE_MODIFIER );
 }
 
-
 //
 // Attempts to classify the given opcode and determine if it is a named object opcode.
 // NamedObj := DefBankField | DefCreateBitField | DefCreateByteField | DefCreateWordField
 // | DefCreateDWordField | DefCreateQWordField | DefCreateField | DefDataRegion | DefExternal
 // | DefOpRegion | DefPowerRes | DefThermalZone | DefDevice | DefEvent | DefField | DefIndexField
 // | DefMethod
-// TODO: Add all this classification stuff to the opcode table!
 //
 _Success_( return )
 BOOLEAN
@@ -1918,50 +1854,7 @@ AmlDecoderIsNamedObjectOpcode(
     _In_    const AML_DECODER_INSTRUCTION_OPCODE* Op
     )
 {
-    BOOLEAN IsMatch;
-
-    //
-    // 0x14                    , MethodOp               , Term Object     , NameString ByteData                               , TermList                 , 0	
-    // 0x15                    , ExternalOp             , Name Object     , NameString ByteData ByteData                      , -                        , 0
-    //
-    IsMatch = ( ( Op->OpcodeID >= AML_OPCODE_ID_METHOD_OP ) && ( Op->OpcodeID <= AML_OPCODE_ID_EXTERNAL_OP ) );
-
-    //
-    // 0x8A                    , CreateDWordFieldOp     , Term Object     , TermArg TermArg NameString                        , -                        , 0		
-    // 0x8B                    , CreateWordFieldOp      , Term Object     , TermArg TermArg NameString                        , -                        , 0		
-    // 0x8C                    , CreateByteFieldOp      , Term Object     , TermArg TermArg NameString                        , -                        , 0		
-    // 0x8D                    , CreateBitFieldOp       , Term Object     , TermArg TermArg NameString                        , -                        , 0
-    //
-    IsMatch |= ( ( Op->OpcodeID >= AML_OPCODE_ID_CREATE_DWORD_FIELD_OP ) && ( Op->OpcodeID <= AML_OPCODE_ID_CREATE_BIT_FIELD_OP ) );
-
-    //
-    // 0x8F                    , CreateQWordFieldOp     , Term Object     , TermArg TermArg NameString                        , -                        , 0
-    //
-    IsMatch |= ( Op->OpcodeID == AML_OPCODE_ID_CREATE_QWORD_FIELD_OP );
-
-    //
-    // 0x5B 0x13               , CreateFieldOp          , Term Object     , TermArg TermArg TermArg NameString                , -                        , 0	
-    // 0x5B 0x02               , EventOp                , Term Object     , NameString                                        , -                        , 0		
-    // 0x5B 0x01               , MutexOp                , Term Object     , NameString ByteData                               , -                        , 0		
-    //
-    IsMatch |= ( Op->OpcodeID == AML_OPCODE_ID_CREATE_FIELD_OP );
-    IsMatch |= ( Op->OpcodeID == AML_OPCODE_ID_EVENT_OP );
-    IsMatch |= ( Op->OpcodeID == AML_OPCODE_ID_MUTEX_OP );
-
-    //
-    // 0x5B 0x80               , OpRegionOp             , Term Object     , NameString ByteData TermArg TermArg               , -                        , 0		
-    // 0x5B 0x81               , FieldOp                , Term Object     , NameString ByteData                               , FieldList                , 0	
-    // 0x5B 0x82               , DeviceOp               , Term Object     , NameString                                        , TermList                 , 0	
-    // 0x5B 0x83               , ProcessorOp            , Term Object     , NameString ByteData DWordData ByteData            , ObjectList               , 0		
-    // 0x5B 0x84               , PowerResOp             , Term Object     , NameString ByteData WordData                      , TermList                 , 0		
-    // 0x5B 0x85               , ThermalZoneOp          , Term Object     , NameString                                        , TermList                 , 0
-    // 0x5B 0x86               , IndexFieldOp           , Term Object     , NameString NameString ByteData                    , FieldList                , 0		
-    // 0x5B 0x87               , BankFieldOp            , Term Object     , NameString NameString TermArg ByteData            , FieldList                , 0
-    // 0x5B 0x88               , DataRegionOp           , Term Object     , NameString TermArg TermArg TermArg                , -                        , 0	
-    //
-    IsMatch |= ( ( Op->OpcodeID >= AML_OPCODE_ID_OP_REGION_OP ) && ( Op->OpcodeID <= AML_OPCODE_ID_DATA_REGION_OP ) );
-
-    return IsMatch;
+    return ( Op->OpcodeClass == AML_OPCODE_CLASS_NAMED_OBJECT );
 }
 
 //
@@ -16,6 +16,7 @@
 #define AML_NAME_FLAG_ALLOW_NULL_NAME      1
 #define AML_NAME_FLAG_ALLOW_NON_EXISTENT   2
 #define AML_NAME_FLAG_NO_METHOD_INVOCATION 3
+#define AML_NAME_FLAG_PRIVATIZE            4 /* Resolved object will be modified or referenced (see AmlNamespacePrivatizeNode). */
 
 //
 // AML match instruction operator values.
@@ -34,7 +35,8 @@ typedef struct _AML_DECODER_INSTRUCTION_OPCODE {
     UINT16                 OpcodeID;
     BOOLEAN                Is2ByteOpcode;
     BOOLEAN                IsExpressionOpcode;
-    UINT8                  PrefixL1; /* 0 if no prefix/this is not a 2-byte instruction. */
+    UINT8                  OpcodeClass; /* AML_OPCODE_CLASS_*, precomputed by the opcode tables. */
+    UINT8                  PrefixL1;    /* 0 if no prefix/this is not a 2-byte instruction. */
     AML_OPCODE_TABLE_ENTRY LeafOpcode;
     const UINT8*           FixedArgumentTypes;
     SIZE_T                 FixedArgumentTypeCount;
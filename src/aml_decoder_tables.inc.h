@@ -196,40 +196,40 @@ static const UINT8 AmlOpcodeVariableArgumentListSharedValueTable[] = {
 };
 
 static const AML_OPCODE_TABLE_ENTRY AmlOpcodeL2Table_0x5B[ 0xFF + 1 ] = {
-    [0x01] = { 1, 0, 0x01, AML_ENCODING_GROUP_TERM_OBJECT,  0, 12, 2, 0, 0, },
-    [0x02] = { 1, 0, 0x02, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 0, },
-    [0x12] = { 1, 1, 0x12, AML_ENCODING_GROUP_TERM_OBJECT,  0, 21, 2, 0, 0, },
-    [0x13] = { 1, 0, 0x13, AML_ENCODING_GROUP_TERM_OBJECT,  0, 23, 4, 0, 0, },
-    [0x1F] = { 1, 1, 0x1F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 27, 6, 0, 0, },
-    [0x20] = { 1, 1, 0x20, AML_ENCODING_GROUP_TERM_OBJECT,  0, 33, 2, 0, 0, },
-    [0x21] = { 1, 0, 0x21, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, },
-    [0x22] = { 1, 0, 0x22, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, },
-    [0x23] = { 1, 1, 0x23, AML_ENCODING_GROUP_TERM_OBJECT,  0, 35, 2, 0, 0, },
-    [0x24] = { 1, 0, 0x24, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x25] = { 1, 1, 0x25, AML_ENCODING_GROUP_TERM_OBJECT,  0, 38, 2, 0, 0, },
-    [0x26] = { 1, 0, 0x26, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x27] = { 1, 0, 0x27, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x28] = { 1, 1, 0x28, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x29] = { 1, 1, 0x29, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x30] = { 1, 0, 0x30, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, },
-    [0x31] = { 1, 0, 0x31, AML_ENCODING_GROUP_DEBUG_OBJECT, 0, 0,  0, 0, 0, },
-    [0x32] = { 1, 0, 0x32, AML_ENCODING_GROUP_TERM_OBJECT,  0, 42, 3, 0, 0, },
-    [0x33] = { 1, 1, 0x33, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, },
-    [0x80] = { 1, 0, 0x80, AML_ENCODING_GROUP_TERM_OBJECT,  0, 45, 4, 0, 0, },
-    [0x81] = { 1, 0, 0x81, AML_ENCODING_GROUP_TERM_OBJECT,  0, 12, 2, 4, 1, },
-    [0x82] = { 1, 0, 0x82, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 1, },
-    [0x83] = { 1, 0, 0x83, AML_ENCODING_GROUP_TERM_OBJECT,  0, 89, 4, 0, 1, },
-    [0x84] = { 1, 0, 0x84, AML_ENCODING_GROUP_TERM_OBJECT,  0, 49, 3, 0, 1, },
-    [0x85] = { 1, 0, 0x85, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 1, },
-    [0x86] = { 1, 0, 0x86, AML_ENCODING_GROUP_TERM_OBJECT,  0, 52, 3, 4, 1, },
-    [0x87] = { 1, 0, 0x87, AML_ENCODING_GROUP_TERM_OBJECT,  0, 55, 4, 4, 1, },
-    [0x88] = { 1, 0, 0x88, AML_ENCODING_GROUP_TERM_OBJECT,  0, 59, 4, 0, 0, },
+    [0x01] = { 1, 0, 0x01, AML_ENCODING_GROUP_TERM_OBJECT,  0, 12, 2, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x02] = { 1, 0, 0x02, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x12] = { 1, 1, 0x12, AML_ENCODING_GROUP_TERM_OBJECT,  0, 21, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x13] = { 1, 0, 0x13, AML_ENCODING_GROUP_TERM_OBJECT,  0, 23, 4, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x1F] = { 1, 1, 0x1F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 27, 6, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x20] = { 1, 1, 0x20, AML_ENCODING_GROUP_TERM_OBJECT,  0, 33, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x21] = { 1, 0, 0x21, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0x22] = { 1, 0, 0x22, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0x23] = { 1, 1, 0x23, AML_ENCODING_GROUP_TERM_OBJECT,  0, 35, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x24] = { 1, 0, 0x24, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0x25] = { 1, 1, 0x25, AML_ENCODING_GROUP_TERM_OBJECT,  0, 38, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x26] = { 1, 0, 0x26, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0x27] = { 1, 0, 0x27, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0x28] = { 1, 1, 0x28, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x29] = { 1, 1, 0x29, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x30] = { 1, 0, 0x30, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x31] = { 1, 0, 0x31, AML_ENCODING_GROUP_DEBUG_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x32] = { 1, 0, 0x32, AML_ENCODING_GROUP_TERM_OBJECT,  0, 42, 3, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0x33] = { 1, 1, 0x33, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x80] = { 1, 0, 0x80, AML_ENCODING_GROUP_TERM_OBJECT,  0, 45, 4, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x81] = { 1, 0, 0x81, AML_ENCODING_GROUP_TERM_OBJECT,  0, 12, 2, 4, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x82] = { 1, 0, 0x82, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x83] = { 1, 0, 0x83, AML_ENCODING_GROUP_TERM_OBJECT,  0, 89, 4, 0, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x84] = { 1, 0, 0x84, AML_ENCODING_GROUP_TERM_OBJECT,  0, 49, 3, 0, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x85] = { 1, 0, 0x85, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x86] = { 1, 0, 0x86, AML_ENCODING_GROUP_TERM_OBJECT,  0, 52, 3, 4, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x87] = { 1, 0, 0x87, AML_ENCODING_GROUP_TERM_OBJECT,  0, 55, 4, 4, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x88] = { 1, 0, 0x88, AML_ENCODING_GROUP_TERM_OBJECT,  0, 59, 4, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
 };
 
 static const AML_OPCODE_TABLE_ENTRY AmlOpcodeL2Table_0x92[ 0xFF + 1 ] = {
-    [0x93] = { 1, 1, 0x93, AML_ENCODING_GROUP_TERM_OBJECT, 0, 81, 2, 0, 0, },
-    [0x94] = { 1, 1, 0x94, AML_ENCODING_GROUP_TERM_OBJECT, 0, 81, 2, 0, 0, },
-    [0x95] = { 1, 1, 0x95, AML_ENCODING_GROUP_TERM_OBJECT, 0, 81, 2, 0, 0, },
+    [0x93] = { 1, 1, 0x93, AML_ENCODING_GROUP_TERM_OBJECT, 0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x94] = { 1, 1, 0x94, AML_ENCODING_GROUP_TERM_OBJECT, 0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x95] = { 1, 1, 0x95, AML_ENCODING_GROUP_TERM_OBJECT, 0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
 };
 
 static const AML_OPCODE_SUBTABLE_LIST_ENTRY AmlOpcodeL2SubTableList[] = {
@@ -239,130 +239,130 @@ static const AML_OPCODE_SUBTABLE_LIST_ENTRY AmlOpcodeL2SubTableList[] = {
 };
 
 static const AML_OPCODE_TABLE_ENTRY AmlOpcodeL1Table[ 0xFF + 1 ] = {
-    [0x00] = { 1, 0, 0x00, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, },
-    [0x01] = { 1, 0, 0x01, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, },
-    [0x06] = { 1, 0, 0x06, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  2, 0, 0, },
-    [0x08] = { 1, 0, 0x08, AML_ENCODING_GROUP_TERM_OBJECT,  0, 2,  2, 0, 0, },
-    [0x0A] = { 1, 0, 0x0A, AML_ENCODING_GROUP_DATA_OBJECT,  0, 4,  1, 0, 0, },
-    [0x0B] = { 1, 0, 0x0B, AML_ENCODING_GROUP_DATA_OBJECT,  0, 5,  1, 0, 0, },
-    [0x0C] = { 1, 0, 0x0C, AML_ENCODING_GROUP_DATA_OBJECT,  0, 6,  1, 0, 0, },
-    [0x0D] = { 1, 0, 0x0D, AML_ENCODING_GROUP_DATA_OBJECT,  0, 7,  2, 0, 0, },
-    [0x0E] = { 1, 0, 0x0E, AML_ENCODING_GROUP_DATA_OBJECT,  0, 9,  1, 0, 0, },
-    [0x10] = { 1, 0, 0x10, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 1, },
-    [0x11] = { 1, 1, 0x11, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 1, 1, },
-    [0x12] = { 1, 1, 0x12, AML_ENCODING_GROUP_TERM_OBJECT,  0, 4,  1, 2, 2, },
-    [0x13] = { 1, 1, 0x13, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 2, 2, },
-    [0x14] = { 1, 0, 0x14, AML_ENCODING_GROUP_TERM_OBJECT,  0, 12, 2, 0, 1, },
-    [0x15] = { 1, 0, 0x15, AML_ENCODING_GROUP_NAME_OBJECT,  0, 14, 3, 0, 0, },
-    [0x2E] = { 1, 0, 0x2E, AML_ENCODING_GROUP_NAME_OBJECT,  0, 17, 2, 0, 0, },
-    [0x2F] = { 1, 0, 0x2F, AML_ENCODING_GROUP_NAME_OBJECT,  0, 19, 2, 0, 0, },
-    [0x30] = { 1, 0, 0x30, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x31] = { 1, 0, 0x31, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x32] = { 1, 0, 0x32, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x33] = { 1, 0, 0x33, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x34] = { 1, 0, 0x34, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x35] = { 1, 0, 0x35, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x36] = { 1, 0, 0x36, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x37] = { 1, 0, 0x37, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x38] = { 1, 0, 0x38, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x39] = { 1, 0, 0x39, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x41] = { 1, 0, 0x41, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x42] = { 1, 0, 0x42, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x43] = { 1, 0, 0x43, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x44] = { 1, 0, 0x44, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x45] = { 1, 0, 0x45, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x46] = { 1, 0, 0x46, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x47] = { 1, 0, 0x47, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x48] = { 1, 0, 0x48, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x49] = { 1, 0, 0x49, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x4a] = { 1, 0, 0x4a, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x4b] = { 1, 0, 0x4b, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x4c] = { 1, 0, 0x4c, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x4d] = { 1, 0, 0x4d, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x4e] = { 1, 0, 0x4e, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x4f] = { 1, 0, 0x4f, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x50] = { 1, 0, 0x50, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x51] = { 1, 0, 0x51, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x52] = { 1, 0, 0x52, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x53] = { 1, 0, 0x53, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x54] = { 1, 0, 0x54, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x55] = { 1, 0, 0x55, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x56] = { 1, 0, 0x56, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x57] = { 1, 0, 0x57, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x58] = { 1, 0, 0x58, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x59] = { 1, 0, 0x59, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x5B] = { 1, 0, 0x5B, AML_ENCODING_GROUP_NONE,         1, 4,  1, 0, 0, },
-    [0x5C] = { 1, 0, 0x5C, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x5E] = { 1, 0, 0x5E, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x5F] = { 1, 0, 0x5F, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x5a] = { 1, 0, 0x5a, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, },
-    [0x60] = { 1, 0, 0x60, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x61] = { 1, 0, 0x61, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x62] = { 1, 0, 0x62, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x63] = { 1, 0, 0x63, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x64] = { 1, 0, 0x64, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x65] = { 1, 0, 0x65, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x66] = { 1, 0, 0x66, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x67] = { 1, 0, 0x67, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, },
-    [0x68] = { 1, 0, 0x68, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, },
-    [0x69] = { 1, 0, 0x69, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, },
-    [0x6A] = { 1, 0, 0x6A, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, },
-    [0x6B] = { 1, 0, 0x6B, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, },
-    [0x6C] = { 1, 0, 0x6C, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, },
-    [0x6D] = { 1, 0, 0x6D, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, },
-    [0x6E] = { 1, 0, 0x6E, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, },
-    [0x70] = { 1, 1, 0x70, AML_ENCODING_GROUP_TERM_OBJECT,  0, 63, 2, 0, 0, },
-    [0x71] = { 1, 1, 0x71, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x72] = { 1, 1, 0x72, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x73] = { 1, 1, 0x73, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x74] = { 1, 1, 0x74, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x75] = { 1, 1, 0x75, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x76] = { 1, 1, 0x76, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x77] = { 1, 1, 0x77, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x78] = { 1, 1, 0x78, AML_ENCODING_GROUP_TERM_OBJECT,  0, 68, 4, 0, 0, },
-    [0x79] = { 1, 1, 0x79, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x7A] = { 1, 1, 0x7A, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x7B] = { 1, 1, 0x7B, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x7C] = { 1, 1, 0x7C, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x7D] = { 1, 1, 0x7D, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x7E] = { 1, 1, 0x7E, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x7F] = { 1, 1, 0x7F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x80] = { 1, 1, 0x80, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x81] = { 1, 1, 0x81, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x82] = { 1, 1, 0x82, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x83] = { 1, 1, 0x83, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, },
-    [0x84] = { 1, 1, 0x84, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x85] = { 1, 1, 0x85, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x86] = { 1, 0, 0x86, AML_ENCODING_GROUP_TERM_OBJECT,  0, 38, 2, 0, 0, },
-    [0x87] = { 1, 1, 0x87, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x88] = { 1, 1, 0x88, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x89] = { 1, 1, 0x89, AML_ENCODING_GROUP_TERM_OBJECT,  0, 72, 6, 0, 0, },
-    [0x8A] = { 1, 0, 0x8A, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, },
-    [0x8B] = { 1, 0, 0x8B, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, },
-    [0x8C] = { 1, 0, 0x8C, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, },
-    [0x8D] = { 1, 0, 0x8D, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, },
-    [0x8E] = { 1, 1, 0x8E, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, },
-    [0x8F] = { 1, 0, 0x8F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, },
-    [0x90] = { 1, 1, 0x90, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, },
-    [0x91] = { 1, 1, 0x91, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, },
-    [0x92] = { 1, 1, 0x92, AML_ENCODING_GROUP_TERM_OBJECT,  2, 11, 1, 0, 0, },
-    [0x93] = { 1, 1, 0x93, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, },
-    [0x94] = { 1, 1, 0x94, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, },
-    [0x95] = { 1, 1, 0x95, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, },
-    [0x96] = { 1, 1, 0x96, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x97] = { 1, 1, 0x97, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x98] = { 1, 1, 0x98, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x99] = { 1, 1, 0x99, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, },
-    [0x9C] = { 1, 1, 0x9C, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, },
-    [0x9D] = { 1, 1, 0x9D, AML_ENCODING_GROUP_TERM_OBJECT,  0, 83, 2, 0, 0, },
-    [0x9E] = { 1, 1, 0x9E, AML_ENCODING_GROUP_TERM_OBJECT,  0, 85, 4, 0, 0, },
-    [0x9F] = { 1, 0, 0x9F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, },
-    [0xA0] = { 1, 0, 0xA0, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 1, },
-    [0xA1] = { 1, 0, 0xA1, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 1, },
-    [0xA2] = { 1, 0, 0xA2, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 1, },
-    [0xA3] = { 1, 0, 0xA3, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, },
-    [0xA4] = { 1, 0, 0xA4, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, },
-    [0xA5] = { 1, 0, 0xA5, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, },
-    [0xCC] = { 1, 0, 0xCC, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, },
-    [0xFF] = { 1, 0, 0xFF, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, },
+    [0x00] = { 1, 0, 0x00, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x01] = { 1, 0, 0x01, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x06] = { 1, 0, 0x06, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  2, 0, 0, AML_OPCODE_CLASS_NAMESPACE_MODIFIER, },
+    [0x08] = { 1, 0, 0x08, AML_ENCODING_GROUP_TERM_OBJECT,  0, 2,  2, 0, 0, AML_OPCODE_CLASS_NAMESPACE_MODIFIER, },
+    [0x0A] = { 1, 0, 0x0A, AML_ENCODING_GROUP_DATA_OBJECT,  0, 4,  1, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x0B] = { 1, 0, 0x0B, AML_ENCODING_GROUP_DATA_OBJECT,  0, 5,  1, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x0C] = { 1, 0, 0x0C, AML_ENCODING_GROUP_DATA_OBJECT,  0, 6,  1, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x0D] = { 1, 0, 0x0D, AML_ENCODING_GROUP_DATA_OBJECT,  0, 7,  2, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x0E] = { 1, 0, 0x0E, AML_ENCODING_GROUP_DATA_OBJECT,  0, 9,  1, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
+    [0x10] = { 1, 0, 0x10, AML_ENCODING_GROUP_TERM_OBJECT,  0, 10, 1, 0, 1, AML_OPCODE_CLASS_NAMESPACE_MODIFIER, },
+    [0x11] = { 1, 1, 0x11, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 1, 1, AML_OPCODE_CLASS_DATA_EXPRESSION, },
+    [0x12] = { 1, 1, 0x12, AML_ENCODING_GROUP_TERM_OBJECT,  0, 4,  1, 2, 2, AML_OPCODE_CLASS_DATA_EXPRESSION, },
+    [0x13] = { 1, 1, 0x13, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 2, 2, AML_OPCODE_CLASS_DATA_EXPRESSION, },
+    [0x14] = { 1, 0, 0x14, AML_ENCODING_GROUP_TERM_OBJECT,  0, 12, 2, 0, 1, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x15] = { 1, 0, 0x15, AML_ENCODING_GROUP_NAME_OBJECT,  0, 14, 3, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x2E] = { 1, 0, 0x2E, AML_ENCODING_GROUP_NAME_OBJECT,  0, 17, 2, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x2F] = { 1, 0, 0x2F, AML_ENCODING_GROUP_NAME_OBJECT,  0, 19, 2, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x30] = { 1, 0, 0x30, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x31] = { 1, 0, 0x31, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x32] = { 1, 0, 0x32, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x33] = { 1, 0, 0x33, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x34] = { 1, 0, 0x34, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x35] = { 1, 0, 0x35, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x36] = { 1, 0, 0x36, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x37] = { 1, 0, 0x37, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x38] = { 1, 0, 0x38, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x39] = { 1, 0, 0x39, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x41] = { 1, 0, 0x41, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x42] = { 1, 0, 0x42, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x43] = { 1, 0, 0x43, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x44] = { 1, 0, 0x44, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x45] = { 1, 0, 0x45, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x46] = { 1, 0, 0x46, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x47] = { 1, 0, 0x47, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x48] = { 1, 0, 0x48, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x49] = { 1, 0, 0x49, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x4a] = { 1, 0, 0x4a, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x4b] = { 1, 0, 0x4b, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x4c] = { 1, 0, 0x4c, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x4d] = { 1, 0, 0x4d, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x4e] = { 1, 0, 0x4e, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x4f] = { 1, 0, 0x4f, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x50] = { 1, 0, 0x50, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x51] = { 1, 0, 0x51, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x52] = { 1, 0, 0x52, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x53] = { 1, 0, 0x53, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x54] = { 1, 0, 0x54, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x55] = { 1, 0, 0x55, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x56] = { 1, 0, 0x56, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x57] = { 1, 0, 0x57, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x58] = { 1, 0, 0x58, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x59] = { 1, 0, 0x59, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x5B] = { 1, 0, 0x5B, AML_ENCODING_GROUP_NONE,         1, 4,  1, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x5C] = { 1, 0, 0x5C, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x5E] = { 1, 0, 0x5E, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x5F] = { 1, 0, 0x5F, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x5a] = { 1, 0, 0x5a, AML_ENCODING_GROUP_NAME_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_NONE, },
+    [0x60] = { 1, 0, 0x60, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x61] = { 1, 0, 0x61, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x62] = { 1, 0, 0x62, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x63] = { 1, 0, 0x63, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x64] = { 1, 0, 0x64, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x65] = { 1, 0, 0x65, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x66] = { 1, 0, 0x66, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x67] = { 1, 0, 0x67, AML_ENCODING_GROUP_LOCAL_OBJECT, 0, 0,  0, 0, 0, AML_OPCODE_CLASS_LOCAL_OBJECT, },
+    [0x68] = { 1, 0, 0x68, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, AML_OPCODE_CLASS_ARG_OBJECT, },
+    [0x69] = { 1, 0, 0x69, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, AML_OPCODE_CLASS_ARG_OBJECT, },
+    [0x6A] = { 1, 0, 0x6A, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, AML_OPCODE_CLASS_ARG_OBJECT, },
+    [0x6B] = { 1, 0, 0x6B, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, AML_OPCODE_CLASS_ARG_OBJECT, },
+    [0x6C] = { 1, 0, 0x6C, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, AML_OPCODE_CLASS_ARG_OBJECT, },
+    [0x6D] = { 1, 0, 0x6D, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, AML_OPCODE_CLASS_ARG_OBJECT, },
+    [0x6E] = { 1, 0, 0x6E, AML_ENCODING_GROUP_ARG_OBJECT,   0, 0,  0, 0, 0, AML_OPCODE_CLASS_ARG_OBJECT, },
+    [0x70] = { 1, 1, 0x70, AML_ENCODING_GROUP_TERM_OBJECT,  0, 63, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x71] = { 1, 1, 0x71, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x72] = { 1, 1, 0x72, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x73] = { 1, 1, 0x73, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x74] = { 1, 1, 0x74, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x75] = { 1, 1, 0x75, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x76] = { 1, 1, 0x76, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x77] = { 1, 1, 0x77, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x78] = { 1, 1, 0x78, AML_ENCODING_GROUP_TERM_OBJECT,  0, 68, 4, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x79] = { 1, 1, 0x79, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x7A] = { 1, 1, 0x7A, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x7B] = { 1, 1, 0x7B, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x7C] = { 1, 1, 0x7C, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x7D] = { 1, 1, 0x7D, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x7E] = { 1, 1, 0x7E, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x7F] = { 1, 1, 0x7F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x80] = { 1, 1, 0x80, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x81] = { 1, 1, 0x81, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x82] = { 1, 1, 0x82, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x83] = { 1, 1, 0x83, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x84] = { 1, 1, 0x84, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x85] = { 1, 1, 0x85, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x86] = { 1, 0, 0x86, AML_ENCODING_GROUP_TERM_OBJECT,  0, 38, 2, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0x87] = { 1, 1, 0x87, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x88] = { 1, 1, 0x88, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x89] = { 1, 1, 0x89, AML_ENCODING_GROUP_TERM_OBJECT,  0, 72, 6, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x8A] = { 1, 0, 0x8A, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x8B] = { 1, 0, 0x8B, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x8C] = { 1, 0, 0x8C, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x8D] = { 1, 0, 0x8D, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x8E] = { 1, 1, 0x8E, AML_ENCODING_GROUP_TERM_OBJECT,  0, 37, 1, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x8F] = { 1, 0, 0x8F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 78, 3, 0, 0, AML_OPCODE_CLASS_NAMED_OBJECT, },
+    [0x90] = { 1, 1, 0x90, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x91] = { 1, 1, 0x91, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x92] = { 1, 1, 0x92, AML_ENCODING_GROUP_TERM_OBJECT,  2, 11, 1, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x93] = { 1, 1, 0x93, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x94] = { 1, 1, 0x94, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x95] = { 1, 1, 0x95, AML_ENCODING_GROUP_TERM_OBJECT,  0, 81, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x96] = { 1, 1, 0x96, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x97] = { 1, 1, 0x97, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x98] = { 1, 1, 0x98, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x99] = { 1, 1, 0x99, AML_ENCODING_GROUP_TERM_OBJECT,  0, 40, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x9C] = { 1, 1, 0x9C, AML_ENCODING_GROUP_TERM_OBJECT,  0, 65, 3, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x9D] = { 1, 1, 0x9D, AML_ENCODING_GROUP_TERM_OBJECT,  0, 83, 2, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x9E] = { 1, 1, 0x9E, AML_ENCODING_GROUP_TERM_OBJECT,  0, 85, 4, 0, 0, AML_OPCODE_CLASS_EXPRESSION, },
+    [0x9F] = { 1, 0, 0x9F, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0xA0] = { 1, 0, 0xA0, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 1, AML_OPCODE_CLASS_STATEMENT, },
+    [0xA1] = { 1, 0, 0xA1, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 1, AML_OPCODE_CLASS_STATEMENT, },
+    [0xA2] = { 1, 0, 0xA2, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 1, AML_OPCODE_CLASS_STATEMENT, },
+    [0xA3] = { 1, 0, 0xA3, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0xA4] = { 1, 0, 0xA4, AML_ENCODING_GROUP_TERM_OBJECT,  0, 11, 1, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0xA5] = { 1, 0, 0xA5, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0xCC] = { 1, 0, 0xCC, AML_ENCODING_GROUP_TERM_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_STATEMENT, },
+    [0xFF] = { 1, 0, 0xFF, AML_ENCODING_GROUP_DATA_OBJECT,  0, 0,  0, 0, 0, AML_OPCODE_CLASS_DATA_OBJECT, },
 };
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "aml_epoch.h"
+
+//
+// Get the oldest epoch entered by any reader that is currently within a critical section,
+// returns UINT64_MAX if there are no active readers.
+//
+static
+UINT64
+AmlEpochMinimumReaderEpoch(
+    _In_ AML_EPOCH* Epoch
+    )
+{
+    SIZE_T i;
+    UINT64 ReaderEpoch;
+    UINT64 MinimumEpoch;
+
+    MinimumEpoch = UINT64_MAX;
+    for( i = 0; i < AML_COUNTOF( Epoch->Readers ); i++ ) {
+        ReaderEpoch = AML_ATOMIC_LOAD64( &Epoch->Readers[ i ].Epoch );
+        if( ReaderEpoch != 0 ) {
+            MinimumEpoch = AML_MIN( MinimumEpoch, ReaderEpoch );
+        }
+    }
+    return MinimumEpoch;
+}
+
+//
+// Advance the global epoch, returns the epoch that was current before advancing.
+//
+static
+UINT64
+AmlEpochAdvance(
+    _Inout_ AML_EPOCH* Epoch
+    )
+{
+    UINT64 CurrentEpoch;
+
+    CurrentEpoch = Epoch->GlobalEpoch;
+    AML_ATOMIC_STORE64( &Epoch->GlobalEpoch, ( CurrentEpoch + 1 ) );
+    return CurrentEpoch;
+}
+
+//
+// Initialize epoch state, retired allocations must have been allocated from the given heap.
+//
+VOID
+AmlEpochInitialize(
+    _Out_   AML_EPOCH* Epoch,
+    _Inout_ AML_HEAP*  Heap
+    )
+{
+    AML_MEMSET( Epoch, 0, sizeof( *Epoch ) );
+    Epoch->Heap = Heap;
+    Epoch->GlobalEpoch = 1;
+}
+
+//
+// Free all retired allocations, all readers must have been unregistered.
+//
+VOID
+AmlEpochRelease(
+    _Inout_ AML_EPOCH* Epoch
+    )
+{
+    AML_EPOCH_RETIRED* Retired;
+
+    while( ( Retired = Epoch->RetiredHead ) != NULL ) {
+        Epoch->RetiredHead = Retired->Next;
+        AmlHeapFree( Epoch->Heap, Retired->Allocation );
+        AmlHeapFree( Epoch->Heap, Retired );
+    }
+    Epoch->RetiredTail = NULL;
+    Epoch->RetiredCount = 0;
+}
+
+//
+// Claim a free reader slot, fails if all reader slots are in use.
+//
+_Success_( return )
+BOOLEAN
+AmlEpochReaderRegister(
+    _Inout_ AML_EPOCH* Epoch,
+    _Out_   SIZE_T*    pReaderIndex
+    )
+{
+    SIZE_T i;
+    UINT64 ReaderCount;
+
+    for( i = 0; i < AML_COUNTOF( Epoch->Readers ); i++ ) {
+        if( AML_ATOMIC_COMPARE_EXCHANGE64( &Epoch->Readers[ i ].IsRegistered, 0, 1 ) != 0 ) {
+            continue;
+        }
+
+        //
+        // Count the new reader, this allows the writer to skip scanning reader slots while there are no readers.
+        //
+        do {
+            ReaderCount = AML_ATOMIC_LOAD64( &Epoch->ReaderCount );
+        } while( AML_ATOMIC_COMPARE_EXCHANGE64( &Epoch->ReaderCount, ReaderCount, ( ReaderCount + 1 ) ) != ReaderCount );
+        *pReaderIndex = i;
+        return AML_TRUE;
+    }
+    return AML_FALSE;
+}
+
+//
+// Release a reader slot claimed by AmlEpochReaderRegister, the reader must not be within a critical section.
+//
+VOID
+AmlEpochReaderUnregister(
+    _Inout_ AML_EPOCH* Epoch,
+    _In_    SIZE_T     ReaderIndex
+    )
+{
+    UINT64 ReaderCount;
+
+    do {
+        ReaderCount = AML_ATOMIC_LOAD64( &Epoch->ReaderCount );
+    } while( AML_ATOMIC_COMPARE_EXCHANGE64( &Epoch->ReaderCount, ReaderCount, ( ReaderCount - 1 ) ) != ReaderCount );
+    AML_ATOMIC_STORE64( &Epoch->Readers[ ReaderIndex ].IsRegistered, 0 );
+}
+
+//
+// Enter a read-side critical section, shared allocations reached within it remain valid until AmlEpochReaderLeave.
+//
+VOID
+AmlEpochReaderEnter(
+    _Inout_ AML_EPOCH* Epoch,
+    _In_    SIZE_T     ReaderIndex
+    )
+{
+    //
+    // Publish the current epoch, the full barrier ensures that the writer either sees the published epoch,
+    // or that all following reads of shared state by the reader see everything unlinked before the writer's scan.
+    //
+    AML_ATOMIC_STORE64( &Epoch->Readers[ ReaderIndex ].Epoch, AML_ATOMIC_LOAD64( &Epoch->GlobalEpoch ) );
+    AML_ATOMIC_FENCE();
+}
+
+//
+// Leave a read-side critical section.
+//
+VOID
+AmlEpochReaderLeave(
+    _Inout_ AML_EPOCH* Epoch,
+    _In_    SIZE_T     ReaderIndex
+    )
+{
+    AML_ATOMIC_STORE64( &Epoch->Readers[ ReaderIndex ].Epoch, 0 );
+}
+
+//
+// Retire an allocation that has already been unlinked from all shared structures (writer-side).
+// The allocation is freed immediately if there are no active readers, otherwise once all current readers have left.
+//
+VOID
+AmlEpochRetire(
+    _Inout_             AML_EPOCH* Epoch,
+    _In_ _Post_invalid_ VOID*      Allocation
+    )
+{
+    AML_EPOCH_RETIRED* Retired;
+    UINT64             RetireEpoch;
+
+    //
+    // Order the unlinking of the allocation before checking for readers.
+    // If there are no registered readers, nothing can still be referencing the allocation (or any previously retired ones).
+    //
+    AML_ATOMIC_FENCE();
+    if( AML_ATOMIC_LOAD64( &Epoch->ReaderCount ) == 0 ) {
+        AmlHeapFree( Epoch->Heap, Allocation );
+        if( Epoch->RetiredHead != NULL ) {
+            AmlEpochReclaim( Epoch );
+        }
+        return;
+    }
+
+    //
+    // Defer freeing the allocation until all readers that may have seen it have left.
+    // If the retired entry can't be allocated, wait for all current readers to leave instead.
+    //
+    if( ( Retired = AmlHeapAllocate( Epoch->Heap, sizeof( *Retired ) ) ) == NULL ) {
+        RetireEpoch = AmlEpochAdvance( Epoch );
+        AML_ATOMIC_FENCE();
+        while( AmlEpochMinimumReaderEpoch( Epoch ) <= RetireEpoch ) {
+            AML_PAUSE();
+        }
+        AmlHeapFree( Epoch->Heap, Allocation );
+        return;
+    }
+    *Retired = ( AML_EPOCH_RETIRED ){ .Epoch = AmlEpochAdvance( Epoch ), .Allocation = Allocation };
+    if( Epoch->RetiredTail != NULL ) {
+        Epoch->RetiredTail->Next = Retired;
+    } else {
+        Epoch->RetiredHead = Retired;
+    }
+    Epoch->RetiredTail = Retired;
+    Epoch->RetiredCount += 1;
+
+    //
+    // Periodically attempt to reclaim all retired allocations.
+    //
+    if( Epoch->RetiredCount >= AML_EPOCH_RECLAIM_THRESHOLD ) {
+        AmlEpochReclaim( Epoch );
+    }
+}
+
+//
+// Free all retired allocations that can no longer be referenced by any active reader (writer-side).
+//
+VOID
+AmlEpochReclaim(
+    _Inout_ AML_EPOCH* Epoch
+    )
+{
+    AML_EPOCH_RETIRED* Retired;
+    UINT64             MinimumEpoch;
+
+    //
+    // Retired allocations are ordered by epoch, an allocation retired at an epoch older than the oldest
+    // epoch entered by any active reader was unlinked before all active readers entered.
+    //
+    AML_ATOMIC_FENCE();
+    MinimumEpoch = AmlEpochMinimumReaderEpoch( Epoch );
+    while( ( ( Retired = Epoch->RetiredHead ) != NULL ) && ( Retired->Epoch < MinimumEpoch ) ) {
+        Epoch->RetiredHead = Retired->Next;
+        Epoch->RetiredCount -= 1;
+        AmlHeapFree( Epoch->Heap, Retired->Allocation );
+        AmlHeapFree( Epoch->Heap, Retired );
+    }
+    if( Epoch->RetiredHead == NULL ) {
+        Epoch->RetiredTail = NULL;
+    }
+}
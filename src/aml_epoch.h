@@ -0,0 +1,122 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_heap.h"
+
+//
+// Maximum amount of concurrently registered epoch readers.
+//
+#define AML_EPOCH_MAX_READERS 64
+
+//
+// Amount of pending retired allocations before the writer attempts to reclaim them.
+//
+#define AML_EPOCH_RECLAIM_THRESHOLD 64
+
+//
+// Per-reader epoch slot, padded to a cache line to avoid false sharing between readers.
+// Epoch is 0 while the reader isn't within a read-side critical section.
+//
+typedef struct _AML_EPOCH_READER {
+    UINT64 Epoch;
+    UINT64 IsRegistered;
+    UINT8  Padding[ 48 ];
+} AML_EPOCH_READER;
+
+//
+// Retired allocation, freed once no reader may still be referencing it.
+//
+typedef struct _AML_EPOCH_RETIRED {
+    struct _AML_EPOCH_RETIRED* Next;
+    UINT64                     Epoch;
+    VOID*                      Allocation;
+} AML_EPOCH_RETIRED;
+
+//
+// Epoch-based deferred reclamation.
+// Readers run lock-free, publishing the global epoch that they have entered in their reader slot.
+// A single (serialized) writer unlinks shared allocations and retires them at the current global epoch,
+// retired allocations are only freed once every active reader has entered a later epoch.
+// All writer-side functions must be serialized by the caller (they are only called by the evaluation of the state, which the host serializes).
+//
+typedef struct _AML_EPOCH {
+    AML_HEAP*          Heap;
+    UINT64             GlobalEpoch;
+    UINT64             ReaderCount;
+    AML_EPOCH_READER   Readers[ AML_EPOCH_MAX_READERS ];
+    AML_EPOCH_RETIRED* RetiredHead;
+    AML_EPOCH_RETIRED* RetiredTail;
+    SIZE_T             RetiredCount;
+} AML_EPOCH;
+
+//
+// Initialize epoch state, retired allocations must have been allocated from the given heap.
+//
+VOID
+AmlEpochInitialize(
+    _Out_   AML_EPOCH* Epoch,
+    _Inout_ AML_HEAP*  Heap
+    );
+
+//
+// Free all retired allocations, all readers must have been unregistered.
+//
+VOID
+AmlEpochRelease(
+    _Inout_ AML_EPOCH* Epoch
+    );
+
+//
+// Claim a free reader slot, fails if all reader slots are in use.
+//
+_Success_( return )
+BOOLEAN
+AmlEpochReaderRegister(
+    _Inout_ AML_EPOCH* Epoch,
+    _Out_   SIZE_T*    pReaderIndex
+    );
+
+//
+// Release a reader slot claimed by AmlEpochReaderRegister, the reader must not be within a critical section.
+//
+VOID
+AmlEpochReaderUnregister(
+    _Inout_ AML_EPOCH* Epoch,
+    _In_    SIZE_T     ReaderIndex
+    );
+
+//
+// Enter a read-side critical section, shared allocations reached within it remain valid until AmlEpochReaderLeave.
+//
+VOID
+AmlEpochReaderEnter(
+    _Inout_ AML_EPOCH* Epoch,
+    _In_    SIZE_T     ReaderIndex
+    );
+
+//
+// Leave a read-side critical section.
+//
+VOID
+AmlEpochReaderLeave(
+    _Inout_ AML_EPOCH* Epoch,
+    _In_    SIZE_T     ReaderIndex
+    );
+
+//
+// Retire an allocation that has already been unlinked from all shared structures (writer-side).
+// The allocation is freed immediately if there are no active readers, otherwise once all current readers have left.
+//
+VOID
+AmlEpochRetire(
+    _Inout_             AML_EPOCH* Epoch,
+    _In_ _Post_invalid_ VOID*      Allocation
+    );
+
+//
+// Free all retired allocations that can no longer be referenced by any active reader (writer-side).
+//
+VOID
+AmlEpochReclaim(
+    _Inout_ AML_EPOCH* Epoch
+    );
@@ -20,6 +20,9 @@
 #include "aml_eval_statement.h"
 #include "aml_eval_namespace.h"
 #include "aml_eval_reference.h"
+#include "aml_name_cache.h"
+#include "aml_skip_index.h"
+#include "aml_method_purity.h"
 
 //
 // TODO:
@@ -141,14 +144,17 @@
 
 //
 // Resolve the given AML_SIMPLE_NAME to an operand meta structure.
+// NameString targets decoded from the current code block are resolved through the name cache of the given call site.
 // The returned object reference counter is increased, and must be released by the caller.
 //
 _Success_( return )
+static
 BOOLEAN
-AmlResolveSimpleName(
+AmlResolveSimpleNameInternal(
     _Inout_  AML_STATE*             State,
     _In_opt_ AML_METHOD_SCOPE*      MethodScope,
     _In_     const AML_SIMPLE_NAME* Target,
+    _In_     SIZE_T                 CallSiteOffset,
     _In_     UINT                   SearchFlags,
     _In_     UINT                   NameFlags,
     _Outptr_ AML_OBJECT**           ppObject
@@ -209,11 +215,22 @@ AmlResolveSimpleName(
         // Search the given name (and resolve/follow aliases to final object).
         // Return special nil object if we are allowed to not find anything.
         //
-        if( AmlNamespaceSearch( &State->Namespace, NULL, &Target->u.NameString, SearchFlags, &NamespaceNode ) == AML_FALSE ) {
+        if( AmlNameCacheSearch( State->NameCache,
+                                &State->Namespace,
+                                State->Data,
+                                CallSiteOffset,
+                                &Target->u.NameString,
+                                SearchFlags,
+                                &NamespaceNode ) == AML_FALSE )
+        {
             if( ( NameFlags & AML_NAME_FLAG_ALLOW_NON_EXISTENT ) == 0 ) {
                 return AML_FALSE;
             }
             Object = &State->Namespace.NilObject;
+        } else if( ( NameFlags & AML_NAME_FLAG_PRIVATIZE )
+                   && ( AmlNamespacePrivatizeNode( &State->Namespace, NamespaceNode ) == AML_FALSE ) )
+        {
+            return AML_FALSE;
         } else {
             Object = NamespaceNode->Object;
         }
@@ -241,6 +258,24 @@ AmlResolveSimpleName(
     return AML_TRUE;
 }
 
+//
+// Resolve the given AML_SIMPLE_NAME to an operand meta structure.
+// The returned object reference counter is increased, and must be released by the caller.
+//
+_Success_( return )
+BOOLEAN
+AmlResolveSimpleName(
+    _Inout_  AML_STATE*             State,
+    _In_opt_ AML_METHOD_SCOPE*      MethodScope,
+    _In_     const AML_SIMPLE_NAME* Target,
+    _In_     UINT                   SearchFlags,
+    _In_     UINT                   NameFlags,
+    _Outptr_ AML_OBJECT**           ppObject
+    )
+{
+    return AmlResolveSimpleNameInternal( State, MethodScope, Target, AML_NAME_CACHE_NO_CALL_SITE, SearchFlags, NameFlags, ppObject );
+}
+
 //
 // Decode and resolve a SimpleName from the input stream.
 //
@@ -254,10 +289,12 @@ AmlEvalSimpleName(
     )
 {
     AML_SIMPLE_NAME SimpleName;
+    SIZE_T          CallSiteOffset;
 
     //
     // Consume a full SimpleName from the input code.
     //
+    CallSiteOffset = State->DataCursor;
     if( AmlDecoderConsumeSimpleName( State, &SimpleName ) == AML_FALSE ) {
         return AML_FALSE;
     }
@@ -265,7 +302,7 @@ AmlEvalSimpleName(
     //
     // Attempt to resolve the SimpleName to an object.
     //
-    return AmlResolveSimpleName( State, NULL, &SimpleName, SearchFlags, NameFlags, ppObject );
+    return AmlResolveSimpleNameInternal( State, NULL, &SimpleName, CallSiteOffset, SearchFlags, NameFlags, ppObject );
 }
 
 //
@@ -416,6 +453,7 @@ AmlEvalSuperName(
 {
     AML_DECODER_INSTRUCTION_OPCODE Peek;
     AML_SIMPLE_NAME                SimpleName;
+    SIZE_T                         CallSiteOffset;
 
     //
     // Peek the next full instruction opcode.
@@ -446,6 +484,7 @@ AmlEvalSuperName(
     // TODO: This will currently match over MethodInvocations, and will lead to ResolveSimpleName failing,
     // or being incorrect! Must fix soon!
     //
+    CallSiteOffset = State->DataCursor;
     if( AmlDecoderConsumeSimpleName( State, &SimpleName ) ) {
         if( ( SimpleName.Type == AML_SIMPLE_NAME_TYPE_STRING )
             && ( SimpleName.u.NameString.Prefix.Length == 0 )
@@ -458,13 +497,13 @@ AmlEvalSuperName(
             *ppObject = &State->Namespace.NilObject;
             return AML_TRUE;
         }
-        return AmlResolveSimpleName( State, NULL, &SimpleName, SearchFlags, NameFlags, ppObject );
+        return AmlResolveSimpleNameInternal( State, NULL, &SimpleName, CallSiteOffset, SearchFlags, NameFlags, ppObject );
     }
 
     //
     // Finally, try to match a ReferenceTypeOpcode, which may include a user MethodInvocation, which is greedy.
     //
-    return AmlEvalReferenceTypeOpcode( State, SearchFlags, ppObject );
+    return AmlEvalReferenceTypeOpcode( State, SearchFlags, NameFlags, ppObject );
 }
 
 //
@@ -480,7 +519,7 @@ AmlEvalTarget(
     _Outptr_ AML_OBJECT** ppObject
     )
 {
-    return AmlEvalSuperName( State, SearchFlags, AML_NAME_FLAG_ALLOW_NULL_NAME, ppObject );
+    return AmlEvalSuperName( State, SearchFlags, ( AML_NAME_FLAG_ALLOW_NULL_NAME | AML_NAME_FLAG_PRIVATIZE ), ppObject );
 }
 
 //
@@ -1060,10 +1099,11 @@ AmlEvalMethodInvocationInternal(
 
     //
     // Attempt to parse and evaluate all arguments.
+    // Buffers and packages of named objects are passed by reference, the method may modify them through its arguments.
     //
     Success = AML_TRUE;
     for( i = 0; i < MethodObject->u.Method.ArgumentCount; i++ ) {
-        if( ( Success = AmlEvalTermArg( State, 0, &Arguments[ i ] ) ) == AML_FALSE ) {
+        if( ( Success = AmlEvalTermArg( State, AML_EVAL_TERM_ARG_FLAG_PRIVATIZE, &Arguments[ i ] ) ) == AML_FALSE ) {
             break;
         }
     }
@@ -1121,7 +1161,7 @@ AmlEvalMethodInvocation(
     //
     // Search the name and try to figure out what it is.
     //
-    if( AmlNamespaceSearch( &State->Namespace, State->Namespace.ScopeLast, &NameString, 0, &NsNode ) == AML_FALSE ) {
+    if( AmlNameCacheSearch( State->NameCache, &State->Namespace, State->Data, OldCursor, &NameString, 0, &NsNode ) == AML_FALSE ) {
         State->DataCursor = OldCursor;
         return AML_FALSE;
     }
@@ -1160,10 +1200,52 @@ AmlEvalTermArgInternal(
     AML_DATA*                      ReadData;
     AML_NAME_STRING                NameString;
     AML_NAMESPACE_NODE*            NsNode;
+    SIZE_T                         CallSiteOffset;
+#if AML_BUILD_COMPUTED_GOTO
+    static const VOID* const       DispatchTable[ AML_OPCODE_CLASS_COUNT ] = {
+        [ AML_OPCODE_CLASS_NONE ]               = &&DispatchNameString,
+        [ AML_OPCODE_CLASS_STATEMENT ]          = &&DispatchNameString,
+        [ AML_OPCODE_CLASS_NAMESPACE_MODIFIER ] = &&DispatchNameString,
+        [ AML_OPCODE_CLASS_NAMED_OBJECT ]       = &&DispatchNameString,
+        [ AML_OPCODE_CLASS_EXPRESSION ]         = &&DispatchExpression,
+        [ AML_OPCODE_CLASS_DATA_OBJECT ]        = &&DispatchDataObject,
+        [ AML_OPCODE_CLASS_DATA_EXPRESSION ]    = &&DispatchDataObject,
+        [ AML_OPCODE_CLASS_ARG_OBJECT ]         = &&DispatchArgObj,
+        [ AML_OPCODE_CLASS_LOCAL_OBJECT ]       = &&DispatchLocalObj,
+    };
+#endif
+
+    //
+    // Peek the next instruction opcode, AmlEval* functions are not the same as match,
+    // they may partially evaluate/match data and error out, an eval function returning false
+    // can either mean no match, or evaluation error.
+    //
+    if( AmlDecoderPeekOpcode( State, &Opcode ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Dispatch the TermArg using the precomputed class of the opcode.
+    // DataObjects that are also ExpressionOpcodes (DefBuffer, DefPackage, DefVarPackage) are evaluated as DataObjects,
+    // anything unclassified must be an object name or a MethodInvocation.
+    //
+#if AML_BUILD_COMPUTED_GOTO
+    goto *DispatchTable[ Opcode.OpcodeClass % AML_OPCODE_CLASS_COUNT ];
+#else
+    switch( Opcode.OpcodeClass ) {
+    case AML_OPCODE_CLASS_EXPRESSION:      goto DispatchExpression;
+    case AML_OPCODE_CLASS_DATA_OBJECT:     goto DispatchDataObject;
+    case AML_OPCODE_CLASS_DATA_EXPRESSION: goto DispatchDataObject;
+    case AML_OPCODE_CLASS_ARG_OBJECT:      goto DispatchArgObj;
+    case AML_OPCODE_CLASS_LOCAL_OBJECT:    goto DispatchLocalObj;
+    default:                               goto DispatchNameString;
+    }
+#endif
 
     //
     // Handle ArgObj, reads the corresponding argument for the current method call scope.
     // 
+DispatchArgObj:
     if( AmlDecoderMatchArgObj( State, &ArgIndex ) ) {
         //
         // Ensure that parsed argument index is valid (should always be, unless code is changed).
@@ -1212,9 +1294,12 @@ AmlEvalTermArgInternal(
         return AmlDataDuplicate( ReadData, &State->Heap, ValueData );
     }
 
+    goto DispatchNameString;
+
     //
     // Handle LocalObj, reads the corresponding local variable for the current method call scope.
     //
+DispatchLocalObj:
     if( AmlDecoderMatchLocalObj( State, &LocalIndex ) ) {
         //
         // Must be within the scope of a method call.
@@ -1245,20 +1330,13 @@ AmlEvalTermArgInternal(
         //
         return AmlDataDuplicate( ReadData, &State->Heap, ValueData );
     }
-
-    //
-    // Peek the next instruction opcode, AmlEval* functions are not the same as match,
-    // they may partially evaluate/match data and error out, an eval function returning false
-    // can either mean no match, or evaluation error.
-    //
-    if( AmlDecoderPeekOpcode( State, &Opcode ) == AML_FALSE ) {
-        return AML_FALSE;
-    }
+    goto DispatchNameString;
 
     //
     // Handle DataObject.
     //
-    if( AmlDecoderIsDataObject( State, &Opcode ) ) {
+DispatchDataObject:
+    {
         IsTemporary = ( ( TermArgFlags & AML_EVAL_TERM_ARG_FLAG_TEMP ) != 0 );
         if( AmlEvalDataObject( State, ValueData, IsTemporary ) == AML_FALSE ) {
             AML_DEBUG_ERROR( State, "Error: AmlEvalTermArg: AmlEvalDataObject failed!\n" );
@@ -1271,7 +1349,8 @@ AmlEvalTermArgInternal(
     // Match an ExpressionOpcode, but don't try to match a MethodInvocation,
     // as we need special logic for here for handling named objects and method invocations.
     //
-    if( AmlDecoderIsExpressionOpcode( State, &Opcode ) ) {
+DispatchExpression:
+    {
         if( AmlEvalExpressionOpcode( State, AML_FALSE, ValueData ) == AML_FALSE ) {
             AML_DEBUG_ERROR( State, "Error: AmlEvalTermArg: AmlEvalExpressionOpcode failed!\n" );
             return AML_FALSE;
@@ -1282,11 +1361,13 @@ AmlEvalTermArgInternal(
     //
     // Nothing else was matched, we must now try to match an object name or MethodInvocation (both start with NameStrings).
     //
+DispatchNameString:
+    CallSiteOffset = State->DataCursor;
     if( AmlDecoderMatchNameString( State, AML_FALSE, &NameString ) ) {
         //
         // Search the name and try to figure out what it is.
         //
-        if( AmlNamespaceSearch( &State->Namespace, State->Namespace.ScopeLast, &NameString, 0, &NsNode ) == AML_FALSE ) {
+        if( AmlNameCacheSearch( State->NameCache, &State->Namespace, State->Data, CallSiteOffset, &NameString, 0, &NsNode ) == AML_FALSE ) {
             AML_DEBUG_ERROR( State, "Error: AmlEvalTermArg: namespace search failed for name: \"" );
             AmlDebugPrintNameString( State, AML_DEBUG_LEVEL_ERROR, &NameString );
             AML_DEBUG_ERROR( State, "\"\n" );
@@ -1303,7 +1384,14 @@ AmlEvalTermArgInternal(
             // ObjectReference - If performing a DeRefOf return the target of the reference. Otherwise, return the reference.
             // All other object types - Return the object
             // TODO: (?) Handle ObjectReference + Alias.
+            // Shared objects are read in place, the duplicate receives a temporary copy of their data,
+            // unless the caller may modify the data of the object through the result (Index, buffer fields, arguments).
             //
+            if( ( TermArgFlags & AML_EVAL_TERM_ARG_FLAG_PRIVATIZE )
+                && ( AmlNamespacePrivatizeNode( &State->Namespace, NsNode ) == AML_FALSE ) )
+            {
+                return AML_FALSE;
+            }
             return AmlDataDuplicate( &NsNode->Object->u.Name.Value, &State->Heap, ValueData );
         case AML_OBJECT_TYPE_BUFFER_FIELD:
         case AML_OBJECT_TYPE_INDEX_FIELD:
@@ -1415,6 +1503,19 @@ AmlEvalTerm(
 {
     AML_DECODER_INSTRUCTION_OPCODE Next;
     AML_DATA                       Result;
+#if AML_BUILD_COMPUTED_GOTO
+    static const VOID* const       DispatchTable[ AML_OPCODE_CLASS_COUNT ] = {
+        [ AML_OPCODE_CLASS_NONE ]               = &&DispatchMethodInvocation,
+        [ AML_OPCODE_CLASS_STATEMENT ]          = &&DispatchStatement,
+        [ AML_OPCODE_CLASS_NAMESPACE_MODIFIER ] = &&DispatchNamespaceModifier,
+        [ AML_OPCODE_CLASS_NAMED_OBJECT ]       = &&DispatchNamedObject,
+        [ AML_OPCODE_CLASS_EXPRESSION ]         = &&DispatchExpression,
+        [ AML_OPCODE_CLASS_DATA_OBJECT ]        = &&DispatchDataObject,
+        [ AML_OPCODE_CLASS_DATA_EXPRESSION ]    = &&DispatchExpression,
+        [ AML_OPCODE_CLASS_ARG_OBJECT ]         = &&DispatchMethodInvocation,
+        [ AML_OPCODE_CLASS_LOCAL_OBJECT ]       = &&DispatchMethodInvocation,
+    };
+#endif
 
     //
     // Peek next full opcode.
@@ -1426,41 +1527,57 @@ AmlEvalTerm(
     AML_DEBUG_TRACE( State, "Executing opcode 0x%x @ +0x%08"PRIx64"\n", ( UINT )Next.OpcodeID, ( UINT64 )State->DataCursor );
 
     //
-    // Evaluate statement opcodes.
+    // Dispatch the instruction to the handler of its precomputed opcode class.
+    // DataObjects that are also ExpressionOpcodes (DefBuffer, DefPackage, DefVarPackage) are evaluated as expressions,
+    // anything unclassified can only be a MethodInvocation.
     //
-    if( AmlDecoderIsStatementOpcode( State, &Next ) ) {
-        return AmlEvalStatementOpcode( State );
+#if AML_BUILD_COMPUTED_GOTO
+    goto *DispatchTable[ Next.OpcodeClass % AML_OPCODE_CLASS_COUNT ];
+#else
+    switch( Next.OpcodeClass ) {
+    case AML_OPCODE_CLASS_STATEMENT:          goto DispatchStatement;
+    case AML_OPCODE_CLASS_NAMESPACE_MODIFIER: goto DispatchNamespaceModifier;
+    case AML_OPCODE_CLASS_NAMED_OBJECT:       goto DispatchNamedObject;
+    case AML_OPCODE_CLASS_EXPRESSION:         goto DispatchExpression;
+    case AML_OPCODE_CLASS_DATA_OBJECT:        goto DispatchDataObject;
+    case AML_OPCODE_CLASS_DATA_EXPRESSION:    goto DispatchExpression;
+    default:                                  goto DispatchMethodInvocation;
     }
+#endif
+
+    //
+    // Evaluate statement opcodes.
+    //
+DispatchStatement:
+    return AmlEvalStatementOpcode( State );
 
     //
     // Evaluate namespace modifier object opcodes.
     //
-    if( AmlDecoderIsNamespaceModifierObjectOpcode( State, &Next ) ) {
-        return AmlEvalNamespaceModifierObjectOpcode( State );
-    }
+DispatchNamespaceModifier:
+    return AmlEvalNamespaceModifierObjectOpcode( State );
 
     //
     // Named object opcodes.
     //
-    if( AmlDecoderIsNamedObjectOpcode( State, &Next ) ) {
-        return AmlEvalNamedObjectOpcode( State );
-    }
+DispatchNamedObject:
+    return AmlEvalNamedObjectOpcode( State );
 
     //
     // Evaluate expression opcodes.
     // Temp hack to free any results.
     //
-    if( AmlDecoderIsExpressionOpcode( State, &Next ) ) {
-        if( AmlEvalExpressionOpcode( State, AML_TRUE, &Result ) == AML_FALSE ) {
-            return AML_FALSE;
-        }
-        AmlDataFree( &Result );
-        return AML_TRUE;
+DispatchExpression:
+    if( AmlEvalExpressionOpcode( State, AML_TRUE, &Result ) == AML_FALSE ) {
+        return AML_FALSE;
     }
+    AmlDataFree( &Result );
+    return AML_TRUE;
 
     //
     // Ignore data in the regular instruction stream.
     //
+DispatchDataObject:
     if( AmlDecoderMatchDataObject( State, NULL ) ) {
         AML_DEBUG_TRACE( State, "Skipping pointless data object in TermList instruction stream.\n" );
         return AML_TRUE;
@@ -1469,6 +1586,7 @@ AmlEvalTerm(
     //
     // Nothing else was matched, try to match and evaluate a MethodInvocation.
     //
+DispatchMethodInvocation:
     if( AmlEvalMethodInvocation( State, 0, &Result ) ) {
         AmlDataFree( &Result );
         return AML_TRUE;
@@ -1530,8 +1648,40 @@ AmlEvalTermNamespacePass(
     return AmlDecoderConsumeInstruction( State );
 }
 
+//
+// Complete the last evaluation frame once the end of its TermList has been reached
+// (or a control flow interruption event is pending).
+// Either pops the frame, or moves the data window back to the start of its TermList (While iteration).
+//
+_Success_( return )
+static
+BOOLEAN
+AmlEvalFrameComplete(
+    _Inout_ AML_STATE* State
+    )
+{
+    switch( State->EvalFrameLast->Type ) {
+    case AML_EVAL_FRAME_TYPE_TERM_LIST:
+        AmlEvalFramePop( State );
+        return AML_TRUE;
+    case AML_EVAL_FRAME_TYPE_SCOPE:
+        AmlEvalFramePop( State );
+        return AmlNamespacePopScope( &State->Namespace );
+    case AML_EVAL_FRAME_TYPE_IF:
+        return AmlEvalIfElseComplete( State );
+    case AML_EVAL_FRAME_TYPE_WHILE:
+        return AmlEvalWhileComplete( State );
+    }
+
+    AML_DEBUG_ERROR( State, "Error: Invalid evaluation frame type!\n" );
+    return AML_FALSE;
+}
+
 //
 // Attempt to evaluate an entire block of code until reaching the end.
+// Nested TermList blocks (If/Else/While/Scope bodies) are pushed to the evaluation frame stack
+// by their instruction handlers, and are evaluated iteratively by this loop,
+// nested expressions (TermArgs) and method invocations still cause native recursion.
 //
 _Success_( return )
 BOOLEAN
@@ -1542,9 +1692,9 @@ AmlEvalTermListCode(
     _In_    BOOLEAN    RestoreDataCursor
     )
 {
-    SIZE_T OldCursor;
-    SIZE_T OldSize;
-    SIZE_T OldDepth;
+    SIZE_T  OldDepth;
+    SIZE_T  BaseFrameDepth;
+    BOOLEAN Success;
 
     //
     // The given code block must be within the bounds of the input data.
@@ -1562,56 +1712,59 @@ AmlEvalTermListCode(
     }
 
     //
-    // Save old decoder cursor/window size before jumping to the given start offset, will be restored after executing the chunk of input code.
-    //
-    OldCursor = State->DataCursor;
-    OldSize = State->DataLength;
-    OldDepth = State->RecursionDepth;
-
-    //
-    // Move interpreter data window to input code block.
+    // Push the base frame of this evaluation loop, moves the interpreter data window to the input code block,
+    // the old decoder cursor/window size will be restored once the frame is popped.
     // Note: this may possibly allow data to be read below the code block,
     // as the lower bound of the interpreter window is currently always 0, but never out of bounds.
     //
-    State->DataCursor = CodeStart;
-    State->DataLength = ( CodeStart + CodeSize );
+    BaseFrameDepth = State->EvalFrameDepth;
+    if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_TERM_LIST, CodeStart, CodeSize, RestoreDataCursor ) == NULL ) {
+        return AML_FALSE;
+    }
+    OldDepth = State->RecursionDepth;
     State->RecursionDepth += 1;
 
     //
-    // Recursively execute terms until we reach the end of the input code block.
+    // Execute terms until the base frame of this loop has been popped.
     //
-    while( State->DataCursor < State->DataLength ) {
+    Success = AML_TRUE;
+    while( State->EvalFrameDepth > BaseFrameDepth ) {
         //
-        // If we are within an interruptible code block, stop executing if we hit an interruption event,
-        // so that the outer caller can handle the event accordingly.
+        // If we have reached the end of the current frame, or hit an interruption event, complete the frame,
+        // any interruption event will be passed on to the outer frames until handled by the intended frame.
         // TODO: While loop events are per-method, a call to a method containing a break inside of a while loop
         // should not cause the outer while loop to break!
         //
-        if( State->PendingInterruptionEvent != AML_INTERRUPTION_EVENT_NONE ) {
-            break;
+        if( ( State->DataCursor >= State->DataLength )
+            || ( State->PendingInterruptionEvent != AML_INTERRUPTION_EVENT_NONE ) )
+        {
+            if( ( Success = AmlEvalFrameComplete( State ) ) == AML_FALSE ) {
+                break;
+            }
+            continue;
         }
 
         //
-        // Process/evaluate the next term.
+        // Process/evaluate the next term, may push a new frame for a nested block.
         //
         if( State->PassType == AML_PASS_TYPE_NAMESPACE ) {
-            if( AmlEvalTermNamespacePass( State ) == AML_FALSE ) {
-                return AML_FALSE;
-            }
-        } else if( AmlEvalTerm( State ) == AML_FALSE ) {
-            return AML_FALSE;
+            Success = AmlEvalTermNamespacePass( State );
+        } else {
+            Success = AmlEvalTerm( State );
+        }
+        if( Success == AML_FALSE ) {
+            break;
         }
     }
 
     //
-    // Restore old interpreter data window.
+    // Release any frames left over from a failed evaluation.
     //
-    if( RestoreDataCursor ) {
-        State->DataCursor = OldCursor;
+    if( Success == AML_FALSE ) {
+        AmlEvalFrameUnwind( State, BaseFrameDepth );
     }
-    State->DataLength = OldSize; 
     State->RecursionDepth = OldDepth;
-    return AML_TRUE;
+    return Success;
 }
 
 //
@@ -1708,6 +1861,17 @@ AmlEvalLoadedTableCode(
 {
     UINT8                           i;
     AML_REGION_ACCESS_REGISTRATION* Handler;
+    AML_NAME_CACHE*                 OldNameCache;
+    AML_NAME_CACHE*                 TableNameCache;
+    AML_SKIP_INDEX*                 OldSkipIndex;
+    AML_SKIP_INDEX*                 TableSkipIndex;
+    BOOLEAN                         Success;
+
+    //
+    // Invalidate all memoized identification method results, and all cached PCI region topology.
+    //
+    State->IdentificationCacheGeneration++;
+    AmlPciTopologyCacheInvalidate( &State->PciTopology );
 
     //
     // Since we are switching the decoder to use a new block of code,
@@ -1719,10 +1883,43 @@ AmlEvalLoadedTableCode(
         return AML_FALSE;
     }
 
+    //
+    // Use a call site name resolution cache for the table code while it is being loaded (if enabled).
+    // The cache is only needed for the duration of the load, methods of the table have their own caches.
+    //
+    OldNameCache = State->NameCache;
+    TableNameCache = NULL;
+    if( State->UseNameResolutionCache ) {
+        TableNameCache = AmlNameCacheCreate( &State->Heap, TableCode, 0, TableCodeSize );
+    }
+
+    //
+    // Record the named object definitions decoded by the namespace pass of this table (if enabled),
+    // allows the full pass to skip decoding them again. Every load (including Load/LoadTable) builds its own index,
+    // as the namespace pass decoding of a table may depend on the state of the namespace at the time of the load.
+    //
+    OldSkipIndex = State->SkipIndex;
+    TableSkipIndex = NULL;
+    if( State->UseNamespaceSkipIndex ) {
+        TableSkipIndex = AmlSkipIndexCreate( &State->Heap, &State->Namespace, TableCode );
+    }
+
     //
     // Attempt to execute the actual table code, restore state upon success, rollback certain changes upon failure.
     //
-    if( AmlEvalLoadedTableCodeInternal( State, TableCode, TableCodeSize, TableRootPath ) == AML_FALSE ) {
+    State->NameCache = TableNameCache;
+    State->SkipIndex = TableSkipIndex;
+    Success = AmlEvalLoadedTableCodeInternal( State, TableCode, TableCodeSize, TableRootPath );
+    State->NameCache = OldNameCache;
+    State->SkipIndex = OldSkipIndex;
+    AmlNameCacheFree( TableNameCache );
+    if( TableSkipIndex != NULL ) {
+        State->SkipIndexStatistics.EntryCount += TableSkipIndex->Statistics.EntryCount;
+        State->SkipIndexStatistics.HitCount   += TableSkipIndex->Statistics.HitCount;
+        State->SkipIndexStatistics.MissCount  += TableSkipIndex->Statistics.MissCount;
+        AmlSkipIndexFree( TableSkipIndex );
+    }
+    if( Success == AML_FALSE ) {
         AmlStateSnapshotRollback( State );
         return AML_FALSE;
     }
@@ -1758,6 +1955,116 @@ AmlEvalLoadedTableCode(
     return AML_TRUE;
 }
 
+//
+// Local names of the identification methods that are memoized if found to be pure.
+//
+static const AML_NAME_SEG AmlIdentificationMethodNames[ ] = {
+    { .Data = { '_', 'H', 'I', 'D' } },
+    { .Data = { '_', 'C', 'I', 'D' } },
+    { .Data = { '_', 'U', 'I', 'D' } },
+    { .Data = { '_', 'A', 'D', 'R' } },
+    { .Data = { '_', 'S', 'U', 'N' } },
+};
+
+//
+// Copy a memoized identification method result, only integer, string, and buffer results are memoized.
+// Strings and buffers are deep-copied, the memoized result is never shared with the caller.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlEvalCopyIdentificationResult(
+    _Inout_ AML_HEAP*       Heap,
+    _In_    const AML_DATA* Source,
+    _Out_   AML_DATA*       Output
+    )
+{
+    AML_BUFFER_DATA* Buffer;
+
+    switch( Source->Type ) {
+    case AML_DATA_TYPE_INTEGER:
+        *Output = *Source;
+        return AML_TRUE;
+    case AML_DATA_TYPE_STRING:
+    case AML_DATA_TYPE_BUFFER:
+        if( Source->u.Buffer->Size > Source->u.Buffer->MaxSize ) {
+            return AML_FALSE;
+        } else if( ( Buffer = AmlBufferDataCreate( Heap, Source->u.Buffer->Size, Source->u.Buffer->Size ) ) == NULL ) {
+            return AML_FALSE;
+        }
+        if( Buffer->Size != 0 ) {
+            AML_MEMCPY( Buffer->Data, Source->u.Buffer->Data, Buffer->Size );
+        }
+        *Output = ( AML_DATA ){ .Type = Source->Type, .u.Buffer = Buffer };
+        return AML_TRUE;
+    default:
+        return AML_FALSE;
+    }
+}
+
+//
+// Invoke the given argument-less method object.
+// The results of pure identification methods (_HID, _CID, _UID, _ADR, _SUN) are memoized on the method object (if enabled),
+// memoized results remain valid until the next table load.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlEvalMethodObject(
+    _Inout_ AML_STATE*  State,
+    _Inout_ AML_OBJECT* Object,
+    _Out_   AML_DATA*   Result
+    )
+{
+    AML_OBJECT_METHOD* Method;
+    SIZE_T             i;
+
+    //
+    // Only identification methods are considered for memoization.
+    //
+    Method = &Object->u.Method;
+    if( ( State->UseIdentificationCache == AML_FALSE ) || ( Object->NamespaceNode == NULL ) ) {
+        return AmlMethodInvoke( State, Object, 0, NULL, 0, Result );
+    }
+    for( i = 0; i < AML_COUNTOF( AmlIdentificationMethodNames ); i++ ) {
+        if( Object->NamespaceNode->LocalName.AsUInt32 == AmlIdentificationMethodNames[ i ].AsUInt32 ) {
+            break;
+        }
+    }
+    if( i >= AML_COUNTOF( AmlIdentificationMethodNames ) ) {
+        return AmlMethodInvoke( State, Object, 0, NULL, 0, Result );
+    }
+
+    //
+    // Return a copy of the memoized result if it is still valid.
+    //
+    if( Method->HasCachedResult && ( Method->CachedResultGeneration == State->IdentificationCacheGeneration ) ) {
+        if( AmlEvalCopyIdentificationResult( &State->Heap, &Method->CachedResult, Result ) ) {
+            State->IdentificationCacheHitCount++;
+            return AML_TRUE;
+        }
+    }
+
+    //
+    // Invoke the method, and memoize the result if the method is pure.
+    //
+    State->IdentificationCacheMissCount++;
+    if( AmlMethodInvoke( State, Object, 0, NULL, 0, Result ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlMethodIsPure( State, Object ) == AML_FALSE ) {
+        return AML_TRUE;
+    }
+    if( Method->HasCachedResult ) {
+        AmlDataFree( &Method->CachedResult );
+        Method->HasCachedResult = AML_FALSE;
+    }
+    if( AmlEvalCopyIdentificationResult( &State->Heap, Result, &Method->CachedResult ) ) {
+        Method->HasCachedResult        = AML_TRUE;
+        Method->CachedResultGeneration = State->IdentificationCacheGeneration;
+    }
+    return AML_TRUE;
+}
+
 //
 // Attempt to evaluate the given object to data.
 // If ToPrimitive is set, we will attempt to resolve the data to its lowest primitive value,
@@ -1784,28 +2091,8 @@ AmlEvalObject(
     }
 
     //
-    // If this is a named object, just return the value as is.
-    // Other than named values and methods, only fields need special handling.
-    //
-    if( Object->Type == AML_OBJECT_TYPE_NAME ) {
-        if( AmlDataDuplicate( &Object->u.Name.Value, &State->Heap, &Result ) == AML_FALSE ) {
-            return AML_FALSE;
-        }
-    }
-
-    //
-    // If the object is a method, we can call it if it has no arguments,
-    // for example: _ADR, things that can be a value or method returning a value).
-    //
-    if( Object->Type == AML_OBJECT_TYPE_METHOD ) {
-        if( Object->u.Method.ArgumentCount != 0 ) {
-            return AML_FALSE;
-        } else if( AmlMethodInvoke( State, Object, 0, NULL, 0, &Result ) == AML_FALSE ) {
-            return AML_FALSE;
-        }
-    }
-
-    //
+    // Named objects are returned as is, methods can be called if they have no arguments
+    // (for example: _ADR, things that can be a value or method returning a value).
     // Special case for field objects, convert them to a plain data reference and try to evaluate the underlying value.
     //
     switch( Object->Type ) {
@@ -1817,7 +2104,7 @@ AmlEvalObject(
     case AML_OBJECT_TYPE_METHOD:
         if( Object->u.Method.ArgumentCount != 0 ) {
             return AML_FALSE;
-        } else if( AmlMethodInvoke( State, Object, 0, NULL, 0, &Result ) == AML_FALSE ) {
+        } else if( AmlEvalMethodObject( State, Object, &Result ) == AML_FALSE ) {
             return AML_FALSE;
         }
         break;
@@ -2012,8 +2299,17 @@ AmlEvalNodeChildZ(
 {
     AML_ARENA_SNAPSHOT Snapshot;
     AML_NAME_STRING    Name;
+    AML_NAME_SEG       Segment;
     BOOLEAN            Success;
 
+    //
+    // Single name segment paths don't require any allocations.
+    //
+    if( AmlPathStringZToNameSeg( ChildName, &Segment ) ) {
+        Name = ( AML_NAME_STRING ){ .Segments = &Segment, .SegmentCount = 1 };
+        return AmlEvalNodeChild( State, Node, &Name, TypeRequirement, SearchAncestors, ToPrimitive, Result );
+    }
+
     //
     // Attempt to parse a null-terminated path string to an AML_NAME_STRING and search like normal.
     // TODO: Use separate TempArena instead of the namespace one.
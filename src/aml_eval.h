@@ -11,12 +11,25 @@
  #define AML_OS_NAME "Microsoft Windows NT"
 #endif
 
+//
+// Dispatch instructions to their opcode class handlers using computed goto (labels as values) if supported by the compiler,
+// otherwise an indexed switch is used. May be disabled by defining AML_BUILD_COMPUTED_GOTO as 0.
+//
+#ifndef AML_BUILD_COMPUTED_GOTO
+ #if defined(__GNUC__)
+  #define AML_BUILD_COMPUTED_GOTO 1
+ #else
+  #define AML_BUILD_COMPUTED_GOTO 0
+ #endif
+#endif
+
 //
 // Special semantics for TermArg evaluation.
 //
 #define AML_EVAL_TERM_ARG_FLAG_NONE       0
 #define AML_EVAL_TERM_ARG_FLAG_IS_DEREFOF (1 << 0)
 #define AML_EVAL_TERM_ARG_FLAG_TEMP       (1 << 1)
+#define AML_EVAL_TERM_ARG_FLAG_PRIVATIZE  (1 << 2) /* Data of a named object may be modified through the result. */
 
 //
 // Evaluates a separate table data block and loads it to the namespace.
@@ -146,12 +159,14 @@ AmlEvalRefOf(
 // Evaluate DerefOf instruction to an object.
 // DefDerefOf := DerefOfOp ObjReference
 // ObjReference := TermArg => ObjectReference | String
+// NameFlags apply to the resolution of a String ObjReference.
 //
 _Success_( return )
 BOOLEAN
 AmlEvalDerefOf(
     _Inout_  AML_STATE*   State,
     _In_     BOOLEAN      ConsumeOpcode,
+    _In_     UINT         NameFlags,
     _Outptr_ AML_OBJECT** ppObject
     );
 
@@ -0,0 +1,429 @@
+#include "aml_eval_async.h"
+#include "aml_state.h"
+#include "aml_eval.h"
+#include "aml_host.h"
+#include "aml_debug.h"
+
+//
+// Get the asynchronous evaluation that is currently executing within the state, if any.
+//
+static
+AML_EVAL_ASYNC*
+AmlEvalAsyncGetActive(
+    _In_ const AML_STATE* State
+    )
+{
+    return ( ( State->ActiveContext != NULL ) ? State->ActiveContext->AsyncEvaluation : NULL );
+}
+
+//
+// Get the monotonic timer deadline of a wait with the given timeout, UINT64_MAX if there is no timeout.
+//
+static
+UINT64
+AmlEvalAsyncDeadline(
+    _Inout_ AML_STATE* State,
+    _In_    UINT64     TimeoutMs,
+    _In_    BOOLEAN    IsInfiniteAllowed
+    )
+{
+    UINT64 Now;
+
+    if( IsInfiniteAllowed && ( TimeoutMs >= 0xFFFF ) ) {
+        return UINT64_MAX;
+    }
+    Now = AmlHostMonotonicTimer( State->Host );
+    return ( Now + AML_MIN( ( TimeoutMs * 10000 ), ( UINT64_MAX - 1 - Now ) ) );
+}
+
+//
+// Suspend the given (currently executing) asynchronous evaluation until it is resumed by the host.
+// Leaves the execution context of the evaluation while suspended, allowing other contexts to run.
+//
+static
+VOID
+AmlEvalAsyncSuspend(
+    _Inout_ AML_EVAL_ASYNC*           Evaluation,
+    _In_    const AML_WAIT_CONDITION* Condition
+    )
+{
+    AML_EXECUTION_CONTEXT* Context;
+
+    Evaluation->WaitCondition = *Condition;
+    Context = AmlExecutionContextSuspend( Evaluation->Context.State );
+    Evaluation->Routines.Yield( Evaluation->Routines.Context, Evaluation->Coroutine );
+    AmlExecutionContextResume( Context );
+    Evaluation->WaitCondition = ( AML_WAIT_CONDITION ){ .Type = AML_WAIT_CONDITION_TYPE_NONE };
+}
+
+//
+// Coroutine entry routine of an asynchronous evaluation.
+// Evaluates the object within the execution context of the evaluation, then yields back to the host for the last time.
+//
+static
+VOID
+AmlEvalAsyncEntry(
+    _Inout_ VOID* EntryContext
+    )
+{
+    AML_EVAL_ASYNC* Evaluation;
+    AML_STATE*      State;
+    AML_DATA        Result;
+    BOOLEAN         Success;
+
+    Evaluation = EntryContext;
+    State = Evaluation->Context.State;
+
+    //
+    // The evaluation can't be backed out of once it has been started, the context must be entered.
+    //
+    AmlExecutionContextResume( &Evaluation->Context );
+    Success = AmlEvalObject( State, Evaluation->Object, &Result, Evaluation->ToPrimitive );
+    Evaluation->Status = ( Success ? AML_EVAL_ASYNC_STATUS_COMPLETED : AML_EVAL_ASYNC_STATUS_FAILED );
+    if( Evaluation->CompletionRoutine != NULL ) {
+        Evaluation->CompletionRoutine( Evaluation->CompletionContext, State, Evaluation, ( Success ? &Result : NULL ) );
+    }
+    if( Success ) {
+        AmlDataFree( &Result );
+    }
+    AmlExecutionContextLeave( &Evaluation->Context );
+
+    //
+    // The finished coroutine is freed by the host thread that has resumed it.
+    //
+    for( ;; ) {
+        Evaluation->Routines.Yield( Evaluation->Routines.Context, Evaluation->Coroutine );
+    }
+}
+
+//
+// Initialize an asynchronous evaluation for the given state, creates the execution context of the evaluation.
+// The given storage must remain valid until the evaluation is freed.
+//
+_Success_( return )
+BOOLEAN
+AmlEvalAsyncInitialize(
+    _Out_   AML_EVAL_ASYNC*               Evaluation,
+    _Inout_ struct _AML_STATE*            State,
+    _In_    const AML_COROUTINE_ROUTINES* Routines
+    )
+{
+    *Evaluation = ( AML_EVAL_ASYNC ){ .Routines = *Routines, .Status = AML_EVAL_ASYNC_STATUS_IDLE };
+    if( AmlExecutionContextInitialize( &Evaluation->Context, State ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    Evaluation->Context.AsyncEvaluation = Evaluation;
+    return AML_TRUE;
+}
+
+//
+// Release all resources of the given asynchronous evaluation, the evaluation must not be pending.
+//
+VOID
+AmlEvalAsyncFree(
+    _Inout_ _Post_invalid_ AML_EVAL_ASYNC* Evaluation
+    )
+{
+    if( Evaluation->Status == AML_EVAL_ASYNC_STATUS_PENDING ) {
+        AML_DEBUG_PANIC( Evaluation->Context.State, "Fatal: Freeing a pending asynchronous evaluation!" );
+        return;
+    }
+    AmlExecutionContextFree( &Evaluation->Context );
+    AML_MEMSET( Evaluation, 0, sizeof( *Evaluation ) );
+}
+
+//
+// Begin asynchronous evaluation of the given object (see AmlEvalObject), the object must remain valid until completion.
+// Runs the evaluation until it either finishes or is suspended, returns AML_EVAL_ASYNC_STATUS_PENDING if suspended,
+// the host must then call AmlEvalAsyncResume once the wake condition of the evaluation is met.
+// Returns AML_EVAL_ASYNC_STATUS_FAILED without calling the completion routine if the evaluation couldn't be started.
+// A finished evaluation may be reused to begin another evaluation.
+// Must not be called from within an entered execution context.
+//
+AML_EVAL_ASYNC_STATUS
+AmlEvalObjectAsync(
+    _Inout_     AML_EVAL_ASYNC*                   Evaluation,
+    _Inout_     struct _AML_OBJECT*               Object,
+    _In_        BOOLEAN                           ToPrimitive,
+    _In_opt_    AML_EVAL_ASYNC_COMPLETION_ROUTINE CompletionRoutine,
+    _Inout_opt_ VOID*                             CompletionContext
+    )
+{
+    if( Evaluation->Status == AML_EVAL_ASYNC_STATUS_PENDING ) {
+        AML_DEBUG_ERROR( Evaluation->Context.State, "Error: Asynchronous evaluation is already pending!\n" );
+        return AML_EVAL_ASYNC_STATUS_FAILED;
+    }
+
+    //
+    // Set up the evaluation and create the coroutine that it runs on.
+    //
+    Evaluation->Object                  = Object;
+    Evaluation->ToPrimitive             = ToPrimitive;
+    Evaluation->CompletionRoutine       = CompletionRoutine;
+    Evaluation->CompletionContext       = CompletionContext;
+    Evaluation->WaitCondition           = ( AML_WAIT_CONDITION ){ .Type = AML_WAIT_CONDITION_TYPE_NONE };
+    Evaluation->IsRegionAccessPending   = AML_FALSE;
+    Evaluation->IsRegionAccessCompleted = AML_FALSE;
+    Evaluation->Coroutine = Evaluation->Routines.Create( Evaluation->Routines.Context, AmlEvalAsyncEntry, Evaluation );
+    if( Evaluation->Coroutine == NULL ) {
+        Evaluation->Status = AML_EVAL_ASYNC_STATUS_FAILED;
+        return Evaluation->Status;
+    }
+
+    //
+    // Run the evaluation until it finishes or is first suspended.
+    //
+    Evaluation->Status = AML_EVAL_ASYNC_STATUS_PENDING;
+    return AmlEvalAsyncResume( Evaluation );
+}
+
+//
+// Resume a pending asynchronous evaluation, runs it until it either finishes or is suspended again.
+// Must not be called from within an entered execution context, the host must serialize all use of the state between threads.
+//
+AML_EVAL_ASYNC_STATUS
+AmlEvalAsyncResume(
+    _Inout_ AML_EVAL_ASYNC* Evaluation
+    )
+{
+    if( Evaluation->Status != AML_EVAL_ASYNC_STATUS_PENDING ) {
+        return Evaluation->Status;
+    }
+
+    //
+    // The evaluation can't be resumed while another execution context of the state is entered, it is left pending.
+    //
+    if( Evaluation->Context.State->ActiveContext != NULL ) {
+        AML_DEBUG_ERROR( Evaluation->Context.State, "Error: Resuming an asynchronous evaluation within an entered execution context!\n" );
+        return Evaluation->Status;
+    }
+
+    //
+    // Switch to the coroutine of the evaluation, it only yields back once it has left its execution context.
+    // The coroutine of a finished evaluation has yielded for the last time, and can be freed.
+    //
+    Evaluation->Routines.Resume( Evaluation->Routines.Context, Evaluation->Coroutine );
+    if( Evaluation->Status != AML_EVAL_ASYNC_STATUS_PENDING ) {
+        Evaluation->Routines.Free( Evaluation->Routines.Context, Evaluation->Coroutine );
+        Evaluation->Coroutine = NULL;
+    }
+    return Evaluation->Status;
+}
+
+//
+// Called by a region access handler to complete the current access asynchronously.
+// Returns the asynchronous evaluation performing the access, the handler must then return success,
+// the evaluation is suspended (with a region wait condition) once the handler returns.
+// Before resuming the evaluation, the host must fill in the access data (for reads),
+// and complete the access using AmlEvalAsyncCompleteRegionAccess.
+// Returns NULL if the access isn't performed by an asynchronous evaluation, the access must then be completed synchronously.
+//
+_Success_( return != NULL )
+AML_EVAL_ASYNC*
+AmlEvalAsyncPendRegionAccess(
+    _Inout_ struct _AML_STATE* State
+    )
+{
+    AML_EVAL_ASYNC* Evaluation;
+
+    if( ( Evaluation = AmlEvalAsyncGetActive( State ) ) == NULL ) {
+        return NULL;
+    }
+    Evaluation->IsRegionAccessPending   = AML_TRUE;
+    Evaluation->IsRegionAccessCompleted = AML_FALSE;
+    return Evaluation;
+}
+
+//
+// Complete a region access previously pended using AmlEvalAsyncPendRegionAccess.
+//
+VOID
+AmlEvalAsyncCompleteRegionAccess(
+    _Inout_ AML_EVAL_ASYNC* Evaluation,
+    _In_    BOOLEAN         Success
+    )
+{
+    Evaluation->RegionAccessSuccess     = Success;
+    Evaluation->IsRegionAccessCompleted = AML_TRUE;
+}
+
+//
+// Await the completion of the region access that was just serviced by a region access handler, if it has been pended.
+// Returns the final success of the access (the given handler result if the access wasn't pended).
+//
+_Success_( return )
+BOOLEAN
+AmlEvalAsyncRegionAccessAwait(
+    _Inout_ struct _AML_STATE*           State,
+    _In_    AML_OBJECT_OPERATION_REGION* Region,
+    _In_    BOOLEAN                      HandlerSuccess
+    )
+{
+    AML_EVAL_ASYNC* Evaluation;
+
+    //
+    // Common case, the access has been completed synchronously by the handler.
+    //
+    Evaluation = AmlEvalAsyncGetActive( State );
+    if( ( Evaluation == NULL ) || ( Evaluation->IsRegionAccessPending == AML_FALSE ) ) {
+        return HandlerSuccess;
+    }
+
+    //
+    // Suspend the evaluation until the host has completed the pended access.
+    //
+    Evaluation->IsRegionAccessPending = AML_FALSE;
+    if( HandlerSuccess == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    while( Evaluation->IsRegionAccessCompleted == AML_FALSE ) {
+        AmlEvalAsyncSuspend( Evaluation, &( AML_WAIT_CONDITION ){
+            .Type     = AML_WAIT_CONDITION_TYPE_REGION,
+            .Deadline = UINT64_MAX,
+            .Region   = Region
+        } );
+    }
+    Evaluation->IsRegionAccessCompleted = AML_FALSE;
+    return Evaluation->RegionAccessSuccess;
+}
+
+//
+// Implements the sleep instruction.
+// Suspends the active asynchronous evaluation until the deadline has passed,
+// otherwise sleeps using AmlHostSleep (other execution contexts may run in the meantime).
+//
+VOID
+AmlEvalAsyncSleep(
+    _Inout_ struct _AML_STATE* State,
+    _In_    UINT64             Milliseconds
+    )
+{
+    AML_EVAL_ASYNC*        Evaluation;
+    AML_EXECUTION_CONTEXT* Context;
+    UINT64                 Deadline;
+
+    //
+    // Regular evaluation, block the current host thread.
+    //
+    if( ( Evaluation = AmlEvalAsyncGetActive( State ) ) == NULL ) {
+        Context = AmlExecutionContextSuspend( State );
+        AmlHostSleep( State->Host, Milliseconds );
+        AmlExecutionContextResume( Context );
+        return;
+    }
+
+    //
+    // Always yield at least once, a sleep relinquishes the processor even if the time has already passed.
+    //
+    Deadline = AmlEvalAsyncDeadline( State, Milliseconds, AML_FALSE );
+    do {
+        AmlEvalAsyncSuspend( Evaluation, &( AML_WAIT_CONDITION ){
+            .Type     = AML_WAIT_CONDITION_TYPE_SLEEP,
+            .Deadline = Deadline
+        } );
+    } while( AmlHostMonotonicTimer( State->Host ) < Deadline );
+}
+
+//
+// Await signal of the given event object (see AmlHostEventAwait).
+// Suspends the active asynchronous evaluation while the event isn't signaled,
+// otherwise waits using AmlHostEventAwait (other execution contexts may run in the meantime).
+//
+AML_WAIT_STATUS
+AmlEvalAsyncEventAwait(
+    _Inout_ struct _AML_STATE*      State,
+    _In_    const AML_OBJECT_EVENT* Event,
+    _In_    UINT64                  TimeoutMs
+    )
+{
+    AML_EVAL_ASYNC*        Evaluation;
+    AML_EXECUTION_CONTEXT* Context;
+    AML_WAIT_STATUS        WaitStatus;
+    UINT64                 Deadline;
+
+    //
+    // Regular evaluation, block the current host thread.
+    //
+    if( ( Evaluation = AmlEvalAsyncGetActive( State ) ) == NULL ) {
+        Context = AmlExecutionContextSuspend( State );
+        WaitStatus = AmlHostEventAwait( Event->Host, Event->HostHandle, TimeoutMs, Event->Counter );
+        AmlExecutionContextResume( Context );
+        return WaitStatus;
+    }
+
+    //
+    // Poll the event, and suspend the evaluation until it may have been signaled (or the timeout has expired).
+    // The counter of the event object is updated by other evaluations while suspended.
+    //
+    Deadline = AmlEvalAsyncDeadline( State, TimeoutMs, AML_TRUE );
+    for( ;; ) {
+        WaitStatus = AmlHostEventAwait( Event->Host, Event->HostHandle, 0, Event->Counter );
+        if( WaitStatus != AML_WAIT_STATUS_TIMEOUT ) {
+            return WaitStatus;
+        } else if( AmlHostMonotonicTimer( State->Host ) >= Deadline ) {
+            return AML_WAIT_STATUS_TIMEOUT;
+        }
+        AmlEvalAsyncSuspend( Evaluation, &( AML_WAIT_CONDITION ){
+            .Type       = AML_WAIT_CONDITION_TYPE_EVENT,
+            .Deadline   = Deadline,
+            .Host       = Event->Host,
+            .HostHandle = Event->HostHandle
+        } );
+    }
+}
+
+//
+// Acquire an internal OS mutex object (see AmlHostMutexAcquire).
+// Suspends the active asynchronous evaluation while the mutex is owned,
+// otherwise waits using AmlHostMutexAcquire (other execution contexts may run in the meantime if the mutex is owned).
+//
+AML_WAIT_STATUS
+AmlEvalAsyncMutexAcquire(
+    _Inout_ struct _AML_STATE* State,
+    _In_    UINT64             MutexHandle,
+    _In_    UINT64             TimeoutMs
+    )
+{
+    AML_EVAL_ASYNC*        Evaluation;
+    AML_EXECUTION_CONTEXT* Context;
+    AML_WAIT_STATUS        WaitStatus;
+    UINT64                 Deadline;
+
+    //
+    // Regular evaluation (or a non-blocking attempt), block the current host thread.
+    // The context is kept entered (and its blocking lock held) if the mutex isn't owned, so that other execution contexts are only interleaved at
+    // operations that actually block, non-serialized methods that merely access fields with the Lock rule (_GL)
+    // must not be re-entered by another context halfway through (they commonly update shared named objects).
+    // Otherwise, other execution contexts may run while waiting, the owner of the mutex may need to run to release it.
+    //
+    Evaluation = AmlEvalAsyncGetActive( State );
+    if( ( Evaluation == NULL ) || ( TimeoutMs == 0 ) ) {
+        WaitStatus = AmlHostMutexAcquire( State->Host, MutexHandle, 0 );
+        if( ( WaitStatus != AML_WAIT_STATUS_TIMEOUT ) || ( TimeoutMs == 0 ) ) {
+            return WaitStatus;
+        }
+        Context = AmlExecutionContextSuspend( State );
+        WaitStatus = AmlHostMutexAcquire( State->Host, MutexHandle, TimeoutMs );
+        AmlExecutionContextResume( Context );
+        return WaitStatus;
+    }
+
+    //
+    // Attempt to acquire the mutex, and suspend the evaluation until it may have been released (or the timeout has expired).
+    //
+    Deadline = AmlEvalAsyncDeadline( State, TimeoutMs, AML_TRUE );
+    for( ;; ) {
+        WaitStatus = AmlHostMutexAcquire( State->Host, MutexHandle, 0 );
+        if( WaitStatus != AML_WAIT_STATUS_TIMEOUT ) {
+            return WaitStatus;
+        } else if( AmlHostMonotonicTimer( State->Host ) >= Deadline ) {
+            return AML_WAIT_STATUS_TIMEOUT;
+        }
+        AmlEvalAsyncSuspend( Evaluation, &( AML_WAIT_CONDITION ){
+            .Type       = AML_WAIT_CONDITION_TYPE_MUTEX,
+            .Deadline   = Deadline,
+            .Host       = State->Host,
+            .HostHandle = MutexHandle
+        } );
+    }
+}
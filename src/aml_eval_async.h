@@ -0,0 +1,257 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_host.h"
+#include "aml_object.h"
+#include "aml_execution_context.h"
+
+//
+// Type of condition that a suspended asynchronous evaluation is waiting on.
+//
+typedef enum _AML_WAIT_CONDITION_TYPE {
+    AML_WAIT_CONDITION_TYPE_NONE,
+    AML_WAIT_CONDITION_TYPE_SLEEP,  /* Sleep until the deadline has passed. */
+    AML_WAIT_CONDITION_TYPE_EVENT,  /* Signal of the host event object, or the deadline. */
+    AML_WAIT_CONDITION_TYPE_MUTEX,  /* Release of the host mutex object, or the deadline. */
+    AML_WAIT_CONDITION_TYPE_REGION, /* Completion of a pending region access (AmlEvalAsyncCompleteRegionAccess). */
+} AML_WAIT_CONDITION_TYPE;
+
+//
+// Wake condition of a suspended asynchronous evaluation.
+// The deadline is an AmlHostMonotonicTimer value, UINT64_MAX if the wait has no timeout.
+// Resuming an evaluation before its condition is met is allowed, the blocked operation is retried,
+// and the evaluation is suspended again if the operation still can't make progress.
+//
+typedef struct _AML_WAIT_CONDITION {
+    AML_WAIT_CONDITION_TYPE      Type;
+    UINT64                       Deadline;
+    AML_HOST_CONTEXT*            Host;       /* Event and mutex conditions. */
+    UINT64                       HostHandle; /* Event and mutex conditions. */
+    AML_OBJECT_OPERATION_REGION* Region;     /* Region conditions. */
+} AML_WAIT_CONDITION;
+
+//
+// Coroutine entry routine, never returns (a finished coroutine yields for the last time, and is then freed).
+//
+typedef
+VOID
+( *AML_COROUTINE_ENTRY )(
+    _Inout_ VOID* EntryContext
+    );
+
+//
+// User-provided coroutine interface callback to create a new coroutine that runs the given entry routine upon first resume.
+//
+typedef
+_Success_( return != NULL )
+VOID*
+( *AML_COROUTINE_CREATE )(
+    _Inout_opt_ VOID*               Context,
+    _In_        AML_COROUTINE_ENTRY Entry,
+    _Inout_     VOID*               EntryContext
+    );
+
+//
+// User-provided coroutine interface callback to switch from the calling host thread into the given coroutine,
+// returns once the coroutine yields. A suspended coroutine may be resumed by a different thread than it was last resumed by.
+//
+typedef
+VOID
+( *AML_COROUTINE_RESUME )(
+    _Inout_opt_ VOID* Context,
+    _Inout_     VOID* Coroutine
+    );
+
+//
+// User-provided coroutine interface callback to switch from within the given coroutine back to the host thread that resumed it.
+//
+typedef
+VOID
+( *AML_COROUTINE_YIELD )(
+    _Inout_opt_ VOID* Context,
+    _Inout_     VOID* Coroutine
+    );
+
+//
+// User-provided coroutine interface callback to free a coroutine that has yielded for the last time.
+//
+typedef
+VOID
+( *AML_COROUTINE_FREE )(
+    _Inout_opt_            VOID* Context,
+    _Inout_ _Post_invalid_ VOID* Coroutine
+    );
+
+//
+// Host-provided coroutine (stackful fiber) interface, used to run asynchronous evaluations.
+//
+typedef struct _AML_COROUTINE_ROUTINES {
+    VOID*                Context;
+    AML_COROUTINE_CREATE Create;
+    AML_COROUTINE_RESUME Resume;
+    AML_COROUTINE_YIELD  Yield;
+    AML_COROUTINE_FREE   Free;
+} AML_COROUTINE_ROUTINES;
+
+//
+// Status of an asynchronous evaluation.
+//
+typedef enum _AML_EVAL_ASYNC_STATUS {
+    AML_EVAL_ASYNC_STATUS_IDLE,      /* Not started yet. */
+    AML_EVAL_ASYNC_STATUS_PENDING,   /* Suspended until its wake condition is met, must be resumed by the host. */
+    AML_EVAL_ASYNC_STATUS_COMPLETED, /* Finished successfully, the completion routine has been called. */
+    AML_EVAL_ASYNC_STATUS_FAILED,    /* Finished unsuccessfully, the completion routine has been called. */
+} AML_EVAL_ASYNC_STATUS;
+
+//
+// Completion routine of an asynchronous evaluation, called from within the entered execution context of the evaluation.
+// The result is NULL if the evaluation failed, and is only valid for the duration of the call.
+// The completion routine must not free or restart the evaluation.
+//
+typedef
+VOID
+( *AML_EVAL_ASYNC_COMPLETION_ROUTINE )(
+    _Inout_opt_ VOID*                   UserContext,
+    _Inout_     struct _AML_STATE*      State,
+    _Inout_     struct _AML_EVAL_ASYNC* Evaluation,
+    _In_opt_    const AML_DATA*         Result
+    );
+
+//
+// Resumable evaluation of an object.
+// Every evaluation runs on its own coroutine, within its own execution context of the shared state.
+// When the evaluation reaches an operation that would block (Sleep, Wait, Acquire, or a region access that the
+// region handler has pended), it leaves its execution context, and yields back to the host,
+// the host then resumes it (from any thread, serialized with all other use of the state) once its wake condition is met.
+// Host mutex objects acquired by AML code may be released by a different host thread than they were acquired by.
+//
+typedef struct _AML_EVAL_ASYNC {
+    AML_EXECUTION_CONTEXT             Context;
+    AML_COROUTINE_ROUTINES            Routines;
+    VOID*                             Coroutine;
+    AML_EVAL_ASYNC_STATUS             Status;
+    AML_WAIT_CONDITION                WaitCondition;
+    struct _AML_OBJECT*               Object;
+    BOOLEAN                           ToPrimitive;
+    AML_EVAL_ASYNC_COMPLETION_ROUTINE CompletionRoutine;
+    VOID*                             CompletionContext;
+    BOOLEAN                           IsRegionAccessPending;
+    BOOLEAN                           IsRegionAccessCompleted;
+    BOOLEAN                           RegionAccessSuccess;
+} AML_EVAL_ASYNC;
+
+//
+// Initialize an asynchronous evaluation for the given state, creates the execution context of the evaluation.
+// The given storage must remain valid until the evaluation is freed.
+//
+_Success_( return )
+BOOLEAN
+AmlEvalAsyncInitialize(
+    _Out_   AML_EVAL_ASYNC*               Evaluation,
+    _Inout_ struct _AML_STATE*            State,
+    _In_    const AML_COROUTINE_ROUTINES* Routines
+    );
+
+//
+// Release all resources of the given asynchronous evaluation, the evaluation must not be pending.
+//
+VOID
+AmlEvalAsyncFree(
+    _Inout_ _Post_invalid_ AML_EVAL_ASYNC* Evaluation
+    );
+
+//
+// Begin asynchronous evaluation of the given object (see AmlEvalObject), the object must remain valid until completion.
+// Runs the evaluation until it either finishes or is suspended, returns AML_EVAL_ASYNC_STATUS_PENDING if suspended,
+// the host must then call AmlEvalAsyncResume once the wake condition of the evaluation is met.
+// Returns AML_EVAL_ASYNC_STATUS_FAILED without calling the completion routine if the evaluation couldn't be started.
+// A finished evaluation may be reused to begin another evaluation.
+// Must not be called from within an entered execution context.
+//
+AML_EVAL_ASYNC_STATUS
+AmlEvalObjectAsync(
+    _Inout_     AML_EVAL_ASYNC*                   Evaluation,
+    _Inout_     struct _AML_OBJECT*               Object,
+    _In_        BOOLEAN                           ToPrimitive,
+    _In_opt_    AML_EVAL_ASYNC_COMPLETION_ROUTINE CompletionRoutine,
+    _Inout_opt_ VOID*                             CompletionContext
+    );
+
+//
+// Resume a pending asynchronous evaluation, runs it until it either finishes or is suspended again.
+// Must not be called from within an entered execution context, the host must serialize all use of the state between threads.
+//
+AML_EVAL_ASYNC_STATUS
+AmlEvalAsyncResume(
+    _Inout_ AML_EVAL_ASYNC* Evaluation
+    );
+
+//
+// Called by a region access handler to complete the current access asynchronously.
+// Returns the asynchronous evaluation performing the access, the handler must then return success,
+// the evaluation is suspended (with a region wait condition) once the handler returns.
+// Before resuming the evaluation, the host must fill in the access data (for reads),
+// and complete the access using AmlEvalAsyncCompleteRegionAccess.
+// Returns NULL if the access isn't performed by an asynchronous evaluation, the access must then be completed synchronously.
+//
+_Success_( return != NULL )
+AML_EVAL_ASYNC*
+AmlEvalAsyncPendRegionAccess(
+    _Inout_ struct _AML_STATE* State
+    );
+
+//
+// Complete a region access previously pended using AmlEvalAsyncPendRegionAccess.
+//
+VOID
+AmlEvalAsyncCompleteRegionAccess(
+    _Inout_ AML_EVAL_ASYNC* Evaluation,
+    _In_    BOOLEAN         Success
+    );
+
+//
+// Await the completion of the region access that was just serviced by a region access handler, if it has been pended.
+// Returns the final success of the access (the given handler result if the access wasn't pended).
+//
+_Success_( return )
+BOOLEAN
+AmlEvalAsyncRegionAccessAwait(
+    _Inout_ struct _AML_STATE*           State,
+    _In_    AML_OBJECT_OPERATION_REGION* Region,
+    _In_    BOOLEAN                      HandlerSuccess
+    );
+
+//
+// Implements the sleep instruction.
+// Suspends the active asynchronous evaluation until the deadline has passed,
+// otherwise sleeps using AmlHostSleep (other execution contexts may run in the meantime).
+//
+VOID
+AmlEvalAsyncSleep(
+    _Inout_ struct _AML_STATE* State,
+    _In_    UINT64             Milliseconds
+    );
+
+//
+// Await signal of the given event object (see AmlHostEventAwait).
+// Suspends the active asynchronous evaluation while the event isn't signaled,
+// otherwise waits using AmlHostEventAwait (other execution contexts may run in the meantime).
+//
+AML_WAIT_STATUS
+AmlEvalAsyncEventAwait(
+    _Inout_ struct _AML_STATE*      State,
+    _In_    const AML_OBJECT_EVENT* Event,
+    _In_    UINT64                  TimeoutMs
+    );
+
+//
+// Acquire an internal OS mutex object (see AmlHostMutexAcquire).
+// Suspends the active asynchronous evaluation while the mutex is owned,
+// otherwise waits using AmlHostMutexAcquire (other execution contexts may run in the meantime).
+//
+AML_WAIT_STATUS
+AmlEvalAsyncMutexAcquire(
+    _Inout_ struct _AML_STATE* State,
+    _In_    UINT64             MutexHandle,
+    _In_    UINT64             TimeoutMs
+    );
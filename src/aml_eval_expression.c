@@ -8,6 +8,7 @@
 #include "aml_field.h"
 #include "aml_compare.h"
 #include "aml_eval_expression.h"
+#include "aml_eval_async.h"
 
 //
 // Perform a single match instruction comparison using the given operator type.
@@ -803,7 +804,7 @@ AmlEvalObjectType(
             return AML_FALSE;
         }
     } else if( AmlDecoderMatchOpcode( State, AML_OPCODE_ID_DEREF_OF_OP, NULL ) ) {
-        if( AmlEvalDerefOf( State, AML_FALSE, &Object ) == AML_FALSE ) {
+        if( AmlEvalDerefOf( State, AML_FALSE, 0, &Object ) == AML_FALSE ) {
             return AML_FALSE;
         }
     } else if( AmlDecoderMatchOpcode( State, AML_OPCODE_ID_INDEX_OP, NULL ) ) {
@@ -996,7 +997,6 @@ AmlReadFromLoadSource(
     )
 {
     AML_OBJECT_OPERATION_REGION* OpRegion;
-    SIZE_T                       i;
     AML_BUFFER_DATA*             Buffer;
     SIZE_T                       ReadBitCount;
 
@@ -1010,20 +1010,8 @@ AmlReadFromLoadSource(
             return AML_FALSE;
         } else if( OpRegion->Length < ReadSize ) {
             return AML_FALSE;
-        }
-        for( i = 0; i < ReadSize; i++ ) {
-            if( AmlOperationRegionRead( State,
-                                        OpRegion,
-                                        NULL,
-                                        i,
-                                        AML_FIELD_ACCESS_TYPE_ANY_ACC,
-                                        0,
-                                        ( sizeof( UINT8 ) * CHAR_BIT ),
-                                        ( ( UINT8* )ReadData + i ),
-                                        sizeof( UINT8 ) ) == AML_FALSE )
-            {
-                return AML_FALSE;
-            }
+        } else if( AmlOperationRegionReadBlock( State, OpRegion, 0, ReadData, ReadSize ) == AML_FALSE ) {
+            return AML_FALSE;
         }
         break;
     case AML_OBJECT_TYPE_NAME:
@@ -1034,9 +1022,7 @@ AmlReadFromLoadSource(
         if( ( Buffer == NULL ) || ( Buffer->Size < ReadSize ) ) {
             return AML_FALSE;
         }
-        for( i = 0; i < ReadSize; i++ ) {
-            ( ( CHAR* )ReadData )[ i ] = Buffer->Data[ i ];
-        }
+        AML_MEMCPY( ReadData, Buffer->Data, ReadSize );
         break;
     case AML_OBJECT_TYPE_FIELD:
     case AML_OBJECT_TYPE_BANK_FIELD:
@@ -1073,6 +1059,7 @@ AmlEvalLoad(
     BOOLEAN                IsValidType;
     AML_DESCRIPTION_HEADER Header;
     VOID*                  TableData;
+    BOOLEAN                IsInPlace;
     SIZE_T                 CodeSize;
     const UINT8*           CodeData;
 
@@ -1152,21 +1139,34 @@ AmlEvalLoad(
     }
 
     //
-    // Allocate space for the entire definition block.
+    // Evaluate the definition block in place if it is entirely contained by the mapping of a direct access region,
+    // the region is referenced to keep its mapping alive for the lifetime of the loaded table (see UseInPlaceTableLoad).
     //
-    TableData = AmlHeapAllocate( &State->Heap, Header.Length );
-    if( TableData == NULL ) {
-        AML_DEBUG_ERROR( State, "Error: Failed to allocate memory for table in Load (size: 0x%x)\n", Header.Length );
-        return AML_FALSE;
-    }
+    IsInPlace = ( State->UseInPlaceTableLoad
+                  && ( Object->Type == AML_OBJECT_TYPE_OPERATION_REGION )
+                  && AmlOperationRegionIsDirectAccess( State, &Object->u.OpRegion )
+                  && ( Object->u.OpRegion.Length >= Header.Length ) );
+    if( IsInPlace ) {
+        AmlObjectReference( Object );
+        TableData = Object->u.OpRegion.MappedBase;
+    } else {
+        //
+        // Allocate space for the entire definition block.
+        //
+        TableData = AmlHeapAllocate( &State->Heap, Header.Length );
+        if( TableData == NULL ) {
+            AML_DEBUG_ERROR( State, "Error: Failed to allocate memory for table in Load (size: 0x%x)\n", Header.Length );
+            return AML_FALSE;
+        }
 
-    //
-    // Attempt to load the entire definition block from the source object.
-    //
-    if( AmlReadFromLoadSource( State, Object, TableData, Header.Length ) == AML_FALSE ) {
-        AML_DEBUG_ERROR( State, "Error: Failed to read entire table to memory in Load (size: 0x%x)\n", Header.Length );
-        AmlHeapFree( &State->Heap, TableData );
-        return AML_FALSE;
+        //
+        // Attempt to load the entire definition block from the source object.
+        //
+        if( AmlReadFromLoadSource( State, Object, TableData, Header.Length ) == AML_FALSE ) {
+            AML_DEBUG_ERROR( State, "Error: Failed to read entire table to memory in Load (size: 0x%x)\n", Header.Length );
+            AmlHeapFree( &State->Heap, TableData );
+            return AML_FALSE;
+        }
     }
 
     //
@@ -1178,7 +1178,11 @@ AmlEvalLoad(
         CodeData = ( ( const UINT8* )TableData + sizeof( Header ) );
         if( AmlEvalLoadedTableCode( State, CodeData, CodeSize, NULL ) == AML_FALSE ) {
             AML_DEBUG_ERROR( State, "Error: Failed to load table - OemID=%.6s\n", Header.OemId.Data );
-            AmlHeapFree( &State->Heap, TableData );
+            if( IsInPlace ) {
+                AmlObjectRelease( Object );
+            } else {
+                AmlHeapFree( &State->Heap, TableData );
+            }
             return AML_FALSE;
         }
     }
@@ -1287,14 +1291,19 @@ AmlEvalLoadTableInternal(
 
     //
     // Allocate space for the entire definition block, as the block must remain loaded for the lifetime of the interpreter.
-    // Copy all of the input table data into the persistent allocation for the table.
+    // Copy all of the input table data into the persistent allocation for the table,
+    // unless the host guarantees that its tables stay mapped and unmodified (see UseInPlaceTableLoad).
     // TODO: Code/table object system + allow unloading/releasing later.
     //
-    LoadedTable = AmlHeapAllocate( &State->Heap, InputTable->Length );
-    if( LoadedTable == NULL ) {
-        return AML_FALSE;
+    if( State->UseInPlaceTableLoad ) {
+        LoadedTable = InputTable;
+    } else {
+        LoadedTable = AmlHeapAllocate( &State->Heap, InputTable->Length );
+        if( LoadedTable == NULL ) {
+            return AML_FALSE;
+        }
+        AML_MEMCPY( LoadedTable, InputTable, InputTable->Length );
     }
-    AML_MEMCPY( LoadedTable, InputTable, InputTable->Length );
 
     //
     // Attempt to actually execute/evaluate the loaded table contents.
@@ -1311,7 +1320,9 @@ AmlEvalLoadTableInternal(
                 OemId->u.String->Data,
                 OemTableId->u.String->Data
             );
-            AmlHeapFree( &State->Heap, LoadedTable );
+            if( LoadedTable != InputTable ) {
+                AmlHeapFree( &State->Heap, LoadedTable );
+            }
         }
     }
 
@@ -1344,7 +1355,10 @@ AmlEvalLoadTableInternal(
                 }
             }
             if( AmlNamespaceSearch( &State->Namespace, NULL, &ParameterPathNameString, 0, &ParameterNsNode ) ) {
-                if( ( ParameterNsNode->Object != NULL ) && ( ParameterNsNode->Object->Type == AML_OBJECT_TYPE_NAME ) ) {
+                if( ( ParameterNsNode->Object != NULL )
+                    && ( ParameterNsNode->Object->Type == AML_OBJECT_TYPE_NAME )
+                    && AmlNamespacePrivatizeNode( &State->Namespace, ParameterNsNode ) )
+                {
                     AmlConvObjectStore( State, &State->Heap, ParameterData, &ParameterNsNode->Object->u.Name.Value, AML_CONV_FLAGS_IMPLICIT );
                 }
             }
@@ -1624,9 +1638,9 @@ AmlEvalExpressionOpcode(
         }
 
         //
-        // Attempt to await signalling of the given event.
+        // Attempt to await signalling of the given event, other execution contexts may run while waiting.
         //
-        WaitStatus = AmlHostEventAwait( SuperName->u.Event.Host, SuperName->u.Event.HostHandle, Operand1.u.Integer, SuperName->u.Event.Counter );
+        WaitStatus = AmlEvalAsyncEventAwait( State, &SuperName->u.Event, Operand1.u.Integer );
         if( WaitStatus == AML_WAIT_STATUS_ERROR ) {
             AmlObjectRelease( SuperName );
             return AML_FALSE;
@@ -1745,7 +1759,7 @@ AmlEvalExpressionOpcode(
         // Object can be any object type (for example, a package, a device object, and so on).
         // TODO: Replace this case with a call to AmlEvalRefOf!
         //
-        if( AmlEvalSuperName( State, 0, 0, &SuperName ) == AML_FALSE ) {
+        if( AmlEvalSuperName( State, 0, AML_NAME_FLAG_PRIVATIZE, &SuperName ) == AML_FALSE ) {
             return AML_FALSE;
         }
 
@@ -1768,7 +1782,7 @@ AmlEvalExpressionOpcode(
         // The Source of this operation can be any object type (for example, data package, device object, and so on),
         // and the result data is optionally stored into the result target.
         //
-        if( AmlEvalSuperName( State, 0, AML_NAME_FLAG_ALLOW_NON_EXISTENT, &SuperName ) == AML_FALSE ) {
+        if( AmlEvalSuperName( State, 0, ( AML_NAME_FLAG_ALLOW_NON_EXISTENT | AML_NAME_FLAG_PRIVATIZE ), &SuperName ) == AML_FALSE ) {
             return AML_FALSE;
         } else if( AmlEvalTarget( State, 0, &Target ) == AML_FALSE ) {
             return AML_FALSE;
@@ -1804,7 +1818,7 @@ AmlEvalExpressionOpcode(
         // Evaluate and handle a DerefOf expression.
         // Must currently be a name/value object, the expression handling function only operates on data/TermArgs, not objects.
         //
-        if( AmlEvalDerefOf( State, AML_FALSE, &SuperName ) == AML_FALSE ) {
+        if( AmlEvalDerefOf( State, AML_FALSE, 0, &SuperName ) == AML_FALSE ) {
             return AML_FALSE;
         } else if( SuperName->Type != AML_OBJECT_TYPE_NAME ) {
             return AML_FALSE;
@@ -2097,7 +2111,7 @@ AmlEvalExpressionOpcode(
         //
         if( AmlEvalTermArg( State, AML_EVAL_TERM_ARG_FLAG_TEMP, &Operand1 ) == AML_FALSE ) {
             return AML_FALSE;
-        } else if( AmlEvalSuperName( State, 0, 0, &Target ) == AML_FALSE ) {
+        } else if( AmlEvalSuperName( State, 0, AML_NAME_FLAG_PRIVATIZE, &Target ) == AML_FALSE ) {
             return AML_FALSE;
         }
 
@@ -2115,7 +2129,7 @@ AmlEvalExpressionOpcode(
         //
         if( AmlEvalTermArg( State, AML_EVAL_TERM_ARG_FLAG_TEMP, &Operand1 ) == AML_FALSE ) {
             return AML_FALSE;
-        } else if( AmlEvalSimpleName( State, 0, 0, &Target ) == AML_FALSE ) {
+        } else if( AmlEvalSimpleName( State, 0, AML_NAME_FLAG_PRIVATIZE, &Target ) == AML_FALSE ) {
             return AML_FALSE;
         }
 
@@ -2486,7 +2500,7 @@ AmlEvalExpressionOpcode(
         // Equivalent to Add (Addend, 1, Addend).
         // Attempts to convert the current value of the target to an integer.
         //
-        if( AmlEvalSuperName( State, 0, 0, &Target ) == AML_FALSE ) {
+        if( AmlEvalSuperName( State, 0, AML_NAME_FLAG_PRIVATIZE, &Target ) == AML_FALSE ) {
             return AML_FALSE;
         }
 
@@ -2535,7 +2549,7 @@ AmlEvalExpressionOpcode(
         // Attempts to convert the current value of the target to an integer.
         //
         Result = ( AML_DATA ){ .Type = AML_DATA_TYPE_INTEGER };
-        if( AmlEvalSuperName( State, 0, 0, &Target ) == AML_FALSE ) {
+        if( AmlEvalSuperName( State, 0, AML_NAME_FLAG_PRIVATIZE, &Target ) == AML_FALSE ) {
             return AML_FALSE;
         }
 
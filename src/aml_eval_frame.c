@@ -0,0 +1,111 @@
+#include "aml_state.h"
+#include "aml_eval_frame.h"
+#include "aml_debug.h"
+
+//
+// Push a new evaluation frame, and move the data window to the given TermList.
+//
+_Success_( return != NULL )
+AML_EVAL_FRAME*
+AmlEvalFramePush(
+    _Inout_ struct _AML_STATE* State,
+    _In_    AML_EVAL_FRAME_TYPE Type,
+    _In_    SIZE_T              CodeStart,
+    _In_    SIZE_T              CodeSize,
+    _In_    BOOLEAN             RestoreDataCursor
+    )
+{
+    AML_ARENA_SNAPSHOT ArenaSnapshot;
+    AML_EVAL_FRAME*    Frame;
+
+    //
+    // The given code block must be within the bounds of the input data.
+    //
+    if( ( CodeStart > State->DataTotalLength ) || ( CodeSize > ( State->DataTotalLength - CodeStart ) ) ) {
+        return NULL;
+    }
+
+    //
+    // Nesting depth is only limited by the memory budget of the frame stack.
+    //
+    if( ( ( State->EvalFrameDepth + 1 ) * sizeof( *Frame ) ) > State->EvalFrameStackMaxSize ) {
+        AML_DEBUG_ERROR( State, "Error: Reached evaluation frame stack memory budget!\n" );
+        return NULL;
+    }
+
+    //
+    // Allocate the frame from the frame stack arena.
+    //
+    ArenaSnapshot = AmlArenaSnapshot( &State->EvalFrameArena );
+    if( ( Frame = AmlArenaAllocate( &State->EvalFrameArena, sizeof( *Frame ) ) ) == NULL ) {
+        AmlArenaSnapshotRollback( &State->EvalFrameArena, &ArenaSnapshot );
+        return NULL;
+    }
+    *Frame = ( AML_EVAL_FRAME ){
+        .Previous          = State->EvalFrameLast,
+        .ArenaSnapshot     = ArenaSnapshot,
+        .Type              = Type,
+        .RestoreDataCursor = RestoreDataCursor,
+        .OldCursor         = State->DataCursor,
+        .OldLength         = State->DataLength,
+    };
+
+    //
+    // Link the frame to the stack and move the data window to the frame's TermList.
+    //
+    State->EvalFrameLast   = Frame;
+    State->EvalFrameDepth += 1;
+    State->DataCursor      = CodeStart;
+    State->DataLength      = ( CodeStart + CodeSize );
+    return Frame;
+}
+
+//
+// Pop the last evaluation frame, and restore the outer data window.
+//
+VOID
+AmlEvalFramePop(
+    _Inout_ struct _AML_STATE* State
+    )
+{
+    AML_EVAL_FRAME* Frame;
+
+    //
+    // Restore the outer data window.
+    //
+    Frame = State->EvalFrameLast;
+    if( Frame->RestoreDataCursor ) {
+        State->DataCursor = Frame->OldCursor;
+    }
+    State->DataLength = Frame->OldLength;
+
+    //
+    // Unlink and release the frame.
+    //
+    State->EvalFrameLast   = Frame->Previous;
+    State->EvalFrameDepth -= 1;
+    AmlArenaSnapshotRollback( &State->EvalFrameArena, &Frame->ArenaSnapshot );
+}
+
+//
+// Release all evaluation frames down to the given stack depth, without restoring any data windows.
+// Used to unwind the frame stack upon failure.
+//
+VOID
+AmlEvalFrameUnwind(
+    _Inout_ struct _AML_STATE* State,
+    _In_    SIZE_T             Depth
+    )
+{
+    AML_EVAL_FRAME* Frame;
+
+    //
+    // Frames must be released in order, the arena snapshots of each frame are nested.
+    //
+    while( State->EvalFrameDepth > Depth ) {
+        Frame = State->EvalFrameLast;
+        State->EvalFrameLast   = Frame->Previous;
+        State->EvalFrameDepth -= 1;
+        AmlArenaSnapshotRollback( &State->EvalFrameArena, &Frame->ArenaSnapshot );
+    }
+}
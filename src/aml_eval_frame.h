@@ -0,0 +1,97 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_arena.h"
+#include "aml_state_pass.h"
+
+//
+// Default memory budget of the evaluation frame stack in bytes (may be overridden per-state at creation).
+// Only bounds the nesting of blocks, expressions and method invocations are bounded by AML_BUILD_MAX_RECURSION_DEPTH.
+//
+#ifndef AML_BUILD_DEFAULT_FRAME_STACK_SIZE
+ #ifdef AML_BUILD_FUZZER
+  #define AML_BUILD_DEFAULT_FRAME_STACK_SIZE ( 64 * 1024 )
+ #else
+  #define AML_BUILD_DEFAULT_FRAME_STACK_SIZE ( 1024 * 1024 )
+ #endif
+#endif
+
+//
+// Evaluation frame types, determines the action taken once the end of the frame's TermList has been reached.
+//
+typedef enum _AML_EVAL_FRAME_TYPE {
+    AML_EVAL_FRAME_TYPE_TERM_LIST, /* Plain TermList (evaluation loop base, Else body). */
+    AML_EVAL_FRAME_TYPE_SCOPE,     /* Body of Scope/Device/Processor/PowerRes/ThermalZone, pops the namespace scope level. */
+    AML_EVAL_FRAME_TYPE_IF,        /* Body of an If statement, followed by an optional Else. */
+    AML_EVAL_FRAME_TYPE_WHILE,     /* Body of a While loop, the predicate is re-evaluated after each iteration. */
+} AML_EVAL_FRAME_TYPE;
+
+//
+// Evaluation frame of a single TermList block.
+// Nested blocks are pushed to the frame stack of the state instead of being evaluated recursively.
+// Method invocations and nested expressions (TermArgs) are not frames, their result is required in the middle
+// of the enclosing expression, they recurse natively and are bounded by AML_BUILD_MAX_RECURSION_DEPTH instead.
+//
+typedef struct _AML_EVAL_FRAME {
+    //
+    // Frame stack links and the arena snapshot to rollback to when popping this frame.
+    //
+    struct _AML_EVAL_FRAME* Previous;
+    AML_ARENA_SNAPSHOT      ArenaSnapshot;
+
+    //
+    // Frame type, and the outer data window to restore when popping this frame.
+    //
+    AML_EVAL_FRAME_TYPE Type;
+    BOOLEAN             RestoreDataCursor;
+    SIZE_T              OldCursor;
+    SIZE_T              OldLength;
+
+    //
+    // Type-specific state.
+    //
+    union {
+        struct {
+            UINT64 Predicate;
+        } If;
+        struct {
+            SIZE_T                 PredicateStart;
+            SIZE_T                 PkgEnd;
+            SIZE_T                 TermListStart;
+            SIZE_T                 TermListSize;
+            SIZE_T                 Iteration;
+            AML_INTERRUPTION_EVENT OldPendingEvent;
+        } While;
+    } u;
+} AML_EVAL_FRAME;
+
+//
+// Push a new evaluation frame, and move the data window to the given TermList.
+//
+_Success_( return != NULL )
+AML_EVAL_FRAME*
+AmlEvalFramePush(
+    _Inout_ struct _AML_STATE* State,
+    _In_    AML_EVAL_FRAME_TYPE Type,
+    _In_    SIZE_T              CodeStart,
+    _In_    SIZE_T              CodeSize,
+    _In_    BOOLEAN             RestoreDataCursor
+    );
+
+//
+// Pop the last evaluation frame, and restore the outer data window.
+//
+VOID
+AmlEvalFramePop(
+    _Inout_ struct _AML_STATE* State
+    );
+
+//
+// Release all evaluation frames down to the given stack depth, without restoring any data windows.
+// Used to unwind the frame stack upon failure.
+//
+VOID
+AmlEvalFrameUnwind(
+    _Inout_ struct _AML_STATE* State,
+    _In_    SIZE_T             Depth
+    );
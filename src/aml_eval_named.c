@@ -4,6 +4,8 @@
 #include "aml_conv.h"
 #include "aml_compare.h"
 #include "aml_debug.h"
+#include "aml_skip_index.h"
+#include "aml_field.h"
 
 //
 // Evaluate a named buffer field CreateXFieldOp instruction.
@@ -68,7 +70,7 @@ AmlEvalCreateBufferField(
     // 
     // TODO: Restructure code to allow releasing of SourceBuf on failure.
     //
-    if( AmlEvalTermArgToType( State, 0, AML_DATA_TYPE_BUFFER, &SourceBuf ) == AML_FALSE ) {
+    if( AmlEvalTermArgToType( State, AML_EVAL_TERM_ARG_FLAG_PRIVATIZE, AML_DATA_TYPE_BUFFER, &SourceBuf ) == AML_FALSE ) {
         return AML_FALSE;
     } else if( AmlEvalTermArgToType( State, 0, AML_DATA_TYPE_INTEGER, &IndexData ) == AML_FALSE ) {
         return AML_FALSE;
@@ -420,6 +422,11 @@ AmlEvalFieldOpcode(
                 return AML_FALSE;
             }
 
+            //
+            // Precompute the access plan of the field, the field geometry never changes after creation.
+            //
+            AmlFieldBuildAccessPlan( &Object->u.Field );
+
             //
             // Create a namespace node for the object.
             //
@@ -601,6 +608,11 @@ AmlEvalBankFieldOpcode(
                 return AML_FALSE;
             }
 
+            //
+            // Precompute the access plan of the bank field, the field geometry never changes after creation.
+            //
+            AmlFieldBuildAccessPlan( &Object->u.BankField.Base );
+
             //
             // Create a namespace node for the object.
             //
@@ -760,6 +772,7 @@ AmlEvalIndexFieldOpcode(
             };
             AmlObjectReference( IndexNsNode->Object );
             AmlObjectReference( DataNsNode->Object );
+            AmlIndexFieldBuildAccessPlan( &Object->u.IndexField );
 
             //
             // Raise the reference counter of the element's connection (if any).
@@ -806,6 +819,31 @@ AmlEvalIndexFieldOpcode(
     return AML_TRUE;
 }
 
+//
+// Enter the TermList of a named scope object definition (Device, Processor, PowerRes, ThermalZone) recorded by the namespace pass.
+// Equivalent to decoding the definition again and finding the pre-parsed node, without the namespace search.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlEvalSkipIndexedScope(
+    _Inout_ AML_STATE*                  State,
+    _In_    const AML_SKIP_INDEX_ENTRY* Entry
+    )
+{
+    //
+    // Mark the pre-parsed node as fully evaluated and push a frame to evaluate all code of the scope,
+    // the namespace scope level is popped and exited once the frame completes.
+    //
+    Entry->Node->IsEvaluated = AML_TRUE;
+    if( AmlNamespacePushNodeScope( &State->Namespace, Entry->Node, 0 ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_SCOPE, Entry->CodeStart, Entry->CodeSize, AML_FALSE ) == NULL ) {
+        return AML_FALSE;
+    }
+    return AML_TRUE;
+}
+
 //
 // Evaluate a DefDevice instruction.
 // DefDevice := DeviceOp PkgLength NameString TermList
@@ -818,15 +856,16 @@ AmlEvalDevice(
     _In_    BOOLEAN    ConsumeOpcode
     )
 {
-    AML_NAME_STRING     DeviceName;
-    AML_NAMESPACE_NODE* SearchNode;
-    SIZE_T              PkgLength;
-    SIZE_T              PkgStart;
-    SIZE_T              PkgCodeOffset;
-    SIZE_T              CodeStart;
-    SIZE_T              CodeSize;
-    AML_OBJECT*         Object;
-    AML_NAMESPACE_NODE* Node;
+    AML_NAME_STRING             DeviceName;
+    AML_NAMESPACE_NODE*         SearchNode;
+    SIZE_T                      PkgLength;
+    SIZE_T                      PkgStart;
+    SIZE_T                      PkgCodeOffset;
+    SIZE_T                      CodeStart;
+    SIZE_T                      CodeSize;
+    AML_OBJECT*                 Object;
+    AML_NAMESPACE_NODE*         Node;
+    const AML_SKIP_INDEX_ENTRY* Entry;
 
     //
     // Consume the instruction opcode if the caller hasn't already.
@@ -837,6 +876,16 @@ AmlEvalDevice(
         }
     }
 
+    //
+    // Skip straight to the TermList if the namespace pass has already decoded this device (see aml_skip_index.h).
+    //
+    if( ( State->PassType == AML_PASS_TYPE_FULL ) && ( State->SkipIndex != NULL ) ) {
+        Entry = AmlSkipIndexLookup( State->SkipIndex, &State->Namespace, State->Data, State->DataCursor, State->DataLength, AML_OBJECT_TYPE_DEVICE );
+        if( Entry != NULL ) {
+            return AmlEvalSkipIndexedScope( State, Entry );
+        }
+    }
+
     //
     // DefDevice := DeviceOp PkgLength NameString TermList
     //
@@ -911,7 +960,7 @@ AmlEvalDevice(
     //
     // Push and enter a new namespace scope level with the given name.
     //
-    if( AmlNamespacePushScope( &State->Namespace, &Node->AbsolutePath, 0 ) == AML_FALSE ) {
+    if( AmlNamespacePushNodeScope( &State->Namespace, Node, 0 ) == AML_FALSE ) {
         return AML_FALSE;
     }
 
@@ -926,16 +975,20 @@ AmlEvalDevice(
     CodeSize = ( PkgLength - PkgCodeOffset );
 
     //
-    // Recursively evaluate all code of the scope.
+    // Record the decoded definition for the full pass.
     //
-    if( AmlEvalTermListCode( State, CodeStart, CodeSize, AML_FALSE ) == AML_FALSE ) {
-        return AML_FALSE;
+    if( State->PassType == AML_PASS_TYPE_NAMESPACE ) {
+        AmlSkipIndexRecord( State->SkipIndex,
+                            State->Data,
+                            &DeviceName,
+                            &( AML_SKIP_INDEX_ENTRY ){ .PkgStart = PkgStart, .WindowEnd = State->DataLength, .CodeStart = CodeStart, .CodeSize = CodeSize, .Node = Node } );
     }
-          
+
     //
-    // Pop and exit the namespace scope level.
+    // Push a frame to evaluate all code of the scope,
+    // the namespace scope level is popped and exited once the frame completes.
     //
-    if( AmlNamespacePopScope( &State->Namespace ) == AML_FALSE ) {
+    if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_SCOPE, CodeStart, CodeSize, AML_FALSE ) == NULL ) {
         return AML_FALSE;
     }
 
@@ -953,19 +1006,20 @@ AmlEvalMethod(
     _In_    BOOLEAN    ConsumeOpcode
     )
 {
-    UINT8               PeekByte;
-    SIZE_T              PkgLength;
-    SIZE_T              PkgStart;
-    AML_NAME_STRING     MethodName;
-    AML_OBJECT_METHOD   Method;
-    SIZE_T              CodeStart;
-    SIZE_T              CodeSize;
-    SIZE_T              i;
-    SIZE_T              MaxTypeBytes;
-    UINT8               MethodFlags;
-    AML_OBJECT*         Object;
-    AML_NAMESPACE_NODE* SearchNode;
-    AML_NAMESPACE_NODE* Node;
+    UINT8                       PeekByte;
+    SIZE_T                      PkgLength;
+    SIZE_T                      PkgStart;
+    AML_NAME_STRING             MethodName;
+    AML_OBJECT_METHOD           Method;
+    SIZE_T                      CodeStart;
+    SIZE_T                      CodeSize;
+    SIZE_T                      i;
+    SIZE_T                      MaxTypeBytes;
+    UINT8                       MethodFlags;
+    AML_OBJECT*                 Object;
+    AML_NAMESPACE_NODE*         SearchNode;
+    AML_NAMESPACE_NODE*         Node;
+    const AML_SKIP_INDEX_ENTRY* Entry;
 
     //
     // Consume the instruction opcode if the caller hasn't already.
@@ -976,6 +1030,18 @@ AmlEvalMethod(
         }
     }
 
+    //
+    // Skip past the method body if the namespace pass has already decoded this method (see aml_skip_index.h).
+    //
+    if( ( State->PassType == AML_PASS_TYPE_FULL ) && ( State->SkipIndex != NULL ) ) {
+        Entry = AmlSkipIndexLookup( State->SkipIndex, &State->Namespace, State->Data, State->DataCursor, State->DataLength, AML_OBJECT_TYPE_METHOD );
+        if( Entry != NULL ) {
+            Entry->Node->IsEvaluated = AML_TRUE;
+            State->DataCursor = ( Entry->CodeStart + Entry->CodeSize );
+            return AML_TRUE;
+        }
+    }
+
     //
     // DefMethod := MethodOp PkgLength NameString MethodFlags TermList
     //
@@ -1184,6 +1250,16 @@ AmlEvalMethod(
         Node->IsPreParsed = ( State->PassType == AML_PASS_TYPE_NAMESPACE );
     }
 
+    //
+    // Record the decoded definition for the full pass.
+    //
+    if( State->PassType == AML_PASS_TYPE_NAMESPACE ) {
+        AmlSkipIndexRecord( State->SkipIndex,
+                            State->Data,
+                            &MethodName,
+                            &( AML_SKIP_INDEX_ENTRY ){ .PkgStart = PkgStart, .WindowEnd = State->DataLength, .CodeStart = CodeStart, .CodeSize = CodeSize, .Node = Node } );
+    }
+
     //
     // Mark this node as fully evaluated if this is the real evaluation pass.
     //
@@ -1248,18 +1324,19 @@ AmlEvalProcessor(
     _In_    BOOLEAN    ConsumeOpcode
     )
 {
-    SIZE_T              OriginalLength;
-    SIZE_T              PkgStart;
-    SIZE_T              PkgLength;
-    AML_NAME_STRING     Name;
-    UINT8               ProcID;
-    UINT32              PblkAddr;
-    UINT8               PblkLen;
-    AML_OBJECT*         Object;
-    AML_NAMESPACE_NODE* SearchNode;
-    AML_NAMESPACE_NODE* Node;
-    SIZE_T              PkgCodeOffset;
-    SIZE_T              PkgCodeSize;
+    SIZE_T                      OriginalLength;
+    SIZE_T                      PkgStart;
+    SIZE_T                      PkgLength;
+    AML_NAME_STRING             Name;
+    UINT8                       ProcID;
+    UINT32                      PblkAddr;
+    UINT8                       PblkLen;
+    AML_OBJECT*                 Object;
+    AML_NAMESPACE_NODE*         SearchNode;
+    AML_NAMESPACE_NODE*         Node;
+    SIZE_T                      PkgCodeOffset;
+    SIZE_T                      PkgCodeSize;
+    const AML_SKIP_INDEX_ENTRY* Entry;
 
     //
     // Consume the instruction opcode if the caller has yet to do it.
@@ -1270,6 +1347,16 @@ AmlEvalProcessor(
         }
     }
 
+    //
+    // Skip straight to the TermList if the namespace pass has already decoded this processor (see aml_skip_index.h).
+    //
+    if( ( State->PassType == AML_PASS_TYPE_FULL ) && ( State->SkipIndex != NULL ) ) {
+        Entry = AmlSkipIndexLookup( State->SkipIndex, &State->Namespace, State->Data, State->DataCursor, State->DataLength, AML_OBJECT_TYPE_PROCESSOR );
+        if( Entry != NULL ) {
+            return AmlEvalSkipIndexedScope( State, Entry );
+        }
+    }
+
     //
     // ProcID := ByteData
     // PblkAddr := DWordData
@@ -1359,20 +1446,30 @@ AmlEvalProcessor(
     PkgCodeSize = ( PkgLength - PkgCodeOffset );
 
     //
-    // Push a new scope level for the processor TermList, and attempt to evaluate it.
+    // Record the decoded definition for the full pass.
     //
-    if( AmlNamespacePushScope( &State->Namespace, &Node->AbsolutePath, 0 ) == AML_FALSE ) {
-        return AML_FALSE;
-    } else if( AmlEvalTermListCode( State, State->DataCursor, PkgCodeSize, AML_FALSE ) == AML_FALSE ) {
-        return AML_FALSE;
-    } else if( AmlNamespacePopScope( &State->Namespace ) == AML_FALSE ) {
-        return AML_FALSE;
+    if( State->PassType == AML_PASS_TYPE_NAMESPACE ) {
+        AmlSkipIndexRecord( State->SkipIndex,
+                            State->Data,
+                            &Name,
+                            &( AML_SKIP_INDEX_ENTRY ){ .PkgStart = PkgStart, .WindowEnd = OriginalLength, .CodeStart = State->DataCursor, .CodeSize = PkgCodeSize, .Node = Node } );
     }
 
     //
-    // Restore the original data window length.
+    // Restore the original data window length, the frame of the TermList will restore it once completed.
     //
     State->DataLength = OriginalLength;
+
+    //
+    // Push a new scope level for the processor TermList, and push a frame to evaluate it,
+    // the namespace scope level is popped once the frame completes.
+    //
+    if( AmlNamespacePushNodeScope( &State->Namespace, Node, 0 ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_SCOPE, State->DataCursor, PkgCodeSize, AML_FALSE ) == NULL ) {
+        return AML_FALSE;
+    }
+
     return AML_TRUE;
 }
 
@@ -1386,17 +1483,18 @@ AmlEvalPowerRes(
     _In_    BOOLEAN    ConsumeOpcode
     )
 {
-    SIZE_T              OriginalLength;
-    SIZE_T              PkgStart;
-    SIZE_T              PkgLength;
-    AML_NAME_STRING     Name;
-    UINT8               SystemLevel;
-    UINT16              ResourceOrder;
-    AML_OBJECT*         Object;
-    AML_NAMESPACE_NODE* SearchNode;
-    AML_NAMESPACE_NODE* Node;
-    SIZE_T              PkgCodeOffset;
-    SIZE_T              PkgCodeSize;
+    SIZE_T                      OriginalLength;
+    SIZE_T                      PkgStart;
+    SIZE_T                      PkgLength;
+    AML_NAME_STRING             Name;
+    UINT8                       SystemLevel;
+    UINT16                      ResourceOrder;
+    AML_OBJECT*                 Object;
+    AML_NAMESPACE_NODE*         SearchNode;
+    AML_NAMESPACE_NODE*         Node;
+    SIZE_T                      PkgCodeOffset;
+    SIZE_T                      PkgCodeSize;
+    const AML_SKIP_INDEX_ENTRY* Entry;
 
     //
     // Consume the instruction opcode if the caller has yet to do it.
@@ -1407,6 +1505,16 @@ AmlEvalPowerRes(
         }
     }
 
+    //
+    // Skip straight to the TermList if the namespace pass has already decoded this power resource (see aml_skip_index.h).
+    //
+    if( ( State->PassType == AML_PASS_TYPE_FULL ) && ( State->SkipIndex != NULL ) ) {
+        Entry = AmlSkipIndexLookup( State->SkipIndex, &State->Namespace, State->Data, State->DataCursor, State->DataLength, AML_OBJECT_TYPE_POWER_RESOURCE );
+        if( Entry != NULL ) {
+            return AmlEvalSkipIndexedScope( State, Entry );
+        }
+    }
+
     //
     // Decode the PkgLength that encapsulates the rest of the operands and the TermList.
     //
@@ -1494,20 +1602,30 @@ AmlEvalPowerRes(
     PkgCodeSize = ( PkgLength - PkgCodeOffset );
 
     //
-    // Push a new scope level for the TermList, and attempt to evaluate it.
+    // Record the decoded definition for the full pass.
     //
-    if( AmlNamespacePushScope( &State->Namespace, &Node->AbsolutePath, 0 ) == AML_FALSE ) {
-        return AML_FALSE;
-    } else if( AmlEvalTermListCode( State, State->DataCursor, PkgCodeSize, AML_FALSE ) == AML_FALSE ) {
-        return AML_FALSE;
-    } else if( AmlNamespacePopScope( &State->Namespace ) == AML_FALSE ) {
-        return AML_FALSE;
+    if( State->PassType == AML_PASS_TYPE_NAMESPACE ) {
+        AmlSkipIndexRecord( State->SkipIndex,
+                            State->Data,
+                            &Name,
+                            &( AML_SKIP_INDEX_ENTRY ){ .PkgStart = PkgStart, .WindowEnd = OriginalLength, .CodeStart = State->DataCursor, .CodeSize = PkgCodeSize, .Node = Node } );
     }
 
     //
-    // Restore the original data window length.
+    // Restore the original data window length, the frame of the TermList will restore it once completed.
     //
     State->DataLength = OriginalLength;
+
+    //
+    // Push a new scope level for the TermList, and push a frame to evaluate it,
+    // the namespace scope level is popped once the frame completes.
+    //
+    if( AmlNamespacePushNodeScope( &State->Namespace, Node, 0 ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_SCOPE, State->DataCursor, PkgCodeSize, AML_FALSE ) == NULL ) {
+        return AML_FALSE;
+    }
+
     return AML_TRUE;
 }
 
@@ -1521,15 +1639,16 @@ AmlEvalThermalZone(
     _In_    BOOLEAN    ConsumeOpcode
     )
 {
-    SIZE_T              OriginalLength;
-    SIZE_T              PkgStart;
-    SIZE_T              PkgLength;
-    AML_NAME_STRING     Name;
-    AML_OBJECT*         Object;
-    AML_NAMESPACE_NODE* SearchNode;
-    AML_NAMESPACE_NODE* Node;
-    SIZE_T              PkgCodeOffset;
-    SIZE_T              PkgCodeSize;
+    SIZE_T                      OriginalLength;
+    SIZE_T                      PkgStart;
+    SIZE_T                      PkgLength;
+    AML_NAME_STRING             Name;
+    AML_OBJECT*                 Object;
+    AML_NAMESPACE_NODE*         SearchNode;
+    AML_NAMESPACE_NODE*         Node;
+    SIZE_T                      PkgCodeOffset;
+    SIZE_T                      PkgCodeSize;
+    const AML_SKIP_INDEX_ENTRY* Entry;
 
     //
     // Consume the instruction opcode if the caller has yet to do it.
@@ -1540,6 +1659,16 @@ AmlEvalThermalZone(
         }
     }
 
+    //
+    // Skip straight to the TermList if the namespace pass has already decoded this thermal zone (see aml_skip_index.h).
+    //
+    if( ( State->PassType == AML_PASS_TYPE_FULL ) && ( State->SkipIndex != NULL ) ) {
+        Entry = AmlSkipIndexLookup( State->SkipIndex, &State->Namespace, State->Data, State->DataCursor, State->DataLength, AML_OBJECT_TYPE_THERMAL_ZONE );
+        if( Entry != NULL ) {
+            return AmlEvalSkipIndexedScope( State, Entry );
+        }
+    }
+
     //
     // Decode the PkgLength that encapsulates the rest of the operands and the TermList.
     //
@@ -1620,20 +1749,30 @@ AmlEvalThermalZone(
     PkgCodeSize = ( PkgLength - PkgCodeOffset );
 
     //
-    // Push a new scope level for the TermList, and attempt to evaluate it.
+    // Record the decoded definition for the full pass.
     //
-    if( AmlNamespacePushScope( &State->Namespace, &Node->AbsolutePath, 0 ) == AML_FALSE ) {
-        return AML_FALSE;
-    } else if( AmlEvalTermListCode( State, State->DataCursor, PkgCodeSize, AML_FALSE ) == AML_FALSE ) {
-        return AML_FALSE;
-    } else if( AmlNamespacePopScope( &State->Namespace ) == AML_FALSE ) {
-        return AML_FALSE;
+    if( State->PassType == AML_PASS_TYPE_NAMESPACE ) {
+        AmlSkipIndexRecord( State->SkipIndex,
+                            State->Data,
+                            &Name,
+                            &( AML_SKIP_INDEX_ENTRY ){ .PkgStart = PkgStart, .WindowEnd = OriginalLength, .CodeStart = State->DataCursor, .CodeSize = PkgCodeSize, .Node = Node } );
     }
 
     //
-    // Restore the original data window length.
+    // Restore the original data window length, the frame of the TermList will restore it once completed.
     //
     State->DataLength = OriginalLength;
+
+    //
+    // Push a new scope level for the TermList, and push a frame to evaluate it,
+    // the namespace scope level is popped once the frame completes.
+    //
+    if( AmlNamespacePushNodeScope( &State->Namespace, Node, 0 ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_SCOPE, State->DataCursor, PkgCodeSize, AML_FALSE ) == NULL ) {
+        return AML_FALSE;
+    }
+
     return AML_TRUE;
 }
 
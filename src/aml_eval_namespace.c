@@ -181,16 +181,10 @@ AmlEvalScope(
     ScopeCodeSize = ( ScopePkgLength - ScopePkgCodeOffset );
 
     //
-    // Recursively evaluate all code of the scope.
+    // Push a frame to evaluate all code of the scope,
+    // the namespace scope level is popped and exited once the frame completes.
     //
-    if( AmlEvalTermListCode( State, ScopeCodeStart, ScopeCodeSize, AML_FALSE ) == AML_FALSE ) {
-        return AML_FALSE;
-    }
-
-    //
-    // Pop and exit the namespace scope level.
-    //
-    if( AmlNamespacePopScope( &State->Namespace ) == AML_FALSE ) {
+    if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_SCOPE, ScopeCodeStart, ScopeCodeSize, AML_FALSE ) == NULL ) {
         return AML_FALSE;
     }
 
@@ -24,7 +24,7 @@ AmlEvalRefOf(
             return AML_FALSE;
         }
     }
-    if( AmlEvalSuperName( State, 0, 0, &DestObject ) == AML_FALSE ) {
+    if( AmlEvalSuperName( State, 0, AML_NAME_FLAG_PRIVATIZE, &DestObject ) == AML_FALSE ) {
         return AML_FALSE;
     }
 
@@ -51,12 +51,14 @@ AmlEvalRefOf(
 // Evaluate DerefOf instruction to an object.
 // DefDerefOf := DerefOfOp ObjReference
 // ObjReference := TermArg => ObjectReference | String
+// NameFlags apply to the resolution of a String ObjReference.
 //
 _Success_( return )
 BOOLEAN
 AmlEvalDerefOf(
     _Inout_  AML_STATE*   State,
     _In_     BOOLEAN      ConsumeOpcode,
+    _In_     UINT         NameFlags,
     _Outptr_ AML_OBJECT** ppObject
     )
 {
@@ -107,7 +109,7 @@ AmlEvalDerefOf(
         //
         // Resolve operand and return it as the result of this function.
         //
-        if( AmlResolveSimpleName( State, NULL, &SimpleName, 0, 0, &Object ) == AML_FALSE ) {
+        if( AmlResolveSimpleName( State, NULL, &SimpleName, 0, NameFlags, &Object ) == AML_FALSE ) {
             return AML_FALSE;
         }
         break;
@@ -168,7 +170,7 @@ AmlEvalIndex(
     // Source is evaluated to a buffer, string, or package data type. Index is evaluated to an integer.
     // The reference to the nth object (where n = Index) within Source is optionally stored as a reference into Destination.
     //
-    if( AmlEvalTermArg( State, AML_EVAL_TERM_ARG_FLAG_TEMP, &Source ) == AML_FALSE ) {
+    if( AmlEvalTermArg( State, ( AML_EVAL_TERM_ARG_FLAG_TEMP | AML_EVAL_TERM_ARG_FLAG_PRIVATIZE ), &Source ) == AML_FALSE ) {
         return AML_FALSE;
     } else if( AmlEvalTermArgToType( State, 0, AML_DATA_TYPE_INTEGER, &Index ) == AML_FALSE ) {
         return AML_FALSE;
@@ -335,6 +337,7 @@ BOOLEAN
 AmlEvalReferenceTypeOpcode(
     _Inout_  AML_STATE*   State,
     _In_     UINT         SearchFlags,
+    _In_     UINT         NameFlags,
     _Outptr_ AML_OBJECT** ppObject
     )
 {
@@ -358,7 +361,7 @@ AmlEvalReferenceTypeOpcode(
         }
         break;
     case AML_OPCODE_ID_DEREF_OF_OP:
-        if( AmlEvalDerefOf( State, AML_TRUE, ppObject ) == AML_FALSE ) {
+        if( AmlEvalDerefOf( State, AML_TRUE, NameFlags, ppObject ) == AML_FALSE ) {
             return AML_FALSE;
         }
         break;
@@ -17,12 +17,14 @@ AmlEvalRefOf(
 // Evaluate DerefOf instruction to an object.
 // DefDerefOf := DerefOfOp ObjReference
 // ObjReference := TermArg => ObjectReference | String
+// NameFlags apply to the resolution of a String ObjReference.
 //
 _Success_( return )
 BOOLEAN
 AmlEvalDerefOf(
     _Inout_  AML_STATE*   State,
     _In_     BOOLEAN      ConsumeOpcode,
+    _In_     UINT         NameFlags,
     _Outptr_ AML_OBJECT** ppObject
     );
 
@@ -52,5 +54,6 @@ BOOLEAN
 AmlEvalReferenceTypeOpcode(
     _Inout_  AML_STATE*   State,
     _In_     UINT         SearchFlags,
+    _In_     UINT         NameFlags,
     _Outptr_ AML_OBJECT** ppObject
     );
\ No newline at end of file
@@ -2,6 +2,61 @@
 #include "aml_eval_statement.h"
 #include "aml_debug.h"
 #include "aml_mutex.h"
+#include "aml_eval_async.h"
+
+//
+// Evaluate the optional Else portion of a DefIfElse instruction, following the If term list.
+// DefElse := Nothing | <elseop pkglength termlist>
+//
+_Success_( return )
+static
+BOOLEAN
+AmlEvalElse(
+    _Inout_ AML_STATE* State,
+    _In_    UINT64     Predicate
+    )
+{
+    SIZE_T PkgStart;
+    SIZE_T PkgLength;
+    SIZE_T TermListSize;
+
+    //
+    // Check if the statement has an Else portion.
+    // Else := ElseOp PkgLength TermList
+    //
+    if( AmlDecoderMatchOpcode( State, AML_OPCODE_ID_ELSE_OP, NULL ) == AML_FALSE ) {
+        return AML_TRUE;
+    }
+
+    //
+    // Save start of the Else statement package data.
+    //
+    PkgStart = State->DataCursor;
+
+    //
+    // Consume and validate package length.
+    //
+    if( AmlDecoderConsumePackageLength( State, &PkgLength ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( PkgStart >= State->DataLength || PkgLength > ( State->DataLength - PkgStart ) ) {
+        return AML_FALSE;
+    }
+
+    //
+    // If the If statement predicate was zero, push a frame for the term list of the else statement, otherwise, skip it.
+    // Just like the If portion, if this is the namespace pre-pass, explore all paths for all possible object names.
+    //
+    if( ( Predicate == 0 ) || ( State->PassType == AML_PASS_TYPE_NAMESPACE ) ) {
+        TermListSize = ( PkgLength - ( State->DataCursor - PkgStart ) );
+        if( AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_TERM_LIST, State->DataCursor, TermListSize, AML_FALSE ) == NULL ) {
+            return AML_FALSE;
+        }
+    } else {
+        State->DataCursor = ( PkgStart + PkgLength );
+    }
+
+    return AML_TRUE;
+}
 
 //
 // Evaluate a DefIfElse instruction.
@@ -16,11 +71,12 @@ AmlEvalIfElse(
     _In_    BOOLEAN    ConsumeOpcode
     )
 {
-    SIZE_T   PkgStart;
-    SIZE_T   PkgLength;
-    SIZE_T   TermListStart;
-    SIZE_T   TermListSize;
-    AML_DATA Predicate;
+    SIZE_T          PkgStart;
+    SIZE_T          PkgLength;
+    SIZE_T          TermListStart;
+    SIZE_T          TermListSize;
+    AML_DATA        Predicate;
+    AML_EVAL_FRAME* Frame;
 
     //
     // Consume the instruction opcode if the caller has yet to do it.
@@ -77,53 +133,93 @@ AmlEvalIfElse(
     //
     // If we are in namespace evaluation mode, scan the contents of both paths,
     // irregardless of the predicate, the namespace path may require all possible object definitions.
-    // If the Predicate is non-zero, the term list of the If term is executed, otherwise, skip it.
-    // TODO: This doesn't necessarily need to be done recursively, it is only done currently to change the
-    // window size to the TermListSize, otherwise, we would just let the eval loop keep processing the next
-    // instructions naturally.
+    // If the Predicate is non-zero, a frame is pushed for the term list of the If term,
+    // the Else portion is handled once the frame has been completed, otherwise, skip it.
     //
     if( ( Predicate.u.Integer != 0 ) || ( State->PassType == AML_PASS_TYPE_NAMESPACE ) ) {
-        if( AmlEvalTermListCode( State, State->DataCursor, TermListSize, AML_FALSE ) == AML_FALSE ) {
+        if( ( Frame = AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_IF, TermListStart, TermListSize, AML_FALSE ) ) == NULL ) {
             return AML_FALSE;
         }
-    } else {
-        State->DataCursor = ( PkgStart + PkgLength );
+        Frame->u.If.Predicate = Predicate.u.Integer;
+        return AML_TRUE;
     }
 
     //
-    // Check if the statement has an Else portion.
-    // Else := ElseOp PkgLength TermList
+    // The term list of the If term has been skipped, handle the Else portion.
     //
-    if( AmlDecoderMatchOpcode( State, AML_OPCODE_ID_ELSE_OP, NULL ) ) {
-        //
-        // Save start of the Else statement package data.
-        //
-        PkgStart = State->DataCursor;
+    State->DataCursor = ( PkgStart + PkgLength );
+    return AmlEvalElse( State, Predicate.u.Integer );
+}
 
-        //
-        // Consume and validate package length.
-        //
-        if( AmlDecoderConsumePackageLength( State, &PkgLength ) == AML_FALSE ) {
-            return AML_FALSE;
-        } else if( PkgStart >= State->DataLength || PkgLength > ( State->DataLength - PkgStart ) ) {
-            return AML_FALSE;
-        }
+//
+// Complete the evaluation frame of the term list of an If term, handles the Else portion of the statement.
+//
+_Success_( return )
+BOOLEAN
+AmlEvalIfElseComplete(
+    _Inout_ AML_STATE* State
+    )
+{
+    UINT64 Predicate;
 
-        //
-        // If the If statement predicate was zero, execute the term list of the else statement, otherwise, skip it.
-        // Just like above, if this is the namespace pre-pass, explore all paths for all possible object names.
-        // TODO: Same as the above call to AmlEvalTermListCode, doesn't necessarily need to be recursive.
-        //
-        if( ( Predicate.u.Integer == 0 ) || ( State->PassType == AML_PASS_TYPE_NAMESPACE ) ) {
-            TermListSize = ( PkgLength - ( State->DataCursor - PkgStart ) );
-            if( AmlEvalTermListCode( State, State->DataCursor, TermListSize, AML_FALSE ) == AML_FALSE ) {
-                return AML_FALSE;
-            }
-        } else {
-            State->DataCursor = ( PkgStart + PkgLength );
-        }
+    //
+    // Pop the frame of the If term list, the cursor is left at the end of the term list.
+    //
+    Predicate = State->EvalFrameLast->u.If.Predicate;
+    AmlEvalFramePop( State );
+
+    //
+    // If the term list was interrupted (break/continue/return), the Else portion is never reached,
+    // the interruption event is passed on to the outer frames.
+    //
+    if( State->PendingInterruptionEvent != AML_INTERRUPTION_EVENT_NONE ) {
+        return AML_TRUE;
+    }
+
+    return AmlEvalElse( State, Predicate );
+}
+
+//
+// Begin the next iteration of the evaluation frame of a while loop.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlEvalWhileBeginIteration(
+    _Inout_ AML_STATE*      State,
+    _Inout_ AML_EVAL_FRAME* Frame
+    )
+{
+    //
+    // Infinite Break out of the loop if we have possibly encountered an infinite loop.
+    //
+    if( Frame->u.While.Iteration >= AML_BUILD_MAX_LOOP_ITERATIONS ) {
+        AML_DEBUG_ERROR( State, "Error: Exceeded maximum loop iteration count (possible infinite loop).\n" );
+        return AML_FALSE;
+    }
+
+    //
+    // Increase while loop nesting level.
+    //
+    if( State->WhileLoopLevel == SIZE_MAX ) {
+        AML_DEBUG_ERROR( State, "Error: Reached maximum while loop nesting level.\n" );
+        return AML_FALSE;
     }
+    State->WhileLoopLevel++;
+
+    //
+    // Back up old control flow interruption state, generally these should never stay set between nesting levels, but just make sure.
+    // Clear control flow interruption state, and then break out of term list execution if a while loop break event becomes set.
+    // TODO: This whole system needs a refactor now due to the return instruction (?)
+    //
+    Frame->u.While.OldPendingEvent = State->PendingInterruptionEvent;
+    State->PendingInterruptionEvent = AML_INTERRUPTION_EVENT_NONE;
 
+    //
+    // Move the data window back to the start of the body term list of the while loop.
+    //
+    State->DataCursor = Frame->u.While.TermListStart;
+    State->DataLength = ( Frame->u.While.TermListStart + Frame->u.While.TermListSize );
     return AML_TRUE;
 }
 
@@ -138,15 +234,13 @@ AmlEvalWhile(
     _In_    BOOLEAN    ConsumeOpcode
     )
 {
-    SIZE_T                 PredicateStart;
-    SIZE_T                 PkgStart;
-    SIZE_T                 PkgLength;
-    SIZE_T                 TermListStart;
-    SIZE_T                 TermListSize;
-    AML_DATA               Predicate;
-    SIZE_T                 i;
-    AML_INTERRUPTION_EVENT OldPendingEvent;
-    AML_INTERRUPTION_EVENT PendingEvent;
+    SIZE_T          PredicateStart;
+    SIZE_T          PkgStart;
+    SIZE_T          PkgLength;
+    SIZE_T          TermListStart;
+    SIZE_T          TermListSize;
+    AML_DATA        Predicate;
+    AML_EVAL_FRAME* Frame;
 
     //
     // Predicate := TermArg => Integer
@@ -187,86 +281,89 @@ AmlEvalWhile(
     TermListSize  = ( PkgLength - ( TermListStart - PkgStart ) );
 
     //
-    // While the predicate remains true, keep executing the term list until reaching a break or continue statement.
+    // Skip the entire loop if the predicate is initially false.
     //
-    for( i = 0; Predicate.u.Integer != 0; i++ ) {
-        //
-        // Infinite Break out of the loop if we have possibly encountered an infinite loop.
-        //
-        if( i >= AML_BUILD_MAX_LOOP_ITERATIONS ) {
-            AML_DEBUG_ERROR( State, "Error: Exceeded maximum loop iteration count (possible infinite loop).\n" );
-            return AML_FALSE;
-        }
-
-        //
-        // Increase while loop nesting level.
-        //
-        if( State->WhileLoopLevel == SIZE_MAX ) {
-            AML_DEBUG_ERROR( State, "Error: Reached maximum while loop nesting level.\n" );
-            return AML_FALSE;
-        }
-        State->WhileLoopLevel++;
-
-        //
-        // Back up old control flow interruption state, generally these should never stay set between nesting levels, but just make sure.
-        // Clear control flow interruption state, and then break out of term list execution if a while loop break event becomes set.
-        // TODO: This whole system needs a refactor now due to the return instruction (?)
-        //
-        OldPendingEvent = State->PendingInterruptionEvent;
-        State->PendingInterruptionEvent = AML_INTERRUPTION_EVENT_NONE;
-
-        //
-        // Execute the body term list of the while loop.
-        //
-        if( AmlEvalTermListCode( State, TermListStart, TermListSize, AML_TRUE ) == AML_FALSE ) {
-            return AML_FALSE;
-        }
+    if( Predicate.u.Integer == 0 ) {
+        State->DataCursor = ( PkgStart + PkgLength );
+        return AML_TRUE;
+    }
 
-        //
-        // Save the pending event results of this iteration.
-        //
-        PendingEvent = State->PendingInterruptionEvent;
+    //
+    // While the predicate remains true, keep executing the term list until reaching a break or continue statement.
+    // Push a frame for the term list of the loop, the predicate is re-evaluated once each iteration of the frame completes.
+    //
+    if( ( Frame = AmlEvalFramePush( State, AML_EVAL_FRAME_TYPE_WHILE, TermListStart, TermListSize, AML_TRUE ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    Frame->u.While.PredicateStart = PredicateStart;
+    Frame->u.While.PkgEnd         = ( PkgStart + PkgLength );
+    Frame->u.While.TermListStart  = TermListStart;
+    Frame->u.While.TermListSize   = TermListSize;
+    Frame->u.While.Iteration      = 0;
+    return AmlEvalWhileBeginIteration( State, Frame );
+}
 
-        //
-        // Decrease while loop nesting level count.
-        //
-        State->WhileLoopLevel--;
+//
+// Complete a single iteration of the evaluation frame of a while loop.
+// Either begins the next iteration, or pops the frame and moves the IP past the while loop instruction and body.
+//
+_Success_( return )
+BOOLEAN
+AmlEvalWhileComplete(
+    _Inout_ AML_STATE* State
+    )
+{
+    AML_EVAL_FRAME*        Frame;
+    AML_INTERRUPTION_EVENT PendingEvent;
+    AML_DATA               Predicate;
+    SIZE_T                 PkgEnd;
 
-        //
-        // If there is a pending event that wasn't for us, we must pass it on until it is handled by the intended code.
-        //
-        if( ( PendingEvent != AML_INTERRUPTION_EVENT_NONE )
-            && ( PendingEvent != AML_INTERRUPTION_EVENT_BREAK )
-            && ( PendingEvent != AML_INTERRUPTION_EVENT_CONTINUE ) )
-        {
-            break;
-        }
+    //
+    // Save the pending event results of this iteration.
+    //
+    Frame = State->EvalFrameLast;
+    PendingEvent = State->PendingInterruptionEvent;
 
-        //
-        // Restore old control flow interruption state, and decrease nesting level.
-        //
-        State->PendingInterruptionEvent = OldPendingEvent;
+    //
+    // Decrease while loop nesting level count, and restore the outer data window to re-evaluate the predicate.
+    //
+    State->WhileLoopLevel--;
+    State->DataLength = Frame->OldLength;
 
+    //
+    // If there is a pending event that wasn't for us, we must pass it on until it is handled by the intended code.
+    //
+    if( ( PendingEvent == AML_INTERRUPTION_EVENT_NONE )
+        || ( PendingEvent == AML_INTERRUPTION_EVENT_BREAK )
+        || ( PendingEvent == AML_INTERRUPTION_EVENT_CONTINUE ) )
+    {
         //
-        // Break out of the loop if we have hit a break instruction.
+        // Restore old control flow interruption state.
         //
-        if( PendingEvent == AML_INTERRUPTION_EVENT_BREAK ) {
-            break;
-        }
+        State->PendingInterruptionEvent = Frame->u.While.OldPendingEvent;
 
         //
-        // Re-evaluate the predicate's value after this iteration.
+        // Re-evaluate the predicate's value after this iteration (unless we have hit a break instruction),
+        // and begin the next iteration if it is still true.
         //
-        State->DataCursor = PredicateStart;
-        if( AmlEvalTermArgToType( State, 0, AML_DATA_TYPE_INTEGER, &Predicate ) == AML_FALSE ) {
-            return AML_FALSE;
+        if( PendingEvent != AML_INTERRUPTION_EVENT_BREAK ) {
+            State->DataCursor = Frame->u.While.PredicateStart;
+            if( AmlEvalTermArgToType( State, 0, AML_DATA_TYPE_INTEGER, &Predicate ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+            if( Predicate.u.Integer != 0 ) {
+                Frame->u.While.Iteration++;
+                return AmlEvalWhileBeginIteration( State, Frame );
+            }
         }
     }
 
     //
     // We have finished executing the while loop, move the IP past the while loop instruction and body.
     //
-    State->DataCursor = ( PkgStart + PkgLength );
+    PkgEnd = Frame->u.While.PkgEnd;
+    AmlEvalFramePop( State );
+    State->DataCursor = PkgEnd;
     return AML_TRUE;
 }
 
@@ -288,6 +385,7 @@ AmlEvalStatementOpcode(
     AML_OBJECT*                    Object;
     AML_DATA                       NotifyValue;
     AML_DATA                       Time;
+    AML_EXECUTION_CONTEXT*         Context;
 
     //
     // Consume next full instruction opcode, must have already been deduced to be a StatementOpcode by the caller.
@@ -360,7 +458,7 @@ AmlEvalStatementOpcode(
         if( AmlEvalTermArgToType( State, 0, AML_DATA_TYPE_INTEGER, &Time ) == AML_FALSE ) {
             return AML_FALSE;
         }
-        AmlHostSleep( State->Host, Time.u.Integer );
+        AmlEvalAsyncSleep( State, Time.u.Integer );
         return AML_TRUE;
     case AML_OPCODE_ID_STALL_OP:
         //
@@ -370,7 +468,13 @@ AmlEvalStatementOpcode(
         if( AmlEvalTermArgToType( State, 0, AML_DATA_TYPE_INTEGER, &Time ) == AML_FALSE ) {
             return AML_FALSE;
         }
+
+        //
+        // Allow other execution contexts to run while stalling.
+        //
+        Context = AmlExecutionContextSuspend( State );
         AmlHostStall( State->Host, Time.u.Integer );
+        AmlExecutionContextResume( Context );
         return AML_TRUE;
     case AML_OPCODE_ID_NOTIFY_OP:
         //
@@ -391,6 +495,12 @@ AmlEvalStatementOpcode(
         case AML_OBJECT_TYPE_THERMAL_ZONE:
         case AML_OBJECT_TYPE_PROCESSOR:
         case AML_OBJECT_TYPE_DEVICE:
+            //
+            // A bus check may re-enumerate the hierarchy below the device, all cached PCI region topology must be evaluated again.
+            //
+            if( NotifyValue.u.Integer == AML_NOTIFY_VALUE_BUS_CHECK ) {
+                AmlPciTopologyCacheInvalidate( &State->PciTopology );
+            }
             AmlHostObjectNotification( State->Host, Object, NotifyValue.u.Integer );
             break;
         default:
@@ -26,6 +26,15 @@ AmlEvalIfElse(
     _In_    BOOLEAN    ConsumeOpcode
     );
 
+//
+// Complete the evaluation frame of the term list of an If term, handles the Else portion of the statement.
+//
+_Success_( return )
+BOOLEAN
+AmlEvalIfElseComplete(
+    _Inout_ AML_STATE* State
+    );
+
 //
 // Predicate := TermArg => Integer
 // DefWhile := WhileOp PkgLength Predicate TermList
@@ -37,6 +46,16 @@ AmlEvalWhile(
     _In_    BOOLEAN    ConsumeOpcode
     );
 
+//
+// Complete a single iteration of the evaluation frame of a while loop.
+// Either begins the next iteration, or pops the frame and moves the IP past the while loop instruction and body.
+//
+_Success_( return )
+BOOLEAN
+AmlEvalWhileComplete(
+    _Inout_ AML_STATE* State
+    );
+
 //
 // Evaluate a StatementOpcode.
 // StatementOpcode := DefBreak | DefBreakPoint | DefContinue | DefFatal | DefIfElse
@@ -0,0 +1,285 @@
+#include "aml_execution_context.h"
+#include "aml_state.h"
+#include "aml_host.h"
+#include "aml_debug.h"
+
+//
+// Exchange the value of a single field between the state and the context.
+//
+#define AML_EXECUTION_CONTEXT_SWAP_FIELD(Type, StateField, ContextField) \
+    do {                                                                  \
+        Type SwapTemp    = ( StateField );                                \
+        ( StateField )   = ( ContextField );                              \
+        ( ContextField ) = SwapTemp;                                      \
+    } while( 0 )
+
+//
+// Exchange all per-execution fields of the state with the saved fields of the context.
+// Swapping is symmetric, while a context is entered, it holds the execution state that was displaced from the state.
+//
+static
+VOID
+AmlExecutionContextSwap(
+    _Inout_ AML_STATE*             State,
+    _Inout_ AML_EXECUTION_CONTEXT* Context
+    )
+{
+    //
+    // Decoder/evaluation state.
+    //
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_PASS_TYPE, State->PassType, Context->PassType );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->MethodScopeLevel, Context->MethodScopeLevel );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->MethodScopeLevelStart, Context->MethodScopeLevelStart );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( const UINT8*, State->Data, Context->Data );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->DataTotalLength, Context->DataTotalLength );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->DataLength, Context->DataLength );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->DataCursor, Context->DataCursor );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( struct _AML_NAME_CACHE*, State->NameCache, Context->NameCache );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( struct _AML_SKIP_INDEX*, State->SkipIndex, Context->SkipIndex );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->WhileLoopLevel, Context->WhileLoopLevel );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->RecursionDepth, Context->RecursionDepth );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_INTERRUPTION_EVENT, State->PendingInterruptionEvent, Context->PendingInterruptionEvent );
+
+    //
+    // Method scope stack.
+    //
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_ARENA, State->MethodScopeArena, Context->MethodScopeArena );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_METHOD_SCOPE*, State->MethodScopeFirst, Context->MethodScopeFirst );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_METHOD_SCOPE*, State->MethodScopeLast, Context->MethodScopeLast );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_METHOD_SCOPE*, State->MethodScopeRoot, Context->MethodScopeRoot );
+
+    //
+    // Evaluation frame stack.
+    //
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_ARENA, State->EvalFrameArena, Context->EvalFrameArena );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_EVAL_FRAME*, State->EvalFrameLast, Context->EvalFrameLast );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( SIZE_T, State->EvalFrameDepth, Context->EvalFrameDepth );
+
+    //
+    // State snapshot stack.
+    //
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_ARENA, State->StateSnapshotArena, Context->StateSnapshotArena );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_STATE_SNAPSHOT*, State->StateSnapshotHead, Context->StateSnapshotHead );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_STATE_SNAPSHOT*, State->StateSnapshotTail, Context->StateSnapshotTail );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( UINT64, State->StateSnapshotLevelIndex, Context->StateSnapshotLevelIndex );
+
+    //
+    // Namespace scope stack and temp arena.
+    //
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_ARENA, State->Namespace.ScopeArena, Context->NamespaceScopeArena );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_NAMESPACE_SCOPE*, State->Namespace.ScopeFirst, Context->NamespaceScopeFirst );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_NAMESPACE_SCOPE*, State->Namespace.ScopeLast, Context->NamespaceScopeLast );
+    AML_EXECUTION_CONTEXT_SWAP_FIELD( AML_ARENA, State->Namespace.TempArena, Context->NamespaceTempArena );
+}
+
+//
+// Swap in the execution state of the context, fails if another context of the state is already active.
+// This is only a sanity check of the host serialization, not a lock.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlExecutionContextEnterInternal(
+    _Inout_ AML_EXECUTION_CONTEXT* Context
+    )
+{
+    AML_STATE* State;
+
+    State = Context->State;
+    if( State->ActiveContext != NULL ) {
+        AML_DEBUG_ERROR( State, "Error: Another execution context of the state is already entered!\n" );
+        return AML_FALSE;
+    }
+    AmlExecutionContextSwap( State, Context );
+    State->ActiveContext = Context;
+    Context->IsEntered = AML_TRUE;
+    return AML_TRUE;
+}
+
+//
+// Swap out the execution state of the context.
+//
+static
+VOID
+AmlExecutionContextLeaveInternal(
+    _Inout_ AML_EXECUTION_CONTEXT* Context
+    )
+{
+    AML_STATE* State;
+
+    State = Context->State;
+    Context->IsEntered = AML_FALSE;
+    State->ActiveContext = NULL;
+    AmlExecutionContextSwap( State, Context );
+}
+
+//
+// Initialize a new execution context for the given state, no other context of the state may be entered.
+// The given context storage must remain valid until the context is freed.
+//
+_Success_( return )
+BOOLEAN
+AmlExecutionContextInitialize(
+    _Out_   AML_EXECUTION_CONTEXT* Context,
+    _Inout_ struct _AML_STATE*     State
+    )
+{
+    BOOLEAN Success;
+
+    //
+    // Default initialize the execution state of the context, starting out at the root namespace scope.
+    // Memset is used here to avoid a large copy of the default AML_EXECUTION_CONTEXT structure on the stack.
+    //
+    AML_MEMSET( Context, 0, sizeof( *Context ) );
+    Context->State               = State;
+    Context->PassType            = AML_PASS_TYPE_FULL;
+    Context->NamespaceScopeFirst = &State->Namespace.ScopeRoot;
+    Context->NamespaceScopeLast  = &State->Namespace.ScopeRoot;
+    AmlArenaInitialize( &Context->MethodScopeArena, State->Allocator, 4096, 0 );
+    AmlArenaInitialize( &Context->EvalFrameArena, State->Allocator, 4096, 0 );
+    AmlArenaInitialize( &Context->StateSnapshotArena, State->Allocator, 4096, 0 );
+    AmlArenaInitialize( &Context->NamespaceScopeArena, State->Allocator, 8192, 0 );
+    AmlArenaInitialize( &Context->NamespaceTempArena, State->Allocator, 4096, 0 );
+
+    //
+    // Begin the default state snapshot stack level and method scope root level of the context,
+    // the root method scope objects are allocated from the shared heap, so the context must be entered.
+    //
+    if( AmlExecutionContextEnterInternal( Context ) == AML_FALSE ) {
+        Success = AML_FALSE;
+    } else {
+        Success = ( AmlStateSnapshotBegin( State ) && AmlMethodPushScope( State ) );
+        State->MethodScopeRoot = State->MethodScopeLast;
+        AmlExecutionContextLeaveInternal( Context );
+    }
+    if( Success == AML_FALSE ) {
+        AmlArenaRelease( &Context->MethodScopeArena );
+        AmlArenaRelease( &Context->EvalFrameArena );
+        AmlArenaRelease( &Context->StateSnapshotArena );
+        AmlArenaRelease( &Context->NamespaceScopeArena );
+        AmlArenaRelease( &Context->NamespaceTempArena );
+        return AML_FALSE;
+    }
+    return AML_TRUE;
+}
+
+//
+// Release all resources of the given execution context, the context must not be entered.
+// All contexts must be freed before their state.
+//
+VOID
+AmlExecutionContextFree(
+    _Inout_ _Post_invalid_ AML_EXECUTION_CONTEXT* Context
+    )
+{
+    AML_STATE* State;
+
+    //
+    // Pop the root method scope level to release its objects back to the shared heap.
+    //
+    State = Context->State;
+    if( AmlExecutionContextEnterInternal( Context ) ) {
+        if( State->MethodScopeRoot != NULL ) {
+            AmlMethodPopScope( State );
+        }
+        AmlExecutionContextLeaveInternal( Context );
+    }
+
+    //
+    // Release all per-context memory.
+    //
+    AmlArenaRelease( &Context->MethodScopeArena );
+    AmlArenaRelease( &Context->EvalFrameArena );
+    AmlArenaRelease( &Context->StateSnapshotArena );
+    AmlArenaRelease( &Context->NamespaceScopeArena );
+    AmlArenaRelease( &Context->NamespaceTempArena );
+
+    //
+    // Zero fields for debugging.
+    //
+    AML_MEMSET( Context, 0, sizeof( *Context ) );
+}
+
+//
+// Switch the state to the given execution context, fails if another context of the state is already entered.
+// Entering does not wait for the other context to leave, the host must serialize all use of the state between threads.
+// Contexts must not be entered from within an evaluation (for example, by a host callback).
+//
+_Success_( return )
+BOOLEAN
+AmlExecutionContextEnter(
+    _Inout_ AML_EXECUTION_CONTEXT* Context
+    )
+{
+    if( Context->IsEntered ) {
+        AML_DEBUG_ERROR( Context->State, "Error: Execution context has already been entered!\n" );
+        return AML_FALSE;
+    }
+    return AmlExecutionContextEnterInternal( Context );
+}
+
+//
+// Switch the state back out of the given entered execution context.
+//
+VOID
+AmlExecutionContextLeave(
+    _Inout_ AML_EXECUTION_CONTEXT* Context
+    )
+{
+    if( ( Context->IsEntered == AML_FALSE ) || ( Context->State->ActiveContext != Context ) ) {
+        AML_DEBUG_PANIC( Context->State, "Fatal: Leaving an execution context that isn't active!" );
+        return;
+    }
+    AmlExecutionContextLeaveInternal( Context );
+}
+
+//
+// Temporarily leave the active execution context of the state (if any) before a blocking operation,
+// returns the suspended context, which must be passed to AmlExecutionContextResume once the operation completes.
+// Also releases the blocking lock of the context (if bound), allowing other contexts bound to it to run in the meantime.
+// Does nothing and returns NULL if the state isn't executing within a context.
+//
+_Success_( return != NULL )
+AML_EXECUTION_CONTEXT*
+AmlExecutionContextSuspend(
+    _Inout_ struct _AML_STATE* State
+    )
+{
+    AML_EXECUTION_CONTEXT* Context;
+
+    if( ( Context = State->ActiveContext ) == NULL ) {
+        return NULL;
+    }
+    AmlExecutionContextLeaveInternal( Context );
+    if( Context->HasBlockingLock ) {
+        AmlHostMutexRelease( State->Host, Context->BlockingLock );
+    }
+    return Context;
+}
+
+//
+// Re-enter an execution context previously suspended using AmlExecutionContextSuspend,
+// waits for the blocking lock of the context (if bound) first.
+//
+VOID
+AmlExecutionContextResume(
+    _Inout_opt_ AML_EXECUTION_CONTEXT* Context
+    )
+{
+    if( Context == NULL ) {
+        return;
+    }
+
+    //
+    // The suspended evaluation can't be backed out of at this point, the blocking lock must be reacquired,
+    // and the host must not have left any other context of the state entered in the meantime.
+    //
+    if( Context->HasBlockingLock ) {
+        if( AmlHostMutexAcquire( Context->State->Host, Context->BlockingLock, 0xFFFF ) != AML_WAIT_STATUS_SUCCESS ) {
+            AML_DEBUG_PANIC( Context->State, "Fatal: Failed to reacquire the blocking lock of a suspended execution context!" );
+        }
+    }
+    if( AmlExecutionContextEnterInternal( Context ) == AML_FALSE ) {
+        AML_DEBUG_PANIC( Context->State, "Fatal: Failed to resume a suspended execution context, another context of the state is entered!" );
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_arena.h"
+#include "aml_state_pass.h"
+
+//
+// Execution context.
+// Holds all per-execution state of an AML_STATE (decoder window, method scope stack, evaluation frame stack,
+// state snapshot stack, namespace scope stack, and the namespace temp arena), while the namespace, heap,
+// and region space handlers of the state are shared by all contexts.
+// Entering a context swaps its execution state into the AML_STATE, leaving the context swaps it back out,
+// allowing several independent evaluations of a single state to be in progress at the same time.
+// The state itself is not thread safe, only a single context may be entered at a time, and the host must serialize
+// all use of the state between threads (for example, using a host mutex bound as the blocking lock of each context).
+// Operations that actually block (Sleep, Stall, Wait, and Acquire or serialized method entry of an owned mutex)
+// suspend the active context, allowing the host to enter other contexts in the meantime.
+//
+typedef struct _AML_EXECUTION_CONTEXT {
+    //
+    // The state that this context executes within.
+    //
+    struct _AML_STATE* State;
+
+    //
+    // Set while the context is entered (is the active context of the state).
+    //
+    BOOLEAN IsEntered;
+
+    //
+    // Asynchronous evaluation that owns this context, NULL for regular (blocking) contexts.
+    //
+    struct _AML_EVAL_ASYNC* AsyncEvaluation;
+
+    //
+    // Optional host mutex that serializes this context with all other contexts bound to the same mutex (see AmlInitializeDevicesParallel).
+    // Binding the same mutex to all contexts of a state is the simplest way for a host to serialize the state between threads.
+    // The thread of the context must hold the mutex for as long as the context is entered (AmlExecutionContextEnter does not acquire it),
+    // it is only released while the context is suspended by a blocking operation, and reacquired before the context is resumed.
+    //
+    UINT64  BlockingLock;
+    BOOLEAN HasBlockingLock;
+
+    //
+    // Saved decoder/evaluation state (see the matching fields of AML_STATE).
+    //
+    AML_PASS_TYPE           PassType;
+    SIZE_T                  MethodScopeLevel;
+    SIZE_T                  MethodScopeLevelStart;
+    const UINT8*            Data;
+    SIZE_T                  DataTotalLength;
+    SIZE_T                  DataLength;
+    SIZE_T                  DataCursor;
+    struct _AML_NAME_CACHE* NameCache;
+    struct _AML_SKIP_INDEX* SkipIndex;
+    SIZE_T                  WhileLoopLevel;
+    SIZE_T                  RecursionDepth;
+    AML_INTERRUPTION_EVENT  PendingInterruptionEvent;
+
+    //
+    // Saved method scope stack.
+    //
+    AML_ARENA                 MethodScopeArena;
+    struct _AML_METHOD_SCOPE* MethodScopeFirst;
+    struct _AML_METHOD_SCOPE* MethodScopeLast;
+    struct _AML_METHOD_SCOPE* MethodScopeRoot;
+
+    //
+    // Saved evaluation frame stack.
+    //
+    AML_ARENA               EvalFrameArena;
+    struct _AML_EVAL_FRAME* EvalFrameLast;
+    SIZE_T                  EvalFrameDepth;
+
+    //
+    // Saved state snapshot stack.
+    //
+    AML_ARENA                   StateSnapshotArena;
+    struct _AML_STATE_SNAPSHOT* StateSnapshotHead;
+    struct _AML_STATE_SNAPSHOT* StateSnapshotTail;
+    UINT64                      StateSnapshotLevelIndex;
+
+    //
+    // Saved namespace scope stack and temp arena (see the matching fields of AML_NAMESPACE_STATE).
+    //
+    AML_ARENA                    NamespaceScopeArena;
+    struct _AML_NAMESPACE_SCOPE* NamespaceScopeFirst;
+    struct _AML_NAMESPACE_SCOPE* NamespaceScopeLast;
+    AML_ARENA                    NamespaceTempArena;
+} AML_EXECUTION_CONTEXT;
+
+//
+// Initialize a new execution context for the given state, no other context of the state may be entered.
+// The given context storage must remain valid until the context is freed.
+//
+_Success_( return )
+BOOLEAN
+AmlExecutionContextInitialize(
+    _Out_   AML_EXECUTION_CONTEXT* Context,
+    _Inout_ struct _AML_STATE*     State
+    );
+
+//
+// Release all resources of the given execution context, the context must not be entered.
+// All contexts must be freed before their state.
+//
+VOID
+AmlExecutionContextFree(
+    _Inout_ _Post_invalid_ AML_EXECUTION_CONTEXT* Context
+    );
+
+//
+// Switch the state to the given execution context, fails if another context of the state is already entered.
+// Entering does not wait for the other context to leave, the host must serialize all use of the state between threads.
+// Contexts must not be entered from within an evaluation (for example, by a host callback).
+//
+_Success_( return )
+BOOLEAN
+AmlExecutionContextEnter(
+    _Inout_ AML_EXECUTION_CONTEXT* Context
+    );
+
+//
+// Switch the state back out of the given entered execution context.
+//
+VOID
+AmlExecutionContextLeave(
+    _Inout_ AML_EXECUTION_CONTEXT* Context
+    );
+
+//
+// Temporarily leave the active execution context of the state (if any) before a blocking operation,
+// returns the suspended context, which must be passed to AmlExecutionContextResume once the operation completes.
+// Also releases the blocking lock of the context (if bound), allowing other contexts bound to it to run in the meantime.
+// Does nothing and returns NULL if the state isn't executing within a context.
+//
+_Success_( return != NULL )
+AML_EXECUTION_CONTEXT*
+AmlExecutionContextSuspend(
+    _Inout_ struct _AML_STATE* State
+    );
+
+//
+// Re-enter an execution context previously suspended using AmlExecutionContextSuspend,
+// waits for the blocking lock of the context (if bound) first.
+//
+VOID
+AmlExecutionContextResume(
+    _Inout_opt_ AML_EXECUTION_CONTEXT* Context
+    );
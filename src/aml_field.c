@@ -8,6 +8,106 @@
 #include "aml_buffer_field.h"
 #include "aml_field.h"
 
+//
+// Maximum amount of access words batched into a single vectored region access by field reads and writes.
+//
+#define AML_FIELD_ACCESS_VECTOR_SIZE 16
+
+//
+// Mask of the given amount of low bits (1 to 64).
+//
+static
+UINT64
+AmlFieldBitMask(
+    _In_ UINT64 BitCount
+    )
+{
+    return ( ( 1ull << ( BitCount - 1 ) ) | ( ( 1ull << ( BitCount - 1 ) ) - 1 ) );
+}
+
+//
+// Merge the low BitCount bits (1 to 64) of the given value into a zero-initialized output buffer at the given bit index.
+// The output buffer must be large enough to contain the bit span.
+//
+static
+VOID
+AmlFieldStoreBits(
+    _Inout_ UINT8* Data,
+    _In_    UINT64 BitIndex,
+    _In_    UINT64 Value,
+    _In_    UINT64 BitCount
+    )
+{
+    UINT64 BitShift;
+    UINT64 ByteCount;
+    UINT64 i;
+
+    Value &= AmlFieldBitMask( BitCount );
+    Data += ( BitIndex / CHAR_BIT );
+    BitShift = ( BitIndex % CHAR_BIT );
+    ByteCount = ( ( BitShift + BitCount + ( CHAR_BIT - 1 ) ) / CHAR_BIT );
+    Data[ 0 ] |= ( UINT8 )( Value << BitShift );
+    for( i = 1; i < ByteCount; i++ ) {
+        Data[ i ] |= ( UINT8 )( Value >> ( ( i * CHAR_BIT ) - BitShift ) );
+    }
+}
+
+//
+// Load BitCount bits (1 to 64) from the given bit index of the input buffer, bits past the end of the input buffer read as 0.
+//
+static
+UINT64
+AmlFieldLoadBits(
+    _In_reads_bytes_( DataSize ) const UINT8* Data,
+    _In_                         SIZE_T       DataSize,
+    _In_                         UINT64       BitIndex,
+    _In_                         UINT64       BitCount
+    )
+{
+    UINT64 ByteIndex;
+    UINT64 BitShift;
+    UINT64 ByteCount;
+    UINT64 Value;
+    UINT64 i;
+
+    ByteIndex = ( BitIndex / CHAR_BIT );
+    BitShift = ( BitIndex % CHAR_BIT );
+    ByteCount = ( ( BitShift + BitCount + ( CHAR_BIT - 1 ) ) / CHAR_BIT );
+    if( ByteIndex >= DataSize ) {
+        return 0;
+    }
+    Value = ( Data[ ByteIndex ] >> BitShift );
+    for( i = 1; ( i < ByteCount ) && ( i < ( DataSize - ByteIndex ) ); i++ ) {
+        Value |= ( ( UINT64 )Data[ ByteIndex + i ] << ( ( i * CHAR_BIT ) - BitShift ) );
+    }
+    return ( Value & AmlFieldBitMask( BitCount ) );
+}
+
+//
+// Merge the field bits of the given access word of a field read (by its index within the span of the access plan) into the output buffer.
+// Only the first word may begin at a non-zero bit offset, all following words begin at bit 0.
+//
+static
+VOID
+AmlFieldStoreWord(
+    _In_    const AML_FIELD_ACCESS_PLAN* Plan,
+    _Inout_ VOID*                        ResultData,
+    _In_    UINT64                       OutputBitCount,
+    _In_    UINT64                       WordIndex,
+    _In_    UINT64                       WordData
+    )
+{
+    UINT64 WordBitOffset;
+    UINT64 BitIndex;
+
+    WordBitOffset = ( ( WordIndex == 0 ) ? Plan->FirstBitOffset : 0 );
+    BitIndex = ( ( WordIndex * Plan->AccessBitWidth ) + WordBitOffset - Plan->FirstBitOffset );
+    AmlFieldStoreBits( ResultData,
+                       BitIndex,
+                       ( WordData >> WordBitOffset ),
+                       AML_MIN( ( OutputBitCount - BitIndex ), ( Plan->AccessBitWidth - WordBitOffset ) ) );
+}
+
 //
 // Perform a BufferAcc field read with special semantics.
 //
@@ -126,15 +226,16 @@ AmlFieldRead(
     _Out_opt_                            SIZE_T*            pResultBitCount
     )
 {
-    UINT64                       AccessBitWidth;
+    const AML_FIELD_ACCESS_PLAN* Plan;
     AML_OBJECT_OPERATION_REGION* OpRegion;
-    UINT64                       AlignedFieldByteCount;
     UINT64                       i;
     UINT64                       OutputBitCount;
-    UINT64                       ByteIndex;
-    UINT8                        WordData[ 8 ];
-    UINT64                       WordBitOffset;
-    UINT64                       WordBitCount;
+    UINT64                       WordCount;
+    UINT64                       WordIndex;
+    UINT64                       WordData;
+    AML_REGION_ACCESS_ENTRY      Entries[ AML_FIELD_ACCESS_VECTOR_SIZE ];
+    SIZE_T                       EntryCount;
+    SIZE_T                       EntryIndex;
 
     //
     // BufferAcc access types require different semantics/handling.
@@ -144,58 +245,29 @@ AmlFieldRead(
     }
 
     //
-    // Validate the field's referenced operation region object.
+    // Validate the field's referenced operation region object, and the access plan built upon field creation.
     //
     if( ( Field->OperationRegion == NULL )
-        || ( Field->OperationRegion->Type != AML_OBJECT_TYPE_OPERATION_REGION ) )
+        || ( Field->OperationRegion->Type != AML_OBJECT_TYPE_OPERATION_REGION )
+        || ( Field->AccessPlan.IsValid == AML_FALSE ) )
     {
         return AML_FALSE;
     }
     OpRegion = &Field->OperationRegion->u.OpRegion;
+    Plan = &Field->AccessPlan;
 
     //
     // Ensure that the output buffer is big enough to fit the field data.
-    // If truncation is enabled, truncate the field data size if not big enough.
+    // If truncation is enabled, truncate the field data size (and the amount of read words) if not big enough.
     //
     OutputBitCount = Field->Element.Length;
+    WordCount = Plan->WordCount;
     if( OutputBitCount > ( ResultDataSize * CHAR_BIT ) ) {
         if( AllowTruncation == AML_FALSE ) {
             return AML_FALSE;
         }
         OutputBitCount = ( ResultDataSize * CHAR_BIT );
-    }
-
-    //
-    // Determine the bit-width for the given access type.
-    //
-    switch( Field->Element.AccessType ) {
-    case AML_FIELD_ACCESS_TYPE_ANY_ACC:
-        AccessBitWidth = 8;
-        break;
-    case AML_FIELD_ACCESS_TYPE_BYTE_ACC:
-        AccessBitWidth = 8;
-        break;
-    case AML_FIELD_ACCESS_TYPE_WORD_ACC:
-        AccessBitWidth = 16;
-        break;
-    case AML_FIELD_ACCESS_TYPE_DWORD_ACC:
-        AccessBitWidth = 32;
-        break;
-    case AML_FIELD_ACCESS_TYPE_QWORD_ACC:
-        AccessBitWidth = 64;
-        break;
-    default:
-        return AML_FALSE;
-    }
-
-    //
-    // Ensure that the region referenced by the field is large enough to contain the field's data.
-    //
-    AlignedFieldByteCount = ( ( ( Field->Element.Length + ( AccessBitWidth - 1 ) ) & ~( AccessBitWidth - 1 ) ) / CHAR_BIT );
-    if( ( AlignedFieldByteCount > OpRegion->Length )
-        || ( ( Field->Offset / CHAR_BIT ) > ( OpRegion->Length - AlignedFieldByteCount ) ) )
-    {
-        return AML_FALSE;
+        WordCount = ( ( Plan->FirstBitOffset + OutputBitCount + ( Plan->AccessBitWidth - 1 ) ) / Plan->AccessBitWidth );
     }
 
     //
@@ -206,35 +278,61 @@ AmlFieldRead(
     }
 
     //
-    // Attempt to read in chunks of the access width until we have received the full field value.
+    // Fast path for directly accessible SystemMemory regions, every access word is loaded straight from the region mapping.
+    // Any span exceeding the region is left to the regular path, which fails the access at the first out of bounds word.
     //
-    for( i = 0; i < OutputBitCount; i += WordBitCount ) {
+    if( AmlOperationRegionIsDirectAccess( State, OpRegion ) && ( Plan->EndWordOffset <= OpRegion->Length ) ) {
+        for( WordIndex = 0; WordIndex < WordCount; WordIndex++ ) {
+            WordData = AmlOperationRegionDirectRead( OpRegion,
+                                                     ( Plan->FirstWordOffset + ( WordIndex * ( Plan->AccessBitWidth / CHAR_BIT ) ) ),
+                                                     Plan->AccessBitWidth );
+            AmlFieldStoreWord( Plan, ResultData, OutputBitCount, WordIndex, WordData );
+        }
+    } else if( WordCount == 1 ) {
         //
-        // Read an access-word worth of data from the current (word) offset.
+        // Fast path for fields contained by a single access word, a single region access followed by a shift.
         //
-        ByteIndex = ( ( ( Field->Offset + i ) & ~( AccessBitWidth - 1 ) ) / CHAR_BIT );
+        WordData = 0;
         if( AmlOperationRegionRead( State,
                                     OpRegion,
                                     Field,
-                                    ByteIndex,
+                                    Plan->FirstWordOffset,
                                     Field->Element.AccessType,
                                     Field->Element.AccessAttributes,
-                                    AccessBitWidth,
-                                    WordData,
+                                    Plan->AccessBitWidth,
+                                    &WordData,
                                     sizeof( WordData ) ) == AML_FALSE )
         {
             return AML_FALSE;
         }
-
+        AmlFieldStoreWord( Plan, ResultData, OutputBitCount, 0, WordData );
+    } else {
         //
-        // Copy the desired bits of the read word to the output buffer.
+        // Read the span of access words covering the field, the access words are batched,
+        // every batch is passed to the region access handler as a single vectored access.
         //
-        WordBitOffset = ( ( Field->Offset + i ) % AccessBitWidth );
-        WordBitCount = AML_MIN( ( AccessBitWidth - WordBitOffset ), ( OutputBitCount - i ) );
-        if( AmlCopyBits( WordData, sizeof( WordData ), ResultData,
-                         ResultDataSize, WordBitOffset, WordBitCount, i ) == AML_FALSE )
-        {
-            return AML_FALSE;
+        for( WordIndex = 0; WordIndex < WordCount; ) {
+            EntryCount = ( SIZE_T )AML_MIN( ( WordCount - WordIndex ), AML_COUNTOF( Entries ) );
+            for( EntryIndex = 0; EntryIndex < EntryCount; EntryIndex++ ) {
+                Entries[ EntryIndex ] = ( AML_REGION_ACCESS_ENTRY ){
+                    .Offset   = ( Plan->FirstWordOffset + ( ( WordIndex + EntryIndex ) * ( Plan->AccessBitWidth / CHAR_BIT ) ) ),
+                    .BitWidth = Plan->AccessBitWidth
+                };
+            }
+            if( AmlOperationRegionAccessVector( State,
+                                                OpRegion,
+                                                Field,
+                                                AML_REGION_ACCESS_TYPE_READ,
+                                                Field->Element.AccessType,
+                                                Field->Element.AccessAttributes,
+                                                Entries,
+                                                EntryCount ) == AML_FALSE )
+            {
+                return AML_FALSE;
+            }
+            for( EntryIndex = 0; EntryIndex < EntryCount; EntryIndex++, WordIndex++ ) {
+                AmlFieldStoreWord( Plan, ResultData, OutputBitCount, WordIndex, Entries[ EntryIndex ].Word );
+            }
         }
     }
 
@@ -248,6 +346,40 @@ AmlFieldRead(
     return AML_TRUE;
 }
 
+//
+// Get the field write generation of the region space of a region, NULL for non-spec (OEM) region spaces.
+// The generation is shared by all regions of the same space, as separately declared regions may alias each other.
+//
+static
+UINT64*
+AmlFieldGetWriteGeneration(
+    _Inout_ struct _AML_STATE*                 State,
+    _In_    const AML_OBJECT_OPERATION_REGION* Region
+    )
+{
+    if( Region->SpaceType >= AML_COUNTOF( State->RegionSpaceWriteGenerations ) ) {
+        return NULL;
+    }
+    return &State->RegionSpaceWriteGenerations[ Region->SpaceType ];
+}
+
+//
+// Advance the field write generation of the region space of a region, done once for every field write.
+//
+static
+VOID
+AmlFieldAdvanceWriteGeneration(
+    _Inout_ struct _AML_STATE*                 State,
+    _In_    const AML_OBJECT_OPERATION_REGION* Region
+    )
+{
+    UINT64* Generation;
+
+    if( ( Generation = AmlFieldGetWriteGeneration( State, Region ) ) != NULL ) {
+        *Generation += 1;
+    }
+}
+
 //
 // Perform a BufferAcc field write with special semantics.
 //
@@ -317,6 +449,7 @@ AmlFieldBufferAccWrite(
     // Directly pass the packet along to the operation region access handler,
     // no chunked access is performed, and access must always be within the maximum buffer size of the type.
     //
+    AmlFieldAdvanceWriteGeneration( State, OpRegion );
     return AmlOperationRegionWrite( State,
                                     OpRegion,
                                     Field,
@@ -328,6 +461,36 @@ AmlFieldBufferAccWrite(
                                     PacketSize );
 }
 
+//
+// Perform all batched word writes of a field write as a single vectored region access, and reset the batch.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlFieldFlushWrites(
+    _Inout_                       struct _AML_STATE*           State,
+    _Inout_                       AML_OBJECT_OPERATION_REGION* OpRegion,
+    _In_                          AML_OBJECT_FIELD*            Field,
+    _Inout_count_( *pEntryCount ) AML_REGION_ACCESS_ENTRY*     Entries,
+    _Inout_                       SIZE_T*                      pEntryCount
+    )
+{
+    SIZE_T EntryCount;
+
+    if( ( EntryCount = *pEntryCount ) == 0 ) {
+        return AML_TRUE;
+    }
+    *pEntryCount = 0;
+    return AmlOperationRegionAccessVector( State,
+                                           OpRegion,
+                                           Field,
+                                           AML_REGION_ACCESS_TYPE_WRITE,
+                                           Field->Element.AccessType,
+                                           Field->Element.AccessAttributes,
+                                           Entries,
+                                           EntryCount );
+}
+
 //
 // Write data to the given field from the input data array.
 // The maximum input data size is passed in bytes, but the actual copy to the field is done at bit-granularity.
@@ -346,20 +509,19 @@ AmlFieldWrite(
     _In_                              BOOLEAN            AllowTruncation
     )
 {
-    UINT64                       AccessBitWidth;
-    UINT64                       AccessByteWidth;
+    const AML_FIELD_ACCESS_PLAN* Plan;
     AML_OBJECT_OPERATION_REGION* OpRegion;
-    UINT64                       AlignedFieldByteCount;
     UINT64                       WordData;
-    UINT64                       i;
-    UINT64                       RegionByteIndex;
-    UINT64                       WordBitCount;
+    UINT64                       WordIndex;
+    UINT64                       WordOffset;
     UINT64                       WordBitOffset;
-    UINT64                       FieldWidthMask;
-    UINT64                       AccessWidthMask;
+    UINT64                       WordBitCount;
     UINT64                       WordMask;
+    UINT64                       BitIndex;
     UINT64                       InputWordData;
-    UINT64                       InputBitCount;
+    BOOLEAN                      IsDirectAccess;
+    AML_REGION_ACCESS_ENTRY      Entries[ AML_FIELD_ACCESS_VECTOR_SIZE ];
+    SIZE_T                       EntryCount;
 
     //
     // BufferAcc access types require different semantics/handling.
@@ -390,40 +552,10 @@ AmlFieldWrite(
     }
 
     //
-    // Determine the properties for the given access type.
-    //
-    switch( Field->Element.AccessType ) {
-    case AML_FIELD_ACCESS_TYPE_ANY_ACC:
-        AccessBitWidth = 8;
-        break;
-    case AML_FIELD_ACCESS_TYPE_BYTE_ACC:
-        AccessBitWidth = 8;
-        break;
-    case AML_FIELD_ACCESS_TYPE_WORD_ACC:
-        AccessBitWidth = 16;
-        break;
-    case AML_FIELD_ACCESS_TYPE_DWORD_ACC:
-        AccessBitWidth = 32;
-        break;
-    case AML_FIELD_ACCESS_TYPE_QWORD_ACC:
-        AccessBitWidth = 64;
-        break;
-    default:
-        return AML_FALSE;
-    }
-
-    //
-    // Byte-size of the access word width, used when interacting with the underlying operation region.
-    //
-    AccessByteWidth = ( AccessBitWidth / CHAR_BIT );
-
-    //
-    // Ensure that the region referenced by the field is large enough to contain the field's data.
+    // Validate the access plan built upon field creation (access type and region bounds).
     //
-    AlignedFieldByteCount = ( ( ( Field->Element.Length + ( AccessBitWidth - 1 ) ) & ~( AccessBitWidth - 1 ) ) / CHAR_BIT );
-    if( ( AlignedFieldByteCount > OpRegion->Length )
-        || ( ( Field->Offset / CHAR_BIT ) > ( OpRegion->Length - AlignedFieldByteCount ) ) )
-    {
+    Plan = &Field->AccessPlan;
+    if( Plan->IsValid == AML_FALSE ) {
         return AML_FALSE;
     }
 
@@ -435,24 +567,33 @@ AmlFieldWrite(
     // }
 
     //
-    // Attempt to write in chunks of the access width until we have written the full field value.
+    // Directly accessible SystemMemory regions are loaded and stored straight from the region mapping.
+    // Any span exceeding the region is left to the regular path, which fails the access at the first out of bounds word.
     //
-    for( i = 0; i < Field->Element.Length; i += WordBitCount ) {
-        //
-        // Calculate the access-word-aligned byte index of the current word.
-        //
-        RegionByteIndex = ( ( ( Field->Offset + i ) & ~( AccessBitWidth - 1 ) ) / CHAR_BIT );
+    IsDirectAccess = ( AmlOperationRegionIsDirectAccess( State, OpRegion ) && ( Plan->EndWordOffset <= OpRegion->Length ) );
 
+    //
+    // Write the span of access words covering the field.
+    // The word writes are batched, every batch is passed to the region access handler as a single vectored access.
+    //
+    AmlFieldAdvanceWriteGeneration( State, OpRegion );
+    EntryCount = 0;
+    for( WordIndex = 0; WordIndex < Plan->WordCount; WordIndex++ ) {
         //
-        // Calculate the word-local bit offset and count, and determine the amount of input bits to use in this cycle.
+        // Determine the field bits covered by the current word, only the first word may begin at a non-zero bit offset,
+        // and only the first and last words may be partially covered by the field.
         // It is possible that there are no more input bits left, but we still need to update the rest of the word.
         //
-        WordBitOffset = ( ( Field->Offset + i ) % AccessBitWidth );
-        WordBitCount = AML_MIN( ( Field->Element.Length - i ), ( AccessBitWidth - WordBitOffset ) );
-        if( i < ( InputDataSize * CHAR_BIT ) ) {
-            InputBitCount = AML_MIN( WordBitCount, ( ( InputDataSize * CHAR_BIT ) - i ) );
+        WordOffset = ( Plan->FirstWordOffset + ( WordIndex * ( Plan->AccessBitWidth / CHAR_BIT ) ) );
+        WordBitOffset = ( ( WordIndex == 0 ) ? Plan->FirstBitOffset : 0 );
+        BitIndex = ( ( WordIndex * Plan->AccessBitWidth ) + WordBitOffset - Plan->FirstBitOffset );
+        WordBitCount = AML_MIN( ( Field->Element.Length - BitIndex ), ( Plan->AccessBitWidth - WordBitOffset ) );
+        if( WordIndex == 0 ) {
+            WordMask = Plan->FirstWordMask;
+        } else if( WordIndex == ( Plan->WordCount - 1 ) ) {
+            WordMask = Plan->LastWordMask;
         } else {
-            InputBitCount = 0;
+            WordMask = Plan->AccessWidthMask;
         }
 
         //
@@ -461,25 +602,29 @@ AmlFieldWrite(
         switch( AML_FIELD_FLAGS_UPDATE_RULE_GET( Field->Flags ) ) {
         case AML_FIELD_UPDATE_RULE_PRESERVE:
             //
-            // In preserve access mode, we must preserve any of the original unmodified bits of the word.
+            // In preserve access mode, we must preserve any of the original unmodified bits of partially covered words.
+            // All batched writes are flushed before the read, keeping the original order of the accesses.
             //
             WordData = 0;
-            if( AllowTruncation == AML_FALSE ) {
-                if( ( ( ( Field->Offset + i ) & ( AccessBitWidth - 1 ) ) != 0 )
-                    || ( ( Field->Element.Length - i ) < AccessBitWidth ) )
+            if( ( AllowTruncation == AML_FALSE ) && ( WordMask != Plan->AccessWidthMask ) ) {
+                if( IsDirectAccess ) {
+                    WordData = AmlOperationRegionDirectRead( OpRegion, WordOffset, Plan->AccessBitWidth );
+                    break;
+                }
+                if( AmlFieldFlushWrites( State, OpRegion, Field, Entries, &EntryCount ) == AML_FALSE ) {
+                    return AML_FALSE;
+                }
+                if( AmlOperationRegionRead( State,
+                                            OpRegion,
+                                            Field,
+                                            WordOffset,
+                                            Field->Element.AccessType,
+                                            Field->Element.AccessAttributes,
+                                            Plan->AccessBitWidth,
+                                            &WordData,
+                                            ( Plan->AccessBitWidth / CHAR_BIT ) ) == AML_FALSE )
                 {
-                    if( AmlOperationRegionRead( State,
-                                                OpRegion,
-                                                Field,
-                                                RegionByteIndex,
-                                                Field->Element.AccessType,
-                                                Field->Element.AccessAttributes,
-                                                AccessBitWidth,
-                                                &WordData,
-                                                AccessByteWidth ) == AML_FALSE )
-                    {
-                        return AML_FALSE;
-                    }
+                    return AML_FALSE;
                 }
             }
             break;
@@ -492,49 +637,36 @@ AmlFieldWrite(
         }
 
         //
-        // The word mask is the shifted mask of the word bits updated by this field write cycle.
-        //
-        AccessWidthMask = ( ( 1ull << ( AccessBitWidth - 1 ) ) | ( ( 1ull << ( AccessBitWidth - 1 ) ) - 1 ) );
-        FieldWidthMask = ( ( 1ull << ( WordBitCount - 1 ) ) | ( ( 1ull << ( WordBitCount - 1 ) ) - 1 ) );
-        WordMask = ( ( FieldWidthMask & AccessWidthMask ) << WordBitOffset );
-
-        //
-        // Read the input data for this write cycle.
-        //
-        InputWordData = 0;
-        if( i < ( InputDataSize * CHAR_BIT ) ) {
-            if( AmlCopyBits( InputData, InputDataSize, &InputWordData,
-                             sizeof( InputWordData ), i, InputBitCount, 0 ) == AML_FALSE )
-            {
-                return AML_FALSE;
-            }
-        }
-
-        //
-        // Update the portion of the word being updated in this cycle,
+        // Update the portion of the word covered by the field with the input data bits,
         // leaves other bit values that depend on the update rule.
         //
+        InputWordData = AmlFieldLoadBits( InputData, InputDataSize, BitIndex, WordBitCount );
         WordData &= ~WordMask;
         WordData |= ( ( InputWordData << WordBitOffset ) & WordMask );
 
         //
-        // Perform the actual write to the operation region word.
+        // Store the word directly, or queue up the write to the operation region word, flushing the batch once full.
         //
-        if( AmlOperationRegionWrite( State,
-                                     OpRegion,
-                                     Field,
-                                     RegionByteIndex,
-                                     Field->Element.AccessType,
-                                     Field->Element.AccessAttributes,
-                                     AccessBitWidth,
-                                     &WordData,
-                                     AccessByteWidth ) == AML_FALSE )
-        {
-            return AML_FALSE;
+        if( IsDirectAccess ) {
+            AmlOperationRegionDirectWrite( OpRegion, WordOffset, Plan->AccessBitWidth, WordData );
+            continue;
+        }
+        Entries[ EntryCount++ ] = ( AML_REGION_ACCESS_ENTRY ){
+            .Offset   = WordOffset,
+            .BitWidth = Plan->AccessBitWidth,
+            .Word     = WordData
+        };
+        if( EntryCount == AML_COUNTOF( Entries ) ) {
+            if( AmlFieldFlushWrites( State, OpRegion, Field, Entries, &EntryCount ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
         }
     }
 
-    return AML_TRUE;
+    //
+    // Perform all remaining batched writes.
+    //
+    return AmlFieldFlushWrites( State, OpRegion, Field, Entries, &EntryCount );
 }
 
 //
@@ -591,6 +723,65 @@ AmlBankFieldWrite(
     return AmlFieldWrite( State, &Field->Base, InputData, InputDataSize, AllowTruncation );
 }
 
+//
+// Write the index of an index field to its index register, selecting the field's data behind the data register.
+// If index register elision is enabled, the write is skipped when the register is known to still hold the index.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlIndexFieldSelect(
+    _Inout_ struct _AML_STATE*      State,
+    _In_    AML_OBJECT_INDEX_FIELD* Field
+    )
+{
+    AML_DATA                  IndexValue;
+    AML_DATA                  IndexField;
+    AML_INDEX_REGISTER_STATE* Register;
+    UINT64*                   Generation;
+    UINT64                    PreviousGeneration;
+
+    //
+    // Write the offset to the index register through the regular field path if elision isn't possible.
+    // The value written to the IndexName register is defined to be a byte offset that is aligned on an AccessType boundary
+    //
+    IndexValue = ( AML_DATA ){ .Type = AML_DATA_TYPE_INTEGER, .u.Integer = Field->AccessPlan.IndexValue };
+    IndexField = ( AML_DATA ){ .Type = AML_DATA_TYPE_FIELD_UNIT, .u.FieldUnit = Field->Index };
+    if( ( State->UseIndexRegisterElision == AML_FALSE ) || ( Field->AccessPlan.IsElidable == AML_FALSE ) ) {
+        return AmlConvIntegerToFieldUnit( State, &IndexValue, &IndexField, AML_CONV_FLAGS_IMPLICIT );
+    }
+
+    //
+    // Skip the write if the register still holds the index, no field writes have been made to its region space since it was written.
+    //
+    Register = &Field->Index->u.Field.IndexRegister;
+    Generation = AmlFieldGetWriteGeneration( State, &Field->Index->u.Field.OperationRegion->u.OpRegion );
+    if( Register->IsValid
+        && ( Register->Value == Field->AccessPlan.IndexValue )
+        && ( Register->SpaceWriteGeneration == *Generation ) )
+    {
+        return AML_TRUE;
+    }
+
+    //
+    // Write the index and remember it, the write itself advances the write generation of the region space exactly once,
+    // any additional write to the space made in the meantime (pending asynchronous accesses) leaves the index unknown.
+    //
+    Register->IsValid = AML_FALSE;
+    PreviousGeneration = *Generation;
+    if( AmlConvIntegerToFieldUnit( State, &IndexValue, &IndexField, AML_CONV_FLAGS_IMPLICIT ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    if( *Generation == ( PreviousGeneration + 1 ) ) {
+        *Register = ( AML_INDEX_REGISTER_STATE ){
+            .IsValid              = AML_TRUE,
+            .Value                = Field->AccessPlan.IndexValue,
+            .SpaceWriteGeneration = *Generation
+        };
+    }
+    return AML_TRUE;
+}
+
 //
 // The given ResultDataSize is the max size of the ResultData array in *bytes*.
 //
@@ -606,16 +797,10 @@ AmlIndexFieldRead(
     _Out_opt_                            SIZE_T*                 pResultBitCount
     )
 {
-    AML_DATA IndexValue;
-    AML_DATA IndexField;
-
     //
     // Write the offset to the index register before performing the actual read.
-    // The value written to the IndexName register is defined to be a byte offset that is aligned on an AccessType boundary
     //
-    IndexValue = ( AML_DATA ){ .Type = AML_DATA_TYPE_INTEGER, .u.Integer = ( Field->Offset / 8 ) };
-    IndexField = ( AML_DATA ){ .Type = AML_DATA_TYPE_FIELD_UNIT, .u.FieldUnit = Field->Index };
-    if( AmlConvIntegerToFieldUnit( State, &IndexValue, &IndexField, AML_CONV_FLAGS_IMPLICIT ) == AML_FALSE ) {
+    if( AmlIndexFieldSelect( State, Field ) == AML_FALSE ) {
         return AML_FALSE;
     }
     return AmlFieldUnitRead( State, Field->Data, ResultData, ResultDataSize, AllowTruncation, pResultBitCount );
@@ -636,18 +821,186 @@ AmlIndexFieldWrite(
     _In_                              BOOLEAN                 AllowTruncation
     )
 {
-    AML_DATA IndexValue;
-    AML_DATA IndexField;
+    AML_INDEX_REGISTER_STATE* Register;
+    UINT64*                   Generation;
+    UINT64                    PreviousGeneration;
+    BOOLEAN                   IsKnown;
 
     //
     // Write the offset to the index register before performing the actual write.
     //
-    IndexValue = ( AML_DATA ){ .Type = AML_DATA_TYPE_INTEGER, .u.Integer = ( Field->Offset / 8 ) };
-    IndexField = ( AML_DATA ){ .Type = AML_DATA_TYPE_FIELD_UNIT, .u.FieldUnit = Field->Index };
-    if( AmlConvIntegerToFieldUnit( State, &IndexValue, &IndexField, AML_CONV_FLAGS_IMPLICIT ) == AML_FALSE ) {
+    if( AmlIndexFieldSelect( State, Field ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( ( State->UseIndexRegisterElision == AML_FALSE ) || ( Field->AccessPlan.IsElidable == AML_FALSE ) ) {
+        return AmlFieldUnitWrite( State, Field->Data, InputData, InputDataSize, AllowTruncation );
+    }
+
+    //
+    // The data register doesn't overlap the index register, so the data write itself doesn't change the selected index,
+    // but it does advance the write generation of the index register's region space if both registers share the same space.
+    //
+    Register = &Field->Index->u.Field.IndexRegister;
+    Generation = AmlFieldGetWriteGeneration( State, &Field->Index->u.Field.OperationRegion->u.OpRegion );
+    PreviousGeneration = *Generation;
+    IsKnown = ( Register->IsValid && ( Register->SpaceWriteGeneration == PreviousGeneration ) );
+    if( AmlFieldUnitWrite( State, Field->Data, InputData, InputDataSize, AllowTruncation ) == AML_FALSE ) {
+        Register->IsValid = AML_FALSE;
         return AML_FALSE;
     }
-    return AmlFieldUnitWrite( State, Field->Data, InputData, InputDataSize, AllowTruncation );
+    if( IsKnown && ( *Generation == ( PreviousGeneration + 1 ) ) ) {
+        Register->SpaceWriteGeneration = *Generation;
+    }
+    return AML_TRUE;
+}
+
+//
+// Build the access plan of a newly created index field, the index and data field units must already be referenced.
+// Index register writes may only be elided if both registers are regular fields, and the data register doesn't overlap
+// the index register (within the region space), so that data accesses can never change the selected index.
+//
+VOID
+AmlIndexFieldBuildAccessPlan(
+    _Inout_ AML_OBJECT_INDEX_FIELD* Field
+    )
+{
+    const AML_OBJECT_FIELD*            Index;
+    const AML_OBJECT_FIELD*            Data;
+    const AML_OBJECT_OPERATION_REGION* IndexRegion;
+    const AML_OBJECT_OPERATION_REGION* DataRegion;
+
+    Field->AccessPlan = ( AML_INDEX_FIELD_ACCESS_PLAN ){
+        .IndexValue = ( Field->Offset / 8 ),
+        .IsElidable = AML_FALSE
+    };
+
+    //
+    // Both registers must be regular fields with valid access plans.
+    //
+    if( ( Field->Index == NULL )
+        || ( Field->Data == NULL )
+        || ( Field->Index->Type != AML_OBJECT_TYPE_FIELD )
+        || ( Field->Data->Type != AML_OBJECT_TYPE_FIELD ) )
+    {
+        return;
+    }
+    Index = &Field->Index->u.Field;
+    Data = &Field->Data->u.Field;
+    if( ( Index->AccessPlan.IsValid == AML_FALSE ) || ( Data->AccessPlan.IsValid == AML_FALSE ) ) {
+        return;
+    }
+
+    //
+    // Index register writes are tracked using the write generation of its region space (spec region spaces only).
+    //
+    IndexRegion = &Index->OperationRegion->u.OpRegion;
+    DataRegion = &Data->OperationRegion->u.OpRegion;
+    if( IndexRegion->SpaceType >= AML_MAX_SPEC_REGION_SPACE_TYPE_COUNT ) {
+        return;
+    }
+
+    //
+    // Registers within the same region space must not share any access words, regions of the same space may alias
+    // each other, so the registers are compared by their offsets within the space rather than within their regions.
+    //
+    if( IndexRegion->SpaceType == DataRegion->SpaceType ) {
+        if( ( IndexRegion->Offset > ( UINT64_MAX - Index->AccessPlan.EndWordOffset ) )
+            || ( DataRegion->Offset > ( UINT64_MAX - Data->AccessPlan.EndWordOffset ) ) )
+        {
+            return;
+        }
+        if( ( ( IndexRegion->Offset + Index->AccessPlan.FirstWordOffset ) < ( DataRegion->Offset + Data->AccessPlan.EndWordOffset ) )
+            && ( ( DataRegion->Offset + Data->AccessPlan.FirstWordOffset ) < ( IndexRegion->Offset + Index->AccessPlan.EndWordOffset ) ) )
+        {
+            return;
+        }
+    }
+
+    Field->AccessPlan.IsElidable = AML_TRUE;
+}
+
+//
+// Build the access plan of a newly created field (or bank field base), the field's region must already be referenced.
+// Fields that can't be accessed using regular access words (BufferAcc fields, or fields outside of their region)
+// are given an invalid plan, regular reads and writes of such fields fail.
+//
+VOID
+AmlFieldBuildAccessPlan(
+    _Inout_ AML_OBJECT_FIELD* Field
+    )
+{
+    AML_FIELD_ACCESS_PLAN*       Plan;
+    AML_OBJECT_OPERATION_REGION* OpRegion;
+    UINT64                       AccessBitWidth;
+    UINT64                       AlignedFieldByteCount;
+    UINT64                       FirstWordBitCount;
+    UINT64                       LastWordBitCount;
+
+    Plan = &Field->AccessPlan;
+    *Plan = ( AML_FIELD_ACCESS_PLAN ){ .IsValid = AML_FALSE };
+
+    //
+    // Validate the field's referenced operation region object.
+    //
+    if( ( Field->OperationRegion == NULL )
+        || ( Field->OperationRegion->Type != AML_OBJECT_TYPE_OPERATION_REGION ) )
+    {
+        return;
+    }
+    OpRegion = &Field->OperationRegion->u.OpRegion;
+
+    //
+    // Determine the bit-width for the given access type, BufferAcc fields aren't accessed using access words.
+    //
+    switch( Field->Element.AccessType ) {
+    case AML_FIELD_ACCESS_TYPE_ANY_ACC:
+        AccessBitWidth = 8;
+        break;
+    case AML_FIELD_ACCESS_TYPE_BYTE_ACC:
+        AccessBitWidth = 8;
+        break;
+    case AML_FIELD_ACCESS_TYPE_WORD_ACC:
+        AccessBitWidth = 16;
+        break;
+    case AML_FIELD_ACCESS_TYPE_DWORD_ACC:
+        AccessBitWidth = 32;
+        break;
+    case AML_FIELD_ACCESS_TYPE_QWORD_ACC:
+        AccessBitWidth = 64;
+        break;
+    default:
+        return;
+    }
+
+    //
+    // Ensure that the region referenced by the field is large enough to contain the field's data,
+    // the field length must also be small enough to not overflow the aligned bit counts below.
+    //
+    if( Field->Element.Length > ( UINT64_MAX - ( AccessBitWidth * 2 ) ) ) {
+        return;
+    }
+    AlignedFieldByteCount = ( ( ( Field->Element.Length + ( AccessBitWidth - 1 ) ) & ~( AccessBitWidth - 1 ) ) / CHAR_BIT );
+    if( ( AlignedFieldByteCount > OpRegion->Length )
+        || ( ( Field->Offset / CHAR_BIT ) > ( OpRegion->Length - AlignedFieldByteCount ) ) )
+    {
+        return;
+    }
+
+    //
+    // Determine the span of access words covering the field, and the field bits within the first and last words.
+    //
+    Plan->AccessBitWidth  = ( UINT8 )AccessBitWidth;
+    Plan->FirstBitOffset  = ( UINT8 )( Field->Offset % AccessBitWidth );
+    Plan->FirstWordOffset = ( ( Field->Offset & ~( AccessBitWidth - 1 ) ) / CHAR_BIT );
+    Plan->WordCount       = ( ( Plan->FirstBitOffset + Field->Element.Length + ( AccessBitWidth - 1 ) ) / AccessBitWidth );
+    Plan->EndWordOffset   = ( Plan->FirstWordOffset + ( Plan->WordCount * ( AccessBitWidth / CHAR_BIT ) ) );
+    Plan->AccessWidthMask = AmlFieldBitMask( AccessBitWidth );
+    if( Plan->WordCount != 0 ) {
+        FirstWordBitCount = AML_MIN( Field->Element.Length, ( AccessBitWidth - Plan->FirstBitOffset ) );
+        LastWordBitCount = ( ( Plan->FirstBitOffset + Field->Element.Length ) - ( ( Plan->WordCount - 1 ) * AccessBitWidth ) );
+        Plan->FirstWordMask = ( AmlFieldBitMask( FirstWordBitCount ) << Plan->FirstBitOffset );
+        Plan->LastWordMask = ( ( Plan->WordCount == 1 ) ? Plan->FirstWordMask : AmlFieldBitMask( LastWordBitCount ) );
+    }
+    Plan->IsValid = AML_TRUE;
 }
 
 //
@@ -775,4 +1128,104 @@ AmlFieldUnitWrite(
     }
 
     return AML_FALSE;
+}
+
+//
+// Access a run of index fields in order, writing every field from the corresponding input value if given,
+// otherwise reading every field into the corresponding output value.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlIndexFieldAccessRun(
+    _Inout_                  struct _AML_STATE*         State,
+    _In_count_( FieldCount ) struct _AML_OBJECT* const* FieldObjects,
+    _In_                     SIZE_T                     FieldCount,
+    _In_opt_                 const UINT64*              InputValues,
+    _Inout_opt_              UINT64*                    OutputValues
+    )
+{
+    const AML_OBJECT_INDEX_FIELD* First;
+    BOOLEAN                       IsLocked;
+    BOOLEAN                       Success;
+    SIZE_T                        i;
+
+    if( FieldCount == 0 ) {
+        return AML_TRUE;
+    }
+
+    //
+    // All fields of the run must be index fields sharing the same index and data registers.
+    //
+    if( FieldObjects[ 0 ]->Type != AML_OBJECT_TYPE_INDEX_FIELD ) {
+        return AML_FALSE;
+    }
+    First = &FieldObjects[ 0 ]->u.IndexField;
+    IsLocked = AML_FALSE;
+    for( i = 0; i < FieldCount; i++ ) {
+        if( ( FieldObjects[ i ]->Type != AML_OBJECT_TYPE_INDEX_FIELD )
+            || ( FieldObjects[ i ]->u.IndexField.Index != First->Index )
+            || ( FieldObjects[ i ]->u.IndexField.Data != First->Data ) )
+        {
+            AML_DEBUG_ERROR( State, "Error: Index field run must only contain index fields of the same registers!\n" );
+            return AML_FALSE;
+        }
+        IsLocked |= ( AML_FIELD_FLAGS_LOCK_RULE_GET( FieldObjects[ i ]->u.IndexField.Flags ) != 0 );
+    }
+
+    //
+    // Access all fields under a single acquisition of the global lock (if required by any of them).
+    //
+    if( IsLocked ) {
+        if( AmlMutexAcquire( State, State->GlobalLock, 0xFFFF ) != AML_WAIT_STATUS_SUCCESS ) {
+            return AML_FALSE;
+        }
+    }
+    Success = AML_TRUE;
+    for( i = 0; ( i < FieldCount ) && Success; i++ ) {
+        if( InputValues != NULL ) {
+            Success = AmlIndexFieldWrite( State, &FieldObjects[ i ]->u.IndexField,
+                                          &InputValues[ i ], sizeof( InputValues[ i ] ), AML_FALSE );
+        } else if( OutputValues != NULL ) {
+            OutputValues[ i ] = 0;
+            Success = AmlIndexFieldRead( State, &FieldObjects[ i ]->u.IndexField,
+                                         &OutputValues[ i ], sizeof( OutputValues[ i ] ), AML_FALSE, NULL );
+        }
+    }
+    if( IsLocked ) {
+        AmlMutexRelease( State, State->GlobalLock );
+    }
+    return Success;
+}
+
+//
+// Read a run of index fields (of up to 64 bits each) in order, every field into the corresponding entry of Values.
+// All fields must share the same index and data registers, the global lock is acquired once for the entire run.
+//
+_Success_( return )
+BOOLEAN
+AmlIndexFieldReadRun(
+    _Inout_                     struct _AML_STATE*         State,
+    _In_count_( FieldCount )    struct _AML_OBJECT* const* FieldObjects,
+    _In_                        SIZE_T                     FieldCount,
+    _Inout_count_( FieldCount ) UINT64*                    Values
+    )
+{
+    return AmlIndexFieldAccessRun( State, FieldObjects, FieldCount, NULL, Values );
+}
+
+//
+// Write a run of index fields (of up to 64 bits each) in order, every field from the corresponding entry of Values.
+// All fields must share the same index and data registers, the global lock is acquired once for the entire run.
+//
+_Success_( return )
+BOOLEAN
+AmlIndexFieldWriteRun(
+    _Inout_                  struct _AML_STATE*         State,
+    _In_count_( FieldCount ) struct _AML_OBJECT* const* FieldObjects,
+    _In_                     SIZE_T                     FieldCount,
+    _In_count_( FieldCount ) const UINT64*              Values
+    )
+{
+    return AmlIndexFieldAccessRun( State, FieldObjects, FieldCount, Values, NULL );
 }
\ No newline at end of file
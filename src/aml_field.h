@@ -2,6 +2,26 @@
 
 #include "aml_platform.h"
 
+//
+// Build the access plan of a newly created field (or bank field base), the field's region must already be referenced.
+// Fields that can't be accessed using regular access words (BufferAcc fields, or fields outside of their region)
+// are given an invalid plan, regular reads and writes of such fields fail.
+//
+VOID
+AmlFieldBuildAccessPlan(
+    _Inout_ struct _AML_OBJECT_FIELD* Field
+    );
+
+//
+// Build the access plan of a newly created index field, the index and data field units must already be referenced.
+// Index register writes may only be elided if both registers are regular fields, and the data register doesn't overlap
+// the index register (within the region space), so that data accesses can never change the selected index.
+//
+VOID
+AmlIndexFieldBuildAccessPlan(
+    _Inout_ struct _AML_OBJECT_INDEX_FIELD* Field
+    );
+
 //
 // Read data from a field unit object (field, buffer field, index field, bank field).
 //
@@ -30,4 +50,30 @@ AmlFieldUnitWrite(
     _In_reads_bytes_( InputDataSize ) const VOID*         InputData,
     _In_                              SIZE_T              InputDataSize,
     _In_                              BOOLEAN             AllowTruncation
+    );
+
+//
+// Read a run of index fields (of up to 64 bits each) in order, every field into the corresponding entry of Values.
+// All fields must share the same index and data registers, the global lock is acquired once for the entire run.
+//
+_Success_( return )
+BOOLEAN
+AmlIndexFieldReadRun(
+    _Inout_                     struct _AML_STATE*         State,
+    _In_count_( FieldCount )    struct _AML_OBJECT* const* FieldObjects,
+    _In_                        SIZE_T                     FieldCount,
+    _Inout_count_( FieldCount ) UINT64*                    Values
+    );
+
+//
+// Write a run of index fields (of up to 64 bits each) in order, every field from the corresponding entry of Values.
+// All fields must share the same index and data registers, the global lock is acquired once for the entire run.
+//
+_Success_( return )
+BOOLEAN
+AmlIndexFieldWriteRun(
+    _Inout_                  struct _AML_STATE*         State,
+    _In_count_( FieldCount ) struct _AML_OBJECT* const* FieldObjects,
+    _In_                     SIZE_T                     FieldCount,
+    _In_count_( FieldCount ) const UINT64*              Values
     );
\ No newline at end of file
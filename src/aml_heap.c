@@ -96,8 +96,8 @@ AmlHeapAllocate(
         //
         // Pop the found block from the bin.
         //
-        BinEntry->Next = NULL;
         Heap->Bins[ BinIndex ] = BinEntry->Next;
+        BinEntry->Next = NULL;
 
         //
         // Poison the block header until the block is freed again.
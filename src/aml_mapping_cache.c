@@ -0,0 +1,297 @@
+#include "aml_mapping_cache.h"
+
+//
+// Unlink a mapping from the idle list.
+//
+static
+VOID
+AmlMappingCacheIdleRemove(
+    _Inout_ AML_MAPPING_CACHE* Cache,
+    _Inout_ AML_MAPPING*       Mapping
+    )
+{
+    if( Mapping->IdlePrev != NULL ) {
+        Mapping->IdlePrev->IdleNext = Mapping->IdleNext;
+    } else {
+        Cache->IdleHead = Mapping->IdleNext;
+    }
+    if( Mapping->IdleNext != NULL ) {
+        Mapping->IdleNext->IdlePrev = Mapping->IdlePrev;
+    } else {
+        Cache->IdleTail = Mapping->IdlePrev;
+    }
+    Mapping->IdleNext = NULL;
+    Mapping->IdlePrev = NULL;
+    Cache->IdleCount -= 1;
+}
+
+//
+// Link a mapping to the head (most recently used end) of the idle list.
+//
+static
+VOID
+AmlMappingCacheIdleInsert(
+    _Inout_ AML_MAPPING_CACHE* Cache,
+    _Inout_ AML_MAPPING*       Mapping
+    )
+{
+    Mapping->IdlePrev = NULL;
+    Mapping->IdleNext = Cache->IdleHead;
+    if( Cache->IdleHead != NULL ) {
+        Cache->IdleHead->IdlePrev = Mapping;
+    } else {
+        Cache->IdleTail = Mapping;
+    }
+    Cache->IdleHead = Mapping;
+    Cache->IdleCount += 1;
+}
+
+//
+// Unlink a mapping from the lookup list.
+//
+static
+VOID
+AmlMappingCacheListRemove(
+    _Inout_ AML_MAPPING_CACHE* Cache,
+    _Inout_ AML_MAPPING*       Mapping
+    )
+{
+    if( Mapping->Prev != NULL ) {
+        Mapping->Prev->Next = Mapping->Next;
+    } else {
+        Cache->Head = Mapping->Next;
+    }
+    if( Mapping->Next != NULL ) {
+        Mapping->Next->Prev = Mapping->Prev;
+    }
+    Mapping->Next = NULL;
+    Mapping->Prev = NULL;
+}
+
+//
+// Link a mapping to the head of the lookup list.
+//
+static
+VOID
+AmlMappingCacheListInsert(
+    _Inout_ AML_MAPPING_CACHE* Cache,
+    _Inout_ AML_MAPPING*       Mapping
+    )
+{
+    Mapping->Prev = NULL;
+    Mapping->Next = Cache->Head;
+    if( Cache->Head != NULL ) {
+        Cache->Head->Prev = Mapping;
+    }
+    Cache->Head = Mapping;
+}
+
+//
+// Unmap and free a mapping that has already been unlinked from all lists.
+//
+static
+VOID
+AmlMappingCacheDestroy(
+    _Inout_                AML_MAPPING_CACHE* Cache,
+    _Inout_ _Post_invalid_ AML_MAPPING*       Mapping
+    )
+{
+    AmlHostMemoryUnmap( Cache->Host, Mapping->VirtualBase, Mapping->Size );
+    Cache->Statistics.HostUnmapCount += 1;
+    AmlHeapFree( Cache->Heap, Mapping );
+}
+
+//
+// Initialize an empty mapping cache, keeping at most IdleLimit idle mappings alive.
+//
+VOID
+AmlMappingCacheInitialize(
+    _Out_   AML_MAPPING_CACHE*        Cache,
+    _Inout_ struct _AML_HOST_CONTEXT* Host,
+    _Inout_ AML_HEAP*                 Heap,
+    _In_    SIZE_T                    IdleLimit
+    )
+{
+    *Cache = ( AML_MAPPING_CACHE ){ .Host = Host, .Heap = Heap, .IdleLimit = IdleLimit };
+}
+
+//
+// Unmap all idle mappings and free all cache entries, all mappings must have been released.
+// Mappings that are still referenced are only unlinked from the cache (superseded), their host mappings are leaked.
+//
+VOID
+AmlMappingCacheRelease(
+    _Inout_ AML_MAPPING_CACHE* Cache
+    )
+{
+    AML_MAPPING* Mapping;
+
+    while( ( Mapping = Cache->Head ) != NULL ) {
+        AmlMappingCacheListRemove( Cache, Mapping );
+        if( Mapping->ReferenceCount != 0 ) {
+            Mapping->IsSuperseded = AML_TRUE;
+            continue;
+        }
+        AmlMappingCacheIdleRemove( Cache, Mapping );
+        AmlMappingCacheDestroy( Cache, Mapping );
+    }
+}
+
+//
+// Acquire a reference to a mapping covering the given physical range, mapping (or remapping a merged range) if required.
+// Returns the mapping and the virtual address corresponding to the given physical address.
+//
+_Success_( return )
+BOOLEAN
+AmlMappingCacheAcquire(
+    _Inout_  AML_MAPPING_CACHE* Cache,
+    _In_     UINT64             PhysicalAddress,
+    _In_     UINT64             Size,
+    _Outptr_ AML_MAPPING**      ppMapping,
+    _Outptr_ VOID**             ppMappedAddress
+    )
+{
+    AML_MAPPING* Mapping;
+    AML_MAPPING* Contained;
+    AML_MAPPING* NextMapping;
+    UINT64       Base;
+    UINT64       End;
+    UINT64       MergedBase;
+    UINT64       MergedEnd;
+    UINT64       MappingEnd;
+    BOOLEAN      IsMergeChanged;
+    VOID*        VirtualBase;
+
+    //
+    // Determine the page-aligned physical range, empty ranges still require the containing page to be mapped.
+    //
+    Size = AML_MAX( Size, 1 );
+    if( ( PhysicalAddress > ( UINT64_MAX - Size ) )
+        || ( ( PhysicalAddress + Size ) > ( UINT64_MAX - ( AML_BUILD_MAPPING_CACHE_PAGE_SIZE - 1 ) ) ) )
+    {
+        return AML_FALSE;
+    }
+    Base = ( PhysicalAddress & ~( ( UINT64 )AML_BUILD_MAPPING_CACHE_PAGE_SIZE - 1 ) );
+    End = ( ( PhysicalAddress + Size + ( AML_BUILD_MAPPING_CACHE_PAGE_SIZE - 1 ) ) & ~( ( UINT64 )AML_BUILD_MAPPING_CACHE_PAGE_SIZE - 1 ) );
+    Cache->Statistics.AcquireCount += 1;
+
+    //
+    // Attempt to find an existing mapping that fully covers the range.
+    // Otherwise, determine the union of the range and all (transitively) overlapping mappings.
+    //
+    MergedBase = Base;
+    MergedEnd = End;
+    do {
+        IsMergeChanged = AML_FALSE;
+        for( Mapping = Cache->Head; Mapping != NULL; Mapping = Mapping->Next ) {
+            MappingEnd = ( Mapping->PhysicalBase + Mapping->Size );
+            if( ( Mapping->PhysicalBase <= Base ) && ( MappingEnd >= End ) ) {
+                if( Mapping->ReferenceCount++ == 0 ) {
+                    AmlMappingCacheIdleRemove( Cache, Mapping );
+                }
+                Cache->Statistics.MapCallsSaved += 1;
+                *ppMapping = Mapping;
+                *ppMappedAddress = ( ( UINT8* )Mapping->VirtualBase + ( PhysicalAddress - Mapping->PhysicalBase ) );
+                return AML_TRUE;
+            }
+            if( ( Mapping->PhysicalBase < MergedEnd ) && ( MappingEnd > MergedBase )
+                && ( ( Mapping->PhysicalBase < MergedBase ) || ( MappingEnd > MergedEnd ) ) )
+            {
+                MergedBase = AML_MIN( MergedBase, Mapping->PhysicalBase );
+                MergedEnd = AML_MAX( MergedEnd, MappingEnd );
+                IsMergeChanged = AML_TRUE;
+            }
+        }
+    } while( IsMergeChanged );
+
+    //
+    // Map the merged range, if the host fails to map the (larger) merged range, fall back to mapping only the requested range.
+    //
+    if( ( Mapping = AmlHeapAllocate( Cache->Heap, sizeof( *Mapping ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    if( AmlHostMemoryMap( Cache->Host, MergedBase, ( MergedEnd - MergedBase ), 0, &VirtualBase ) == AML_FALSE ) {
+        if( ( ( MergedBase == Base ) && ( MergedEnd == End ) )
+            || ( AmlHostMemoryMap( Cache->Host, Base, ( End - Base ), 0, &VirtualBase ) == AML_FALSE ) )
+        {
+            AmlHeapFree( Cache->Heap, Mapping );
+            return AML_FALSE;
+        }
+        MergedBase = Base;
+        MergedEnd = End;
+    }
+    Cache->Statistics.HostMapCount += 1;
+
+    //
+    // All mappings contained by the new mapping are superseded by it, idle ones are unmapped immediately,
+    // referenced ones are unmapped upon release of their last reference.
+    //
+    for( Contained = Cache->Head; Contained != NULL; Contained = NextMapping ) {
+        NextMapping = Contained->Next;
+        if( ( Contained->PhysicalBase < MergedBase )
+            || ( ( Contained->PhysicalBase + Contained->Size ) > MergedEnd ) )
+        {
+            continue;
+        }
+        Cache->Statistics.MergeCount += 1;
+        AmlMappingCacheListRemove( Cache, Contained );
+        if( Contained->ReferenceCount != 0 ) {
+            Contained->IsSuperseded = AML_TRUE;
+        } else {
+            AmlMappingCacheIdleRemove( Cache, Contained );
+            AmlMappingCacheDestroy( Cache, Contained );
+        }
+    }
+
+    //
+    // Insert the new mapping, holding the first reference.
+    //
+    *Mapping = ( AML_MAPPING ){
+        .PhysicalBase   = MergedBase,
+        .Size           = ( MergedEnd - MergedBase ),
+        .VirtualBase    = VirtualBase,
+        .ReferenceCount = 1,
+    };
+    AmlMappingCacheListInsert( Cache, Mapping );
+    *ppMapping = Mapping;
+    *ppMappedAddress = ( ( UINT8* )VirtualBase + ( PhysicalAddress - MergedBase ) );
+    return AML_TRUE;
+}
+
+//
+// Release a reference to a mapping returned by AmlMappingCacheAcquire.
+// The last reference moves the mapping to the idle pool (evicting the least recently used idle mapping if full),
+// superseded mappings are unmapped immediately.
+//
+VOID
+AmlMappingCacheReleaseMapping(
+    _Inout_                AML_MAPPING_CACHE* Cache,
+    _Inout_ _Post_invalid_ AML_MAPPING*       Mapping
+    )
+{
+    AML_MAPPING* Victim;
+
+    if( --Mapping->ReferenceCount != 0 ) {
+        return;
+    }
+
+    //
+    // Superseded mappings are no longer reachable, unmap them immediately.
+    //
+    if( Mapping->IsSuperseded ) {
+        AmlMappingCacheDestroy( Cache, Mapping );
+        return;
+    }
+
+    //
+    // Keep the mapping alive in the idle pool, evicting the least recently used idle mapping if the pool is full.
+    //
+    AmlMappingCacheIdleInsert( Cache, Mapping );
+    if( Cache->IdleCount > Cache->IdleLimit ) {
+        Victim = Cache->IdleTail;
+        AmlMappingCacheIdleRemove( Cache, Victim );
+        AmlMappingCacheListRemove( Cache, Victim );
+        AmlMappingCacheDestroy( Cache, Victim );
+        Cache->Statistics.EvictionCount += 1;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_heap.h"
+#include "aml_host.h"
+
+//
+// Granularity of cached physical mappings, all cached ranges are aligned to this size.
+//
+#ifndef AML_BUILD_MAPPING_CACHE_PAGE_SIZE
+ #define AML_BUILD_MAPPING_CACHE_PAGE_SIZE 4096
+#endif
+
+//
+// Default maximum amount of idle (unreferenced) mappings kept alive by a mapping cache.
+//
+#define AML_MAPPING_CACHE_DEFAULT_IDLE_LIMIT 16
+
+//
+// Cached host mapping of a page-aligned physical range.
+// A mapping that has been merged into a larger mapping is superseded, it is no longer found by lookups,
+// and is unmapped as soon as its last reference is released.
+//
+typedef struct _AML_MAPPING {
+    struct _AML_MAPPING* Next;           /* Lookup list (not superseded mappings only). */
+    struct _AML_MAPPING* Prev;
+    struct _AML_MAPPING* IdleNext;       /* Idle list, ordered from most to least recently used (unreferenced mappings only). */
+    struct _AML_MAPPING* IdlePrev;
+    UINT64               PhysicalBase;
+    UINT64               Size;
+    VOID*                VirtualBase;
+    SIZE_T               ReferenceCount;
+    BOOLEAN              IsSuperseded;
+} AML_MAPPING;
+
+//
+// Mapping cache statistics.
+// MapCallsSaved is the amount of acquisitions that were satisfied without a new host mapping.
+//
+typedef struct _AML_MAPPING_CACHE_STATISTICS {
+    UINT64 AcquireCount;
+    UINT64 HostMapCount;
+    UINT64 HostUnmapCount;
+    UINT64 MapCallsSaved;
+    UINT64 MergeCount;
+    UINT64 EvictionCount;
+} AML_MAPPING_CACHE_STATISTICS;
+
+//
+// Shared, reference-counted cache of host physical memory mappings (used for SystemMemory operation regions).
+// Overlapping requests are satisfied by a single mapping covering the union of their page-aligned ranges,
+// unreferenced mappings are kept alive in an LRU-bounded idle pool, so that repeated creation of (temporary)
+// regions over the same physical range doesn't cost any host map/unmap calls.
+//
+typedef struct _AML_MAPPING_CACHE {
+    struct _AML_HOST_CONTEXT*    Host;
+    AML_HEAP*                    Heap;
+    AML_MAPPING*                 Head;
+    AML_MAPPING*                 IdleHead;
+    AML_MAPPING*                 IdleTail;
+    SIZE_T                       IdleCount;
+    SIZE_T                       IdleLimit;
+    AML_MAPPING_CACHE_STATISTICS Statistics;
+} AML_MAPPING_CACHE;
+
+//
+// Initialize an empty mapping cache, keeping at most IdleLimit idle mappings alive.
+//
+VOID
+AmlMappingCacheInitialize(
+    _Out_   AML_MAPPING_CACHE*        Cache,
+    _Inout_ struct _AML_HOST_CONTEXT* Host,
+    _Inout_ AML_HEAP*                 Heap,
+    _In_    SIZE_T                    IdleLimit
+    );
+
+//
+// Unmap all idle mappings and free all cache entries, all mappings must have been released.
+// Mappings that are still referenced are only unlinked from the cache (superseded), their host mappings are leaked.
+//
+VOID
+AmlMappingCacheRelease(
+    _Inout_ AML_MAPPING_CACHE* Cache
+    );
+
+//
+// Acquire a reference to a mapping covering the given physical range, mapping (or remapping a merged range) if required.
+// Returns the mapping and the virtual address corresponding to the given physical address.
+//
+_Success_( return )
+BOOLEAN
+AmlMappingCacheAcquire(
+    _Inout_  AML_MAPPING_CACHE* Cache,
+    _In_     UINT64             PhysicalAddress,
+    _In_     UINT64             Size,
+    _Outptr_ AML_MAPPING**      ppMapping,
+    _Outptr_ VOID**             ppMappedAddress
+    );
+
+//
+// Release a reference to a mapping returned by AmlMappingCacheAcquire.
+// The last reference moves the mapping to the idle pool (evicting the least recently used idle mapping if full),
+// superseded mappings are unmapped immediately.
+//
+VOID
+AmlMappingCacheReleaseMapping(
+    _Inout_                AML_MAPPING_CACHE* Cache,
+    _Inout_ _Post_invalid_ AML_MAPPING*       Mapping
+    );
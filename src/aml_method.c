@@ -3,6 +3,8 @@
 #include "aml_debug.h"
 #include "aml_state.h"
 #include "aml_mutex.h"
+#include "aml_eval_async.h"
+#include "aml_name_cache.h"
 
 //
 // Track an acquisition of the given mutex within the current method scope.
@@ -324,10 +326,73 @@ AmlMethodPopScope(
     return AmlArenaSnapshotRollback( &State->MethodScopeArena, &PoppedScope->ArenaSnapshot );
 }
 
+//
+// Begin the invocation of a serialized method within the active execution context of the state.
+// Waits for any other execution context to leave the method, recursive invocations by the owning context are allowed.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlMethodSerializationAcquire(
+    _Inout_ struct _AML_STATE* State,
+    _Inout_ AML_OBJECT_METHOD* MethodInfo
+    )
+{
+    AML_WAIT_STATUS WaitStatus;
+
+    //
+    // Recursive invocation by the current owner.
+    //
+    if( MethodInfo->SerializationOwner == State->ActiveContext ) {
+        MethodInfo->SerializationDepth += 1;
+        return AML_TRUE;
+    }
+
+    //
+    // Lazily create the serialization mutex of the method.
+    //
+    if( MethodInfo->HasSerializationMutex == AML_FALSE ) {
+        if( AmlHostMutexCreate( State->Host, &MethodInfo->SerializationMutex ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        MethodInfo->SerializationHost     = State->Host;
+        MethodInfo->HasSerializationMutex = AML_TRUE;
+    }
+
+    //
+    // Wait for the current owner to leave the method, other contexts may run while waiting.
+    //
+    WaitStatus = AmlEvalAsyncMutexAcquire( State, MethodInfo->SerializationMutex, 0xFFFF );
+    if( WaitStatus != AML_WAIT_STATUS_SUCCESS ) {
+        return AML_FALSE;
+    }
+    MethodInfo->SerializationOwner = State->ActiveContext;
+    MethodInfo->SerializationDepth = 1;
+    return AML_TRUE;
+}
+
+//
+// End the invocation of a serialized method previously begun using AmlMethodSerializationAcquire.
+//
+static
+VOID
+AmlMethodSerializationRelease(
+    _Inout_ struct _AML_STATE* State,
+    _Inout_ AML_OBJECT_METHOD* MethodInfo
+    )
+{
+    if( ( MethodInfo->SerializationDepth -= 1 ) == 0 ) {
+        MethodInfo->SerializationOwner = NULL;
+        AmlHostMutexRelease( State->Host, MethodInfo->SerializationMutex );
+    }
+}
+
 //
 // Evaluate a method invocation to a created method object.
 // Does not consume any code from the state (for arguments),
 // requires all arguments to be setup and passed here.
+// The method body is evaluated by a nested evaluation loop with its own base frame (natively recursive),
+// as the caller may be in the middle of an expression that consumes the return value.
 //
 _Success_( return )
 BOOLEAN
@@ -348,6 +413,8 @@ AmlMethodInvoke(
     AML_DATA               ReturnValue;
     AML_INTERRUPTION_EVENT OldPendingEvent;
     AML_INTERRUPTION_EVENT PendingEvent;
+    AML_NAME_CACHE*        OldNameCache;
+    BOOLEAN                IsSerialized;
 
     //
     // The given object must have a namespace node attached (for scope informaiton).
@@ -374,10 +441,24 @@ AmlMethodInvoke(
         return AML_FALSE;
     }
 
+    //
+    // Serialized methods may only be active within a single execution context at a time.
+    // Serialization is only required if the state is being executed within execution contexts.
+    //
+    IsSerialized = ( MethodInfo->IsSerialized && ( State->ActiveContext != NULL ) );
+    if( IsSerialized ) {
+        if( AmlMethodSerializationAcquire( State, MethodInfo ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+    }
+
     //
     // Push a new method scope stack level to be used for the method call.
     //
     if( AmlMethodPushScope( State ) == AML_FALSE ) {
+        if( IsSerialized ) {
+            AmlMethodSerializationRelease( State, MethodInfo );
+        }
         return AML_FALSE;
     }
 
@@ -420,7 +501,7 @@ AmlMethodInvoke(
         //
         // Push a new namespace scope level with the scope of the method to be used for the method call.
         //
-        if( ( Success = AmlNamespacePushScope( &State->Namespace, &MethodNsNode->AbsolutePath, AML_SCOPE_FLAG_TEMPORARY ) ) == AML_FALSE ) {
+        if( ( Success = AmlNamespacePushNodeScope( &State->Namespace, MethodNsNode, AML_SCOPE_FLAG_TEMPORARY ) ) == AML_FALSE ) {
             break;
         }
 
@@ -428,15 +509,33 @@ AmlMethodInvoke(
         // Begin executing the body of the method until we hit a return or the end of the method.
         // We pass AML_TRUE for RestoreDataCursor, this will cause the IP to be restored to the original place
         // (following the call instruction + args), after execution of the method.
-        // Uses a temporary hack to update the temporary scope of the method.
-        // Will not function if multithreading is implemented.
-        // TODO: Figure out a better way to do this!
+        // Nodes created by the method body are linked to the temporary scope pushed above,
+        // as found through the namespace scope stack of the current execution context (see AmlNamespaceCreateNode).
         //
-        MethodNsNode->TempScope = State->Namespace.ScopeLast;
         if( MethodInfo->UserRoutine == NULL ) {
             State->Data = MethodInfo->CodeDataBlock;
             State->DataTotalLength = MethodInfo->CodeDataBlockSize;
+
+            //
+            // Lazily create the call site name resolution cache of the method body upon first invocation.
+            // Failure to create the cache is not fatal, all names are just searched as usual.
+            //
+            if( State->UseNameResolutionCache && ( MethodInfo->NameCache == NULL ) ) {
+                MethodInfo->NameCache = AmlNameCacheCreate(
+                    &State->Heap,
+                    MethodInfo->CodeDataBlock,
+                    MethodInfo->CodeStart,
+                    MethodInfo->CodeSize
+                );
+            }
+
+            //
+            // Switch to the name cache of the method for the duration of its body.
+            //
+            OldNameCache = State->NameCache;
+            State->NameCache = MethodInfo->NameCache;
             Success = AmlEvalTermListCode( State, MethodInfo->CodeStart, MethodInfo->CodeSize, AML_TRUE );
+            State->NameCache = OldNameCache;
         } else {
             Success = MethodInfo->UserRoutine( State, MethodInfo->UserContext, Arguments, ArgumentCount, &Scope->ReturnValue );
         }
@@ -486,6 +585,9 @@ AmlMethodInvoke(
         AML_TRAP_STRING( "Method scope stack out of sync!" );
     }
     Success &= AmlMethodPopScope( State );
+    if( IsSerialized ) {
+        AmlMethodSerializationRelease( State, MethodInfo );
+    }
 
     //
     // Free the return value (if any) upon failure.
@@ -0,0 +1,317 @@
+#include "aml_state.h"
+#include "aml_decoder.h"
+#include "aml_method_purity.h"
+
+//
+// Check if the given expression opcode is free of side effects (other than storing to its targets),
+// and doesn't depend on anything but its operands.
+//
+static
+BOOLEAN
+AmlMethodPurityIsPureOperator(
+    _In_ UINT16 OpcodeID
+    )
+{
+    switch( OpcodeID ) {
+    case AML_OPCODE_ID_STORE_OP:
+    case AML_OPCODE_ID_ADD_OP:
+    case AML_OPCODE_ID_CONCAT_OP:
+    case AML_OPCODE_ID_SUBTRACT_OP:
+    case AML_OPCODE_ID_INCREMENT_OP:
+    case AML_OPCODE_ID_DECREMENT_OP:
+    case AML_OPCODE_ID_MULTIPLY_OP:
+    case AML_OPCODE_ID_DIVIDE_OP:
+    case AML_OPCODE_ID_SHIFT_LEFT_OP:
+    case AML_OPCODE_ID_SHIFT_RIGHT_OP:
+    case AML_OPCODE_ID_AND_OP:
+    case AML_OPCODE_ID_NAND_OP:
+    case AML_OPCODE_ID_OR_OP:
+    case AML_OPCODE_ID_NOR_OP:
+    case AML_OPCODE_ID_XOR_OP:
+    case AML_OPCODE_ID_NOT_OP:
+    case AML_OPCODE_ID_FIND_SET_LEFT_BIT_OP:
+    case AML_OPCODE_ID_FIND_SET_RIGHT_BIT_OP:
+    case AML_OPCODE_ID_MOD_OP:
+    case AML_OPCODE_ID_LAND_OP:
+    case AML_OPCODE_ID_LOR_OP:
+    case AML_OPCODE_ID_LNOT_OP:
+    case AML_OPCODE_ID_LNOT_EQUAL_OP:
+    case AML_OPCODE_ID_LLESS_EQUAL_OP:
+    case AML_OPCODE_ID_LGREATER_EQUAL_OP:
+    case AML_OPCODE_ID_LEQUAL_OP:
+    case AML_OPCODE_ID_LGREATER_OP:
+    case AML_OPCODE_ID_LLESS_OP:
+    case AML_OPCODE_ID_TO_BUFFER_OP:
+    case AML_OPCODE_ID_TO_DECIMAL_STRING_OP:
+    case AML_OPCODE_ID_TO_HEX_STRING_OP:
+    case AML_OPCODE_ID_TO_INTEGER_OP:
+    case AML_OPCODE_ID_TO_STRING_OP:
+    case AML_OPCODE_ID_MID_OP:
+    case AML_OPCODE_ID_FROM_BCD_OP:
+    case AML_OPCODE_ID_TO_BCD:
+        return AML_TRUE;
+    default:
+        return AML_FALSE;
+    }
+}
+
+//
+// Consume the PkgLength of a block instruction, and return the end offset of the package.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlMethodPurityConsumePackage(
+    _Inout_ AML_STATE* State,
+    _Out_   SIZE_T*    pPkgEnd
+    )
+{
+    SIZE_T PkgStart;
+    SIZE_T PkgLength;
+
+    PkgStart = State->DataCursor;
+    if( AmlDecoderConsumePackageLength( State, &PkgLength ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlDecoderIsValidDataWindow( State, PkgStart, PkgLength ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( ( PkgStart + PkgLength ) < State->DataCursor ) {
+        return AML_FALSE;
+    }
+    *pPkgEnd = ( PkgStart + PkgLength );
+    return AML_TRUE;
+}
+
+//
+// Analyze and consume a single TermArg, fails if the TermArg isn't pure.
+// Only constant data, locals, and pure operators (storing to nothing but locals) are allowed.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlMethodPurityTermArg(
+    _Inout_ AML_STATE* State,
+    _In_    SIZE_T     Depth
+    )
+{
+    AML_DECODER_INSTRUCTION_OPCODE Instruction;
+    UINT64                         Integer;
+    SIZE_T                         PkgEnd;
+    SIZE_T                         i;
+    UINT8                          PeekByte;
+    BOOLEAN                        Success;
+
+    if( Depth >= AML_METHOD_PURITY_MAX_DEPTH ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Constant integer data and locals (arguments are never allowed, the method may be invoked with any arguments).
+    //
+    if( AmlDecoderMatchConstIntegerData( State, &Integer, NULL ) ) {
+        return AML_TRUE;
+    } else if( AmlDecoderMatchLocalObj( State, NULL ) ) {
+        return AML_TRUE;
+    } else if( AmlDecoderPeekOpcode( State, &Instruction ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Remaining constant data, any other non-operator instruction (name strings, packages, references, etc.) is impure.
+    //
+    switch( Instruction.OpcodeID ) {
+    case AML_OPCODE_ID_STRING_PREFIX:
+        return AmlDecoderMatchStringData( State, NULL );
+    case AML_OPCODE_ID_REVISION_OP:
+        return AmlDecoderConsumeOpcode( State, NULL );
+    case AML_OPCODE_ID_BUFFER_OP:
+        //
+        // DefBuffer := BufferOp PkgLength BufferSize ByteList
+        //
+        if( AmlDecoderConsumeOpcode( State, NULL ) == AML_FALSE ) {
+            return AML_FALSE;
+        } else if( AmlMethodPurityConsumePackage( State, &PkgEnd ) == AML_FALSE ) {
+            return AML_FALSE;
+        } else if( AmlMethodPurityTermArg( State, ( Depth + 1 ) ) == AML_FALSE ) {
+            return AML_FALSE;
+        } else if( State->DataCursor > PkgEnd ) {
+            return AML_FALSE;
+        }
+        State->DataCursor = PkgEnd;
+        return AML_TRUE;
+    default:
+        if( AmlMethodPurityIsPureOperator( Instruction.OpcodeID ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        break;
+    }
+
+    //
+    // Analyze all operands of the operator, the result of an operator may only be stored to a local (or nothing).
+    //
+    if( ( Instruction.VariableArgumentTypeCount != 0 ) || ( AmlDecoderConsumeOpcode( State, NULL ) == AML_FALSE ) ) {
+        return AML_FALSE;
+    }
+    for( i = 0; i < Instruction.FixedArgumentTypeCount; i++ ) {
+        switch( Instruction.FixedArgumentTypes[ i ] ) {
+        case AML_ARGUMENT_FIXED_TYPE_TERM_ARG:
+            Success = AmlMethodPurityTermArg( State, ( Depth + 1 ) );
+            break;
+        case AML_ARGUMENT_FIXED_TYPE_TARGET:
+            if( AmlDecoderPeekByte( State, 0, &PeekByte ) == AML_FALSE ) {
+                Success = AML_FALSE;
+            } else if( PeekByte == 0 ) {
+                Success = AmlDecoderConsumeByte( State, NULL );
+            } else {
+                Success = AmlDecoderMatchLocalObj( State, NULL );
+            }
+            break;
+        case AML_ARGUMENT_FIXED_TYPE_SUPER_NAME:
+        case AML_ARGUMENT_FIXED_TYPE_SUPER_NAME_NO_INVOCATION:
+            Success = AmlDecoderMatchLocalObj( State, NULL );
+            break;
+        default:
+            Success = AML_FALSE;
+            break;
+        }
+        if( Success == AML_FALSE ) {
+            return AML_FALSE;
+        }
+    }
+
+    return AML_TRUE;
+}
+
+//
+// Analyze and consume all instructions of a TermList up to the given end offset, fails if any instruction isn't pure.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlMethodPurityTermList(
+    _Inout_ AML_STATE* State,
+    _In_    SIZE_T     End,
+    _In_    SIZE_T     Depth
+    )
+{
+    AML_DECODER_INSTRUCTION_OPCODE Instruction;
+    SIZE_T                         PkgEnd;
+
+    if( Depth >= AML_METHOD_PURITY_MAX_DEPTH ) {
+        return AML_FALSE;
+    }
+
+    while( State->DataCursor < End ) {
+        if( AmlDecoderPeekOpcode( State, &Instruction ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+
+        switch( Instruction.OpcodeID ) {
+        case AML_OPCODE_ID_IF_OP:
+        case AML_OPCODE_ID_WHILE_OP:
+        case AML_OPCODE_ID_ELSE_OP:
+            //
+            // DefIfElse := IfOp PkgLength Predicate TermList DefElse
+            // DefElse := Nothing | <elseop pkglength termlist>
+            // DefWhile := WhileOp PkgLength Predicate TermList
+            //
+            AmlDecoderConsumeOpcode( State, NULL );
+            if( AmlMethodPurityConsumePackage( State, &PkgEnd ) == AML_FALSE ) {
+                return AML_FALSE;
+            } else if( PkgEnd > End ) {
+                return AML_FALSE;
+            }
+            if( Instruction.OpcodeID != AML_OPCODE_ID_ELSE_OP ) {
+                if( AmlMethodPurityTermArg( State, ( Depth + 1 ) ) == AML_FALSE ) {
+                    return AML_FALSE;
+                }
+            }
+            if( AmlMethodPurityTermList( State, PkgEnd, ( Depth + 1 ) ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+            break;
+        case AML_OPCODE_ID_RETURN_OP:
+            //
+            // DefReturn := ReturnOp ArgObject
+            //
+            AmlDecoderConsumeOpcode( State, NULL );
+            if( AmlMethodPurityTermArg( State, ( Depth + 1 ) ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+            break;
+        case AML_OPCODE_ID_BREAK_OP:
+        case AML_OPCODE_ID_CONTINUE_OP:
+        case AML_OPCODE_ID_NOOP_OP:
+            AmlDecoderConsumeOpcode( State, NULL );
+            break;
+        default:
+            //
+            // Any other instruction must be a pure expression (with its result stored to a local or discarded).
+            //
+            if( AmlMethodPurityTermArg( State, ( Depth + 1 ) ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+            break;
+        }
+    }
+
+    return ( State->DataCursor == End );
+}
+
+//
+// Determine if the given method is free of side effects, and only depends on constants and its own locals.
+// The method body is statically analyzed upon first use, and the result is saved to the method object.
+// Pure methods may only contain If/Else/While/Break/Continue/Noop/Return control flow, and expressions of constant data,
+// locals, and arithmetic/logical/conversion operators, storing to nothing but locals. Any reference to the namespace,
+// arguments, region/field access, Notify, mutexes, sleeping/stalling, references and packages make a method impure.
+//
+BOOLEAN
+AmlMethodIsPure(
+    _Inout_ AML_STATE*  State,
+    _Inout_ AML_OBJECT* MethodObject
+    )
+{
+    AML_OBJECT_METHOD* Method;
+    const UINT8*       OldData;
+    SIZE_T             OldDataTotalLength;
+    SIZE_T             OldDataLength;
+    SIZE_T             OldDataCursor;
+    BOOLEAN            IsPure;
+
+    //
+    // Return the result of a previous analysis.
+    //
+    Method = &MethodObject->u.Method;
+    if( Method->Purity != AML_METHOD_PURITY_UNKNOWN ) {
+        return ( Method->Purity == AML_METHOD_PURITY_PURE );
+    }
+
+    //
+    // Native host methods are never considered pure.
+    //
+    if( ( Method->UserRoutine != NULL ) || ( Method->CodeDataBlock == NULL ) ) {
+        Method->Purity = AML_METHOD_PURITY_IMPURE;
+        return AML_FALSE;
+    }
+
+    //
+    // Temporarily switch the decoder to the method body, the body is only decoded, never evaluated.
+    //
+    OldData            = State->Data;
+    OldDataTotalLength = State->DataTotalLength;
+    OldDataLength      = State->DataLength;
+    OldDataCursor      = State->DataCursor;
+    State->Data            = Method->CodeDataBlock;
+    State->DataTotalLength = Method->CodeDataBlockSize;
+    State->DataCursor      = Method->CodeStart;
+    State->DataLength      = ( Method->CodeStart + Method->CodeSize );
+    IsPure = ( ( Method->CodeStart <= Method->CodeDataBlockSize )
+               && ( Method->CodeSize <= ( Method->CodeDataBlockSize - Method->CodeStart ) )
+               && AmlMethodPurityTermList( State, State->DataLength, 0 ) );
+    State->Data            = OldData;
+    State->DataTotalLength = OldDataTotalLength;
+    State->DataLength      = OldDataLength;
+    State->DataCursor      = OldDataCursor;
+
+    Method->Purity = ( IsPure ? AML_METHOD_PURITY_PURE : AML_METHOD_PURITY_IMPURE );
+    return IsPure;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_object.h"
+
+//
+// Method purity analysis results (AML_OBJECT_METHOD::Purity).
+//
+#define AML_METHOD_PURITY_UNKNOWN 0
+#define AML_METHOD_PURITY_PURE    1
+#define AML_METHOD_PURITY_IMPURE  2
+
+//
+// Maximum nesting depth of the analyzed method body (nested blocks and expressions),
+// deeper method bodies are conservatively treated as impure.
+//
+#define AML_METHOD_PURITY_MAX_DEPTH 32
+
+//
+// Determine if the given method is free of side effects, and only depends on constants and its own locals.
+// The method body is statically analyzed upon first use, and the result is saved to the method object.
+// Pure methods may only contain If/Else/While/Break/Continue/Noop/Return control flow, and expressions of constant data,
+// locals, and arithmetic/logical/conversion operators, storing to nothing but locals. Any reference to the namespace,
+// arguments, region/field access, Notify, mutexes, sleeping/stalling, references and packages make a method impure.
+//
+BOOLEAN
+AmlMethodIsPure(
+    _Inout_ struct _AML_STATE* State,
+    _Inout_ AML_OBJECT*        MethodObject
+    );
@@ -4,6 +4,7 @@
 #include "aml_debug.h"
 #include "aml_host.h"
 #include "aml_mutex.h"
+#include "aml_eval_async.h"
 
 //
 // Attempt to acquire the given mutex object.
@@ -31,8 +32,9 @@ AmlMutexAcquire(
 
     //
     // Attempt to acquire the given mutex.
+    // Other execution contexts may run while waiting, the owner of the mutex may need to run to release it.
     //
-    WaitStatus = AmlHostMutexAcquire( State->Host, Mutex->HostHandle, TimeoutMs );
+    WaitStatus = AmlEvalAsyncMutexAcquire( State, Mutex->HostHandle, TimeoutMs );
     if( WaitStatus == AML_WAIT_STATUS_ERROR ) {
         return WaitStatus;
     }
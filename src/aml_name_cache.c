@@ -0,0 +1,210 @@
+#include "aml_name_cache.h"
+
+//
+// Create an empty name resolution cache for the given code block.
+// The code block must remain loaded for the entire lifetime of the cache.
+//
+_Success_( return != NULL )
+AML_NAME_CACHE*
+AmlNameCacheCreate(
+    _Inout_ AML_HEAP*    Heap,
+    _In_    const UINT8* Data,
+    _In_    SIZE_T       CodeStart,
+    _In_    SIZE_T       CodeSize
+    )
+{
+    AML_NAME_CACHE* Cache;
+    SIZE_T          EntryCount;
+    SIZE_T          i;
+
+    //
+    // Size the direct-mapped entry table to roughly one entry per 4 bytes of code (rounded up to a power of 2).
+    //
+    EntryCount = AML_NAME_CACHE_MIN_ENTRY_COUNT;
+    while( ( EntryCount < AML_NAME_CACHE_MAX_ENTRY_COUNT ) && ( EntryCount < ( CodeSize / 4 ) ) ) {
+        EntryCount *= 2;
+    }
+
+    //
+    // Allocate the cache header and entry table.
+    //
+    if( ( Cache = AmlHeapAllocate( Heap, sizeof( *Cache ) ) ) == NULL ) {
+        return NULL;
+    }
+    *Cache = ( AML_NAME_CACHE ){
+        .ParentHeap = Heap,
+        .Data       = Data,
+        .CodeStart  = CodeStart,
+        .CodeSize   = CodeSize,
+        .EntryMask  = ( EntryCount - 1 ),
+    };
+    if( ( Cache->Entries = AmlHeapAllocate( Heap, ( EntryCount * sizeof( Cache->Entries[ 0 ] ) ) ) ) == NULL ) {
+        AmlNameCacheFree( Cache );
+        return NULL;
+    }
+
+    //
+    // All entries start out unused.
+    //
+    for( i = 0; i < EntryCount; i++ ) {
+        Cache->Entries[ i ] = ( AML_NAME_CACHE_ENTRY ){ .Offset = AML_NAME_CACHE_NO_CALL_SITE };
+    }
+
+    return Cache;
+}
+
+//
+// Release all entries and the cache itself.
+//
+VOID
+AmlNameCacheFree(
+    _Inout_opt_ _Post_invalid_ AML_NAME_CACHE* Cache
+    )
+{
+    if( Cache == NULL ) {
+        return;
+    }
+
+    if( Cache->Entries != NULL ) {
+        AmlHeapFree( Cache->ParentHeap, Cache->Entries );
+    }
+    AmlHeapFree( Cache->ParentHeap, Cache );
+}
+
+//
+// Check if the given entry holds a still valid resolution of the given call site, searched from the given scope.
+//
+static
+BOOLEAN
+AmlNameCacheEntryMatches(
+    _In_ const AML_NAME_CACHE_ENTRY* Entry,
+    _In_ const AML_NAMESPACE_STATE*  Namespace,
+    _In_ const AML_NAMESPACE_SCOPE*  Scope,
+    _In_ SIZE_T                      Offset,
+    _In_ UINT                        SearchFlags
+    )
+{
+    SIZE_T i;
+
+    //
+    // Typical case, compare the call site and the namespace generation first.
+    //
+    if( ( Entry->Offset != Offset )
+        || ( Entry->Generation != Namespace->Generations[ Entry->GenerationIndex ] )
+        || ( Entry->SearchFlags != SearchFlags ) )
+    {
+        return AML_FALSE;
+    }
+
+    //
+    // The same call site may be executed from different scopes (for example, a Scope within a method body),
+    // the exact absolute path of the scope must match the scope that the cached search was performed from.
+    //
+    if( ( Entry->ScopePathHash != Scope->AbsolutePathHash )
+        || ( Entry->ScopeSegmentCount != Scope->AbsolutePath.SegmentCount ) )
+    {
+        return AML_FALSE;
+    }
+    for( i = 0; i < Entry->ScopeSegmentCount; i++ ) {
+        if( Entry->ScopeSegments[ i ].AsUInt32 != Scope->AbsolutePath.Segments[ i ].AsUInt32 ) {
+            return AML_FALSE;
+        }
+    }
+
+    //
+    // The object of an existing node may have been replaced by an alias since the entry was cached,
+    // these must still be resolved by a full search.
+    //
+    if( ( Entry->Node->Object->Type == AML_OBJECT_TYPE_ALIAS )
+        && ( ( SearchFlags & ( AML_SEARCH_FLAG_NAME_CREATION | AML_SEARCH_FLAG_NO_ALIAS_RESOLUTION ) ) == 0 ) )
+    {
+        return AML_FALSE;
+    }
+
+    return AML_TRUE;
+}
+
+//
+// Search for an existing node with the given name, decoded from the given call site of the given data block.
+// Performs a regular AmlNamespaceSearch (from the last active scope) if the call site isn't covered by the cache,
+// or if the cached resolution is no longer valid.
+//
+_Success_( return )
+BOOLEAN
+AmlNameCacheSearch(
+    _Inout_opt_ AML_NAME_CACHE*        Cache,
+    _In_        AML_NAMESPACE_STATE*   Namespace,
+    _In_        const UINT8*           Data,
+    _In_        SIZE_T                 CallSiteOffset,
+    _In_        const AML_NAME_STRING* Name,
+    _In_        UINT                   SearchFlags,
+    _Outptr_    AML_NAMESPACE_NODE**   ppFoundNode
+    )
+{
+    AML_NAMESPACE_SCOPE*  Scope;
+    AML_NAME_CACHE_ENTRY* Entry;
+    SIZE_T                Offset;
+    AML_NAMESPACE_NODE*   FoundNode;
+
+    //
+    // The decoder may have switched to a different block of code (Load/LoadTable),
+    // or the name may not have been decoded from the cached code block at all.
+    //
+    Scope = Namespace->ScopeLast;
+    if( ( Cache == NULL )
+        || ( CallSiteOffset == AML_NAME_CACHE_NO_CALL_SITE )
+        || ( Data != Cache->Data )
+        || ( CallSiteOffset < Cache->CodeStart )
+        || ( ( CallSiteOffset - Cache->CodeStart ) >= Cache->CodeSize )
+        || ( Scope->AbsolutePath.SegmentCount > AML_NAME_CACHE_MAX_SCOPE_DEPTH ) )
+    {
+        return AmlNamespaceSearch( Namespace, Scope, Name, SearchFlags, ppFoundNode );
+    }
+
+    //
+    // Return the cached node if the entry of this call site is still valid.
+    //
+    Offset = ( CallSiteOffset - Cache->CodeStart );
+    Entry = &Cache->Entries[ Offset & Cache->EntryMask ];
+    if( AmlNameCacheEntryMatches( Entry, Namespace, Scope, Offset, SearchFlags ) ) {
+        Cache->HitCount++;
+        *ppFoundNode = Entry->Node;
+        return AML_TRUE;
+    }
+
+    //
+    // Perform a full search, failed searches aren't cached.
+    //
+    Cache->MissCount++;
+    if( AmlNamespaceSearch( Namespace, Scope, Name, SearchFlags, &FoundNode ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Only cache resolutions to a node with the same local name as the searched name.
+    // Names resolved through aliases (to a different local name) may be affected by the creation of other
+    // nodes along the alias chain, which wouldn't invalidate the generation counter of the final node.
+    //
+    if( ( Name->SegmentCount == 0 )
+        || ( FoundNode->LocalName.AsUInt32 != Name->Segments[ Name->SegmentCount - 1 ].AsUInt32 ) )
+    {
+        *ppFoundNode = FoundNode;
+        return AML_TRUE;
+    }
+
+    //
+    // Replace the entry of this call site with the new resolution.
+    //
+    Entry->Offset            = Offset;
+    Entry->GenerationIndex   = AmlNamespaceGenerationIndex( &FoundNode->LocalName );
+    Entry->Generation        = Namespace->Generations[ Entry->GenerationIndex ];
+    Entry->SearchFlags       = SearchFlags;
+    Entry->ScopePathHash     = Scope->AbsolutePathHash;
+    Entry->ScopeSegmentCount = Scope->AbsolutePath.SegmentCount;
+    Entry->Node              = FoundNode;
+    if( Scope->AbsolutePath.SegmentCount > 0 ) {
+        AML_MEMCPY( Entry->ScopeSegments, Scope->AbsolutePath.Segments, ( Scope->AbsolutePath.SegmentCount * sizeof( Entry->ScopeSegments[ 0 ] ) ) );
+    }
+    *ppFoundNode = FoundNode;
+    return AML_TRUE;
+}
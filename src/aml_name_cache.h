@@ -0,0 +1,93 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_heap.h"
+#include "aml_data.h"
+#include "aml_namespace.h"
+
+//
+// Maximum depth of the active scope path that call sites are cached for.
+// Name references made from deeper scope levels are always resolved by a full namespace search.
+//
+#define AML_NAME_CACHE_MAX_SCOPE_DEPTH 8
+
+//
+// Minimum and maximum amount of direct-mapped entries per cached code block.
+//
+#define AML_NAME_CACHE_MIN_ENTRY_COUNT 8
+#define AML_NAME_CACHE_MAX_ENTRY_COUNT 1024
+
+//
+// Call site offset used for names that weren't decoded from a code block (never cached).
+//
+#define AML_NAME_CACHE_NO_CALL_SITE ( ~( SIZE_T )0 )
+
+//
+// Resolved name reference of a single call site.
+// An entry is only valid for the namespace generation (of the resolved node's local name) it was resolved in,
+// and for the exact absolute path of the scope that the search was performed from.
+//
+typedef struct _AML_NAME_CACHE_ENTRY {
+    SIZE_T                      Offset; /* Call site offset relative to CodeStart, AML_NAME_CACHE_NO_CALL_SITE if unused. */
+    UINT64                      Generation;
+    UINT                        GenerationIndex;
+    UINT                        SearchFlags;
+    UINT32                      ScopePathHash;
+    SIZE_T                      ScopeSegmentCount;
+    AML_NAME_SEG                ScopeSegments[ AML_NAME_CACHE_MAX_SCOPE_DEPTH ];
+    struct _AML_NAMESPACE_NODE* Node;
+} AML_NAME_CACHE_ENTRY;
+
+//
+// Per-call-site name resolution cache of a single code block (method body or loaded table).
+// Entries are direct-mapped by call site offset, a colliding call site simply replaces the existing entry.
+// Entries are invalidated whenever namespace nodes of the same local name are created or removed (see AML_NAMESPACE_STATE::Generations).
+//
+typedef struct _AML_NAME_CACHE {
+    AML_HEAP*             ParentHeap;
+    const UINT8*          Data;
+    SIZE_T                CodeStart;
+    SIZE_T                CodeSize;
+    AML_NAME_CACHE_ENTRY* Entries;
+    SIZE_T                EntryMask;
+    UINT64                HitCount;
+    UINT64                MissCount;
+} AML_NAME_CACHE;
+
+//
+// Create an empty name resolution cache for the given code block.
+// The code block must remain loaded for the entire lifetime of the cache.
+//
+_Success_( return != NULL )
+AML_NAME_CACHE*
+AmlNameCacheCreate(
+    _Inout_ AML_HEAP*    Heap,
+    _In_    const UINT8* Data,
+    _In_    SIZE_T       CodeStart,
+    _In_    SIZE_T       CodeSize
+    );
+
+//
+// Release all entries and the cache itself.
+//
+VOID
+AmlNameCacheFree(
+    _Inout_opt_ _Post_invalid_ AML_NAME_CACHE* Cache
+    );
+
+//
+// Search for an existing node with the given name, decoded from the given call site of the given data block.
+// Performs a regular AmlNamespaceSearch (from the last active scope) if the call site isn't covered by the cache,
+// or if the cached resolution is no longer valid.
+//
+_Success_( return )
+BOOLEAN
+AmlNameCacheSearch(
+    _Inout_opt_ AML_NAME_CACHE*        Cache,
+    _In_        AML_NAMESPACE_STATE*   Namespace,
+    _In_        const UINT8*           Data,
+    _In_        SIZE_T                 CallSiteOffset,
+    _In_        const AML_NAME_STRING* Name,
+    _In_        UINT                   SearchFlags,
+    _Outptr_    AML_NAMESPACE_NODE**   ppFoundNode
+    );
@@ -3,9 +3,23 @@
 #include "aml_hash.h"
 #include "aml_base.h"
 
+//
+// Absolute path view of a possibly-relative name string, resolved against an active scope without copying any segments.
+// The full absolute path is the path of the ancestor scope that the name is relative to, followed by the segments of the name.
+//
+typedef struct _AML_NAMESPACE_PATH_VIEW {
+    const AML_NAME_PREFIX* Prefix;
+    const AML_NAME_SEG*    ParentSegments;
+    SIZE_T                 ParentSegmentCount;
+    UINT32                 ParentHash; /* Hash of the parent segments. */
+    const AML_NAME_SEG*    Segments;
+    SIZE_T                 SegmentCount;
+} AML_NAMESPACE_PATH_VIEW;
+
 //
 // Initialize global namespace state.
 // The given allocator and heap must remain valid for the entire lifetime of the namespace state.
+// The capacity hint is the expected amount of namespace nodes, used to pre-size the path hash-table (may be 0).
 // TODO: Take in PermanentArena as an argument instead of a regular Allocator,
 // then set up the scope arena to use the PermanentArena as a backend.
 //
@@ -13,7 +27,8 @@ VOID
 AmlNamespaceStateInitialize(
     _Out_   AML_NAMESPACE_STATE* State,
     _In_    AML_ALLOCATOR        Allocator,
-    _Inout_ AML_HEAP*            Heap
+    _Inout_ AML_HEAP*            Heap,
+    _In_    SIZE_T               CapacityHint
     )
 {
     //
@@ -31,14 +46,24 @@ AmlNamespaceStateInitialize(
     AmlArenaInitialize( &State->TempArena, Allocator, 4096, 0 );
     AmlArenaInitialize( &State->ScopeArena, Allocator, 8192, 0 );
 
+    //
+    // Initialize the absolute path hash-table, the table itself is allocated upon creation of the first node.
+    // Replaced tables and released nodes are retired through the epoch, as concurrent readers may still be accessing them.
+    //
+    AmlEpochInitialize( &State->Epoch, Heap );
+    AmlNamespacePathMapInitialize( &State->PathMap, Heap, &State->Epoch, CapacityHint );
+
     //
     // Set up the root scope node.
     //
+    State->ScopeRootPrefixHash = AML_NAMESPACE_HASH_SEED;
     State->ScopeRoot = ( AML_NAMESPACE_SCOPE ){
         .ArenaSnapshot = AmlArenaSnapshot( &State->ScopeArena ),
         .AbsolutePath = {
             .Prefix = { .Data = { '\\' }, .Length = 1 }
         },
+        .AbsolutePathHash = AML_NAMESPACE_HASH_SEED,
+        .PrefixHashes     = &State->ScopeRootPrefixHash,
     };
     State->ScopeFirst = &State->ScopeRoot;
     State->ScopeLast = &State->ScopeRoot;
@@ -56,6 +81,8 @@ AmlNamespaceStateRelease(
     //
     // Release all allocated memory.
     //
+    AmlEpochRelease( &State->Epoch );
+    AmlNamespacePathMapRelease( &State->PathMap );
     AmlArenaRelease( &State->TempArena );
     AmlArenaRelease( &State->ScopeArena );
     AmlArenaRelease( &State->PermanentArena );
@@ -67,24 +94,21 @@ AmlNamespaceStateRelease(
 }
 
 //
-// Convert a possibly-relative name string to an absolute path, relative to the given active namespace scope.
+// Resolve a possibly-relative name string to an absolute path view, relative to the given active namespace scope.
 // Note: this does not apply any search rules, if the path is relative, it assumes that it is relative to the current scope!
 //
 _Success_( return )
 static
 BOOLEAN
-AmlNamespaceConvertNameStringToAbsolutePath(
-    _In_    const AML_NAMESPACE_SCOPE* ActiveScope,
-    _Inout_ AML_ARENA*                 Arena,
-    _In_    const AML_NAME_STRING*     Input,
-    _Out_   AML_NAME_STRING*           AbsoluteOutput
+AmlNamespaceResolvePathView(
+    _In_  const AML_NAMESPACE_SCOPE* ActiveScope,
+    _In_  const AML_NAME_STRING*     Input,
+    _Out_ AML_NAMESPACE_PATH_VIEW*   View
     )
 {
-    SIZE_T        i;
-    AML_NAME_SEG* OutputSegments;
-    SIZE_T        BackAncestorCount;
-    SIZE_T        OutputSegmentCount;
-    SIZE_T        ParentSegmentCount;
+    SIZE_T i;
+    SIZE_T BackAncestorCount;
+    SIZE_T ParentSegmentCount;
 
     //
     // An empty name is not a valid name.
@@ -95,30 +119,15 @@ AmlNamespaceConvertNameStringToAbsolutePath(
     }
 
     //
-    // If the input name is already absolute, and begins with the RootChar, nothing needs to be done, just deep copy the input.
+    // If the input name is already absolute, and begins with the RootChar, the view is just the input itself.
     //
     if( ( Input->Prefix.Length > 0 ) && ( Input->Prefix.Data[ 0 ] == '\\' ) ) {
-        OutputSegments = AmlArenaAllocate( Arena, ( sizeof( AML_NAME_SEG ) * Input->SegmentCount ) );
-        if( OutputSegments == NULL ) {
-            return AML_FALSE;
-        }
-
-        //
-        // Copy all input name segments to the new output copy allocation.
-        //
-        for( i = 0; i < Input->SegmentCount; i++ ) {
-            OutputSegments[ i ] = Input->Segments[ i ];
-        }
-
-        //
-        // Return the deep-copied absolute name string.
-        //
-        *AbsoluteOutput = ( AML_NAME_STRING ){
-            .Prefix       = Input->Prefix,
-            .SegmentCount = Input->SegmentCount,
-            .Segments     = OutputSegments
+        *View = ( AML_NAMESPACE_PATH_VIEW ){
+            .Prefix       = &Input->Prefix,
+            .ParentHash   = AML_NAMESPACE_HASH_SEED,
+            .Segments     = Input->Segments,
+            .SegmentCount = Input->SegmentCount
         };
-
         return AML_TRUE;
     }
 
@@ -144,43 +153,176 @@ AmlNamespaceConvertNameStringToAbsolutePath(
     }
 
     //
-    // Use the stored absolute path of the found parent namespace as the base of our new path.
+    // Use the stored absolute path (and its precomputed prefix hash) of the selected ancestor as the base of the path.
     // This avoids having to iterate ancestor namespaces upwards until root to build the path.
     //
     ParentSegmentCount = ( ActiveScope->AbsolutePath.SegmentCount - BackAncestorCount );
-    if( ParentSegmentCount > ( SIZE_MAX - Input->SegmentCount ) ) {
+    if( ParentSegmentCount > ( ( SIZE_MAX / sizeof( AML_NAME_SEG ) ) - Input->SegmentCount ) ) {
         return AML_FALSE;
     }
-    OutputSegmentCount = ( ParentSegmentCount + Input->SegmentCount );
 
     //
-    // Allocate memory for the full output path.
+    // The prefixes are taken from the ancestor node that we took the AbsolutePath from, and are assumed to be valid ('\').
     //
-    OutputSegments = AmlArenaAllocate( Arena, ( sizeof( AML_NAME_SEG ) * OutputSegmentCount ) );
-    if( OutputSegments == NULL ) {
+    *View = ( AML_NAMESPACE_PATH_VIEW ){
+        .Prefix             = &ActiveScope->AbsolutePath.Prefix,
+        .ParentSegments     = ActiveScope->AbsolutePath.Segments,
+        .ParentSegmentCount = ParentSegmentCount,
+        .ParentHash         = ActiveScope->PrefixHashes[ ParentSegmentCount ],
+        .Segments           = Input->Segments,
+        .SegmentCount       = Input->SegmentCount
+    };
+    return AML_TRUE;
+}
+
+//
+// Get the segment at the given index of the full absolute path of a path view.
+//
+static
+const AML_NAME_SEG*
+AmlNamespacePathViewSegment(
+    _In_ const AML_NAMESPACE_PATH_VIEW* View,
+    _In_ SIZE_T                         Index
+    )
+{
+    if( Index < View->ParentSegmentCount ) {
+        return &View->ParentSegments[ Index ];
+    }
+    return &View->Segments[ Index - View->ParentSegmentCount ];
+}
+
+//
+// Compare the full absolute paths of two path views.
+//
+static
+BOOLEAN
+AmlNamespaceComparePathViews(
+    _In_ const AML_NAMESPACE_PATH_VIEW* View1,
+    _In_ const AML_NAMESPACE_PATH_VIEW* View2
+    )
+{
+    SIZE_T i;
+    SIZE_T SegmentCount;
+
+    //
+    // Early-out by comparing lengths first.
+    //
+    SegmentCount = ( View1->ParentSegmentCount + View1->SegmentCount );
+    if( ( View1->Prefix->Length != View2->Prefix->Length )
+        || ( SegmentCount != ( View2->ParentSegmentCount + View2->SegmentCount ) ) )
+    {
         return AML_FALSE;
     }
 
     //
-    // Copy in full absolute path of the selected parent namespace.
+    // Compare all prefix characters.
     //
-    for( i = 0; i < ParentSegmentCount; i++ ) {
-        OutputSegments[ i ] = ActiveScope->AbsolutePath.Segments[ i ];
+    for( i = 0; i < View1->Prefix->Length; i++ ) {
+        if( View1->Prefix->Data[ i ] != View2->Prefix->Data[ i ] ) {
+            return AML_FALSE;
+        }
     }
 
     //
-    // Append the relative part of the input path to the absolute path of the selected ancestor.
+    // Compare all segments.
     //
-    for( i = 0; i < Input->SegmentCount; i++ ) {
-        OutputSegments[ ParentSegmentCount + i ] = Input->Segments[ i ];
+    for( i = 0; i < SegmentCount; i++ ) {
+        if( AmlNamespacePathViewSegment( View1, i )->AsUInt32 != AmlNamespacePathViewSegment( View2, i )->AsUInt32 ) {
+            return AML_FALSE;
+        }
+    }
+
+    return AML_TRUE;
+}
+
+//
+// Compare an absolute path with the full absolute path of a path view.
+//
+static
+BOOLEAN
+AmlNamespaceComparePathView(
+    _In_ const AML_NAME_STRING*         AbsolutePath,
+    _In_ const AML_NAMESPACE_PATH_VIEW* View
+    )
+{
+    AML_NAMESPACE_PATH_VIEW AbsoluteView;
+
+    AbsoluteView = ( AML_NAMESPACE_PATH_VIEW ){
+        .Prefix       = &AbsolutePath->Prefix,
+        .Segments     = AbsolutePath->Segments,
+        .SegmentCount = AbsolutePath->SegmentCount
+    };
+    return AmlNamespaceComparePathViews( &AbsoluteView, View );
+}
+
+//
+// Calculate the full absolute path hash of a path view.
+//
+static
+UINT32
+AmlNamespaceHashPathView(
+    _In_ const AML_NAMESPACE_PATH_VIEW* View
+    )
+{
+    UINT32 Hash;
+    SIZE_T i;
+
+    Hash = View->ParentHash;
+    for( i = 0; i < View->SegmentCount; i++ ) {
+        Hash = AmlHashKey32( View->Segments[ i ].Data, sizeof( View->Segments[ i ].Data ), Hash );
+    }
+    return Hash;
+}
+
+//
+// Convert a possibly-relative name string to an absolute path, relative to the given active namespace scope.
+// Only used when the absolute path must outlive the name (node creation and scope levels), searches use path views.
+// Note: this does not apply any search rules, if the path is relative, it assumes that it is relative to the current scope!
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceConvertNameStringToAbsolutePath(
+    _In_    const AML_NAMESPACE_SCOPE* ActiveScope,
+    _Inout_ AML_ARENA*                 Arena,
+    _In_    const AML_NAME_STRING*     Input,
+    _Out_   AML_NAME_STRING*           AbsoluteOutput
+    )
+{
+    AML_NAMESPACE_PATH_VIEW View;
+    AML_NAME_SEG*           OutputSegments;
+    SIZE_T                  OutputSegmentCount;
+    SIZE_T                  i;
+
+    //
+    // Resolve the input to the ancestor path that it is relative to.
+    //
+    if( AmlNamespaceResolvePathView( ActiveScope, Input, &View ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Allocate memory for the full output path.
+    //
+    OutputSegmentCount = ( View.ParentSegmentCount + View.SegmentCount );
+    OutputSegments = AmlArenaAllocate( Arena, ( sizeof( AML_NAME_SEG ) * OutputSegmentCount ) );
+    if( OutputSegments == NULL ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Copy in full absolute path of the selected parent namespace,
+    // then append the relative part of the input path to the absolute path of the selected ancestor.
+    //
+    for( i = 0; i < OutputSegmentCount; i++ ) {
+        OutputSegments[ i ] = *AmlNamespacePathViewSegment( &View, i );
     }
 
     //
     // Write out the converted path.
-    // The prefixes are taken from the ancestor node that we took the AbsolutePath from, and are assumed to be valid ('\').
     //
     *AbsoluteOutput = ( AML_NAME_STRING ){
-        .Prefix       = ActiveScope->AbsolutePath.Prefix,
+        .Prefix       = *View.Prefix,
         .SegmentCount = OutputSegmentCount,
         .Segments     = OutputSegments
     };
@@ -189,77 +331,63 @@ AmlNamespaceConvertNameStringToAbsolutePath(
 }
 
 //
-// Resolve and hash the absolute path of the given prefixed name string.
+// Calculate the hashes of every prefix of the given absolute path (SegmentCount + 1 entries), allocated from the given arena.
+// The hashes of the leading segments shared with the given base path are copied from its existing prefix hashes.
 //
 _Success_( return )
 static
 BOOLEAN
-AmlNamespaceHashPrefixedNameString(
-    _In_  const AML_NAMESPACE_SCOPE* ActiveScope,
-    _In_  const AML_NAME_STRING*     Name,
-    _Out_ UINT32*                    pHashSum
+AmlNamespaceHashAbsolutePathPrefixes(
+    _Inout_  AML_ARENA*             Arena,
+    _In_     const AML_NAME_STRING* AbsolutePath,
+    _In_opt_ const AML_NAME_STRING* BasePath,
+    _In_opt_ const UINT32*          BasePrefixHashes,
+    _Outptr_ UINT32**               ppPrefixHashes
     )
 {
-    UINT32  Seed;
+    UINT32* PrefixHashes;
+    SIZE_T  SharedCount;
     SIZE_T  i;
-    SIZE_T  BackAncestorCount;
-    BOOLEAN IsRelative;
 
     //
-    // Starting hash seed.
+    // Allocate a hash for every prefix length, including the empty root prefix.
     //
-    Seed = AML_NAMESPACE_HASH_SEED;
-
-    //
-    // Handle prefixed names.
-    // If this is a parent scope prefix, find the namespace ancestor that this relative name is referring to.
-    //
-    IsRelative = AML_TRUE;
-    BackAncestorCount = 0;
-    if( Name->Prefix.Length > 0 ) {
-        if( Name->Prefix.Data[ 0 ] == '^' ) {
-            for( i = 0; i < Name->Prefix.Length; i++ ) {
-                if( ( Name->Prefix.Data[ i ] != '^' ) ) {
-                    return AML_FALSE;
-                }
-                BackAncestorCount++;
-            }
-        } else if( Name->Prefix.Data[ 0 ] != '\\' ) {
-            return AML_FALSE;
-        }
-        IsRelative = ( Name->Prefix.Data[ 0 ] != '\\' );
+    if( AbsolutePath->SegmentCount >= ( SIZE_MAX / sizeof( UINT32 ) ) ) {
+        return AML_FALSE;
     }
-
-    //
-    // If this is an ancestor prefixed path, the parent scope's path must
-    // be large enough to move back by the desired amount of ancestors.
-    //
-    if( BackAncestorCount > ActiveScope->AbsolutePath.SegmentCount ) {
+    PrefixHashes = AmlArenaAllocate( Arena, ( ( AbsolutePath->SegmentCount + 1 ) * sizeof( UINT32 ) ) );
+    if( PrefixHashes == NULL ) {
         return AML_FALSE;
     }
-    
+
     //
-    // Accumulate the hash of the path of the ancestor that this name is relative to.
+    // Find the amount of leading segments shared with the base path (typically the active scope).
     //
-    if( IsRelative ) {
-        for( i = 0; i < ( ActiveScope->AbsolutePath.SegmentCount - BackAncestorCount ); i++ ) {
-            Seed = AmlHashKey32( ActiveScope->AbsolutePath.Segments[ i ].Data,
-                                 sizeof( ActiveScope->AbsolutePath.Segments[ i ].Data ),
-                                 Seed );
+    SharedCount = 0;
+    if( ( BasePath != NULL ) && ( BasePrefixHashes != NULL ) ) {
+        while( ( SharedCount < AbsolutePath->SegmentCount )
+               && ( SharedCount < BasePath->SegmentCount )
+               && ( AbsolutePath->Segments[ SharedCount ].AsUInt32 == BasePath->Segments[ SharedCount ].AsUInt32 ) )
+        {
+            SharedCount++;
+        }
+        for( i = 0; i <= SharedCount; i++ ) {
+            PrefixHashes[ i ] = BasePrefixHashes[ i ];
         }
+    } else {
+        PrefixHashes[ 0 ] = AML_NAMESPACE_HASH_SEED;
     }
 
     //
-    // Accumulate the hash of the input name.
+    // Extend the shared prefix hashes by a single segment at a time.
     //
-    for( i = 0; i < Name->SegmentCount; i++ ) {
-        Seed = AmlHashKey32( Name->Segments[ i ].Data, sizeof( Name->Segments[ i ].Data ), Seed );
+    for( i = SharedCount; i < AbsolutePath->SegmentCount; i++ ) {
+        PrefixHashes[ i + 1 ] = AmlHashKey32( AbsolutePath->Segments[ i ].Data,
+                                              sizeof( AbsolutePath->Segments[ i ].Data ),
+                                              PrefixHashes[ i ] );
     }
 
-    //
-    // Return the calculated absolute path hash.
-    //
-    *pHashSum = Seed;
+    *ppPrefixHashes = PrefixHashes;
     return AML_TRUE;
 }
 
@@ -306,6 +434,19 @@ AmlNamespaceCompareNameStringLocal(
     return AML_TRUE;
 }
 
+//
+// Get the index of the generation counter that tracks the creation and removal of nodes with the given local name.
+// Creating a node can only change the resolution of names that now resolve to the new node (with the same local name),
+// and removing a node can only change the resolution of names that resolved to the removed node.
+//
+UINT
+AmlNamespaceGenerationIndex(
+    _In_ const AML_NAME_SEG* LocalName
+    )
+{
+    return ( AmlHashKey32( LocalName->Data, sizeof( LocalName->Data ), AML_NAMESPACE_HASH_SEED ) % AML_NAMESPACE_GENERATION_COUNT );
+}
+
 //
 // Fully expand and compare two AML_NAME_STRING values.
 //
@@ -317,15 +458,8 @@ AmlNamespaceCompareNameString(
     _In_     const AML_NAME_STRING*     String2
     )
 {
-    AML_ARENA_SNAPSHOT Snapshot;
-    AML_NAME_STRING    AbsString1;
-    AML_NAME_STRING    AbsString2;
-    BOOLEAN            Match;
-
-    //
-    // Snapshot temporary arena to rollback all allocations.
-    //
-    Snapshot = AmlArenaSnapshot( &State->TempArena );
+    AML_NAMESPACE_PATH_VIEW View1;
+    AML_NAMESPACE_PATH_VIEW View2;
 
     //
     // Use the current namespace scope if none is given.
@@ -333,24 +467,37 @@ AmlNamespaceCompareNameString(
     ActiveScope = ( ( ActiveScope == NULL ) ? State->ScopeLast : ActiveScope );
 
     //
-    // Attempt to convert both strings to absolute paths relative to the given scope,
-    // and compare the resolved absolute name strings.
+    // Attempt to resolve both strings relative to the given scope,
+    // and compare the resolved absolute paths.
     //
-    Match = AML_FALSE;
-    do {
-        if( AmlNamespaceConvertNameStringToAbsolutePath( ActiveScope, &State->TempArena, String1, &AbsString1 ) == AML_FALSE ) {
-            break;
-        } else if( AmlNamespaceConvertNameStringToAbsolutePath( ActiveScope, &State->TempArena, String2, &AbsString2 ) == AML_FALSE ) {
-            break;
-        }
-        Match = AmlNamespaceCompareNameStringLocal( &AbsString1, &AbsString2 );
-    } while( 0 );
+    if( AmlNamespaceResolvePathView( ActiveScope, String1, &View1 ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceResolvePathView( ActiveScope, String2, &View2 ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    return AmlNamespaceComparePathViews( &View1, &View2 );
+}
 
-    //
-    // Rollback all temporary allocations.
-    //
-    AmlArenaSnapshotRollback( &State->TempArena, &Snapshot );
-    return Match;
+//
+// Look up the node with the given absolute path hash.
+// Concurrent readers may observe reused path map slots, the found node must then actually have the given hash.
+//
+_Success_( return != NULL )
+static
+AML_NAMESPACE_NODE*
+AmlNamespaceLookupHash(
+    _In_ AML_NAMESPACE_STATE* State,
+    _In_ UINT32               Hash,
+    _In_ BOOLEAN              IsConcurrent
+    )
+{
+    AML_NAMESPACE_NODE* Node;
+
+    if( IsConcurrent == AML_FALSE ) {
+        return AmlNamespacePathMapLookup( &State->PathMap, Hash );
+    }
+    Node = AmlNamespacePathMapLookupConcurrent( &State->PathMap, Hash );
+    return ( ( ( Node != NULL ) && ( Node->AbsolutePathHash == Hash ) ) ? Node : NULL );
 }
 
 //
@@ -361,16 +508,14 @@ _Success_( return != NULL )
 static
 AML_NAMESPACE_NODE*
 AmlNamespaceSearchPrefixedName(
-    _In_ AML_NAMESPACE_STATE*   State,
-    _In_ AML_NAMESPACE_SCOPE*   ActiveScope,
-    _In_ const AML_NAME_STRING* Name
+    _In_ AML_NAMESPACE_STATE*       State,
+    _In_ const AML_NAMESPACE_SCOPE* ActiveScope,
+    _In_ const AML_NAME_STRING*     Name,
+    _In_ BOOLEAN                    IsConcurrent
     )
 {
-    UINT32              Hash;
-    AML_ARENA_SNAPSHOT  Snapshot;
-    AML_NAME_STRING     AbsoluteName;
-    AML_NAMESPACE_NODE* BucketEntry;
-    AML_NAMESPACE_NODE* FoundNode;
+    AML_NAMESPACE_PATH_VIEW View;
+    AML_NAMESPACE_NODE*     MapEntry;
 
     //
     // Must be a prefixed name, or a name with multiple name segments.
@@ -380,44 +525,17 @@ AmlNamespaceSearchPrefixedName(
     }
 
     //
-    // Resolve and hash the absolute path of the input node and attempt to find the given path in the hash table.
+    // Resolve the input name against the active scope (without building the absolute path),
+    // hash the resolved path starting from the precomputed hash of the ancestor, and attempt to find it in the hash table.
     //
-    Snapshot = AmlArenaSnapshot( &State->TempArena );
-    FoundNode = NULL;
-    do {
-        //
-        // Attempt to resolve the absolute path of the input name.
-        //
-        if( AmlNamespaceConvertNameStringToAbsolutePath( ActiveScope,
-                                                         &State->TempArena,
-                                                         Name,
-                                                         &AbsoluteName ) == AML_FALSE )
-        {
-            break;
-        }
-
-        //
-        // Attempt to hash the input absolute path.
-        //
-        if( AmlNamespaceHashPrefixedNameString( ActiveScope, Name, &Hash ) == AML_FALSE ) {
-            break;
-        }
-
-        //
-        // Search for a node with this full path in the hash-table.
-        //
-        BucketEntry = State->AbsolutePathMap[ Hash % AML_COUNTOF( State->AbsolutePathMap ) ];
-        for( ; BucketEntry != NULL; BucketEntry = BucketEntry->BucketNext ) {
-            if( ( BucketEntry->AbsolutePathHash == Hash )
-                && AmlNamespaceCompareNameStringLocal( &BucketEntry->AbsolutePath, &AbsoluteName ) )
-            {
-                FoundNode = BucketEntry;
-            }
-        }
-    } while( 0 );
-    AmlArenaSnapshotRollback( &State->TempArena, &Snapshot );
-
-    return FoundNode;
+    if( AmlNamespaceResolvePathView( ActiveScope, Name, &View ) == AML_FALSE ) {
+        return NULL;
+    }
+    MapEntry = AmlNamespaceLookupHash( State, AmlNamespaceHashPathView( &View ), IsConcurrent );
+    if( ( MapEntry == NULL ) || ( AmlNamespaceComparePathView( &MapEntry->AbsolutePath, &View ) == AML_FALSE ) ) {
+        return NULL;
+    }
+    return MapEntry;
 }
 
 //
@@ -427,17 +545,16 @@ _Success_( return != NULL )
 static
 AML_NAMESPACE_NODE*
 AmlNamespaceSearchRelativeName(
-    _In_ AML_NAMESPACE_STATE*   State,
-    _In_ AML_NAMESPACE_SCOPE*   ActiveScope,
-    _In_ const AML_NAME_STRING* Name,
-    _In_ UINT                   SearchFlags
+    _In_ AML_NAMESPACE_STATE*       State,
+    _In_ const AML_NAMESPACE_SCOPE* ActiveScope,
+    _In_ const AML_NAME_STRING*     Name,
+    _In_ UINT                       SearchFlags,
+    _In_ BOOLEAN                    IsConcurrent
     )
 {
     SIZE_T              i;
     UINT32              Hash;
-    SIZE_T              j;
-    const AML_NAME_SEG* Segment;
-    AML_NAMESPACE_NODE* BucketEntry;
+    AML_NAMESPACE_NODE* MapEntry;
     AML_NAMESPACE_NODE* FoundNode;
     AML_NAME_STRING     PathPrefix1;
     AML_NAME_STRING     PathPrefix2;
@@ -478,57 +595,41 @@ AmlNamespaceSearchRelativeName(
         }
 
         //
-        // Accumulate the scope segment hashes up to the current search ancestor index.
+        // Accumulate the hash of the relative search name onto the precomputed hash of the current search ancestor.
         //
-        Hash = AML_NAMESPACE_HASH_SEED;
-        if( i < ActiveScope->AbsolutePath.SegmentCount ) {
-            for( j = 0; j < ( ActiveScope->AbsolutePath.SegmentCount - i ); j++ ) {
-                Segment = &ActiveScope->AbsolutePath.Segments[ j ];
-                Hash = AmlHashKey32( Segment->Data, sizeof( Segment->Data ), Hash );
-            }
-        }
+        Hash = AmlHashKey32( Name->Segments[ 0 ].Data,
+                             sizeof( Name->Segments[ 0 ].Data ),
+                             ActiveScope->PrefixHashes[ ActiveScope->AbsolutePath.SegmentCount - i ] );
 
         //
-        // Accumulate the hash of the relative search name.
+        // Search for a node with this full path in the hash-table.
+        // In case of hash collisions, the actual absolute paths are compared after this.
         //
-        Hash = AmlHashKey32( Name->Segments[ 0 ].Data, sizeof( Name->Segments[ 0 ].Data ), Hash );
+        if( ( MapEntry = AmlNamespaceLookupHash( State, Hash, IsConcurrent ) ) == NULL ) {
+            continue;
+        }
 
         //
-        // Search for a node with this full path in the hash-table.
+        // If this isn't the root of the search path, compare the path of the found node and the search path.
+        // This doesn't include the local name being searched for, but the part of the path that comes before it.
         //
-        BucketEntry = State->AbsolutePathMap[ Hash % AML_COUNTOF( State->AbsolutePathMap ) ];
-        for( ; BucketEntry != NULL; BucketEntry = BucketEntry->BucketNext ) {
-            //
-            // Typical case, early out if the hashes of the two paths don't match.
-            // In case of hash collisions, the actual absolute paths are compared after this.
-            // 
-            if( BucketEntry->AbsolutePathHash != Hash ) {
-                continue;
+        if( i < ActiveScope->AbsolutePath.SegmentCount ) {
+            PathPrefix1 = MapEntry->AbsolutePath;
+            if( PathPrefix1.SegmentCount > 0 ) {
+                PathPrefix1.SegmentCount -= 1;
             }
-
-            //
-            // If this isn't the root of the search path, compare the path of the found node and the search path.
-            // This doesn't include the local name being searched for, but the part of the path that comes before it.
-            //
-            if( i < ActiveScope->AbsolutePath.SegmentCount ) {
-                PathPrefix1 = BucketEntry->AbsolutePath;
-                if( PathPrefix1.SegmentCount > 0 ) {
-                    PathPrefix1.SegmentCount -= 1;
-                }
-                PathPrefix2 = ActiveScope->AbsolutePath;
-                PathPrefix2.SegmentCount -= i;
-                if( AmlNamespaceCompareNameStringLocal( &PathPrefix1, &PathPrefix2 ) == AML_FALSE ) {
-                    continue;
-                }
+            PathPrefix2 = ActiveScope->AbsolutePath;
+            PathPrefix2.SegmentCount -= i;
+            if( AmlNamespaceCompareNameStringLocal( &PathPrefix1, &PathPrefix2 ) == AML_FALSE ) {
+                continue;
             }
+        }
 
-            //
-            // Hash and path prefixes match, finally attempt to compare the local name being searched.
-            //
-            if( BucketEntry->LocalName.AsUInt32 == Name->Segments[ 0 ].AsUInt32 ) {
-                FoundNode = BucketEntry;
-                break;
-            }
+        //
+        // Hash and path prefixes match, finally attempt to compare the local name being searched.
+        //
+        if( MapEntry->LocalName.AsUInt32 == Name->Segments[ 0 ].AsUInt32 ) {
+            FoundNode = MapEntry;
         }
     }
 
@@ -567,9 +668,9 @@ AmlNamespaceSearch(
     // Calculate the hash of the input name using prefix path rules.
     //
     if( ( Name->Prefix.Length > 0 ) || ( Name->SegmentCount > 1 ) ) {
-        FoundNode = AmlNamespaceSearchPrefixedName( State, ActiveScope, Name );
+        FoundNode = AmlNamespaceSearchPrefixedName( State, ActiveScope, Name, AML_FALSE );
     } else {
-        FoundNode = AmlNamespaceSearchRelativeName( State, ActiveScope, Name, SearchFlags );
+        FoundNode = AmlNamespaceSearchRelativeName( State, ActiveScope, Name, SearchFlags, AML_FALSE );
     }
 
     //
@@ -635,22 +736,67 @@ AmlNamespaceSearchZ(
 }
 
 //
-// Push new namespace scope level.
+// Look up the node with the absolute path made up of the first SegmentCount segments of the given absolute path.
+// Uses the precomputed prefix hashes of the path instead of hashing the path prefix again,
+// a found alias node is resolved by a regular search (same as AmlNamespaceSearch without search flags).
+//
+_Success_( return != NULL )
+static
+AML_NAMESPACE_NODE*
+AmlNamespaceSearchAbsolutePathPrefix(
+    _In_ AML_NAMESPACE_STATE*   State,
+    _In_ const AML_NAME_STRING* AbsolutePath,
+    _In_ const UINT32*          PrefixHashes,
+    _In_ SIZE_T                 SegmentCount
+    )
+{
+    AML_NAME_STRING     PrefixPath;
+    AML_NAMESPACE_NODE* FoundNode;
+
+    //
+    // Search for a node with the hash of the path prefix, and compare the actual path in case of a hash collision.
+    //
+    PrefixPath = ( AML_NAME_STRING ){
+        .Prefix       = AbsolutePath->Prefix,
+        .Segments     = AbsolutePath->Segments,
+        .SegmentCount = SegmentCount
+    };
+    FoundNode = AmlNamespacePathMapLookup( &State->PathMap, PrefixHashes[ SegmentCount ] );
+    if( ( FoundNode == NULL ) || ( AmlNamespaceCompareNameStringLocal( &FoundNode->AbsolutePath, &PrefixPath ) == AML_FALSE ) ) {
+        return NULL;
+    }
+
+    //
+    // Aliases are rare here, fall back to the full search to resolve them.
+    //
+    if( FoundNode->Object->Type == AML_OBJECT_TYPE_ALIAS ) {
+        if( AmlNamespaceSearch( State, NULL, &PrefixPath, 0, &FoundNode ) == AML_FALSE ) {
+            return NULL;
+        }
+    }
+
+    return FoundNode;
+}
+
+//
+// Push new namespace scope level, the prefix hashes of the path shared with the given base path are reused.
 //
 _Success_( return )
+static
 BOOLEAN
-AmlNamespacePushScope(
-    _Inout_ AML_NAMESPACE_STATE*   State,
-    _In_    const AML_NAME_STRING* Name,
-    _In_    UINT                   ScopeFlags
+AmlNamespacePushScopeInternal(
+    _Inout_  AML_NAMESPACE_STATE*   State,
+    _In_     const AML_NAME_STRING* Name,
+    _In_opt_ const AML_NAME_STRING* BasePath,
+    _In_opt_ const UINT32*          BasePrefixHashes,
+    _In_     UINT                   ScopeFlags
     )
 {
     AML_ARENA_SNAPSHOT   ScopeArenaSnapshot;
     AML_NAMESPACE_SCOPE* Scope;
     AML_NAME_STRING      AbsolutePath;
-    AML_NAME_STRING      ParentPath;
     AML_NAMESPACE_NODE*  ParentNode;
-    UINT32               PathHash;
+    UINT32*              PrefixHashes;
 
     //
     // Attempt to allocate a new namespace scope stack entry.
@@ -678,9 +824,15 @@ AmlNamespacePushScope(
     }
 
     //
-    // Attempt to hash the absolute path.
+    // Attempt to hash every prefix of the absolute path once, all searches made from this scope level
+    // (and its ancestor levels) will start from these hashes.
     //
-    if( AmlNamespaceHashPrefixedNameString( State->ScopeLast, &AbsolutePath, &PathHash ) == AML_FALSE ) {
+    if( AmlNamespaceHashAbsolutePathPrefixes( &State->ScopeArena,
+                                              &AbsolutePath,
+                                              BasePath,
+                                              BasePrefixHashes,
+                                              &PrefixHashes ) == AML_FALSE )
+    {
         AmlArenaSnapshotRollback( &State->ScopeArena, &ScopeArenaSnapshot );
         return AML_FALSE;
     }
@@ -691,28 +843,20 @@ AmlNamespacePushScope(
     *Scope = ( AML_NAMESPACE_SCOPE ){
         .ArenaSnapshot    = ScopeArenaSnapshot,
         .AbsolutePath     = AbsolutePath,
-        .AbsolutePathHash = PathHash,
+        .AbsolutePathHash = PrefixHashes[ AbsolutePath.SegmentCount ],
+        .PrefixHashes     = PrefixHashes,
         .Flags            = ScopeFlags,
     };
 
     //
     // Attempt to look up the parent namespace node (if any) to apply parent-specific properties to the new child scope.
+    // If we arent explicitly switching to a completely different scope, propagate the flags of the parent!
     // TODO: Scan back for the first valid node in the parent path.
     //
-    if( AbsolutePath.SegmentCount > 0 ) {
-        ParentPath = ( AML_NAME_STRING ){
-            .Prefix       = AbsolutePath.Prefix,
-            .Segments     = AbsolutePath.Segments,
-            .SegmentCount = ( AbsolutePath.SegmentCount - 1 )
-        };
-
-        //
-        // If we arent explicitly switching to a completely different scope, propagate the flags of the parent!
-        //
-        if( ( ScopeFlags & AML_SCOPE_FLAG_SWITCH ) == 0 ) {
-            if( AmlNamespaceSearch( State, NULL, &ParentPath, 0, &ParentNode ) ) {
-                Scope->Flags |= ParentNode->ScopeFlags;
-            }
+    if( ( AbsolutePath.SegmentCount > 0 ) && ( ( ScopeFlags & AML_SCOPE_FLAG_SWITCH ) == 0 ) ) {
+        ParentNode = AmlNamespaceSearchAbsolutePathPrefix( State, &AbsolutePath, PrefixHashes, ( AbsolutePath.SegmentCount - 1 ) );
+        if( ParentNode != NULL ) {
+            Scope->Flags |= ParentNode->ScopeFlags;
         }
     }
 
@@ -729,6 +873,42 @@ AmlNamespacePushScope(
     return AML_TRUE;
 }
 
+//
+// Push new namespace scope level.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespacePushScope(
+    _Inout_ AML_NAMESPACE_STATE*   State,
+    _In_    const AML_NAME_STRING* Name,
+    _In_    UINT                   ScopeFlags
+    )
+{
+    //
+    // Relative names share (at least) the path of the ancestor they are relative to with the current scope.
+    //
+    return AmlNamespacePushScopeInternal( State,
+                                          Name,
+                                          &State->ScopeLast->AbsolutePath,
+                                          State->ScopeLast->PrefixHashes,
+                                          ScopeFlags );
+}
+
+//
+// Push new namespace scope level for the absolute path of an existing node.
+// Equivalent to AmlNamespacePushScope with the node's absolute path, but reuses the node's precomputed path hashes.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespacePushNodeScope(
+    _Inout_ AML_NAMESPACE_STATE*      State,
+    _In_    const AML_NAMESPACE_NODE* Node,
+    _In_    UINT                      ScopeFlags
+    )
+{
+    return AmlNamespacePushScopeInternal( State, &Node->AbsolutePath, &Node->AbsolutePath, Node->PrefixHashes, ScopeFlags );
+}
+
 //
 // Pop last namespace scope level.
 //
@@ -781,6 +961,40 @@ AmlNamespacePopScope(
     return AmlArenaSnapshotRollback( &State->ScopeArena, &PoppedScope->ArenaSnapshot );
 }
 
+//
+// Find the innermost temporary scope level of the given scope stack that was pushed for the given method node
+// (the scope of the active invocation of the method), returns NULL if the method isn't active.
+// The temporary scope isn't stored on the node itself, the same method may be active within multiple execution contexts.
+//
+static
+AML_NAMESPACE_SCOPE*
+AmlNamespaceFindTemporaryScope(
+    _In_ AML_NAMESPACE_SCOPE*      ActiveScope,
+    _In_ const AML_NAMESPACE_NODE* Node
+    )
+{
+    AML_NAMESPACE_SCOPE* Scope;
+    SIZE_T               i;
+
+    for( Scope = ActiveScope; Scope != NULL; Scope = Scope->Parent ) {
+        if( ( ( Scope->Flags & AML_SCOPE_FLAG_TEMPORARY ) == 0 )
+            || ( Scope->AbsolutePathHash != Node->AbsolutePathHash )
+            || ( Scope->AbsolutePath.SegmentCount != Node->AbsolutePath.SegmentCount ) )
+        {
+            continue;
+        }
+        for( i = 0; i < Scope->AbsolutePath.SegmentCount; i++ ) {
+            if( Scope->AbsolutePath.Segments[ i ].AsUInt32 != Node->AbsolutePath.Segments[ i ].AsUInt32 ) {
+                break;
+            }
+        }
+        if( i == Scope->AbsolutePath.SegmentCount ) {
+            return Scope;
+        }
+    }
+    return NULL;
+}
+
 //
 // Create and link a new namespace node (does not initialize the node's object/value).
 // TODO: Release resources upon failure!
@@ -794,12 +1008,8 @@ AmlNamespaceCreateNode(
     _Outptr_    AML_NAMESPACE_NODE**   ppCreatedNode
     )
 {
-    AML_NAMESPACE_NODE*  Node;
-    AML_NAMESPACE_NODE** ppBucketHead;
-    AML_NAMESPACE_NODE*  BucketHead;
-    AML_NAMESPACE_NODE*  BucketEntry;
-    AML_NAME_STRING      ParentPath;
-    AML_NAMESPACE_NODE*  ParentNode;
+    AML_NAMESPACE_NODE* Node;
+    AML_NAMESPACE_NODE* ParentNode;
 
     //
     // Use the last level of scope if none given.
@@ -827,11 +1037,18 @@ AmlNamespaceCreateNode(
     }
 
     //
-    // Calculate path hash of the absolute path.
+    // Calculate the prefix hashes and the full path hash of the absolute path,
+    // the leading path shared with the active scope is already hashed.
     //
-    if( AmlNamespaceHashPrefixedNameString( ActiveScope, &Node->AbsolutePath, &Node->AbsolutePathHash ) == AML_FALSE ) {
+    if( AmlNamespaceHashAbsolutePathPrefixes( &State->PermanentArena,
+                                              &Node->AbsolutePath,
+                                              &ActiveScope->AbsolutePath,
+                                              ActiveScope->PrefixHashes,
+                                              &Node->PrefixHashes ) == AML_FALSE )
+    {
         return AML_FALSE;
     }
+    Node->AbsolutePathHash = Node->PrefixHashes[ Node->AbsolutePath.SegmentCount ];
 
     //
     // Save local name segment of the node.
@@ -841,34 +1058,11 @@ AmlNamespaceCreateNode(
     }
 
     //
-    // Lookup the hash-table bucket that the absolute path belongs to.
-    //
-    ppBucketHead = &State->AbsolutePathMap[ Node->AbsolutePathHash % AML_COUNTOF( State->AbsolutePathMap ) ];
-    BucketHead   = *ppBucketHead;
-
-    //
-    // Insert the node to the hash-table bucket.
+    // Insert the node to the absolute path hash-table.
+    // Fails if there is a name collision (any existing node with the same path hash).
     //
-    if( BucketHead != NULL ) {
-        //
-        // Ensure that there are no name collisions.
-        //
-        for( BucketEntry = BucketHead;
-             BucketEntry != NULL;
-             BucketEntry = BucketEntry->BucketNext )
-        {
-            if( ( BucketEntry->AbsolutePathHash == Node->AbsolutePathHash )
-                || AmlNamespaceCompareNameStringLocal( &BucketEntry->AbsolutePath, &Node->AbsolutePath ) )
-            {
-                return AML_FALSE;
-            }
-        }
-
-        //
-        // Link the new node to the head end of the bucket.
-        //
-        Node->BucketNext = BucketHead;
-        BucketHead->BucketPrevious = Node;
+    if( AmlNamespacePathMapInsert( &State->PathMap, Node->AbsolutePathHash, Node ) == AML_FALSE ) {
+        return AML_FALSE;
     }
 
     //
@@ -876,21 +1070,27 @@ AmlNamespaceCreateNode(
     // We don't scan backwards up through the whole path to handle paths with a missing parent link, as this may be happening out of order.
     //
     if( Node->AbsolutePath.SegmentCount > 0 ) {
-        ParentPath = ( AML_NAME_STRING ){
-            .Prefix       = Node->AbsolutePath.Prefix,
-            .Segments     = Node->AbsolutePath.Segments,
-            .SegmentCount = ( Node->AbsolutePath.SegmentCount - 1 )
-        };
+        ParentNode = AmlNamespaceSearchAbsolutePathPrefix( State,
+                                                           &Node->AbsolutePath,
+                                                           Node->PrefixHashes,
+                                                           ( Node->AbsolutePath.SegmentCount - 1 ) );
 
         //
         // Apply parent-specific properties if the parent exists.
         //
-        if( AmlNamespaceSearch( State, NULL, &ParentPath, 0, &ParentNode ) ) {
+        if( ParentNode != NULL ) {
             //
             // Propogate the flags and temporary scope of the parent to the new child.
+            // Nodes created directly within a method are linked to the temporary scope of the innermost active invocation of the method.
             //
             Node->ScopeFlags |= ParentNode->ScopeFlags;
-            Node->TempScope   = ParentNode->TempScope;
+            Node->TempScope   = NULL;
+            if( ( ParentNode->Object != NULL ) && ( ParentNode->Object->Type == AML_OBJECT_TYPE_METHOD ) ) {
+                Node->TempScope = AmlNamespaceFindTemporaryScope( ActiveScope, ParentNode );
+            }
+            if( Node->TempScope == NULL ) {
+                Node->TempScope = ParentNode->TempScope;
+            }
 
             //
             // If the found parent node is already present in the hierarchical tree, link the child to it.
@@ -901,6 +1101,14 @@ AmlNamespaceCreateNode(
         }
     }
 
+    //
+    // If the tree has already been built, but the node couldn't be linked to a parent,
+    // it won't be present in the child index of a parent that may be created later on.
+    //
+    if( State->TreeRoot.IsPresent && ( Node->TreeEntry.IsPresent == AML_FALSE ) ) {
+        State->TreeChildMapIncomplete = AML_TRUE;
+    }
+
     //
     // If the scope that this node is being created in is temporary, link it to the scope's temporary node list.
     //
@@ -927,9 +1135,9 @@ AmlNamespaceCreateNode(
     }
 
     //
-    // Make the inserted node the new head of the bucket.
+    // Invalidate all cached name resolutions that could now resolve to the new node.
     //
-    *ppBucketHead = Node;
+    State->Generations[ AmlNamespaceGenerationIndex( &Node->LocalName ) ] += 1;
 
     //
     // Return created and linked namespace node.
@@ -986,6 +1194,91 @@ AmlNamespaceParentNode(
     return Parent;
 }
 
+//
+// Attempt to look up a direct child of the given node by local name using the child index of the tree.
+// Returns AML_FALSE if the child index can't answer the lookup (the node isn't present in the tree yet,
+// or the child index may be incomplete), otherwise returns the found child, or NULL if there is no such child.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceTreeChildLookup(
+    _In_     const AML_NAMESPACE_STATE* State,
+    _In_     const AML_NAMESPACE_NODE*  Node,
+    _In_     const AML_NAME_SEG*        LocalName,
+    _Outptr_ AML_NAMESPACE_NODE**       ppChildNode
+    )
+{
+    AML_NAMESPACE_NODE* ChildNode;
+
+    if( Node->TreeEntry.IsPresent == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    ChildNode = AmlNamespaceChildMapLookup( &Node->TreeEntry.ChildMap, LocalName );
+    if( ( ChildNode == NULL ) && State->TreeChildMapIncomplete ) {
+        return AML_FALSE;
+    }
+    *ppChildNode = ChildNode;
+    return AML_TRUE;
+}
+
+//
+// Attempt to search for a single-segment unprefixed name relative to the input node using only the child index of the tree.
+// If SearchAncestors is set, the child indices of all path ancestors of the node are searched (same as the regular search rules).
+// Returns AML_FALSE if the lookup couldn't be answered using the child index alone.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceTreeSearchRelative(
+    _In_     const AML_NAMESPACE_STATE* State,
+    _In_     const AML_NAMESPACE_NODE*  Node,
+    _In_     const AML_NAME_SEG*        LocalName,
+    _In_     BOOLEAN                    SearchAncestors,
+    _Outptr_ AML_NAMESPACE_NODE**       ppFoundNode
+    )
+{
+    const AML_NAMESPACE_NODE* Current;
+    const AML_NAMESPACE_NODE* Parent;
+    AML_NAMESPACE_NODE*       FoundNode;
+
+    for( Current = Node; ; Current = Parent ) {
+        if( AmlNamespaceTreeChildLookup( State, Current, LocalName, &FoundNode ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+
+        //
+        // A found alias must be resolved by a regular search (child lookups without ancestors don't resolve aliases).
+        //
+        if( FoundNode != NULL ) {
+            if( SearchAncestors && ( FoundNode->Object->Type == AML_OBJECT_TYPE_ALIAS ) ) {
+                return AML_FALSE;
+            }
+            *ppFoundNode = FoundNode;
+            return AML_TRUE;
+        }
+
+        //
+        // Reached the root of the namespace, or the only level that is searched.
+        //
+        if( ( SearchAncestors == AML_FALSE ) || ( Current->AbsolutePath.SegmentCount == 0 ) ) {
+            *ppFoundNode = NULL;
+            return AML_TRUE;
+        }
+
+        //
+        // Move up to the parent level, the tree parent must be the node of the direct parent path.
+        //
+        if( ( Current->TreeEntry.Parent == NULL ) || ( Current->TreeEntry.Parent == &State->TreeRoot ) ) {
+            return AML_FALSE;
+        }
+        Parent = AML_CONTAINING_RECORD( Current->TreeEntry.Parent, AML_NAMESPACE_NODE, TreeEntry );
+        if( ( Parent->AbsolutePath.SegmentCount + 1 ) != Current->AbsolutePath.SegmentCount ) {
+            return AML_FALSE;
+        }
+    }
+}
+
 //
 // Search for the given name relative to the input node.
 // Attempts to find the given Name relative to the node or any of its ancestors.
@@ -1002,10 +1295,19 @@ AmlNamespaceSearchRelative(
     BOOLEAN             Success;
     AML_NAMESPACE_NODE* FoundNode;
 
+    //
+    // Typical case, single predefined child names (_STA, _ADR, etc.) are looked up directly from the tree's child index.
+    //
+    if( ( Name->Prefix.Length == 0 ) && ( Name->SegmentCount == 1 ) ) {
+        if( AmlNamespaceTreeSearchRelative( State, Node, &Name->Segments[ 0 ], SearchAncestors, &FoundNode ) ) {
+            return FoundNode;
+        }
+    }
+
     //
     // Temporarily switch to the scope of the given parent node and search for the name.
     //
-    if( AmlNamespacePushScope( State, &Node->AbsolutePath, AML_SCOPE_FLAG_SWITCH ) == AML_FALSE ) {
+    if( AmlNamespacePushNodeScope( State, Node, AML_SCOPE_FLAG_SWITCH ) == AML_FALSE ) {
         return NULL;
     }
     Success = AmlNamespaceSearch( State, NULL, Name, ( SearchAncestors ? 0 : AML_SEARCH_FLAG_NAME_CREATION ), &FoundNode );
@@ -1030,8 +1332,17 @@ AmlNamespaceSearchRelativeZ(
 {
     AML_ARENA_SNAPSHOT  Snapshot;
     AML_NAME_STRING     Name;
+    AML_NAME_SEG        Segment;
     AML_NAMESPACE_NODE* FoundNode;
 
+    //
+    // Single name segment paths don't require any allocations.
+    //
+    if( AmlPathStringZToNameSeg( NameString, &Segment ) ) {
+        Name = ( AML_NAME_STRING ){ .Segments = &Segment, .SegmentCount = 1 };
+        return AmlNamespaceSearchRelative( State, Node, &Name, SearchAncestors );
+    }
+
     //
     // Attempt to parse a null-terminated path string to an AML_NAME_STRING and search like normal.
     //
@@ -1081,8 +1392,6 @@ AmlNamespaceReleaseNode(
     _Inout_ _Post_invalid_ AML_NAMESPACE_NODE*  Node
     )
 {
-    UINT32 BucketIndex;
-
     //
     // Push a release action to the current snapshot if this node is within one.
     //
@@ -1096,30 +1405,19 @@ AmlNamespaceReleaseNode(
     }
 
     //
-    // Release the linked object (if any).
+    // Release the linked object (if any), shared objects are owned by their base namespace.
     //
-    if( Node->Object != &State->NilObject ) {
+    if( Node->Object->IsShared ) {
+        State->SharedObjectCount -= 1;
+    } else if( Node->Object != &State->NilObject ) {
         Node->Object->NamespaceNode = NULL;
         AmlObjectRelease( Node->Object );
     }
 
     //
-    // Unlink the node from the path hash-table sibling nodes.
+    // Remove the node from the absolute path hash-table.
     //
-    if( Node->BucketPrevious != NULL ) {
-        Node->BucketPrevious->BucketNext = Node->BucketNext;
-    }
-    if( Node->BucketNext != NULL ) {
-        Node->BucketNext->BucketPrevious = Node->BucketPrevious;
-    }
-
-    //
-    // If this node was the head of the hash-table bucket, update the new head.
-    //
-    BucketIndex = ( Node->AbsolutePathHash % AML_COUNTOF( State->AbsolutePathMap ) );
-    if( State->AbsolutePathMap[ BucketIndex ] == Node ) {
-        State->AbsolutePathMap[ BucketIndex ] = Node->BucketNext;
-    }
+    AmlNamespacePathMapRemove( &State->PathMap, Node->AbsolutePathHash, Node );
 
     //
     // Unlink the node from the in-order list.
@@ -1139,9 +1437,60 @@ AmlNamespaceReleaseNode(
     AmlNamespaceTreeUnlinkNode( State, &Node->TreeEntry );
 
     //
-    // Free the namespace node allocation.
+    // Invalidate all cached name resolutions and skip indexes that may still reference this node.
+    //
+    State->Generations[ AmlNamespaceGenerationIndex( &Node->LocalName ) ] += 1;
+    State->ReleaseCount += 1;
+    State->PermanentReleaseCount += ( ( Node->TempScope == NULL ) ? 1 : 0 );
+
+    //
+    // Free the namespace node allocation, deferred until no concurrent reader may still be accessing the node.
     //
-    AmlHeapFree( State->Heap, Node );
+    AmlEpochRetire( &State->Epoch, Node );
+}
+
+//
+// Replace the shared object of a node (see AML_OBJECT::IsShared) with a private copy allocated from the namespace heap.
+// Must be performed before the object of the node is modified, or referenced by anything other than the node itself.
+// Does nothing if the object of the node isn't shared.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespacePrivatizeNode(
+    _Inout_ AML_NAMESPACE_STATE* State,
+    _Inout_ AML_NAMESPACE_NODE*  Node
+    )
+{
+    const AML_OBJECT* Shared;
+    AML_OBJECT*       Object;
+
+    //
+    // Only named data objects are shared, copy the object along with its value (shared data is never referenced by duplicates).
+    //
+    Shared = Node->Object;
+    if( Shared->IsShared == AML_FALSE ) {
+        return AML_TRUE;
+    } else if( Shared->Type != AML_OBJECT_TYPE_NAME ) {
+        return AML_FALSE;
+    } else if( AmlObjectCreate( State->Heap, AML_OBJECT_TYPE_NAME, &Object ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    Object->RegCallBitmap       = Shared->RegCallBitmap;
+    Object->IsInitializedDevice = Shared->IsInitializedDevice;
+    Object->u.Name.String       = Shared->u.Name.String;
+    if( AmlDataDuplicate( &Shared->u.Name.Value, State->Heap, &Object->u.Name.Value ) == AML_FALSE ) {
+        AmlObjectRelease( Object );
+        return AML_FALSE;
+    }
+
+    //
+    // Link the private copy to the node, the shared object remains unmodified.
+    //
+    Object->NamespaceNode = Node;
+    Node->Object = Object;
+    State->SharedObjectCount -= 1;
+    State->PrivatizedObjectCount += 1;
+    return AML_TRUE;
 }
 
 //
@@ -1162,6 +1511,18 @@ AmlNamespaceTreeUnlinkNode(
         return;
     }
 
+    //
+    // Remove the node from the child index of its parent, and release its own child index.
+    // Any children of the node are transplanted to the parent below, and are no longer indexed by their direct parent path.
+    //
+    if( ( Node->Parent != NULL ) && ( Node->Parent != &State->TreeRoot ) ) {
+        AmlNamespaceChildMapRemove( &Node->Parent->ChildMap, AML_CONTAINING_RECORD( Node, AML_NAMESPACE_NODE, TreeEntry ) );
+    }
+    AmlNamespaceChildMapRelease( &Node->ChildMap, State->Heap );
+    if( Node->ChildFirst != NULL ) {
+        State->TreeChildMapIncomplete = AML_TRUE;
+    }
+
     //
     // Unlink the tree node from its siblings.
     //
@@ -1227,6 +1588,9 @@ AmlNamespaceTreeLinkChildNode(
     _Inout_ AML_NAMESPACE_TREE_NODE* ChildTreeNode
     )
 {
+    AML_NAMESPACE_NODE* ParentNode;
+    AML_NAMESPACE_NODE* ChildNode;
+
     //
     // The given child tree node must not already be present in the tree!
     //
@@ -1259,6 +1623,23 @@ AmlNamespaceTreeLinkChildNode(
     ChildTreeNode->Parent = TreeNode;
     ChildTreeNode->IsPresent = AML_TRUE;
 
+    //
+    // Index the child by its local name if it is a direct child of the parent node's path.
+    // Children linked from a deeper path (or failing to be indexed) can't be found through the child index,
+    // child lookups that miss the index must then fall back to a regular search.
+    //
+    ChildNode = AML_CONTAINING_RECORD( ChildTreeNode, AML_NAMESPACE_NODE, TreeEntry );
+    if( TreeNode != &State->TreeRoot ) {
+        ParentNode = AML_CONTAINING_RECORD( TreeNode, AML_NAMESPACE_NODE, TreeEntry );
+        if( ( ChildNode->AbsolutePath.SegmentCount != ( ParentNode->AbsolutePath.SegmentCount + 1 ) )
+            || ( AmlNamespaceChildMapInsert( &TreeNode->ChildMap, State->Heap, ChildNode ) == AML_FALSE ) )
+        {
+            State->TreeChildMapIncomplete = AML_TRUE;
+        }
+    } else if( ChildNode->AbsolutePath.SegmentCount != 0 ) {
+        State->TreeChildMapIncomplete = AML_TRUE;
+    }
+
     //
     // Update the tree depth of the linked node (how many ancestors it takes to reach this node).
     // Then use the tree node's depth to possibly update the maximum depth of the entire tree (deepest path).
@@ -1323,6 +1704,18 @@ AmlNamespaceTreeInsertNode(
     }
 }
 
+//
+// Mark the (initially empty) hierarchical tree as built, nodes may then be linked to the tree root directly.
+//
+VOID
+AmlNamespaceTreeInitializeRoot(
+    _Inout_ AML_NAMESPACE_STATE* State
+    )
+{
+    State->TreeRoot.Depth = 1;
+    State->TreeRoot.IsPresent = AML_TRUE;
+}
+
 //
 // Build the actual hierarchical namespace tree from the unsorted list of all namespace objects.
 // TODO: Allow rebuilding the tree, also allow rebuilding from a specific node.
@@ -1337,9 +1730,108 @@ AmlNamespaceTreeBuild(
     //
     // Iterate and insert all namespace nodes in unsorted order.
     //
-    State->TreeRoot.Depth = 1;
-    State->TreeRoot.IsPresent = AML_TRUE;
+    AmlNamespaceTreeInitializeRoot( State );
     for( Node = State->InOrderNodeHead; Node != NULL; Node = Node->InOrderNext ) {
         AmlNamespaceTreeInsertNode( State, Node );
     }
+}
+
+//
+// Register a new concurrent namespace reader, fails if the maximum amount of readers are already registered.
+// Registration itself must not race with the release of the namespace state.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceReaderRegister(
+    _Inout_ AML_NAMESPACE_STATE*  State,
+    _Out_   AML_NAMESPACE_READER* Reader
+    )
+{
+    *Reader = ( AML_NAMESPACE_READER ){ .State = State };
+    return AmlEpochReaderRegister( &State->Epoch, &Reader->Index );
+}
+
+//
+// Unregister a concurrent namespace reader, the reader must not be within a read-side critical section.
+//
+VOID
+AmlNamespaceReaderUnregister(
+    _Inout_ AML_NAMESPACE_READER* Reader
+    )
+{
+    AmlEpochReaderUnregister( &Reader->State->Epoch, Reader->Index );
+    *Reader = ( AML_NAMESPACE_READER ){ 0 };
+}
+
+//
+// Enter a read-side critical section, nodes found within it remain valid until AmlNamespaceReaderLeave.
+// Readers must not stay within a critical section for long, released nodes aren't freed until all readers have left.
+//
+VOID
+AmlNamespaceReaderEnter(
+    _Inout_ AML_NAMESPACE_READER* Reader
+    )
+{
+    AmlEpochReaderEnter( &Reader->State->Epoch, Reader->Index );
+}
+
+//
+// Leave a read-side critical section.
+//
+VOID
+AmlNamespaceReaderLeave(
+    _Inout_ AML_NAMESPACE_READER* Reader
+    )
+{
+    AmlEpochReaderLeave( &Reader->State->Epoch, Reader->Index );
+}
+
+//
+// Search for an existing node with the given name from a concurrent reader (within a read-side critical section).
+// Searches for the given name/path according to the rules in 5.3. ACPI Namespace, relative to the given scope node,
+// or relative to the root if no scope node is given. Aliases aren't resolved.
+// Only the path of the found node (and of the scope node) may be accessed by the reader,
+// the object of the node may only be accessed while the host holds the serialization of the state.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceReaderSearch(
+    _Inout_  AML_NAMESPACE_READER*     Reader,
+    _In_opt_ const AML_NAMESPACE_NODE* ScopeNode,
+    _In_     const AML_NAME_STRING*    Name,
+    _Outptr_ AML_NAMESPACE_NODE**      ppFoundNode
+    )
+{
+    AML_NAMESPACE_SCOPE        NodeScope;
+    const AML_NAMESPACE_SCOPE* ActiveScope;
+    AML_NAMESPACE_NODE*        FoundNode;
+
+    //
+    // Only the immutable path fields of the active scope are used by the search,
+    // the path and prefix hashes of a node are never modified once the node has been published.
+    //
+    if( ScopeNode != NULL ) {
+        NodeScope = ( AML_NAMESPACE_SCOPE ){
+            .AbsolutePath     = ScopeNode->AbsolutePath,
+            .AbsolutePathHash = ScopeNode->AbsolutePathHash,
+            .PrefixHashes     = ScopeNode->PrefixHashes,
+        };
+        ActiveScope = &NodeScope;
+    } else {
+        ActiveScope = &Reader->State->ScopeRoot;
+    }
+
+    //
+    // Search using the same rules as AmlNamespaceSearch, but through concurrent path map lookups.
+    //
+    if( ( Name->Prefix.Length > 0 ) || ( Name->SegmentCount > 1 ) ) {
+        FoundNode = AmlNamespaceSearchPrefixedName( Reader->State, ActiveScope, Name, AML_TRUE );
+    } else {
+        FoundNode = AmlNamespaceSearchRelativeName( Reader->State, ActiveScope, Name, AML_SEARCH_FLAG_NONE, AML_TRUE );
+    }
+    if( FoundNode == NULL ) {
+        return AML_FALSE;
+    }
+    *ppFoundNode = FoundNode;
+    return AML_TRUE;
 }
\ No newline at end of file
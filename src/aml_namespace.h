@@ -4,6 +4,9 @@
 #include "aml_data.h"
 #include "aml_arena.h"
 #include "aml_object.h"
+#include "aml_namespace_map.h"
+#include "aml_namespace_child_map.h"
+#include "aml_epoch.h"
 
 //
 // Seed used for namespace hashtables.
@@ -32,6 +35,12 @@ typedef struct _AML_NAMESPACE_TREE_NODE {
     //
     struct _AML_NAMESPACE_TREE_NODE* Parent;
 
+    //
+    // Index of the direct children of this node by local name (children whose path is one segment deeper than this node).
+    // Children linked to the node from a deeper path (missing intermediate path levels) aren't indexed.
+    //
+    AML_NAMESPACE_CHILD_MAP ChildMap;
+
     //
     // The depth of this node in the tree (how many ancestors it has).
     //
@@ -62,12 +71,6 @@ typedef struct _AML_NAMESPACE_NODE {
     //
     UINT64 ReferenceCount;
 
-    //
-    // FullPath hash-table bucket links.
-    //
-    struct _AML_NAMESPACE_NODE* BucketNext;
-    struct _AML_NAMESPACE_NODE* BucketPrevious;
-
     //
     // Evaluation-order list links.
     //
@@ -83,9 +86,12 @@ typedef struct _AML_NAMESPACE_NODE {
 
     //
     // The absolute full path to the node, multiple name segments, including the final local node name.
+    // PrefixHashes holds the hash of every prefix of the absolute path (SegmentCount + 1 entries),
+    // PrefixHashes[ i ] being the hash of the first i segments, and PrefixHashes[ SegmentCount ] being AbsolutePathHash.
     //
     AML_NAME_STRING AbsolutePath;
     UINT32          AbsolutePathHash;
+    UINT32*         PrefixHashes;
 
     //
     // The local node name, the last name segment of the path.
@@ -145,9 +151,12 @@ typedef struct _AML_NAMESPACE_SCOPE {
 
     //
     // Absolute path to this namespace, starting from root (\), including the name of itself.
+    // PrefixHashes holds the hash of every ancestor path (SegmentCount + 1 entries, see AML_NAMESPACE_NODE::PrefixHashes),
+    // allowing the relative name search to hash each ancestor level with a single additional segment.
     //
     AML_NAME_STRING AbsolutePath;
     UINT32          AbsolutePathHash;
+    UINT32*         PrefixHashes;
 
     //
     // Scope behavior flags (AML_SCOPE_FLAG).
@@ -163,14 +172,14 @@ typedef struct _AML_NAMESPACE_SCOPE {
 } AML_NAMESPACE_SCOPE;
 
 //
-// Namespace object hash table bucket count.
+// Namespace scope hash table bucket count.
 //
-#define AML_NAMESPACE_PATH_MAP_BUCKET_COUNT 1024
+#define AML_NAMESPACE_SCOPE_MAP_BUCKET_COUNT 128
 
 //
-// Namespace scope hash table bucket count.
+// Namespace generation counter count.
 //
-#define AML_NAMESPACE_SCOPE_MAP_BUCKET_COUNT 128
+#define AML_NAMESPACE_GENERATION_COUNT 256
 
 //
 // Global namespace state.
@@ -191,10 +200,39 @@ typedef struct _AML_NAMESPACE_STATE {
     //
     AML_ARENA TempArena;
 
+    //
+    // Deferred reclamation of released nodes and path map tables, allows concurrent readers (see AML_NAMESPACE_READER).
+    //
+    AML_EPOCH Epoch;
+
     //
     // Namespace absolute/full-path node hash-table.
     //
-    struct _AML_NAMESPACE_NODE* AbsolutePathMap[ AML_NAMESPACE_PATH_MAP_BUCKET_COUNT ];
+    AML_NAMESPACE_PATH_MAP PathMap;
+
+    //
+    // Namespace generation counters, changed whenever a node is created or removed.
+    // Counters are partitioned by the local name of the node (see AmlNamespaceGenerationIndex),
+    // used to invalidate cached name resolutions (see aml_name_cache.h).
+    //
+    UINT64 Generations[ AML_NAMESPACE_GENERATION_COUNT ];
+
+    //
+    // Total amount of released nodes, used to invalidate indexes that hold plain node pointers (see aml_skip_index.h).
+    //
+    UINT64 ReleaseCount;
+
+    //
+    // Amount of released permanent (non-temporary) nodes, used by caches keyed by long-lived node pointers (see aml_pci_topology.h).
+    //
+    UINT64 PermanentReleaseCount;
+
+    //
+    // Amount of nodes currently holding a shared object of a base namespace (see AML_OBJECT::IsShared),
+    // and amount of shared objects that have been replaced by a private copy (see AmlNamespacePrivatizeNode).
+    //
+    SIZE_T SharedObjectCount;
+    SIZE_T PrivatizedObjectCount;
 
     //
     // Empty sentinel object used by namespace nodes that have yet to be pointed to an object.
@@ -205,6 +243,7 @@ typedef struct _AML_NAMESPACE_STATE {
     // Namespace root scope, shouldn't usually be accessed directly.
     //
     AML_NAMESPACE_SCOPE ScopeRoot;
+    UINT32              ScopeRootPrefixHash; /* Backing storage of ScopeRoot.PrefixHashes. */
 
     //
     // Currently active namespace scopes.
@@ -219,6 +258,13 @@ typedef struct _AML_NAMESPACE_STATE {
     AML_NAMESPACE_TREE_NODE TreeRoot;
     UINT64                  TreeMaxDepth;
 
+    //
+    // Set if any node may be missing from the child index of its direct parent (see AML_NAMESPACE_TREE_NODE::ChildMap),
+    // for example if it was created without a parent node, or its parent has been removed.
+    // Child lookups that miss the child index must then fall back to a regular search.
+    //
+    BOOLEAN TreeChildMapIncomplete;
+
     //
     // Evaluation-order node list, used to build the final tree in order of how objects are laid out in code.
     //
@@ -226,6 +272,17 @@ typedef struct _AML_NAMESPACE_STATE {
     AML_NAMESPACE_NODE* InOrderNodeTail;
 } AML_NAMESPACE_STATE;
 
+//
+// Concurrent namespace reader.
+// Allows host threads that aren't using the state to search the namespace without waiting for the host serialization of the state,
+// while nodes are being created and released by the (serialized) evaluation of the state.
+// Only benefits host-side lookups, evaluation itself is never concurrent.
+//
+typedef struct _AML_NAMESPACE_READER {
+    struct _AML_NAMESPACE_STATE* State;
+    SIZE_T                       Index;
+} AML_NAMESPACE_READER;
+
 //
 // SearchFlags used by AmlNamespaceSearch.
 //
@@ -245,6 +302,7 @@ typedef struct _AML_NAMESPACE_STATE {
 //
 // Initialize global namespace state.
 // The given allocator and heap must remain valid for the entire lifetime of the namespace state.
+// The capacity hint is the expected amount of namespace nodes, used to pre-size the path hash-table (may be 0).
 // TODO: Take in PermanentArena as an argument instead of a regular Allocator,
 // then set up the scope arena to use the PermanentArena as a backend.
 //
@@ -252,7 +310,8 @@ VOID
 AmlNamespaceStateInitialize(
     _Out_   AML_NAMESPACE_STATE* State,
     _In_    AML_ALLOCATOR        Allocator,
-    _Inout_ AML_HEAP*            Heap
+    _Inout_ AML_HEAP*            Heap,
+    _In_    SIZE_T               CapacityHint
     );
 
 //
@@ -264,6 +323,16 @@ AmlNamespaceStateRelease(
     _Inout_ _Post_invalid_ AML_NAMESPACE_STATE* State
     );
 
+//
+// Get the index of the generation counter that tracks the creation and removal of nodes with the given local name.
+// Creating a node can only change the resolution of names that now resolve to the new node (with the same local name),
+// and removing a node can only change the resolution of names that resolved to the removed node.
+//
+UINT
+AmlNamespaceGenerationIndex(
+    _In_ const AML_NAME_SEG* LocalName
+    );
+
 //
 // Fully expand and compare two AML_NAME_STRING values.
 //
@@ -372,6 +441,18 @@ AmlNamespacePushScope(
     _In_    UINT                   ScopeFlags
     );
 
+//
+// Push new namespace scope level for the absolute path of an existing node.
+// Equivalent to AmlNamespacePushScope with the node's absolute path, but reuses the node's precomputed path hashes.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespacePushNodeScope(
+    _Inout_ AML_NAMESPACE_STATE*      State,
+    _In_    const AML_NAMESPACE_NODE* Node,
+    _In_    UINT                      ScopeFlags
+    );
+
 //
 // Pop last namespace scope level.
 //
@@ -402,6 +483,18 @@ AmlNamespaceReleaseNode(
     _Inout_ _Post_invalid_ AML_NAMESPACE_NODE*  Node
     );
 
+//
+// Replace the shared object of a node (see AML_OBJECT::IsShared) with a private copy allocated from the namespace heap.
+// Must be performed before the object of the node is modified, or referenced by anything other than the node itself.
+// Does nothing if the object of the node isn't shared.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespacePrivatizeNode(
+    _Inout_ AML_NAMESPACE_STATE* State,
+    _Inout_ AML_NAMESPACE_NODE*  Node
+    );
+
 //
 // Unlink the given node from the tree, transplanting its children to the parent.
 //
@@ -432,10 +525,70 @@ AmlNamespaceTreeInsertNode(
     _Inout_ AML_NAMESPACE_NODE*  Node
     );
 
+//
+// Mark the (initially empty) hierarchical tree as built, nodes may then be linked to the tree root directly.
+//
+VOID
+AmlNamespaceTreeInitializeRoot(
+    _Inout_ AML_NAMESPACE_STATE* State
+    );
+
 //
 // Build the actual hierarchical namespace tree from the unsorted list of all namespace objects.
 //
 VOID
 AmlNamespaceTreeBuild(
     _Inout_ AML_NAMESPACE_STATE* State	
+    );
+
+//
+// Register a new concurrent namespace reader, fails if the maximum amount of readers are already registered.
+// Registration itself must not race with the release of the namespace state.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceReaderRegister(
+    _Inout_ AML_NAMESPACE_STATE*  State,
+    _Out_   AML_NAMESPACE_READER* Reader
+    );
+
+//
+// Unregister a concurrent namespace reader, the reader must not be within a read-side critical section.
+//
+VOID
+AmlNamespaceReaderUnregister(
+    _Inout_ AML_NAMESPACE_READER* Reader
+    );
+
+//
+// Enter a read-side critical section, nodes found within it remain valid until AmlNamespaceReaderLeave.
+// Readers must not stay within a critical section for long, released nodes aren't freed until all readers have left.
+//
+VOID
+AmlNamespaceReaderEnter(
+    _Inout_ AML_NAMESPACE_READER* Reader
+    );
+
+//
+// Leave a read-side critical section.
+//
+VOID
+AmlNamespaceReaderLeave(
+    _Inout_ AML_NAMESPACE_READER* Reader
+    );
+
+//
+// Search for an existing node with the given name from a concurrent reader (within a read-side critical section).
+// Searches for the given name/path according to the rules in 5.3. ACPI Namespace, relative to the given scope node,
+// or relative to the root if no scope node is given. Aliases aren't resolved.
+// Only the path of the found node (and of the scope node) may be accessed by the reader,
+// the object of the node may only be accessed while the host holds the serialization of the state.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceReaderSearch(
+    _Inout_  AML_NAMESPACE_READER*     Reader,
+    _In_opt_ const AML_NAMESPACE_NODE* ScopeNode,
+    _In_     const AML_NAME_STRING*    Name,
+    _Outptr_ AML_NAMESPACE_NODE**      ppFoundNode
     );
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "aml_namespace_child_map.h"
+#include "aml_namespace.h"
+
+//
+// Hash a local name to the home slot index of the hashed child table.
+//
+static
+UINT32
+AmlNamespaceChildMapSlot(
+    _In_ const AML_NAMESPACE_CHILD_MAP* Map,
+    _In_ const AML_NAME_SEG*            LocalName
+    )
+{
+    UINT32 Hash;
+
+    //
+    // Name segments are 4 ASCII characters, a multiplicative mix is enough to spread them across the table.
+    //
+    Hash = ( LocalName->AsUInt32 * 0x9E3779B1u );
+    Hash ^= ( Hash >> 15 );
+    return ( Hash & ( Map->Capacity - 1 ) );
+}
+
+//
+// Insert a node to the first empty slot of its probe sequence.
+// The table must have already been checked to contain an empty slot.
+//
+static
+VOID
+AmlNamespaceChildMapTableInsert(
+    _Inout_ AML_NAMESPACE_CHILD_MAP* Map,
+    _In_    AML_NAMESPACE_NODE*      Node
+    )
+{
+    UINT32 Index;
+
+    Index = AmlNamespaceChildMapSlot( Map, &Node->LocalName );
+    while( Map->Table[ Index ] != NULL ) {
+        Index = ( ( Index + 1 ) & ( Map->Capacity - 1 ) );
+    }
+    Map->Table[ Index ] = Node;
+}
+
+//
+// Move all children to a newly allocated hashed table of the given capacity (must be a power of 2).
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceChildMapResize(
+    _Inout_ AML_NAMESPACE_CHILD_MAP* Map,
+    _Inout_ AML_HEAP*                Heap,
+    _In_    UINT32                   Capacity
+    )
+{
+    AML_NAMESPACE_NODE** OldTable;
+    UINT32               OldCapacity;
+    UINT32               i;
+
+    //
+    // Allocate the new empty table.
+    //
+    OldTable    = Map->Table;
+    OldCapacity = Map->Capacity;
+    if( ( Map->Table = AmlHeapAllocate( Heap, ( Capacity * sizeof( Map->Table[ 0 ] ) ) ) ) == NULL ) {
+        Map->Table = OldTable;
+        return AML_FALSE;
+    }
+    AML_MEMSET( Map->Table, 0, ( Capacity * sizeof( Map->Table[ 0 ] ) ) );
+    Map->Capacity = Capacity;
+
+    //
+    // Rehash the children of the previous table, or move all inline children to the table.
+    //
+    if( OldTable != NULL ) {
+        for( i = 0; i < OldCapacity; i++ ) {
+            if( OldTable[ i ] != NULL ) {
+                AmlNamespaceChildMapTableInsert( Map, OldTable[ i ] );
+            }
+        }
+        AmlHeapFree( Heap, OldTable );
+    } else {
+        for( i = 0; i < Map->Count; i++ ) {
+            AmlNamespaceChildMapTableInsert( Map, Map->Inline[ i ] );
+            Map->Inline[ i ] = NULL;
+        }
+    }
+
+    return AML_TRUE;
+}
+
+//
+// Release the hashed table of the child map (if any) and reset it to an empty map.
+//
+VOID
+AmlNamespaceChildMapRelease(
+    _Inout_ AML_NAMESPACE_CHILD_MAP* Map,
+    _Inout_ AML_HEAP*                Heap
+    )
+{
+    if( Map->Table != NULL ) {
+        AmlHeapFree( Heap, Map->Table );
+    }
+    *Map = ( AML_NAMESPACE_CHILD_MAP ){ 0 };
+}
+
+//
+// Lookup the child with the given local name, returns NULL if the map has no such child.
+//
+_Success_( return != NULL )
+AML_NAMESPACE_NODE*
+AmlNamespaceChildMapLookup(
+    _In_ const AML_NAMESPACE_CHILD_MAP* Map,
+    _In_ const AML_NAME_SEG*            LocalName
+    )
+{
+    UINT32              Index;
+    UINT32              i;
+    AML_NAMESPACE_NODE* Node;
+
+    //
+    // Scan the inline children.
+    //
+    if( Map->Table == NULL ) {
+        for( i = 0; i < Map->Count; i++ ) {
+            if( Map->Inline[ i ]->LocalName.AsUInt32 == LocalName->AsUInt32 ) {
+                return Map->Inline[ i ];
+            }
+        }
+        return NULL;
+    }
+
+    //
+    // Linearly probe the hashed table until the child or an empty slot is found.
+    //
+    Index = AmlNamespaceChildMapSlot( Map, LocalName );
+    for( i = 0; i < Map->Capacity; i++ ) {
+        Node = Map->Table[ ( Index + i ) & ( Map->Capacity - 1 ) ];
+        if( Node == NULL ) {
+            break;
+        } else if( Node->LocalName.AsUInt32 == LocalName->AsUInt32 ) {
+            return Node;
+        }
+    }
+    return NULL;
+}
+
+//
+// Insert a child node to the map, keyed by the local name of the node.
+// Fails if a child with the same local name already exists, or if the hashed table couldn't be grown.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceChildMapInsert(
+    _Inout_ AML_NAMESPACE_CHILD_MAP* Map,
+    _Inout_ AML_HEAP*                Heap,
+    _In_    AML_NAMESPACE_NODE*      Node
+    )
+{
+    //
+    // Local names of direct children are unique.
+    //
+    if( AmlNamespaceChildMapLookup( Map, &Node->LocalName ) != NULL ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Typical case, there is still room for the child inline.
+    //
+    if( ( Map->Table == NULL ) && ( Map->Count < AML_NAMESPACE_CHILD_MAP_INLINE_COUNT ) ) {
+        Map->Inline[ Map->Count++ ] = Node;
+        return AML_TRUE;
+    }
+
+    //
+    // Switch to (or grow) the hashed table, keeping the load factor of the table at most 3/4.
+    //
+    if( Map->Table == NULL ) {
+        if( AmlNamespaceChildMapResize( Map, Heap, AML_NAMESPACE_CHILD_MAP_MIN_CAPACITY ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+    } else if( ( ( Map->Count + 1 ) * 4 ) > ( Map->Capacity * 3 ) ) {
+        if( ( Map->Capacity > ( UINT32_MAX / 2 / sizeof( Map->Table[ 0 ] ) ) )
+            || ( AmlNamespaceChildMapResize( Map, Heap, ( Map->Capacity * 2 ) ) == AML_FALSE ) )
+        {
+            return AML_FALSE;
+        }
+    }
+    AmlNamespaceChildMapTableInsert( Map, Node );
+    Map->Count += 1;
+    return AML_TRUE;
+}
+
+//
+// Remove the given child node from the map, does nothing if the node isn't in the map.
+//
+VOID
+AmlNamespaceChildMapRemove(
+    _Inout_ AML_NAMESPACE_CHILD_MAP* Map,
+    _In_    AML_NAMESPACE_NODE*      Node
+    )
+{
+    UINT32              Index;
+    UINT32              Next;
+    UINT32              Home;
+    UINT32              i;
+    AML_NAMESPACE_NODE* Moved;
+
+    //
+    // Remove inline children by moving the last inline child into the free slot.
+    //
+    if( Map->Table == NULL ) {
+        for( i = 0; i < Map->Count; i++ ) {
+            if( Map->Inline[ i ] == Node ) {
+                Map->Inline[ i ] = Map->Inline[ --Map->Count ];
+                Map->Inline[ Map->Count ] = NULL;
+                return;
+            }
+        }
+        return;
+    }
+
+    //
+    // Find the slot of the node within the hashed table.
+    //
+    Index = AmlNamespaceChildMapSlot( Map, &Node->LocalName );
+    for( i = 0; i < Map->Capacity; i++ ) {
+        if( ( Map->Table[ Index ] == NULL ) || ( Map->Table[ Index ] == Node ) ) {
+            break;
+        }
+        Index = ( ( Index + 1 ) & ( Map->Capacity - 1 ) );
+    }
+    if( ( i >= Map->Capacity ) || ( Map->Table[ Index ] != Node ) ) {
+        return;
+    }
+
+    //
+    // Backward shift deletion, move following entries of the probe sequence back into the freed slot
+    // if their home slot doesn't lie (cyclically) between the freed slot and their current slot.
+    //
+    Map->Table[ Index ] = NULL;
+    Map->Count -= 1;
+    for( Next = ( ( Index + 1 ) & ( Map->Capacity - 1 ) ); Map->Table[ Next ] != NULL; Next = ( ( Next + 1 ) & ( Map->Capacity - 1 ) ) ) {
+        Moved = Map->Table[ Next ];
+        Home = AmlNamespaceChildMapSlot( Map, &Moved->LocalName );
+        if( ( ( Next - Home ) & ( Map->Capacity - 1 ) ) >= ( ( Next - Index ) & ( Map->Capacity - 1 ) ) ) {
+            Map->Table[ Index ] = Moved;
+            Map->Table[ Next ] = NULL;
+            Index = Next;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_heap.h"
+#include "aml_data.h"
+
+//
+// Amount of children stored inline in the child map before switching to a hashed table.
+//
+#define AML_NAMESPACE_CHILD_MAP_INLINE_COUNT 4
+
+//
+// Initial capacity of the hashed child table (must be a power of 2).
+//
+#define AML_NAMESPACE_CHILD_MAP_MIN_CAPACITY 16
+
+//
+// Index of the direct children of a namespace tree node, keyed by the local name (AML_NAME_SEG) of each child.
+// A few children are stored in a small inline array, once there are more children than fit inline,
+// all children are moved to a linear probing table of child node pointers.
+//
+typedef struct _AML_NAMESPACE_CHILD_MAP {
+    struct _AML_NAMESPACE_NODE*  Inline[ AML_NAMESPACE_CHILD_MAP_INLINE_COUNT ];
+    struct _AML_NAMESPACE_NODE** Table;    /* Hashed child table, NULL while all children are stored inline. */
+    UINT32                       Count;
+    UINT32                       Capacity; /* Capacity of the hashed child table. */
+} AML_NAMESPACE_CHILD_MAP;
+
+//
+// Release the hashed table of the child map (if any) and reset it to an empty map.
+//
+VOID
+AmlNamespaceChildMapRelease(
+    _Inout_ AML_NAMESPACE_CHILD_MAP* Map,
+    _Inout_ AML_HEAP*                Heap
+    );
+
+//
+// Lookup the child with the given local name, returns NULL if the map has no such child.
+//
+_Success_( return != NULL )
+struct _AML_NAMESPACE_NODE*
+AmlNamespaceChildMapLookup(
+    _In_ const AML_NAMESPACE_CHILD_MAP* Map,
+    _In_ const AML_NAME_SEG*            LocalName
+    );
+
+//
+// Insert a child node to the map, keyed by the local name of the node.
+// Fails if a child with the same local name already exists, or if the hashed table couldn't be grown.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceChildMapInsert(
+    _Inout_ AML_NAMESPACE_CHILD_MAP*    Map,
+    _Inout_ AML_HEAP*                   Heap,
+    _In_    struct _AML_NAMESPACE_NODE* Node
+    );
+
+//
+// Remove the given child node from the map, does nothing if the node isn't in the map.
+//
+VOID
+AmlNamespaceChildMapRemove(
+    _Inout_ AML_NAMESPACE_CHILD_MAP*    Map,
+    _In_    struct _AML_NAMESPACE_NODE* Node
+    );
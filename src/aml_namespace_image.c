@@ -0,0 +1,2418 @@
+#include "aml_namespace_image.h"
+#include "aml_state.h"
+#include "aml_heap.h"
+#include "aml_hash.h"
+#include "aml_host.h"
+#include "aml_field.h"
+#include "aml_debug.h"
+#include "aml_pci_topology.h"
+
+//
+// Growable record section of an image under construction.
+//
+typedef struct _AML_NAMESPACE_IMAGE_SECTION {
+    UINT8* Data;
+    SIZE_T Size;
+    SIZE_T Capacity;
+} AML_NAMESPACE_IMAGE_SECTION;
+
+//
+// Image construction state.
+// Nodes, objects, buffers, and packages are mapped to their record index by address (identity map),
+// preserving sharing of reference counted data (for example, the source buffer of a buffer field and its named buffer).
+//
+typedef struct _AML_NAMESPACE_IMAGE_WRITER {
+    AML_STATE*                       State;
+    AML_HEAP*                        Heap;
+    const AML_NAMESPACE_IMAGE_TABLE* Tables;
+    SIZE_T                           TableCount;
+    AML_NAMESPACE_IMAGE_SECTION      Nodes;
+    AML_NAMESPACE_IMAGE_SECTION      Values;
+    AML_NAMESPACE_IMAGE_SECTION      Buffers;
+    AML_NAMESPACE_IMAGE_SECTION      Packages;
+    AML_NAMESPACE_IMAGE_SECTION      PackageSources;   /* Source package of every package record, elements are written after all nodes. */
+    AML_NAMESPACE_IMAGE_SECTION      CodeBlocks;
+    AML_NAMESPACE_IMAGE_SECTION      CodeBlockSources; /* Source code of every code block record. */
+    AML_NAMESPACE_IMAGE_SECTION      TreeLinks;
+    AML_NAMESPACE_IMAGE_SECTION      Pool;
+    UINT_PTR*                        MapKeys;
+    UINT32*                          MapValues;
+    SIZE_T                           MapCapacity;
+    SIZE_T                           MapCount;
+} AML_NAMESPACE_IMAGE_WRITER;
+
+//
+// Image loading state, records are read in place from the image.
+//
+typedef struct _AML_NAMESPACE_IMAGE_READER {
+    AML_STATE*                            State;
+    const AML_NAMESPACE_IMAGE_HEADER*     Header;
+    const AML_NAMESPACE_IMAGE_TABLE*      Tables;
+    const AML_NAMESPACE_IMAGE_NODE*       Nodes;
+    const AML_NAMESPACE_IMAGE_VALUE*      Values;
+    const AML_NAMESPACE_IMAGE_BUFFER*     Buffers;
+    const AML_NAMESPACE_IMAGE_PACKAGE*    Packages;
+    const AML_NAMESPACE_IMAGE_CODE_BLOCK* CodeBlocks;
+    const AML_NAMESPACE_IMAGE_TREE_LINK*  TreeLinks;
+    const UINT8*                          Pool;
+    const AML_NAMESPACE_BASE*             Base;          /* Base namespace providing shared objects and data, or NULL. */
+    AML_NAMESPACE_NODE**                  ExistingNodes; /* Node already present within the state (not created), by node index. */
+    AML_NAMESPACE_NODE**                  CreatedNodes;  /* Node created by the reader, by node index. */
+    AML_OBJECT**                          Objects;       /* Object of every node, by node index. */
+    AML_BUFFER_DATA**                     BufferData;    /* Buffer data of every buffer record, the reader holds a reference to each. */
+    AML_PACKAGE_DATA**                    PackageData;   /* Package of every package record, the reader holds a reference to each. */
+} AML_NAMESPACE_IMAGE_READER;
+
+//
+// Base namespace construction state.
+// Counts the values referencing every buffer, package, and node record of the image,
+// data referenced by multiple values (or nodes referenced by any value) must remain private to each state.
+//
+typedef struct _AML_NAMESPACE_BASE_BUILDER {
+    AML_NAMESPACE_IMAGE_READER Reader;
+    AML_NAMESPACE_BASE*        Base;
+    UINT32*                    BufferUses;
+    UINT32*                    PackageUses;
+    UINT32*                    NodeUses;
+} AML_NAMESPACE_BASE_BUILDER;
+
+//
+// Reserve (and zero) space for the given amount of bytes at the end of a section, returns the offset of the reserved space.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageSectionReserve(
+    _Inout_ AML_HEAP*                    Heap,
+    _Inout_ AML_NAMESPACE_IMAGE_SECTION* Section,
+    _In_    SIZE_T                       Size,
+    _Out_   SIZE_T*                      pOffset
+    )
+{
+    UINT8* NewData;
+    SIZE_T NewCapacity;
+
+    //
+    // Grow the section by doubling its capacity until the reserved space fits.
+    //
+    if( Size > ( SIZE_MAX - Section->Size ) ) {
+        return AML_FALSE;
+    }
+    if( ( Section->Size + Size ) > Section->Capacity ) {
+        NewCapacity = AML_MAX( Section->Capacity, AML_NAMESPACE_IMAGE_MIN_SECTION_CAPACITY );
+        while( NewCapacity < ( Section->Size + Size ) ) {
+            if( NewCapacity > ( SIZE_MAX / 2 ) ) {
+                return AML_FALSE;
+            }
+            NewCapacity *= 2;
+        }
+        if( ( NewData = AmlHeapAllocate( Heap, NewCapacity ) ) == NULL ) {
+            return AML_FALSE;
+        }
+        if( Section->Data != NULL ) {
+            AML_MEMCPY( NewData, Section->Data, Section->Size );
+            AmlHeapFree( Heap, Section->Data );
+        }
+        Section->Data     = NewData;
+        Section->Capacity = NewCapacity;
+    }
+
+    //
+    // Zero the reserved space, the final image never contains uninitialized padding.
+    //
+    AML_MEMSET( &Section->Data[ Section->Size ], 0, Size );
+    *pOffset = Section->Size;
+    Section->Size += Size;
+    return AML_TRUE;
+}
+
+//
+// Append a copy of the given record to the end of a section.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageSectionAppend(
+    _Inout_                  AML_HEAP*                    Heap,
+    _Inout_                  AML_NAMESPACE_IMAGE_SECTION* Section,
+    _In_reads_bytes_( Size ) const VOID*                  Record,
+    _In_                     SIZE_T                       Size
+    )
+{
+    SIZE_T Offset;
+
+    if( AmlNamespaceImageSectionReserve( Heap, Section, Size, &Offset ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    AML_MEMCPY( &Section->Data[ Offset ], Record, Size );
+    return AML_TRUE;
+}
+
+//
+// Identity map slot of the given key.
+//
+static
+SIZE_T
+AmlNamespaceImageMapSlot(
+    _In_ UINT_PTR Key,
+    _In_ SIZE_T   Capacity
+    )
+{
+    return ( AmlHashKey32( &Key, sizeof( Key ), 0 ) & ( Capacity - 1 ) );
+}
+
+//
+// Look up the record index of an object, buffer, or package.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageMapLookup(
+    _In_  const AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_  const VOID*                       Address,
+    _Out_ UINT32*                           pIndex
+    )
+{
+    UINT_PTR Key;
+    SIZE_T   Slot;
+
+    Key = ( UINT_PTR )Address;
+    if( ( Key == 0 ) || ( Writer->MapCapacity == 0 ) ) {
+        return AML_FALSE;
+    }
+    for( Slot = AmlNamespaceImageMapSlot( Key, Writer->MapCapacity );
+         Writer->MapKeys[ Slot ] != 0;
+         Slot = ( ( Slot + 1 ) & ( Writer->MapCapacity - 1 ) ) )
+    {
+        if( Writer->MapKeys[ Slot ] == Key ) {
+            *pIndex = Writer->MapValues[ Slot ];
+            return AML_TRUE;
+        }
+    }
+    return AML_FALSE;
+}
+
+//
+// Insert a new entry to the identity map, fails if the address has already been mapped.
+// The map is kept at most half full, and grown by doubling its capacity.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageMapInsert(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_    const VOID*                 Address,
+    _In_    UINT32                      Index
+    )
+{
+    UINT_PTR  Key;
+    UINT32    ExistingIndex;
+    UINT_PTR* NewKeys;
+    UINT32*   NewValues;
+    SIZE_T    NewCapacity;
+    SIZE_T    Slot;
+    SIZE_T    i;
+
+    Key = ( UINT_PTR )Address;
+    if( ( Key == 0 ) || AmlNamespaceImageMapLookup( Writer, Address, &ExistingIndex ) ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Grow the map and re-insert all existing entries if needed.
+    //
+    if( ( ( Writer->MapCount + 1 ) * 2 ) > Writer->MapCapacity ) {
+        NewCapacity = AML_MAX( AML_NAMESPACE_IMAGE_MIN_MAP_CAPACITY, ( Writer->MapCapacity * 2 ) );
+        if( NewCapacity > ( SIZE_MAX / sizeof( NewKeys[ 0 ] ) ) ) {
+            return AML_FALSE;
+        } else if( ( NewKeys = AmlHeapAllocate( Writer->Heap, ( NewCapacity * sizeof( NewKeys[ 0 ] ) ) ) ) == NULL ) {
+            return AML_FALSE;
+        } else if( ( NewValues = AmlHeapAllocate( Writer->Heap, ( NewCapacity * sizeof( NewValues[ 0 ] ) ) ) ) == NULL ) {
+            AmlHeapFree( Writer->Heap, NewKeys );
+            return AML_FALSE;
+        }
+        for( i = 0; i < NewCapacity; i++ ) {
+            NewKeys[ i ] = 0;
+        }
+        for( i = 0; i < Writer->MapCapacity; i++ ) {
+            if( Writer->MapKeys[ i ] == 0 ) {
+                continue;
+            }
+            for( Slot = AmlNamespaceImageMapSlot( Writer->MapKeys[ i ], NewCapacity );
+                 NewKeys[ Slot ] != 0;
+                 Slot = ( ( Slot + 1 ) & ( NewCapacity - 1 ) ) )
+            {
+            }
+            NewKeys[ Slot ]   = Writer->MapKeys[ i ];
+            NewValues[ Slot ] = Writer->MapValues[ i ];
+        }
+        if( Writer->MapKeys != NULL ) {
+            AmlHeapFree( Writer->Heap, Writer->MapKeys );
+            AmlHeapFree( Writer->Heap, Writer->MapValues );
+        }
+        Writer->MapKeys     = NewKeys;
+        Writer->MapValues   = NewValues;
+        Writer->MapCapacity = NewCapacity;
+    }
+
+    //
+    // Insert the new entry at the first free slot.
+    //
+    for( Slot = AmlNamespaceImageMapSlot( Key, Writer->MapCapacity );
+         Writer->MapKeys[ Slot ] != 0;
+         Slot = ( ( Slot + 1 ) & ( Writer->MapCapacity - 1 ) ) )
+    {
+    }
+    Writer->MapKeys[ Slot ]   = Key;
+    Writer->MapValues[ Slot ] = Index;
+    Writer->MapCount++;
+    return AML_TRUE;
+}
+
+//
+// Release all construction state of a writer.
+//
+static
+VOID
+AmlNamespaceImageWriterFree(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer
+    )
+{
+    AML_NAMESPACE_IMAGE_SECTION* Sections[ ] = {
+        &Writer->Nodes,
+        &Writer->Values,
+        &Writer->Buffers,
+        &Writer->Packages,
+        &Writer->PackageSources,
+        &Writer->CodeBlocks,
+        &Writer->CodeBlockSources,
+        &Writer->TreeLinks,
+        &Writer->Pool
+    };
+    SIZE_T i;
+
+    for( i = 0; i < AML_COUNTOF( Sections ); i++ ) {
+        if( Sections[ i ]->Data != NULL ) {
+            AmlHeapFree( Writer->Heap, Sections[ i ]->Data );
+            Sections[ i ]->Data = NULL;
+        }
+    }
+    if( Writer->MapKeys != NULL ) {
+        AmlHeapFree( Writer->Heap, Writer->MapKeys );
+        AmlHeapFree( Writer->Heap, Writer->MapValues );
+        Writer->MapKeys = NULL;
+        Writer->MapValues = NULL;
+    }
+}
+
+//
+// Calculate the key of a table, tables must at least hold a full description header.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageTableKey(
+    _In_  const AML_NAMESPACE_IMAGE_TABLE* Table,
+    _Out_ AML_NAMESPACE_IMAGE_TABLE_KEY*   Key
+    )
+{
+    AML_MEMSET( Key, 0, sizeof( *Key ) );
+    if( ( Table->Table == NULL ) || ( Table->TableSize < sizeof( AML_DESCRIPTION_HEADER ) ) ) {
+        return AML_FALSE;
+    }
+    AML_MEMCPY( &Key->Header, Table->Table, sizeof( Key->Header ) );
+    Key->ContentHash = AmlHashKey32( Table->Table, Table->TableSize, AML_NAMESPACE_IMAGE_HASH_SEED );
+    Key->TableSize   = Table->TableSize;
+    return AML_TRUE;
+}
+
+//
+// Write a name string record, the segments of the name are appended to the byte pool.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteName(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_    const AML_NAME_STRING*      Name,
+    _Out_   AML_NAMESPACE_IMAGE_NAME*   Output
+    )
+{
+    SIZE_T Offset;
+    SIZE_T i;
+
+    AML_MEMSET( Output, 0, sizeof( *Output ) );
+    if( ( Name->Prefix.Length > sizeof( Output->Prefix ) ) || ( Name->SegmentCount > ( UINT32_MAX / sizeof( AML_NAME_SEG ) ) ) ) {
+        return AML_FALSE;
+    }
+    for( i = 0; i < Name->Prefix.Length; i++ ) {
+        Output->Prefix[ i ] = Name->Prefix.Data[ i ];
+    }
+    Output->PrefixLength = ( UINT8 )Name->Prefix.Length;
+    Output->SegmentCount = ( UINT32 )Name->SegmentCount;
+    if( Name->SegmentCount != 0 ) {
+        if( AmlNamespaceImageSectionReserve( Writer->Heap, &Writer->Pool, ( Name->SegmentCount * sizeof( AML_NAME_SEG ) ), &Offset ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        AML_MEMCPY( &Writer->Pool.Data[ Offset ], Name->Segments, ( Name->SegmentCount * sizeof( AML_NAME_SEG ) ) );
+        Output->SegmentOffset = Offset;
+    }
+    return AML_TRUE;
+}
+
+//
+// Write the record of a string/buffer (only once per buffer data), returns the index of the buffer record.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteBuffer(
+    _Inout_  AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_opt_ const AML_BUFFER_DATA*      Buffer,
+    _Out_    UINT32*                     pIndex
+    )
+{
+    AML_NAMESPACE_IMAGE_BUFFER Record;
+    SIZE_T                     Count;
+    SIZE_T                     Offset;
+
+    //
+    // Buffer data shared by multiple values is only recorded once.
+    //
+    if( Buffer == NULL ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageMapLookup( Writer, Buffer, pIndex ) ) {
+        return AML_TRUE;
+    }
+
+    //
+    // Copy the contents of the buffer to the byte pool.
+    //
+    Count = ( Writer->Buffers.Size / sizeof( Record ) );
+    if( ( Count >= AML_NAMESPACE_IMAGE_NO_INDEX ) || ( ( Buffer->Size != 0 ) && ( Buffer->Data == NULL ) ) ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageSectionReserve( Writer->Heap, &Writer->Pool, Buffer->Size, &Offset ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    if( Buffer->Size != 0 ) {
+        AML_MEMCPY( &Writer->Pool.Data[ Offset ], Buffer->Data, Buffer->Size );
+    }
+
+    //
+    // Append the buffer record.
+    //
+    Record = ( AML_NAMESPACE_IMAGE_BUFFER ){ .DataOffset = Offset, .Size = Buffer->Size, .MaxSize = Buffer->MaxSize };
+    if( AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->Buffers, &Record, sizeof( Record ) ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageMapInsert( Writer, Buffer, ( UINT32 )Count ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    *pIndex = ( UINT32 )Count;
+    return AML_TRUE;
+}
+
+//
+// Write the record of a package (only once per package), returns the index of the package record.
+// Only reserves the value records of the package elements, elements are written once all nodes have been written.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWritePackage(
+    _Inout_  AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_opt_ const AML_PACKAGE_DATA*     Package,
+    _Out_    UINT32*                     pIndex
+    )
+{
+    AML_NAMESPACE_IMAGE_PACKAGE Record;
+    SIZE_T                      Count;
+    SIZE_T                      FirstValue;
+    SIZE_T                      Offset;
+
+    //
+    // Packages shared by multiple values are only recorded once.
+    //
+    if( Package == NULL ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageMapLookup( Writer, Package, pIndex ) ) {
+        return AML_TRUE;
+    }
+
+    //
+    // Reserve consecutive (uninitialized) value records for all elements.
+    //
+    Count = ( Writer->Packages.Size / sizeof( Record ) );
+    FirstValue = ( Writer->Values.Size / sizeof( AML_NAMESPACE_IMAGE_VALUE ) );
+    if( ( Count >= AML_NAMESPACE_IMAGE_NO_INDEX )
+        || ( Package->ElementCount >= ( AML_NAMESPACE_IMAGE_NO_INDEX - FirstValue ) ) )
+    {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageSectionReserve( Writer->Heap,
+                                                &Writer->Values,
+                                                ( ( SIZE_T )Package->ElementCount * sizeof( AML_NAMESPACE_IMAGE_VALUE ) ),
+                                                &Offset ) == AML_FALSE )
+    {
+        return AML_FALSE;
+    }
+
+    //
+    // Append the package record, and queue the package for writing of its elements.
+    //
+    Record = ( AML_NAMESPACE_IMAGE_PACKAGE ){ .FirstValue = ( UINT32 )FirstValue, .ElementCount = ( UINT32 )Package->ElementCount };
+    if( AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->Packages, &Record, sizeof( Record ) ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->PackageSources, &Package, sizeof( Package ) ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageMapInsert( Writer, Package, ( UINT32 )Count ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    *pIndex = ( UINT32 )Count;
+    return AML_TRUE;
+}
+
+//
+// Build the record of a data value, referenced objects must be owned by a recorded node.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteValue(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_    const AML_DATA*             Value,
+    _Out_   AML_NAMESPACE_IMAGE_VALUE*  Output
+    )
+{
+    *Output = ( AML_NAMESPACE_IMAGE_VALUE ){ .Type = Value->Type, .Index = AML_NAMESPACE_IMAGE_NO_INDEX };
+    switch( Value->Type ) {
+    case AML_DATA_TYPE_NONE:
+    case AML_DATA_TYPE_DEBUG:
+        return AML_TRUE;
+    case AML_DATA_TYPE_INTEGER:
+        Output->Integer = Value->u.Integer;
+        return AML_TRUE;
+    case AML_DATA_TYPE_STRING:
+        return AmlNamespaceImageWriteBuffer( Writer, Value->u.String, &Output->Index );
+    case AML_DATA_TYPE_BUFFER:
+        return AmlNamespaceImageWriteBuffer( Writer, Value->u.Buffer, &Output->Index );
+    case AML_DATA_TYPE_PACKAGE:
+        return AmlNamespaceImageWritePackage( Writer, Value->u.Package, &Output->Index );
+    case AML_DATA_TYPE_PACKAGE_ELEMENT:
+        Output->Integer = Value->u.PackageElement.ElementIndex;
+        return AmlNamespaceImageWritePackage( Writer, Value->u.PackageElement.Package, &Output->Index );
+    case AML_DATA_TYPE_REFERENCE:
+        return AmlNamespaceImageMapLookup( Writer, Value->u.Reference.Object, &Output->Index );
+    case AML_DATA_TYPE_FIELD_UNIT:
+        return AmlNamespaceImageMapLookup( Writer, Value->u.FieldUnit, &Output->Index );
+    default:
+        return AML_FALSE;
+    }
+}
+
+//
+// Append the record of a data value, returns the index of the value record.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageAppendValue(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_    const AML_DATA*             Value,
+    _Out_   UINT32*                     pIndex
+    )
+{
+    AML_NAMESPACE_IMAGE_VALUE Record;
+    SIZE_T                    Count;
+
+    //
+    // Writing the value may reserve further value records (package elements), only take the index once it is written.
+    //
+    if( AmlNamespaceImageWriteValue( Writer, Value, &Record ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    Count = ( Writer->Values.Size / sizeof( Record ) );
+    if( Count >= AML_NAMESPACE_IMAGE_NO_INDEX ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->Values, &Record, sizeof( Record ) ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    *pIndex = ( UINT32 )Count;
+    return AML_TRUE;
+}
+
+//
+// Fill in the field element state shared by all field types.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteFieldElement(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_    const AML_FIELD_ELEMENT*    Element,
+    _In_    UINT8                       Flags,
+    _In_    UINT64                      Offset,
+    _Inout_ AML_NAMESPACE_IMAGE_NODE*   Record
+    )
+{
+    Record->u.Field.Offset           = Offset;
+    Record->u.Field.Length           = Element->Length;
+    Record->u.Field.Region           = AML_NAMESPACE_IMAGE_NO_INDEX;
+    Record->u.Field.Bank             = AML_NAMESPACE_IMAGE_NO_INDEX;
+    Record->u.Field.BankValue        = AML_NAMESPACE_IMAGE_NO_INDEX;
+    Record->u.Field.Index            = AML_NAMESPACE_IMAGE_NO_INDEX;
+    Record->u.Field.Data             = AML_NAMESPACE_IMAGE_NO_INDEX;
+    Record->u.Field.Flags            = Flags;
+    Record->u.Field.AccessType       = Element->AccessType;
+    Record->u.Field.AccessAttributes = Element->AccessAttributes;
+    Record->u.Field.AccessByteLength = Element->AccessByteLength;
+    Record->u.Field.IsConnection     = Element->IsConnection;
+    if( AmlNamespaceImageWriteName( Writer, &Element->Name, &Record->Name ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    return AmlNamespaceImageAppendValue( Writer, &Element->ConnectionResource, &Record->u.Field.Connection );
+}
+
+//
+// Find the index of the given table that holds the code of a method.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageFindMethodTable(
+    _In_  const AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_  const AML_OBJECT_METHOD*          Method,
+    _Out_ UINT32*                           pIndex
+    )
+{
+    const AML_NAMESPACE_IMAGE_TABLE* Table;
+    SIZE_T                           i;
+
+    for( i = 0; i < Writer->TableCount; i++ ) {
+        Table = &Writer->Tables[ i ];
+        if( ( Table->TableSize >= sizeof( AML_DESCRIPTION_HEADER ) )
+            && ( Method->CodeDataBlock == ( ( const UINT8* )Table->Table + sizeof( AML_DESCRIPTION_HEADER ) ) )
+            && ( Method->CodeDataBlockSize == ( Table->TableSize - sizeof( AML_DESCRIPTION_HEADER ) ) ) )
+        {
+            *pIndex = ( UINT32 )i;
+            return AML_TRUE;
+        }
+    }
+    return AML_FALSE;
+}
+
+//
+// Write the code block record holding the code of a method that isn't part of any of the given tables (only once per block).
+// Such code belongs to tables dynamically loaded by Load, there are usually only a handful of them.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteCodeBlock(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_    const AML_OBJECT_METHOD*    Method,
+    _Out_   UINT32*                     pIndex
+    )
+{
+    AML_NAMESPACE_IMAGE_CODE_BLOCK Record;
+    const VOID*                    Source;
+    SIZE_T                         Count;
+    SIZE_T                         Offset;
+    SIZE_T                         i;
+
+    //
+    // Look up an existing record of the same code block.
+    //
+    Count = ( Writer->CodeBlocks.Size / sizeof( Record ) );
+    for( i = 0; i < Count; i++ ) {
+        AML_MEMCPY( &Source, &Writer->CodeBlockSources.Data[ i * sizeof( Source ) ], sizeof( Source ) );
+        AML_MEMCPY( &Record, &Writer->CodeBlocks.Data[ i * sizeof( Record ) ], sizeof( Record ) );
+        if( ( Source == Method->CodeDataBlock ) && ( Record.Size == Method->CodeDataBlockSize ) ) {
+            *pIndex = ( UINT32 )i;
+            return AML_TRUE;
+        }
+    }
+
+    //
+    // Copy the entire code block to the byte pool.
+    //
+    if( ( Count >= AML_NAMESPACE_IMAGE_NO_INDEX ) || ( Method->CodeDataBlock == NULL ) ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageSectionReserve( Writer->Heap, &Writer->Pool, Method->CodeDataBlockSize, &Offset ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    AML_MEMCPY( &Writer->Pool.Data[ Offset ], Method->CodeDataBlock, Method->CodeDataBlockSize );
+    Record = ( AML_NAMESPACE_IMAGE_CODE_BLOCK ){ .DataOffset = Offset, .Size = Method->CodeDataBlockSize };
+    Source = Method->CodeDataBlock;
+    if( AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->CodeBlocks, &Record, sizeof( Record ) ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->CodeBlockSources, &Source, sizeof( Source ) ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    *pIndex = ( UINT32 )Count;
+    return AML_TRUE;
+}
+
+//
+// Write the record of a single namespace node and its object.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteNode(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _In_    const AML_NAMESPACE_NODE*   Node
+    )
+{
+    AML_NAMESPACE_IMAGE_NODE Record;
+    const AML_OBJECT*        Object;
+    AML_NAME_STRING          ParentPath;
+    AML_NAMESPACE_NODE*      ParentNode;
+    BOOLEAN                  Success;
+
+    //
+    // Record the node itself.
+    //
+    AML_MEMSET( &Record, 0, sizeof( Record ) );
+    Object = ( ( Node->Object != &Node->ParentState->NilObject ) ? Node->Object : NULL );
+    Record.ObjectType = ( ( Object != NULL ) ? Object->Type : AML_OBJECT_TYPE_NONE );
+    Record.ScopeFlags = Node->ScopeFlags;
+    Record.Parent     = AML_NAMESPACE_IMAGE_NO_INDEX;
+
+    //
+    // Record the index of the parent node, allows the loader to skip looking up existing nodes beneath newly created parents.
+    //
+    if( Node->AbsolutePath.SegmentCount > 1 ) {
+        ParentPath = Node->AbsolutePath;
+        ParentPath.SegmentCount--;
+        if( AmlNamespaceSearch( Node->ParentState, NULL, &ParentPath, AML_SEARCH_FLAG_NO_ALIAS_RESOLUTION, &ParentNode ) ) {
+            if( AmlNamespaceImageMapLookup( Writer, ParentNode, &Record.Parent ) == AML_FALSE ) {
+                Record.Parent = AML_NAMESPACE_IMAGE_NO_INDEX;
+            }
+        }
+    }
+    Record.Flags      = ( ( Node->IsPreParsed ? AML_NAMESPACE_IMAGE_NODE_FLAG_PRE_PARSED : 0 )
+                          | ( Node->IsEvaluated ? AML_NAMESPACE_IMAGE_NODE_FLAG_EVALUATED : 0 ) );
+
+    //
+    // Record the device initialization state of the object (only set once the initial load has been completed).
+    //
+    if( Object != NULL ) {
+        Record.Flags        |= ( Object->IsInitializedDevice ? AML_NAMESPACE_IMAGE_NODE_FLAG_INITIALIZED_DEVICE : 0 );
+        Record.RegCallBitmap = Object->RegCallBitmap;
+    }
+
+    if( AmlNamespaceImageWriteName( Writer, &Node->AbsolutePath, &Record.Path ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Record the object-type specific state of the object.
+    //
+    Success = AML_TRUE;
+    switch( Record.ObjectType ) {
+    case AML_OBJECT_TYPE_NONE:
+    case AML_OBJECT_TYPE_THERMAL_ZONE:
+        break;
+    case AML_OBJECT_TYPE_NAME:
+        Success = ( AmlNamespaceImageWriteName( Writer, &Object->u.Name.String, &Record.Name )
+                    && AmlNamespaceImageAppendValue( Writer, &Object->u.Name.Value, &Record.u.Name.Value ) );
+        break;
+    case AML_OBJECT_TYPE_SCOPE:
+        Success = AmlNamespaceImageWriteName( Writer, &Object->u.Scope.Location, &Record.Name );
+        break;
+    case AML_OBJECT_TYPE_DEVICE:
+        Success = AmlNamespaceImageWriteName( Writer, &Object->u.Device.Name, &Record.Name );
+        break;
+    case AML_OBJECT_TYPE_METHOD:
+        //
+        // Native methods can't be recorded, they must be created again by the loading state (predefined objects).
+        // Methods of dynamically loaded tables reference a code block of the image instead of a table.
+        //
+        Record.u.Method.CodeStart     = Object->u.Method.CodeStart;
+        Record.u.Method.CodeSize      = Object->u.Method.CodeSize;
+        Record.u.Method.Table         = AML_NAMESPACE_IMAGE_NO_INDEX;
+        Record.u.Method.CodeBlock     = AML_NAMESPACE_IMAGE_NO_INDEX;
+        Record.u.Method.ArgumentCount = Object->u.Method.ArgumentCount;
+        Record.u.Method.IsSerialized  = Object->u.Method.IsSerialized;
+        Record.u.Method.SyncLevel     = Object->u.Method.SyncLevel;
+        if( Object->u.Method.UserRoutine != NULL ) {
+            Record.Flags |= AML_NAMESPACE_IMAGE_NODE_FLAG_NATIVE;
+        } else if( AmlNamespaceImageFindMethodTable( Writer, &Object->u.Method, &Record.u.Method.Table ) == AML_FALSE ) {
+            Success = AmlNamespaceImageWriteCodeBlock( Writer, &Object->u.Method, &Record.u.Method.CodeBlock );
+        }
+        Success = ( Success && AmlNamespaceImageWriteName( Writer, &Object->u.Method.Name, &Record.Name ) );
+        break;
+    case AML_OBJECT_TYPE_OPERATION_REGION:
+        Record.u.OpRegion.Offset    = Object->u.OpRegion.Offset;
+        Record.u.OpRegion.Length    = Object->u.OpRegion.Length;
+        Record.u.OpRegion.SpaceType = Object->u.OpRegion.SpaceType;
+        Success = AmlNamespaceImageWriteName( Writer, &Object->u.OpRegion.Name, &Record.Name );
+        break;
+    case AML_OBJECT_TYPE_FIELD:
+        Success = ( AmlNamespaceImageWriteFieldElement( Writer,
+                                                        &Object->u.Field.Element,
+                                                        Object->u.Field.Flags,
+                                                        Object->u.Field.Offset,
+                                                        &Record )
+                    && AmlNamespaceImageMapLookup( Writer, Object->u.Field.OperationRegion, &Record.u.Field.Region ) );
+        break;
+    case AML_OBJECT_TYPE_BANK_FIELD:
+        Success = ( AmlNamespaceImageWriteFieldElement( Writer,
+                                                        &Object->u.BankField.Base.Element,
+                                                        Object->u.BankField.Base.Flags,
+                                                        Object->u.BankField.Base.Offset,
+                                                        &Record )
+                    && AmlNamespaceImageMapLookup( Writer, Object->u.BankField.Base.OperationRegion, &Record.u.Field.Region )
+                    && AmlNamespaceImageMapLookup( Writer, Object->u.BankField.Bank, &Record.u.Field.Bank )
+                    && AmlNamespaceImageAppendValue( Writer, &Object->u.BankField.BankValue, &Record.u.Field.BankValue ) );
+        break;
+    case AML_OBJECT_TYPE_INDEX_FIELD:
+        Success = ( AmlNamespaceImageWriteFieldElement( Writer,
+                                                        &Object->u.IndexField.Element,
+                                                        Object->u.IndexField.Flags,
+                                                        Object->u.IndexField.Offset,
+                                                        &Record )
+                    && AmlNamespaceImageMapLookup( Writer, Object->u.IndexField.Index, &Record.u.Field.Index )
+                    && AmlNamespaceImageMapLookup( Writer, Object->u.IndexField.Data, &Record.u.Field.Data ) );
+        break;
+    case AML_OBJECT_TYPE_BUFFER_FIELD:
+        Record.u.BufferField.BitIndex = Object->u.BufferField.BitIndex;
+        Record.u.BufferField.BitCount = Object->u.BufferField.BitCount;
+        Success = ( AmlNamespaceImageWriteName( Writer, &Object->u.BufferField.Name, &Record.Name )
+                    && AmlNamespaceImageAppendValue( Writer, &Object->u.BufferField.SourceBuf, &Record.u.BufferField.Source ) );
+        break;
+    case AML_OBJECT_TYPE_ALIAS:
+        Success = ( AmlNamespaceImageWriteName( Writer, &Object->u.Alias.Name, &Record.Name )
+                    && AmlNamespaceImageWriteName( Writer, &Object->u.Alias.DestinationName, &Record.u.Alias.Destination ) );
+        break;
+    case AML_OBJECT_TYPE_MUTEX:
+        //
+        // Mutexes still held by the loaded code can't be recorded.
+        //
+        if( Object->u.Mutex.ScopeEntry != NULL ) {
+            return AML_FALSE;
+        }
+        Record.u.Mutex.SyncLevel = Object->u.Mutex.SyncLevel;
+        break;
+    case AML_OBJECT_TYPE_EVENT:
+        Record.u.Event.Counter = Object->u.Event.Counter;
+        break;
+    case AML_OBJECT_TYPE_PROCESSOR:
+        Record.u.Processor.PBLKAddress = Object->u.Processor.PBLKAddress;
+        Record.u.Processor.PBLKLength  = Object->u.Processor.PBLKLength;
+        Record.u.Processor.ID          = Object->u.Processor.ID;
+        break;
+    case AML_OBJECT_TYPE_POWER_RESOURCE:
+        Record.u.PowerResource.ResourceOrder = Object->u.PowerResource.ResourceOrder;
+        Record.u.PowerResource.SystemLevel   = Object->u.PowerResource.SystemLevel;
+        break;
+    case AML_OBJECT_TYPE_DATA_REGION:
+        Success = ( AmlNamespaceImageWriteName( Writer, &Object->u.DataRegion.Name, &Record.Name )
+                    && AmlNamespaceImageAppendValue( Writer, &Object->u.DataRegion.SignatureString, &Record.u.DataRegion.Signature )
+                    && AmlNamespaceImageAppendValue( Writer, &Object->u.DataRegion.OemIDString, &Record.u.DataRegion.OemId )
+                    && AmlNamespaceImageAppendValue( Writer, &Object->u.DataRegion.OemTableIDString, &Record.u.DataRegion.OemTableId ) );
+        break;
+    default:
+        return AML_FALSE;
+    }
+
+    if( Success == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    return AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->Nodes, &Record, sizeof( Record ) );
+}
+
+//
+// Write the records of all namespace nodes in evaluation order.
+// All objects are mapped to the index of their node before any node is written, values may reference any node.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteNodes(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer
+    )
+{
+    AML_NAMESPACE_STATE* Namespace;
+    AML_NAMESPACE_NODE*  Node;
+    UINT32               NodeCount;
+
+    //
+    // Temporary nodes (method-local objects) are never part of an image.
+    // Nodes themselves are mapped to their index as well, to record the parent node index of each node.
+    //
+    Namespace = &Writer->State->Namespace;
+    NodeCount = 0;
+    for( Node = Namespace->InOrderNodeHead; Node != NULL; Node = Node->InOrderNext ) {
+        if( ( NodeCount >= ( AML_NAMESPACE_IMAGE_NO_INDEX - 1 ) ) || ( Node->TempScope != NULL ) ) {
+            return AML_FALSE;
+        } else if( AmlNamespaceImageMapInsert( Writer, Node, NodeCount ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        if( ( Node->Object != NULL ) && ( Node->Object != &Namespace->NilObject ) ) {
+            if( AmlNamespaceImageMapInsert( Writer, Node->Object, NodeCount ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+        }
+        NodeCount++;
+    }
+
+    for( Node = Namespace->InOrderNodeHead; Node != NULL; Node = Node->InOrderNext ) {
+        if( AmlNamespaceImageWriteNode( Writer, Node ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Write the elements of all recorded packages, elements may record further packages, which are written by the same loop.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWritePackageElements(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer
+    )
+{
+    AML_NAMESPACE_IMAGE_PACKAGE Record;
+    AML_NAMESPACE_IMAGE_VALUE   Value;
+    const AML_PACKAGE_DATA*     Package;
+    SIZE_T                      i;
+    UINT64                      j;
+
+    for( i = 0; i < ( Writer->Packages.Size / sizeof( Record ) ); i++ ) {
+        AML_MEMCPY( &Record, &Writer->Packages.Data[ i * sizeof( Record ) ], sizeof( Record ) );
+        AML_MEMCPY( &Package, &Writer->PackageSources.Data[ i * sizeof( Package ) ], sizeof( Package ) );
+        for( j = 0; ( j < Record.ElementCount ) && ( Package->Elements != NULL ); j++ ) {
+            if( Package->Elements[ j ] == NULL ) {
+                continue;
+            } else if( AmlNamespaceImageWriteValue( Writer, &Package->Elements[ j ]->Value, &Value ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+            AML_MEMCPY( &Writer->Values.Data[ ( Record.FirstValue + j ) * sizeof( Value ) ], &Value, sizeof( Value ) );
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Write the links of all nodes present within the namespace tree, in tree pre-order.
+// The tree is walked iteratively using the parent links of its nodes, no traversal stack is needed.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageWriteTreeLinks(
+    _Inout_ AML_NAMESPACE_IMAGE_WRITER* Writer
+    )
+{
+    AML_NAMESPACE_TREE_NODE*      Root;
+    AML_NAMESPACE_TREE_NODE*      TreeNode;
+    AML_NAMESPACE_IMAGE_TREE_LINK Link;
+
+    Root = &Writer->State->Namespace.TreeRoot;
+    if( Root->IsPresent == AML_FALSE ) {
+        return AML_TRUE;
+    }
+
+    TreeNode = Root->ChildFirst;
+    while( TreeNode != NULL ) {
+        //
+        // Record the link of the node to its parent, all present nodes must have been recorded.
+        //
+        Link.Parent = AML_NAMESPACE_IMAGE_NO_INDEX;
+        if( ( AmlNamespaceImageMapLookup( Writer, AML_CONTAINING_RECORD( TreeNode, AML_NAMESPACE_NODE, TreeEntry ), &Link.Node ) == AML_FALSE )
+            || ( ( TreeNode->Parent != Root )
+                 && ( AmlNamespaceImageMapLookup( Writer,
+                                                  AML_CONTAINING_RECORD( TreeNode->Parent, AML_NAMESPACE_NODE, TreeEntry ),
+                                                  &Link.Parent ) == AML_FALSE ) )
+            || ( AmlNamespaceImageSectionAppend( Writer->Heap, &Writer->TreeLinks, &Link, sizeof( Link ) ) == AML_FALSE ) )
+        {
+            return AML_FALSE;
+        }
+
+        //
+        // Advance to the first child, or the next sibling of the node or of its closest ancestor that has one.
+        //
+        if( TreeNode->ChildFirst != NULL ) {
+            TreeNode = TreeNode->ChildFirst;
+            continue;
+        }
+        while( ( TreeNode != Root ) && ( TreeNode->Next == NULL ) ) {
+            TreeNode = TreeNode->Parent;
+        }
+        TreeNode = ( ( TreeNode != Root ) ? TreeNode->Next : NULL );
+    }
+    return AML_TRUE;
+}
+
+//
+// Advance the size of an image by a section of the given size, sections begin at an aligned offset.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageLayoutSection(
+    _Inout_ UINT64* pImageSize,
+    _In_    UINT64  SectionSize,
+    _Out_   UINT64* pOffset
+    )
+{
+    UINT64 Offset;
+
+    Offset = ( ( *pImageSize + ( AML_NAMESPACE_IMAGE_ALIGNMENT - 1 ) ) & ~( ( UINT64 )AML_NAMESPACE_IMAGE_ALIGNMENT - 1 ) );
+    if( ( Offset < *pImageSize ) || ( SectionSize > ( UINT64_MAX - Offset ) ) ) {
+        return AML_FALSE;
+    }
+    *pOffset = Offset;
+    *pImageSize = ( Offset + SectionSize );
+    return AML_TRUE;
+}
+
+//
+// Lay out and copy all constructed sections to the final image.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageAssemble(
+    _Inout_  AML_NAMESPACE_IMAGE_WRITER* Writer,
+    _Outptr_ VOID**                      ppImage,
+    _Out_    SIZE_T*                     pImageSize
+    )
+{
+    AML_NAMESPACE_IMAGE_HEADER    Header;
+    AML_NAMESPACE_IMAGE_TABLE_KEY Key;
+    UINT64                        ImageSize;
+    UINT8*                        Image;
+    SIZE_T                        i;
+
+    //
+    // Lay out all sections following the header.
+    //
+    Header = ( AML_NAMESPACE_IMAGE_HEADER ){
+        .Magic        = AML_NAMESPACE_IMAGE_MAGIC,
+        .Version      = AML_NAMESPACE_IMAGE_VERSION,
+        .HeaderSize   = sizeof( AML_NAMESPACE_IMAGE_HEADER ),
+        .NodeSize     = sizeof( AML_NAMESPACE_IMAGE_NODE ),
+        .Flags        = ( Writer->State->IsIntegerSize64 ? AML_NAMESPACE_IMAGE_FLAG_INTEGER_SIZE_64 : 0 ),
+        .TableCount   = ( UINT32 )Writer->TableCount,
+        .NodeCount    = ( UINT32 )( Writer->Nodes.Size / sizeof( AML_NAMESPACE_IMAGE_NODE ) ),
+        .ValueCount   = ( UINT32 )( Writer->Values.Size / sizeof( AML_NAMESPACE_IMAGE_VALUE ) ),
+        .BufferCount  = ( UINT32 )( Writer->Buffers.Size / sizeof( AML_NAMESPACE_IMAGE_BUFFER ) ),
+        .PackageCount   = ( UINT32 )( Writer->Packages.Size / sizeof( AML_NAMESPACE_IMAGE_PACKAGE ) ),
+        .CodeBlockCount = ( UINT32 )( Writer->CodeBlocks.Size / sizeof( AML_NAMESPACE_IMAGE_CODE_BLOCK ) ),
+        .TreeLinkCount  = ( UINT32 )( Writer->TreeLinks.Size / sizeof( AML_NAMESPACE_IMAGE_TREE_LINK ) ),
+        .PoolSize       = Writer->Pool.Size,
+    };
+    ImageSize = sizeof( Header );
+    if( ( AmlNamespaceImageLayoutSection( &ImageSize, ( Writer->TableCount * sizeof( Key ) ), &Header.TableOffset ) == AML_FALSE )
+        || ( AmlNamespaceImageLayoutSection( &ImageSize, Writer->Nodes.Size, &Header.NodeOffset ) == AML_FALSE )
+        || ( AmlNamespaceImageLayoutSection( &ImageSize, Writer->Values.Size, &Header.ValueOffset ) == AML_FALSE )
+        || ( AmlNamespaceImageLayoutSection( &ImageSize, Writer->Buffers.Size, &Header.BufferOffset ) == AML_FALSE )
+        || ( AmlNamespaceImageLayoutSection( &ImageSize, Writer->Packages.Size, &Header.PackageOffset ) == AML_FALSE )
+        || ( AmlNamespaceImageLayoutSection( &ImageSize, Writer->CodeBlocks.Size, &Header.CodeBlockOffset ) == AML_FALSE )
+        || ( AmlNamespaceImageLayoutSection( &ImageSize, Writer->TreeLinks.Size, &Header.TreeLinkOffset ) == AML_FALSE )
+        || ( AmlNamespaceImageLayoutSection( &ImageSize, Writer->Pool.Size, &Header.PoolOffset ) == AML_FALSE )
+        || ( ImageSize > SIZE_MAX ) )
+    {
+        return AML_FALSE;
+    }
+    Header.ImageSize = ImageSize;
+
+    //
+    // Allocate the zeroed image and copy all sections to it.
+    //
+    if( ( Image = AmlHeapAllocate( Writer->Heap, ( SIZE_T )ImageSize ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    AML_MEMSET( Image, 0, ( SIZE_T )ImageSize );
+    AML_MEMCPY( Image, &Header, sizeof( Header ) );
+    for( i = 0; i < Writer->TableCount; i++ ) {
+        if( AmlNamespaceImageTableKey( &Writer->Tables[ i ], &Key ) == AML_FALSE ) {
+            AmlHeapFree( Writer->Heap, Image );
+            return AML_FALSE;
+        }
+        AML_MEMCPY( &Image[ Header.TableOffset + ( i * sizeof( Key ) ) ], &Key, sizeof( Key ) );
+    }
+    AML_MEMCPY( &Image[ Header.NodeOffset ], Writer->Nodes.Data, Writer->Nodes.Size );
+    AML_MEMCPY( &Image[ Header.ValueOffset ], Writer->Values.Data, Writer->Values.Size );
+    AML_MEMCPY( &Image[ Header.BufferOffset ], Writer->Buffers.Data, Writer->Buffers.Size );
+    AML_MEMCPY( &Image[ Header.PackageOffset ], Writer->Packages.Data, Writer->Packages.Size );
+    AML_MEMCPY( &Image[ Header.CodeBlockOffset ], Writer->CodeBlocks.Data, Writer->CodeBlocks.Size );
+    AML_MEMCPY( &Image[ Header.TreeLinkOffset ], Writer->TreeLinks.Data, Writer->TreeLinks.Size );
+    AML_MEMCPY( &Image[ Header.PoolOffset ], Writer->Pool.Data, Writer->Pool.Size );
+    *ppImage = Image;
+    *pImageSize = ( SIZE_T )ImageSize;
+    return AML_TRUE;
+}
+
+//
+// Produce a namespace image of all nodes and objects created by the initial loads of the given tables.
+// Typically called after all tables have been loaded (AmlEvalLoadedTableCode), but before AmlCompleteInitialLoad,
+// device initialization (_STA/_INI/_REG) is then performed again after loading the image.
+// Images of states that have completed their initial load record which devices have already been initialized
+// and which _REG methods have already been called, these aren't called again after loading the image,
+// and the shape of the namespace tree, which is then linked in the loading state exactly as it was in the producing state.
+// The code of methods that isn't part of the given tables (for example, tables dynamically loaded by Load) is copied into the image,
+// images produced without any tables hold the code of all methods, and only reference the memory of the image itself.
+// Fails if the namespace holds state that cannot be captured, such as temporary nodes, or mutexes that are still held.
+// The returned image is allocated from the state heap, and must be freed using AmlNamespaceImageFree.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceImageBuild(
+    _Inout_                  struct _AML_STATE*               State,
+    _In_count_( TableCount ) const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                     SIZE_T                           TableCount,
+    _Outptr_                 VOID**                           ppImage,
+    _Out_                    SIZE_T*                          pImageSize
+    )
+{
+    AML_NAMESPACE_IMAGE_WRITER Writer;
+    BOOLEAN                    Success;
+
+    //
+    // Table indices must be representable by the node records.
+    //
+    if( TableCount >= AML_NAMESPACE_IMAGE_NO_INDEX ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Write all node records first, followed by the package elements referenced by them, and the links of the namespace tree.
+    //
+    Writer = ( AML_NAMESPACE_IMAGE_WRITER ){ .State = State, .Heap = &State->Heap, .Tables = Tables, .TableCount = TableCount };
+    Success = ( AmlNamespaceImageWriteNodes( &Writer )
+                && AmlNamespaceImageWritePackageElements( &Writer )
+                && AmlNamespaceImageWriteTreeLinks( &Writer )
+                && AmlNamespaceImageAssemble( &Writer, ppImage, pImageSize ) );
+    AmlNamespaceImageWriterFree( &Writer );
+    return Success;
+}
+
+//
+// Free an image returned by AmlNamespaceImageBuild.
+//
+VOID
+AmlNamespaceImageFree(
+    _Inout_          struct _AML_STATE* State,
+    _In_ _Frees_ptr_ VOID*              Image
+    )
+{
+    AmlHeapFree( &State->Heap, Image );
+}
+
+//
+// Check if a section of the given amount of records lies within the image.
+//
+static
+BOOLEAN
+AmlNamespaceImageIsValidSection(
+    _In_ const AML_NAMESPACE_IMAGE_HEADER* Header,
+    _In_ UINT64                            Offset,
+    _In_ UINT64                            Count,
+    _In_ SIZE_T                            RecordSize
+    )
+{
+    return ( ( ( Offset % AML_NAMESPACE_IMAGE_ALIGNMENT ) == 0 )
+             && ( Offset <= Header->ImageSize )
+             && ( Count <= ( ( Header->ImageSize - Offset ) / RecordSize ) ) );
+}
+
+//
+// Check if a range of bytes lies within the byte pool of the image.
+//
+static
+BOOLEAN
+AmlNamespaceImageIsValidPoolRange(
+    _In_ const AML_NAMESPACE_IMAGE_READER* Reader,
+    _In_ UINT64                            Offset,
+    _In_ UINT64                            Size
+    )
+{
+    return ( ( Offset <= Reader->Header->PoolSize ) && ( Size <= ( Reader->Header->PoolSize - Offset ) ) );
+}
+
+//
+// Validate the image header and section layout, and match the image against the build, the state, and the given tables.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageOpen(
+    _Inout_                       AML_NAMESPACE_IMAGE_READER*      Reader,
+    _In_reads_bytes_( ImageSize ) const UINT8*                     Image,
+    _In_                          SIZE_T                           ImageSize,
+    _In_count_( TableCount )      const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                          SIZE_T                           TableCount
+    )
+{
+    const AML_NAMESPACE_IMAGE_HEADER*    Header;
+    const AML_NAMESPACE_IMAGE_TABLE_KEY* Keys;
+    AML_NAMESPACE_IMAGE_TABLE_KEY        Key;
+    const UINT8*                         A;
+    const UINT8*                         B;
+    SIZE_T                               i;
+    SIZE_T                               j;
+
+    //
+    // Records are read in place, the image must be suitably aligned.
+    //
+    if( ( Image == NULL )
+        || ( ( ( UINT_PTR )Image % AML_NAMESPACE_IMAGE_ALIGNMENT ) != 0 )
+        || ( ImageSize < sizeof( AML_NAMESPACE_IMAGE_HEADER ) ) )
+    {
+        return AML_FALSE;
+    }
+
+    //
+    // Validate the header against the build and the state.
+    //
+    Header = ( const AML_NAMESPACE_IMAGE_HEADER* )Image;
+    if( ( Header->Magic != AML_NAMESPACE_IMAGE_MAGIC )
+        || ( Header->Version != AML_NAMESPACE_IMAGE_VERSION )
+        || ( Header->HeaderSize != sizeof( AML_NAMESPACE_IMAGE_HEADER ) )
+        || ( Header->NodeSize != sizeof( AML_NAMESPACE_IMAGE_NODE ) )
+        || ( Header->ImageSize > ImageSize )
+        || ( ( ( Header->Flags & AML_NAMESPACE_IMAGE_FLAG_INTEGER_SIZE_64 ) != 0 ) != ( Reader->State->IsIntegerSize64 != AML_FALSE ) ) )
+    {
+        return AML_FALSE;
+    }
+
+    //
+    // Validate the layout of all sections.
+    //
+    if( ( AmlNamespaceImageIsValidSection( Header, Header->TableOffset, Header->TableCount, sizeof( AML_NAMESPACE_IMAGE_TABLE_KEY ) ) == AML_FALSE )
+        || ( AmlNamespaceImageIsValidSection( Header, Header->NodeOffset, Header->NodeCount, sizeof( AML_NAMESPACE_IMAGE_NODE ) ) == AML_FALSE )
+        || ( AmlNamespaceImageIsValidSection( Header, Header->ValueOffset, Header->ValueCount, sizeof( AML_NAMESPACE_IMAGE_VALUE ) ) == AML_FALSE )
+        || ( AmlNamespaceImageIsValidSection( Header, Header->BufferOffset, Header->BufferCount, sizeof( AML_NAMESPACE_IMAGE_BUFFER ) ) == AML_FALSE )
+        || ( AmlNamespaceImageIsValidSection( Header, Header->PackageOffset, Header->PackageCount, sizeof( AML_NAMESPACE_IMAGE_PACKAGE ) ) == AML_FALSE )
+        || ( AmlNamespaceImageIsValidSection( Header, Header->CodeBlockOffset, Header->CodeBlockCount, sizeof( AML_NAMESPACE_IMAGE_CODE_BLOCK ) ) == AML_FALSE )
+        || ( AmlNamespaceImageIsValidSection( Header, Header->TreeLinkOffset, Header->TreeLinkCount, sizeof( AML_NAMESPACE_IMAGE_TREE_LINK ) ) == AML_FALSE )
+        || ( AmlNamespaceImageIsValidSection( Header, Header->PoolOffset, Header->PoolSize, 1 ) == AML_FALSE ) )
+    {
+        return AML_FALSE;
+    }
+
+    //
+    // The image is keyed by the tables that it was produced from, any mismatching table invalidates the entire image.
+    //
+    if( Header->TableCount != TableCount ) {
+        return AML_FALSE;
+    }
+    Keys = ( const AML_NAMESPACE_IMAGE_TABLE_KEY* )&Image[ Header->TableOffset ];
+    for( i = 0; i < TableCount; i++ ) {
+        if( AmlNamespaceImageTableKey( &Tables[ i ], &Key ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        A = ( const UINT8* )&Keys[ i ];
+        B = ( const UINT8* )&Key;
+        for( j = 0; j < sizeof( Key ); j++ ) {
+            if( A[ j ] != B[ j ] ) {
+                return AML_FALSE;
+            }
+        }
+    }
+
+    Reader->Header     = Header;
+    Reader->Tables     = Tables;
+    Reader->Nodes      = ( const AML_NAMESPACE_IMAGE_NODE* )&Image[ Header->NodeOffset ];
+    Reader->Values     = ( const AML_NAMESPACE_IMAGE_VALUE* )&Image[ Header->ValueOffset ];
+    Reader->Buffers    = ( const AML_NAMESPACE_IMAGE_BUFFER* )&Image[ Header->BufferOffset ];
+    Reader->Packages   = ( const AML_NAMESPACE_IMAGE_PACKAGE* )&Image[ Header->PackageOffset ];
+    Reader->CodeBlocks = ( const AML_NAMESPACE_IMAGE_CODE_BLOCK* )&Image[ Header->CodeBlockOffset ];
+    Reader->TreeLinks  = ( const AML_NAMESPACE_IMAGE_TREE_LINK* )&Image[ Header->TreeLinkOffset ];
+    Reader->Pool       = &Image[ Header->PoolOffset ];
+    return AML_TRUE;
+}
+
+//
+// Read a name string record, the name segments are used in place.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageReadName(
+    _In_  const AML_NAMESPACE_IMAGE_READER* Reader,
+    _In_  const AML_NAMESPACE_IMAGE_NAME*   Name,
+    _Out_ AML_NAME_STRING*                  Output
+    )
+{
+    SIZE_T i;
+
+    if( ( Name->PrefixLength > sizeof( Name->Prefix ) )
+        || ( Name->SegmentCount > ( Reader->Header->PoolSize / sizeof( AML_NAME_SEG ) ) )
+        || ( AmlNamespaceImageIsValidPoolRange( Reader,
+                                                Name->SegmentOffset,
+                                                ( ( UINT64 )Name->SegmentCount * sizeof( AML_NAME_SEG ) ) ) == AML_FALSE ) )
+    {
+        return AML_FALSE;
+    }
+
+    *Output = ( AML_NAME_STRING ){ .Prefix = { .Length = Name->PrefixLength }, .SegmentCount = Name->SegmentCount };
+    for( i = 0; i < Name->PrefixLength; i++ ) {
+        if( ( Name->Prefix[ i ] != '\\' ) && ( Name->Prefix[ i ] != '^' ) ) {
+            return AML_FALSE;
+        }
+        Output->Prefix.Data[ i ] = Name->Prefix[ i ];
+    }
+    if( Name->SegmentCount != 0 ) {
+        Output->Segments = ( const AML_NAME_SEG* )&Reader->Pool[ Name->SegmentOffset ];
+    }
+    return AML_TRUE;
+}
+
+//
+// Allocate the per-record lookup arrays of the reader.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageReaderAllocate(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    const AML_NAMESPACE_IMAGE_HEADER* Header;
+    VOID**                            Array;
+    SIZE_T                            Count;
+    SIZE_T                            i;
+
+    //
+    // All arrays share a single allocation of pointers.
+    //
+    Header = Reader->Header;
+    Count = ( ( SIZE_T )Header->NodeCount * 3 );
+    if( ( Header->BufferCount > ( SIZE_MAX - Count ) )
+        || ( Header->PackageCount > ( SIZE_MAX - Count - Header->BufferCount ) ) )
+    {
+        return AML_FALSE;
+    }
+    Count += ( ( SIZE_T )Header->BufferCount + Header->PackageCount );
+    if( ( Count == 0 ) || ( Count > ( SIZE_MAX / sizeof( Array[ 0 ] ) ) ) ) {
+        return AML_FALSE;
+    } else if( ( Array = AmlHeapAllocate( &Reader->State->Heap, ( Count * sizeof( Array[ 0 ] ) ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    for( i = 0; i < Count; i++ ) {
+        Array[ i ] = NULL;
+    }
+    Reader->ExistingNodes = ( AML_NAMESPACE_NODE** )&Array[ 0 ];
+    Reader->CreatedNodes  = ( AML_NAMESPACE_NODE** )&Array[ Header->NodeCount ];
+    Reader->Objects       = ( AML_OBJECT** )&Array[ ( SIZE_T )Header->NodeCount * 2 ];
+    Reader->BufferData    = ( AML_BUFFER_DATA** )&Array[ ( SIZE_T )Header->NodeCount * 3 ];
+    Reader->PackageData   = ( AML_PACKAGE_DATA** )&Array[ ( ( SIZE_T )Header->NodeCount * 3 ) + Header->BufferCount ];
+    return AML_TRUE;
+}
+
+//
+// Release the references held by the reader, and free its lookup arrays.
+//
+static
+VOID
+AmlNamespaceImageReaderFree(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    UINT32 i;
+
+    if( Reader->ExistingNodes == NULL ) {
+        return;
+    }
+    for( i = 0; i < Reader->Header->BufferCount; i++ ) {
+        if( Reader->BufferData[ i ] != NULL ) {
+            AmlBufferDataRelease( Reader->BufferData[ i ] );
+        }
+    }
+    for( i = 0; i < Reader->Header->PackageCount; i++ ) {
+        if( Reader->PackageData[ i ] != NULL ) {
+            AmlPackageDataRelease( Reader->PackageData[ i ] );
+        }
+    }
+    AmlHeapFree( &Reader->State->Heap, Reader->ExistingNodes );
+    Reader->ExistingNodes = NULL;
+}
+
+//
+// Look up all nodes of the image that are already present within the state (predefined namespaces and objects),
+// present nodes must hold an object of the same type, and native methods must always be present.
+// Performed before the namespace is modified, mismatching images leave the state untouched.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageFindExistingNodes(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    const AML_NAMESPACE_IMAGE_NODE* Record;
+    AML_NAME_STRING                 Path;
+    AML_NAMESPACE_NODE*             Node;
+    AML_OBJECT_TYPE                 ExistingType;
+    UINT32                          i;
+
+    for( i = 0; i < Reader->Header->NodeCount; i++ ) {
+        //
+        // All node paths must be absolute, and the object type must be valid for a named object.
+        //
+        Record = &Reader->Nodes[ i ];
+        if( ( AmlNamespaceImageReadName( Reader, &Record->Path, &Path ) == AML_FALSE )
+            || ( Path.Prefix.Length != 1 )
+            || ( Path.Prefix.Data[ 0 ] != '\\' )
+            || ( Record->ObjectType > AML_OBJECT_TYPE_NAME )
+            || ( Record->ObjectType == AML_OBJECT_TYPE_DEBUG ) )
+        {
+            return AML_FALSE;
+        }
+
+        //
+        // Match the node against any existing node of the same path.
+        // Nodes beneath a parent node created by the image can't already be present, and don't have to be looked up.
+        //
+        if( ( Record->Parent < i )
+            && ( Reader->ExistingNodes[ Record->Parent ] == NULL )
+            && ( ( Record->Flags & AML_NAMESPACE_IMAGE_NODE_FLAG_NATIVE ) == 0 ) )
+        {
+            continue;
+        } else if( AmlNamespaceSearch( &Reader->State->Namespace, NULL, &Path, AML_SEARCH_FLAG_NO_ALIAS_RESOLUTION, &Node ) ) {
+            ExistingType = ( ( Node->Object != NULL ) ? Node->Object->Type : AML_OBJECT_TYPE_NONE );
+            if( ExistingType != Record->ObjectType ) {
+                AML_DEBUG_ERROR( Reader->State, "Error: Namespace image node conflicts with an existing node.\n" );
+                return AML_FALSE;
+            }
+            Reader->ExistingNodes[ i ] = Node;
+            Reader->Objects[ i ] = ( ( ExistingType != AML_OBJECT_TYPE_NONE ) ? Node->Object : NULL );
+        } else if( Record->Flags & AML_NAMESPACE_IMAGE_NODE_FLAG_NATIVE ) {
+            AML_DEBUG_ERROR( Reader->State, "Error: Namespace image native method isn't present in the state.\n" );
+            return AML_FALSE;
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Create the object of a node record, only initializes state that doesn't reference other records.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageCreateObject(
+    _Inout_  AML_NAMESPACE_IMAGE_READER*     Reader,
+    _In_     const AML_NAMESPACE_IMAGE_NODE* Record,
+    _Outptr_ AML_OBJECT**                    ppObject
+    )
+{
+    AML_STATE*                       State;
+    AML_OBJECT*                      Object;
+    AML_NAME_STRING                  Name;
+    AML_NAME_STRING                  Destination;
+    const AML_NAMESPACE_IMAGE_TABLE* Table;
+    const UINT8*                     CodeBlock;
+    SIZE_T                           CodeBlockSize;
+    AML_FIELD_ELEMENT                Element;
+    BOOLEAN                          Success;
+
+    State = Reader->State;
+    if( AmlNamespaceImageReadName( Reader, &Record->Name, &Name ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlObjectCreate( &State->Heap, ( AML_OBJECT_TYPE )Record->ObjectType, &Object ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Field element state shared by all field types.
+    //
+    Element = ( AML_FIELD_ELEMENT ){
+        .Type             = AML_FIELD_ELEMENT_TYPE_NAMED,
+        .AccessType       = Record->u.Field.AccessType,
+        .AccessAttributes = Record->u.Field.AccessAttributes,
+        .AccessByteLength = Record->u.Field.AccessByteLength,
+        .IsConnection     = Record->u.Field.IsConnection,
+        .Length           = Record->u.Field.Length,
+        .Name             = Name,
+    };
+
+    Success = AML_TRUE;
+    switch( Record->ObjectType ) {
+    case AML_OBJECT_TYPE_NAME:
+        Object->u.Name.String = Name;
+        break;
+    case AML_OBJECT_TYPE_SCOPE:
+        Object->u.Scope.Location = Name;
+        break;
+    case AML_OBJECT_TYPE_DEVICE:
+        Object->u.Device.Name = Name;
+        break;
+    case AML_OBJECT_TYPE_THERMAL_ZONE:
+        break;
+    case AML_OBJECT_TYPE_METHOD:
+        //
+        // The method code must lie within the definition block of its table (or dynamically loaded code block).
+        //
+        if( Record->u.Method.Table < Reader->Header->TableCount ) {
+            Table = &Reader->Tables[ Record->u.Method.Table ];
+            CodeBlock = ( ( const UINT8* )Table->Table + sizeof( AML_DESCRIPTION_HEADER ) );
+            CodeBlockSize = ( Table->TableSize - sizeof( AML_DESCRIPTION_HEADER ) );
+        } else if( ( Record->u.Method.CodeBlock < Reader->Header->CodeBlockCount )
+                   && ( Reader->CodeBlocks[ Record->u.Method.CodeBlock ].Size <= SIZE_MAX )
+                   && AmlNamespaceImageIsValidPoolRange( Reader,
+                                                         Reader->CodeBlocks[ Record->u.Method.CodeBlock ].DataOffset,
+                                                         Reader->CodeBlocks[ Record->u.Method.CodeBlock ].Size ) )
+        {
+            CodeBlock = &Reader->Pool[ Reader->CodeBlocks[ Record->u.Method.CodeBlock ].DataOffset ];
+            CodeBlockSize = ( SIZE_T )Reader->CodeBlocks[ Record->u.Method.CodeBlock ].Size;
+        } else {
+            Success = AML_FALSE;
+            break;
+        }
+        if( ( Record->u.Method.CodeStart > CodeBlockSize )
+            || ( Record->u.Method.CodeSize > ( CodeBlockSize - Record->u.Method.CodeStart ) ) )
+        {
+            Success = AML_FALSE;
+            break;
+        }
+        Object->u.Method = ( AML_OBJECT_METHOD ){
+            .Name              = Name,
+            .CodeDataBlock     = CodeBlock,
+            .CodeDataBlockSize = CodeBlockSize,
+            .CodeStart         = ( SIZE_T )Record->u.Method.CodeStart,
+            .CodeSize          = ( SIZE_T )Record->u.Method.CodeSize,
+            .ArgumentCount     = ( Record->u.Method.ArgumentCount & AML_METHOD_FLAGS_ARG_COUNT_MASK ),
+            .IsSerialized      = ( Record->u.Method.IsSerialized & AML_METHOD_FLAGS_SERIALIZE_MASK ),
+            .SyncLevel         = ( Record->u.Method.SyncLevel & AML_METHOD_FLAGS_SYNC_LEVEL_MASK ),
+        };
+        break;
+    case AML_OBJECT_TYPE_OPERATION_REGION:
+        Object->u.OpRegion = ( AML_OBJECT_OPERATION_REGION ){
+            .Host      = State->Host,
+            .Name      = Name,
+            .Offset    = Record->u.OpRegion.Offset,
+            .Length    = Record->u.OpRegion.Length,
+            .SpaceType = Record->u.OpRegion.SpaceType,
+        };
+        break;
+    case AML_OBJECT_TYPE_FIELD:
+        Object->u.Field = ( AML_OBJECT_FIELD ){ .Flags = Record->u.Field.Flags, .Offset = Record->u.Field.Offset, .Element = Element };
+        break;
+    case AML_OBJECT_TYPE_BANK_FIELD:
+        Object->u.BankField.Base = ( AML_OBJECT_FIELD ){ .Flags = Record->u.Field.Flags, .Offset = Record->u.Field.Offset, .Element = Element };
+        break;
+    case AML_OBJECT_TYPE_INDEX_FIELD:
+        Object->u.IndexField = ( AML_OBJECT_INDEX_FIELD ){ .Flags = Record->u.Field.Flags, .Offset = Record->u.Field.Offset, .Element = Element };
+        break;
+    case AML_OBJECT_TYPE_BUFFER_FIELD:
+        Object->u.BufferField = ( AML_OBJECT_BUFFER_FIELD ){
+            .BitIndex = Record->u.BufferField.BitIndex,
+            .BitCount = Record->u.BufferField.BitCount,
+            .Name     = Name,
+        };
+        break;
+    case AML_OBJECT_TYPE_ALIAS:
+        Success = AmlNamespaceImageReadName( Reader, &Record->u.Alias.Destination, &Destination );
+        Object->u.Alias = ( AML_OBJECT_ALIAS ){ .Name = Name, .DestinationName = Destination };
+        break;
+    case AML_OBJECT_TYPE_MUTEX:
+        Object->u.Mutex = ( AML_OBJECT_MUTEX ){ .Host = State->Host, .SyncLevel = Record->u.Mutex.SyncLevel };
+        Success = AmlHostMutexCreate( State->Host, &Object->u.Mutex.HostHandle );
+        break;
+    case AML_OBJECT_TYPE_EVENT:
+        Object->u.Event = ( AML_OBJECT_EVENT ){ .Host = State->Host, .Counter = Record->u.Event.Counter };
+        Success = AmlHostEventCreate( State->Host, &Object->u.Event.HostHandle );
+        break;
+    case AML_OBJECT_TYPE_PROCESSOR:
+        Object->u.Processor = ( AML_OBJECT_PROCESSOR ){
+            .PBLKAddress = Record->u.Processor.PBLKAddress,
+            .PBLKLength  = Record->u.Processor.PBLKLength,
+            .ID          = Record->u.Processor.ID,
+        };
+        break;
+    case AML_OBJECT_TYPE_POWER_RESOURCE:
+        Object->u.PowerResource = ( AML_OBJECT_POWER_RESOURCE ){
+            .SystemLevel   = Record->u.PowerResource.SystemLevel,
+            .ResourceOrder = Record->u.PowerResource.ResourceOrder,
+        };
+        break;
+    case AML_OBJECT_TYPE_DATA_REGION:
+        Object->u.DataRegion.Name = Name;
+        break;
+    default:
+        Success = AML_FALSE;
+        break;
+    }
+
+    if( Success == AML_FALSE ) {
+        AmlObjectRelease( Object );
+        return AML_FALSE;
+    }
+    *ppObject = Object;
+    return AML_TRUE;
+}
+
+//
+// Create the nodes and objects of all node records that aren't already present within the state.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageCreateNodes(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    const AML_NAMESPACE_IMAGE_NODE* Record;
+    AML_NAME_STRING                 Path;
+    AML_OBJECT*                     Object;
+    AML_NAMESPACE_NODE*             Node;
+    UINT32                          i;
+
+    for( i = 0; i < Reader->Header->NodeCount; i++ ) {
+        Record = &Reader->Nodes[ i ];
+        if( Reader->ExistingNodes[ i ] != NULL ) {
+            continue;
+        }
+
+        //
+        // Create the object before its node, as done when evaluating its definition.
+        // Shared objects of the base namespace are linked in place, they are never linked back to a node (see AML_OBJECT::IsShared).
+        //
+        Object = NULL;
+        if( ( Reader->Base != NULL ) && ( Reader->Base->Objects[ i ] != NULL ) ) {
+            Object = Reader->Base->Objects[ i ];
+        } else if( Record->ObjectType != AML_OBJECT_TYPE_NONE ) {
+            if( AmlNamespaceImageCreateObject( Reader, Record, &Object ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+        }
+
+        //
+        // Create the node at its absolute path, and restore the node state of the original load.
+        //
+        if( ( AmlNamespaceImageReadName( Reader, &Record->Path, &Path ) == AML_FALSE )
+            || ( AmlStateSnapshotCreateNode( Reader->State, NULL, &Path, &Node ) == AML_FALSE ) )
+        {
+            AmlObjectRelease( Object );
+            return AML_FALSE;
+        }
+        Node->ScopeFlags  = Record->ScopeFlags;
+        Node->IsPreParsed = ( ( Record->Flags & AML_NAMESPACE_IMAGE_NODE_FLAG_PRE_PARSED ) != 0 );
+        Node->IsEvaluated = ( ( Record->Flags & AML_NAMESPACE_IMAGE_NODE_FLAG_EVALUATED ) != 0 );
+        if( ( Object != NULL ) && Object->IsShared ) {
+            Node->Object = Object;
+            Reader->State->Namespace.SharedObjectCount += 1;
+        } else if( Object != NULL ) {
+            Object->NamespaceNode = Node;
+            Node->Object = Object;
+        }
+        Reader->CreatedNodes[ i ] = Node;
+        Reader->Objects[ i ]      = Object;
+    }
+    return AML_TRUE;
+}
+
+//
+// Create the buffer data and (empty) packages of all buffer and package records.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageCreateData(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    const AML_NAMESPACE_IMAGE_BUFFER*  Buffer;
+    const AML_NAMESPACE_IMAGE_PACKAGE* Package;
+    AML_HEAP*                          Heap;
+    AML_BUFFER_DATA*                   BufferData;
+    AML_PACKAGE_DATA*                  PackageData;
+    AML_PACKAGE_ELEMENT**              Elements;
+    UINT32                             i;
+    UINT32                             j;
+
+    //
+    // Copy the contents of all buffers from the byte pool.
+    //
+    Heap = &Reader->State->Heap;
+    for( i = 0; i < Reader->Header->BufferCount; i++ ) {
+        Buffer = &Reader->Buffers[ i ];
+        if( ( Reader->Base != NULL ) && ( Reader->Base->BufferData[ i ] != NULL ) ) {
+            Reader->BufferData[ i ] = Reader->Base->BufferData[ i ];
+            continue;
+        } else if( ( Buffer->Size > Buffer->MaxSize )
+            || ( Buffer->MaxSize > SIZE_MAX )
+            || ( AmlNamespaceImageIsValidPoolRange( Reader, Buffer->DataOffset, Buffer->Size ) == AML_FALSE ) )
+        {
+            return AML_FALSE;
+        } else if( ( BufferData = AmlBufferDataCreate( Heap, ( SIZE_T )Buffer->Size, ( SIZE_T )Buffer->MaxSize ) ) == NULL ) {
+            return AML_FALSE;
+        }
+        if( Buffer->Size != 0 ) {
+            AML_MEMCPY( BufferData->Data, &Reader->Pool[ Buffer->DataOffset ], ( SIZE_T )Buffer->Size );
+        }
+        Reader->BufferData[ i ] = BufferData;
+    }
+
+    //
+    // Create all packages with uninitialized elements, elements are filled in once all packages exist.
+    // Data shared by the base namespace is used in place, shared data is never reference counted, and never filled in again.
+    //
+    for( i = 0; i < Reader->Header->PackageCount; i++ ) {
+        Package = &Reader->Packages[ i ];
+        if( ( Reader->Base != NULL ) && ( Reader->Base->PackageData[ i ] != NULL ) ) {
+            Reader->PackageData[ i ] = Reader->Base->PackageData[ i ];
+            continue;
+        } else if( ( Package->FirstValue > Reader->Header->ValueCount )
+            || ( Package->ElementCount > ( Reader->Header->ValueCount - Package->FirstValue ) ) )
+        {
+            return AML_FALSE;
+        } else if( ( PackageData = AmlHeapAllocate( Heap, sizeof( *PackageData ) ) ) == NULL ) {
+            return AML_FALSE;
+        } else if( ( Elements = AmlHeapAllocate( Heap, ( sizeof( Elements[ 0 ] ) * Package->ElementCount ) ) ) == NULL ) {
+            AmlHeapFree( Heap, PackageData );
+            return AML_FALSE;
+        }
+        for( j = 0; j < Package->ElementCount; j++ ) {
+            Elements[ j ] = NULL;
+        }
+        *PackageData = ( AML_PACKAGE_DATA ){
+            .ReferenceCount   = 1,
+            .ParentHeap       = Heap,
+            .ElementArrayHeap = Heap,
+            .ElementCount     = Package->ElementCount,
+            .Elements         = Elements
+        };
+        Reader->PackageData[ i ] = PackageData;
+    }
+    return AML_TRUE;
+}
+
+//
+// Read a data value record, taking a new reference to any referenced buffer, package, or object.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageReadValue(
+    _In_  const AML_NAMESPACE_IMAGE_READER* Reader,
+    _In_  UINT32                            ValueIndex,
+    _Out_ AML_DATA*                         Output
+    )
+{
+    const AML_NAMESPACE_IMAGE_VALUE* Value;
+    AML_BUFFER_DATA*                 Buffer;
+    AML_PACKAGE_DATA*                Package;
+    AML_OBJECT*                      Object;
+
+    *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_NONE };
+    if( ValueIndex >= Reader->Header->ValueCount ) {
+        return AML_FALSE;
+    }
+
+    Value = &Reader->Values[ ValueIndex ];
+    switch( Value->Type ) {
+    case AML_DATA_TYPE_NONE:
+    case AML_DATA_TYPE_DEBUG:
+        *Output = ( AML_DATA ){ .Type = Value->Type };
+        return AML_TRUE;
+    case AML_DATA_TYPE_INTEGER:
+        *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_INTEGER, .u.Integer = Value->Integer };
+        return AML_TRUE;
+    case AML_DATA_TYPE_STRING:
+    case AML_DATA_TYPE_BUFFER:
+        //
+        // Strings must always remain null-terminated.
+        //
+        if( Value->Index >= Reader->Header->BufferCount ) {
+            return AML_FALSE;
+        }
+        Buffer = Reader->BufferData[ Value->Index ];
+        if( ( Value->Type == AML_DATA_TYPE_STRING ) && ( Buffer->MaxSize <= Buffer->Size ) ) {
+            return AML_FALSE;
+        }
+        AmlBufferDataReference( Buffer );
+        *Output = ( AML_DATA ){ .Type = Value->Type, .u.Buffer = Buffer };
+        return AML_TRUE;
+    case AML_DATA_TYPE_PACKAGE:
+    case AML_DATA_TYPE_PACKAGE_ELEMENT:
+        if( Value->Index >= Reader->Header->PackageCount ) {
+            return AML_FALSE;
+        }
+        Package = Reader->PackageData[ Value->Index ];
+        AmlPackageDataReference( Package );
+        if( Value->Type == AML_DATA_TYPE_PACKAGE ) {
+            *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_PACKAGE, .u.Package = Package };
+        } else {
+            *Output = ( AML_DATA ){
+                .Type             = AML_DATA_TYPE_PACKAGE_ELEMENT,
+                .u.PackageElement = { .Package = Package, .ElementIndex = Value->Integer }
+            };
+        }
+        return AML_TRUE;
+    case AML_DATA_TYPE_REFERENCE:
+    case AML_DATA_TYPE_FIELD_UNIT:
+        if( ( Value->Index >= Reader->Header->NodeCount ) || ( ( Object = Reader->Objects[ Value->Index ] ) == NULL ) ) {
+            return AML_FALSE;
+        } else if( ( Value->Type == AML_DATA_TYPE_FIELD_UNIT ) && ( AmlObjectIsFieldUnit( Object ) == AML_FALSE ) ) {
+            return AML_FALSE;
+        }
+        AmlObjectReference( Object );
+        if( Value->Type == AML_DATA_TYPE_REFERENCE ) {
+            *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_REFERENCE, .u.Reference.Object = Object };
+        } else {
+            *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_FIELD_UNIT, .u.FieldUnit = Object };
+        }
+        return AML_TRUE;
+    default:
+        return AML_FALSE;
+    }
+}
+
+//
+// Fill in the elements of all packages.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageFillPackages(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    const AML_NAMESPACE_IMAGE_PACKAGE* Package;
+    AML_PACKAGE_ELEMENT*               Element;
+    UINT32                             i;
+    UINT32                             j;
+
+    for( i = 0; i < Reader->Header->PackageCount; i++ ) {
+        Package = &Reader->Packages[ i ];
+        if( Reader->PackageData[ i ]->IsShared ) {
+            continue;
+        }
+        for( j = 0; j < Package->ElementCount; j++ ) {
+            if( ( Element = AmlHeapAllocate( &Reader->State->Heap, sizeof( *Element ) ) ) == NULL ) {
+                return AML_FALSE;
+            }
+            *Element = ( AML_PACKAGE_ELEMENT ){ .ParentHeap = &Reader->State->Heap, .Value.Type = AML_DATA_TYPE_NONE };
+            Reader->PackageData[ i ]->Elements[ j ] = Element;
+            if( AmlNamespaceImageReadValue( Reader, ( Package->FirstValue + j ), &Element->Value ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Look up the object of a node record, referenced objects must be of the given type (or be field units).
+//
+_Success_( return != NULL )
+static
+AML_OBJECT*
+AmlNamespaceImageReferenceObject(
+    _In_ const AML_NAMESPACE_IMAGE_READER* Reader,
+    _In_ UINT32                            NodeIndex,
+    _In_ BOOLEAN                           IsFieldUnit
+    )
+{
+    AML_OBJECT* Object;
+
+    if( ( NodeIndex >= Reader->Header->NodeCount ) || ( ( Object = Reader->Objects[ NodeIndex ] ) == NULL ) ) {
+        return NULL;
+    } else if( IsFieldUnit ? ( AmlObjectIsFieldUnit( Object ) == AML_FALSE ) : ( Object->Type != AML_OBJECT_TYPE_OPERATION_REGION ) ) {
+        return NULL;
+    }
+    AmlObjectReference( Object );
+    return Object;
+}
+
+//
+// Fill in the object state referencing other records (values, objects) of all created objects.
+// Index field access plans depend on the plans of their registers, and are built once all other fields are complete.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageFillObjects(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    const AML_NAMESPACE_IMAGE_NODE* Record;
+    AML_OBJECT*                     Object;
+    UINT32                          i;
+
+    for( i = 0; i < Reader->Header->NodeCount; i++ ) {
+        Record = &Reader->Nodes[ i ];
+        Object = Reader->Objects[ i ];
+        if( ( Reader->ExistingNodes[ i ] != NULL ) || ( Object == NULL ) || Object->IsShared ) {
+            continue;
+        }
+
+        switch( Object->Type ) {
+        case AML_OBJECT_TYPE_NAME:
+            if( AmlNamespaceImageReadValue( Reader, Record->u.Name.Value, &Object->u.Name.Value ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+            break;
+        case AML_OBJECT_TYPE_BUFFER_FIELD:
+            if( AmlNamespaceImageReadValue( Reader, Record->u.BufferField.Source, &Object->u.BufferField.SourceBuf ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+            break;
+        case AML_OBJECT_TYPE_FIELD:
+            Object->u.Field.OperationRegion = AmlNamespaceImageReferenceObject( Reader, Record->u.Field.Region, AML_FALSE );
+            if( ( Object->u.Field.OperationRegion == NULL )
+                || ( AmlNamespaceImageReadValue( Reader, Record->u.Field.Connection, &Object->u.Field.Element.ConnectionResource ) == AML_FALSE ) )
+            {
+                return AML_FALSE;
+            }
+            AmlFieldBuildAccessPlan( &Object->u.Field );
+            break;
+        case AML_OBJECT_TYPE_BANK_FIELD:
+            Object->u.BankField.Base.OperationRegion = AmlNamespaceImageReferenceObject( Reader, Record->u.Field.Region, AML_FALSE );
+            Object->u.BankField.Bank = AmlNamespaceImageReferenceObject( Reader, Record->u.Field.Bank, AML_TRUE );
+            if( ( Object->u.BankField.Base.OperationRegion == NULL )
+                || ( Object->u.BankField.Bank == NULL )
+                || ( AmlNamespaceImageReadValue( Reader, Record->u.Field.BankValue, &Object->u.BankField.BankValue ) == AML_FALSE )
+                || ( AmlNamespaceImageReadValue( Reader,
+                                                 Record->u.Field.Connection,
+                                                 &Object->u.BankField.Base.Element.ConnectionResource ) == AML_FALSE ) )
+            {
+                return AML_FALSE;
+            }
+            AmlFieldBuildAccessPlan( &Object->u.BankField.Base );
+            break;
+        case AML_OBJECT_TYPE_INDEX_FIELD:
+            Object->u.IndexField.Index = AmlNamespaceImageReferenceObject( Reader, Record->u.Field.Index, AML_TRUE );
+            Object->u.IndexField.Data = AmlNamespaceImageReferenceObject( Reader, Record->u.Field.Data, AML_TRUE );
+            if( ( Object->u.IndexField.Index == NULL )
+                || ( Object->u.IndexField.Data == NULL )
+                || ( AmlNamespaceImageReadValue( Reader, Record->u.Field.Connection, &Object->u.IndexField.Element.ConnectionResource ) == AML_FALSE ) )
+            {
+                return AML_FALSE;
+            }
+            break;
+        case AML_OBJECT_TYPE_DATA_REGION:
+            if( ( AmlNamespaceImageReadValue( Reader, Record->u.DataRegion.Signature, &Object->u.DataRegion.SignatureString ) == AML_FALSE )
+                || ( AmlNamespaceImageReadValue( Reader, Record->u.DataRegion.OemId, &Object->u.DataRegion.OemIDString ) == AML_FALSE )
+                || ( AmlNamespaceImageReadValue( Reader, Record->u.DataRegion.OemTableId, &Object->u.DataRegion.OemTableIDString ) == AML_FALSE ) )
+            {
+                return AML_FALSE;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    for( i = 0; i < Reader->Header->NodeCount; i++ ) {
+        Object = Reader->Objects[ i ];
+        if( ( Reader->ExistingNodes[ i ] == NULL ) && ( Object != NULL ) && ( Object->Type == AML_OBJECT_TYPE_INDEX_FIELD ) ) {
+            AmlIndexFieldBuildAccessPlan( &Object->u.IndexField );
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Get the node of a node record, either already present within the state, or created by the reader.
+//
+static
+AML_NAMESPACE_NODE*
+AmlNamespaceImageGetNode(
+    _In_ const AML_NAMESPACE_IMAGE_READER* Reader,
+    _In_ UINT32                            Index
+    )
+{
+    return ( ( Reader->ExistingNodes[ Index ] != NULL ) ? Reader->ExistingNodes[ Index ] : Reader->CreatedNodes[ Index ] );
+}
+
+//
+// Restore the device initialization state of all objects (including objects that were already present within the state),
+// and link all nodes to the namespace tree as they were linked within the producing state.
+// Existing objects only gain state, devices initialized (or _REG methods called) by the loading state are never reset.
+// Nodes that are already present within the tree of the loading state are kept in place,
+// any nodes that remain unlinked are inserted by the regular tree construction (AmlNamespaceTreeBuild).
+//
+static
+VOID
+AmlNamespaceImageRestoreInitialLoadState(
+    _Inout_ AML_NAMESPACE_IMAGE_READER* Reader
+    )
+{
+    const AML_NAMESPACE_IMAGE_NODE*      Record;
+    const AML_NAMESPACE_IMAGE_TREE_LINK* Link;
+    AML_NAMESPACE_STATE*                 Namespace;
+    AML_NAMESPACE_TREE_NODE*             Parent;
+    AML_NAMESPACE_NODE*                  Node;
+    AML_OBJECT*                          Object;
+    UINT32                               i;
+
+    //
+    // Restore the device initialization state of all objects.
+    //
+    Namespace = &Reader->State->Namespace;
+    for( i = 0; i < Reader->Header->NodeCount; i++ ) {
+        Record = &Reader->Nodes[ i ];
+        Object = AmlNamespaceImageGetNode( Reader, i )->Object;
+        if( ( Object == NULL ) || ( Object == &Namespace->NilObject ) || Object->IsShared ) {
+            continue;
+        }
+        Object->RegCallBitmap |= Record->RegCallBitmap;
+        if( Record->Flags & AML_NAMESPACE_IMAGE_NODE_FLAG_INITIALIZED_DEVICE ) {
+            Object->IsInitializedDevice = AML_TRUE;
+        }
+    }
+
+    //
+    // Link all recorded nodes to the tree in pre-order, beneath parents that are present within the tree.
+    //
+    if( Reader->Header->TreeLinkCount != 0 ) {
+        if( Namespace->TreeRoot.IsPresent == AML_FALSE ) {
+            AmlNamespaceTreeInitializeRoot( Namespace );
+        }
+    }
+    for( i = 0; i < Reader->Header->TreeLinkCount; i++ ) {
+        Link = &Reader->TreeLinks[ i ];
+        if( Link->Node >= Reader->Header->NodeCount ) {
+            continue;
+        } else if( Link->Parent == AML_NAMESPACE_IMAGE_NO_INDEX ) {
+            Parent = &Namespace->TreeRoot;
+        } else if( Link->Parent < Reader->Header->NodeCount ) {
+            Parent = &AmlNamespaceImageGetNode( Reader, Link->Parent )->TreeEntry;
+        } else {
+            continue;
+        }
+        Node = AmlNamespaceImageGetNode( Reader, Link->Node );
+        if( Parent->IsPresent && ( Node->TreeEntry.IsPresent == AML_FALSE ) ) {
+            AmlNamespaceTreeLinkChildNode( Namespace, Parent, &Node->TreeEntry );
+        }
+    }
+}
+
+//
+// Recreate the namespace captured by an image, using the shared objects and data of the given base namespace (if any).
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceImageLoadInternal(
+    _Inout_                       struct _AML_STATE*               State,
+    _In_reads_bytes_( ImageSize ) const VOID*                      Image,
+    _In_                          SIZE_T                           ImageSize,
+    _In_count_( TableCount )      const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                          SIZE_T                           TableCount,
+    _In_opt_                      const AML_NAMESPACE_BASE*        Base
+    )
+{
+    AML_NAMESPACE_IMAGE_READER Reader;
+    BOOLEAN                    Success;
+
+    //
+    // Match the image against the tables and the state before modifying the namespace.
+    //
+    Reader = ( AML_NAMESPACE_IMAGE_READER ){ .State = State, .Base = Base };
+    if( AmlNamespaceImageOpen( &Reader, Image, ImageSize, Tables, TableCount ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( Reader.Header->NodeCount == 0 ) {
+        return AML_TRUE;
+    } else if( AmlNamespaceImageReaderAllocate( &Reader ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlNamespaceImageFindExistingNodes( &Reader ) == AML_FALSE ) {
+        AmlNamespaceImageReaderFree( &Reader );
+        return AML_FALSE;
+    }
+
+    //
+    // Invalidate all memoized identification method results, and all cached PCI region topology (as done by table loads).
+    //
+    State->IdentificationCacheGeneration++;
+    AmlPciTopologyCacheInvalidate( &State->PciTopology );
+
+    //
+    // Create all nodes and objects first, values and fields may reference any object of the image.
+    //
+    if( AmlStateSnapshotBegin( State ) == AML_FALSE ) {
+        AmlNamespaceImageReaderFree( &Reader );
+        return AML_FALSE;
+    }
+    Success = ( AmlNamespaceImageCreateNodes( &Reader )
+                && AmlNamespaceImageCreateData( &Reader )
+                && AmlNamespaceImageFillPackages( &Reader )
+                && AmlNamespaceImageFillObjects( &Reader ) );
+    if( Success ) {
+        AmlNamespaceImageRestoreInitialLoadState( &Reader );
+    }
+    AmlNamespaceImageReaderFree( &Reader );
+    if( Success == AML_FALSE ) {
+        AML_DEBUG_ERROR( State, "Error: Namespace image load failed!\n" );
+        AmlStateSnapshotRollback( State );
+        return AML_FALSE;
+    }
+    AmlStateSnapshotCommit( State, AML_TRUE );
+    return AML_TRUE;
+}
+
+//
+// Recreate the namespace captured by an image, instead of loading its tables using AmlEvalLoadedTableCode.
+// The given tables must match the tables that the image was produced from, and must be given in the same order.
+// Fails without modifying the state if the image doesn't match the given tables, the build, or the state
+// (for example, a conflicting predefined object), allowing the caller to fall back to loading the tables normally.
+// Nodes already present within the state (predefined namespaces and objects) are kept as they are.
+// Side effects of the original table loads (region accesses, debug output) are not performed again.
+// The image and the tables must remain loaded for the entire lifetime of the state, names and method code are used in place.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceImageLoad(
+    _Inout_                       struct _AML_STATE*               State,
+    _In_reads_bytes_( ImageSize ) const VOID*                      Image,
+    _In_                          SIZE_T                           ImageSize,
+    _In_count_( TableCount )      const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                          SIZE_T                           TableCount
+    )
+{
+    return AmlNamespaceImageLoadInternal( State, Image, ImageSize, Tables, TableCount, NULL );
+}
+
+//
+// Count the values referencing every buffer, package, and node record of the image.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceBaseCountUses(
+    _Inout_ AML_NAMESPACE_BASE_BUILDER* Builder
+    )
+{
+    const AML_NAMESPACE_IMAGE_HEADER* Header;
+    const AML_NAMESPACE_IMAGE_VALUE*  Value;
+    UINT32*                           Uses;
+    SIZE_T                            Count;
+    SIZE_T                            i;
+
+    //
+    // All counters share a single allocation.
+    //
+    Header = Builder->Reader.Header;
+    Count = ( ( SIZE_T )Header->BufferCount + Header->PackageCount + Header->NodeCount );
+    if( ( Count == 0 ) || ( Count > ( SIZE_MAX / sizeof( Uses[ 0 ] ) ) ) ) {
+        return AML_FALSE;
+    } else if( ( Uses = AmlHeapAllocate( &Builder->Reader.State->Heap, ( Count * sizeof( Uses[ 0 ] ) ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    AML_MEMSET( Uses, 0, ( Count * sizeof( Uses[ 0 ] ) ) );
+    Builder->BufferUses  = &Uses[ 0 ];
+    Builder->PackageUses = &Uses[ Header->BufferCount ];
+    Builder->NodeUses    = &Uses[ ( SIZE_T )Header->BufferCount + Header->PackageCount ];
+
+    for( i = 0; i < Header->ValueCount; i++ ) {
+        Value = &Builder->Reader.Values[ i ];
+        switch( Value->Type ) {
+        case AML_DATA_TYPE_STRING:
+        case AML_DATA_TYPE_BUFFER:
+            if( Value->Index < Header->BufferCount ) {
+                Builder->BufferUses[ Value->Index ] += 1;
+            }
+            break;
+        case AML_DATA_TYPE_PACKAGE:
+        case AML_DATA_TYPE_PACKAGE_ELEMENT:
+            if( Value->Index < Header->PackageCount ) {
+                Builder->PackageUses[ Value->Index ] += 1;
+            }
+            break;
+        case AML_DATA_TYPE_REFERENCE:
+        case AML_DATA_TYPE_FIELD_UNIT:
+            if( Value->Index < Header->NodeCount ) {
+                Builder->NodeUses[ Value->Index ] += 1;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Check if a value record holds static data that can be shared, all referenced buffers and packages must be valid,
+// and must not be referenced by any other value. Packages nested deeper than AML_NAMESPACE_BASE_MAX_PACKAGE_DEPTH aren't shared.
+//
+static
+BOOLEAN
+AmlNamespaceBaseIsStaticValue(
+    _In_ const AML_NAMESPACE_BASE_BUILDER* Builder,
+    _In_ UINT32                            ValueIndex,
+    _In_ SIZE_T                            Depth
+    )
+{
+    const AML_NAMESPACE_IMAGE_READER*  Reader;
+    const AML_NAMESPACE_IMAGE_VALUE*   Value;
+    const AML_NAMESPACE_IMAGE_BUFFER*  Buffer;
+    const AML_NAMESPACE_IMAGE_PACKAGE* Package;
+    UINT32                             i;
+
+    Reader = &Builder->Reader;
+    if( ValueIndex >= Reader->Header->ValueCount ) {
+        return AML_FALSE;
+    }
+
+    Value = &Reader->Values[ ValueIndex ];
+    switch( Value->Type ) {
+    case AML_DATA_TYPE_INTEGER:
+        return AML_TRUE;
+    case AML_DATA_TYPE_STRING:
+    case AML_DATA_TYPE_BUFFER:
+        //
+        // Strings must always remain null-terminated.
+        //
+        if( ( Value->Index >= Reader->Header->BufferCount ) || ( Builder->BufferUses[ Value->Index ] != 1 ) ) {
+            return AML_FALSE;
+        }
+        Buffer = &Reader->Buffers[ Value->Index ];
+        return ( ( Buffer->Size <= Buffer->MaxSize )
+                 && ( Buffer->MaxSize <= SIZE_MAX )
+                 && ( ( Value->Type != AML_DATA_TYPE_STRING ) || ( Buffer->MaxSize > Buffer->Size ) )
+                 && AmlNamespaceImageIsValidPoolRange( Reader, Buffer->DataOffset, Buffer->Size ) );
+    case AML_DATA_TYPE_PACKAGE:
+        if( ( Depth >= AML_NAMESPACE_BASE_MAX_PACKAGE_DEPTH )
+            || ( Value->Index >= Reader->Header->PackageCount )
+            || ( Builder->PackageUses[ Value->Index ] != 1 ) )
+        {
+            return AML_FALSE;
+        }
+        Package = &Reader->Packages[ Value->Index ];
+        if( ( Package->FirstValue > Reader->Header->ValueCount )
+            || ( Package->ElementCount > ( Reader->Header->ValueCount - Package->FirstValue ) ) )
+        {
+            return AML_FALSE;
+        }
+        for( i = 0; i < Package->ElementCount; i++ ) {
+            if( AmlNamespaceBaseIsStaticValue( Builder, ( Package->FirstValue + i ), ( Depth + 1 ) ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+        }
+        return AML_TRUE;
+    default:
+        return AML_FALSE;
+    }
+}
+
+//
+// Create the shared data of a static value record (see AmlNamespaceBaseIsStaticValue) within the base heap.
+// Partially created data is released along with the entire base upon failure.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceBaseCreateValue(
+    _Inout_ AML_NAMESPACE_BASE_BUILDER* Builder,
+    _In_    UINT32                      ValueIndex,
+    _Out_   AML_DATA*                   Output
+    )
+{
+    const AML_NAMESPACE_IMAGE_READER*  Reader;
+    const AML_NAMESPACE_IMAGE_VALUE*   Value;
+    const AML_NAMESPACE_IMAGE_BUFFER*  Buffer;
+    const AML_NAMESPACE_IMAGE_PACKAGE* Package;
+    AML_HEAP*                          Heap;
+    AML_BUFFER_DATA*                   BufferData;
+    AML_PACKAGE_DATA*                  PackageData;
+    AML_PACKAGE_ELEMENT**              Elements;
+    UINT32                             i;
+
+    Reader = &Builder->Reader;
+    Heap = &Builder->Base->Heap;
+    Value = &Reader->Values[ ValueIndex ];
+    *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_NONE };
+    switch( Value->Type ) {
+    case AML_DATA_TYPE_INTEGER:
+        *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_INTEGER, .u.Integer = Value->Integer };
+        return AML_TRUE;
+    case AML_DATA_TYPE_STRING:
+    case AML_DATA_TYPE_BUFFER:
+        Buffer = &Reader->Buffers[ Value->Index ];
+        if( ( BufferData = AmlBufferDataCreate( Heap, ( SIZE_T )Buffer->Size, ( SIZE_T )Buffer->MaxSize ) ) == NULL ) {
+            return AML_FALSE;
+        }
+        if( Buffer->Size != 0 ) {
+            AML_MEMCPY( BufferData->Data, &Reader->Pool[ Buffer->DataOffset ], ( SIZE_T )Buffer->Size );
+        }
+        BufferData->IsShared = AML_TRUE;
+        Builder->Base->BufferData[ Value->Index ] = BufferData;
+        *Output = ( AML_DATA ){ .Type = Value->Type, .u.Buffer = BufferData };
+        return AML_TRUE;
+    case AML_DATA_TYPE_PACKAGE:
+        Package = &Reader->Packages[ Value->Index ];
+        if( ( PackageData = AmlHeapAllocate( Heap, sizeof( *PackageData ) ) ) == NULL ) {
+            return AML_FALSE;
+        } else if( ( Elements = AmlHeapAllocate( Heap, ( sizeof( Elements[ 0 ] ) * Package->ElementCount ) ) ) == NULL ) {
+            return AML_FALSE;
+        }
+        *PackageData = ( AML_PACKAGE_DATA ){
+            .ReferenceCount   = 1,
+            .ParentHeap       = Heap,
+            .ElementArrayHeap = Heap,
+            .ElementCount     = Package->ElementCount,
+            .Elements         = Elements,
+            .IsShared         = AML_TRUE
+        };
+        for( i = 0; i < Package->ElementCount; i++ ) {
+            if( ( Elements[ i ] = AmlHeapAllocate( Heap, sizeof( *Elements[ i ] ) ) ) == NULL ) {
+                return AML_FALSE;
+            }
+            *Elements[ i ] = ( AML_PACKAGE_ELEMENT ){ .ParentHeap = Heap, .Value.Type = AML_DATA_TYPE_NONE };
+            if( AmlNamespaceBaseCreateValue( Builder, ( Package->FirstValue + i ), &Elements[ i ]->Value ) == AML_FALSE ) {
+                return AML_FALSE;
+            }
+        }
+        Builder->Base->PackageData[ Value->Index ] = PackageData;
+        *Output = ( AML_DATA ){ .Type = AML_DATA_TYPE_PACKAGE, .u.Package = PackageData };
+        return AML_TRUE;
+    default:
+        return AML_FALSE;
+    }
+}
+
+//
+// Create the shared objects of all named data objects of the image that hold static data.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespaceBaseCreateObjects(
+    _Inout_ AML_NAMESPACE_BASE_BUILDER* Builder
+    )
+{
+    const AML_NAMESPACE_IMAGE_READER* Reader;
+    const AML_NAMESPACE_IMAGE_NODE*   Record;
+    AML_NAMESPACE_BASE*               Base;
+    AML_OBJECT*                       Object;
+    VOID**                            Array;
+    SIZE_T                            Count;
+    UINT32                            i;
+
+    //
+    // All lookup arrays share a single allocation of pointers.
+    //
+    Reader = &Builder->Reader;
+    Base = Builder->Base;
+    Count = ( ( SIZE_T )Base->NodeCount + Base->BufferCount + Base->PackageCount );
+    if( Count > ( SIZE_MAX / sizeof( Array[ 0 ] ) ) ) {
+        return AML_FALSE;
+    } else if( ( Array = AmlHeapAllocate( &Base->Heap, ( Count * sizeof( Array[ 0 ] ) ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    for( i = 0; i < Count; i++ ) {
+        Array[ i ] = NULL;
+    }
+    Base->Objects     = ( AML_OBJECT** )&Array[ 0 ];
+    Base->BufferData  = ( AML_BUFFER_DATA** )&Array[ Base->NodeCount ];
+    Base->PackageData = ( AML_PACKAGE_DATA** )&Array[ ( SIZE_T )Base->NodeCount + Base->BufferCount ];
+
+    //
+    // Shared objects aren't reference counted (no ParentHeap), they are owned by the base, and released along with its arena.
+    // Names referenced by any value (for example, RefOf) must remain private, references must always target the object of the node.
+    //
+    for( i = 0; i < Base->NodeCount; i++ ) {
+        Record = &Reader->Nodes[ i ];
+        if( ( Record->ObjectType != AML_OBJECT_TYPE_NAME )
+            || ( Record->Flags & AML_NAMESPACE_IMAGE_NODE_FLAG_NATIVE )
+            || ( Builder->NodeUses[ i ] != 0 )
+            || ( AmlNamespaceBaseIsStaticValue( Builder, Record->u.Name.Value, 0 ) == AML_FALSE ) )
+        {
+            continue;
+        } else if( AmlObjectCreate( &Base->Heap, AML_OBJECT_TYPE_NAME, &Object ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        Object->ParentHeap          = NULL;
+        Object->IsShared            = AML_TRUE;
+        Object->RegCallBitmap       = Record->RegCallBitmap;
+        Object->IsInitializedDevice = ( ( Record->Flags & AML_NAMESPACE_IMAGE_NODE_FLAG_INITIALIZED_DEVICE ) != 0 );
+        Base->Objects[ i ] = Object;
+        Base->ObjectCount += 1;
+        if( ( AmlNamespaceImageReadName( Reader, &Record->Name, &Object->u.Name.String ) == AML_FALSE )
+            || ( AmlNamespaceBaseCreateValue( Builder, Record->u.Name.Value, &Object->u.Name.Value ) == AML_FALSE ) )
+        {
+            return AML_FALSE;
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Create the shared base namespace of an image, the image is matched against the given tables and state as done by AmlNamespaceImageLoad.
+// The base is allocated using the allocator of the given state, but is independent of the state and may outlive it.
+// The image and the tables must remain loaded for the entire lifetime of the base, and of all states loaded from it.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceBaseCreate(
+    _Out_                         AML_NAMESPACE_BASE*              Base,
+    _Inout_                       struct _AML_STATE*               State,
+    _In_reads_bytes_( ImageSize ) const VOID*                      Image,
+    _In_                          SIZE_T                           ImageSize,
+    _In_count_( TableCount )      const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                          SIZE_T                           TableCount
+    )
+{
+    AML_NAMESPACE_BASE_BUILDER Builder;
+    BOOLEAN                    Success;
+
+    //
+    // Validate the image before allocating any memory for the base.
+    //
+    Builder = ( AML_NAMESPACE_BASE_BUILDER ){ .Reader = { .State = State }, .Base = Base };
+    if( AmlNamespaceImageOpen( &Builder.Reader, Image, ImageSize, Tables, TableCount ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    *Base = ( AML_NAMESPACE_BASE ){
+        .Image        = Image,
+        .ImageSize    = ImageSize,
+        .Tables       = Tables,
+        .TableCount   = TableCount,
+        .NodeCount    = Builder.Reader.Header->NodeCount,
+        .BufferCount  = Builder.Reader.Header->BufferCount,
+        .PackageCount = Builder.Reader.Header->PackageCount,
+    };
+    AmlArenaInitialize( &Base->Arena, State->Allocator, ( 4096 * 8 ), 0 );
+    AmlHeapInitialize( &Base->Heap, &Base->Arena );
+    if( Base->NodeCount == 0 ) {
+        return AML_TRUE;
+    }
+
+    //
+    // Create the shared objects of all eligible named data objects.
+    //
+    Success = ( AmlNamespaceBaseCountUses( &Builder ) && AmlNamespaceBaseCreateObjects( &Builder ) );
+    if( Builder.BufferUses != NULL ) {
+        AmlHeapFree( &State->Heap, Builder.BufferUses );
+    }
+    if( Success == AML_FALSE ) {
+        AmlNamespaceBaseRelease( Base );
+        return AML_FALSE;
+    }
+    return AML_TRUE;
+}
+
+//
+// Release all memory of a base namespace, all states loaded from the base must have already been freed.
+//
+VOID
+AmlNamespaceBaseRelease(
+    _Inout_ AML_NAMESPACE_BASE* Base
+    )
+{
+    AmlArenaRelease( &Base->Arena );
+}
+
+//
+// Recreate the namespace captured by the image of a base namespace (see AmlNamespaceImageLoad),
+// the shared objects of the base are linked to the created nodes in place, instead of being created by the state.
+// The base must remain valid for the entire lifetime of the state.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceImageLoadShared(
+    _Inout_ struct _AML_STATE*        State,
+    _In_    const AML_NAMESPACE_BASE* Base
+    )
+{
+    return AmlNamespaceImageLoadInternal( State, Base->Image, Base->ImageSize, Base->Tables, Base->TableCount, Base );
+}
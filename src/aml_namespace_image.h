@@ -0,0 +1,342 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_arena.h"
+#include "aml_heap.h"
+#include "aml_data.h"
+#include "aml_object.h"
+
+//
+// Namespace image magic ("AMNI") and format version, images of any other version are rejected.
+//
+#define AML_NAMESPACE_IMAGE_MAGIC   0x494E4D41
+#define AML_NAMESPACE_IMAGE_VERSION 2
+
+//
+// Required alignment of a namespace image (and of all of its sections), images are read in place.
+//
+#define AML_NAMESPACE_IMAGE_ALIGNMENT 8
+
+//
+// Seed used to hash the contents of the tables an image was produced from.
+//
+#define AML_NAMESPACE_IMAGE_HASH_SEED 'AmlI'
+
+//
+// Maximum nesting depth of packages shared by a base namespace, more deeply nested packages remain private to each state.
+//
+#define AML_NAMESPACE_BASE_MAX_PACKAGE_DEPTH 32
+
+//
+// Absent node/value index of an image record.
+//
+#define AML_NAMESPACE_IMAGE_NO_INDEX UINT32_MAX
+
+//
+// Initial capacity (in bytes) of each section of an image under construction, and initial slot count of its identity map.
+//
+#define AML_NAMESPACE_IMAGE_MIN_SECTION_CAPACITY 4096
+#define AML_NAMESPACE_IMAGE_MIN_MAP_CAPACITY     256
+
+//
+// Namespace image header flags.
+//
+#define AML_NAMESPACE_IMAGE_FLAG_INTEGER_SIZE_64 ( 1 << 0 ) /* Produced by a state using 64-bit integers. */
+
+//
+// Namespace image node flags.
+//
+#define AML_NAMESPACE_IMAGE_NODE_FLAG_PRE_PARSED         ( 1 << 0 )
+#define AML_NAMESPACE_IMAGE_NODE_FLAG_EVALUATED          ( 1 << 1 )
+#define AML_NAMESPACE_IMAGE_NODE_FLAG_NATIVE             ( 1 << 2 ) /* Native method, must already exist within the loading state. */
+#define AML_NAMESPACE_IMAGE_NODE_FLAG_INITIALIZED_DEVICE ( 1 << 3 ) /* Object already processed by device initialization (_INI). */
+
+//
+// Table that a namespace image is produced from and keyed by.
+//
+typedef struct _AML_NAMESPACE_IMAGE_TABLE {
+    const VOID* Table;     /* Full table, beginning with its description header, followed by the loaded definition block code. */
+    SIZE_T      TableSize;
+} AML_NAMESPACE_IMAGE_TABLE;
+
+//
+// Namespace image header, followed by the table key, node, value, buffer, package, code block, and tree link record arrays, and the byte pool.
+// All sections are referenced by their offset from the start of the image, and all records reference each other by index,
+// the image contains no pointers and can be loaded from any address (for example, directly from a mapped file).
+// Images are native to the producing build (byte order, integer size, and record layout).
+//
+typedef struct _AML_NAMESPACE_IMAGE_HEADER {
+    UINT32 Magic;
+    UINT16 Version;
+    UINT16 HeaderSize; /* sizeof( AML_NAMESPACE_IMAGE_HEADER ) of the producing build. */
+    UINT32 NodeSize;   /* sizeof( AML_NAMESPACE_IMAGE_NODE ) of the producing build. */
+    UINT32 Flags;      /* AML_NAMESPACE_IMAGE_FLAG */
+    UINT64 ImageSize;
+    UINT32 TableCount;
+    UINT32 NodeCount;
+    UINT32 ValueCount;
+    UINT32 BufferCount;
+    UINT32 PackageCount;
+    UINT32 CodeBlockCount;
+    UINT32 TreeLinkCount;
+    UINT32 Reserved;
+    UINT64 TableOffset;
+    UINT64 NodeOffset;
+    UINT64 ValueOffset;
+    UINT64 BufferOffset;
+    UINT64 PackageOffset;
+    UINT64 CodeBlockOffset;
+    UINT64 TreeLinkOffset;
+    UINT64 PoolOffset;
+    UINT64 PoolSize;
+} AML_NAMESPACE_IMAGE_HEADER;
+
+//
+// Key of a table that the image was produced from, an image is only loaded if all of its tables match the given tables.
+//
+typedef struct _AML_NAMESPACE_IMAGE_TABLE_KEY {
+    AML_DESCRIPTION_HEADER Header;      /* Includes the checksum, length, and OEM revision of the table. */
+    UINT32                 ContentHash; /* Hash of the full table contents. */
+    UINT64                 TableSize;
+} AML_NAMESPACE_IMAGE_TABLE_KEY;
+
+//
+// Name string of an image record, the name segments are held by the byte pool.
+//
+typedef struct _AML_NAMESPACE_IMAGE_NAME {
+    UINT64 SegmentOffset;
+    UINT32 SegmentCount;
+    UINT8  PrefixLength;
+    UINT8  Prefix[ AML_NAME_MAX_PREFIX_COUNT + 1 ];
+} AML_NAMESPACE_IMAGE_NAME;
+
+//
+// Data value record.
+//
+typedef struct _AML_NAMESPACE_IMAGE_VALUE {
+    UINT32 Type;    /* AML_DATA_TYPE */
+    UINT32 Index;   /* Buffer (String/Buffer), package (Package/PackageElement), or node (Reference/FieldUnit) index. */
+    UINT64 Integer; /* Integer value, or the element index of a PackageElement. */
+} AML_NAMESPACE_IMAGE_VALUE;
+
+//
+// String/buffer data record, shared by all values referencing the same buffer data.
+//
+typedef struct _AML_NAMESPACE_IMAGE_BUFFER {
+    UINT64 DataOffset; /* Byte pool offset of the (Size) bytes of buffer contents. */
+    UINT64 Size;
+    UINT64 MaxSize;
+} AML_NAMESPACE_IMAGE_BUFFER;
+
+//
+// Package data record, shared by all values referencing the same package, elements are consecutive value records.
+//
+typedef struct _AML_NAMESPACE_IMAGE_PACKAGE {
+    UINT32 FirstValue;
+    UINT32 ElementCount;
+} AML_NAMESPACE_IMAGE_PACKAGE;
+
+//
+// Definition block code record, holds the code of tables dynamically loaded during the initial loads (Load).
+// Methods of these tables use the code held by the byte pool of the image in place.
+//
+typedef struct _AML_NAMESPACE_IMAGE_CODE_BLOCK {
+    UINT64 DataOffset;
+    UINT64 Size;
+} AML_NAMESPACE_IMAGE_CODE_BLOCK;
+
+//
+// Namespace tree link record, links a node to its parent within the namespace tree of the producing state.
+// Only recorded for states that have built their namespace tree (completed their initial load),
+// links are recorded in tree pre-order, parents are always linked before their children, and siblings in their original order.
+//
+typedef struct _AML_NAMESPACE_IMAGE_TREE_LINK {
+    UINT32 Node;
+    UINT32 Parent; /* Node index of the parent tree node, AML_NAMESPACE_IMAGE_NO_INDEX for the tree root. */
+} AML_NAMESPACE_IMAGE_TREE_LINK;
+
+//
+// Namespace node record, along with the object-type specific state of its object.
+// Nodes are recorded in evaluation order, references to other objects are node indices.
+//
+typedef struct _AML_NAMESPACE_IMAGE_NODE {
+    AML_NAMESPACE_IMAGE_NAME Path;          /* Absolute path of the node. */
+    AML_NAMESPACE_IMAGE_NAME Name;          /* Name string of the object, as given by its definition. */
+    UINT32                   ObjectType;    /* AML_OBJECT_TYPE, AML_OBJECT_TYPE_NONE for nodes without an object. */
+    UINT32                   Flags;         /* AML_NAMESPACE_IMAGE_NODE_FLAG */
+    UINT32                   ScopeFlags;
+    UINT32                   Parent;        /* Node index of the parent node, AML_NAMESPACE_IMAGE_NO_INDEX if the parent isn't recorded. */
+    UINT32                   RegCallBitmap; /* Region space types that the _REG child of the object has already been called for. */
+    union {
+        struct {
+            UINT32 Value;
+        } Name;
+        struct {
+            UINT64 CodeStart;
+            UINT64 CodeSize;
+            UINT32 Table;     /* Index of the table holding the method code, or AML_NAMESPACE_IMAGE_NO_INDEX. */
+            UINT32 CodeBlock; /* Index of the code block holding the method code (if not held by a table). */
+            UINT8  ArgumentCount;
+            UINT8  IsSerialized;
+            UINT8  SyncLevel;
+        } Method;
+        struct {
+            UINT64 Offset;
+            UINT64 Length;
+            UINT8  SpaceType;
+        } OpRegion;
+        struct {
+            UINT64 Offset;
+            UINT64 Length;     /* Bit-length of the field element. */
+            UINT32 Connection; /* Value index of the connection resource of the field element. */
+            UINT32 Region;     /* Node index of the operation region (Field, BankField). */
+            UINT32 Bank;       /* Node index of the bank register (BankField). */
+            UINT32 BankValue;  /* Value index of the bank value (BankField). */
+            UINT32 Index;      /* Node index of the index register (IndexField). */
+            UINT32 Data;       /* Node index of the data register (IndexField). */
+            UINT8  Flags;
+            UINT8  AccessType;
+            UINT8  AccessAttributes;
+            UINT8  AccessByteLength;
+            UINT8  IsConnection;
+        } Field;
+        struct {
+            UINT64 BitIndex;
+            UINT64 BitCount;
+            UINT32 Source; /* Value index of the source buffer. */
+        } BufferField;
+        struct {
+            AML_NAMESPACE_IMAGE_NAME Destination;
+        } Alias;
+        struct {
+            UINT8 SyncLevel;
+        } Mutex;
+        struct {
+            INT64 Counter;
+        } Event;
+        struct {
+            UINT32 PBLKAddress;
+            UINT32 PBLKLength;
+            UINT8  ID;
+        } Processor;
+        struct {
+            UINT16 ResourceOrder;
+            UINT8  SystemLevel;
+        } PowerResource;
+        struct {
+            UINT32 Signature; /* Value indices of the identification strings. */
+            UINT32 OemId;
+            UINT32 OemTableId;
+        } DataRegion;
+    } u;
+} AML_NAMESPACE_IMAGE_NODE;
+
+//
+// Produce a namespace image of all nodes and objects created by the initial loads of the given tables.
+// Typically called after all tables have been loaded (AmlEvalLoadedTableCode), but before AmlCompleteInitialLoad,
+// device initialization (_STA/_INI/_REG) is then performed again after loading the image.
+// Images of states that have completed their initial load record which devices have already been initialized
+// and which _REG methods have already been called, these aren't called again after loading the image,
+// and the shape of the namespace tree, which is then linked in the loading state exactly as it was in the producing state.
+// The code of methods that isn't part of the given tables (for example, tables dynamically loaded by Load) is copied into the image,
+// images produced without any tables hold the code of all methods, and only reference the memory of the image itself.
+// Fails if the namespace holds state that cannot be captured, such as temporary nodes, or mutexes that are still held.
+// The returned image is allocated from the state heap, and must be freed using AmlNamespaceImageFree.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceImageBuild(
+    _Inout_                  struct _AML_STATE*               State,
+    _In_count_( TableCount ) const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                     SIZE_T                           TableCount,
+    _Outptr_                 VOID**                           ppImage,
+    _Out_                    SIZE_T*                          pImageSize
+    );
+
+//
+// Free an image returned by AmlNamespaceImageBuild.
+//
+VOID
+AmlNamespaceImageFree(
+    _Inout_          struct _AML_STATE* State,
+    _In_ _Frees_ptr_ VOID*              Image
+    );
+
+//
+// Recreate the namespace captured by an image, instead of loading its tables using AmlEvalLoadedTableCode.
+// The given tables must match the tables that the image was produced from, and must be given in the same order.
+// Fails without modifying the state if the image doesn't match the given tables, the build, or the state
+// (for example, a conflicting predefined object), allowing the caller to fall back to loading the tables normally.
+// Nodes already present within the state (predefined namespaces and objects) are kept as they are.
+// Side effects of the original table loads (region accesses, debug output) are not performed again.
+// The image and the tables must remain loaded for the entire lifetime of the state, names and method code are used in place.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceImageLoad(
+    _Inout_                       struct _AML_STATE*               State,
+    _In_reads_bytes_( ImageSize ) const VOID*                      Image,
+    _In_                          SIZE_T                           ImageSize,
+    _In_count_( TableCount )      const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                          SIZE_T                           TableCount
+    );
+
+//
+// Read-only base namespace of an image, holds the named data objects (Name) of the image that can be shared
+// by all states loading the image using AmlNamespaceImageLoadShared, instead of each state creating its own copy.
+// Only Name objects holding static data (integers, strings, buffers, and packages of these) are shared,
+// and only if their data isn't referenced by any other value of the image (for example, the source buffer of a buffer field).
+// States replace a shared object with a private copy before modifying or referencing it (see AmlNamespacePrivatizeNode),
+// the base itself is never modified after creation, and may be used by multiple states concurrently.
+//
+typedef struct _AML_NAMESPACE_BASE {
+    AML_ARENA                        Arena;
+    AML_HEAP                         Heap;
+    const VOID*                      Image;
+    SIZE_T                           ImageSize;
+    const AML_NAMESPACE_IMAGE_TABLE* Tables;
+    SIZE_T                           TableCount;
+    UINT32                           NodeCount;
+    UINT32                           BufferCount;
+    UINT32                           PackageCount;
+    SIZE_T                           ObjectCount;    /* Count of shared objects. */
+    AML_OBJECT**                     Objects;        /* Shared object of every node record, NULL for nodes created by each state. */
+    AML_BUFFER_DATA**                BufferData;     /* Shared buffer data of every buffer record, NULL if not shared. */
+    AML_PACKAGE_DATA**               PackageData;    /* Shared package of every package record, NULL if not shared. */
+} AML_NAMESPACE_BASE;
+
+//
+// Create the shared base namespace of an image, the image is matched against the given tables and state as done by AmlNamespaceImageLoad.
+// The base is allocated using the allocator of the given state, but is independent of the state and may outlive it.
+// The image and the tables must remain loaded for the entire lifetime of the base, and of all states loaded from it.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceBaseCreate(
+    _Out_                         AML_NAMESPACE_BASE*              Base,
+    _Inout_                       struct _AML_STATE*               State,
+    _In_reads_bytes_( ImageSize ) const VOID*                      Image,
+    _In_                          SIZE_T                           ImageSize,
+    _In_count_( TableCount )      const AML_NAMESPACE_IMAGE_TABLE* Tables,
+    _In_                          SIZE_T                           TableCount
+    );
+
+//
+// Release all memory of a base namespace, all states loaded from the base must have already been freed.
+//
+VOID
+AmlNamespaceBaseRelease(
+    _Inout_ AML_NAMESPACE_BASE* Base
+    );
+
+//
+// Recreate the namespace captured by the image of a base namespace (see AmlNamespaceImageLoad),
+// the shared objects of the base are linked to the created nodes in place, instead of being created by the state.
+// The base must remain valid for the entire lifetime of the state.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespaceImageLoadShared(
+    _Inout_ struct _AML_STATE*        State,
+    _In_    const AML_NAMESPACE_BASE* Base
+    );
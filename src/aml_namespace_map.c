@@ -0,0 +1,501 @@
+#include "aml_namespace_map.h"
+
+//
+// Node value of removed (or migrated) slots, keeps the probe sequences of following slots intact.
+//
+#define AML_NAMESPACE_PATH_MAP_TOMBSTONE ( ( struct _AML_NAMESPACE_NODE* )( UINT_PTR )1 )
+
+//
+// Find the slot of the given hash (and node, if given) within a single table.
+// Returns NULL if no matching slot was found, the amount of visited slots is returned through pProbeLength.
+//
+_Success_( return != NULL )
+static
+AML_NAMESPACE_PATH_MAP_ENTRY*
+AmlNamespacePathMapTableFind(
+    _In_      const AML_NAMESPACE_PATH_MAP_TABLE* Table,
+    _In_      UINT32                              Hash,
+    _In_opt_  const struct _AML_NAMESPACE_NODE*   Node,
+    _Out_opt_ SIZE_T*                             pProbeLength
+    )
+{
+    SIZE_T                        Index;
+    SIZE_T                        i;
+    AML_NAMESPACE_PATH_MAP_ENTRY* Entry;
+
+    //
+    // Linearly probe slots starting at the hash index until an empty slot is found.
+    //
+    Entry = NULL;
+    i = 0;
+    if( Table->Entries != NULL ) {
+        Index = ( Hash & ( Table->Capacity - 1 ) );
+        for( ; i < Table->Capacity; i++ ) {
+            Entry = &Table->Entries[ ( Index + i ) & ( Table->Capacity - 1 ) ];
+            if( Entry->Node == NULL ) {
+                Entry = NULL;
+                i += 1;
+                break;
+            } else if( ( Entry->Node != AML_NAMESPACE_PATH_MAP_TOMBSTONE )
+                       && ( Entry->Hash == Hash )
+                       && ( ( Node == NULL ) || ( Entry->Node == Node ) ) )
+            {
+                i += 1;
+                break;
+            }
+            Entry = NULL;
+        }
+    }
+
+    if( pProbeLength != NULL ) {
+        *pProbeLength = i;
+    }
+    return Entry;
+}
+
+//
+// Find the node with the given hash within a single table from a concurrent reader.
+// Slots are read node first, the node is published after its hash (see AmlNamespacePathMapTableInsert).
+//
+_Success_( return != NULL )
+static
+struct _AML_NAMESPACE_NODE*
+AmlNamespacePathMapTableFindConcurrent(
+    _In_opt_ const AML_NAMESPACE_PATH_MAP_ENTRY* Entries,
+    _In_     SIZE_T                              Capacity,
+    _In_     UINT32                              Hash
+    )
+{
+    SIZE_T                      Index;
+    SIZE_T                      i;
+    struct _AML_NAMESPACE_NODE* Node;
+
+    if( Entries == NULL ) {
+        return NULL;
+    }
+    Index = ( Hash & ( Capacity - 1 ) );
+    for( i = 0; i < Capacity; i++ ) {
+        Node = AML_ATOMIC_LOAD_POINTER( &Entries[ ( Index + i ) & ( Capacity - 1 ) ].Node );
+        if( Node == NULL ) {
+            break;
+        } else if( ( Node != AML_NAMESPACE_PATH_MAP_TOMBSTONE )
+                   && ( AML_ATOMIC_LOAD32( &Entries[ ( Index + i ) & ( Capacity - 1 ) ].Hash ) == Hash ) )
+        {
+            return Node;
+        }
+    }
+    return NULL;
+}
+
+//
+// Replace the current and old table descriptors.
+// Concurrent readers retry any lookup that overlapped with the replacement.
+//
+static
+VOID
+AmlNamespacePathMapPublishTables(
+    _Inout_ AML_NAMESPACE_PATH_MAP*             Map,
+    _In_    const AML_NAMESPACE_PATH_MAP_TABLE* Table,
+    _In_    const AML_NAMESPACE_PATH_MAP_TABLE* OldTable
+    )
+{
+    AML_ATOMIC_STORE64( &Map->Sequence, ( Map->Sequence + 1 ) );
+    AML_ATOMIC_STORE_POINTER( &Map->Table.Entries, Table->Entries );
+    AML_ATOMIC_STORE_SIZE( &Map->Table.Capacity, Table->Capacity );
+    Map->Table.Count = Table->Count;
+    Map->Table.TombstoneCount = Table->TombstoneCount;
+    AML_ATOMIC_STORE_POINTER( &Map->OldTable.Entries, OldTable->Entries );
+    AML_ATOMIC_STORE_SIZE( &Map->OldTable.Capacity, OldTable->Capacity );
+    Map->OldTable.Count = OldTable->Count;
+    Map->OldTable.TombstoneCount = OldTable->TombstoneCount;
+    AML_ATOMIC_STORE64( &Map->Sequence, ( Map->Sequence + 1 ) );
+}
+
+//
+// Release a table that is no longer reachable through the map, concurrent readers may still be probing it.
+//
+static
+VOID
+AmlNamespacePathMapRetireEntries(
+    _Inout_             AML_NAMESPACE_PATH_MAP*       Map,
+    _In_ _Post_invalid_ AML_NAMESPACE_PATH_MAP_ENTRY* Entries
+    )
+{
+    if( Map->Epoch != NULL ) {
+        AmlEpochRetire( Map->Epoch, Entries );
+    } else {
+        AmlHeapFree( Map->Heap, Entries );
+    }
+}
+
+//
+// Insert an entry to the first free (empty or removed) slot of its probe sequence.
+// The table must have already been checked to contain a free slot.
+// The hash of the slot is written before the node, which publishes the slot to concurrent readers.
+//
+static
+VOID
+AmlNamespacePathMapTableInsert(
+    _Inout_ AML_NAMESPACE_PATH_MAP_TABLE* Table,
+    _In_    UINT32                        Hash,
+    _In_    struct _AML_NAMESPACE_NODE*   Node
+    )
+{
+    SIZE_T                        Index;
+    AML_NAMESPACE_PATH_MAP_ENTRY* Entry;
+
+    Index = ( Hash & ( Table->Capacity - 1 ) );
+    for( ;; Index = ( ( Index + 1 ) & ( Table->Capacity - 1 ) ) ) {
+        Entry = &Table->Entries[ Index ];
+        if( Entry->Node == NULL ) {
+            break;
+        } else if( Entry->Node == AML_NAMESPACE_PATH_MAP_TOMBSTONE ) {
+            Table->TombstoneCount -= 1;
+            break;
+        }
+    }
+    AML_ATOMIC_STORE32( &Entry->Hash, Hash );
+    AML_ATOMIC_STORE_POINTER( &Entry->Node, Node );
+    Table->Count += 1;
+}
+
+//
+// Allocate an empty table of the given capacity (must be a power of 2).
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespacePathMapTableAllocate(
+    _Inout_ AML_HEAP*                     Heap,
+    _Out_   AML_NAMESPACE_PATH_MAP_TABLE* Table,
+    _In_    SIZE_T                        Capacity
+    )
+{
+    AML_NAMESPACE_PATH_MAP_ENTRY* Entries;
+
+    if( Capacity > ( ~( SIZE_T )0 / sizeof( Entries[ 0 ] ) ) ) {
+        return AML_FALSE;
+    } else if( ( Entries = AmlHeapAllocate( Heap, ( Capacity * sizeof( Entries[ 0 ] ) ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    AML_MEMSET( Entries, 0, ( Capacity * sizeof( Entries[ 0 ] ) ) );
+    *Table = ( AML_NAMESPACE_PATH_MAP_TABLE ){ .Entries = Entries, .Capacity = Capacity };
+    return AML_TRUE;
+}
+
+//
+// Migrate up to the given amount of slots of the old table to the current table,
+// releases the old table once all of its slots have been migrated.
+//
+static
+VOID
+AmlNamespacePathMapMigrate(
+    _Inout_ AML_NAMESPACE_PATH_MAP* Map,
+    _In_    SIZE_T                  SlotCount
+    )
+{
+    AML_NAMESPACE_PATH_MAP_ENTRY* Entry;
+
+    if( Map->OldTable.Entries == NULL ) {
+        return;
+    }
+
+    //
+    // Move all live entries of the next slots, the old slots are replaced with tombstones,
+    // keeping the probe sequences of not yet migrated entries intact for lookups.
+    // Entries are inserted to the new table before being removed from the old table,
+    // concurrent readers search the old table first, and so always find a migrated entry in one of the tables.
+    //
+    for( ; ( SlotCount > 0 ) && ( Map->MigrateIndex < Map->OldTable.Capacity ); SlotCount--, Map->MigrateIndex++ ) {
+        Entry = &Map->OldTable.Entries[ Map->MigrateIndex ];
+        if( ( Entry->Node != NULL ) && ( Entry->Node != AML_NAMESPACE_PATH_MAP_TOMBSTONE ) ) {
+            AmlNamespacePathMapTableInsert( &Map->Table, Entry->Hash, Entry->Node );
+            AML_ATOMIC_STORE_POINTER( &Entry->Node, AML_NAMESPACE_PATH_MAP_TOMBSTONE );
+            Map->OldTable.Count -= 1;
+            Map->OldTable.TombstoneCount += 1;
+        }
+    }
+
+    //
+    // Release the old table once fully migrated.
+    //
+    if( Map->MigrateIndex >= Map->OldTable.Capacity ) {
+        Entry = Map->OldTable.Entries;
+        AmlNamespacePathMapPublishTables( Map, &Map->Table, &( AML_NAMESPACE_PATH_MAP_TABLE ){ 0 } );
+        AmlNamespacePathMapRetireEntries( Map, Entry );
+        Map->MigrateIndex = 0;
+    }
+}
+
+//
+// Ensure that the current table has room for another entry, begins rehashing to a new table if the load factor is exceeded.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlNamespacePathMapReserve(
+    _Inout_ AML_NAMESPACE_PATH_MAP* Map
+    )
+{
+    AML_NAMESPACE_PATH_MAP_TABLE NewTable;
+    AML_NAMESPACE_PATH_MAP_TABLE OldTable;
+    SIZE_T                       NewCapacity;
+
+    //
+    // Lazily allocate the initial table.
+    //
+    if( Map->Table.Entries == NULL ) {
+        if( AmlNamespacePathMapTableAllocate( Map->Heap, &NewTable, Map->InitialCapacity ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        AmlNamespacePathMapPublishTables( Map, &NewTable, &Map->OldTable );
+        return AML_TRUE;
+    }
+
+    //
+    // Nothing to do if the current table is still below the maximum load factor.
+    //
+    if( ( ( Map->Table.Count + Map->Table.TombstoneCount + 1 ) * 100 ) <= ( Map->Table.Capacity * AML_NAMESPACE_PATH_MAP_MAX_LOAD ) ) {
+        return AML_TRUE;
+    }
+
+    //
+    // Finish migrating the previous table before starting a new rehash (should only happen with heavy removal).
+    //
+    AmlNamespacePathMapMigrate( Map, ~( SIZE_T )0 );
+
+    //
+    // Double the capacity if at least half of the table is live, otherwise the load is mostly made up of removed entries,
+    // and the table only needs to be rehashed at the same capacity.
+    //
+    NewCapacity = Map->Table.Capacity;
+    if( ( Map->Table.Count * 2 ) >= Map->Table.Capacity ) {
+        if( NewCapacity > ( ~( SIZE_T )0 / 2 ) ) {
+            return AML_FALSE;
+        }
+        NewCapacity *= 2;
+    }
+    if( AmlNamespacePathMapTableAllocate( Map->Heap, &NewTable, NewCapacity ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Begin incremental migration of the current table to the new table.
+    //
+    OldTable = Map->Table;
+    AmlNamespacePathMapPublishTables( Map, &NewTable, &OldTable );
+    Map->MigrateIndex = 0;
+    Map->Statistics.ResizeCount += 1;
+    return AML_TRUE;
+}
+
+//
+// Initialize an empty path map, the table is lazily allocated upon first insertion.
+// The capacity hint is the expected amount of nodes, may be 0 to use the default minimum capacity.
+//
+VOID
+AmlNamespacePathMapInitialize(
+    _Out_       AML_NAMESPACE_PATH_MAP* Map,
+    _Inout_     AML_HEAP*               Heap,
+    _Inout_opt_ AML_EPOCH*              Epoch,
+    _In_        SIZE_T                  CapacityHint
+    )
+{
+    SIZE_T Capacity;
+
+    //
+    // Pick the smallest power of 2 capacity that fits the hinted amount of nodes below the maximum load factor.
+    //
+    Capacity = AML_NAMESPACE_PATH_MAP_MIN_CAPACITY;
+    while( ( ( Capacity / 100 ) * AML_NAMESPACE_PATH_MAP_MAX_LOAD ) < CapacityHint ) {
+        if( Capacity > ( ~( SIZE_T )0 / 2 ) ) {
+            break;
+        }
+        Capacity *= 2;
+    }
+
+    *Map = ( AML_NAMESPACE_PATH_MAP ){ .Heap = Heap, .Epoch = Epoch, .InitialCapacity = Capacity };
+}
+
+//
+// Release all path map tables.
+//
+VOID
+AmlNamespacePathMapRelease(
+    _Inout_ AML_NAMESPACE_PATH_MAP* Map
+    )
+{
+    if( Map->OldTable.Entries != NULL ) {
+        AmlHeapFree( Map->Heap, Map->OldTable.Entries );
+    }
+    if( Map->Table.Entries != NULL ) {
+        AmlHeapFree( Map->Heap, Map->Table.Entries );
+    }
+    Map->OldTable = ( AML_NAMESPACE_PATH_MAP_TABLE ){ 0 };
+    Map->Table = ( AML_NAMESPACE_PATH_MAP_TABLE ){ 0 };
+}
+
+//
+// Lookup the node with the given path hash, returns NULL if there is no node with the given hash.
+//
+_Success_( return != NULL )
+struct _AML_NAMESPACE_NODE*
+AmlNamespacePathMapLookup(
+    _Inout_ AML_NAMESPACE_PATH_MAP* Map,
+    _In_    UINT32                  Hash
+    )
+{
+    AML_NAMESPACE_PATH_MAP_ENTRY* Entry;
+    SIZE_T                        ProbeLength;
+    SIZE_T                        OldProbeLength;
+
+    //
+    // Search the current table first, and then the old table if we are in the middle of rehashing.
+    //
+    OldProbeLength = 0;
+    Entry = AmlNamespacePathMapTableFind( &Map->Table, Hash, NULL, &ProbeLength );
+    if( ( Entry == NULL ) && ( Map->OldTable.Entries != NULL ) ) {
+        Entry = AmlNamespacePathMapTableFind( &Map->OldTable, Hash, NULL, &OldProbeLength );
+    }
+
+    //
+    // Update probe statistics.
+    //
+    ProbeLength += OldProbeLength;
+    Map->Statistics.LookupCount += 1;
+    Map->Statistics.ProbeCount += ProbeLength;
+    Map->Statistics.MaxProbeLength = AML_MAX( Map->Statistics.MaxProbeLength, ProbeLength );
+
+    return ( ( Entry != NULL ) ? Entry->Node : NULL );
+}
+
+//
+// Lookup the node with the given path hash from a concurrent reader, returns NULL if there is no node with the given hash.
+// Must be called within a read-side critical section of the map's epoch, doesn't update lookup statistics.
+// Slots may be reused while they are being read, the caller must validate the path of the returned node.
+//
+_Success_( return != NULL )
+struct _AML_NAMESPACE_NODE*
+AmlNamespacePathMapLookupConcurrent(
+    _In_ const AML_NAMESPACE_PATH_MAP* Map,
+    _In_ UINT32                        Hash
+    )
+{
+    UINT64                              Sequence;
+    const AML_NAMESPACE_PATH_MAP_ENTRY* Entries;
+    SIZE_T                              Capacity;
+    const AML_NAMESPACE_PATH_MAP_ENTRY* OldEntries;
+    SIZE_T                              OldCapacity;
+    struct _AML_NAMESPACE_NODE*         Node;
+
+    for( ;; ) {
+        //
+        // Read a consistent snapshot of both table descriptors, retrying if they are being replaced.
+        //
+        Sequence = AML_ATOMIC_LOAD64( &Map->Sequence );
+        if( ( Sequence & 1 ) != 0 ) {
+            AML_PAUSE();
+            continue;
+        }
+        Entries     = AML_ATOMIC_LOAD_POINTER( &Map->Table.Entries );
+        Capacity    = AML_ATOMIC_LOAD_SIZE( &Map->Table.Capacity );
+        OldEntries  = AML_ATOMIC_LOAD_POINTER( &Map->OldTable.Entries );
+        OldCapacity = AML_ATOMIC_LOAD_SIZE( &Map->OldTable.Capacity );
+        if( AML_ATOMIC_LOAD64( &Map->Sequence ) != Sequence ) {
+            continue;
+        }
+
+        //
+        // Search the old table first, entries being migrated are always inserted to the current table before
+        // being removed from the old table. The tables themselves remain valid until the reader leaves the epoch.
+        //
+        if( ( Node = AmlNamespacePathMapTableFindConcurrent( OldEntries, OldCapacity, Hash ) ) == NULL ) {
+            Node = AmlNamespacePathMapTableFindConcurrent( Entries, Capacity, Hash );
+        }
+
+        //
+        // A miss is only valid if the tables weren't replaced in the meantime (entries may have moved to a newer table).
+        //
+        if( ( Node != NULL ) || ( AML_ATOMIC_LOAD64( &Map->Sequence ) == Sequence ) ) {
+            return Node;
+        }
+    }
+}
+
+//
+// Insert a node with the given path hash.
+// Fails if a node with the same hash already exists, or if the map couldn't be grown.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespacePathMapInsert(
+    _Inout_ AML_NAMESPACE_PATH_MAP*     Map,
+    _In_    UINT32                      Hash,
+    _In_    struct _AML_NAMESPACE_NODE* Node
+    )
+{
+    //
+    // Node hashes must be unique.
+    //
+    if( AmlNamespacePathMapLookup( Map, Hash ) != NULL ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Ensure that there is room for the new entry (may begin rehashing), and progress any pending migration.
+    //
+    if( AmlNamespacePathMapReserve( Map ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    AmlNamespacePathMapTableInsert( &Map->Table, Hash, Node );
+    AmlNamespacePathMapMigrate( Map, AML_NAMESPACE_PATH_MAP_MIGRATE_STEP );
+    return AML_TRUE;
+}
+
+//
+// Remove the given node (inserted with the given path hash) from the map.
+//
+VOID
+AmlNamespacePathMapRemove(
+    _Inout_ AML_NAMESPACE_PATH_MAP*     Map,
+    _In_    UINT32                      Hash,
+    _In_    struct _AML_NAMESPACE_NODE* Node
+    )
+{
+    AML_NAMESPACE_PATH_MAP_TABLE* Table;
+    AML_NAMESPACE_PATH_MAP_ENTRY* Entry;
+
+    //
+    // The node may still be within the old table if we are in the middle of rehashing.
+    //
+    Table = &Map->Table;
+    if( ( Entry = AmlNamespacePathMapTableFind( Table, Hash, Node, NULL ) ) == NULL ) {
+        Table = &Map->OldTable;
+        if( ( Entry = AmlNamespacePathMapTableFind( Table, Hash, Node, NULL ) ) == NULL ) {
+            return;
+        }
+    }
+
+    //
+    // Replace the slot with a tombstone to keep the probe sequences of following entries intact.
+    //
+    AML_ATOMIC_STORE_POINTER( &Entry->Node, AML_NAMESPACE_PATH_MAP_TOMBSTONE );
+    Table->Count -= 1;
+    Table->TombstoneCount += 1;
+    AmlNamespacePathMapMigrate( Map, AML_NAMESPACE_PATH_MAP_MIGRATE_STEP );
+}
+
+//
+// Query the current path map statistics.
+//
+VOID
+AmlNamespacePathMapQueryStatistics(
+    _In_  const AML_NAMESPACE_PATH_MAP*      Map,
+    _Out_ AML_NAMESPACE_PATH_MAP_STATISTICS* Statistics
+    )
+{
+    *Statistics = Map->Statistics;
+    Statistics->Capacity = ( Map->Table.Capacity + Map->OldTable.Capacity );
+    Statistics->Count = ( Map->Table.Count + Map->OldTable.Count );
+    Statistics->TombstoneCount = ( Map->Table.TombstoneCount + Map->OldTable.TombstoneCount );
+}
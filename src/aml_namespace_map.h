@@ -0,0 +1,145 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_heap.h"
+#include "aml_epoch.h"
+
+//
+// Minimum capacity of the namespace path map (must be a power of 2), used if no larger capacity hint is given.
+//
+#define AML_NAMESPACE_PATH_MAP_MIN_CAPACITY 1024
+
+//
+// Maximum load factor of the path map (including removed entries) before it is grown/rehashed, in percent.
+//
+#define AML_NAMESPACE_PATH_MAP_MAX_LOAD 75
+
+//
+// Amount of old table slots migrated to the new table by each insertion/removal while rehashing.
+//
+#define AML_NAMESPACE_PATH_MAP_MIGRATE_STEP 32
+
+//
+// Single path map slot, an empty slot has a NULL node, a removed slot has a tombstone node.
+//
+typedef struct _AML_NAMESPACE_PATH_MAP_ENTRY {
+    UINT32                      Hash;
+    struct _AML_NAMESPACE_NODE* Node;
+} AML_NAMESPACE_PATH_MAP_ENTRY;
+
+//
+// Single open-addressing (linear probing) table of the path map.
+//
+typedef struct _AML_NAMESPACE_PATH_MAP_TABLE {
+    AML_NAMESPACE_PATH_MAP_ENTRY* Entries;
+    SIZE_T                        Capacity;
+    SIZE_T                        Count;          /* Live entries. */
+    SIZE_T                        TombstoneCount; /* Removed (or migrated) entries. */
+} AML_NAMESPACE_PATH_MAP_TABLE;
+
+//
+// Path map statistics, may be queried by the host.
+//
+typedef struct _AML_NAMESPACE_PATH_MAP_STATISTICS {
+    SIZE_T Capacity;
+    SIZE_T Count;
+    SIZE_T TombstoneCount;
+    UINT64 ResizeCount;
+    UINT64 LookupCount;
+    UINT64 ProbeCount;     /* Total amount of slots visited by all lookups. */
+    UINT64 MaxProbeLength; /* Longest amount of slots visited by a single lookup. */
+} AML_NAMESPACE_PATH_MAP_STATISTICS;
+
+//
+// Absolute path hash to namespace node map.
+// Stores (hash, node) pairs contiguously in an open-addressing table that is grown once it reaches the maximum load factor.
+// Growing is done incrementally, the previous table is migrated a few slots at a time by following insertions and removals,
+// lookups search both tables until the migration is complete.
+// Node hashes are unique within the map, insertion of a node with an existing hash fails.
+// All modifications must be serialized, but concurrent readers may use AmlNamespacePathMapLookupConcurrent at any time,
+// replaced tables are then retired through the given epoch (if any) instead of being freed immediately.
+//
+typedef struct _AML_NAMESPACE_PATH_MAP {
+    AML_HEAP*                         Heap;
+    AML_EPOCH*                        Epoch;
+    SIZE_T                            InitialCapacity;
+    UINT64                            Sequence;     /* Odd while the table descriptors are being replaced. */
+    AML_NAMESPACE_PATH_MAP_TABLE      Table;
+    AML_NAMESPACE_PATH_MAP_TABLE      OldTable;     /* Table being migrated, Entries is NULL if not rehashing. */
+    SIZE_T                            MigrateIndex; /* Next slot of the old table to be migrated. */
+    AML_NAMESPACE_PATH_MAP_STATISTICS Statistics;
+} AML_NAMESPACE_PATH_MAP;
+
+//
+// Initialize an empty path map, the table is lazily allocated upon first insertion.
+// The capacity hint is the expected amount of nodes, may be 0 to use the default minimum capacity.
+// The epoch is used to retire replaced tables, and is only required if the map is used by concurrent readers.
+//
+VOID
+AmlNamespacePathMapInitialize(
+    _Out_       AML_NAMESPACE_PATH_MAP* Map,
+    _Inout_     AML_HEAP*               Heap,
+    _Inout_opt_ AML_EPOCH*              Epoch,
+    _In_        SIZE_T                  CapacityHint
+    );
+
+//
+// Release all path map tables.
+//
+VOID
+AmlNamespacePathMapRelease(
+    _Inout_ AML_NAMESPACE_PATH_MAP* Map
+    );
+
+//
+// Lookup the node with the given path hash, returns NULL if there is no node with the given hash.
+//
+_Success_( return != NULL )
+struct _AML_NAMESPACE_NODE*
+AmlNamespacePathMapLookup(
+    _Inout_ AML_NAMESPACE_PATH_MAP* Map,
+    _In_    UINT32                  Hash
+    );
+
+//
+// Lookup the node with the given path hash from a concurrent reader, returns NULL if there is no node with the given hash.
+// Must be called within a read-side critical section of the map's epoch, doesn't update lookup statistics.
+// Slots may be reused while they are being read, the caller must validate the path of the returned node.
+//
+_Success_( return != NULL )
+struct _AML_NAMESPACE_NODE*
+AmlNamespacePathMapLookupConcurrent(
+    _In_ const AML_NAMESPACE_PATH_MAP* Map,
+    _In_ UINT32                        Hash
+    );
+
+//
+// Insert a node with the given path hash.
+// Fails if a node with the same hash already exists, or if the map couldn't be grown.
+//
+_Success_( return )
+BOOLEAN
+AmlNamespacePathMapInsert(
+    _Inout_ AML_NAMESPACE_PATH_MAP*     Map,
+    _In_    UINT32                      Hash,
+    _In_    struct _AML_NAMESPACE_NODE* Node
+    );
+
+//
+// Remove the given node (inserted with the given path hash) from the map.
+//
+VOID
+AmlNamespacePathMapRemove(
+    _Inout_ AML_NAMESPACE_PATH_MAP*     Map,
+    _In_    UINT32                      Hash,
+    _In_    struct _AML_NAMESPACE_NODE* Node
+    );
+
+//
+// Query the current path map statistics.
+//
+VOID
+AmlNamespacePathMapQueryStatistics(
+    _In_  const AML_NAMESPACE_PATH_MAP*      Map,
+    _Out_ AML_NAMESPACE_PATH_MAP_STATISTICS* Statistics
+    );
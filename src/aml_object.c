@@ -5,8 +5,11 @@
 #include "aml_host.h"
 #include "aml_conv.h"
 #include "aml_decoder.h"
+#include "aml_name_cache.h"
 #include "aml_mutex.h"
 #include "aml_pci.h"
+#include "aml_mapping_cache.h"
+#include "aml_pci_topology.h"
 
 //
 // Allocate and default-initialize a reference counted AML object.
@@ -105,11 +108,31 @@ AmlObjectFree(
     case AML_OBJECT_TYPE_EVENT:
         AmlHostEventFree( Object->u.Event.Host, Object->u.Event.HostHandle );
         break;
+    case AML_OBJECT_TYPE_METHOD:
+        AmlNameCacheFree( Object->u.Method.NameCache );
+        Object->u.Method.NameCache = NULL;
+        if( Object->u.Method.HasCachedResult ) {
+            AmlDataFree( &Object->u.Method.CachedResult );
+            Object->u.Method.HasCachedResult = AML_FALSE;
+        }
+        if( Object->u.Method.HasSerializationMutex ) {
+            AmlHostMutexFree( Object->u.Method.SerializationHost, Object->u.Method.SerializationMutex );
+            Object->u.Method.HasSerializationMutex = AML_FALSE;
+        }
+        break;
     case AML_OBJECT_TYPE_OPERATION_REGION:
-        if( Object->u.OpRegion.IsMapped ) {
+        if( Object->u.OpRegion.Windows != NULL ) {
+            AmlOperationRegionFreeWindows( &Object->u.OpRegion );
+        } else if( Object->u.OpRegion.Mapping != NULL ) {
+            AmlMappingCacheReleaseMapping( Object->u.OpRegion.MappingCache, Object->u.OpRegion.Mapping );
+        } else if( Object->u.OpRegion.IsMapped ) {
             AmlHostMemoryUnmap( Object->u.OpRegion.Host, Object->u.OpRegion.MappedBase, Object->u.OpRegion.Length );
         }
-        AmlPciInformationFree( &Object->u.OpRegion.PciInfo );
+        if( Object->u.OpRegion.PciTopology != NULL ) {
+            AmlPciTopologyCacheReleaseEntry( Object->u.OpRegion.PciTopologyCache, Object->u.OpRegion.PciTopology );
+        } else {
+            AmlPciInformationFree( &Object->u.OpRegion.PciInfo );
+        }
         break;
     default:
         break;
@@ -108,6 +108,22 @@ typedef struct _AML_OBJECT_METHOD {
     UINT8                   ArgumentCount : 3;
     UINT8                   IsSerialized : 1;
     UINT8                   SyncLevel : 4;
+    struct _AML_NAME_CACHE* NameCache;    /* Call site name resolutions, lazily built upon first invocation (if enabled). */
+    UINT8                   Purity;       /* AML_METHOD_PURITY_*, lazily analyzed for identification methods (see aml_method_purity.h). */
+    BOOLEAN                 HasCachedResult;
+    UINT64                  CachedResultGeneration;
+    AML_DATA                CachedResult; /* Memoized result of a pure identification method, owned by the method object. */
+
+    //
+    // Serialization state of serialized methods invoked within execution contexts (see aml_execution_context.h),
+    // a serialized method may only be active within a single execution context at a time.
+    // The host mutex is lazily created upon the first invocation within an execution context.
+    //
+    struct _AML_HOST_CONTEXT*      SerializationHost;
+    UINT64                         SerializationMutex;
+    BOOLEAN                        HasSerializationMutex;
+    struct _AML_EXECUTION_CONTEXT* SerializationOwner;
+    SIZE_T                         SerializationDepth; /* Recursive invocation count of the owning context. */
 } AML_OBJECT_METHOD;
 
 //
@@ -138,9 +154,15 @@ typedef struct _AML_OBJECT_OPERATION_REGION {
     UINT64                    Offset;         /* Offset in bytes. */
     UINT64                    Length;         /* Length in bytes. */
     VOID*                     MappedBase;     /* For memory-mapped space types. */
-    AML_PCI_INFORMATION       PciInfo;        /* For PCI space types (CFG/BAR). */
+    struct _AML_MAPPING_CACHE* MappingCache;   /* Cache owning the SystemMemory mapping (if mapped through the state mapping cache). */
+    struct _AML_MAPPING*      Mapping;        /* Referenced cached mapping (if mapped through the state mapping cache). */
+    struct _AML_REGION_WINDOW_CACHE* Windows; /* On-demand mapping windows of windowed SystemMemory regions (MappedBase unused). */
+    AML_PCI_INFORMATION       PciInfo;        /* For PCI space types (CFG/BAR), bridge list borrowed from PciTopology if set. */
+    struct _AML_PCI_TOPOLOGY_CACHE* PciTopologyCache; /* Cache owning the PCI topology entry (if evaluated through the state PCI topology cache). */
+    struct _AML_PCI_TOPOLOGY_ENTRY* PciTopology;      /* Referenced shared PCI topology of the parent device (if evaluated through the cache). */
     UINT8                     SpaceType;      /* AML_REGION_SPACE_TYPE */
     BOOLEAN                   IsMapped : 1;	  /* For memory-mapped and PCI (CFG/BAR) space types. */
+    BOOLEAN                   IsDirectAccess : 1; /* SystemMemory mapping is plain memory, accessed directly by fields (see AmlOperationRegionIsDirectAccess). */
 } AML_OBJECT_OPERATION_REGION;
 
 //
@@ -255,14 +277,43 @@ typedef struct _AML_OBJECT_BUFFER_FIELD {
     AML_DATA         SourceBuf;
 } AML_OBJECT_BUFFER_FIELD;
 
+//
+// Precomputed access plan of a field, built once upon creation of the field (see AmlFieldBuildAccessPlan).
+// The field spans WordCount consecutive access words of its region, from region byte offset FirstWordOffset up to EndWordOffset.
+// Masks are the field bits within the first and last access words (both masks are the same for single-word fields).
+//
+typedef struct _AML_FIELD_ACCESS_PLAN {
+    BOOLEAN IsValid;         /* Regular (non-BufferAcc) access type, and the field fits within its region. */
+    UINT8   AccessBitWidth;
+    UINT8   FirstBitOffset;  /* Bit offset of the field within its first access word. */
+    UINT64  FirstWordOffset;
+    UINT64  EndWordOffset;
+    UINT64  WordCount;
+    UINT64  AccessWidthMask;
+    UINT64  FirstWordMask;
+    UINT64  LastWordMask;
+} AML_FIELD_ACCESS_PLAN;
+
+//
+// Index last selected through a field used as the index register of index fields (see UseIndexRegisterElision).
+// The register is only known to still hold Value while the write generation of its region space remains SpaceWriteGeneration.
+//
+typedef struct _AML_INDEX_REGISTER_STATE {
+    BOOLEAN IsValid;
+    UINT64  Value;
+    UINT64  SpaceWriteGeneration;
+} AML_INDEX_REGISTER_STATE;
+
 //
 // Object created by DefField.
 //
 typedef struct _AML_OBJECT_FIELD {
-    AML_FIELD_ELEMENT   Element;
-    UINT8               Flags; // AML_FIELD_FLAGS
-    UINT64              Offset;
-    struct _AML_OBJECT* OperationRegion;
+    AML_FIELD_ELEMENT        Element;
+    UINT8                    Flags; // AML_FIELD_FLAGS
+    UINT64                   Offset;
+    struct _AML_OBJECT*      OperationRegion;
+    AML_FIELD_ACCESS_PLAN    AccessPlan;
+    AML_INDEX_REGISTER_STATE IndexRegister; /* Only used if the field is the index register of index fields. */
 } AML_OBJECT_FIELD;
 
 //
@@ -274,15 +325,24 @@ typedef struct _AML_OBJECT_BANK_FIELD {
     AML_DATA            BankValue;
 } AML_OBJECT_BANK_FIELD;
 
+//
+// Precomputed index/data register geometry of an index field, built once upon creation (see AmlIndexFieldBuildAccessPlan).
+//
+typedef struct _AML_INDEX_FIELD_ACCESS_PLAN {
+    UINT64  IndexValue; /* Value written to the index register to select the field (byte offset of the field). */
+    BOOLEAN IsElidable; /* Index and data registers are regular fields that don't overlap, index writes may be elided. */
+} AML_INDEX_FIELD_ACCESS_PLAN;
+
 //
 // Object created by DefIndexField.
 //
 typedef struct _AML_OBJECT_INDEX_FIELD {
-    AML_FIELD_ELEMENT   Element;
-    UINT8               Flags; // AML_FIELD_FLAGS
-    UINT64              Offset;
-    struct _AML_OBJECT* Index;
-    struct _AML_OBJECT* Data;
+    AML_FIELD_ELEMENT           Element;
+    UINT8                       Flags; // AML_FIELD_FLAGS
+    UINT64                      Offset;
+    struct _AML_OBJECT*         Index;
+    struct _AML_OBJECT*         Data;
+    AML_INDEX_FIELD_ACCESS_PLAN AccessPlan;
 } AML_OBJECT_INDEX_FIELD;
 
 //
@@ -367,6 +427,14 @@ typedef struct _AML_OBJECT {
     //
     BOOLEAN IsInitializedDevice : 1;
 
+    //
+    // Indicates if this object is owned by a base namespace shared by multiple states (see aml_namespace_image.h).
+    // Shared objects are read-only, aren't reference counted (no ParentHeap), and aren't linked to a namespace node,
+    // a state replaces the shared object of a node with a private copy only before modifying or referencing it
+    // (see AmlNamespacePrivatizeNode), plain reads of the object receive a temporary copy of its data.
+    //
+    BOOLEAN IsShared : 1;
+
     //
     // Underlying object type structures.
     //
@@ -281,6 +281,22 @@
 #define AML_ENCODING_GROUP_LOCAL_OBJECT 5
 #define AML_ENCODING_GROUP_ARG_OBJECT   6
 
+//
+// AML opcode classes, precomputed for every opcode table entry.
+// The class of an opcode is also the index of its handler in the evaluator dispatch tables.
+// Note: these are internal, the values have no meaning or relation to the AML spec.
+//
+#define AML_OPCODE_CLASS_NONE               0 /* NameString prefixes/characters, DebugOp, and ExtOpPrefix. */
+#define AML_OPCODE_CLASS_STATEMENT          1
+#define AML_OPCODE_CLASS_NAMESPACE_MODIFIER 2
+#define AML_OPCODE_CLASS_NAMED_OBJECT       3
+#define AML_OPCODE_CLASS_EXPRESSION         4
+#define AML_OPCODE_CLASS_DATA_OBJECT        5
+#define AML_OPCODE_CLASS_DATA_EXPRESSION    6 /* Both a DataObject and an ExpressionOpcode (DefBuffer, DefPackage, DefVarPackage). */
+#define AML_OPCODE_CLASS_ARG_OBJECT         7
+#define AML_OPCODE_CLASS_LOCAL_OBJECT       8
+#define AML_OPCODE_CLASS_COUNT              9
+
 //
 // AML argument entry types.
 //
@@ -323,6 +339,7 @@ typedef struct _AML_OPCODE_TABLE_ENTRY {
     UINT8 FixedListArgCount;
     UINT8 VariableListArgTableOffset;
     UINT8 VariableListArgCount;
+    UINT8 OpcodeClass;
 } AML_OPCODE_TABLE_ENTRY;
 
 //
@@ -3,6 +3,12 @@
 #include "aml_debug.h"
 #include "aml_pci.h"
 #include "aml_operation_region.h"
+#include "aml_eval_async.h"
+
+//
+// Maximum amount of access words passed to a single vectored access by AmlOperationRegionReadBlock.
+//
+#define AML_OPERATION_REGION_BLOCK_VECTOR_SIZE 16
 
 //
 // Validate the access parameters for the given operation region.
@@ -67,6 +73,65 @@ AmlOperationRegionValidateAccess(
     return AML_TRUE;
 }
 
+//
+// Evaluate the PCI information of the device that a PCI_Config/PCI_BAR_Target region belongs to.
+// Once the initial load has completed, the topology of permanent parent nodes is shared through the state PCI topology cache,
+// the region then borrows the bridge list of the shared entry.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlOperationRegionEvaluatePci(
+    _Inout_ struct _AML_STATE*           State,
+    _Inout_ AML_OBJECT_OPERATION_REGION* Region,
+    _In_    AML_NAMESPACE_NODE*          RegionNode
+    )
+{
+    AML_NAMESPACE_NODE*     ParentNode;
+    AML_PCI_INFORMATION     Info;
+    AML_PCI_TOPOLOGY_ENTRY* Entry;
+
+    ParentNode = AmlNamespaceParentNode( &State->Namespace, RegionNode );
+
+    //
+    // Temporary parent nodes are never cached, their pointers may be reused by later nodes.
+    // The topology is only evaluated through the cache once the initial load has fully defined the namespace.
+    //
+    if( ( State->UsePciTopologyCache == AML_FALSE )
+        || ( State->IsInitialLoadComplete == AML_FALSE )
+        || ( ParentNode == NULL )
+        || ( ParentNode->TempScope != NULL ) )
+    {
+        return AmlEvalNodePciInformation( State, ParentNode, &Region->PciInfo );
+    }
+
+    //
+    // Entries are keyed by plain node pointers, drop all of them if any permanent node has been released since.
+    //
+    if( State->PciTopology.NodeReleaseCount != State->Namespace.PermanentReleaseCount ) {
+        AmlPciTopologyCacheInvalidate( &State->PciTopology );
+        State->PciTopology.NodeReleaseCount = State->Namespace.PermanentReleaseCount;
+    }
+
+    //
+    // Share the cached topology of the parent node, evaluating and caching it if this is the first region under it.
+    // Falls back to private PCI information if the entry can't be allocated.
+    //
+    if( ( Entry = AmlPciTopologyCacheLookup( &State->PciTopology, ParentNode ) ) == NULL ) {
+        if( AmlEvalNodePciInformation( State, ParentNode, &Info ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+        if( ( Entry = AmlPciTopologyCacheInsert( &State->PciTopology, ParentNode, &Info ) ) == NULL ) {
+            Region->PciInfo = Info;
+            return AML_TRUE;
+        }
+    }
+    Region->PciTopologyCache = &State->PciTopology;
+    Region->PciTopology      = Entry;
+    Region->PciInfo          = Entry->Info;
+    return AML_TRUE;
+}
+
 //
 // Ensures that the given operation region is mapped and present to be accessed.
 // For an MMIO region this consists of mapping the physical base to virtual.
@@ -79,8 +144,7 @@ AmlOperationRegionEnsureMapped(
     _Inout_ AML_OBJECT_OPERATION_REGION* Region
     )
 {
-    AML_OBJECT*         Object;
-    AML_NAMESPACE_NODE* ParentNode;
+    AML_OBJECT* Object;
 
     //
     // The backing region is only mapped once, on-demand/lazily upon the first access, and unmapped upon destruction of the object.
@@ -94,7 +158,46 @@ AmlOperationRegionEnsureMapped(
     //
     switch( Region->SpaceType ) {
     case AML_REGION_SPACE_TYPE_SYSTEM_MEMORY:
-        Region->IsMapped = AmlHostMemoryMap( State->Host, Region->Offset, Region->Length, 0, &Region->MappedBase );
+        //
+        // Large regions are only mapped on demand, in windows around the accessed offsets (see AmlOperationRegionMapAccess).
+        // Falls back to mapping the entire region if the window cache can't be allocated.
+        //
+        if( ( State->RegionWindowThreshold != 0 )
+            && ( Region->Length > State->RegionWindowThreshold )
+            && ( Region->Length <= ( UINT64_MAX - AML_BUILD_REGION_WINDOW_SIZE ) )
+            && ( Region->Offset <= ( UINT64_MAX - AML_BUILD_REGION_WINDOW_SIZE - Region->Length ) ) )
+        {
+            Region->Windows = AmlHeapAllocate( &State->Heap, sizeof( *Region->Windows ) );
+            if( Region->Windows != NULL ) {
+                *Region->Windows = ( AML_REGION_WINDOW_CACHE ){
+                    .Host         = State->Host,
+                    .Heap         = &State->Heap,
+                    .MappingCache = ( State->UseMappingCache ? &State->MappingCache : NULL ),
+                };
+                Region->IsMapped = AML_TRUE;
+                return AML_TRUE;
+            }
+        }
+
+        //
+        // Overlapping regions share a single host mapping if the mapping cache is enabled,
+        // ranges that the cache can't represent fall back to a private host mapping.
+        //
+        if( State->UseMappingCache ) {
+            Region->IsMapped = AmlMappingCacheAcquire(
+                &State->MappingCache,
+                Region->Offset,
+                Region->Length,
+                &Region->Mapping,
+                &Region->MappedBase
+            );
+            if( Region->IsMapped ) {
+                Region->MappingCache = &State->MappingCache;
+            }
+        }
+        if( Region->IsMapped == AML_FALSE ) {
+            Region->IsMapped = AmlHostMemoryMap( State->Host, Region->Offset, Region->Length, 0, &Region->MappedBase );
+        }
         if( Region->IsMapped == AML_FALSE ) {
             AML_DEBUG_ERROR(
                 State,
@@ -103,6 +206,11 @@ AmlOperationRegionEnsureMapped(
                 Region->Length
             );
         }
+
+        //
+        // If the host has declared that its mappings are plain memory, following field accesses may bypass the handler.
+        //
+        Region->IsDirectAccess = ( Region->IsMapped && State->UseDirectSystemMemoryAccess );
         return Region->IsMapped;
     case AML_REGION_SPACE_TYPE_PCI_CONFIG:
     case AML_REGION_SPACE_TYPE_PCI_BAR_TARGET:
@@ -119,8 +227,7 @@ AmlOperationRegionEnsureMapped(
         //
         // PCI access requires us to attempt to resolve the PCI information of the parent device.
         //
-        ParentNode = AmlNamespaceParentNode( &State->Namespace, Object->NamespaceNode );
-        Region->IsMapped = AmlEvalNodePciInformation( State, ParentNode, &Object->u.OpRegion.PciInfo );
+        Region->IsMapped = AmlOperationRegionEvaluatePci( State, Region, Object->NamespaceNode );
         if( Region->IsMapped == AML_FALSE ) {
             AML_DEBUG_ERROR( State, "Error: Failed to evaluate PCI information for operation region \"" );
             AmlDebugPrintNameString( State, AML_DEBUG_LEVEL_ERROR, &Object->NamespaceNode->AbsolutePath );
@@ -138,6 +245,54 @@ AmlOperationRegionEnsureMapped(
     return AML_TRUE;
 }
 
+//
+// Resolve the current PCI address (S/B/D/F) of the device of a PCI_Config/PCI_BAR_Target region,
+// taking into account any PCI bridges that the device is linked over (used by the default handlers and BAR target handlers).
+// Regions sharing cached topology that has since been invalidated are re-evaluated first.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionResolvePciAddress(
+    _Inout_ struct _AML_STATE*           State,
+    _Inout_ AML_OBJECT_OPERATION_REGION* Region,
+    _Out_   AML_PCI_SBDF_ADDRESS*        Address
+    )
+{
+    //
+    // Drop shared topology that has been invalidated (table load, bus check, released nodes), and evaluate it again.
+    //
+    if( ( Region->PciTopology != NULL )
+        && ( ( Region->PciTopology->Generation != State->PciTopology.Generation )
+             || ( State->PciTopology.NodeReleaseCount != State->Namespace.PermanentReleaseCount ) ) )
+    {
+        AmlPciTopologyCacheReleaseEntry( Region->PciTopologyCache, Region->PciTopology );
+        Region->PciTopologyCache = NULL;
+        Region->PciTopology      = NULL;
+        Region->PciInfo          = ( AML_PCI_INFORMATION ){ .Heap = &State->Heap };
+        Region->IsMapped         = AML_FALSE;
+        if( AmlOperationRegionEnsureMapped( State, Region ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+    }
+
+    //
+    // We must have evaluated PCI information for the region's device.
+    //
+    if( Region->IsMapped == AML_FALSE ) {
+        AML_DEBUG_ERROR( State, "Error: No valid parsed PCI device information for operation region!\n" );
+        return AML_FALSE;
+    }
+
+    //
+    // Shared topology also shares the resolved address, until a bridge bus-number register is written.
+    //
+    if( Region->PciTopology != NULL ) {
+        return AmlPciTopologyCacheResolveAddress( Region->PciTopologyCache, State->Host, Region->PciTopology, Address );
+    }
+    *Address = Region->PciInfo.Address;
+    return AmlPciResolveDeviceAddress( State->Host, &Region->PciInfo, Address );
+}
+
 //
 // Read from an operation region at byte-granularity.
 // Access bit-width must be a power-of-2 from 8,64 inclusive.
@@ -158,6 +313,7 @@ AmlOperationRegionRead(
 {
     SIZE_T                          i;
     AML_REGION_ACCESS_REGISTRATION* Handler;
+    BOOLEAN                         Success;
 
     //
     // Validate the input parameters of the read for this region.
@@ -192,10 +348,12 @@ AmlOperationRegionRead(
 
     //
     // Allow the registered handler to service the read for this operation region.
+    // The handler may pend the access, to be completed asynchronously by the host.
     //
-    return Handler->UserRoutine( State, Region, Handler->UserContext, Field,
-                                 AML_REGION_ACCESS_TYPE_READ, AccessAttribute, ByteOffset,
-                                 AccessBitWidth, ( AML_REGION_ACCESS_DATA* )ResultData );
+    Success = Handler->UserRoutine( State, Region, Handler->UserContext, Field,
+                                    AML_REGION_ACCESS_TYPE_READ, AccessAttribute, ByteOffset,
+                                    AccessBitWidth, ( AML_REGION_ACCESS_DATA* )ResultData );
+    return AmlEvalAsyncRegionAccessAwait( State, Region, Success );
 }
 
 //
@@ -217,6 +375,7 @@ AmlOperationRegionWrite(
     )
 {
     AML_REGION_ACCESS_REGISTRATION* Handler;
+    BOOLEAN                         Success;
 
     //
     // Validate the input parameters of the read for this region.
@@ -243,10 +402,397 @@ AmlOperationRegionWrite(
 
     //
     // Allow the registered handler to service the read for this operation region.
+    // The handler may pend the access, to be completed asynchronously by the host.
+    //
+    Success = Handler->UserRoutine( State, Region, Handler->UserContext, Field,
+                                    AML_REGION_ACCESS_TYPE_WRITE, AccessAttribute, ByteOffset,
+                                    AccessBitWidth, ( AML_REGION_ACCESS_DATA* )Data );
+    return AmlEvalAsyncRegionAccessAwait( State, Region, Success );
+}
+
+//
+// Perform a list of word accesses of the given type to an operation region, in order.
+// Dispatched to the vectored access handler of the region space in a single call if registered,
+// otherwise every access is dispatched to the regular access handler separately.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionAccessVector(
+    _Inout_                     struct _AML_STATE*           State,
+    _Inout_                     AML_OBJECT_OPERATION_REGION* Region,
+    _Inout_opt_                 AML_OBJECT_FIELD*            Field,
+    _In_                        AML_REGION_ACCESS_TYPE       RegionAccessType,
+    _In_                        UINT8                        AccessType,
+    _In_                        UINT8                        AccessAttribute,
+    _Inout_count_( EntryCount ) AML_REGION_ACCESS_ENTRY*     Entries,
+    _In_                        SIZE_T                       EntryCount
+    )
+{
+    SIZE_T                          i;
+    AML_REGION_ACCESS_REGISTRATION* Handler;
+    BOOLEAN                         Success;
+
+    //
+    // Validate the input parameters of every access for this region,
+    // and zero out the data of all reads before passing them to the handler.
+    //
+    for( i = 0; i < EntryCount; i++ ) {
+        if( AmlOperationRegionValidateAccess( State, Region, Entries[ i ].Offset, AccessType,
+                                              Entries[ i ].BitWidth, sizeof( Entries[ i ].Word ) ) == AML_FALSE )
+        {
+            return AML_FALSE;
+        }
+        if( RegionAccessType == AML_REGION_ACCESS_TYPE_READ ) {
+            Entries[ i ].Word = 0;
+        }
+    }
+
+    //
+    // Ensure that the backing data of the operation region is mapped and accessible.
+    //
+    if( AmlOperationRegionEnsureMapped( State, Region ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // See if an access handler has been registered for this type of region.
+    //
+    Handler = AmlLookupRegionSpaceAccessHandler( State, Region->SpaceType );
+    if( ( Handler == NULL ) || ( Handler->UserRoutine == NULL ) ) {
+        AML_DEBUG_ERROR( State, "Error: No handler registered for region space type: 0x%x.\n", ( UINT )Region->SpaceType );
+        return AML_FALSE;
+    }
+
+    //
+    // Allow the vectored handler to service all accesses at once, the handler may pend the entire vectored access.
+    //
+    if( Handler->VectorRoutine != NULL ) {
+        Success = Handler->VectorRoutine( State, Region, Handler->UserContext, Field,
+                                          RegionAccessType, AccessAttribute, Entries, EntryCount );
+        return AmlEvalAsyncRegionAccessAwait( State, Region, Success );
+    }
+
+    //
+    // Fall back to servicing every access using the regular handler.
+    //
+    for( i = 0; i < EntryCount; i++ ) {
+        Success = Handler->UserRoutine( State, Region, Handler->UserContext, Field,
+                                        RegionAccessType, AccessAttribute, Entries[ i ].Offset,
+                                        Entries[ i ].BitWidth, ( AML_REGION_ACCESS_DATA* )&Entries[ i ].Word );
+        if( AmlEvalAsyncRegionAccessAwait( State, Region, Success ) == AML_FALSE ) {
+            return AML_FALSE;
+        }
+    }
+
+    return AML_TRUE;
+}
+
+//
+// Read a block of bytes from an operation region in as few accesses as possible (used to copy tables loaded by Load).
+// Direct access SystemMemory regions are copied straight from their mapping (see AmlOperationRegionIsDirectAccess),
+// other regions are read using the widest naturally aligned access words, batched into vectored accesses.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionReadBlock(
+    _Inout_                        struct _AML_STATE*           State,
+    _Inout_                        AML_OBJECT_OPERATION_REGION* Region,
+    _In_                           UINT64                       ByteOffset,
+    _Out_writes_bytes_all_( Size ) VOID*                        Data,
+    _In_                           SIZE_T                       Size
+    )
+{
+    AML_REGION_ACCESS_ENTRY Entries[ AML_OPERATION_REGION_BLOCK_VECTOR_SIZE ];
+    SIZE_T                  EntryCount;
+    SIZE_T                  Position;
+    SIZE_T                  BatchPosition;
+    SIZE_T                  ByteCount;
+    SIZE_T                  i;
+    SIZE_T                  j;
+
+    //
+    // The entire block must be within the bounds of the region.
+    //
+    if( ( ByteOffset > Region->Length ) || ( Size > ( Region->Length - ByteOffset ) ) ) {
+        return AML_FALSE;
+    } else if( Size == 0 ) {
+        return AML_TRUE;
+    }
+
+    //
+    // Copy the block straight from the mapping of direct access regions.
+    //
+    if( AmlOperationRegionEnsureMapped( State, Region ) == AML_FALSE ) {
+        return AML_FALSE;
+    } else if( AmlOperationRegionIsDirectAccess( State, Region ) ) {
+        AML_MEMCPY( Data, ( ( const UINT8* )Region->MappedBase + ByteOffset ), Size );
+        return AML_TRUE;
+    }
+
+    //
+    // Read the block in batches of the widest access words that are naturally aligned within the region,
+    // and that don't exceed the remaining size of the block.
+    //
+    Position = 0;
+    while( Position < Size ) {
+        BatchPosition = Position;
+        for( EntryCount = 0; ( EntryCount < AML_COUNTOF( Entries ) ) && ( Position < Size ); EntryCount++ ) {
+            for( ByteCount = sizeof( UINT64 ); ByteCount > 1; ByteCount /= 2 ) {
+                if( ( ( ( ByteOffset + Position ) & ( ByteCount - 1 ) ) == 0 ) && ( ByteCount <= ( Size - Position ) ) ) {
+                    break;
+                }
+            }
+            Entries[ EntryCount ] = ( AML_REGION_ACCESS_ENTRY ){
+                .Offset   = ( ByteOffset + Position ),
+                .BitWidth = ( ByteCount * CHAR_BIT ),
+            };
+            Position += ByteCount;
+        }
+        if( AmlOperationRegionAccessVector( State, Region, NULL, AML_REGION_ACCESS_TYPE_READ, AML_FIELD_ACCESS_TYPE_ANY_ACC,
+                                            0, Entries, EntryCount ) == AML_FALSE )
+        {
+            return AML_FALSE;
+        }
+
+        //
+        // Store the read words to the output block in little-endian byte order.
+        //
+        for( i = 0; i < EntryCount; i++ ) {
+            for( j = 0; j < ( Entries[ i ].BitWidth / CHAR_BIT ); j++ ) {
+                ( ( UINT8* )Data )[ BatchPosition++ ] = ( UINT8 )( Entries[ i ].Word >> ( j * CHAR_BIT ) );
+            }
+        }
+    }
+
+    return AML_TRUE;
+}
+
+//
+// Unmap a single mapping window of a windowed SystemMemory region, the window slot becomes unused.
+//
+static
+VOID
+AmlOperationRegionUnmapWindow(
+    _Inout_ AML_REGION_WINDOW_CACHE* Cache,
+    _Inout_ AML_REGION_WINDOW*       Window
+    )
+{
+    if( Window->Mapping != NULL ) {
+        AmlMappingCacheReleaseMapping( Cache->MappingCache, Window->Mapping );
+    } else {
+        AmlHostMemoryUnmap( Cache->Host, Window->MappedBase, Window->Size );
+    }
+    *Window = ( AML_REGION_WINDOW ){ .Size = 0 };
+}
+
+//
+// Get the virtual address of an access to a mapped SystemMemory region (see AmlHostMmioRead/Write).
+// Windowed regions have no MappedBase, the window containing the access is mapped on demand,
+// the returned address is only valid until the next call for the same region.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionMapAccess(
+    _Inout_  struct _AML_STATE*           State,
+    _Inout_  AML_OBJECT_OPERATION_REGION* Region,
+    _In_     UINT64                       ByteOffset,
+    _In_     UINT64                       AccessBitWidth,
+    _Outptr_ VOID**                       ppAddress
+    )
+{
+    AML_REGION_WINDOW_CACHE* Cache;
+    AML_REGION_WINDOW*       Window;
+    UINT64                   AccessSize;
+    UINT64                   PhysicalAddress;
+    UINT64                   Start;
+    UINT64                   End;
+    SIZE_T                   i;
+
+    //
+    // Regions that aren't windowed are mapped in their entirety.
+    //
+    if( Region->Windows == NULL ) {
+        *ppAddress = ( ( UINT8* )Region->MappedBase + ByteOffset );
+        return AML_TRUE;
+    }
+
+    //
+    // Look for an already mapped window containing the entire access.
+    //
+    Cache = Region->Windows;
+    AccessSize = AML_MAX( ( AccessBitWidth / CHAR_BIT ), 1 );
+    Cache->UseTick += 1;
+    for( i = 0; i < AML_COUNTOF( Cache->Windows ); i++ ) {
+        Window = &Cache->Windows[ i ];
+        if( ( Window->Size != 0 )
+            && ( ByteOffset >= Window->Offset )
+            && ( Window->Size >= AccessSize )
+            && ( ( ByteOffset - Window->Offset ) <= ( Window->Size - AccessSize ) ) )
+        {
+            Window->LastUseTick = Cache->UseTick;
+            *ppAddress = ( ( UINT8* )Window->MappedBase + ( ByteOffset - Window->Offset ) );
+            return AML_TRUE;
+        }
+    }
+
+    //
+    // Determine the bounds of the new window, windows are aligned to their size in physical address space,
+    // an access straddling a window boundary instead begins a window at its own page.
+    // The window is clipped to the bounds of the region, the access has already been validated against them.
+    //
+    PhysicalAddress = ( Region->Offset + ByteOffset );
+    Start = ( PhysicalAddress & ~( ( UINT64 )AML_BUILD_REGION_WINDOW_SIZE - 1 ) );
+    if( ( PhysicalAddress + AccessSize ) > ( Start + AML_BUILD_REGION_WINDOW_SIZE ) ) {
+        Start = ( PhysicalAddress & ~( ( UINT64 )AML_BUILD_MAPPING_CACHE_PAGE_SIZE - 1 ) );
+    }
+    End = AML_MIN( ( Start + AML_BUILD_REGION_WINDOW_SIZE ), ( Region->Offset + Region->Length ) );
+    Start = AML_MAX( Start, Region->Offset );
+
+    //
+    // Unmap all windows overlapping the new window, so that no part of the region is ever mapped twice,
+    // and select the window slot to use, either an unused one, or the least recently used one.
+    //
+    Window = &Cache->Windows[ 0 ];
+    for( i = 0; i < AML_COUNTOF( Cache->Windows ); i++ ) {
+        if( ( Cache->Windows[ i ].Size != 0 )
+            && ( ( Region->Offset + Cache->Windows[ i ].Offset ) < End )
+            && ( ( Region->Offset + Cache->Windows[ i ].Offset + Cache->Windows[ i ].Size ) > Start ) )
+        {
+            AmlOperationRegionUnmapWindow( Cache, &Cache->Windows[ i ] );
+        }
+        if( ( Window->Size != 0 )
+            && ( ( Cache->Windows[ i ].Size == 0 ) || ( Cache->Windows[ i ].LastUseTick < Window->LastUseTick ) ) )
+        {
+            Window = &Cache->Windows[ i ];
+        }
+    }
+
+    //
+    // Replace the selected window slot with the new window.
     //
-    return Handler->UserRoutine( State, Region, Handler->UserContext, Field,
-                                 AML_REGION_ACCESS_TYPE_WRITE, AccessAttribute, ByteOffset,
-                                 AccessBitWidth, ( AML_REGION_ACCESS_DATA* )Data );
+    if( Window->Size != 0 ) {
+        AmlOperationRegionUnmapWindow( Cache, Window );
+    }
+    if( Cache->MappingCache != NULL ) {
+        if( AmlMappingCacheAcquire( Cache->MappingCache, Start, ( End - Start ), &Window->Mapping, &Window->MappedBase ) == AML_FALSE ) {
+            Window->Mapping = NULL;
+        }
+    }
+    if( ( Window->Mapping == NULL )
+        && ( AmlHostMemoryMap( State->Host, Start, ( End - Start ), 0, &Window->MappedBase ) == AML_FALSE ) )
+    {
+        AML_DEBUG_ERROR(
+            State,
+            "Error: Failed to map system memory operation region window: 0x%"PRIx64" (Size: 0x%"PRIx64")\n",
+            Start,
+            ( End - Start )
+        );
+        return AML_FALSE;
+    }
+    Window->Offset      = ( Start - Region->Offset );
+    Window->Size        = ( End - Start );
+    Window->LastUseTick = Cache->UseTick;
+    *ppAddress = ( ( UINT8* )Window->MappedBase + ( ByteOffset - Window->Offset ) );
+    return AML_TRUE;
+}
+
+//
+// Unmap all mapping windows of a windowed SystemMemory region, and free its window cache.
+//
+VOID
+AmlOperationRegionFreeWindows(
+    _Inout_ AML_OBJECT_OPERATION_REGION* Region
+    )
+{
+    AML_REGION_WINDOW_CACHE* Cache;
+    SIZE_T                   i;
+
+    Cache = Region->Windows;
+    for( i = 0; i < AML_COUNTOF( Cache->Windows ); i++ ) {
+        if( Cache->Windows[ i ].Size != 0 ) {
+            AmlOperationRegionUnmapWindow( Cache, &Cache->Windows[ i ] );
+        }
+    }
+    AmlHeapFree( Cache->Heap, Cache );
+    Region->Windows = NULL;
+}
+
+//
+// Check if field accesses to the given region may directly load and store its mapping (AmlOperationRegionDirectRead/Write).
+// Only applies to SystemMemory regions that have already been mapped (without windows) by a state with UseDirectSystemMemoryAccess enabled,
+// and only while the default SystemMemory handler is registered (custom handlers always observe every access).
+//
+BOOLEAN
+AmlOperationRegionIsDirectAccess(
+    _In_ const struct _AML_STATE*           State,
+    _In_ const AML_OBJECT_OPERATION_REGION* Region
+    )
+{
+    const AML_REGION_ACCESS_REGISTRATION* Handler;
+
+    if( Region->IsDirectAccess == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    Handler = &State->RegionSpaceHandlers[ AML_REGION_SPACE_TYPE_SYSTEM_MEMORY ];
+    return ( ( Handler->UserRoutine == AmlOperationRegionHandlerDefaultSystemMemory ) && ( Handler->VectorRoutine == NULL ) );
+}
+
+//
+// Directly read a word from the mapping of a direct access region (see AmlOperationRegionIsDirectAccess) using a volatile load.
+// The access must have already been validated against the bounds of the region by the caller.
+//
+UINT64
+AmlOperationRegionDirectRead(
+    _In_ const AML_OBJECT_OPERATION_REGION* Region,
+    _In_ UINT64                             ByteOffset,
+    _In_ UINT64                             AccessBitWidth
+    )
+{
+    volatile UINT8* Address;
+
+    Address = ( ( volatile UINT8* )Region->MappedBase + ByteOffset );
+    switch( AccessBitWidth ) {
+    case 8:
+        return *Address;
+    case 16:
+        return *( volatile UINT16* )Address;
+    case 32:
+        return *( volatile UINT32* )Address;
+    case 64:
+        return *( volatile UINT64* )Address;
+    }
+    return 0;
+}
+
+//
+// Directly write a word to the mapping of a direct access region (see AmlOperationRegionIsDirectAccess) using a volatile store.
+// The access must have already been validated against the bounds of the region by the caller.
+//
+VOID
+AmlOperationRegionDirectWrite(
+    _In_ const AML_OBJECT_OPERATION_REGION* Region,
+    _In_ UINT64                             ByteOffset,
+    _In_ UINT64                             AccessBitWidth,
+    _In_ UINT64                             Word
+    )
+{
+    volatile UINT8* Address;
+
+    Address = ( ( volatile UINT8* )Region->MappedBase + ByteOffset );
+    switch( AccessBitWidth ) {
+    case 8:
+        *Address = ( UINT8 )Word;
+        break;
+    case 16:
+        *( volatile UINT16* )Address = ( UINT16 )Word;
+        break;
+    case 32:
+        *( volatile UINT32* )Address = ( UINT32 )Word;
+        break;
+    case 64:
+        *( volatile UINT64* )Address = Word;
+        break;
+    }
 }
 
 //
@@ -398,15 +944,16 @@ _Success_( return )
 static
 BOOLEAN
 AmlOperationRegionReadSystemMemory(
-    _In_                                 const struct _AML_STATE*           State,
-    _In_                                 const AML_OBJECT_OPERATION_REGION* Region,
-    _In_                                 UINT64                             Offset,
-    _In_                                 UINT64                             AccessBitWidth,
-    _Out_writes_bytes_( ResultDataSize ) VOID*                              ResultData,
-    _In_                                 SIZE_T                             ResultDataSize
+    _Inout_                              struct _AML_STATE*           State,
+    _Inout_                              AML_OBJECT_OPERATION_REGION* Region,
+    _In_                                 UINT64                       Offset,
+    _In_                                 UINT64                       AccessBitWidth,
+    _Out_writes_bytes_( ResultDataSize ) VOID*                        ResultData,
+    _In_                                 SIZE_T                       ResultDataSize
     )
 {
     UINT64 MmioAddress;
+    VOID*  Address;
 
     //
     // Validate input parameters.
@@ -427,8 +974,12 @@ AmlOperationRegionReadSystemMemory(
 
     //
     // Calculate absolute MMIO address, the input offset is relative to the region start offset.
+    // Windowed regions map the window containing the access on demand.
     //
-    MmioAddress = ( ( UINT64 )Region->MappedBase + Offset );
+    if( AmlOperationRegionMapAccess( State, Region, Offset, AccessBitWidth, &Address ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    MmioAddress = ( UINT64 )Address;
 
     //
     // Perform the actual I/O read.
@@ -460,15 +1011,16 @@ _Success_( return )
 static
 BOOLEAN
 AmlOperationRegionWriteSystemMemory(
-    _In_                         const struct _AML_STATE*           State,
-    _In_                         const AML_OBJECT_OPERATION_REGION* Region,
-    _In_                         UINT64                             Offset,
-    _In_                         UINT64                             AccessBitWidth,
-    _In_reads_bytes_( DataSize ) VOID*                              Data,
-    _In_                         SIZE_T                             DataSize
+    _Inout_                      struct _AML_STATE*           State,
+    _Inout_                      AML_OBJECT_OPERATION_REGION* Region,
+    _In_                         UINT64                       Offset,
+    _In_                         UINT64                       AccessBitWidth,
+    _In_reads_bytes_( DataSize ) VOID*                        Data,
+    _In_                         SIZE_T                       DataSize
     )
 {
     UINT64 MmioAddress;
+    VOID*  Address;
 
     //
     // Validate input parameters.
@@ -488,8 +1040,12 @@ AmlOperationRegionWriteSystemMemory(
 
     //
     // Calculate absolute MMIO address, the input offset is relative to the region start offset.
+    // Windowed regions map the window containing the access on demand.
     //
-    MmioAddress = ( ( UINT64 )Region->MappedBase + Offset );
+    if( AmlOperationRegionMapAccess( State, Region, Offset, AccessBitWidth, &Address ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    MmioAddress = ( UINT64 )Address;
 
     //
     // Perform the actual I/O read.
@@ -547,7 +1103,7 @@ _Success_( return )
 static
 BOOLEAN
 AmlOperationRegionReadPciConfig(
-    _In_                                 const struct _AML_STATE*     State,
+    _Inout_                              struct _AML_STATE*           State,
     _Inout_                              AML_OBJECT_OPERATION_REGION* Region,
     _In_                                 UINT64                       Offset,
     _In_                                 UINT64                       AccessBitWidth,
@@ -566,20 +1122,11 @@ AmlOperationRegionReadPciConfig(
         return AML_FALSE;
     }
 
-    //
-    // We must have evaluated PCI information for the region's device.
-    //
-    if( Region->IsMapped == AML_FALSE ) {
-        AML_DEBUG_ERROR( State, "Error: No valid parsed PCI device information for operation region!\n" );
-        return AML_FALSE;
-    }
-
     //
     // Resolve the actual current PCI address (S/B/D/F) of the region's device.
     // Takes into account any PCI bridges that the device is linked over.
     //
-    Address = Region->PciInfo.Address;
-    if( AmlPciResolveDeviceAddress( State->Host, &Region->PciInfo, &Address ) == AML_FALSE ) {
+    if( AmlOperationRegionResolvePciAddress( State, Region, &Address ) == AML_FALSE ) {
         return AML_FALSE;
     }
 
@@ -613,7 +1160,7 @@ _Success_( return )
 static
 BOOLEAN
 AmlOperationRegionWritePciConfig(
-    _In_                         const struct _AML_STATE*     State,
+    _Inout_                      struct _AML_STATE*           State,
     _Inout_                      AML_OBJECT_OPERATION_REGION* Region,
     _In_                         UINT64                       Offset,
     _In_                         UINT64                       AccessBitWidth,
@@ -632,20 +1179,11 @@ AmlOperationRegionWritePciConfig(
         return AML_FALSE;
     }
 
-    //
-    // We must have evaluated PCI information for the region's device.
-    //
-    if( Region->IsMapped == AML_FALSE ) {
-        AML_DEBUG_ERROR( State, "Error: No valid parsed PCI device information for operation region!\n" );
-        return AML_FALSE;
-    }
-
     //
     // Resolve the actual current PCI address (S/B/D/F) of the region's device.
     // Takes into account any PCI bridges that the device is linked over.
     //
-    Address = Region->PciInfo.Address;
-    if( AmlPciResolveDeviceAddress( State->Host, &Region->PciInfo, &Address ) == AML_FALSE ) {
+    if( AmlOperationRegionResolvePciAddress( State, Region, &Address ) == AML_FALSE ) {
         return AML_FALSE;
     }
 
@@ -669,6 +1207,16 @@ AmlOperationRegionWritePciConfig(
         return AML_FALSE;
     }
 
+    //
+    // Writes to the bus-number registers of a bridge (primary, secondary, subordinate) may move all devices behind it,
+    // invalidate all resolved addresses of the shared PCI topology (these offsets are BAR2 of non-bridge devices).
+    //
+    if( ( ( Region->Offset + Offset ) <= AML_PCI_CFS_OFFSET_BRIDGE_SUBORDINATE_BUS )
+        && ( ( Region->Offset + Offset + ( AccessBitWidth / CHAR_BIT ) ) > AML_PCI_CFS_OFFSET_BRIDGE_PRIMARY_BUS ) )
+    {
+        AmlPciTopologyCacheInvalidateAddresses( &State->PciTopology );
+    }
+
     return AML_TRUE;
 }
 
@@ -2,6 +2,45 @@
 
 #include "aml_platform.h"
 #include "aml_object.h"
+#include "aml_heap.h"
+#include "aml_mapping_cache.h"
+
+//
+// Size of the on-demand mapping windows of windowed SystemMemory regions (see AML_STATE_PARAMETERS.RegionWindowThreshold),
+// windows are aligned to their size in physical address space. Must be a power-of-2 multiple of the page size.
+//
+#ifndef AML_BUILD_REGION_WINDOW_SIZE
+ #define AML_BUILD_REGION_WINDOW_SIZE ( 16 * AML_BUILD_MAPPING_CACHE_PAGE_SIZE )
+#endif
+
+//
+// Maximum amount of mapping windows kept alive per windowed SystemMemory region.
+//
+#ifndef AML_BUILD_REGION_WINDOW_COUNT
+ #define AML_BUILD_REGION_WINDOW_COUNT 4
+#endif
+
+//
+// Mapped window of a windowed SystemMemory region.
+//
+typedef struct _AML_REGION_WINDOW {
+    UINT64               Offset;      /* Offset of the window relative to the start of the region. */
+    UINT64               Size;        /* Size of the window in bytes, 0 if the window slot is unused. */
+    VOID*                MappedBase;
+    struct _AML_MAPPING* Mapping;     /* Referenced cached mapping (if mapped through the state mapping cache). */
+    UINT64               LastUseTick;
+} AML_REGION_WINDOW;
+
+//
+// Per-region cache of mapping windows, the least recently used window is replaced when all slots are in use.
+//
+typedef struct _AML_REGION_WINDOW_CACHE {
+    struct _AML_HOST_CONTEXT* Host;
+    AML_HEAP*                 Heap;
+    AML_MAPPING_CACHE*        MappingCache; /* Optional, windows are mapped through the state mapping cache if set. */
+    UINT64                    UseTick;
+    AML_REGION_WINDOW         Windows[ AML_BUILD_REGION_WINDOW_COUNT ];
+} AML_REGION_WINDOW_CACHE;
 
 //
 // AML operation-region access type, used by the host to distinguish
@@ -78,14 +117,45 @@ BOOLEAN
     _Inout_     AML_REGION_ACCESS_DATA*              Data
     );
 
+//
+// Single word access of a vectored operation region access.
+//
+typedef struct _AML_REGION_ACCESS_ENTRY {
+    UINT64 Offset;   /* Byte offset of the access, relative to the start of the region. */
+    UINT64 BitWidth; /* Access bit-width, a power-of-2 from 8,64 inclusive. */
+    UINT64 Word;     /* Data of the access (only the low BitWidth bits are significant), filled in by the handler for reads. */
+} AML_REGION_ACCESS_ENTRY;
+
+//
+// AML operation-region vectored access handler callback.
+// Services a list of word accesses of the same type in a single call, the accesses must be performed in order.
+// The accesses of a single field read or write all have the same width, and form one contiguous ascending span.
+// Used by the host to reduce the amount of separate (possibly expensive) callbacks for multi-word field accesses.
+//
+typedef
+_Success_( return )
+BOOLEAN
+( *AML_REGION_ACCESS_VECTOR_ROUTINE )(
+    _Inout_                     struct _AML_STATE*           State,
+    _Inout_                     AML_OBJECT_OPERATION_REGION* Region,
+    _Inout_                     VOID*                        UserContext,
+    _Inout_opt_                 AML_OBJECT_FIELD*            Field,
+    _In_                        AML_REGION_ACCESS_TYPE       AccessType,
+    _In_                        UINT8                        AccessAttribute,
+    _Inout_count_( EntryCount ) AML_REGION_ACCESS_ENTRY*     Entries,
+    _In_                        SIZE_T                       EntryCount
+    );
+
 //
 // Registered information about a region access handler.
+// The vectored access routine is optional, accesses are split into per-word UserRoutine calls if not present.
 //
 typedef struct _AML_REGION_ACCESS_REGISTRATION {
-    AML_REGION_ACCESS_ROUTINE UserRoutine;
-    VOID*                     UserContext;
-    BOOLEAN                   BroadcastPending;
-    BOOLEAN                   EnableState;
+    AML_REGION_ACCESS_ROUTINE        UserRoutine;
+    AML_REGION_ACCESS_VECTOR_ROUTINE VectorRoutine;
+    VOID*                            UserContext;
+    BOOLEAN                          BroadcastPending;
+    BOOLEAN                          EnableState;
 } AML_REGION_ACCESS_REGISTRATION;
 
 //
@@ -124,6 +194,109 @@ AmlOperationRegionWrite(
     _In_                         SIZE_T                       DataSize
     );
 
+//
+// Perform a list of word accesses of the given type to an operation region, in order.
+// Dispatched to the vectored access handler of the region space in a single call if registered,
+// otherwise every access is dispatched to the regular access handler separately.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionAccessVector(
+    _Inout_                     struct _AML_STATE*           State,
+    _Inout_                     AML_OBJECT_OPERATION_REGION* Region,
+    _Inout_opt_                 AML_OBJECT_FIELD*            Field,
+    _In_                        AML_REGION_ACCESS_TYPE       RegionAccessType,
+    _In_                        UINT8                        AccessType,
+    _In_                        UINT8                        AccessAttribute,
+    _Inout_count_( EntryCount ) AML_REGION_ACCESS_ENTRY*     Entries,
+    _In_                        SIZE_T                       EntryCount
+    );
+
+//
+// Read a block of bytes from an operation region in as few accesses as possible (used to copy tables loaded by Load).
+// Direct access SystemMemory regions are copied straight from their mapping (see AmlOperationRegionIsDirectAccess),
+// other regions are read using the widest naturally aligned access words, batched into vectored accesses.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionReadBlock(
+    _Inout_                        struct _AML_STATE*           State,
+    _Inout_                        AML_OBJECT_OPERATION_REGION* Region,
+    _In_                           UINT64                       ByteOffset,
+    _Out_writes_bytes_all_( Size ) VOID*                        Data,
+    _In_                           SIZE_T                       Size
+    );
+
+//
+// Get the virtual address of an access to a mapped SystemMemory region (see AmlHostMmioRead/Write).
+// Windowed regions have no MappedBase, the window containing the access is mapped on demand,
+// the returned address is only valid until the next call for the same region.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionMapAccess(
+    _Inout_  struct _AML_STATE*           State,
+    _Inout_  AML_OBJECT_OPERATION_REGION* Region,
+    _In_     UINT64                       ByteOffset,
+    _In_     UINT64                       AccessBitWidth,
+    _Outptr_ VOID**                       ppAddress
+    );
+
+//
+// Unmap all mapping windows of a windowed SystemMemory region, and free its window cache.
+//
+VOID
+AmlOperationRegionFreeWindows(
+    _Inout_ AML_OBJECT_OPERATION_REGION* Region
+    );
+
+//
+// Resolve the current PCI address (S/B/D/F) of the device of a PCI_Config/PCI_BAR_Target region,
+// taking into account any PCI bridges that the device is linked over (used by the default handlers and BAR target handlers).
+// Regions sharing cached topology that has since been invalidated are re-evaluated first.
+//
+_Success_( return )
+BOOLEAN
+AmlOperationRegionResolvePciAddress(
+    _Inout_ struct _AML_STATE*           State,
+    _Inout_ AML_OBJECT_OPERATION_REGION* Region,
+    _Out_   AML_PCI_SBDF_ADDRESS*        Address
+    );
+
+//
+// Check if field accesses to the given region may directly load and store its mapping (AmlOperationRegionDirectRead/Write).
+// Only applies to SystemMemory regions that have already been mapped (without windows) by a state with UseDirectSystemMemoryAccess enabled,
+// and only while the default SystemMemory handler is registered (custom handlers always observe every access).
+//
+BOOLEAN
+AmlOperationRegionIsDirectAccess(
+    _In_ const struct _AML_STATE*           State,
+    _In_ const AML_OBJECT_OPERATION_REGION* Region
+    );
+
+//
+// Directly read a word from the mapping of a direct access region (see AmlOperationRegionIsDirectAccess) using a volatile load.
+// The access must have already been validated against the bounds of the region by the caller.
+//
+UINT64
+AmlOperationRegionDirectRead(
+    _In_ const AML_OBJECT_OPERATION_REGION* Region,
+    _In_ UINT64                             ByteOffset,
+    _In_ UINT64                             AccessBitWidth
+    );
+
+//
+// Directly write a word to the mapping of a direct access region (see AmlOperationRegionIsDirectAccess) using a volatile store.
+// The access must have already been validated against the bounds of the region by the caller.
+//
+VOID
+AmlOperationRegionDirectWrite(
+    _In_ const AML_OBJECT_OPERATION_REGION* Region,
+    _In_ UINT64                             ByteOffset,
+    _In_ UINT64                             AccessBitWidth,
+    _In_ UINT64                             Word
+    );
+
 //
 // Default region-space handler for system IO space.
 //
@@ -0,0 +1,268 @@
+#include "aml_pci_topology.h"
+#include "aml_pci.h"
+#include "aml_hash.h"
+
+//
+// Calculate the bucket index of a node key.
+//
+static
+SIZE_T
+AmlPciTopologyCacheBucketIndex(
+    _In_ const AML_PCI_TOPOLOGY_CACHE* Cache,
+    _In_ const VOID*                   Node
+    )
+{
+    return ( AmlHashKey32( &Node, sizeof( Node ), 0 ) & ( Cache->BucketCount - 1 ) );
+}
+
+//
+// Free an entry that has already been unlinked from the cache and has no remaining references.
+//
+static
+VOID
+AmlPciTopologyCacheDestroy(
+    _Inout_                AML_PCI_TOPOLOGY_CACHE* Cache,
+    _Inout_ _Post_invalid_ AML_PCI_TOPOLOGY_ENTRY* Entry
+    )
+{
+    AmlPciInformationFree( &Entry->Info );
+    AmlHeapFree( Cache->Heap, Entry );
+}
+
+//
+// Grow the bucket array to fit at least one more entry, re-hashing all linked entries.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlPciTopologyCacheGrow(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache
+    )
+{
+    AML_PCI_TOPOLOGY_ENTRY** OldBuckets;
+    SIZE_T                   OldBucketCount;
+    SIZE_T                   NewBucketCount;
+    AML_PCI_TOPOLOGY_ENTRY** NewBuckets;
+    AML_PCI_TOPOLOGY_ENTRY*  Entry;
+    AML_PCI_TOPOLOGY_ENTRY*  NextEntry;
+    SIZE_T                   BucketIndex;
+    SIZE_T                   i;
+
+    if( Cache->EntryCount < Cache->BucketCount ) {
+        return AML_TRUE;
+    }
+
+    //
+    // Allocate the new (power-of-2 sized) bucket array.
+    //
+    NewBucketCount = AML_MAX( AML_PCI_TOPOLOGY_CACHE_MIN_BUCKET_COUNT, ( Cache->BucketCount * 2 ) );
+    if( NewBucketCount > ( SIZE_MAX / sizeof( NewBuckets[ 0 ] ) ) ) {
+        return AML_FALSE;
+    } else if( ( NewBuckets = AmlHeapAllocate( Cache->Heap, ( NewBucketCount * sizeof( NewBuckets[ 0 ] ) ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+    for( i = 0; i < NewBucketCount; i++ ) {
+        NewBuckets[ i ] = NULL;
+    }
+
+    //
+    // Re-hash all entries into the new buckets.
+    //
+    OldBuckets = Cache->Buckets;
+    OldBucketCount = Cache->BucketCount;
+    Cache->Buckets = NewBuckets;
+    Cache->BucketCount = NewBucketCount;
+    for( i = 0; i < OldBucketCount; i++ ) {
+        for( Entry = OldBuckets[ i ]; Entry != NULL; Entry = NextEntry ) {
+            NextEntry = Entry->Next;
+            BucketIndex = AmlPciTopologyCacheBucketIndex( Cache, Entry->Node );
+            Entry->Next = NewBuckets[ BucketIndex ];
+            NewBuckets[ BucketIndex ] = Entry;
+        }
+    }
+    if( OldBuckets != NULL ) {
+        AmlHeapFree( Cache->Heap, OldBuckets );
+    }
+
+    return AML_TRUE;
+}
+
+//
+// Initialize an empty PCI topology cache.
+//
+VOID
+AmlPciTopologyCacheInitialize(
+    _Out_   AML_PCI_TOPOLOGY_CACHE* Cache,
+    _Inout_ AML_HEAP*               Heap
+    )
+{
+    *Cache = ( AML_PCI_TOPOLOGY_CACHE ){ .Heap = Heap };
+}
+
+//
+// Unlink and free all cached entries, entries that are still referenced are freed upon release of their last reference.
+//
+VOID
+AmlPciTopologyCacheRelease(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache
+    )
+{
+    AmlPciTopologyCacheInvalidate( Cache );
+    if( Cache->Buckets != NULL ) {
+        AmlHeapFree( Cache->Heap, Cache->Buckets );
+    }
+    Cache->Buckets = NULL;
+    Cache->BucketCount = 0;
+}
+
+//
+// Look up the cached topology of the given node, returns a new reference to the entry, or NULL if not cached.
+//
+_Success_( return != NULL )
+AML_PCI_TOPOLOGY_ENTRY*
+AmlPciTopologyCacheLookup(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache,
+    _In_    const VOID*             Node
+    )
+{
+    AML_PCI_TOPOLOGY_ENTRY* Entry;
+
+    Cache->Statistics.LookupCount += 1;
+    if( Cache->BucketCount == 0 ) {
+        return NULL;
+    }
+    for( Entry = Cache->Buckets[ AmlPciTopologyCacheBucketIndex( Cache, Node ) ]; Entry != NULL; Entry = Entry->Next ) {
+        if( Entry->Node == Node ) {
+            Entry->ReferenceCount += 1;
+            Cache->Statistics.HitCount += 1;
+            return Entry;
+        }
+    }
+    return NULL;
+}
+
+//
+// Insert the evaluated topology of the given node, taking ownership of the PCI information upon success.
+// Returns a new reference to the inserted entry.
+//
+_Success_( return != NULL )
+AML_PCI_TOPOLOGY_ENTRY*
+AmlPciTopologyCacheInsert(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE*    Cache,
+    _In_    const VOID*                Node,
+    _In_    const AML_PCI_INFORMATION* Info
+    )
+{
+    AML_PCI_TOPOLOGY_ENTRY* Entry;
+    SIZE_T                  BucketIndex;
+
+    //
+    // Make room for the new entry and allocate it.
+    //
+    if( AmlPciTopologyCacheGrow( Cache ) == AML_FALSE ) {
+        return NULL;
+    } else if( ( Entry = AmlHeapAllocate( Cache->Heap, sizeof( *Entry ) ) ) == NULL ) {
+        return NULL;
+    }
+
+    //
+    // Link the entry, the cache holds one reference, the caller receives the other.
+    //
+    BucketIndex = AmlPciTopologyCacheBucketIndex( Cache, Node );
+    *Entry = ( AML_PCI_TOPOLOGY_ENTRY ){
+        .Next           = Cache->Buckets[ BucketIndex ],
+        .Node           = Node,
+        .ReferenceCount = 2,
+        .Generation     = Cache->Generation,
+        .Info           = *Info,
+    };
+    Cache->Buckets[ BucketIndex ] = Entry;
+    Cache->EntryCount += 1;
+    Cache->Statistics.InsertCount += 1;
+    return Entry;
+}
+
+//
+// Release a reference to an entry returned by AmlPciTopologyCacheLookup or AmlPciTopologyCacheInsert.
+//
+VOID
+AmlPciTopologyCacheReleaseEntry(
+    _Inout_                AML_PCI_TOPOLOGY_CACHE* Cache,
+    _Inout_ _Post_invalid_ AML_PCI_TOPOLOGY_ENTRY* Entry
+    )
+{
+    if( --Entry->ReferenceCount == 0 ) {
+        AmlPciTopologyCacheDestroy( Cache, Entry );
+    }
+}
+
+//
+// Resolve the current address of the device of an entry, taking into account any PCI bridge links.
+// The resolved address is reused until the next address invalidation.
+//
+_Success_( return )
+BOOLEAN
+AmlPciTopologyCacheResolveAddress(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache,
+    _Inout_ AML_HOST_CONTEXT*       Host,
+    _Inout_ AML_PCI_TOPOLOGY_ENTRY* Entry,
+    _Out_   AML_PCI_SBDF_ADDRESS*   Address
+    )
+{
+    if( Entry->IsAddressResolved && ( Entry->AddressGeneration == Cache->AddressGeneration ) ) {
+        Cache->Statistics.AddressHitCount += 1;
+        *Address = Entry->ResolvedAddress;
+        return AML_TRUE;
+    }
+
+    //
+    // Read the current bus numbers of all bridges along the way, failures are not cached.
+    //
+    Cache->Statistics.AddressResolveCount += 1;
+    Entry->IsAddressResolved = AML_FALSE;
+    if( AmlPciResolveDeviceAddress( Host, &Entry->Info, &Entry->ResolvedAddress ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+    Entry->IsAddressResolved = AML_TRUE;
+    Entry->AddressGeneration = Cache->AddressGeneration;
+    *Address = Entry->ResolvedAddress;
+    return AML_TRUE;
+}
+
+//
+// Invalidate all cached topology (table loads, bus checks), all entries are unlinked and must be re-evaluated.
+// May also be called by the host after it has re-enumerated the PCI hierarchy itself.
+//
+VOID
+AmlPciTopologyCacheInvalidate(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache
+    )
+{
+    AML_PCI_TOPOLOGY_ENTRY* Entry;
+    SIZE_T                  i;
+
+    Cache->Generation += 1;
+    Cache->AddressGeneration += 1;
+    Cache->Statistics.InvalidationCount += 1;
+    for( i = 0; i < Cache->BucketCount; i++ ) {
+        while( ( Entry = Cache->Buckets[ i ] ) != NULL ) {
+            Cache->Buckets[ i ] = Entry->Next;
+            Entry->Next = NULL;
+            AmlPciTopologyCacheReleaseEntry( Cache, Entry );
+        }
+    }
+    Cache->EntryCount = 0;
+}
+
+//
+// Invalidate all resolved device addresses (writes to bridge bus-number registers), the evaluated topology is kept.
+// May also be called by the host after it has reprogrammed bridge bus numbers itself.
+//
+VOID
+AmlPciTopologyCacheInvalidateAddresses(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache
+    )
+{
+    Cache->AddressGeneration += 1;
+    Cache->Statistics.AddressInvalidationCount += 1;
+}
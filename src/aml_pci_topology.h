@@ -0,0 +1,143 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_heap.h"
+#include "aml_host.h"
+#include "aml_pci_info.h"
+
+//
+// Initial amount of hash buckets of a PCI topology cache, grown by doubling whenever the entry count exceeds it.
+//
+#define AML_PCI_TOPOLOGY_CACHE_MIN_BUCKET_COUNT 16
+
+//
+// Notify value signalling that the bus below the notified device must be re-enumerated (bus check).
+//
+#define AML_NOTIFY_VALUE_BUS_CHECK 0
+
+//
+// Cached PCI topology of a device node: evaluated segment/bus/device/function, and the bridge chain up to the root bus.
+// Entries are shared by all PCI regions declared under the same node, and stay alive as long as any region references them.
+// An invalidated entry is unlinked from the cache, its Generation no longer matches the cache, and regions re-evaluate it.
+//
+typedef struct _AML_PCI_TOPOLOGY_ENTRY {
+    struct _AML_PCI_TOPOLOGY_ENTRY* Next;              /* Hash bucket chain (linked entries only). */
+    const VOID*                     Node;              /* Namespace node key, never dereferenced. */
+    SIZE_T                          ReferenceCount;    /* Includes the reference held by the cache while linked. */
+    BOOLEAN                         IsAddressResolved;
+    UINT64                          Generation;        /* Cache topology generation at the time of evaluation. */
+    UINT64                          AddressGeneration; /* Cache address generation at the time ResolvedAddress was resolved. */
+    AML_PCI_INFORMATION             Info;              /* Owns the bridge list. */
+    AML_PCI_SBDF_ADDRESS            ResolvedAddress;
+} AML_PCI_TOPOLOGY_ENTRY;
+
+//
+// PCI topology cache statistics.
+//
+typedef struct _AML_PCI_TOPOLOGY_CACHE_STATISTICS {
+    UINT64 LookupCount;
+    UINT64 HitCount;
+    UINT64 InsertCount;
+    UINT64 AddressResolveCount;
+    UINT64 AddressHitCount;
+    UINT64 InvalidationCount;
+    UINT64 AddressInvalidationCount;
+} AML_PCI_TOPOLOGY_CACHE_STATISTICS;
+
+//
+// Namespace-wide cache of evaluated PCI device topology (used for PCI_Config and PCI_BAR_Target regions).
+// Evaluating the PCI information of a device walks and evaluates _ADR/_HID/_CID/_BBN/_SEG of all of its ancestors,
+// and resolving its final bus number reads the secondary bus register of every bridge along the way,
+// the cache performs both only once per device instead of once per region and once per access.
+// Topology is invalidated when a table is loaded, a bus check is notified, or a permanent node is released (Generation),
+// resolved addresses are additionally invalidated when a bridge bus-number register is written (AddressGeneration).
+//
+typedef struct _AML_PCI_TOPOLOGY_CACHE {
+    AML_HEAP*                         Heap;
+    AML_PCI_TOPOLOGY_ENTRY**          Buckets;
+    SIZE_T                            BucketCount;
+    SIZE_T                            EntryCount;
+    UINT64                            Generation;
+    UINT64                            AddressGeneration;
+    UINT64                            NodeReleaseCount; /* Namespace permanent node release count as of the last invalidation (maintained by the user). */
+    AML_PCI_TOPOLOGY_CACHE_STATISTICS Statistics;
+} AML_PCI_TOPOLOGY_CACHE;
+
+//
+// Initialize an empty PCI topology cache.
+//
+VOID
+AmlPciTopologyCacheInitialize(
+    _Out_   AML_PCI_TOPOLOGY_CACHE* Cache,
+    _Inout_ AML_HEAP*               Heap
+    );
+
+//
+// Unlink and free all cached entries, entries that are still referenced are freed upon release of their last reference.
+//
+VOID
+AmlPciTopologyCacheRelease(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache
+    );
+
+//
+// Look up the cached topology of the given node, returns a new reference to the entry, or NULL if not cached.
+//
+_Success_( return != NULL )
+AML_PCI_TOPOLOGY_ENTRY*
+AmlPciTopologyCacheLookup(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache,
+    _In_    const VOID*             Node
+    );
+
+//
+// Insert the evaluated topology of the given node, taking ownership of the PCI information upon success.
+// Returns a new reference to the inserted entry.
+//
+_Success_( return != NULL )
+AML_PCI_TOPOLOGY_ENTRY*
+AmlPciTopologyCacheInsert(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE*    Cache,
+    _In_    const VOID*                Node,
+    _In_    const AML_PCI_INFORMATION* Info
+    );
+
+//
+// Release a reference to an entry returned by AmlPciTopologyCacheLookup or AmlPciTopologyCacheInsert.
+//
+VOID
+AmlPciTopologyCacheReleaseEntry(
+    _Inout_                AML_PCI_TOPOLOGY_CACHE* Cache,
+    _Inout_ _Post_invalid_ AML_PCI_TOPOLOGY_ENTRY* Entry
+    );
+
+//
+// Resolve the current address of the device of an entry, taking into account any PCI bridge links.
+// The resolved address is reused until the next address invalidation.
+//
+_Success_( return )
+BOOLEAN
+AmlPciTopologyCacheResolveAddress(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache,
+    _Inout_ AML_HOST_CONTEXT*       Host,
+    _Inout_ AML_PCI_TOPOLOGY_ENTRY* Entry,
+    _Out_   AML_PCI_SBDF_ADDRESS*   Address
+    );
+
+//
+// Invalidate all cached topology (table loads, bus checks), all entries are unlinked and must be re-evaluated.
+// May also be called by the host after it has re-enumerated the PCI hierarchy itself.
+//
+VOID
+AmlPciTopologyCacheInvalidate(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache
+    );
+
+//
+// Invalidate all resolved device addresses (writes to bridge bus-number registers), the evaluated topology is kept.
+// May also be called by the host after it has reprogrammed bridge bus numbers itself.
+//
+VOID
+AmlPciTopologyCacheInvalidateAddresses(
+    _Inout_ AML_PCI_TOPOLOGY_CACHE* Cache
+    );
@@ -171,6 +171,149 @@
  #endif
 #endif
 
+//
+// Atomic memory access helpers, used for state shared with concurrent namespace readers (see aml_epoch.h).
+// Loads and stores are width-specific, the 32/64 variants access UINT32/UINT64 values, the SIZE and POINTER variants
+// access SIZE_T values and object pointers (AML_ATOMIC_LOAD_POINTER returns a VOID*).
+// AML_ATOMIC_LOAD* have acquire semantics, AML_ATOMIC_STORE* have release semantics, AML_ATOMIC_FENCE is a full barrier.
+// AML_ATOMIC_COMPARE_EXCHANGE64 returns the previous value (behaves like _InterlockedCompareExchange64 from MSVC).
+// Use the __atomic builtins if advertised through __has_builtin (GCC/clang).
+//
+#ifndef AML_ATOMIC_LOAD64
+ #ifdef __has_builtin
+  #if __has_builtin(__atomic_load_n) && __has_builtin(__atomic_store_n) && __has_builtin(__atomic_compare_exchange_n)
+   #define AML_ATOMIC_LOAD32(Pointer) __atomic_load_n((Pointer), __ATOMIC_ACQUIRE)
+   #define AML_ATOMIC_LOAD64(Pointer) __atomic_load_n((Pointer), __ATOMIC_ACQUIRE)
+   #define AML_ATOMIC_LOAD_SIZE(Pointer) __atomic_load_n((Pointer), __ATOMIC_ACQUIRE)
+   #define AML_ATOMIC_LOAD_POINTER(Pointer) __atomic_load_n((Pointer), __ATOMIC_ACQUIRE)
+   #define AML_ATOMIC_STORE32(Pointer, Value) __atomic_store_n((Pointer), (Value), __ATOMIC_RELEASE)
+   #define AML_ATOMIC_STORE64(Pointer, Value) __atomic_store_n((Pointer), (Value), __ATOMIC_RELEASE)
+   #define AML_ATOMIC_STORE_SIZE(Pointer, Value) __atomic_store_n((Pointer), (Value), __ATOMIC_RELEASE)
+   #define AML_ATOMIC_STORE_POINTER(Pointer, Value) __atomic_store_n((Pointer), (Value), __ATOMIC_RELEASE)
+   #define AML_ATOMIC_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+   #define AML_ATOMIC_COMPARE_EXCHANGE64(Pointer, Comparand, Desired) \
+    __sync_val_compare_and_swap((Pointer), (Comparand), (Desired))
+  #endif
+ #endif
+#endif
+
+//
+// Use the ISO volatile load/store intrinsics (plain accesses regardless of /volatile:ms) if this is an MSVC build,
+// ordered using a dmb ish barrier on ARM, and a compiler barrier on x86 (where plain loads/stores already have acquire/release semantics).
+//
+#if !defined(AML_ATOMIC_LOAD64) && defined(_MSC_VER)
+ #if defined(_M_ARM) || defined(_M_ARM64)
+  #define AML_ATOMIC_ORDER_BARRIER() __dmb(0xB)
+  #define AML_ATOMIC_FENCE() __dmb(0xB)
+ #elif defined(_M_X64)
+  #define AML_ATOMIC_ORDER_BARRIER() _ReadWriteBarrier()
+  #define AML_ATOMIC_FENCE() __faststorefence()
+ #else
+  #define AML_ATOMIC_ORDER_BARRIER() _ReadWriteBarrier()
+  #define AML_ATOMIC_FENCE() _mm_mfence()
+ #endif
+
+//
+// MSVC acquire load of a 32-bit value.
+//
+static
+__forceinline
+UINT32
+AmlAtomicLoad32(
+    _In_ const volatile UINT32* Pointer
+    )
+{
+    UINT32 Value;
+
+    Value = ( UINT32 )__iso_volatile_load32( ( const volatile __int32* )Pointer );
+    AML_ATOMIC_ORDER_BARRIER();
+    return Value;
+}
+
+//
+// MSVC acquire load of a 64-bit value.
+//
+static
+__forceinline
+UINT64
+AmlAtomicLoad64(
+    _In_ const volatile UINT64* Pointer
+    )
+{
+    UINT64 Value;
+
+    Value = ( UINT64 )__iso_volatile_load64( ( const volatile __int64* )Pointer );
+    AML_ATOMIC_ORDER_BARRIER();
+    return Value;
+}
+
+//
+// MSVC release store of a 32-bit value.
+//
+static
+__forceinline
+VOID
+AmlAtomicStore32(
+    _Out_ volatile UINT32* Pointer,
+    _In_  UINT32           Value
+    )
+{
+    AML_ATOMIC_ORDER_BARRIER();
+    __iso_volatile_store32( ( volatile __int32* )Pointer, ( __int32 )Value );
+}
+
+//
+// MSVC release store of a 64-bit value.
+//
+static
+__forceinline
+VOID
+AmlAtomicStore64(
+    _Out_ volatile UINT64* Pointer,
+    _In_  UINT64           Value
+    )
+{
+    AML_ATOMIC_ORDER_BARRIER();
+    __iso_volatile_store64( ( volatile __int64* )Pointer, ( __int64 )Value );
+}
+
+ #define AML_ATOMIC_LOAD32(Pointer) AmlAtomicLoad32((Pointer))
+ #define AML_ATOMIC_LOAD64(Pointer) AmlAtomicLoad64((Pointer))
+ #define AML_ATOMIC_STORE32(Pointer, Value) AmlAtomicStore32((Pointer), (Value))
+ #define AML_ATOMIC_STORE64(Pointer, Value) AmlAtomicStore64((Pointer), (Value))
+ #ifdef _WIN64
+  #define AML_ATOMIC_LOAD_SIZE(Pointer) ((SIZE_T)AmlAtomicLoad64((const volatile UINT64*)(Pointer)))
+  #define AML_ATOMIC_LOAD_POINTER(Pointer) ((VOID*)AmlAtomicLoad64((const volatile UINT64*)(Pointer)))
+  #define AML_ATOMIC_STORE_SIZE(Pointer, Value) AmlAtomicStore64((volatile UINT64*)(Pointer), (UINT64)(Value))
+  #define AML_ATOMIC_STORE_POINTER(Pointer, Value) AmlAtomicStore64((volatile UINT64*)(Pointer), (UINT64)(Value))
+ #else
+  #define AML_ATOMIC_LOAD_SIZE(Pointer) ((SIZE_T)AmlAtomicLoad32((const volatile UINT32*)(Pointer)))
+  #define AML_ATOMIC_LOAD_POINTER(Pointer) ((VOID*)AmlAtomicLoad32((const volatile UINT32*)(Pointer)))
+  #define AML_ATOMIC_STORE_SIZE(Pointer, Value) AmlAtomicStore32((volatile UINT32*)(Pointer), (UINT32)(Value))
+  #define AML_ATOMIC_STORE_POINTER(Pointer, Value) AmlAtomicStore32((volatile UINT32*)(Pointer), (UINT32)(Value))
+ #endif
+ #define AML_ATOMIC_COMPARE_EXCHANGE64(Pointer, Comparand, Desired) \
+  ((UINT64)_InterlockedCompareExchange64((volatile __int64*)(Pointer), (__int64)(Desired), (__int64)(Comparand)))
+#endif
+
+//
+// No supported atomic intrinsics, fall back to plain accesses.
+// Concurrent namespace readers are unsupported unless the host platform header provides these.
+//
+#ifndef AML_ATOMIC_LOAD64
+ #define AML_ATOMIC_LOAD32(Pointer) (*(Pointer))
+ #define AML_ATOMIC_LOAD64(Pointer) (*(Pointer))
+ #define AML_ATOMIC_LOAD_SIZE(Pointer) (*(Pointer))
+ #define AML_ATOMIC_LOAD_POINTER(Pointer) (*(Pointer))
+ #define AML_ATOMIC_STORE32(Pointer, Value) ((VOID)(*(Pointer) = (Value)))
+ #define AML_ATOMIC_STORE64(Pointer, Value) ((VOID)(*(Pointer) = (Value)))
+ #define AML_ATOMIC_STORE_SIZE(Pointer, Value) ((VOID)(*(Pointer) = (Value)))
+ #define AML_ATOMIC_STORE_POINTER(Pointer, Value) ((VOID)(*(Pointer) = (Value)))
+ #define AML_ATOMIC_FENCE() ((VOID)0)
+ #define AML_ATOMIC_COMPARE_EXCHANGE64(Pointer, Comparand, Desired) \
+  ((*(Pointer) == (Comparand)) ? ((*(Pointer) = (Desired)), (Comparand)) : *(Pointer))
+#endif
+
 //
 // Internal debugger fail/trap helper, use __builtin_trap if advertised as available (GCC/clang).
 //
@@ -0,0 +1,238 @@
+#include "aml_skip_index.h"
+
+//
+// Create an empty skip index for the given table code.
+// The table code must remain loaded for the entire lifetime of the index.
+//
+_Success_( return != NULL )
+AML_SKIP_INDEX*
+AmlSkipIndexCreate(
+    _Inout_ AML_HEAP*                  Heap,
+    _In_    const AML_NAMESPACE_STATE* Namespace,
+    _In_    const UINT8*               Data
+    )
+{
+    AML_SKIP_INDEX* Index;
+
+    //
+    // The entry array is lazily allocated upon the first recorded definition.
+    //
+    if( ( Index = AmlHeapAllocate( Heap, sizeof( *Index ) ) ) == NULL ) {
+        return NULL;
+    }
+    *Index = ( AML_SKIP_INDEX ){
+        .ParentHeap   = Heap,
+        .Data         = Data,
+        .ReleaseCount = Namespace->ReleaseCount,
+    };
+    return Index;
+}
+
+//
+// Release all entries and the index itself.
+//
+VOID
+AmlSkipIndexFree(
+    _Inout_opt_ _Post_invalid_ AML_SKIP_INDEX* Index
+    )
+{
+    if( Index == NULL ) {
+        return;
+    }
+
+    if( Index->Entries != NULL ) {
+        AmlHeapFree( Index->ParentHeap, Index->Entries );
+    }
+    AmlHeapFree( Index->ParentHeap, Index );
+}
+
+//
+// Grow the entry array to fit at least one more entry.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlSkipIndexGrow(
+    _Inout_ AML_SKIP_INDEX* Index
+    )
+{
+    AML_SKIP_INDEX_ENTRY* NewEntries;
+    SIZE_T                NewCapacity;
+
+    NewCapacity = ( ( Index->Capacity != 0 ) ? ( Index->Capacity * 2 ) : AML_SKIP_INDEX_MIN_CAPACITY );
+    if( NewCapacity > ( ( SIZE_T )-1 / sizeof( NewEntries[ 0 ] ) ) ) {
+        return AML_FALSE;
+    } else if( ( NewEntries = AmlHeapAllocate( Index->ParentHeap, ( NewCapacity * sizeof( NewEntries[ 0 ] ) ) ) ) == NULL ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Move existing entries to the new array.
+    //
+    if( Index->Entries != NULL ) {
+        AML_MEMCPY( NewEntries, Index->Entries, ( Index->Count * sizeof( NewEntries[ 0 ] ) ) );
+        AmlHeapFree( Index->ParentHeap, Index->Entries );
+    }
+    Index->Entries  = NewEntries;
+    Index->Capacity = NewCapacity;
+    return AML_TRUE;
+}
+
+//
+// Record a decoded named object definition of the given data block.
+// Only definitions with a single segment unprefixed name are recorded (resolved directly within the active scope),
+// entries must be recorded in increasing order of PkgStart, any other definitions are silently ignored.
+//
+VOID
+AmlSkipIndexRecord(
+    _Inout_opt_ AML_SKIP_INDEX*             Index,
+    _In_        const UINT8*                Data,
+    _In_        const AML_NAME_STRING*      Name,
+    _In_        const AML_SKIP_INDEX_ENTRY* Entry
+    )
+{
+    //
+    // Prefixed and multi-segment names may resolve to a node outside of the active scope,
+    // these definitions are always decoded and searched for again by the full pass.
+    //
+    if( ( Index == NULL ) || ( Data != Index->Data ) || ( Name->Prefix.Length != 0 ) || ( Name->SegmentCount != 1 ) ) {
+        return;
+    }
+
+    //
+    // Keep the entries sorted, a definition decoded more than once is only recorded the first time.
+    //
+    if( ( Index->Count != 0 ) && ( Entry->PkgStart <= Index->Entries[ Index->Count - 1 ].PkgStart ) ) {
+        return;
+    }
+
+    //
+    // Failure to grow the index isn't fatal, the remaining definitions are decoded again by the full pass.
+    //
+    if( Index->Count >= Index->Capacity ) {
+        if( AmlSkipIndexGrow( Index ) == AML_FALSE ) {
+            return;
+        }
+    }
+    Index->Entries[ Index->Count++ ] = *Entry;
+    Index->Statistics.EntryCount += 1;
+}
+
+//
+// Find the entry recorded at the given PkgStart offset, returns NULL if there is no such entry.
+//
+static
+AML_SKIP_INDEX_ENTRY*
+AmlSkipIndexFind(
+    _Inout_ AML_SKIP_INDEX* Index,
+    _In_    SIZE_T          PkgStart
+    )
+{
+    SIZE_T Low;
+    SIZE_T High;
+    SIZE_T Middle;
+
+    //
+    // Typical case, the full pass visits definitions in the same order that they were recorded in.
+    //
+    if( ( Index->NextLookup < Index->Count ) && ( Index->Entries[ Index->NextLookup ].PkgStart == PkgStart ) ) {
+        return &Index->Entries[ Index->NextLookup++ ];
+    }
+
+    //
+    // Binary search the sorted entries.
+    //
+    Low  = 0;
+    High = Index->Count;
+    while( Low < High ) {
+        Middle = ( Low + ( ( High - Low ) / 2 ) );
+        if( Index->Entries[ Middle ].PkgStart < PkgStart ) {
+            Low = ( Middle + 1 );
+        } else {
+            High = Middle;
+        }
+    }
+    if( ( Low >= Index->Count ) || ( Index->Entries[ Low ].PkgStart != PkgStart ) ) {
+        return NULL;
+    }
+    Index->NextLookup = ( Low + 1 );
+    return &Index->Entries[ Low ];
+}
+
+//
+// Check if the given node is a direct child of the given scope.
+//
+static
+BOOLEAN
+AmlSkipIndexIsScopeChild(
+    _In_ const AML_NAMESPACE_NODE*  Node,
+    _In_ const AML_NAMESPACE_SCOPE* Scope
+    )
+{
+    SIZE_T i;
+
+    if( ( Node->AbsolutePath.SegmentCount != ( Scope->AbsolutePath.SegmentCount + 1 ) )
+        || ( Node->PrefixHashes[ Scope->AbsolutePath.SegmentCount ] != Scope->AbsolutePathHash ) )
+    {
+        return AML_FALSE;
+    }
+    for( i = 0; i < Scope->AbsolutePath.SegmentCount; i++ ) {
+        if( Node->AbsolutePath.Segments[ i ].AsUInt32 != Scope->AbsolutePath.Segments[ i ].AsUInt32 ) {
+            return AML_FALSE;
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Lookup the recorded definition at the given PkgStart offset of the given data block.
+// Only returns the entry if the recorded node is still a pre-parsed node of the expected type,
+// located directly within the last active scope, and the definition was decoded within the same data window.
+//
+_Success_( return != NULL )
+const AML_SKIP_INDEX_ENTRY*
+AmlSkipIndexLookup(
+    _Inout_opt_ AML_SKIP_INDEX*            Index,
+    _In_        const AML_NAMESPACE_STATE* Namespace,
+    _In_        const UINT8*               Data,
+    _In_        SIZE_T                     PkgStart,
+    _In_        SIZE_T                     WindowEnd,
+    _In_        AML_OBJECT_TYPE            ObjectType
+    )
+{
+    AML_SKIP_INDEX_ENTRY* Entry;
+
+    //
+    // The decoder may have switched to a different block of code (method of another table, Load/LoadTable).
+    //
+    if( ( Index == NULL ) || ( Data != Index->Data ) ) {
+        return NULL;
+    }
+
+    //
+    // Recorded nodes may have been freed if any node has been released since the index was created.
+    //
+    if( ( Namespace->ReleaseCount != Index->ReleaseCount )
+        || ( ( Entry = AmlSkipIndexFind( Index, PkgStart ) ) == NULL ) )
+    {
+        Index->Statistics.MissCount += 1;
+        return NULL;
+    }
+
+    //
+    // The full pass must have decoded the definition exactly as the namespace pass did,
+    // and a search for the name from the active scope must yield the same pre-parsed node.
+    //
+    if( ( Entry->WindowEnd != WindowEnd )
+        || ( Entry->Node->IsPreParsed == AML_FALSE )
+        || ( Entry->Node->Object == NULL )
+        || ( Entry->Node->Object->Type != ObjectType )
+        || ( AmlSkipIndexIsScopeChild( Entry->Node, Namespace->ScopeLast ) == AML_FALSE ) )
+    {
+        Index->Statistics.MissCount += 1;
+        return NULL;
+    }
+
+    Index->Statistics.HitCount += 1;
+    return Entry;
+}
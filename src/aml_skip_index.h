@@ -0,0 +1,100 @@
+#pragma once
+
+#include "aml_platform.h"
+#include "aml_heap.h"
+#include "aml_data.h"
+#include "aml_namespace.h"
+
+//
+// Initial capacity of the entry array of a skip index.
+//
+#define AML_SKIP_INDEX_MIN_CAPACITY 64
+
+//
+// Decoded named object definition with a PkgLength-delimited body (Method, Device, Processor, PowerRes, ThermalZone),
+// as recorded by the namespace pass of a table load.
+//
+typedef struct _AML_SKIP_INDEX_ENTRY {
+    SIZE_T                      PkgStart;  /* Offset of the PkgLength following the opcode, entries are sorted by this offset. */
+    SIZE_T                      WindowEnd; /* DataLength of the data window that the definition was decoded within. */
+    SIZE_T                      CodeStart; /* Start of the TermList (method body) following the fixed operands. */
+    SIZE_T                      CodeSize;
+    struct _AML_NAMESPACE_NODE* Node;
+} AML_SKIP_INDEX_ENTRY;
+
+//
+// Skip index statistics, accumulated by the state for all loaded tables (see AML_STATE::SkipIndexStatistics).
+//
+typedef struct _AML_SKIP_INDEX_STATISTICS {
+    UINT64 EntryCount;
+    UINT64 HitCount;
+    UINT64 MissCount;
+} AML_SKIP_INDEX_STATISTICS;
+
+//
+// Instruction boundary and PkgLength index of a single table load.
+// The namespace pass records the operands of named object definitions that have already been decoded once,
+// allowing the full evaluation pass to jump straight past the name and fixed operands to the body of the definition,
+// and to reuse the pre-parsed node without another namespace search.
+// Entries are only trusted while no namespace node has been released since the index was created,
+// and while the pre-parsed node is still a direct child of the active scope.
+//
+typedef struct _AML_SKIP_INDEX {
+    AML_HEAP*                 ParentHeap;
+    const UINT8*              Data;
+    AML_SKIP_INDEX_ENTRY*     Entries;
+    SIZE_T                    Count;
+    SIZE_T                    Capacity;
+    SIZE_T                    NextLookup;   /* Entry following the last hit, lookups are typically performed in order. */
+    UINT64                    ReleaseCount; /* Namespace node release count at the time of creation. */
+    AML_SKIP_INDEX_STATISTICS Statistics;
+} AML_SKIP_INDEX;
+
+//
+// Create an empty skip index for the given table code.
+// The table code must remain loaded for the entire lifetime of the index.
+//
+_Success_( return != NULL )
+AML_SKIP_INDEX*
+AmlSkipIndexCreate(
+    _Inout_ AML_HEAP*                  Heap,
+    _In_    const AML_NAMESPACE_STATE* Namespace,
+    _In_    const UINT8*               Data
+    );
+
+//
+// Release all entries and the index itself.
+//
+VOID
+AmlSkipIndexFree(
+    _Inout_opt_ _Post_invalid_ AML_SKIP_INDEX* Index
+    );
+
+//
+// Record a decoded named object definition of the given data block.
+// Only definitions with a single segment unprefixed name are recorded (resolved directly within the active scope),
+// entries must be recorded in increasing order of PkgStart, any other definitions are silently ignored.
+//
+VOID
+AmlSkipIndexRecord(
+    _Inout_opt_ AML_SKIP_INDEX*             Index,
+    _In_        const UINT8*                Data,
+    _In_        const AML_NAME_STRING*      Name,
+    _In_        const AML_SKIP_INDEX_ENTRY* Entry
+    );
+
+//
+// Lookup the recorded definition at the given PkgStart offset of the given data block.
+// Only returns the entry if the recorded node is still a pre-parsed node of the expected type,
+// located directly within the last active scope, and the definition was decoded within the same data window.
+//
+_Success_( return != NULL )
+const AML_SKIP_INDEX_ENTRY*
+AmlSkipIndexLookup(
+    _Inout_opt_ AML_SKIP_INDEX*            Index,
+    _In_        const AML_NAMESPACE_STATE* Namespace,
+    _In_        const UINT8*               Data,
+    _In_        SIZE_T                     PkgStart,
+    _In_        SIZE_T                     WindowEnd,
+    _In_        AML_OBJECT_TYPE            ObjectType
+    );
@@ -2,6 +2,7 @@
 #include "aml_debug.h"
 #include "aml_eval.h"
 #include "aml_osi.h"
+#include "aml_namespace_image.h"
 
 //
 // Iterative namespace tree DFS traversal frame.
@@ -12,6 +13,30 @@ typedef struct _AML_NAMESPACE_TREE_DFS_FRAME {
     AML_NAMESPACE_TREE_NODE* NextChild;
 } AML_NAMESPACE_TREE_DFS_FRAME;
 
+//
+// Shared state of a parallel device initialization.
+// All fields are protected by the scheduler lock, which is also the blocking lock of all worker contexts,
+// so that only a single worker evaluates at a time, other workers only run while the evaluating worker blocks.
+//
+typedef struct _AML_DEVICE_INIT_SCHEDULER {
+    AML_STATE*                        State;
+    const AML_DEVICE_INIT_PARAMETERS* Parameters;
+    UINT64                            Lock;
+    AML_EXECUTION_CONTEXT**           FreeContexts;
+    SIZE_T                            FreeContextCount;
+    AML_DEVICE_INIT_STATISTICS        Statistics;
+    BOOLEAN                           Success;
+} AML_DEVICE_INIT_SCHEDULER;
+
+//
+// Parallel device initialization work item, initializes a single device and schedules the devices below it.
+//
+typedef struct _AML_DEVICE_INIT_WORK {
+    AML_DEVICE_INIT_SCHEDULER* Scheduler;
+    AML_NAMESPACE_TREE_NODE*   TreeNode;
+    UINT64                     PathTime; /* Critical path time up to and including the nearest device ancestor. */
+} AML_DEVICE_INIT_WORK;
+
 //
 // Initialize the AML decoder/evaluation state.
 // Note: The given allocator and host context must exist for the entire lifetime of the state.
@@ -34,6 +59,20 @@ AmlStateCreate(
     State->PassType        = AML_PASS_TYPE_FULL;
     State->IsIntegerSize64 = Parameters->Use64BitInteger;
     State->Host            = Parameters->Host;
+    State->Allocator       = Allocator;
+
+    //
+    // Optional evaluation features.
+    //
+    State->UseNameResolutionCache      = Parameters->UseNameResolutionCache;
+    State->UseNamespaceSkipIndex       = Parameters->UseNamespaceSkipIndex;
+    State->UseIdentificationCache      = ( Parameters->DisableIdentificationCache == AML_FALSE );
+    State->UseDirectSystemMemoryAccess = Parameters->UseDirectSystemMemoryAccess;
+    State->UseMappingCache             = Parameters->UseMappingCache;
+    State->RegionWindowThreshold       = Parameters->RegionWindowThreshold;
+    State->UsePciTopologyCache         = Parameters->UsePciTopologyCache;
+    State->UseIndexRegisterElision     = Parameters->UseIndexRegisterElision;
+    State->UseInPlaceTableLoad         = Parameters->UseInPlaceTableLoad;
 
     //
     // Set up the default operation region space access handlers.
@@ -51,15 +90,39 @@ AmlStateCreate(
     AmlArenaInitialize( &State->Arena, Allocator, ( 4096 * 8 ), 0 );
     AmlHeapInitialize( &State->Heap, &State->Arena );
 
+    //
+    // Initialize the SystemMemory region mapping cache.
+    //
+    AmlMappingCacheInitialize(
+        &State->MappingCache,
+        State->Host,
+        &State->Heap,
+        ( ( Parameters->MappingCacheIdleLimit != 0 ) ? Parameters->MappingCacheIdleLimit : AML_MAPPING_CACHE_DEFAULT_IDLE_LIMIT )
+    );
+
+    //
+    // Initialize the PCI region topology cache.
+    //
+    AmlPciTopologyCacheInitialize( &State->PciTopology, &State->Heap );
+
     //
     // Initialize per-method-call scope arena.
     //
     AmlArenaInitialize( &State->MethodScopeArena, Allocator, 4096, 0 );
 
+    //
+    // Initialize evaluation frame stack arena and its memory budget.
+    //
+    AmlArenaInitialize( &State->EvalFrameArena, Allocator, 4096, 0 );
+    State->EvalFrameStackMaxSize = Parameters->MaxFrameStackSize;
+    if( State->EvalFrameStackMaxSize == 0 ) {
+        State->EvalFrameStackMaxSize = AML_BUILD_DEFAULT_FRAME_STACK_SIZE;
+    }
+
     //
     // Initialize namespace state.
     //
-    AmlNamespaceStateInitialize( &State->Namespace, Allocator, &State->Heap );
+    AmlNamespaceStateInitialize( &State->Namespace, Allocator, &State->Heap, Parameters->NamespaceCapacityHint );
 
     //
     // Initialize snapshot state stack arena.
@@ -100,15 +163,25 @@ AmlStateFree(
     )
 {
     //
-    // Release all allocated namespace state memory.
+    // Release all allocated namespace state memory, and the base namespace shared with clones, all clones must have already been freed.
     //
     AmlNamespaceStateRelease( &State->Namespace );
+    if( State->CloneBase != NULL ) {
+        AmlNamespaceBaseRelease( State->CloneBase );
+    }
+
+    //
+    // Unmap all remaining cached region mappings and free the cached PCI topology, all region objects have been released by now.
+    //
+    AmlMappingCacheRelease( &State->MappingCache );
+    AmlPciTopologyCacheRelease( &State->PciTopology );
 
     //
     // Release all allocated state memory.
     //
     AmlArenaRelease( &State->StateSnapshotArena );
     AmlArenaRelease( &State->MethodScopeArena );
+    AmlArenaRelease( &State->EvalFrameArena );
     AmlArenaRelease( &State->Arena );
 
     //
@@ -117,6 +190,157 @@ AmlStateFree(
     AML_MEMSET( State, 0, sizeof( *State ) );
 }
 
+//
+// Freeze the namespace of a template state, capturing everything needed by AmlStateClone.
+// The template must have loaded all of its tables, later changes to the template aren't visible to any clones.
+// Must complete before the first AmlStateClone of the template, and must not be called concurrently with it,
+// calling it again for an already frozen template has no effect.
+//
+_Success_( return )
+BOOLEAN
+AmlStateFreezeTemplate(
+    _Inout_ AML_STATE* Template
+    )
+{
+    //
+    // Capture the namespace of the template.
+    // The image is produced without any tables, it holds the code of all methods, and outlives any tables of the template.
+    //
+    if( Template->CloneImage == NULL ) {
+        if( AmlNamespaceImageBuild( Template, NULL, 0, &Template->CloneImage, &Template->CloneImageSize ) == AML_FALSE ) {
+            AML_DEBUG_ERROR( Template, "Error: Failed to capture the namespace of the template state.\n" );
+            return AML_FALSE;
+        }
+    }
+
+    //
+    // Create the base namespace of the image, shared by all clones using UseSharedNamespace.
+    //
+    if( Template->CloneBase == NULL ) {
+        if( ( Template->CloneBase = AmlHeapAllocate( &Template->Heap, sizeof( *Template->CloneBase ) ) ) == NULL ) {
+            return AML_FALSE;
+        } else if( AmlNamespaceBaseCreate( Template->CloneBase, Template, Template->CloneImage, Template->CloneImageSize, NULL, 0 ) == AML_FALSE ) {
+            AML_DEBUG_ERROR( Template, "Error: Failed to create the shared namespace of the template state.\n" );
+            AmlHeapFree( &Template->Heap, Template->CloneBase );
+            Template->CloneBase = NULL;
+            return AML_FALSE;
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Create a new state holding a copy of the namespace of a template state, instead of loading the same tables again.
+// The template must have been frozen using AmlStateFreezeTemplate, clones of templates that have completed their initial load
+// are complete as well, and consider all devices initialized (and _REG methods called) by the template as such.
+// Method code, names, and the frozen namespace are shared with the template, the template must not be freed before all of its clones.
+// The template itself isn't modified, clones of the same frozen template may be created concurrently.
+// The integer size of the clone is always that of the template, the remaining parameters apply to the clone.
+// Clones created using UseSharedNamespace don't hold their own copy of the static named data of the template (Name objects),
+// they use the objects of a base namespace owned by the template, and copy an object only before modifying or referencing it.
+//
+_Success_( return )
+BOOLEAN
+AmlStateClone(
+    _In_  const AML_STATE*            Template,
+    _Out_ AML_STATE*                  Clone,
+    _In_  AML_ALLOCATOR               Allocator,
+    _In_  const AML_STATE_PARAMETERS* Parameters
+    )
+{
+    AML_STATE_PARAMETERS              CloneParameters;
+    const AML_NAMESPACE_IMAGE_HEADER* Header;
+
+    //
+    // Clones only read the namespace captured by freezing the template.
+    //
+    if( ( Template->CloneImage == NULL ) || ( Template->CloneBase == NULL ) ) {
+        AML_DEBUG_ERROR( Template, "Error: The template state must be frozen before cloning it.\n" );
+        return AML_FALSE;
+    }
+
+    //
+    // Create the clone, presized to hold all nodes of the template.
+    //
+    Header = Template->CloneImage;
+    CloneParameters = *Parameters;
+    CloneParameters.Use64BitInteger = Template->IsIntegerSize64;
+    if( CloneParameters.NamespaceCapacityHint == 0 ) {
+        CloneParameters.NamespaceCapacityHint = Header->NodeCount;
+    }
+    if( AmlStateCreate( Clone, Allocator, &CloneParameters ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Create the predefined namespaces and objects of the clone itself (native methods, global lock),
+    // and recreate the remaining namespace of the template on top of them.
+    // The namespace tree of a complete template is linked exactly as it is within the template.
+    //
+    if( AmlCreatePredefinedNamespaces( Clone ) == AML_FALSE ) {
+        AmlStateFree( Clone );
+        return AML_FALSE;
+    }
+    AmlCreatePredefinedObjects( Clone );
+    if( Parameters->UseSharedNamespace ) {
+        if( AmlNamespaceImageLoadShared( Clone, Template->CloneBase ) == AML_FALSE ) {
+            AmlStateFree( Clone );
+            return AML_FALSE;
+        }
+        Clone->SharedBase = Template->CloneBase;
+    } else if( AmlNamespaceImageLoad( Clone, Template->CloneImage, Template->CloneImageSize, NULL, 0 ) == AML_FALSE ) {
+        AmlStateFree( Clone );
+        return AML_FALSE;
+    }
+    Clone->SharedImageSize = Template->CloneImageSize;
+
+    //
+    // Complete the initial load of the clone if the template has done so,
+    // the device initialization state of the template has been restored, devices aren't initialized again.
+    //
+    if( Template->IsInitialLoadComplete ) {
+        if( AmlCompleteInitialLoad( Clone, AML_FALSE ) == AML_FALSE ) {
+            AmlStateFree( Clone );
+            return AML_FALSE;
+        }
+    }
+    return AML_TRUE;
+}
+
+//
+// Query the memory usage of a state, distinguishing memory private to the state from template memory shared with other clones.
+//
+VOID
+AmlStateQueryMemoryUsage(
+    _In_  const AML_STATE*        State,
+    _Out_ AML_STATE_MEMORY_USAGE* Usage
+    )
+{
+    *Usage = ( AML_STATE_MEMORY_USAGE ){
+        .SharedObjectCount     = State->Namespace.SharedObjectCount,
+        .PrivatizedObjectCount = State->Namespace.PrivatizedObjectCount,
+    };
+
+    //
+    // All state memory is allocated by the arenas of the state and its namespace.
+    //
+    Usage->PrivateSize += AmlArenaQueryAllocatedSize( &State->Arena );
+    Usage->PrivateSize += AmlArenaQueryAllocatedSize( &State->MethodScopeArena );
+    Usage->PrivateSize += AmlArenaQueryAllocatedSize( &State->EvalFrameArena );
+    Usage->PrivateSize += AmlArenaQueryAllocatedSize( &State->StateSnapshotArena );
+    Usage->PrivateSize += AmlArenaQueryAllocatedSize( &State->Namespace.PermanentArena );
+    Usage->PrivateSize += AmlArenaQueryAllocatedSize( &State->Namespace.TempArena );
+    Usage->PrivateSize += AmlArenaQueryAllocatedSize( &State->Namespace.ScopeArena );
+
+    //
+    // Clones use the names and method code of the template image in place, and the objects of the shared base namespace.
+    //
+    Usage->SharedSize = State->SharedImageSize;
+    if( State->SharedBase != NULL ) {
+        Usage->SharedSize += AmlArenaQueryAllocatedSize( &State->SharedBase->Arena );
+    }
+}
+
 //
 // Create a namespace.
 //
@@ -409,6 +633,29 @@ AmlIsObjectScopeCandidate(
     return AML_FALSE;
 }
 
+//
+// Returns AML_TRUE if the given object is of a spec-designated _INI object type.
+//
+static
+BOOLEAN
+AmlIsObjectDevice(
+    _In_opt_ const AML_OBJECT* Object
+    )
+{
+    if( Object != NULL ) {
+        switch( Object->Type ) {
+        case AML_OBJECT_TYPE_DEVICE:
+        case AML_OBJECT_TYPE_PROCESSOR:
+        case AML_OBJECT_TYPE_THERMAL_ZONE:
+            return AML_TRUE;
+        default:
+            break;
+        }
+    }
+
+    return AML_FALSE;
+}
+
 //
 // Call the _INI function for a single device object if allowed by the _STA value.
 //
@@ -451,12 +698,7 @@ AmlInitializeDevice(
     // special handlers like \_INI and \_SB_._INI must be called unconditionally elsewhere,
     // as they don't require the same considerations as a regular device in regards to _STA behavior.
     //
-    switch( NsNode->Object->Type ) {
-    case AML_OBJECT_TYPE_DEVICE:
-    case AML_OBJECT_TYPE_PROCESSOR:
-    case AML_OBJECT_TYPE_THERMAL_ZONE:
-        break;
-    default:
+    if( AmlIsObjectDevice( NsNode->Object ) == AML_FALSE ) {
         return AML_TRUE;
     }
 
@@ -499,6 +741,41 @@ AmlInitializeDevice(
     return AML_TRUE;
 }
 
+//
+// Unconditionally call the special root \\_INI and \\_SB_._INI initializers (if present and not yet called).
+//
+static
+VOID
+AmlInitializeRootDevices(
+    _Inout_ AML_STATE* State
+    )
+{
+    AML_NAMESPACE_NODE* NsIniNode;
+
+    if( AmlNamespaceSearchZ( &State->Namespace, NULL, "\\_INI", 0, &NsIniNode ) ) {
+        if( ( NsIniNode->Object != NULL )
+            && ( NsIniNode->Object->Type == AML_OBJECT_TYPE_METHOD )
+            && ( NsIniNode->Object->IsInitializedDevice == AML_FALSE ) )
+        {
+            if( AmlMethodInvoke( State, NsIniNode->Object, 0, NULL, 0, NULL ) == AML_FALSE ) {
+                AML_DEBUG_ERROR( State, "Error: Method call failed for special root \\_INI initializer.\n" );
+            }
+            NsIniNode->Object->IsInitializedDevice = AML_TRUE;
+        }
+    }
+    if( AmlNamespaceSearchZ( &State->Namespace, NULL, "\\_SB_._INI", 0, &NsIniNode ) ) {
+        if( ( NsIniNode->Object != NULL )
+            && ( NsIniNode->Object->Type == AML_OBJECT_TYPE_METHOD )
+            && ( NsIniNode->Object->IsInitializedDevice == AML_FALSE ) )
+        {
+            if( AmlMethodInvoke( State, NsIniNode->Object, 0, NULL, 0, NULL ) == AML_FALSE ) {
+                AML_DEBUG_ERROR( State, "Error: Method call failed for special root \\_SB_._INI initializer.\n" );
+            }
+            NsIniNode->Object->IsInitializedDevice = AML_TRUE;
+        }
+    }
+}
+
 //
 // Call the _INI methods for all functioning devices that advertise their presence through _STA.
 // CallRootInitializers determines if the unconditional root \_INI and \_SB_._INI methods
@@ -517,7 +794,6 @@ AmlInitializeDevices(
     SIZE_T                        StackTail;
     AML_NAMESPACE_TREE_DFS_FRAME* Frame;
     AML_NAMESPACE_NODE*           NsNode;
-    AML_NAMESPACE_NODE*           NsIniNode;
     BOOLEAN                       SkipChildren;
 
     //
@@ -531,28 +807,7 @@ AmlInitializeDevices(
     // Call the root _INI methods if desired by the user (not strictly spec compliant).
     //
     if( CallRootInitializers ) {
-        if( AmlNamespaceSearchZ( &State->Namespace, NULL, "\\_INI", 0, &NsIniNode ) ) {
-            if( ( NsIniNode->Object != NULL )
-                && ( NsIniNode->Object->Type == AML_OBJECT_TYPE_METHOD )
-                && ( NsIniNode->Object->IsInitializedDevice == AML_FALSE ) )
-            {
-                if( AmlMethodInvoke( State, NsIniNode->Object, 0, NULL, 0, NULL ) == AML_FALSE ) {
-                    AML_DEBUG_ERROR( State, "Error: Method call failed for special root \\_INI initializer.\n" );
-                }
-                NsIniNode->Object->IsInitializedDevice = AML_TRUE;
-            }
-        }
-        if( AmlNamespaceSearchZ( &State->Namespace, NULL, "\\_SB_._INI", 0, &NsIniNode ) ) {
-            if( ( NsIniNode->Object != NULL )
-                && ( NsIniNode->Object->Type == AML_OBJECT_TYPE_METHOD )
-                && ( NsIniNode->Object->IsInitializedDevice == AML_FALSE ) )
-            {
-                if( AmlMethodInvoke( State, NsIniNode->Object, 0, NULL, 0, NULL ) == AML_FALSE ) {
-                    AML_DEBUG_ERROR( State, "Error: Method call failed for special root \\_SB_._INI initializer.\n" );
-                }
-                NsIniNode->Object->IsInitializedDevice = AML_TRUE;
-            }
-        }
+        AmlInitializeRootDevices( State );
     }
 
     //
@@ -641,6 +896,373 @@ AmlInitializeDevices(
     return AML_TRUE;
 }
 
+static
+VOID
+AmlInitializeDevicesWorkRoutine(
+    _Inout_ VOID* WorkContext
+    );
+
+//
+// Queue a work item to initialize the device of the given tree node, and schedule all devices below it.
+// Must be called with the scheduler lock held.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlInitializeDevicesSubmit(
+    _Inout_ AML_DEVICE_INIT_SCHEDULER* Scheduler,
+    _In_    AML_NAMESPACE_TREE_NODE*   TreeNode,
+    _In_    UINT64                     PathTime
+    )
+{
+    AML_DEVICE_INIT_WORK*  Work;
+    const AML_WORKER_POOL* Pool;
+
+    Work = AmlHeapAllocate( &Scheduler->State->Heap, sizeof( *Work ) );
+    if( Work == NULL ) {
+        return AML_FALSE;
+    }
+    *Work = ( AML_DEVICE_INIT_WORK ){ .Scheduler = Scheduler, .TreeNode = TreeNode, .PathTime = PathTime };
+    Pool = Scheduler->Parameters->Pool;
+    if( Pool->Submit( Pool->Context, AmlInitializeDevicesWorkRoutine, Work ) == AML_FALSE ) {
+        AmlHeapFree( &Scheduler->State->Heap, Work );
+        return AML_FALSE;
+    }
+    return AML_TRUE;
+}
+
+//
+// Initialize the device of a work item (if any), then traverse its subtree,
+// submitting a new work item for every device found below it, and traversing through all other objects inline.
+// Must be called from within an entered execution context.
+//
+static
+VOID
+AmlInitializeDevicesWork(
+    _Inout_ AML_DEVICE_INIT_SCHEDULER* Scheduler,
+    _In_    const AML_DEVICE_INIT_WORK* Work
+    )
+{
+    AML_STATE*                    State;
+    AML_DEVICE_INIT_STATISTICS*   Statistics;
+    AML_NAMESPACE_NODE*           NsNode;
+    UINT64                        StartTime;
+    UINT64                        InitTime;
+    UINT64                        PathTime;
+    BOOLEAN                       SkipChildren;
+    AML_ARENA_SNAPSHOT            TempSnapshot;
+    AML_NAMESPACE_TREE_DFS_FRAME* Stack;
+    SIZE_T                        StackTail;
+    AML_NAMESPACE_TREE_DFS_FRAME* Frame;
+    AML_NAMESPACE_TREE_NODE*      Child;
+
+    //
+    // Initialize the device of the work item, and record its timing.
+    // The parent device has already been fully initialized before this work item was submitted.
+    //
+    State = Scheduler->State;
+    PathTime = Work->PathTime;
+    SkipChildren = AML_FALSE;
+    if( Work->TreeNode != &State->Namespace.TreeRoot ) {
+        NsNode = AML_CONTAINING_RECORD( Work->TreeNode, AML_NAMESPACE_NODE, TreeEntry );
+        if( AmlIsObjectDevice( NsNode->Object ) ) {
+            StartTime = AmlHostMonotonicTimer( State->Host );
+            Statistics = &Scheduler->Statistics;
+            if( AmlInitializeDevice( State, NsNode, &SkipChildren ) == AML_FALSE ) {
+                AML_DEBUG_ERROR( State, "Error: Device initialization failed for node: \"" );
+                AmlDebugPrintNameString( State, AML_DEBUG_LEVEL_ERROR, &NsNode->AbsolutePath );
+                AML_DEBUG_ERROR( State, "\"\n" );
+                Statistics->FailedDeviceCount += 1;
+            }
+            InitTime = ( AmlHostMonotonicTimer( State->Host ) - StartTime );
+            PathTime += InitTime;
+            Statistics->DeviceCount      += 1;
+            Statistics->TotalTime        += InitTime;
+            Statistics->CriticalPathTime  = AML_MAX( Statistics->CriticalPathTime, PathTime );
+            if( Scheduler->Parameters->TimingRoutine != NULL ) {
+                Scheduler->Parameters->TimingRoutine(
+                    Scheduler->Parameters->TimingContext,
+                    State,
+                    NsNode,
+                    InitTime,
+                    PathTime
+                );
+            }
+        }
+    }
+
+    //
+    // If the device wasn't functional, don't call initializers for any children.
+    //
+    if( SkipChildren ) {
+        return;
+    }
+
+    //
+    // Allocate a pending visit stack for the traversal of all non-device objects below the work item.
+    //
+    TempSnapshot = AmlArenaSnapshot( &State->Namespace.TempArena );
+    Stack = AmlArenaAllocate( &State->Namespace.TempArena, ( sizeof( Stack[ 0 ] ) * State->Namespace.TreeMaxDepth ) );
+    if( Stack == NULL ) {
+        Scheduler->Success = AML_FALSE;
+        return;
+    }
+    StackTail = 0;
+    Stack[ StackTail++ ] = ( AML_NAMESPACE_TREE_DFS_FRAME ){
+        .Node      = Work->TreeNode,
+        .NextChild = Work->TreeNode->ChildFirst
+    };
+
+    //
+    // Visit all children, devices are initialized by their own work items (interleaved with their siblings whenever one blocks),
+    // other objects are traversed through to find the devices below them.
+    //
+    while( StackTail != 0 ) {
+        Frame = &Stack[ StackTail - 1 ];
+        if( ( Child = Frame->NextChild ) == NULL ) {
+            StackTail -= 1;
+            continue;
+        }
+        Frame->NextChild = Child->Next;
+
+        //
+        // Submit a new work item for child devices, fall back to initializing the subtree of the device inline.
+        //
+        NsNode = AML_CONTAINING_RECORD( Child, AML_NAMESPACE_NODE, TreeEntry );
+        if( AmlIsObjectDevice( NsNode->Object ) ) {
+            if( AmlInitializeDevicesSubmit( Scheduler, Child, PathTime ) == AML_FALSE ) {
+                if( AmlInitializeDevices( State, Child, AML_FALSE ) == AML_FALSE ) {
+                    Scheduler->Success = AML_FALSE;
+                }
+            }
+            continue;
+        }
+
+        //
+        // This should never happen unless the tree is somehow out of date or invalid (or the traversal algorithm is broken).
+        //
+        if( StackTail >= State->Namespace.TreeMaxDepth ) {
+            AML_DEBUG_PANIC( State, "Fatal: Namespace node visit stack size exceeded maximum tree depth!" );
+            Scheduler->Success = AML_FALSE;
+            break;
+        }
+        Stack[ StackTail++ ] = ( AML_NAMESPACE_TREE_DFS_FRAME ){
+            .Node      = Child,
+            .NextChild = Child->ChildFirst
+        };
+    }
+
+    //
+    // Rollback temporary visit stack allocations.
+    //
+    AmlArenaSnapshotRollback( &State->Namespace.TempArena, &TempSnapshot );
+}
+
+//
+// Worker pool routine of a parallel device initialization work item.
+// Claims a free execution context for the duration of the work item,
+// there is always a free context, as at most WorkerCount work items run concurrently.
+//
+static
+VOID
+AmlInitializeDevicesWorkRoutine(
+    _Inout_ VOID* WorkContext
+    )
+{
+    AML_DEVICE_INIT_WORK*      Work;
+    AML_DEVICE_INIT_SCHEDULER* Scheduler;
+    AML_STATE*                 State;
+    AML_EXECUTION_CONTEXT*     Context;
+
+    Work = WorkContext;
+    Scheduler = Work->Scheduler;
+    State = Scheduler->State;
+
+    //
+    // Wait for the scheduler lock, the work item can't be backed out of at this point.
+    //
+    if( AmlHostMutexAcquire( State->Host, Scheduler->Lock, 0xFFFF ) != AML_WAIT_STATUS_SUCCESS ) {
+        AML_DEBUG_PANIC( State, "Fatal: Failed to acquire the device initialization scheduler lock!" );
+        return;
+    }
+
+    //
+    // Claim a free execution context and enter it.
+    //
+    Context = NULL;
+    if( Scheduler->FreeContextCount != 0 ) {
+        Context = Scheduler->FreeContexts[ --Scheduler->FreeContextCount ];
+        if( AmlExecutionContextEnter( Context ) == AML_FALSE ) {
+            Scheduler->FreeContexts[ Scheduler->FreeContextCount++ ] = Context;
+            Context = NULL;
+        }
+    }
+
+    //
+    // Process the work item (or record its failure), and release it back to the shared heap while still within the context.
+    //
+    if( Context != NULL ) {
+        AmlInitializeDevicesWork( Scheduler, Work );
+        AmlHeapFree( &State->Heap, Work );
+        AmlExecutionContextLeave( Context );
+        Scheduler->FreeContexts[ Scheduler->FreeContextCount++ ] = Context;
+    } else {
+        AML_DEBUG_ERROR( State, "Error: No execution context available for a device initialization work item.\n" );
+        Scheduler->Success = AML_FALSE;
+    }
+    AmlHostMutexRelease( State->Host, Scheduler->Lock );
+}
+
+//
+// Run a parallel device initialization starting at the given root work item, the caller must not be within an entered context.
+// Creates an execution context for every worker, bound to the scheduler lock,
+// and waits for all transitively submitted work items to finish.
+// Returns AML_FALSE if the root work item couldn't be submitted, it must then be freed by the caller.
+//
+_Success_( return )
+static
+BOOLEAN
+AmlInitializeDevicesRun(
+    _Inout_ AML_DEVICE_INIT_SCHEDULER* Scheduler,
+    _Out_   AML_EXECUTION_CONTEXT*     Contexts,
+    _Inout_ AML_DEVICE_INIT_WORK*      RootWork
+    )
+{
+    AML_STATE*             State;
+    const AML_WORKER_POOL* Pool;
+    SIZE_T                 ContextCount;
+    UINT64                 StartTime;
+    BOOLEAN                IsRootSubmitted;
+
+    State = Scheduler->State;
+    Pool = Scheduler->Parameters->Pool;
+    if( AmlHostMutexCreate( State->Host, &Scheduler->Lock ) == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // Initialize a free execution context for every worker, all bound to the scheduler lock.
+    //
+    for( ContextCount = 0; ContextCount < Pool->WorkerCount; ContextCount++ ) {
+        if( AmlExecutionContextInitialize( &Contexts[ ContextCount ], State ) == AML_FALSE ) {
+            break;
+        }
+        Contexts[ ContextCount ].BlockingLock    = Scheduler->Lock;
+        Contexts[ ContextCount ].HasBlockingLock = AML_TRUE;
+        Scheduler->FreeContexts[ Scheduler->FreeContextCount++ ] = &Contexts[ ContextCount ];
+    }
+
+    //
+    // Submit the root work item, and wait for all transitively submitted work items to finish.
+    //
+    IsRootSubmitted = AML_FALSE;
+    if( ContextCount == Pool->WorkerCount ) {
+        StartTime = AmlHostMonotonicTimer( State->Host );
+        IsRootSubmitted = Pool->Submit( Pool->Context, AmlInitializeDevicesWorkRoutine, RootWork );
+        if( IsRootSubmitted ) {
+            Pool->Wait( Pool->Context );
+        }
+        Scheduler->Statistics.ElapsedTime = ( AmlHostMonotonicTimer( State->Host ) - StartTime );
+    }
+
+    //
+    // Free all worker contexts.
+    //
+    while( ContextCount != 0 ) {
+        AmlExecutionContextFree( &Contexts[ --ContextCount ] );
+    }
+    AmlHostMutexFree( State->Host, Scheduler->Lock );
+    return IsRootSubmitted;
+}
+
+//
+// Call the _INI methods for all functioning devices that advertise their presence through _STA (see AmlInitializeDevices),
+// sibling subtrees are scheduled as separate work items on the given worker pool, each worker using its own execution context.
+// A device is only initialized after its parent, and its _STA is always evaluated before its _INI.
+// AML is not evaluated in parallel: the workers are serialized by a scheduler lock, which a worker only releases while it blocks
+// (Sleep, Stall, Wait, and Acquire or serialized method entry of an owned mutex), so only the blocking waits of subtrees overlap.
+// Devices that fail to initialize are reported like AmlInitializeDevices does (debug log), and counted in the statistics.
+// The caller may be within an entered execution context, which is suspended until all devices have been initialized.
+//
+_Success_( return )
+BOOLEAN
+AmlInitializeDevicesParallel(
+    _Inout_   AML_STATE*                        State,
+    _Inout_   AML_NAMESPACE_TREE_NODE*          StartTreeNode,
+    _In_      BOOLEAN                           CallRootInitializers,
+    _In_      const AML_DEVICE_INIT_PARAMETERS* Parameters,
+    _Out_opt_ AML_DEVICE_INIT_STATISTICS*       Statistics
+    )
+{
+    AML_DEVICE_INIT_SCHEDULER Scheduler;
+    AML_EXECUTION_CONTEXT*    Contexts;
+    AML_EXECUTION_CONTEXT*    CallerContext;
+    AML_DEVICE_INIT_WORK*     RootWork;
+    SIZE_T                    WorkerCount;
+
+    //
+    // The namespace tree must have been built for the start node.
+    //
+    if( StartTreeNode->IsPresent == AML_FALSE ) {
+        return AML_FALSE;
+    }
+
+    //
+    // The root initializers must run before all other devices, call them serially.
+    //
+    if( CallRootInitializers ) {
+        AmlInitializeRootDevices( State );
+    }
+
+    //
+    // Allocate an execution context for every worker, and the root work item,
+    // while the caller is still within its context (or is the only user of the state).
+    //
+    Scheduler = ( AML_DEVICE_INIT_SCHEDULER ){ .State = State, .Parameters = Parameters, .Success = AML_TRUE };
+    WorkerCount = AML_MAX( Parameters->Pool->WorkerCount, 1 );
+    Contexts = AmlHeapAllocate( &State->Heap, ( sizeof( Contexts[ 0 ] ) * WorkerCount ) );
+    Scheduler.FreeContexts = AmlHeapAllocate( &State->Heap, ( sizeof( Scheduler.FreeContexts[ 0 ] ) * WorkerCount ) );
+    RootWork = AmlHeapAllocate( &State->Heap, sizeof( *RootWork ) );
+
+    //
+    // Suspend the caller's context (if any) while the workers run.
+    // The root work item is freed by its work routine once submitted.
+    //
+    if( ( Parameters->Pool->WorkerCount != 0 )
+        && ( Contexts != NULL )
+        && ( Scheduler.FreeContexts != NULL )
+        && ( RootWork != NULL ) )
+    {
+        *RootWork = ( AML_DEVICE_INIT_WORK ){ .Scheduler = &Scheduler, .TreeNode = StartTreeNode, .PathTime = 0 };
+        CallerContext = AmlExecutionContextSuspend( State );
+        if( AmlInitializeDevicesRun( &Scheduler, Contexts, RootWork ) ) {
+            RootWork = NULL;
+        } else {
+            Scheduler.Success = AML_FALSE;
+        }
+        AmlExecutionContextResume( CallerContext );
+    } else {
+        Scheduler.Success = AML_FALSE;
+    }
+
+    //
+    // Release all scheduler allocations back to the shared heap.
+    //
+    if( RootWork != NULL ) {
+        AmlHeapFree( &State->Heap, RootWork );
+    }
+    if( Scheduler.FreeContexts != NULL ) {
+        AmlHeapFree( &State->Heap, Scheduler.FreeContexts );
+    }
+    if( Contexts != NULL ) {
+        AmlHeapFree( &State->Heap, Contexts );
+    }
+    if( Statistics != NULL ) {
+        *Statistics = Scheduler.Statistics;
+    }
+    return Scheduler.Success;
+}
+
 //
 // Complete the initial load, build the hierarchical namespace tree, initialize all device objects.
 //
@@ -1024,6 +1646,27 @@ AmlRegisterRegionSpaceAccessHandler(
     return AML_TRUE;
 }
 
+//
+// Attempt to register an optional vectored access handler alongside the regular access handler of a region-space,
+// used to service multi-word field accesses in a single call (see AML_REGION_ACCESS_VECTOR_ROUTINE).
+// The vectored handler receives the UserContext of the regular handler, and is removed upon (re-)registration of the regular handler.
+// Passing a NULL routine removes the vectored handler, all accesses are then split into regular handler calls.
+//
+_Success_( return )
+BOOLEAN
+AmlRegisterRegionSpaceVectorAccessHandler(
+    _Inout_  AML_STATE*                       State,
+    _In_     UINT8                            RegionSpaceType,
+    _In_opt_ AML_REGION_ACCESS_VECTOR_ROUTINE VectorRoutine
+    )
+{
+    if( RegionSpaceType >= AML_COUNTOF( State->RegionSpaceHandlers ) ) {
+        return AML_FALSE;
+    }
+    State->RegionSpaceHandlers[ RegionSpaceType ].VectorRoutine = VectorRoutine;
+    return AML_TRUE;
+}
+
 //
 // Lookup the access handler registration entry for the given region space tyhpe.
 //
@@ -10,9 +10,15 @@
 #include "aml_operation_region.h"
 #include "aml_state_snapshot.h"
 #include "aml_state_pass.h"
+#include "aml_eval_frame.h"
+#include "aml_skip_index.h"
+#include "aml_mapping_cache.h"
+#include "aml_pci_topology.h"
+#include "aml_execution_context.h"
 
 //
-// Maximum recursion depth limit.
+// Maximum native recursion depth limit (nested expressions, method invocations, table loads).
+// Nested TermList blocks are instead limited by the memory budget of the evaluation frame stack.
 //
 #ifndef AML_BUILD_MAX_RECURSION_DEPTH
  #ifdef AML_BUILD_FUZZER
@@ -37,11 +43,22 @@ typedef struct _AML_STATE {
     AML_ARENA Arena;
     AML_HEAP  Heap;
 
+    //
+    // Backend allocator of the state, used to create the arenas of execution contexts.
+    //
+    AML_ALLOCATOR Allocator;
+
     //
     // Host interface context.
     //
     AML_HOST_CONTEXT* Host;
 
+    //
+    // Currently entered execution context, NULL if not using contexts (see aml_execution_context.h).
+    // Only a single context may be entered at a time, the host must serialize all use of the state between threads.
+    //
+    struct _AML_EXECUTION_CONTEXT* ActiveContext;
+
     //
     // Indicates if the main DSDT/SSDT initial evaluation is complete.
     //
@@ -53,6 +70,84 @@ typedef struct _AML_STATE {
     //
     BOOLEAN IsIntegerSize64;
 
+    //
+    // Enables per-call-site name resolution caches for method bodies and loaded tables (see aml_name_cache.h).
+    //
+    BOOLEAN UseNameResolutionCache;
+
+    //
+    // Enables namespace pass skip indexes for loaded tables (see aml_skip_index.h).
+    //
+    BOOLEAN                   UseNamespaceSkipIndex;
+    AML_SKIP_INDEX_STATISTICS SkipIndexStatistics; /* Accumulated statistics of the skip indexes of all loaded tables. */
+
+    //
+    // Enables memoization of the results of pure identification methods (_HID, _CID, _UID, _ADR, _SUN, see aml_method_purity.h).
+    // Memoized results are invalidated whenever a table is loaded (IdentificationCacheGeneration).
+    //
+    BOOLEAN UseIdentificationCache;
+    UINT64  IdentificationCacheGeneration;
+    UINT64  IdentificationCacheHitCount;
+    UINT64  IdentificationCacheMissCount;
+
+    //
+    // Field accesses to mapped SystemMemory regions load and store the region mapping directly,
+    // instead of dispatching every access word to the region space handler (see AmlOperationRegionIsDirectAccess).
+    //
+    BOOLEAN UseDirectSystemMemoryAccess;
+
+    //
+    // Enables sharing of host mappings between overlapping SystemMemory regions (see aml_mapping_cache.h).
+    //
+    BOOLEAN           UseMappingCache;
+    AML_MAPPING_CACHE MappingCache;
+
+    //
+    // SystemMemory regions larger than this are mapped on demand in windows around the accessed offsets
+    // instead of being mapped entirely upon first access, 0 if windowing is disabled (see AmlOperationRegionMapAccess).
+    //
+    UINT64 RegionWindowThreshold;
+
+    //
+    // Enables sharing of evaluated PCI device topology between PCI_Config/PCI_BAR_Target regions (see aml_pci_topology.h).
+    // Only used for regions evaluated after the initial load has completed.
+    //
+    BOOLEAN                UsePciTopologyCache;
+    AML_PCI_TOPOLOGY_CACHE PciTopology;
+
+    //
+    // Index field accesses skip writing the index register when it is known to still hold the selected index,
+    // the index is only known as long as no other field write has been made to the index register's region space since.
+    // Write generations are tracked per region space (incremented once by every field write), as regions may alias each other.
+    //
+    BOOLEAN UseIndexRegisterElision;
+    UINT64  RegionSpaceWriteGenerations[ AML_MAX_SPEC_REGION_SPACE_TYPE_COUNT ];
+
+    //
+    // Tables loaded from direct access SystemMemory regions (Load) and host tables (LoadTable) are evaluated in place,
+    // instead of being copied to the heap first, the host guarantees that their memory stays mapped and unmodified.
+    //
+    BOOLEAN UseInPlaceTableLoad;
+
+    //
+    // Self-contained namespace image of this state, produced by AmlStateFreezeTemplate.
+    // Clones reference the names and method code held by the image in place.
+    //
+    VOID*  CloneImage;
+    SIZE_T CloneImageSize;
+
+    //
+    // Base namespace of the clone image, holding the named data objects shared by all clones created using UseSharedNamespace.
+    // Created by AmlStateFreezeTemplate, and owned by the template.
+    //
+    struct _AML_NAMESPACE_BASE* CloneBase;
+
+    //
+    // Memory of the template used in place by this clone (see AmlStateQueryMemoryUsage), SharedBase is only set for clones using UseSharedNamespace.
+    //
+    const struct _AML_NAMESPACE_BASE* SharedBase;
+    SIZE_T                            SharedImageSize;
+
     //
     // Global namespace state.
     //
@@ -66,6 +161,15 @@ typedef struct _AML_STATE {
     AML_METHOD_SCOPE* MethodScopeLast;
     AML_METHOD_SCOPE* MethodScopeRoot; /* Root method scope, the first of the current execution environment. */
 
+    //
+    // Evaluation frame stack, holds the state of all nested TermList blocks (If/Else/While/Scope bodies),
+    // nested blocks are evaluated iteratively instead of recursing on the native stack.
+    //
+    AML_ARENA       EvalFrameArena;
+    AML_EVAL_FRAME* EvalFrameLast;
+    SIZE_T          EvalFrameDepth;
+    SIZE_T          EvalFrameStackMaxSize; /* Memory budget of the frame stack, limits the maximum nesting depth of blocks. */
+
     //
     // Current evaluation and decoder state.
     //
@@ -90,6 +194,16 @@ typedef struct _AML_STATE {
         SIZE_T       DataLength;      /* The length is the absolute input data length, relative to start of Data, not the cursor. */
         SIZE_T       DataCursor;      /* Cursor position of the current window of the interpreter. */
 
+        //
+        // Name resolution cache of the currently executing method body or loaded table (optional).
+        //
+        struct _AML_NAME_CACHE* NameCache;
+
+        //
+        // Namespace pass skip index of the table currently being loaded (optional).
+        //
+        struct _AML_SKIP_INDEX* SkipIndex;
+
         //
         // While loop state.
         //
@@ -138,8 +252,31 @@ typedef struct _AML_STATE {
 typedef struct _AML_STATE_PARAMETERS {
     BOOLEAN           Use64BitInteger;
     AML_HOST_CONTEXT* Host;
+    BOOLEAN           UseNameResolutionCache; /* Cache name resolutions per call site of method bodies and loaded tables (see aml_name_cache.h). */
+    BOOLEAN           UseNamespaceSkipIndex; /* Record named object definitions of loaded tables in a namespace pass skip index (see aml_skip_index.h). */
+    BOOLEAN           DisableIdentificationCache; /* Disables memoization of pure identification method results. */
+    BOOLEAN           UseDirectSystemMemoryAccess; /* Host SystemMemory mappings are plain (cacheable or UC) memory that needs no trapping. */
+    BOOLEAN           UseMappingCache; /* Share host mappings between overlapping SystemMemory regions. */
+    SIZE_T            MappingCacheIdleLimit; /* Optional, AML_MAPPING_CACHE_DEFAULT_IDLE_LIMIT if 0. */
+    UINT64            RegionWindowThreshold; /* Optional, map SystemMemory regions larger than this in windows on demand, disabled if 0. */
+    BOOLEAN           UsePciTopologyCache; /* Share evaluated PCI device topology and resolved addresses between PCI regions. */
+    BOOLEAN           UseIndexRegisterElision; /* Index registers are only changed by AML field writes (no host access or auto-increment). */
+    BOOLEAN           UseInPlaceTableLoad; /* Loaded table memory (host tables, direct access regions) stays mapped and unmodified. */
+    SIZE_T            MaxFrameStackSize; /* Optional, AML_BUILD_DEFAULT_FRAME_STACK_SIZE if 0, only bounds the nesting of blocks. */
+    SIZE_T            NamespaceCapacityHint; /* Optional, expected amount of namespace nodes. */
+    BOOLEAN           UseSharedNamespace; /* AmlStateClone only, share the static named data of the template copy-on-write. */
 } AML_STATE_PARAMETERS;
 
+//
+// Memory usage of a state, see AmlStateQueryMemoryUsage.
+//
+typedef struct _AML_STATE_MEMORY_USAGE {
+    UINT64 PrivateSize;           /* Backing memory allocated by the state itself (excluding execution contexts). */
+    UINT64 SharedSize;            /* Memory of the template used in place by a clone (clone image and shared base namespace). */
+    UINT64 SharedObjectCount;     /* Count of nodes still linked to a shared object. */
+    UINT64 PrivatizedObjectCount; /* Count of shared objects replaced by a private copy (copy-on-write). */
+} AML_STATE_MEMORY_USAGE;
+
 
 //
 // User-returned iterator actions.
@@ -163,6 +300,84 @@ AML_ITERATOR_ACTION
     _Inout_  AML_NAMESPACE_NODE* Node
     );
 
+//
+// Work routine queued to a worker pool.
+//
+typedef
+VOID
+( *AML_WORK_ROUTINE )(
+    _Inout_ VOID* WorkContext
+    );
+
+//
+// User-provided worker pool callback to queue a work routine for execution on one of the worker threads of the pool.
+// The routine must not be run synchronously by the submitting thread.
+//
+typedef
+_Success_( return )
+BOOLEAN
+( *AML_WORKER_POOL_SUBMIT )(
+    _Inout_opt_ VOID*            Context,
+    _In_        AML_WORK_ROUTINE Routine,
+    _Inout_     VOID*            WorkContext
+    );
+
+//
+// User-provided worker pool callback to wait until all submitted work routines have returned,
+// including all routines submitted by other work routines while waiting.
+//
+typedef
+VOID
+( *AML_WORKER_POOL_WAIT )(
+    _Inout_opt_ VOID* Context
+    );
+
+//
+// Host-supplied worker pool, WorkerCount is the maximum amount of work routines that may run concurrently.
+//
+typedef struct _AML_WORKER_POOL {
+    VOID*                  Context;
+    SIZE_T                 WorkerCount;
+    AML_WORKER_POOL_SUBMIT Submit;
+    AML_WORKER_POOL_WAIT   Wait;
+} AML_WORKER_POOL;
+
+//
+// User-provided callback, reports the initialization time (_STA and _INI) of a single device.
+// PathTime is the sum of the initialization times of the device and all of its initialized ancestors.
+// All times are in AmlHostMonotonicTimer units, and include the time spent waiting for the scheduler lock.
+// Called from within the entered execution context of the initializing worker (with the scheduler lock held).
+//
+typedef
+VOID
+( *AML_DEVICE_INIT_TIMING_ROUTINE )(
+    _Inout_opt_ VOID*               UserContext,
+    _Inout_     struct _AML_STATE*  State,
+    _In_        AML_NAMESPACE_NODE* Node,
+    _In_        UINT64              InitTime,
+    _In_        UINT64              PathTime
+    );
+
+//
+// Parallel device initialization parameters.
+//
+typedef struct _AML_DEVICE_INIT_PARAMETERS {
+    const AML_WORKER_POOL*         Pool;
+    AML_DEVICE_INIT_TIMING_ROUTINE TimingRoutine; /* Optional. */
+    VOID*                          TimingContext;
+} AML_DEVICE_INIT_PARAMETERS;
+
+//
+// Parallel device initialization statistics, all times are in AmlHostMonotonicTimer units.
+//
+typedef struct _AML_DEVICE_INIT_STATISTICS {
+    UINT64 DeviceCount;       /* Amount of visited device objects. */
+    UINT64 FailedDeviceCount; /* Amount of devices that failed to initialize (_STA or _INI evaluation failure). */
+    UINT64 TotalTime;         /* Sum of the initialization times of all devices (the serial initialization time). */
+    UINT64 CriticalPathTime;  /* Longest sum of initialization times along a chain of parent and child devices. */
+    UINT64 ElapsedTime;       /* Elapsed time of the entire parallel initialization. */
+} AML_DEVICE_INIT_STATISTICS;
+
 //
 // Initialize the AML decoder/evaluation state.
 // Note: The given allocator and host context must exist for the entire lifetime of the state.
@@ -183,6 +398,46 @@ AmlStateFree(
     _Inout_ _Post_invalid_ AML_STATE* State
     );
 
+//
+// Freeze the namespace of a template state, capturing everything needed by AmlStateClone.
+// The template must have loaded all of its tables, later changes to the template aren't visible to any clones.
+// Must complete before the first AmlStateClone of the template, and must not be called concurrently with it,
+// calling it again for an already frozen template has no effect.
+//
+_Success_( return )
+BOOLEAN
+AmlStateFreezeTemplate(
+    _Inout_ AML_STATE* Template
+    );
+
+//
+// Create a new state holding a copy of the namespace of a template state, instead of loading the same tables again.
+// The template must have been frozen using AmlStateFreezeTemplate, clones of templates that have completed their initial load
+// are complete as well, and consider all devices initialized (and _REG methods called) by the template as such.
+// Method code, names, and the frozen namespace are shared with the template, the template must not be freed before all of its clones.
+// The template itself isn't modified, clones of the same frozen template may be created concurrently.
+// The integer size of the clone is always that of the template, the remaining parameters apply to the clone.
+// Clones created using UseSharedNamespace don't hold their own copy of the static named data of the template (Name objects),
+// they use the objects of a base namespace owned by the template, and copy an object only before modifying or referencing it.
+//
+_Success_( return )
+BOOLEAN
+AmlStateClone(
+    _In_  const AML_STATE*            Template,
+    _Out_ AML_STATE*                  Clone,
+    _In_  AML_ALLOCATOR               Allocator,
+    _In_  const AML_STATE_PARAMETERS* Parameters
+    );
+
+//
+// Query the memory usage of a state, distinguishing memory private to the state from template memory shared with other clones.
+//
+VOID
+AmlStateQueryMemoryUsage(
+    _In_  const AML_STATE*        State,
+    _Out_ AML_STATE_MEMORY_USAGE* Usage
+    );
+
 //
 // Create all predefined namespaces.
 //
@@ -214,6 +469,25 @@ AmlInitializeDevices(
     _In_    BOOLEAN                  CallRootInitializers
     );
 
+//
+// Call the _INI methods for all functioning devices that advertise their presence through _STA (see AmlInitializeDevices),
+// sibling subtrees are scheduled as separate work items on the given worker pool, each worker using its own execution context.
+// A device is only initialized after its parent, and its _STA is always evaluated before its _INI.
+// AML is not evaluated in parallel: the workers are serialized by a scheduler lock, which a worker only releases while it blocks
+// (Sleep, Stall, Wait, and Acquire or serialized method entry of an owned mutex), so only the blocking waits of subtrees overlap.
+// Devices that fail to initialize are reported like AmlInitializeDevices does (debug log), and counted in the statistics.
+// The caller may be within an entered execution context, which is suspended until all devices have been initialized.
+//
+_Success_( return )
+BOOLEAN
+AmlInitializeDevicesParallel(
+    _Inout_   AML_STATE*                        State,
+    _Inout_   AML_NAMESPACE_TREE_NODE*          StartTreeNode,
+    _In_      BOOLEAN                           CallRootInitializers,
+    _In_      const AML_DEVICE_INIT_PARAMETERS* Parameters,
+    _Out_opt_ AML_DEVICE_INIT_STATISTICS*       Statistics
+    );
+
 //
 // Complete the initial load, build the hierarchical namespace tree, initialize all device objects.
 //
@@ -267,6 +541,20 @@ AmlRegisterRegionSpaceAccessHandler(
     _In_     BOOLEAN                   CallRegMethods
     );
 
+//
+// Attempt to register an optional vectored access handler alongside the regular access handler of a region-space,
+// used to service multi-word field accesses in a single call (see AML_REGION_ACCESS_VECTOR_ROUTINE).
+// The vectored handler receives the UserContext of the regular handler, and is removed upon (re-)registration of the regular handler.
+// Passing a NULL routine removes the vectored handler, all accesses are then split into regular handler calls.
+//
+_Success_( return )
+BOOLEAN
+AmlRegisterRegionSpaceVectorAccessHandler(
+    _Inout_  AML_STATE*                       State,
+    _In_     UINT8                            RegionSpaceType,
+    _In_opt_ AML_REGION_ACCESS_VECTOR_ROUTINE VectorRoutine
+    );
+
 //
 // Lookup the access handler registration entry for the given region space tyhpe.
 //